@@ -0,0 +1,125 @@
+/*
+ * File:        lsm_benchmark_utilities.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for utilities shared by the LSMLIB
+ *              benchmarks
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "lsm_benchmark_utilities.h"
+
+
+/*============================= Constants ===========================*/
+
+#define LSM_BENCHMARK_DEFAULT_MIN_TIME    (0.5)
+
+
+/*==================== Function Definitions =========================*/
+
+int LSM_Benchmark_parseOptions(
+  LSM_BenchmarkOptions *options,
+  int argc,
+  char **argv)
+{
+  int i;
+
+  options->quick = 0;
+  options->min_time = LSM_BENCHMARK_DEFAULT_MIN_TIME;
+  options->filter = NULL;
+  options->fp_out = stdout;
+
+  for (i = 1; i < argc; i++) {
+    if (0 == strcmp(argv[i], "-quick")) {
+      options->quick = 1;
+    } else if ( (0 == strcmp(argv[i], "-min_time")) && (i+1 < argc) ) {
+      options->min_time = atof(argv[++i]);
+    } else if ( (0 == strcmp(argv[i], "-filter")) && (i+1 < argc) ) {
+      options->filter = argv[++i];
+    } else if ( (0 == strcmp(argv[i], "-o")) && (i+1 < argc) ) {
+      options->fp_out = fopen(argv[++i], "w");
+      if (!options->fp_out) {
+        fprintf(stderr, "ERROR: Unable to open output file '%s'.\n",
+                argv[i]);
+        options->fp_out = stdout;
+        return -1;
+      }
+    } else {
+      fprintf(stderr,
+        "Usage: %s [-quick] [-min_time <t>] [-filter <string>] "
+        "[-o <file>]\n", argv[0]);
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+
+void LSM_Benchmark_closeOptions(LSM_BenchmarkOptions *options)
+{
+  if (options->fp_out != stdout) {
+    fclose(options->fp_out);
+    options->fp_out = stdout;
+  }
+}
+
+
+int LSM_Benchmark_isSelected(
+  const LSM_BenchmarkOptions *options,
+  const char *name)
+{
+  return (!options->filter) || (strstr(name, options->filter) != NULL);
+}
+
+
+long LSM_Benchmark_getPeakRSS(void)
+{
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage)) return -1;
+
+  /* ru_maxrss is reported in kilobytes on Linux */
+  return usage.ru_maxrss;
+}
+
+
+void LSM_Benchmark_writeResult(
+  const LSM_BenchmarkOptions *options,
+  const char *suite,
+  const char *name,
+  int num_dims,
+  const int *grid_dims,
+  int num_reps,
+  double wall_time,
+  double points_updated,
+  double bytes_touched,
+  const char *extra_fields)
+{
+  FILE *fp = options->fp_out;
+  int dir;
+
+  /* guard against timer resolution for very fast benchmarks */
+  double time = (wall_time > 0) ? wall_time : 1.e-9;
+
+  fprintf(fp, "{ \"suite\": \"%s\", \"name\": \"%s\", \"num_dims\": %d, "
+              "\"grid_dims\": [", suite, name, num_dims);
+  for (dir = 0; dir < num_dims; dir++) {
+    fprintf(fp, "%s%d", (dir > 0) ? ", " : "", grid_dims[dir]);
+  }
+  fprintf(fp, "], \"num_reps\": %d, \"wall_time\": %.6g, "
+              "\"points_per_second\": %.6g, "
+              "\"gigabytes_per_second\": %.6g, \"peak_rss_kb\": %ld",
+          num_reps, wall_time, points_updated/time,
+          bytes_touched/time*1.e-9, LSM_Benchmark_getPeakRSS());
+  if (extra_fields) {
+    fprintf(fp, ", %s", extra_fields);
+  }
+  fprintf(fp, " }\n");
+  fflush(fp);
+}
@@ -0,0 +1,152 @@
+/*
+ * File:        lsm_benchmark_utilities.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for utilities shared by the LSMLIB benchmarks
+ */
+
+#ifndef INCLUDED_LSM_BENCHMARK_UTILITIES_H
+#define INCLUDED_LSM_BENCHMARK_UTILITIES_H
+
+#include <stdio.h>
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \file lsm_benchmark_utilities.h
+ *
+ * \brief
+ * @ref lsm_benchmark_utilities.h provides the command-line options,
+ * timing and result output shared by the LSMLIB benchmark programs.
+ *
+ * Each benchmark result is written as a single line containing a JSON
+ * object (i.e. the output is in JSON Lines format) with the following
+ * fields:
+ *
+ * - suite, name:           benchmark suite and benchmark name
+ * - num_dims, grid_dims:   dimension and size of the grid (without
+ *                          ghostcells)
+ * - num_reps:              number of repetitions (kernel calls for
+ *                          microbenchmarks, time steps for workflows)
+ * - wall_time:             total wall time for all repetitions (seconds)
+ * - points_per_second:     grid points updated per second
+ * - gigabytes_per_second:  estimated memory bandwidth (based on the
+ *                          number of data arrays read and written)
+ * - peak_rss_kb:           peak resident set size of the process
+ *
+ * Benchmark-specific fields (e.g. accuracy measures for the end-to-end
+ * workflows) are appended after these fields.
+ *
+ */
+
+
+/*!
+ * Structure 'LSM_BenchmarkOptions' stores the options shared by the
+ * benchmark programs.
+ */
+typedef struct _LSM_BenchmarkOptions
+{
+  /* only run the smallest grid size for each benchmark */
+  int quick;
+
+  /* minimum wall time (in seconds) used to time each microbenchmark */
+  double min_time;
+
+  /* only run benchmarks whose names contain filter (NULL to run all) */
+  const char *filter;
+
+  /* output stream for benchmark results */
+  FILE *fp_out;
+
+} LSM_BenchmarkOptions;
+
+
+/*!
+ * LSM_Benchmark_parseOptions() parses the command-line options shared
+ * by the benchmark programs:
+ *
+ *   -quick             only run the smallest grid size
+ *   -min_time <t>      minimum time per microbenchmark (default: 0.5 s)
+ *   -filter <string>   only run benchmarks whose names contain <string>
+ *   -o <file>          write results to <file> (default: stdout)
+ *
+ * Arguments:
+ *  - options (out):  benchmark options
+ *  - argc (in):      number of command-line arguments
+ *  - argv (in):      command-line arguments
+ *
+ * Return value:      0 on success; -1 if the command-line is invalid
+ *                    (a usage message is printed to stderr)
+ *
+ */
+int LSM_Benchmark_parseOptions(
+  LSM_BenchmarkOptions *options,
+  int argc,
+  char **argv);
+
+
+/*!
+ * LSM_Benchmark_closeOptions() closes the output file (if one was
+ * opened by LSM_Benchmark_parseOptions()).
+ */
+void LSM_Benchmark_closeOptions(LSM_BenchmarkOptions *options);
+
+
+/*!
+ * LSM_Benchmark_isSelected() returns 1 if the named benchmark should be
+ * run and 0 otherwise.
+ */
+int LSM_Benchmark_isSelected(
+  const LSM_BenchmarkOptions *options,
+  const char *name);
+
+
+/*!
+ * LSM_Benchmark_getPeakRSS() returns the peak resident set size of the
+ * process in kilobytes (or -1 if it is not available).
+ */
+long LSM_Benchmark_getPeakRSS(void);
+
+
+/*!
+ * LSM_Benchmark_writeResult() writes a benchmark result.
+ *
+ * Arguments:
+ *  - options (in):         benchmark options
+ *  - suite (in):           name of benchmark suite
+ *  - name (in):            name of benchmark
+ *  - num_dims (in):        number of spatial dimensions
+ *  - grid_dims (in):       grid dimensions (without ghostcells)
+ *  - num_reps (in):        number of repetitions
+ *  - wall_time (in):       total wall time for all repetitions
+ *  - points_updated (in):  total number of grid points updated
+ *  - bytes_touched (in):   total (estimated) number of bytes read and
+ *                          written
+ *  - extra_fields (in):    additional JSON fields (without leading
+ *                          comma); may be NULL
+ *
+ * Return value:            none
+ *
+ */
+void LSM_Benchmark_writeResult(
+  const LSM_BenchmarkOptions *options,
+  const char *suite,
+  const char *name,
+  int num_dims,
+  const int *grid_dims,
+  int num_reps,
+  double wall_time,
+  double points_updated,
+  double bytes_touched,
+  const char *extra_fields);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
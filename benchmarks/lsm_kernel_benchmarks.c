@@ -0,0 +1,739 @@
+/*
+ * File:        lsm_kernel_benchmarks.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Microbenchmarks for the LSMLIB toolbox kernel families
+ */
+
+/* System headers */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+/* LSMLIB headers */
+#include "LSMLIB_config.h"
+#include "lsm_spatial_derivatives2d.h"
+#include "lsm_spatial_derivatives3d.h"
+#include "lsm_tvd_runge_kutta2d.h"
+#include "lsm_tvd_runge_kutta3d.h"
+#include "lsm_reinitialization2d.h"
+#include "lsm_reinitialization3d.h"
+#include "lsm_curvature2d.h"
+#include "lsm_curvature3d.h"
+#include "lsm_localization2d.h"
+#include "lsm_localization3d.h"
+#include "lsm_instrumentation.h"
+#include "FMM_Heap.h"
+
+/* LSMLIB Serial package headers */
+#include "lsm_grid.h"
+#include "lsm_fast_marching_method.h"
+
+/* Local headers */
+#include "lsm_benchmark_utilities.h"
+
+
+/*============================= Constants ===========================*/
+
+#define LSM_BENCHMARK_SUITE          "kernels"
+
+/* minimum number of timed kernel calls for each benchmark */
+#define LSM_BENCHMARK_MIN_REPS       (3)
+
+/* number of narrow band levels and narrow band widths (in grid cells) */
+#define LSM_BENCHMARK_NB_LEVELS      (3)
+#define LSM_BENCHMARK_NB_WIDTH       (6.0)
+#define LSM_BENCHMARK_NB_WIDTH_INNER (4.0)
+
+/* radius of the zero level set of the test level set function */
+#define LSM_BENCHMARK_RADIUS         (0.3)
+
+/* index ranges and grid spacing arguments for toolbox kernels */
+#define GB2D(g)  &((g)->ilo_gb), &((g)->ihi_gb), &((g)->jlo_gb), &((g)->jhi_gb)
+#define GB3D(g)  GB2D(g), &((g)->klo_gb), &((g)->khi_gb)
+#define FB2D(g)  &((g)->ilo_fb), &((g)->ihi_fb), &((g)->jlo_fb), &((g)->jhi_fb)
+#define FB3D(g)  FB2D(g), &((g)->klo_fb), &((g)->khi_fb)
+#define DX2D(g)  &((g)->dx[0]), &((g)->dx[1])
+#define DX3D(g)  DX2D(g), &((g)->dx[2])
+
+
+/*========================== Data Structures ========================*/
+
+/*
+ * KernelBenchmarkData stores the grid and data arrays used by the
+ * kernel benchmarks.  All arrays are defined on the ghostbox of the grid.
+ */
+typedef struct _KernelBenchmarkData
+{
+  Grid *grid;
+
+  LSMLIB_REAL *phi, *phi0, *rhs;
+  LSMLIB_REAL *u_stage1, *u_stage2, *u_next;
+  LSMLIB_REAL *phi_plus[3], *phi_minus[3], *grad_phi[3];
+  LSMLIB_REAL *grad_phi_mag, *kappa;
+  LSMLIB_REAL *D1, *D2, *D3;
+
+  unsigned char *narrow_band;
+  int *index[3], *index_outer;
+  int n_lo[LSM_BENCHMARK_NB_LEVELS+1], n_hi[LSM_BENCHMARK_NB_LEVELS+1];
+
+} KernelBenchmarkData;
+
+/*
+ * KernelBenchmark describes a single kernel benchmark.  bytes_per_point
+ * is the (estimated) number of bytes read and written per grid point
+ * for each kernel call.
+ */
+typedef struct _KernelBenchmark
+{
+  const char *name;
+  int num_dims;
+  double bytes_per_point;
+  void (*kernel)(KernelBenchmarkData *data);
+} KernelBenchmark;
+
+
+/*================== Helper Functions Declarations ==================*/
+
+/* kernel wrappers */
+static void hjENO1_2d(KernelBenchmarkData *d);
+static void hjENO2_2d(KernelBenchmarkData *d);
+static void hjENO3_2d(KernelBenchmarkData *d);
+static void hjWENO5_2d(KernelBenchmarkData *d);
+static void tvdRK3Stage1_2d(KernelBenchmarkData *d);
+static void tvdRK3Stage2_2d(KernelBenchmarkData *d);
+static void tvdRK3Stage3_2d(KernelBenchmarkData *d);
+static void reinitializationRHS_2d(KernelBenchmarkData *d);
+static void meanCurvature_2d(KernelBenchmarkData *d);
+static void narrowBand_2d(KernelBenchmarkData *d);
+static void fmmHeap_2d(KernelBenchmarkData *d);
+static void fmmDistanceFunction_2d(KernelBenchmarkData *d);
+static void hjENO1_3d(KernelBenchmarkData *d);
+static void hjENO2_3d(KernelBenchmarkData *d);
+static void hjENO3_3d(KernelBenchmarkData *d);
+static void hjWENO5_3d(KernelBenchmarkData *d);
+static void tvdRK3Stage1_3d(KernelBenchmarkData *d);
+static void tvdRK3Stage2_3d(KernelBenchmarkData *d);
+static void tvdRK3Stage3_3d(KernelBenchmarkData *d);
+static void reinitializationRHS_3d(KernelBenchmarkData *d);
+static void meanCurvature_3d(KernelBenchmarkData *d);
+static void narrowBand_3d(KernelBenchmarkData *d);
+static void fmmDistanceFunction_3d(KernelBenchmarkData *d);
+
+/*
+ * createKernelBenchmarkData() allocates the data arrays for the
+ * specified grid size and initializes phi to the signed distance
+ * function for a circle (sphere) and the derivative arrays used as
+ * input by the reinitialization and curvature kernels.
+ */
+static KernelBenchmarkData *createKernelBenchmarkData(
+  int num_dims,
+  int n);
+
+/*
+ * destroyKernelBenchmarkData() frees the memory allocated by
+ * createKernelBenchmarkData().
+ */
+static void destroyKernelBenchmarkData(KernelBenchmarkData *data);
+
+/*
+ * runKernelBenchmark() times the kernel and writes the result.
+ */
+static void runKernelBenchmark(
+  const LSM_BenchmarkOptions *options,
+  const KernelBenchmark *benchmark,
+  KernelBenchmarkData *data);
+
+
+/*============================ Benchmarks ===========================*/
+
+#define RSZ   (sizeof(LSMLIB_REAL))
+
+static const KernelBenchmark s_benchmarks[] = {
+  /* grad phi (plus and minus) + phi + divided differences */
+  { "hj_eno1_2d",              2,  6*RSZ, hjENO1_2d },
+  { "hj_eno2_2d",              2,  7*RSZ, hjENO2_2d },
+  { "hj_eno3_2d",              2,  8*RSZ, hjENO3_2d },
+  { "hj_weno5_2d",             2,  6*RSZ, hjWENO5_2d },
+  /* stage solution + previous stages + rhs */
+  { "tvd_rk3_stage1_2d",       2,  3*RSZ, tvdRK3Stage1_2d },
+  { "tvd_rk3_stage2_2d",       2,  4*RSZ, tvdRK3Stage2_2d },
+  { "tvd_rk3_stage3_2d",       2,  4*RSZ, tvdRK3Stage3_2d },
+  /* rhs + phi + phi0 + grad phi (plus and minus) */
+  { "reinitialization_rhs_2d", 2,  7*RSZ, reinitializationRHS_2d },
+  /* kappa + phi + grad phi + |grad phi| */
+  { "mean_curvature_2d",       2,  5*RSZ, meanCurvature_2d },
+  /* phi + narrow band marks + index arrays */
+  { "narrow_band_2d",          2,  RSZ + 1 + 3*sizeof(int), narrowBand_2d },
+  /* insert and extract each node */
+  { "fmm_heap",                2,  2*sizeof(FMM_HeapNode), fmmHeap_2d },
+  /* distance function + phi + FMM status and heap data */
+  { "fmm_distance_2d",         2,  5*RSZ, fmmDistanceFunction_2d },
+  { "hj_eno1_3d",              3,  8*RSZ, hjENO1_3d },
+  { "hj_eno2_3d",              3,  9*RSZ, hjENO2_3d },
+  { "hj_eno3_3d",              3, 10*RSZ, hjENO3_3d },
+  { "hj_weno5_3d",             3,  8*RSZ, hjWENO5_3d },
+  { "tvd_rk3_stage1_3d",       3,  3*RSZ, tvdRK3Stage1_3d },
+  { "tvd_rk3_stage2_3d",       3,  4*RSZ, tvdRK3Stage2_3d },
+  { "tvd_rk3_stage3_3d",       3,  4*RSZ, tvdRK3Stage3_3d },
+  { "reinitialization_rhs_3d", 3,  9*RSZ, reinitializationRHS_3d },
+  { "mean_curvature_3d",       3,  6*RSZ, meanCurvature_3d },
+  { "narrow_band_3d",          3,  RSZ + 1 + 4*sizeof(int), narrowBand_3d },
+  { "fmm_distance_3d",         3,  7*RSZ, fmmDistanceFunction_3d },
+};
+
+#define NUM_BENCHMARKS   (sizeof(s_benchmarks)/sizeof(KernelBenchmark))
+
+/* grid sizes (number of grid cells in each coordinate direction) */
+static const int s_grid_sizes_2d[] = { 128, 256, 512, 1024 };
+static const int s_grid_sizes_3d[] = { 32, 64, 128 };
+
+#define NUM_GRID_SIZES_2D   (sizeof(s_grid_sizes_2d)/sizeof(int))
+#define NUM_GRID_SIZES_3D   (sizeof(s_grid_sizes_3d)/sizeof(int))
+
+
+/*=========================== Main Program ==========================*/
+
+int main(int argc, char **argv)
+{
+  LSM_BenchmarkOptions options;
+  int num_dims, size_idx;
+  unsigned int b;
+
+  if (LSM_Benchmark_parseOptions(&options, argc, argv)) return 1;
+
+  for (num_dims = 2; num_dims <= 3; num_dims++) {
+
+    const int *grid_sizes = (num_dims == 2) ? s_grid_sizes_2d
+                                            : s_grid_sizes_3d;
+    int num_grid_sizes = (num_dims == 2) ? NUM_GRID_SIZES_2D
+                                         : NUM_GRID_SIZES_3D;
+    if (options.quick) num_grid_sizes = 1;
+
+    for (size_idx = 0; size_idx < num_grid_sizes; size_idx++) {
+
+      KernelBenchmarkData *data = NULL;
+
+      for (b = 0; b < NUM_BENCHMARKS; b++) {
+        if ( (s_benchmarks[b].num_dims != num_dims) ||
+             (!LSM_Benchmark_isSelected(&options, s_benchmarks[b].name)) ) {
+          continue;
+        }
+
+        /* only allocate data if at least one benchmark is selected */
+        if (!data) {
+          data = createKernelBenchmarkData(num_dims, grid_sizes[size_idx]);
+          if (!data) {
+            fprintf(stderr, "ERROR: Unable to allocate benchmark data.\n");
+            LSM_Benchmark_closeOptions(&options);
+            return 1;
+          }
+        }
+
+        runKernelBenchmark(&options, &s_benchmarks[b], data);
+      }
+
+      if (data) destroyKernelBenchmarkData(data);
+    }
+  }
+
+  LSM_Benchmark_closeOptions(&options);
+  return 0;
+}
+
+
+/*==================== Helper Functions Definitions =================*/
+
+static void runKernelBenchmark(
+  const LSM_BenchmarkOptions *options,
+  const KernelBenchmark *benchmark,
+  KernelBenchmarkData *data)
+{
+  Grid *grid = data->grid;
+  double num_points = 1;
+  double t_start, wall_time;
+  int num_reps = 0;
+  int dir;
+
+  for (dir = 0; dir < grid->num_dims; dir++) {
+    num_points *= grid->grid_dims[dir];
+  }
+
+  /* warm-up call */
+  benchmark->kernel(data);
+
+  t_start = LSM_Instrumentation_getWallTime();
+  do {
+    benchmark->kernel(data);
+    num_reps++;
+    wall_time = LSM_Instrumentation_getWallTime() - t_start;
+  } while ( (wall_time < options->min_time) ||
+            (num_reps < LSM_BENCHMARK_MIN_REPS) );
+
+  LSM_Benchmark_writeResult(options, LSM_BENCHMARK_SUITE, benchmark->name,
+    grid->num_dims, grid->grid_dims, num_reps, wall_time,
+    num_reps*num_points, num_reps*num_points*benchmark->bytes_per_point,
+    NULL);
+}
+
+
+static KernelBenchmarkData *createKernelBenchmarkData(
+  int num_dims,
+  int n)
+{
+  KernelBenchmarkData *d;
+  Grid *g;
+  int grid_dims[3] = {n, n, n};
+  LSMLIB_REAL x_lo[3] = {0.0, 0.0, 0.0};
+  LSMLIB_REAL x_hi[3] = {1.0, 1.0, 1.0};
+  LSMLIB_REAL *arrays[20];
+  int num_gridpts, num_arrays = 20;
+  int i, j, k, dir, idx;
+
+  d = (KernelBenchmarkData*) calloc(1, sizeof(KernelBenchmarkData));
+  if (!d) return NULL;
+
+  /* VERY_HIGH accuracy provides enough ghostcells for HJ WENO5 */
+  d->grid = g = createGridSetGridDims(num_dims, grid_dims, x_lo, x_hi,
+                                      VERY_HIGH);
+  num_gridpts = g->num_gridpts;
+
+  /* allocate data arrays (calloc does not touch memory until it is */
+  /* used, so the peak RSS reflects the arrays used by the kernels) */
+  for (idx = 0; idx < num_arrays; idx++) {
+    arrays[idx] = (LSMLIB_REAL*) calloc(num_gridpts, sizeof(LSMLIB_REAL));
+    if (!arrays[idx]) {
+      while (idx > 0) free(arrays[--idx]);
+      destroyGrid(g);
+      free(d);
+      return NULL;
+    }
+  }
+  d->phi = arrays[0];          d->phi0 = arrays[1];
+  d->rhs = arrays[2];          d->u_stage1 = arrays[3];
+  d->u_stage2 = arrays[4];     d->u_next = arrays[5];
+  for (dir = 0; dir < 3; dir++) {
+    d->phi_plus[dir] = arrays[6+dir];
+    d->phi_minus[dir] = arrays[9+dir];
+  }
+  d->D1 = arrays[12];          d->D2 = arrays[13];
+  d->D3 = arrays[14];
+  for (dir = 0; dir < 3; dir++) {
+    d->grad_phi[dir] = arrays[15+dir];
+  }
+  d->grad_phi_mag = arrays[18];  d->kappa = arrays[19];
+
+  d->narrow_band = (unsigned char*) calloc(num_gridpts,
+                                           sizeof(unsigned char));
+  d->index_outer = (int*) calloc(num_gridpts, sizeof(int));
+  for (dir = 0; dir < num_dims; dir++) {
+    d->index[dir] = (int*) calloc(num_gridpts, sizeof(int));
+  }
+
+  /* initialize phi to signed distance function for circle (sphere) */
+  idx = 0;
+  for (k = 0; k < ( (num_dims == 3) ? g->grid_dims_ghostbox[2] : 1 ); k++) {
+    for (j = 0; j < g->grid_dims_ghostbox[1]; j++) {
+      for (i = 0; i < g->grid_dims_ghostbox[0]; i++, idx++) {
+        LSMLIB_REAL x = g->x_lo_ghostbox[0] + g->dx[0]*i - 0.5;
+        LSMLIB_REAL y = g->x_lo_ghostbox[1] + g->dx[1]*j - 0.5;
+        LSMLIB_REAL z = (num_dims == 3) ?
+          g->x_lo_ghostbox[2] + g->dx[2]*k - 0.5 : 0.0;
+        d->phi[idx] = sqrt(x*x + y*y + z*z) - LSM_BENCHMARK_RADIUS;
+        d->phi0[idx] = d->phi[idx];
+        d->rhs[idx] = d->phi[idx];
+      }
+    }
+  }
+
+  /* input data for the reinitialization and curvature kernels */
+  if (num_dims == 2) {
+    hjENO1_2d(d);
+    LSM2D_CENTRAL_GRAD_ORDER2(
+      d->grad_phi[0], d->grad_phi[1], GB2D(g),
+      d->phi, GB2D(g),
+      FB2D(g),
+      DX2D(g));
+    LSM2D_GRADIENT_MAGNITUDE(
+      d->grad_phi[0], d->grad_phi[1], d->grad_phi_mag, GB2D(g),
+      FB2D(g));
+  } else {
+    hjENO1_3d(d);
+    LSM3D_CENTRAL_GRAD_ORDER2(
+      d->grad_phi[0], d->grad_phi[1], d->grad_phi[2], GB3D(g),
+      d->phi, GB3D(g),
+      FB3D(g),
+      DX3D(g));
+    LSM3D_GRADIENT_MAGNITUDE(
+      d->grad_phi[0], d->grad_phi[1], d->grad_phi[2], d->grad_phi_mag,
+      GB3D(g),
+      FB3D(g));
+  }
+
+  return d;
+}
+
+
+static void destroyKernelBenchmarkData(KernelBenchmarkData *d)
+{
+  int dir;
+
+  free(d->phi);       free(d->phi0);       free(d->rhs);
+  free(d->u_stage1);  free(d->u_stage2);   free(d->u_next);
+  for (dir = 0; dir < 3; dir++) {
+    free(d->phi_plus[dir]);
+    free(d->phi_minus[dir]);
+    free(d->grad_phi[dir]);
+    free(d->index[dir]);
+  }
+  free(d->D1);  free(d->D2);  free(d->D3);
+  free(d->grad_phi_mag);  free(d->kappa);
+  free(d->narrow_band);
+  free(d->index_outer);
+  destroyGrid(d->grid);
+  free(d);
+}
+
+
+/* 2D kernel wrappers */
+
+static void hjENO1_2d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  LSM2D_HJ_ENO1(
+    d->phi_plus[0], d->phi_plus[1], GB2D(g),
+    d->phi_minus[0], d->phi_minus[1], GB2D(g),
+    d->phi, GB2D(g),
+    d->D1, GB2D(g),
+    FB2D(g),
+    DX2D(g));
+}
+
+
+static void hjENO2_2d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  LSM2D_HJ_ENO2(
+    d->phi_plus[0], d->phi_plus[1], GB2D(g),
+    d->phi_minus[0], d->phi_minus[1], GB2D(g),
+    d->phi, GB2D(g),
+    d->D1, GB2D(g),
+    d->D2, GB2D(g),
+    FB2D(g),
+    DX2D(g));
+}
+
+
+static void hjENO3_2d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  LSM2D_HJ_ENO3(
+    d->phi_plus[0], d->phi_plus[1], GB2D(g),
+    d->phi_minus[0], d->phi_minus[1], GB2D(g),
+    d->phi, GB2D(g),
+    d->D1, GB2D(g),
+    d->D2, GB2D(g),
+    d->D3, GB2D(g),
+    FB2D(g),
+    DX2D(g));
+}
+
+
+static void hjWENO5_2d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  LSM2D_HJ_WENO5(
+    d->phi_plus[0], d->phi_plus[1], GB2D(g),
+    d->phi_minus[0], d->phi_minus[1], GB2D(g),
+    d->phi, GB2D(g),
+    d->D1, GB2D(g),
+    FB2D(g),
+    DX2D(g));
+}
+
+
+static void tvdRK3Stage1_2d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  LSMLIB_REAL dt = 0.5*g->dx[0];
+  LSM2D_TVD_RK3_STAGE1(
+    d->u_stage1, GB2D(g),
+    d->phi, GB2D(g),
+    d->rhs, GB2D(g),
+    FB2D(g),
+    &dt);
+}
+
+
+static void tvdRK3Stage2_2d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  LSMLIB_REAL dt = 0.5*g->dx[0];
+  LSM2D_TVD_RK3_STAGE2(
+    d->u_stage2, GB2D(g),
+    d->u_stage1, GB2D(g),
+    d->phi, GB2D(g),
+    d->rhs, GB2D(g),
+    FB2D(g),
+    &dt);
+}
+
+
+static void tvdRK3Stage3_2d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  LSMLIB_REAL dt = 0.5*g->dx[0];
+  LSM2D_TVD_RK3_STAGE3(
+    d->u_next, GB2D(g),
+    d->u_stage2, GB2D(g),
+    d->phi, GB2D(g),
+    d->rhs, GB2D(g),
+    FB2D(g),
+    &dt);
+}
+
+
+static void reinitializationRHS_2d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  int use_phi0_for_sgn = 1;
+  LSM2D_COMPUTE_REINITIALIZATION_EQN_RHS(
+    d->rhs, GB2D(g),
+    d->phi, GB2D(g),
+    d->phi0, GB2D(g),
+    d->phi_plus[0], d->phi_plus[1], GB2D(g),
+    d->phi_minus[0], d->phi_minus[1], GB2D(g),
+    FB2D(g),
+    DX2D(g),
+    &use_phi0_for_sgn);
+}
+
+
+static void meanCurvature_2d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  LSM2D_COMPUTE_MEAN_CURVATURE_ORDER2(
+    d->kappa, GB2D(g),
+    d->phi, GB2D(g),
+    d->grad_phi[0], d->grad_phi[1], d->grad_phi_mag, GB2D(g),
+    FB2D(g),
+    DX2D(g));
+}
+
+
+static void narrowBand_2d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  int nlo_index = 0, nhi_index = g->num_gridpts-1;
+  int nlo_index_outer = 0, nhi_index_outer = g->num_gridpts-1;
+  int nlo_outer_plus, nhi_outer_plus, nlo_outer_minus, nhi_outer_minus;
+  LSMLIB_REAL width = LSM_BENCHMARK_NB_WIDTH*g->dx[0];
+  LSMLIB_REAL width_inner = LSM_BENCHMARK_NB_WIDTH_INNER*g->dx[0];
+  int level = LSM_BENCHMARK_NB_LEVELS;
+  LSM2D_DETERMINE_NARROW_BAND(
+    d->phi, GB2D(g),
+    d->narrow_band, GB2D(g),
+    d->index[0], d->index[1],
+    &nlo_index, &nhi_index,
+    d->n_lo, d->n_hi,
+    d->index_outer,
+    &nlo_index_outer, &nhi_index_outer,
+    &nlo_outer_plus, &nhi_outer_plus,
+    &nlo_outer_minus, &nhi_outer_minus,
+    &width, &width_inner, &level);
+}
+
+
+static void fmmHeap_2d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  FMM_Heap *heap = FMM_Heap_createHeap(2, 0, 0);
+  int grid_idx[2];
+  int i, j;
+
+  /* insert interior grid points with (deterministic) pseudorandom */
+  /* values and then extract them in sorted order                  */
+  for (j = g->jlo_fb; j <= g->jhi_fb; j++) {
+    for (i = g->ilo_fb; i <= g->ihi_fb; i++) {
+      unsigned int hash = (unsigned int) (i*73856093) ^
+                          (unsigned int) (j*19349663);
+      grid_idx[0] = i;
+      grid_idx[1] = j;
+      FMM_Heap_insertNode(heap, grid_idx, (hash % 1000003)*1.e-6);
+    }
+  }
+  while (!FMM_Heap_isEmpty(heap)) {
+    FMM_Heap_extractMin(heap, NULL, NULL);
+  }
+
+  FMM_Heap_destroyHeap(heap);
+}
+
+
+static void fmmDistanceFunction_2d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  computeDistanceFunction2d(d->u_next, d->phi, NULL, 2,
+                            g->grid_dims_ghostbox, g->dx);
+}
+
+
+/* 3D kernel wrappers */
+
+static void hjENO1_3d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  LSM3D_HJ_ENO1(
+    d->phi_plus[0], d->phi_plus[1], d->phi_plus[2], GB3D(g),
+    d->phi_minus[0], d->phi_minus[1], d->phi_minus[2], GB3D(g),
+    d->phi, GB3D(g),
+    d->D1, GB3D(g),
+    FB3D(g),
+    DX3D(g));
+}
+
+
+static void hjENO2_3d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  LSM3D_HJ_ENO2(
+    d->phi_plus[0], d->phi_plus[1], d->phi_plus[2], GB3D(g),
+    d->phi_minus[0], d->phi_minus[1], d->phi_minus[2], GB3D(g),
+    d->phi, GB3D(g),
+    d->D1, GB3D(g),
+    d->D2, GB3D(g),
+    FB3D(g),
+    DX3D(g));
+}
+
+
+static void hjENO3_3d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  LSM3D_HJ_ENO3(
+    d->phi_plus[0], d->phi_plus[1], d->phi_plus[2], GB3D(g),
+    d->phi_minus[0], d->phi_minus[1], d->phi_minus[2], GB3D(g),
+    d->phi, GB3D(g),
+    d->D1, GB3D(g),
+    d->D2, GB3D(g),
+    d->D3, GB3D(g),
+    FB3D(g),
+    DX3D(g));
+}
+
+
+static void hjWENO5_3d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  LSM3D_HJ_WENO5(
+    d->phi_plus[0], d->phi_plus[1], d->phi_plus[2], GB3D(g),
+    d->phi_minus[0], d->phi_minus[1], d->phi_minus[2], GB3D(g),
+    d->phi, GB3D(g),
+    d->D1, GB3D(g),
+    FB3D(g),
+    DX3D(g));
+}
+
+
+static void tvdRK3Stage1_3d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  LSMLIB_REAL dt = 0.5*g->dx[0];
+  LSM3D_TVD_RK3_STAGE1(
+    d->u_stage1, GB3D(g),
+    d->phi, GB3D(g),
+    d->rhs, GB3D(g),
+    FB3D(g),
+    &dt);
+}
+
+
+static void tvdRK3Stage2_3d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  LSMLIB_REAL dt = 0.5*g->dx[0];
+  LSM3D_TVD_RK3_STAGE2(
+    d->u_stage2, GB3D(g),
+    d->u_stage1, GB3D(g),
+    d->phi, GB3D(g),
+    d->rhs, GB3D(g),
+    FB3D(g),
+    &dt);
+}
+
+
+static void tvdRK3Stage3_3d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  LSMLIB_REAL dt = 0.5*g->dx[0];
+  LSM3D_TVD_RK3_STAGE3(
+    d->u_next, GB3D(g),
+    d->u_stage2, GB3D(g),
+    d->phi, GB3D(g),
+    d->rhs, GB3D(g),
+    FB3D(g),
+    &dt);
+}
+
+
+static void reinitializationRHS_3d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  int use_phi0_for_sgn = 1;
+  LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS(
+    d->rhs, GB3D(g),
+    d->phi, GB3D(g),
+    d->phi0, GB3D(g),
+    d->phi_plus[0], d->phi_plus[1], d->phi_plus[2], GB3D(g),
+    d->phi_minus[0], d->phi_minus[1], d->phi_minus[2], GB3D(g),
+    FB3D(g),
+    DX3D(g),
+    &use_phi0_for_sgn);
+}
+
+
+static void meanCurvature_3d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  LSM3D_COMPUTE_MEAN_CURVATURE_ORDER2(
+    d->kappa, GB3D(g),
+    d->phi, GB3D(g),
+    d->grad_phi[0], d->grad_phi[1], d->grad_phi[2], d->grad_phi_mag,
+    GB3D(g),
+    FB3D(g),
+    DX3D(g));
+}
+
+
+static void narrowBand_3d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  int nlo_index = 0, nhi_index = g->num_gridpts-1;
+  int nlo_index_outer = 0, nhi_index_outer = g->num_gridpts-1;
+  int nlo_outer_plus, nhi_outer_plus, nlo_outer_minus, nhi_outer_minus;
+  LSMLIB_REAL width = LSM_BENCHMARK_NB_WIDTH*g->dx[0];
+  LSMLIB_REAL width_inner = LSM_BENCHMARK_NB_WIDTH_INNER*g->dx[0];
+  int level = LSM_BENCHMARK_NB_LEVELS;
+  LSM3D_DETERMINE_NARROW_BAND(
+    d->phi, GB3D(g),
+    d->narrow_band, GB3D(g),
+    d->index[0], d->index[1], d->index[2],
+    &nlo_index, &nhi_index,
+    d->n_lo, d->n_hi,
+    d->index_outer,
+    &nlo_index_outer, &nhi_index_outer,
+    &nlo_outer_plus, &nhi_outer_plus,
+    &nlo_outer_minus, &nhi_outer_minus,
+    &width, &width_inner, &level);
+}
+
+
+static void fmmDistanceFunction_3d(KernelBenchmarkData *d)
+{
+  Grid *g = d->grid;
+  computeDistanceFunction3d(d->u_next, d->phi, NULL, 2,
+                            g->grid_dims_ghostbox, g->dx);
+}
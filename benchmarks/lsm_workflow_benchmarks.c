@@ -0,0 +1,1495 @@
+/*
+ * File:        lsm_workflow_benchmarks.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: End-to-end benchmarks for standard level set method
+ *              test problems
+ */
+
+/* System headers */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+/* LSMLIB headers */
+#include "LSMLIB_config.h"
+#include "lsm_level_set_evolution2d.h"
+#include "lsm_spatial_derivatives2d.h"
+#include "lsm_tvd_runge_kutta2d.h"
+#include "lsm_utilities2d.h"
+#include "lsm_geometry2d.h"
+#include "lsm_geometry3d.h"
+#include "lsm_spatial_derivatives3d.h"
+#include "lsm_field_extension3d.h"
+#include "lsm_instrumentation.h"
+
+/* LSMLIB Serial package headers */
+#include "lsm_boundary_conditions.h"
+#include "lsm_curve_evolution.h"
+#include "lsm_curvature_flow.h"
+#include "lsm_data_arrays.h"
+#include "lsm_fast_marching_method.h"
+#include "lsm_grid.h"
+#include "lsm_macros.h"
+#include "lsm_anisotropic_eikonal.h"
+#include "lsm_velocity_extension.h"
+#include "lsm_voxel_image.h"
+
+/* Local headers */
+#include "lsm_benchmark_utilities.h"
+
+
+/*============================= Constants ===========================*/
+
+#define LSM_BENCHMARK_SUITE          "workflows"
+
+#define LSM_BENCHMARK_CFL_NUMBER     (0.5)
+
+/* length of buffer for benchmark-specific output fields */
+#define LSM_BENCHMARK_MAX_EXTRA_LEN  (256)
+
+/* index ranges and grid spacing arguments for toolbox kernels */
+#define GB2D(g)  &((g)->ilo_gb), &((g)->ihi_gb), &((g)->jlo_gb), &((g)->jhi_gb)
+#define FB2D(g)  &((g)->ilo_fb), &((g)->ihi_fb), &((g)->jlo_fb), &((g)->jhi_fb)
+#define D1FB2D(g)                                                          \
+  &((g)->ilo_D1_fb), &((g)->ihi_D1_fb), &((g)->jlo_D1_fb), &((g)->jhi_D1_fb)
+#define D2FB2D(g)                                                          \
+  &((g)->ilo_D2_fb), &((g)->ihi_D2_fb), &((g)->jlo_D2_fb), &((g)->jhi_D2_fb)
+#define DX2D(g)  &((g)->dx[0]), &((g)->dx[1])
+#define FB3D(g)  FB2D(g), &((g)->klo_fb), &((g)->khi_fb)
+#define GB3D(g)  GB2D(g), &((g)->klo_gb), &((g)->khi_gb)
+#define DX3D(g)  DX2D(g), &((g)->dx[2])
+
+/*
+ * Estimated number of data arrays read and written per grid point for
+ * each time step (used to estimate the memory bandwidth):
+ *  - advection with HJ WENO5 and TVD RK3: three stages, each of which
+ *    reads phi and the velocity field and writes the gradient, D1,
+ *    the RHS and the next stage
+ *  - normal velocity and curvature with HJ ENO2 and TVD RK2: two
+ *    stages, each of which computes upwind, central and second
+ *    derivatives before updating phi
+ *  - AOS mean curvature flow: gradient magnitude, one tridiagonal
+ *    solve per direction and the average of the solutions
+ */
+#define LSM_BENCHMARK_ADVECTION_ARRAYS_PER_STEP   (3*(1 + 2 + 2 + 1 + 3 + 2))
+#define LSM_BENCHMARK_IMBIBITION_ARRAYS_PER_STEP  (2*(1 + 4 + 2 + 2 + 3 + 4))
+#define LSM_BENCHMARK_AOS_ARRAYS_PER_STEP         (2 + 3*4 + 2)
+
+/*
+ * Estimated number of data arrays read and written per grid point by
+ * the Eikonal equation solvers:
+ *  - fast marching method: phi, speed, mask and the FMM_Core status
+ *    and heap arrays
+ *  - fast sweeping method (per iteration): phi and the six components
+ *    of the speed tensor for each of the eight sweeps
+ */
+#define LSM_BENCHMARK_FMM_ARRAYS                  (3 + 2)
+#define LSM_BENCHMARK_SWEEPING_ARRAYS_PER_ITER    (8*(1 + 6))
+
+/* radius (in grid cells) of the ball around the point source in */
+/* which the exact solution is imposed                           */
+#define LSM_BENCHMARK_EIKONAL_SOURCE_RADIUS       (3.0)
+
+/*
+ * Estimated number of data arrays read and written per grid point by
+ * the velocity extension calculations:
+ *  - field extension equation (per iteration): the extension field,
+ *    its upwind gradient, D1, the signed normal and the RHS
+ *  - fast marching method: phi, the source field, the distance
+ *    function, the extension field and the FMM_Core status and heap
+ *    arrays
+ *  - narrow band extension with cached ordering: phi, the velocity,
+ *    the classification of grid points and the ordering
+ */
+#define LSM_BENCHMARK_FIELD_EXT_PDE_ARRAYS_PER_ITER  (2 + 3 + 1 + 3 + 1)
+#define LSM_BENCHMARK_FIELD_EXT_FMM_ARRAYS           (4 + 2)
+#define LSM_BENCHMARK_FIELD_EXT_CACHED_ARRAYS        (2 + 1 + 2)
+
+/* width (in grid cells) of the band in which the velocity is extended */
+/* and number of time steps for the velocity extension benchmark       */
+#define LSM_BENCHMARK_FIELD_EXT_BAND_WIDTH        (6.0)
+#define LSM_BENCHMARK_FIELD_EXT_NUM_STEPS         (20)
+
+/*
+ * Estimated number of data arrays read and written per grid point by
+ * the signed distance calculation for voxel images: the labels and
+ * one read and write of phi for each of the three directions
+ */
+#define LSM_BENCHMARK_VOXEL_IMAGE_ARRAYS          (1 + 2*3)
+
+/*
+ * Estimated number of data arrays read per grid point by the cut-cell
+ * volume and surface area calculations: phi for each calculation
+ */
+#define LSM_BENCHMARK_CUT_CELL_ARRAYS             (2)
+
+/*
+ * Estimated number of data arrays read and written per narrow band
+ * point by each pseudo-time step of curve reinitialization: two
+ * stages, each of which reads phi, psi, phi0 and psi0, computes the
+ * upwind derivatives of both functions and updates both functions
+ */
+#define LSM_BENCHMARK_CURVE_REINIT_ARRAYS_PER_ITER (2*(4 + 2*6 + 2*2))
+
+/* inner and outer narrow band widths (in grid cells), number of time */
+/* steps and number of reinitialization iterations for the curve      */
+/* reinitialization benchmark                                         */
+#define LSM_BENCHMARK_CURVE_BETA                  (3.0)
+#define LSM_BENCHMARK_CURVE_GAMMA                 (6.0)
+#define LSM_BENCHMARK_CURVE_NUM_STEPS             (4)
+#define LSM_BENCHMARK_CURVE_NUM_REINIT_ITERS      (5)
+
+
+/*================== Helper Functions Declarations ==================*/
+
+/*
+ * Each workflow benchmark runs the test problem on a grid with n
+ * grid cells in each coordinate direction and writes the result.
+ */
+static void runZalesakDiskBenchmark(
+  const LSM_BenchmarkOptions *options, int n);
+static void runVortexReversalBenchmark(
+  const LSM_BenchmarkOptions *options, int n);
+static void runSphereCurvatureFlowBenchmark(
+  const LSM_BenchmarkOptions *options, int n);
+static void runPorousMediaImbibitionBenchmark(
+  const LSM_BenchmarkOptions *options, int n);
+static void runEikonalPointSourceBenchmark(
+  const LSM_BenchmarkOptions *options, int n);
+static void runVelocityExtensionBenchmark(
+  const LSM_BenchmarkOptions *options, int n);
+static void runVoxelImageBenchmark(
+  const LSM_BenchmarkOptions *options, int n);
+static void runCutCellSphereBenchmark(
+  const LSM_BenchmarkOptions *options, int n);
+static void runCurveReinitializationBenchmark(
+  const LSM_BenchmarkOptions *options, int n);
+
+/*
+ * VelocityFunction sets the external velocity field at time t.
+ */
+typedef void (*VelocityFunction)(LSM_DataArrays *d, Grid *g, LSMLIB_REAL t);
+
+static void setZalesakVelocity(LSM_DataArrays *d, Grid *g, LSMLIB_REAL t);
+static void setVortexVelocity(LSM_DataArrays *d, Grid *g, LSMLIB_REAL t);
+
+/*
+ * advanceAdvectionTVDRK3() advances d->phi by one time step of passive
+ * advection using HJ WENO5 and TVD RK3.
+ */
+static void advanceAdvectionTVDRK3(
+  LSM_DataArrays *d,
+  Grid *g,
+  VelocityFunction velocity,
+  LSMLIB_REAL t,
+  LSMLIB_REAL dt);
+
+/*
+ * computeAdvectionRHS() computes the RHS of the advection equation for
+ * phi_stage (after filling ghostcells).
+ */
+static void computeAdvectionRHS(
+  LSM_DataArrays *d,
+  Grid *g,
+  LSMLIB_REAL *phi_stage);
+
+/*
+ * computeShapeError() computes the area of the symmetric difference
+ * between the regions {phi < 0} and {phi_ref < 0}.
+ */
+static LSMLIB_REAL computeShapeError(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *phi_ref,
+  Grid *g);
+
+/*
+ * computeArea() computes the area of the region {phi < 0} using
+ * cut-cell quadrature.
+ */
+static LSMLIB_REAL computeArea(LSMLIB_REAL *phi, Grid *g);
+
+/*
+ * createDataArrays() allocates LSM_DataArrays for the grid.
+ */
+static LSM_DataArrays *createDataArrays(Grid *g);
+
+/*
+ * getEikonalSpeedTensor() sets the components (D_xx, D_xy, D_xz, D_yy,
+ * D_yz, D_zz) of the speed tensor D and its inverse for the Eikonal
+ * point source benchmark (D = I if isotropic is nonzero).
+ */
+static void getEikonalSpeedTensor(
+  LSMLIB_REAL *D,
+  LSMLIB_REAL *D_inv,
+  int isotropic);
+
+/*
+ * initializeEikonalPointSource() sets phi to the exact solution in a
+ * ball around the center of the n^3 grid on [-1,1]^3 and to -1
+ * elsewhere.
+ * computeEikonalPointSourceError() computes the maximum error of phi.
+ * The exact solution is sqrt(x^T D_inv x) (the distance to the center
+ * if D_inv is NULL).
+ */
+static void initializeEikonalPointSource(
+  LSMLIB_REAL *phi,
+  int n,
+  LSMLIB_REAL h,
+  const LSMLIB_REAL *D_inv);
+static LSMLIB_REAL computeEikonalPointSourceError(
+  LSMLIB_REAL *phi,
+  int n,
+  LSMLIB_REAL h,
+  const LSMLIB_REAL *D_inv);
+static LSMLIB_REAL computeEikonalPointSourceSolution(
+  LSMLIB_REAL x,
+  LSMLIB_REAL y,
+  LSMLIB_REAL z,
+  const LSMLIB_REAL *D_inv);
+
+/*
+ * initializeVelocityExtensionSphere() sets d->phi to the signed
+ * distance to the sphere of radius 0.5 centered at (x_c,0,0) and
+ * d->normal_velocity to a field whose values on the sphere are
+ * 1 + z/(2r) but that varies in the direction normal to the sphere.
+ * computeVelocityExtensionError() computes the maximum error of an
+ * extension velocity in the band |phi| <= band_width.
+ */
+static void initializeVelocityExtensionSphere(
+  LSM_DataArrays *d,
+  Grid *g,
+  LSMLIB_REAL x_c);
+static LSMLIB_REAL computeVelocityExtensionError(
+  LSMLIB_REAL *vel_ext,
+  LSMLIB_REAL *phi,
+  Grid *g,
+  LSMLIB_REAL x_c,
+  LSMLIB_REAL band_width);
+
+/*
+ * extendVelocityUsingFieldExtensionEqn() extends S off of the zero
+ * level set of d->phi by taking num_iterations forward Euler steps
+ * of the field extension equation.
+ */
+static void extendVelocityUsingFieldExtensionEqn(
+  LSM_DataArrays *d,
+  Grid *g,
+  LSMLIB_REAL *S,
+  int num_iterations);
+
+
+/*============================ Benchmarks ===========================*/
+
+typedef struct _WorkflowBenchmark
+{
+  const char *name;
+  void (*run)(const LSM_BenchmarkOptions *options, int n);
+  int grid_sizes[3];
+} WorkflowBenchmark;
+
+static const WorkflowBenchmark s_benchmarks[] = {
+  { "zalesak_disk_2d",             runZalesakDiskBenchmark,
+    { 100, 200, 400 } },
+  { "vortex_reversal_2d",          runVortexReversalBenchmark,
+    { 64, 128, 256 } },
+  { "sphere_curvature_flow_3d",    runSphereCurvatureFlowBenchmark,
+    { 32, 64, 96 } },
+  { "porous_media_imbibition_2d",  runPorousMediaImbibitionBenchmark,
+    { 64, 128, 256 } },
+  { "eikonal_point_source_3d",     runEikonalPointSourceBenchmark,
+    { 32, 64, 96 } },
+  { "velocity_extension_3d",       runVelocityExtensionBenchmark,
+    { 32, 64, 96 } },
+  { "voxel_image_3d",              runVoxelImageBenchmark,
+    { 32, 64, 96 } },
+  { "cut_cell_sphere_3d",          runCutCellSphereBenchmark,
+    { 16, 32, 64 } },
+  { "curve_reinitialization_3d",   runCurveReinitializationBenchmark,
+    { 32, 64, 96 } },
+};
+
+#define NUM_BENCHMARKS   (sizeof(s_benchmarks)/sizeof(WorkflowBenchmark))
+
+
+/*=========================== Main Program ==========================*/
+
+int main(int argc, char **argv)
+{
+  LSM_BenchmarkOptions options;
+  unsigned int b;
+  int size_idx;
+
+  if (LSM_Benchmark_parseOptions(&options, argc, argv)) return 1;
+
+  for (b = 0; b < NUM_BENCHMARKS; b++) {
+    int num_grid_sizes = options.quick ? 1 : 3;
+    if (!LSM_Benchmark_isSelected(&options, s_benchmarks[b].name)) continue;
+
+    for (size_idx = 0; size_idx < num_grid_sizes; size_idx++) {
+      s_benchmarks[b].run(&options, s_benchmarks[b].grid_sizes[size_idx]);
+    }
+  }
+
+  LSM_Benchmark_closeOptions(&options);
+  return 0;
+}
+
+
+/*==================== Helper Functions Definitions =================*/
+
+/*
+ * Zalesak's slotted disk: solid body rotation of a slotted disk
+ * (radius 15, slot width 5, slot length 25) centered at (50,75) in
+ * the domain [0,100]^2 for one revolution.
+ */
+static void runZalesakDiskBenchmark(
+  const LSM_BenchmarkOptions *options, int n)
+{
+  LSMLIB_REAL x_lo[2] = {0.0, 0.0}, x_hi[2] = {100.0, 100.0};
+  int grid_dims[2] = {n, n};
+  LSMLIB_REAL t_final = 628.0;
+  LSMLIB_REAL t = 0.0, dt, cfl_number = LSM_BENCHMARK_CFL_NUMBER;
+  LSMLIB_REAL area_initial, area_final, shape_error;
+  double t_start, wall_time;
+  int num_steps = 0;
+  int i, j, idx;
+  char extra_fields[LSM_BENCHMARK_MAX_EXTRA_LEN];
+  Grid *g = createGridSetGridDims(2, grid_dims, x_lo, x_hi, VERY_HIGH);
+  LSM_DataArrays *d = createDataArrays(g);
+
+  /* initialize phi as the signed distance function of the slotted disk */
+  for (j = 0; j < g->grid_dims_ghostbox[1]; j++) {
+    for (i = 0; i < g->grid_dims_ghostbox[0]; i++) {
+      LSMLIB_REAL x = g->x_lo_ghostbox[0] + g->dx[0]*i;
+      LSMLIB_REAL y = g->x_lo_ghostbox[1] + g->dx[1]*j;
+      LSMLIB_REAL phi_disk = sqrt((x-50)*(x-50) + (y-75)*(y-75)) - 15;
+      LSMLIB_REAL phi_slot = fabs(x-50) - 2.5;
+      if (y - 85 > phi_slot) phi_slot = y - 85;
+      idx = i + j*g->grid_dims_ghostbox[0];
+      d->phi_extra[idx] = (phi_disk > -phi_slot) ? phi_disk : -phi_slot;
+    }
+  }
+  computeDistanceFunction2d(d->phi, d->phi_extra, NULL, 2,
+                            g->grid_dims_ghostbox, g->dx);
+  COPY_DATA(d->phi0, d->phi, g)
+  area_initial = computeArea(d->phi, g);
+
+  /* the velocity field is steady, so the time step is fixed */
+  setZalesakVelocity(d, g, 0.0);
+  LSM2D_COMPUTE_STABLE_ADVECTION_DT(&dt,
+    d->external_velocity_x, d->external_velocity_y, GB2D(g),
+    FB2D(g),
+    DX2D(g),
+    &cfl_number);
+
+  t_start = LSM_Instrumentation_getWallTime();
+  while (t < t_final) {
+    if (t + dt > t_final) dt = t_final - t;
+    advanceAdvectionTVDRK3(d, g, setZalesakVelocity, t, dt);
+    t += dt;
+    num_steps++;
+  }
+  wall_time = LSM_Instrumentation_getWallTime() - t_start;
+
+  area_final = computeArea(d->phi, g);
+  shape_error = computeShapeError(d->phi, d->phi0, g);
+  sprintf(extra_fields,
+          "\"relative_area_change\": %.6g, \"shape_error\": %.6g",
+          (area_final-area_initial)/area_initial, shape_error);
+  LSM_Benchmark_writeResult(options, LSM_BENCHMARK_SUITE,
+    "zalesak_disk_2d", 2, grid_dims, num_steps, wall_time,
+    (double) num_steps*n*n,
+    (double) num_steps*g->num_gridpts*sizeof(LSMLIB_REAL)
+                      *LSM_BENCHMARK_ADVECTION_ARRAYS_PER_STEP,
+    extra_fields);
+
+  destroyLSMDataArrays(d);
+  destroyGrid(g);
+}
+
+
+/*
+ * Vortex reversal: a circle of radius 0.15 centered at (0.5,0.75) in
+ * the unit square is stretched by a single vortex whose direction is
+ * reversed at t = T/2 (T = 2), so the exact solution at t = T is the
+ * initial circle.
+ */
+static void runVortexReversalBenchmark(
+  const LSM_BenchmarkOptions *options, int n)
+{
+  LSMLIB_REAL x_lo[2] = {0.0, 0.0}, x_hi[2] = {1.0, 1.0};
+  int grid_dims[2] = {n, n};
+  LSMLIB_REAL t_final = 2.0;
+  LSMLIB_REAL t = 0.0, dt, cfl_number = LSM_BENCHMARK_CFL_NUMBER;
+  LSMLIB_REAL area_initial, area_final, shape_error;
+  double t_start, wall_time;
+  int num_steps = 0;
+  int i, j;
+  char extra_fields[LSM_BENCHMARK_MAX_EXTRA_LEN];
+  Grid *g = createGridSetGridDims(2, grid_dims, x_lo, x_hi, VERY_HIGH);
+  LSM_DataArrays *d = createDataArrays(g);
+
+  for (j = 0; j < g->grid_dims_ghostbox[1]; j++) {
+    for (i = 0; i < g->grid_dims_ghostbox[0]; i++) {
+      LSMLIB_REAL x = g->x_lo_ghostbox[0] + g->dx[0]*i - 0.5;
+      LSMLIB_REAL y = g->x_lo_ghostbox[1] + g->dx[1]*j - 0.75;
+      d->phi[i + j*g->grid_dims_ghostbox[0]] = sqrt(x*x + y*y) - 0.15;
+    }
+  }
+  COPY_DATA(d->phi0, d->phi, g)
+  area_initial = computeArea(d->phi, g);
+
+  /* the speed is largest at t = 0, so the time step is fixed */
+  setVortexVelocity(d, g, 0.0);
+  LSM2D_COMPUTE_STABLE_ADVECTION_DT(&dt,
+    d->external_velocity_x, d->external_velocity_y, GB2D(g),
+    FB2D(g),
+    DX2D(g),
+    &cfl_number);
+
+  t_start = LSM_Instrumentation_getWallTime();
+  while (t < t_final) {
+    if (t + dt > t_final) dt = t_final - t;
+    advanceAdvectionTVDRK3(d, g, setVortexVelocity, t, dt);
+    t += dt;
+    num_steps++;
+  }
+  wall_time = LSM_Instrumentation_getWallTime() - t_start;
+
+  area_final = computeArea(d->phi, g);
+  shape_error = computeShapeError(d->phi, d->phi0, g);
+  sprintf(extra_fields,
+          "\"relative_area_change\": %.6g, \"shape_error\": %.6g",
+          (area_final-area_initial)/area_initial, shape_error);
+  LSM_Benchmark_writeResult(options, LSM_BENCHMARK_SUITE,
+    "vortex_reversal_2d", 2, grid_dims, num_steps, wall_time,
+    (double) num_steps*n*n,
+    (double) num_steps*g->num_gridpts*sizeof(LSMLIB_REAL)
+                      *LSM_BENCHMARK_ADVECTION_ARRAYS_PER_STEP,
+    extra_fields);
+
+  destroyLSMDataArrays(d);
+  destroyGrid(g);
+}
+
+
+/*
+ * Sphere shrinkage by mean curvature flow: a sphere of radius
+ * R0 = 0.75 evolves under phi_t = kappa |grad phi| (AOS scheme) until
+ * t = 0.1.  The exact radius is R(t) = sqrt(R0^2 - 4t).
+ */
+static void runSphereCurvatureFlowBenchmark(
+  const LSM_BenchmarkOptions *options, int n)
+{
+  LSMLIB_REAL x_lo[3] = {-1.0, -1.0, -1.0}, x_hi[3] = {1.0, 1.0, 1.0};
+  int grid_dims[3] = {n, n, n};
+  LSMLIB_REAL radius = 0.75, b = 1.0, t_final = 0.1;
+  LSMLIB_REAL t = 0.0, dt, volume, radius_exact, radius_final;
+  double t_start, wall_time;
+  int num_steps = 0;
+  int i, j, k, idx;
+  char extra_fields[LSM_BENCHMARK_MAX_EXTRA_LEN];
+  Grid *g = createGridSetGridDims(3, grid_dims, x_lo, x_hi, MEDIUM);
+  LSM_DataArrays *d = createDataArrays(g);
+
+  idx = 0;
+  for (k = 0; k < g->grid_dims_ghostbox[2]; k++) {
+    for (j = 0; j < g->grid_dims_ghostbox[1]; j++) {
+      for (i = 0; i < g->grid_dims_ghostbox[0]; i++, idx++) {
+        LSMLIB_REAL x = g->x_lo_ghostbox[0] + g->dx[0]*i;
+        LSMLIB_REAL y = g->x_lo_ghostbox[1] + g->dx[1]*j;
+        LSMLIB_REAL z = g->x_lo_ghostbox[2] + g->dx[2]*k;
+        d->phi[idx] = sqrt(x*x + y*y + z*z) - radius;
+      }
+    }
+  }
+
+  /* the AOS scheme is unconditionally stable; the time step is */
+  /* chosen for accuracy                                         */
+  dt = 2*g->dx[0]*g->dx[0]/b;
+
+  t_start = LSM_Instrumentation_getWallTime();
+  while (t < t_final) {
+    if (t + dt > t_final) dt = t_final - t;
+    advanceMeanCurvatureFlowAOSForDataArrays(d, g, b, dt, 0);
+    signedLinearExtrapolationBC(d->phi_next, g, ALL_BOUNDARIES);
+    COPY_DATA(d->phi, d->phi_next, g)
+    t += dt;
+    num_steps++;
+  }
+  wall_time = LSM_Instrumentation_getWallTime() - t_start;
+
+  LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO_CUT_CELL(&volume,
+    d->phi, GB3D(g),
+    FB3D(g),
+    DX3D(g));
+  radius_final = pow(3.0*volume/(4.0*M_PI), 1.0/3.0);
+  radius_exact = sqrt(radius*radius - 4*b*t_final);
+  sprintf(extra_fields, "\"relative_radius_error\": %.6g",
+          (radius_final-radius_exact)/radius_exact);
+  LSM_Benchmark_writeResult(options, LSM_BENCHMARK_SUITE,
+    "sphere_curvature_flow_3d", 3, grid_dims, num_steps, wall_time,
+    (double) num_steps*n*n*n,
+    (double) num_steps*g->num_gridpts*sizeof(LSMLIB_REAL)
+                      *LSM_BENCHMARK_AOS_ARRAYS_PER_STEP,
+    extra_fields);
+
+  destroyLSMDataArrays(d);
+  destroyGrid(g);
+}
+
+
+/*
+ * Porous media imbibition: the wetting phase (phi < 0) enters a 2D
+ * granular medium (a 5 x 5 array of circular grains) from the left
+ * boundary under the constant curvature model phi_t + a |grad phi| =
+ * b kappa |grad phi| (a = 1, b = 0.01).  The motion is restricted to
+ * the pore space by imposing the mask (signed distance to the grains)
+ * after each time step.
+ */
+static void runPorousMediaImbibitionBenchmark(
+  const LSM_BenchmarkOptions *options, int n)
+{
+  LSMLIB_REAL x_lo[2] = {0.0, 0.0}, x_hi[2] = {1.0, 1.0};
+  int grid_dims[2] = {n, n};
+  LSMLIB_REAL a = 1.0, b = 0.01, t_final = 0.6;
+  LSMLIB_REAL t = 0.0, dt, dt_curv, cfl_number = LSM_BENCHMARK_CFL_NUMBER;
+  LSMLIB_REAL pore_area, saturation, zero = 0.0;
+  double t_start, wall_time;
+  int num_steps = 0;
+  int i, j, gi, gj, stage;
+  char extra_fields[LSM_BENCHMARK_MAX_EXTRA_LEN];
+  Grid *g = createGridSetGridDims(2, grid_dims, x_lo, x_hi, MEDIUM);
+  LSM_DataArrays *d = createDataArrays(g);
+
+  /* grains are placed on a (slightly perturbed) regular lattice */
+  for (j = 0; j < g->grid_dims_ghostbox[1]; j++) {
+    for (i = 0; i < g->grid_dims_ghostbox[0]; i++) {
+      LSMLIB_REAL x = g->x_lo_ghostbox[0] + g->dx[0]*i;
+      LSMLIB_REAL y = g->x_lo_ghostbox[1] + g->dx[1]*j;
+      int idx = i + j*g->grid_dims_ghostbox[0];
+      LSMLIB_REAL mask = -LSMLIB_REAL_MAX;
+      for (gj = 0; gj < 5; gj++) {
+        for (gi = 0; gi < 5; gi++) {
+          LSMLIB_REAL x_c = 0.1 + 0.2*gi + 0.02*sin(3.0*gi + 7.0*gj);
+          LSMLIB_REAL y_c = 0.1 + 0.2*gj + 0.02*cos(5.0*gi + 2.0*gj);
+          LSMLIB_REAL r_c = 0.075 + 0.01*sin(11.0*gi + 13.0*gj);
+          LSMLIB_REAL dist = r_c - sqrt((x-x_c)*(x-x_c) + (y-y_c)*(y-y_c));
+          if (dist > mask) mask = dist;
+        }
+      }
+      d->mask[idx] = mask;
+      d->phi_extra[idx] = x - 0.05;
+    }
+  }
+  IMPOSE_MASK(d->phi, d->mask, d->phi_extra, g)
+  NEGATE_DATA(d->mask, g)
+  pore_area = computeArea(d->mask, g);
+  NEGATE_DATA(d->mask, g)
+
+  /* explicit time step restriction for the curvature term */
+  dt_curv = 0.25*g->dx[0]*g->dx[0]/b;
+
+  t_start = LSM_Instrumentation_getWallTime();
+  while (t < t_final) {
+
+    /* TVD RK2 time step */
+    for (stage = 0; stage < 2; stage++) {
+      LSMLIB_REAL *phi_stage = (stage == 0) ? d->phi : d->phi_stage1;
+
+      signedLinearExtrapolationBC(phi_stage, g, ALL_BOUNDARIES);
+      SET_DATA_TO_CONSTANT(d->lse_rhs, g, zero)
+
+      /* normal velocity term */
+      LSM2D_HJ_ENO2(
+        d->phi_x_plus, d->phi_y_plus, GB2D(g),
+        d->phi_x_minus, d->phi_y_minus, GB2D(g),
+        phi_stage, GB2D(g),
+        d->D1, GB2D(g),
+        d->D2, GB2D(g),
+        FB2D(g),
+        DX2D(g));
+      LSM2D_ADD_CONST_NORMAL_VEL_TERM_TO_LSE_RHS(
+        d->lse_rhs, GB2D(g),
+        d->phi_x_plus, d->phi_y_plus, GB2D(g),
+        d->phi_x_minus, d->phi_y_minus, GB2D(g),
+        &a,
+        FB2D(g));
+
+      if (stage == 0) {
+        LSM2D_COMPUTE_STABLE_CONST_NORMAL_VEL_DT(&dt, &a,
+          d->phi_x_plus, d->phi_y_plus, GB2D(g),
+          d->phi_x_minus, d->phi_y_minus, GB2D(g),
+          FB2D(g),
+          DX2D(g),
+          &cfl_number);
+        if (dt > dt_curv) dt = dt_curv;
+        if (t + dt > t_final) dt = t_final - t;
+      }
+
+      /* curvature term */
+      LSM2D_CENTRAL_GRAD_ORDER2(
+        d->phi_x, d->phi_y, GB2D(g),
+        phi_stage, GB2D(g),
+        D1FB2D(g),
+        DX2D(g));
+      LSM2D_CENTRAL_GRAD_ORDER2(
+        d->phi_xx, d->phi_xy, GB2D(g),
+        d->phi_x, GB2D(g),
+        D2FB2D(g),
+        DX2D(g));
+      LSM2D_CENTRAL_GRAD_ORDER2(
+        d->phi_xy, d->phi_yy, GB2D(g),
+        d->phi_y, GB2D(g),
+        D2FB2D(g),
+        DX2D(g));
+      LSM2D_ADD_CONST_CURV_TERM_TO_LSE_RHS(
+        d->lse_rhs, GB2D(g),
+        d->phi_x, d->phi_y, GB2D(g),
+        d->phi_xx, d->phi_xy, d->phi_yy, GB2D(g),
+        &b,
+        FB2D(g));
+
+      if (stage == 0) {
+        LSM2D_TVD_RK2_STAGE1(
+          d->phi_stage1, GB2D(g),
+          d->phi, GB2D(g),
+          d->lse_rhs, GB2D(g),
+          FB2D(g),
+          &dt);
+      } else {
+        LSM2D_TVD_RK2_STAGE2(
+          d->phi_next, GB2D(g),
+          d->phi_stage1, GB2D(g),
+          d->phi, GB2D(g),
+          d->lse_rhs, GB2D(g),
+          FB2D(g),
+          &dt);
+      }
+    }
+
+    /* restrict the wetting phase to the pore space */
+    IMPOSE_MASK(d->phi, d->mask, d->phi_next, g)
+
+    t += dt;
+    num_steps++;
+  }
+  wall_time = LSM_Instrumentation_getWallTime() - t_start;
+
+  saturation = computeArea(d->phi, g)/pore_area;
+  sprintf(extra_fields, "\"saturation\": %.6g", saturation);
+  LSM_Benchmark_writeResult(options, LSM_BENCHMARK_SUITE,
+    "porous_media_imbibition_2d", 2, grid_dims, num_steps, wall_time,
+    (double) num_steps*n*n,
+    (double) num_steps*g->num_gridpts*sizeof(LSMLIB_REAL)
+                      *LSM_BENCHMARK_IMBIBITION_ARRAYS_PER_STEP,
+    extra_fields);
+
+  destroyLSMDataArrays(d);
+  destroyGrid(g);
+}
+
+
+/*
+ * Eikonal equation with a point source at the center of [-1,1]^3:
+ * the isotropic solver (fast marching method with unit speed) is
+ * compared with the anisotropic solver (fast sweeping method) for the
+ * identical speed (D = I) and for a rotated, constant speed tensor
+ * with eigenvalues 4, 1 and 1/4.  The exact solution,
+ * sqrt(x^T D^{-1} x), is imposed in a small ball around the source.
+ */
+static void runEikonalPointSourceBenchmark(
+  const LSM_BenchmarkOptions *options, int n)
+{
+  int grid_dims[3] = {n, n, n};
+  int num_gridpts = n*n*n;
+  LSMLIB_REAL h = 2.0/(n-1);
+  LSMLIB_REAL dx[3];
+  LSMLIB_REAL D_inv[6];
+  LSMLIB_REAL *phi = (LSMLIB_REAL*) malloc(num_gridpts*sizeof(LSMLIB_REAL));
+  LSMLIB_REAL *phi_fmm =
+    (LSMLIB_REAL*) malloc(num_gridpts*sizeof(LSMLIB_REAL));
+  LSMLIB_REAL *speed = (LSMLIB_REAL*) malloc(num_gridpts*sizeof(LSMLIB_REAL));
+  LSMLIB_REAL *speed_tensor[6];
+  LSMLIB_REAL max_error, max_difference;
+  double t_start, wall_time;
+  int num_iterations;
+  int isotropic;
+  int c, idx;
+  char extra_fields[LSM_BENCHMARK_MAX_EXTRA_LEN];
+
+  dx[0] = dx[1] = dx[2] = h;
+  for (c = 0; c < 6; c++) {
+    speed_tensor[c] = (LSMLIB_REAL*) malloc(num_gridpts*sizeof(LSMLIB_REAL));
+  }
+
+  /* isotropic solver */
+  for (idx = 0; idx < num_gridpts; idx++) speed[idx] = 1.0;
+  initializeEikonalPointSource(phi_fmm, n, h, NULL);
+  t_start = LSM_Instrumentation_getWallTime();
+  solveEikonalEquation3d(phi_fmm, speed, NULL, 1, grid_dims, dx);
+  wall_time = LSM_Instrumentation_getWallTime() - t_start;
+
+  max_error = computeEikonalPointSourceError(phi_fmm, n, h, NULL);
+  sprintf(extra_fields, "\"max_error\": %.6g", max_error);
+  LSM_Benchmark_writeResult(options, LSM_BENCHMARK_SUITE,
+    "eikonal_point_source_fmm_3d", 3, grid_dims, 1, wall_time,
+    (double) num_gridpts,
+    (double) num_gridpts*sizeof(LSMLIB_REAL)*LSM_BENCHMARK_FMM_ARRAYS,
+    extra_fields);
+
+  /* anisotropic solver with the identical speed and with a rotated */
+  /* speed tensor                                                   */
+  for (isotropic = 1; isotropic >= 0; isotropic--) {
+    LSMLIB_REAL D[6];
+    getEikonalSpeedTensor(D, D_inv, isotropic);
+    for (c = 0; c < 6; c++) {
+      for (idx = 0; idx < num_gridpts; idx++) speed_tensor[c][idx] = D[c];
+    }
+
+    initializeEikonalPointSource(phi, n, h, D_inv);
+    t_start = LSM_Instrumentation_getWallTime();
+    solveAnisotropicEikonalEquation3d(phi, speed_tensor, NULL,
+      LSM_ANISOTROPIC_EIKONAL_DEFAULT_TOLERANCE,
+      LSM_ANISOTROPIC_EIKONAL_DEFAULT_MAX_ITERATIONS, &num_iterations,
+      grid_dims, dx);
+    wall_time = LSM_Instrumentation_getWallTime() - t_start;
+
+    max_error = computeEikonalPointSourceError(phi, n, h, D_inv);
+    if (isotropic) {
+      max_difference = 0.0;
+      for (idx = 0; idx < num_gridpts; idx++) {
+        if (fabs(phi[idx] - phi_fmm[idx]) > max_difference) {
+          max_difference = fabs(phi[idx] - phi_fmm[idx]);
+        }
+      }
+      sprintf(extra_fields,
+        "\"max_error\": %.6g, \"max_difference_from_fmm\": %.6g, "
+        "\"num_iterations\": %d",
+        max_error, max_difference, num_iterations);
+    } else {
+      sprintf(extra_fields,
+        "\"max_error\": %.6g, \"num_iterations\": %d",
+        max_error, num_iterations);
+    }
+    LSM_Benchmark_writeResult(options, LSM_BENCHMARK_SUITE,
+      isotropic ? "eikonal_point_source_sweeping_3d"
+                : "eikonal_point_source_sweeping_anisotropic_3d",
+      3, grid_dims, 1, wall_time,
+      (double) num_gridpts,
+      (double) num_iterations*num_gridpts*sizeof(LSMLIB_REAL)
+                             *LSM_BENCHMARK_SWEEPING_ARRAYS_PER_ITER,
+      extra_fields);
+  }
+
+  for (c = 0; c < 6; c++) free(speed_tensor[c]);
+  free(speed);
+  free(phi_fmm);
+  free(phi);
+}
+
+
+/*
+ * Velocity extension in the time loop: a sphere of radius 0.5 moves
+ * through [-1,1]^3 by a quarter of a grid cell per time step.  At
+ * each time step, the normal velocity is extended off of the sphere
+ * to a band of width LSM_BENCHMARK_FIELD_EXT_BAND_WIDTH grid cells
+ * (1) by iterating the field extension equation until the velocity
+ * has propagated across the band, (2) by the fast marching method
+ * (computeExtensionFields3d()) on the entire grid and (3) by
+ * extendNormalVelocity() with the ordering cached between time steps.
+ */
+static void runVelocityExtensionBenchmark(
+  const LSM_BenchmarkOptions *options, int n)
+{
+  LSMLIB_REAL x_lo[3] = {-1.0, -1.0, -1.0}, x_hi[3] = {1.0, 1.0, 1.0};
+  int grid_dims[3] = {n, n, n};
+  LSMLIB_REAL x_c = 0.0, band_width, max_error;
+  LSMLIB_REAL *extension_fields[1], *source_fields[1];
+  double wall_time[3] = {0.0, 0.0, 0.0};
+  double t_start;
+  int num_pde_iterations;
+  int num_band_pts = 0;
+  int step, idx;
+  char extra_fields[LSM_BENCHMARK_MAX_EXTRA_LEN];
+  Grid *g = createGridSetGridDims(3, grid_dims, x_lo, x_hi, MEDIUM);
+  LSM_DataArrays *d = createDataArrays(g);
+  LSM_VelocityExtension *ext;
+
+  band_width = LSM_BENCHMARK_FIELD_EXT_BAND_WIDTH*g->dx[0];
+  ext = createVelocityExtension(g, band_width);
+
+  /* the field extension equation is solved with CFL number 0.5, */
+  /* so the velocity travels half of a grid cell per iteration   */
+  num_pde_iterations = (int) ceil(LSM_BENCHMARK_FIELD_EXT_BAND_WIDTH
+                                  /LSM_BENCHMARK_CFL_NUMBER);
+
+  extension_fields[0] = d->phi_stage2;
+  source_fields[0] = d->phi_next;
+  for (step = 0; step < LSM_BENCHMARK_FIELD_EXT_NUM_STEPS; step++) {
+    x_c = 0.25*step*g->dx[0];
+    initializeVelocityExtensionSphere(d, g, x_c);
+    COPY_DATA(d->phi_extra, d->normal_velocity, g)
+    COPY_DATA(d->phi_next, d->normal_velocity, g)
+
+    /* field extension equation */
+    t_start = LSM_Instrumentation_getWallTime();
+    extendVelocityUsingFieldExtensionEqn(d, g, d->phi_extra,
+                                         num_pde_iterations);
+    wall_time[0] += LSM_Instrumentation_getWallTime() - t_start;
+
+    /* fast marching method */
+    t_start = LSM_Instrumentation_getWallTime();
+    computeExtensionFields3d(d->phi_stage1, extension_fields, d->phi, NULL,
+      source_fields, NULL, 1, 1, g->grid_dims_ghostbox, g->dx);
+    wall_time[1] += LSM_Instrumentation_getWallTime() - t_start;
+
+    /* narrow band extension with cached ordering */
+    t_start = LSM_Instrumentation_getWallTime();
+    extendNormalVelocityForDataArrays(ext, d, 0);
+    wall_time[2] += LSM_Instrumentation_getWallTime() - t_start;
+  }
+  for (idx = 0; idx < g->num_gridpts; idx++) {
+    if (fabs(d->phi[idx]) <= band_width) num_band_pts++;
+  }
+
+  max_error = computeVelocityExtensionError(d->phi_extra, d->phi, g,
+                                            x_c, band_width);
+  sprintf(extra_fields, "\"max_error\": %.6g, \"iterations_per_step\": %d",
+          max_error, num_pde_iterations);
+  LSM_Benchmark_writeResult(options, LSM_BENCHMARK_SUITE,
+    "velocity_extension_pde_3d", 3, grid_dims,
+    LSM_BENCHMARK_FIELD_EXT_NUM_STEPS, wall_time[0],
+    (double) LSM_BENCHMARK_FIELD_EXT_NUM_STEPS*n*n*n,
+    (double) LSM_BENCHMARK_FIELD_EXT_NUM_STEPS*num_pde_iterations
+             *g->num_gridpts*sizeof(LSMLIB_REAL)
+             *LSM_BENCHMARK_FIELD_EXT_PDE_ARRAYS_PER_ITER,
+    extra_fields);
+
+  max_error = computeVelocityExtensionError(d->phi_stage2, d->phi, g,
+                                            x_c, band_width);
+  sprintf(extra_fields, "\"max_error\": %.6g", max_error);
+  LSM_Benchmark_writeResult(options, LSM_BENCHMARK_SUITE,
+    "velocity_extension_fmm_3d", 3, grid_dims,
+    LSM_BENCHMARK_FIELD_EXT_NUM_STEPS, wall_time[1],
+    (double) LSM_BENCHMARK_FIELD_EXT_NUM_STEPS*n*n*n,
+    (double) LSM_BENCHMARK_FIELD_EXT_NUM_STEPS*g->num_gridpts
+             *sizeof(LSMLIB_REAL)*LSM_BENCHMARK_FIELD_EXT_FMM_ARRAYS,
+    extra_fields);
+
+  max_error = computeVelocityExtensionError(d->normal_velocity, d->phi, g,
+                                            x_c, band_width);
+  sprintf(extra_fields,
+    "\"max_error\": %.6g, \"num_orderings_computed\": %d, "
+    "\"num_orderings_reused\": %d, \"num_deferred\": %d",
+    max_error, ext->num_orderings_computed, ext->num_orderings_reused,
+    ext->num_deferred);
+  LSM_Benchmark_writeResult(options, LSM_BENCHMARK_SUITE,
+    "velocity_extension_cached_3d", 3, grid_dims,
+    LSM_BENCHMARK_FIELD_EXT_NUM_STEPS, wall_time[2],
+    (double) LSM_BENCHMARK_FIELD_EXT_NUM_STEPS*num_band_pts,
+    (double) LSM_BENCHMARK_FIELD_EXT_NUM_STEPS*g->num_gridpts
+             *sizeof(LSMLIB_REAL)*LSM_BENCHMARK_FIELD_EXT_CACHED_ARRAYS,
+    extra_fields);
+
+  destroyVelocityExtension(ext);
+  destroyLSMDataArrays(d);
+  destroyGrid(g);
+}
+
+
+/*
+ * Signed distance from a voxel image: the voxels of an n^3 image of
+ * [-1,1]^3 whose centers lie in a ball of radius 0.5 centered at
+ * (0.1,0.05,-0.05) are labeled 1.  The signed distance function is
+ * computed on grids for each spatial derivative accuracy type (which
+ * differ in the number of ghostcells).  Each voxel must map to the
+ * interior grid point with the same index, so phi must be negative
+ * exactly at the interior grid points of labeled voxels; the number of
+ * interior grid points where this fails is reported as num_mislabeled.
+ */
+static void runVoxelImageBenchmark(
+  const LSM_BenchmarkOptions *options, int n)
+{
+  LSMLIB_REAL x_lo[3] = {-1.0, -1.0, -1.0}, x_hi[3] = {1.0, 1.0, 1.0};
+  LSMLIB_REAL center[3] = {0.1, 0.05, -0.05}, radius = 0.5;
+  int grid_dims[3] = {n, n, n};
+  LSMLIB_SPATIAL_DERIVATIVE_ACCURACY_TYPE accuracy_types[4] =
+    {LOW, MEDIUM, HIGH, VERY_HIGH};
+  const char *accuracy_names[4] = {"LOW", "MEDIUM", "HIGH", "VERY_HIGH"};
+  unsigned char *labels = (unsigned char*) malloc(n*n*n);
+  int a;
+
+  for (a = 0; a < 4; a++) {
+    Grid *g = createGridSetGridDims(3, grid_dims, x_lo, x_hi,
+                                    accuracy_types[a]);
+    LSMLIB_REAL *phi = (LSMLIB_REAL*) malloc(
+      g->num_gridpts*sizeof(LSMLIB_REAL));
+    int num_gc[3];
+    int num_mislabeled = 0;
+    double t_start, wall_time;
+    int i, j, k, dir;
+    char extra_fields[LSM_BENCHMARK_MAX_EXTRA_LEN];
+
+    for (dir = 0; dir < 3; dir++) {
+      num_gc[dir] = (g->grid_dims_ghostbox[dir] - g->grid_dims[dir])/2;
+    }
+
+    /* label voxels using the coordinates of the interior grid points */
+    for (k = 0; k < n; k++) {
+      for (j = 0; j < n; j++) {
+        for (i = 0; i < n; i++) {
+          LSMLIB_REAL x = g->x_lo_ghostbox[0] + g->dx[0]*(i + num_gc[0])
+                        - center[0];
+          LSMLIB_REAL y = g->x_lo_ghostbox[1] + g->dx[1]*(j + num_gc[1])
+                        - center[1];
+          LSMLIB_REAL z = g->x_lo_ghostbox[2] + g->dx[2]*(k + num_gc[2])
+                        - center[2];
+          labels[i + j*n + k*n*n] = (x*x + y*y + z*z < radius*radius);
+        }
+      }
+    }
+
+    t_start = LSM_Instrumentation_getWallTime();
+    computeSignedDistanceFromLabels(phi, NULL, labels,
+      LSM_VOXEL_IMAGE_UINT8, 1, 0, g);
+    wall_time = LSM_Instrumentation_getWallTime() - t_start;
+
+    /* check mapping of voxels to interior grid points */
+    for (k = 0; k < n; k++) {
+      for (j = 0; j < n; j++) {
+        for (i = 0; i < n; i++) {
+          int idx = (i + num_gc[0])
+                  + (j + num_gc[1])*g->grid_dims_ghostbox[0]
+                  + (k + num_gc[2])*g->grid_dims_ghostbox[0]
+                                   *g->grid_dims_ghostbox[1];
+          if ( (phi[idx] < 0) != (1 == labels[i + j*n + k*n*n]) ) {
+            num_mislabeled++;
+          }
+        }
+      }
+    }
+
+    sprintf(extra_fields,
+            "\"accuracy\": \"%s\", \"num_mislabeled\": %d",
+            accuracy_names[a], num_mislabeled);
+    LSM_Benchmark_writeResult(options, LSM_BENCHMARK_SUITE,
+      "voxel_image_signed_distance_3d", 3, grid_dims, 1, wall_time,
+      (double) g->num_gridpts,
+      (double) g->num_gridpts*sizeof(LSMLIB_REAL)
+               *LSM_BENCHMARK_VOXEL_IMAGE_ARRAYS,
+      extra_fields);
+
+    free(phi);
+    destroyGrid(g);
+  }
+
+  free(labels);
+}
+
+
+/*
+ * Cut-cell quadrature for a curved interface: phi is the signed
+ * distance to a sphere of radius 0.6 centered at (0.05,0.02,-0.03) on
+ * an n^3 grid on [-1,1]^3.  The relative errors of the volume of the
+ * region phi < 0 and of the surface area of the zero level set are
+ * reported; both should decrease by a factor of about 4 each time n
+ * is doubled.
+ */
+static void runCutCellSphereBenchmark(
+  const LSM_BenchmarkOptions *options, int n)
+{
+  LSMLIB_REAL x_lo[3] = {-1.0, -1.0, -1.0}, x_hi[3] = {1.0, 1.0, 1.0};
+  LSMLIB_REAL center[3] = {0.05, 0.02, -0.03}, radius = 0.6;
+  int grid_dims[3] = {n, n, n};
+  Grid *g = createGridSetGridDims(3, grid_dims, x_lo, x_hi, MEDIUM);
+  LSMLIB_REAL *phi = (LSMLIB_REAL*) malloc(
+    g->num_gridpts*sizeof(LSMLIB_REAL));
+  LSMLIB_REAL volume, area, volume_exact, area_exact;
+  double t_start, wall_time;
+  int i, j, k, idx = 0;
+  char extra_fields[LSM_BENCHMARK_MAX_EXTRA_LEN];
+
+  for (k = 0; k < g->grid_dims_ghostbox[2]; k++) {
+    for (j = 0; j < g->grid_dims_ghostbox[1]; j++) {
+      for (i = 0; i < g->grid_dims_ghostbox[0]; i++, idx++) {
+        LSMLIB_REAL x = g->x_lo_ghostbox[0] + g->dx[0]*i - center[0];
+        LSMLIB_REAL y = g->x_lo_ghostbox[1] + g->dx[1]*j - center[1];
+        LSMLIB_REAL z = g->x_lo_ghostbox[2] + g->dx[2]*k - center[2];
+        phi[idx] = sqrt(x*x + y*y + z*z) - radius;
+      }
+    }
+  }
+
+  /* for MEDIUM accuracy, the fillbox is the interior box */
+  t_start = LSM_Instrumentation_getWallTime();
+  LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO_CUT_CELL(&volume,
+    phi, GB3D(g),
+    FB3D(g),
+    DX3D(g));
+  LSM3D_SURFACE_AREA_ZERO_LEVEL_SET_CUT_CELL(&area,
+    phi, GB3D(g),
+    FB3D(g),
+    DX3D(g));
+  wall_time = LSM_Instrumentation_getWallTime() - t_start;
+
+  volume_exact = 4.0/3.0*M_PI*radius*radius*radius;
+  area_exact = 4.0*M_PI*radius*radius;
+  sprintf(extra_fields,
+          "\"relative_volume_error\": %.6g, "
+          "\"relative_area_error\": %.6g",
+          (volume-volume_exact)/volume_exact,
+          (area-area_exact)/area_exact);
+  LSM_Benchmark_writeResult(options, LSM_BENCHMARK_SUITE,
+    "cut_cell_sphere_3d", 3, grid_dims, 1, wall_time,
+    (double) g->num_gridpts,
+    (double) g->num_gridpts*sizeof(LSMLIB_REAL)
+             *LSM_BENCHMARK_CUT_CELL_ARRAYS,
+    extra_fields);
+
+  free(phi);
+  destroyGrid(g);
+}
+
+
+/*
+ * Curve reinitialization after a narrow band rebuild: the curve is the
+ * circle of radius 0.5 in the plane z = 0 (phi is the distance to the
+ * cylinder x^2 + y^2 = 0.25 and psi = z) on an n^3 grid on [-1,1]^3.
+ * The circle is translated in the x-direction for a few time steps
+ * (rebuilding the narrow band before and reinitializing phi and psi
+ * after each step).  Then the narrow band is rebuilt and phi and psi
+ * are reinitialized again.  The reinitialization equations are only
+ * solved on level 0 of the narrow band, so the values of phi and psi
+ * at points on the outer levels of the rebuilt narrow band must not
+ * change (even if the right-hand sides at those points were set by
+ * the previous reinitialization); max_outer_level_change (which
+ * should be 0) is the largest change.
+ */
+static void runCurveReinitializationBenchmark(
+  const LSM_BenchmarkOptions *options, int n)
+{
+  LSMLIB_REAL x_lo[3] = {-1.0, -1.0, -1.0}, x_hi[3] = {1.0, 1.0, 1.0};
+  LSMLIB_REAL radius = 0.5;
+  int grid_dims[3] = {n, n, n};
+  Grid *g = createGridSetGridDims(3, grid_dims, x_lo, x_hi, MEDIUM);
+  LSM_CurveEvolutionDataArrays *c = createCurveEvolutionDataArrays(g);
+  LSMLIB_REAL *phi_outer, *psi_outer;
+  LSMLIB_REAL beta = LSM_BENCHMARK_CURVE_BETA*g->dx[0];
+  LSMLIB_REAL gamma = LSM_BENCHMARK_CURVE_GAMMA*g->dx[0];
+  LSMLIB_REAL max_change = 0.0;
+  double t_start, wall_time;
+  int num_outer_pts, num_band_pts;
+  int i, j, k, idx = 0, n_pt, step;
+  char extra_fields[LSM_BENCHMARK_MAX_EXTRA_LEN];
+
+  for (k = 0; k < g->grid_dims_ghostbox[2]; k++) {
+    for (j = 0; j < g->grid_dims_ghostbox[1]; j++) {
+      for (i = 0; i < g->grid_dims_ghostbox[0]; i++, idx++) {
+        LSMLIB_REAL x = g->x_lo_ghostbox[0] + g->dx[0]*i;
+        LSMLIB_REAL y = g->x_lo_ghostbox[1] + g->dx[1]*j;
+        LSMLIB_REAL z = g->x_lo_ghostbox[2] + g->dx[2]*k;
+        c->phi[idx] = sqrt(x*x + y*y) - radius;
+        c->psi[idx] = z;
+        c->external_velocity_x[idx] = 1.0;
+      }
+    }
+  }
+
+  /* translate the curve */
+  for (step = 0; step < LSM_BENCHMARK_CURVE_NUM_STEPS; step++) {
+    LSMLIB_REAL dt;
+    determineCurveEvolutionNarrowBand(c, g, beta, gamma);
+    dt = computeCurveEvolutionStableDt(c, g, LSM_BENCHMARK_CFL_NUMBER);
+    advanceCurveLevelSetsTVDRK(c, g, dt, 2, 2, ALL_BOUNDARIES);
+    reinitializeCurveLevelSets(c, g, LSM_BENCHMARK_CURVE_NUM_REINIT_ITERS,
+                               2, ALL_BOUNDARIES);
+  }
+  determineCurveEvolutionNarrowBand(c, g, beta, gamma);
+
+  /* save phi and psi at points on the outer levels of the narrow band */
+  num_band_pts = c->n_hi[0] - c->n_lo[0] + 1;
+  num_outer_pts = c->num_update_pts - num_band_pts;
+  phi_outer = (LSMLIB_REAL*) malloc((num_outer_pts+1)*sizeof(LSMLIB_REAL));
+  psi_outer = (LSMLIB_REAL*) malloc((num_outer_pts+1)*sizeof(LSMLIB_REAL));
+  for (n_pt = 0; n_pt < num_outer_pts; n_pt++) {
+    idx = c->update_pts[num_band_pts + n_pt];
+    phi_outer[n_pt] = c->phi[idx];
+    psi_outer[n_pt] = c->psi[idx];
+  }
+
+  t_start = LSM_Instrumentation_getWallTime();
+  reinitializeCurveLevelSets(c, g, LSM_BENCHMARK_CURVE_NUM_REINIT_ITERS,
+                             2, ALL_BOUNDARIES);
+  wall_time = LSM_Instrumentation_getWallTime() - t_start;
+
+  for (n_pt = 0; n_pt < num_outer_pts; n_pt++) {
+    idx = c->update_pts[num_band_pts + n_pt];
+    if (fabs(c->phi[idx] - phi_outer[n_pt]) > max_change)
+      max_change = fabs(c->phi[idx] - phi_outer[n_pt]);
+    if (fabs(c->psi[idx] - psi_outer[n_pt]) > max_change)
+      max_change = fabs(c->psi[idx] - psi_outer[n_pt]);
+  }
+
+  sprintf(extra_fields,
+          "\"num_band_pts\": %d, \"num_outer_pts\": %d, "
+          "\"max_outer_level_change\": %.6g",
+          num_band_pts, num_outer_pts, max_change);
+  LSM_Benchmark_writeResult(options, LSM_BENCHMARK_SUITE,
+    "curve_reinitialization_3d", 3, grid_dims,
+    LSM_BENCHMARK_CURVE_NUM_REINIT_ITERS, wall_time,
+    (double) LSM_BENCHMARK_CURVE_NUM_REINIT_ITERS*c->num_update_pts,
+    (double) LSM_BENCHMARK_CURVE_NUM_REINIT_ITERS*c->num_update_pts
+             *sizeof(LSMLIB_REAL)*LSM_BENCHMARK_CURVE_REINIT_ARRAYS_PER_ITER,
+    extra_fields);
+
+  free(phi_outer);
+  free(psi_outer);
+  destroyCurveEvolutionDataArrays(c);
+  destroyGrid(g);
+}
+
+
+static void setZalesakVelocity(LSM_DataArrays *d, Grid *g, LSMLIB_REAL t)
+{
+  int i, j;
+  for (j = 0; j < g->grid_dims_ghostbox[1]; j++) {
+    for (i = 0; i < g->grid_dims_ghostbox[0]; i++) {
+      LSMLIB_REAL x = g->x_lo_ghostbox[0] + g->dx[0]*i;
+      LSMLIB_REAL y = g->x_lo_ghostbox[1] + g->dx[1]*j;
+      int idx = i + j*g->grid_dims_ghostbox[0];
+      d->external_velocity_x[idx] = M_PI/314.0*(50.0 - y);
+      d->external_velocity_y[idx] = M_PI/314.0*(x - 50.0);
+    }
+  }
+}
+
+
+static void setVortexVelocity(LSM_DataArrays *d, Grid *g, LSMLIB_REAL t)
+{
+  LSMLIB_REAL time_factor = cos(M_PI*t/2.0);
+  int i, j;
+  for (j = 0; j < g->grid_dims_ghostbox[1]; j++) {
+    for (i = 0; i < g->grid_dims_ghostbox[0]; i++) {
+      LSMLIB_REAL x = g->x_lo_ghostbox[0] + g->dx[0]*i;
+      LSMLIB_REAL y = g->x_lo_ghostbox[1] + g->dx[1]*j;
+      LSMLIB_REAL sin_x = sin(M_PI*x), sin_y = sin(M_PI*y);
+      int idx = i + j*g->grid_dims_ghostbox[0];
+      d->external_velocity_x[idx] =
+        -sin_x*sin_x*sin(2*M_PI*y)*time_factor;
+      d->external_velocity_y[idx] =
+        sin_y*sin_y*sin(2*M_PI*x)*time_factor;
+    }
+  }
+}
+
+
+static void advanceAdvectionTVDRK3(
+  LSM_DataArrays *d,
+  Grid *g,
+  VelocityFunction velocity,
+  LSMLIB_REAL t,
+  LSMLIB_REAL dt)
+{
+  /* stage 1 */
+  velocity(d, g, t);
+  computeAdvectionRHS(d, g, d->phi);
+  LSM2D_TVD_RK3_STAGE1(
+    d->phi_stage1, GB2D(g),
+    d->phi, GB2D(g),
+    d->lse_rhs, GB2D(g),
+    FB2D(g),
+    &dt);
+
+  /* stage 2 */
+  velocity(d, g, t + dt);
+  computeAdvectionRHS(d, g, d->phi_stage1);
+  LSM2D_TVD_RK3_STAGE2(
+    d->phi_stage2, GB2D(g),
+    d->phi_stage1, GB2D(g),
+    d->phi, GB2D(g),
+    d->lse_rhs, GB2D(g),
+    FB2D(g),
+    &dt);
+
+  /* stage 3 */
+  velocity(d, g, t + 0.5*dt);
+  computeAdvectionRHS(d, g, d->phi_stage2);
+  LSM2D_TVD_RK3_STAGE3(
+    d->phi_next, GB2D(g),
+    d->phi_stage2, GB2D(g),
+    d->phi, GB2D(g),
+    d->lse_rhs, GB2D(g),
+    FB2D(g),
+    &dt);
+
+  COPY_DATA(d->phi, d->phi_next, g)
+}
+
+
+static void computeAdvectionRHS(
+  LSM_DataArrays *d,
+  Grid *g,
+  LSMLIB_REAL *phi_stage)
+{
+  LSMLIB_REAL zero = 0.0;
+
+  signedLinearExtrapolationBC(phi_stage, g, ALL_BOUNDARIES);
+  SET_DATA_TO_CONSTANT(d->lse_rhs, g, zero)
+
+  LSM2D_UPWIND_HJ_WENO5(
+    d->phi_x, d->phi_y, GB2D(g),
+    phi_stage, GB2D(g),
+    d->external_velocity_x, d->external_velocity_y, GB2D(g),
+    d->D1, GB2D(g),
+    FB2D(g),
+    DX2D(g));
+  LSM2D_ADD_ADVECTION_TERM_TO_LSE_RHS(
+    d->lse_rhs, GB2D(g),
+    d->phi_x, d->phi_y, GB2D(g),
+    d->external_velocity_x, d->external_velocity_y, GB2D(g),
+    FB2D(g));
+}
+
+
+static LSMLIB_REAL computeShapeError(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *phi_ref,
+  Grid *g)
+{
+  LSMLIB_REAL error = 0.0;
+  int i, j;
+  for (j = g->jlo_fb; j <= g->jhi_fb; j++) {
+    for (i = g->ilo_fb; i <= g->ihi_fb; i++) {
+      int idx = (i - g->ilo_gb) + (j - g->jlo_gb)*g->grid_dims_ghostbox[0];
+      if ( (phi[idx] < 0) != (phi_ref[idx] < 0) ) error += 1;
+    }
+  }
+  return error*g->dx[0]*g->dx[1];
+}
+
+
+static LSMLIB_REAL computeArea(LSMLIB_REAL *phi, Grid *g)
+{
+  LSMLIB_REAL area;
+  LSM2D_AREA_REGION_PHI_LESS_THAN_ZERO_CUT_CELL(&area,
+    phi, GB2D(g),
+    FB2D(g),
+    DX2D(g));
+  return area;
+}
+
+
+static LSM_DataArrays *createDataArrays(Grid *g)
+{
+  LSM_DataArrays *d = allocateLSMDataArrays();
+  allocateMemoryForLSMDataArrays(d, g);
+  return d;
+}
+
+
+static void getEikonalSpeedTensor(
+  LSMLIB_REAL *D,
+  LSMLIB_REAL *D_inv,
+  int isotropic)
+{
+  /* eigenvalues of D and rotation (about the z-axis followed by a */
+  /* rotation about the x-axis)                                    */
+  LSMLIB_REAL lambda[3] = {4.0, 1.0, 0.25};
+  LSMLIB_REAL theta = M_PI/6, psi = M_PI/5;
+  LSMLIB_REAL R[3][3];
+  int a, b, m, c;
+  int component[6][2] = { {0,0}, {0,1}, {0,2}, {1,1}, {1,2}, {2,2} };
+
+  if (isotropic) {
+    for (c = 0; c < 6; c++) {
+      D[c] = D_inv[c] = (component[c][0] == component[c][1]) ? 1.0 : 0.0;
+    }
+    return;
+  }
+
+  R[0][0] = cos(theta);  R[0][1] = -sin(theta)*cos(psi);
+  R[0][2] = sin(theta)*sin(psi);
+  R[1][0] = sin(theta);  R[1][1] = cos(theta)*cos(psi);
+  R[1][2] = -cos(theta)*sin(psi);
+  R[2][0] = 0.0;         R[2][1] = sin(psi);
+  R[2][2] = cos(psi);
+
+  /* D = R diag(lambda) R^T, D_inv = R diag(1/lambda) R^T */
+  for (c = 0; c < 6; c++) {
+    a = component[c][0];
+    b = component[c][1];
+    D[c] = D_inv[c] = 0.0;
+    for (m = 0; m < 3; m++) {
+      D[c] += R[a][m]*lambda[m]*R[b][m];
+      D_inv[c] += R[a][m]/lambda[m]*R[b][m];
+    }
+  }
+}
+
+
+static void initializeEikonalPointSource(
+  LSMLIB_REAL *phi,
+  int n,
+  LSMLIB_REAL h,
+  const LSMLIB_REAL *D_inv)
+{
+  LSMLIB_REAL radius = LSM_BENCHMARK_EIKONAL_SOURCE_RADIUS*h;
+  int i, j, k, idx;
+
+  idx = 0;
+  for (k = 0; k < n; k++) {
+    for (j = 0; j < n; j++) {
+      for (i = 0; i < n; i++, idx++) {
+        LSMLIB_REAL x = -1.0 + h*i, y = -1.0 + h*j, z = -1.0 + h*k;
+        phi[idx] = (x*x + y*y + z*z <= radius*radius)
+                 ? computeEikonalPointSourceSolution(x, y, z, D_inv) : -1.0;
+      }
+    }
+  }
+}
+
+
+static LSMLIB_REAL computeEikonalPointSourceError(
+  LSMLIB_REAL *phi,
+  int n,
+  LSMLIB_REAL h,
+  const LSMLIB_REAL *D_inv)
+{
+  LSMLIB_REAL max_error = 0.0;
+  int i, j, k, idx;
+
+  idx = 0;
+  for (k = 0; k < n; k++) {
+    for (j = 0; j < n; j++) {
+      for (i = 0; i < n; i++, idx++) {
+        LSMLIB_REAL x = -1.0 + h*i, y = -1.0 + h*j, z = -1.0 + h*k;
+        LSMLIB_REAL error = fabs(phi[idx]
+          - computeEikonalPointSourceSolution(x, y, z, D_inv));
+        if (error > max_error) max_error = error;
+      }
+    }
+  }
+  return max_error;
+}
+
+
+static LSMLIB_REAL computeEikonalPointSourceSolution(
+  LSMLIB_REAL x,
+  LSMLIB_REAL y,
+  LSMLIB_REAL z,
+  const LSMLIB_REAL *D_inv)
+{
+  if (!D_inv) return sqrt(x*x + y*y + z*z);
+  return sqrt(D_inv[0]*x*x + D_inv[3]*y*y + D_inv[5]*z*z
+            + 2.0*(D_inv[1]*x*y + D_inv[2]*x*z + D_inv[4]*y*z));
+}
+
+
+static void initializeVelocityExtensionSphere(
+  LSM_DataArrays *d,
+  Grid *g,
+  LSMLIB_REAL x_c)
+{
+  int i, j, k, idx;
+
+  idx = 0;
+  for (k = 0; k < g->grid_dims_ghostbox[2]; k++) {
+    for (j = 0; j < g->grid_dims_ghostbox[1]; j++) {
+      for (i = 0; i < g->grid_dims_ghostbox[0]; i++, idx++) {
+        LSMLIB_REAL x = g->x_lo_ghostbox[0] + g->dx[0]*i - x_c;
+        LSMLIB_REAL y = g->x_lo_ghostbox[1] + g->dx[1]*j;
+        LSMLIB_REAL z = g->x_lo_ghostbox[2] + g->dx[2]*k;
+        LSMLIB_REAL r = sqrt(x*x + y*y + z*z);
+        d->phi[idx] = r - 0.5;
+        d->normal_velocity[idx] = 1.0 + 0.5*z/(r + LSMLIB_ZERO_TOL)
+                                + 4.0*(r - 0.5);
+      }
+    }
+  }
+}
+
+
+static LSMLIB_REAL computeVelocityExtensionError(
+  LSMLIB_REAL *vel_ext,
+  LSMLIB_REAL *phi,
+  Grid *g,
+  LSMLIB_REAL x_c,
+  LSMLIB_REAL band_width)
+{
+  LSMLIB_REAL max_error = 0.0;
+  int i, j, k;
+
+  for (k = g->klo_fb; k <= g->khi_fb; k++) {
+    for (j = g->jlo_fb; j <= g->jhi_fb; j++) {
+      for (i = g->ilo_fb; i <= g->ihi_fb; i++) {
+        int idx = (i - g->ilo_gb) + (j - g->jlo_gb)*g->grid_dims_ghostbox[0]
+                + (k - g->klo_gb)*g->grid_dims_ghostbox[0]
+                                 *g->grid_dims_ghostbox[1];
+        LSMLIB_REAL x = g->x_lo_ghostbox[0] + g->dx[0]*(i - g->ilo_gb) - x_c;
+        LSMLIB_REAL y = g->x_lo_ghostbox[1] + g->dx[1]*(j - g->jlo_gb);
+        LSMLIB_REAL z = g->x_lo_ghostbox[2] + g->dx[2]*(k - g->klo_gb);
+        LSMLIB_REAL r = sqrt(x*x + y*y + z*z);
+        LSMLIB_REAL error;
+
+        if (fabs(phi[idx]) > band_width) continue;
+        error = fabs(vel_ext[idx] - (1.0 + 0.5*z/(r + LSMLIB_ZERO_TOL)));
+        if (error > max_error) max_error = error;
+      }
+    }
+  }
+  return max_error;
+}
+
+
+static void extendVelocityUsingFieldExtensionEqn(
+  LSM_DataArrays *d,
+  Grid *g,
+  LSMLIB_REAL *S,
+  int num_iterations)
+{
+  LSMLIB_REAL dt = LSM_BENCHMARK_CFL_NUMBER*g->dx[0];
+  int iteration, idx;
+
+  /* the signed normal is computed once since phi does not change */
+  LSM3D_CENTRAL_GRAD_ORDER2(
+    d->phi_x, d->phi_y, d->phi_z, GB3D(g),
+    d->phi, GB3D(g),
+    FB3D(g),
+    DX3D(g));
+  LSM3D_COMPUTE_SIGNED_UNIT_NORMAL(
+    d->external_velocity_x, d->external_velocity_y,
+    d->external_velocity_z, GB3D(g),
+    d->phi_x, d->phi_y, d->phi_z, GB3D(g),
+    d->phi, GB3D(g),
+    FB3D(g),
+    DX3D(g));
+
+  for (iteration = 0; iteration < num_iterations; iteration++) {
+    homogeneousNeumannBC(S, g, ALL_BOUNDARIES);
+    LSM3D_UPWIND_HJ_ENO1(
+      d->phi_xx, d->phi_yy, d->phi_zz, GB3D(g),
+      S, GB3D(g),
+      d->external_velocity_x, d->external_velocity_y,
+      d->external_velocity_z, GB3D(g),
+      d->D1, GB3D(g),
+      FB3D(g),
+      DX3D(g));
+    LSM3D_COMPUTE_FIELD_EXTENSION_EQN_RHS(
+      d->lse_rhs, GB3D(g),
+      S, GB3D(g),
+      d->phi, GB3D(g),
+      d->phi_xx, d->phi_yy, d->phi_zz, GB3D(g),
+      d->external_velocity_x, d->external_velocity_y,
+      d->external_velocity_z, GB3D(g),
+      FB3D(g),
+      DX3D(g));
+    for (idx = 0; idx < g->num_gridpts; idx++) {
+      S[idx] += dt*d->lse_rhs[idx];
+    }
+  }
+}
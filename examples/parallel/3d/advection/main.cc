@@ -321,8 +321,12 @@ int main(int argc, char *argv[])
     if (end_time - current_time < dt) dt = end_time - current_time;
     pout << "  dt:  " << dt << endl;
 
-    // advance level set functions
-    lsm_algorithm->advanceLevelSetFunctions(dt);
+    // advance level set functions (regridding the PatchHierarchy
+    // if the zero level set has moved out of the refined region)
+    bool regrid_needed = lsm_algorithm->advanceLevelSetFunctions(dt);
+    if (regrid_needed) {
+      lsm_algorithm->regridPatchHierarchy();
+    }
  
     // add an extra line to output for aesthetic reasons
     pout << endl;
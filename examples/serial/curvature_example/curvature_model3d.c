@@ -27,6 +27,7 @@
 
 /* LSMLIB Serial package headers */
 #include "lsm_boundary_conditions.h"
+#include "lsm_curvature_flow.h"
 #include "lsm_macros.h"
 
 /* Local headers */
@@ -196,9 +197,14 @@ void curvatureModelMedium3dMainLoop(
 		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),		    
 		    &cfl_number);  
       }
+      else if( o->semi_implicit )
+      {
+         /* curvature term does not restrict dt; use unit speed CFL */
+         dt = cfl_number*(g->dx)[0];
+      }
       else dt = tplot;
      
-      if( o->b > 0)
+      if( (o->b > 0) && !(o->semi_implicit) )
       {
 	/* Compute derivatives needed for curvature term*/
 	LSM3D_CENTRAL_GRAD_ORDER2(d->phi_x, d->phi_y, d->phi_z,
@@ -331,7 +337,7 @@ void curvatureModelMedium3dMainLoop(
 		    &(g->klo_fb), &(g->khi_fb));	    
       }
       
-      if( o->b )
+      if( o->b && !(o->semi_implicit) )
       {
 	LSM3D_CENTRAL_GRAD_ORDER2(d->phi_x,d->phi_y,d->phi_z,
                     &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
@@ -412,6 +418,16 @@ void curvatureModelMedium3dMainLoop(
       /* masking enforced so that the interface stays within pore space */	 
        if(o->do_mask) IMPOSE_MASK(d->phi,d->mask,d->phi_next,g)  
        else           COPY_DATA(d->phi,d->phi_next,g)
+
+      if( (o->b > 0) && o->semi_implicit )
+      { 
+        /* semi-implicit (AOS) step for the curvature term */
+        advanceMeanCurvatureFlowAOSForDataArrays(d,g,o->b,dt,0);
+	
+        signedLinearExtrapolationBC(d->phi_next,g,bdry_location_idx);
+        if(o->do_mask) IMPOSE_MASK(d->phi,d->mask,d->phi_next,g)  
+        else           COPY_DATA(d->phi,d->phi_next,g)
+      }
        
       dt_sub = dt_sub + dt;
    } /*inner loop */
@@ -72,6 +72,7 @@ Options *createOptionsDefault(void)
   /* User additions */
   
   options->print_details = 1;
+  options->semi_implicit = 0;
   
   /* end User additions */
     
@@ -107,6 +108,7 @@ Options *copyOptions(Options *options_src)
   /* User additions */
   
   options->print_details = options_src->print_details;
+  options->semi_implicit = options_src->semi_implicit;
     
   /* end User additions */
     
@@ -269,6 +271,18 @@ Options *createOptionsFromInputFile(char *filename)
 	  options->print_details =  1;
        }    
     }
+    else if( c == 's' && (tolower(line[n+1]) == 'e') )
+    {  /* 'semi_implicit' */
+       sscanf(line+n,"%*s %d ",&tmp1);
+       if( (tmp1 == 0) || (tmp1 == 1))
+           options->semi_implicit = tmp1;
+       else
+       {
+	  printf("\nIncorrect semi_implicit option %d, set to default.\n",
+	                                                           tmp1);
+	  options->semi_implicit =  0;
+       }    
+    }
     
     /* end User additions */
   }
@@ -307,6 +321,8 @@ void  printOptions(Options *options,FILE *fp)
   /* User additions */
   fprintf(fp,"  print_details %4d [ print details (1) or not (0)   ]\n",
                                                         options->print_details);
+  fprintf(fp,"  semi_implicit %4d [ semi-implicit (1) or explicit (0) curvature term ]\n",
+                                                        options->semi_implicit);
   /* end User additions */
 }
 
@@ -71,6 +71,8 @@ typedef struct _Options
    /* User additions */
    
    int    print_details;    /* whether to print details (1) or not (0) */  
+   int    semi_implicit;    /* treat curvature term semi-implicitly (1) 
+                               or explicitly (0) */
    
    /* end User additions */
 
@@ -0,0 +1,77 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% ADVANCE_LEVEL_SET_TVDRK_3D() advances a three-dimensional level set
+% function in time by taking a sequence of TVD Runge-Kutta time steps.
+% The entire time loop (spatial derivatives, right-hand side of the
+% level set evolution equation and TVD Runge-Kutta stages) runs in
+% compiled code with scratch memory that is allocated once per call.
+%
+% Usage:  [phi, num_steps_taken] = ADVANCE_LEVEL_SET_TVDRK_3D( ...
+%                                    phi, velocity, ...
+%                                    ghostcell_width, dX, ...
+%                                    dt, num_steps, ...
+%                                    spatial_derivative_order, ...
+%                                    tvdrk_order, ...
+%                                    stop_tol, ...
+%                                    narrow_band_width)
+%
+% Arguments:
+% - phi:                       level set function at t = t_cur
+% - velocity:                  velocity field (cell array)
+% - ghostcell_width:           ghostcell width for phi
+% - dX:                        array containing the grid spacing
+%                                in coordinate directions
+% - dt:                        time step
+% - num_steps:                 maximum number of time steps to take
+% - spatial_derivative_order:  order of discretization for spatial
+%                                derivative (default = 5)
+% - tvdrk_order:               order of discretization for time
+%                                integration (default = 3)
+% - stop_tol:                  stopping tolerance (default = 0)
+% - narrow_band_width:         width of narrow band (default = 0)
+%
+% Return value:
+% - phi:                       level set function at
+%                                t = t_cur + num_steps_taken*dt
+% - num_steps_taken:           number of time steps taken
+%
+% NOTES:
+% - As in computeLevelSetEvolutionEqnRHS(), the velocity _must_ be
+%   passed in as a cell array.  When velocity has three cells, they
+%   hold the x-, y- and z-components of an external (vector) velocity
+%   field.  When velocity has one cell, it holds the normal velocity.
+%   The velocity is held fixed over all time steps.
+%
+% - The velocity data arrays must be the same size and may be smaller
+%   than the phi data array (but no smaller than the phi data array with
+%   ghostcells removed).
+%
+% - The time loop stops early when max |phi^{n+1} - phi^n|/dt is less
+%   than stop_tol (i.e. when phi has reached a steady state).  When
+%   stop_tol is zero, num_steps time steps are always taken.
+%
+% - When narrow_band_width is positive, only grid points where
+%   |phi| < narrow_band_width at the beginning of the call are updated,
+%   and the right-hand side of the level set evolution equation is
+%   multiplied by the cut-off function of Peng et al. (1999) with an
+%   inner width of 2/3 narrow_band_width.  Because the narrow band is
+%   not rebuilt during the call, the zero level set should not move
+%   more than a few grid cells over num_steps time steps.  Narrow band
+%   calculations are only supported for spatial_derivative_order equal
+%   to 1 or 2 and require ghostcell_width to be at least 3.
+%
+% - The values of phi in the ghostcells are not changed.
+%
+% - All data arrays are assumed to be in the order generated by the
+%   MATLAB meshgrid() function.  That is, data corresponding to the
+%   point (x_i,y_j,z_k) is stored at index (j,i,k).
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% Copyrights: (c) 2005 The Trustees of Princeton University and Board of
+%                 Regents of the University of Texas.  All rights reserved.
+%             (c) 2009 Kevin T. Chu.  All rights reserved.
+% Revision:   $Revision$
+% Modified:   $Date$
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -0,0 +1,561 @@
+/*
+ * File:        REINITIALIZE_LEVEL_SET_FUNCTION_3D.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: MATLAB/Octave MEX-file for reinitializing a level set
+ *              function to be a signed distance function
+ */
+
+/*=======================================================================
+ *
+ * REINITIALIZE_LEVEL_SET_FUNCTION_3D() reinitializes a three-dimensional
+ * level set function to be a signed distance function.  The entire
+ * iteration loop (spatial derivatives, right-hand side of the
+ * reinitialization equation and TVD Runge-Kutta stages) runs in compiled
+ * code with scratch memory that is allocated once per call.
+ *
+ * Usage:  [phi, num_iterations] = REINITIALIZE_LEVEL_SET_FUNCTION_3D( ...
+ *                                   phi_init, ghostcell_width, dX, ...
+ *                                   max_iterations, ...
+ *                                   spatial_derivative_order, ...
+ *                                   tvdrk_order, ...
+ *                                   stop_tol, ...
+ *                                   narrow_band_width)
+ *
+ * Arguments:
+ * - phi_init:                  initial level set function
+ * - ghostcell_width:           ghostcell width for phi
+ * - dX:                        array containing the grid spacing
+ *                                in coordinate directions
+ * - max_iterations:            maximum number of reinitialization steps
+ *                                to take (default = 100)
+ * - spatial_derivative_order:  order of discretization for spatial
+ *                                derivative (default = 5)
+ * - tvdrk_order:               order of discretization for time
+ *                                integration (default = 3)
+ * - stop_tol:                  stopping tolerance (default = 0)
+ * - narrow_band_width:         width of narrow band (default = 0)
+ *
+ * Return value:
+ * - phi:                       reinitialized level set function
+ * - num_iterations:            number of reinitialization steps taken
+ *
+ * NOTES:
+ * - The iteration stops early when max |phi^{n+1} - phi^n|/dt is less
+ *   than stop_tol.  When stop_tol is zero, max_iterations steps are
+ *   always taken.
+ *
+ * - When narrow_band_width is positive, only grid points where
+ *   |phi_init| < narrow_band_width are updated; all other values of phi
+ *   are left unchanged.  The narrow band is determined once at the
+ *   beginning of the call.  Narrow band calculations are only supported
+ *   for spatial_derivative_order equal to 1 or 2 and require
+ *   ghostcell_width to be at least 3.
+ *
+ * - When narrow_band_width is zero, the results are identical to those
+ *   of reinitializeLevelSetFunction().  In particular, the values of phi
+ *   in the ghostcells are not changed.
+ *
+ * - All data arrays are assumed to be in the order generated by the
+ *   MATLAB meshgrid() function.  That is, data corresponding to the
+ *   point (x_i,y_j,z_k) is stored at index (j,i,k).
+ *
+ *=======================================================================*/
+
+#include <math.h>
+#include <string.h>
+#include "mex.h"
+#include "LSMLIB_config.h"
+#include "lsm_localization3d.h"
+#include "lsm_reinitialization3d.h"
+#include "lsm_reinitialization3d_local.h"
+#include "lsm_spatial_derivatives3d.h"
+#include "lsm_spatial_derivatives3d_local.h"
+
+/* Input Arguments */
+#define PHI_INIT                  (prhs[0])
+#define GHOSTCELL_WIDTH           (prhs[1])
+#define DX                        (prhs[2])
+#define MAX_ITERATIONS            (prhs[3])
+#define SPATIAL_DERIVATIVE_ORDER  (prhs[4])
+#define TVDRK_ORDER               (prhs[5])
+#define STOP_TOL                  (prhs[6])
+#define NARROW_BAND_WIDTH         (prhs[7])
+
+/* Output Arguments */
+#define PHI                       (plhs[0])
+#define NUM_ITERATIONS            (plhs[1])
+
+/* Macros */
+#define NDIM                      (3)
+#define NUM_NB_LEVELS             (3)
+#define GB(c)  &((c)->ilo_gb), &((c)->ihi_gb), &((c)->jlo_gb), \
+               &((c)->jhi_gb), &((c)->klo_gb), &((c)->khi_gb)
+#define FB(c)  &((c)->ilo_fb), &((c)->ihi_fb), &((c)->jlo_fb), \
+               &((c)->jhi_fb), &((c)->klo_fb), &((c)->khi_fb)
+#define DXYZ(c) &((c)->dx[0]), &((c)->dx[1]), &((c)->dx[2])
+
+/* marks for boundary layers of the narrow band (see localization) */
+static const unsigned char s_mark_gb = 127;
+static const unsigned char s_mark_D1 = 126;
+static const unsigned char s_mark_D2 = 125;
+static const unsigned char s_mark_fb = 124;
+
+
+/*
+ * ReinitializationContext holds the index space information and the
+ * scratch memory used by every iteration of the reinitialization loop.
+ */
+typedef struct {
+  int ilo_gb, ihi_gb, jlo_gb, jhi_gb, klo_gb, khi_gb;
+  int ilo_fb, ihi_fb, jlo_fb, jhi_fb, klo_fb, khi_fb;
+  LSMLIB_REAL dx[3];
+  int num_gridpts;
+  int spatial_derivative_order;
+
+  LSMLIB_REAL *phi_x_plus, *phi_y_plus, *phi_z_plus;
+  LSMLIB_REAL *phi_x_minus, *phi_y_minus, *phi_z_minus;
+  LSMLIB_REAL *D1, *D2, *D3;
+  LSMLIB_REAL *reinit_rhs;
+  LSMLIB_REAL *phi_cur;
+
+  /* narrow band (unused when use_narrow_band is 0) */
+  int use_narrow_band;
+  unsigned char *narrow_band;
+  int *index_x, *index_y, *index_z;
+  int n_lo[NUM_NB_LEVELS+1], n_hi[NUM_NB_LEVELS+1];
+  int *update_pts;
+  int num_update_pts;
+} ReinitializationContext;
+
+static void determineNarrowBand(ReinitializationContext *c,
+                                const LSMLIB_REAL *phi,
+                                LSMLIB_REAL narrow_band_width,
+                                int ghostcell_width);
+static void computeReinitializationEqnRHS(ReinitializationContext *c,
+                                          const LSMLIB_REAL *phi);
+static LSMLIB_REAL updateStage(ReinitializationContext *c,
+                               LSMLIB_REAL *phi,
+                               const LSMLIB_REAL *phi_cur,
+                               LSMLIB_REAL alpha,
+                               LSMLIB_REAL dt);
+
+
+void mexFunction( int nlhs, mxArray *plhs[],
+                  int nrhs, const mxArray *prhs[] )
+{
+  ReinitializationContext ctx;
+  ReinitializationContext *c = &ctx;
+  LSMLIB_REAL *phi, *phi_init;
+  double *dX;
+  int ghostcell_width;
+  int max_iterations = 100;
+  int tvdrk_order = 3;
+  LSMLIB_REAL stop_tol = 0.0;
+  LSMLIB_REAL narrow_band_width = 0.0;
+  LSMLIB_REAL dt, max_change;
+  int count;
+
+  /* array dimension information */
+  const mwSize *data_array_dims_in;
+  size_t data_size;
+
+  /* Check for proper number of arguments */
+  if ( (nrhs < 3) || (nrhs > 8) ) {
+    mexErrMsgTxt("Three to eight input arguments required.");
+  } else if (nlhs > 2) {
+    mexErrMsgTxt("Too many output arguments.");
+  }
+
+  /* Check that the inputs have the correct floating-point precision */
+#ifdef LSMLIB_DOUBLE_PRECISION
+  if (!mxIsDouble(PHI_INIT)) {
+    mexErrMsgTxt("Incompatible precision: LSMLIB built for double-precision but phi is single-precision");
+  }
+#else
+  if (!mxIsSingle(PHI_INIT)) {
+    mexErrMsgTxt("Incompatible precision: LSMLIB built for single-precision but phi is double-precision");
+  }
+#endif
+
+  /* Parameter Checks */
+  if (mxGetNumberOfDimensions(PHI_INIT) != 3) {
+    mexErrMsgTxt("phi should be a 3 dimensional array.");
+  }
+
+  c->spatial_derivative_order = 5;
+  if ( (nrhs > 3) && !mxIsEmpty(MAX_ITERATIONS) ) {
+    max_iterations = (int) mxGetScalar(MAX_ITERATIONS);
+    if (max_iterations < 0) max_iterations = 100;
+  }
+  if ( (nrhs > 4) && !mxIsEmpty(SPATIAL_DERIVATIVE_ORDER) ) {
+    c->spatial_derivative_order = (int) mxGetScalar(SPATIAL_DERIVATIVE_ORDER);
+  }
+  if ( (nrhs > 5) && !mxIsEmpty(TVDRK_ORDER) ) {
+    tvdrk_order = (int) mxGetScalar(TVDRK_ORDER);
+  }
+  if ( (nrhs > 6) && !mxIsEmpty(STOP_TOL) ) {
+    stop_tol = mxGetScalar(STOP_TOL);
+  }
+  if ( (nrhs > 7) && !mxIsEmpty(NARROW_BAND_WIDTH) ) {
+    narrow_band_width = mxGetScalar(NARROW_BAND_WIDTH);
+  }
+  c->use_narrow_band = (narrow_band_width > 0);
+
+  if ( (c->spatial_derivative_order != 1)
+    && (c->spatial_derivative_order != 2)
+    && (c->spatial_derivative_order != 3)
+    && (c->spatial_derivative_order != 5) ) {
+    mexErrMsgTxt("Invalid spatial derivative order...only 1, 2, 3, and 5 are supported");
+  }
+  if ( c->use_narrow_band && (c->spatial_derivative_order > 2) ) {
+    mexErrMsgTxt("Invalid spatial derivative order...only 1 and 2 are supported for narrow band calculations");
+  }
+  if ( (tvdrk_order < 1) || (tvdrk_order > 3) ) {
+    mexErrMsgTxt("Invalid time integration order...only 1, 2, and 3 are supported");
+  }
+
+  /* Get ghostcell_width */
+  ghostcell_width = (int) mxGetScalar(GHOSTCELL_WIDTH);
+
+  /* Get dX (a scalar dX is used for all coordinate directions) */
+  dX = mxGetPr(DX);
+
+  /* Change order of dX to be match MATLAB meshgrid() order for grids. */
+  if (mxGetNumberOfElements(DX) == 1) {
+    c->dx[0] = dX[0]; c->dx[1] = dX[0]; c->dx[2] = dX[0];
+  } else {
+    c->dx[0] = dX[1]; c->dx[1] = dX[0]; c->dx[2] = dX[2];
+  }
+
+  /* Get size of data */
+  data_array_dims_in = mxGetDimensions(PHI_INIT);
+  c->ilo_gb = 1; c->ihi_gb = (int) data_array_dims_in[0];
+  c->jlo_gb = 1; c->jhi_gb = (int) data_array_dims_in[1];
+  c->klo_gb = 1; c->khi_gb = (int) data_array_dims_in[2];
+  c->ilo_fb = c->ilo_gb + ghostcell_width;
+  c->ihi_fb = c->ihi_gb - ghostcell_width;
+  c->jlo_fb = c->jlo_gb + ghostcell_width;
+  c->jhi_fb = c->jhi_gb - ghostcell_width;
+  c->klo_fb = c->klo_gb + ghostcell_width;
+  c->khi_fb = c->khi_gb - ghostcell_width;
+  c->num_gridpts = (int) mxGetNumberOfElements(PHI_INIT);
+  data_size = c->num_gridpts*sizeof(LSMLIB_REAL);
+
+  /* Create output array and copy initial data */
+  PHI = mxDuplicateArray(PHI_INIT);
+  phi = (LSMLIB_REAL*) mxGetData(PHI);
+  phi_init = (LSMLIB_REAL*) mxGetData(PHI_INIT);
+
+  /* Allocate scratch memory (mxMalloc() aborts the MEX-file on failure) */
+  c->phi_x_plus  = (LSMLIB_REAL*) mxMalloc(data_size);
+  c->phi_y_plus  = (LSMLIB_REAL*) mxMalloc(data_size);
+  c->phi_z_plus  = (LSMLIB_REAL*) mxMalloc(data_size);
+  c->phi_x_minus = (LSMLIB_REAL*) mxMalloc(data_size);
+  c->phi_y_minus = (LSMLIB_REAL*) mxMalloc(data_size);
+  c->phi_z_minus = (LSMLIB_REAL*) mxMalloc(data_size);
+  c->D1 = (LSMLIB_REAL*) mxMalloc(data_size);
+  c->D2 = (c->spatial_derivative_order > 1)
+        ? (LSMLIB_REAL*) mxMalloc(data_size) : 0;
+  c->D3 = (c->spatial_derivative_order == 3)
+        ? (LSMLIB_REAL*) mxMalloc(data_size) : 0;
+  c->reinit_rhs = (LSMLIB_REAL*) mxCalloc(c->num_gridpts,
+                                          sizeof(LSMLIB_REAL));
+  c->phi_cur = (LSMLIB_REAL*) mxMalloc(data_size);
+
+  c->narrow_band = 0;
+  c->index_x = 0; c->index_y = 0; c->index_z = 0;
+  c->update_pts = 0;
+  if (c->use_narrow_band) {
+    determineNarrowBand(c, phi_init, narrow_band_width, ghostcell_width);
+  }
+
+  /* compute dt */
+  dt = c->dx[0];
+  if (c->dx[1] < dt) dt = c->dx[1];
+  if (c->dx[2] < dt) dt = c->dx[2];
+  dt *= 0.5;
+
+  /* begin reinitialization loop */
+  count = 0;
+  while (count < max_iterations) {
+
+    /* save phi_cur */
+    memcpy(c->phi_cur, phi, data_size);
+
+    /* take TVDRK time step */
+    computeReinitializationEqnRHS(c, phi);
+    max_change = updateStage(c, phi, c->phi_cur, 0.0, dt);
+
+    if (tvdrk_order == 2) {
+
+      /* complete TVDRK2 time step */
+      computeReinitializationEqnRHS(c, phi);
+      max_change = updateStage(c, phi, c->phi_cur, 0.5, dt);
+
+    } else if (tvdrk_order == 3) {
+
+      /* take TVDRK3 Stage 2 time step */
+      computeReinitializationEqnRHS(c, phi);
+      updateStage(c, phi, c->phi_cur, 0.75, dt);
+
+      /* complete TVDRK3 time step */
+      computeReinitializationEqnRHS(c, phi);
+      max_change = updateStage(c, phi, c->phi_cur, 1.0/3.0, dt);
+    }
+
+    /* update count */
+    count++;
+
+    /* check stopping criterion */
+    if (max_change < stop_tol*dt) break;
+
+  } /* end reinitialization loop */
+
+  /* Return number of iterations */
+  if (nlhs > 1) {
+    NUM_ITERATIONS = mxCreateDoubleScalar((double) count);
+  }
+
+  /* Clean up memory */
+  mxFree(c->phi_x_plus);
+  mxFree(c->phi_y_plus);
+  mxFree(c->phi_z_plus);
+  mxFree(c->phi_x_minus);
+  mxFree(c->phi_y_minus);
+  mxFree(c->phi_z_minus);
+  mxFree(c->D1);
+  if (c->D2) mxFree(c->D2);
+  if (c->D3) mxFree(c->D3);
+  mxFree(c->reinit_rhs);
+  mxFree(c->phi_cur);
+  if (c->use_narrow_band) {
+    mxFree(c->narrow_band);
+    mxFree(c->index_x);
+    mxFree(c->index_y);
+    mxFree(c->index_z);
+    mxFree(c->update_pts);
+  }
+
+  return;
+}
+
+
+/*
+ * determineNarrowBand() determines the narrow band of phi and the list
+ * of grid points (level 0 of the narrow band) that are updated.
+ */
+static void determineNarrowBand(ReinitializationContext *c,
+                                const LSMLIB_REAL *phi,
+                                LSMLIB_REAL narrow_band_width,
+                                int ghostcell_width)
+{
+  int nlo_index = 0, nhi_index = c->num_gridpts - 1;
+  int nlo_outer_plus, nhi_outer_plus, nlo_outer_minus, nhi_outer_minus;
+  int level = NUM_NB_LEVELS;
+  int nx = c->ihi_gb - c->ilo_gb + 1;
+  int nxy = nx*(c->jhi_gb - c->jlo_gb + 1);
+  int *index_outer;
+  int l, n;
+
+  c->narrow_band = (unsigned char*) mxCalloc(c->num_gridpts,
+                                             sizeof(unsigned char));
+  c->index_x = (int*) mxMalloc(c->num_gridpts*sizeof(int));
+  c->index_y = (int*) mxMalloc(c->num_gridpts*sizeof(int));
+  c->index_z = (int*) mxMalloc(c->num_gridpts*sizeof(int));
+  c->update_pts = (int*) mxMalloc(c->num_gridpts*sizeof(int));
+  index_outer = (int*) mxMalloc(c->num_gridpts*sizeof(int));
+
+  LSM3D_DETERMINE_NARROW_BAND(phi, GB(c),
+    c->narrow_band, GB(c),
+    c->index_x, c->index_y, c->index_z,
+    &nlo_index, &nhi_index,
+    c->n_lo, c->n_hi,
+    index_outer, &nlo_index, &nhi_index,
+    &nlo_outer_plus, &nhi_outer_plus,
+    &nlo_outer_minus, &nhi_outer_minus,
+    &narrow_band_width, &narrow_band_width, &level);
+  mxFree(index_outer);
+
+  /* exclude the ghostcells from the fillbox: layer l (counted from */
+  /* the boundary of the ghostbox) is only used for computing       */
+  /* undivided differences of order 2 or lower                      */
+  for (l = ghostcell_width-1; l >= 0; l--) {
+    int ilo = c->ilo_gb + l, ihi = c->ihi_gb - l;
+    int jlo = c->jlo_gb + l, jhi = c->jhi_gb - l;
+    int klo = c->klo_gb + l, khi = c->khi_gb - l;
+    const unsigned char *mark = (l == 0) ? &s_mark_gb
+                              : (l == 1) ? &s_mark_D1 : &s_mark_D2;
+    LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER(c->narrow_band, GB(c),
+      &ilo, &ihi, &jlo, &jhi, &klo, &khi, mark);
+  }
+
+  /* only level 0 of the narrow band is updated */
+  c->num_update_pts = 0;
+  for (n = c->n_lo[0]; n <= c->n_hi[0]; n++) {
+    int idx = (c->index_x[n] - c->ilo_gb)
+            + (c->index_y[n] - c->jlo_gb)*nx
+            + (c->index_z[n] - c->klo_gb)*nxy;
+    if (c->narrow_band[idx] <= s_mark_fb) {
+      c->update_pts[c->num_update_pts++] = idx;
+    }
+  }
+}
+
+
+/*
+ * computeReinitializationEqnRHS() computes the plus and minus HJ ENO/WENO
+ * derivatives of phi and the right-hand side of the reinitialization
+ * equation.
+ */
+static void computeReinitializationEqnRHS(ReinitializationContext *c,
+                                          const LSMLIB_REAL *phi)
+{
+  int use_phi0_for_sgn = 0;
+
+  if (c->use_narrow_band) {
+
+    if (c->spatial_derivative_order == 1) {
+      LSM3D_HJ_ENO1_LOCAL(
+        c->phi_x_plus, c->phi_y_plus, c->phi_z_plus, GB(c),
+        c->phi_x_minus, c->phi_y_minus, c->phi_z_minus, GB(c),
+        phi, GB(c),
+        c->D1, GB(c),
+        DXYZ(c),
+        c->index_x, c->index_y, c->index_z,
+        &(c->n_lo[0]), &(c->n_hi[0]),
+        &(c->n_lo[1]), &(c->n_hi[1]),
+        c->narrow_band, GB(c),
+        &s_mark_fb, &s_mark_D1);
+    } else {
+      LSM3D_HJ_ENO2_LOCAL(
+        c->phi_x_plus, c->phi_y_plus, c->phi_z_plus, GB(c),
+        c->phi_x_minus, c->phi_y_minus, c->phi_z_minus, GB(c),
+        phi, GB(c),
+        c->D1, GB(c),
+        c->D2, GB(c),
+        DXYZ(c),
+        c->index_x, c->index_y, c->index_z,
+        &(c->n_lo[0]), &(c->n_hi[0]),
+        &(c->n_lo[1]), &(c->n_hi[1]),
+        &(c->n_lo[2]), &(c->n_hi[2]),
+        c->narrow_band, GB(c),
+        &s_mark_fb, &s_mark_D1, &s_mark_D2);
+    }
+
+    LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS_LOCAL(
+      c->reinit_rhs, GB(c),
+      phi, GB(c),
+      phi, GB(c),
+      c->phi_x_plus, c->phi_y_plus, c->phi_z_plus, GB(c),
+      c->phi_x_minus, c->phi_y_minus, c->phi_z_minus, GB(c),
+      DXYZ(c),
+      &use_phi0_for_sgn,
+      c->index_x, c->index_y, c->index_z,
+      &(c->n_lo[0]), &(c->n_hi[0]),
+      c->narrow_band, GB(c),
+      &s_mark_fb);
+
+  } else {
+
+    switch (c->spatial_derivative_order) {
+      case 1: {
+        LSM3D_HJ_ENO1(
+          c->phi_x_plus, c->phi_y_plus, c->phi_z_plus, GB(c),
+          c->phi_x_minus, c->phi_y_minus, c->phi_z_minus, GB(c),
+          phi, GB(c),
+          c->D1, GB(c),
+          FB(c),
+          DXYZ(c));
+        break;
+      }
+      case 2: {
+        LSM3D_HJ_ENO2(
+          c->phi_x_plus, c->phi_y_plus, c->phi_z_plus, GB(c),
+          c->phi_x_minus, c->phi_y_minus, c->phi_z_minus, GB(c),
+          phi, GB(c),
+          c->D1, GB(c),
+          c->D2, GB(c),
+          FB(c),
+          DXYZ(c));
+        break;
+      }
+      case 3: {
+        LSM3D_HJ_ENO3(
+          c->phi_x_plus, c->phi_y_plus, c->phi_z_plus, GB(c),
+          c->phi_x_minus, c->phi_y_minus, c->phi_z_minus, GB(c),
+          phi, GB(c),
+          c->D1, GB(c),
+          c->D2, GB(c),
+          c->D3, GB(c),
+          FB(c),
+          DXYZ(c));
+        break;
+      }
+      case 5: {
+        LSM3D_HJ_WENO5(
+          c->phi_x_plus, c->phi_y_plus, c->phi_z_plus, GB(c),
+          c->phi_x_minus, c->phi_y_minus, c->phi_z_minus, GB(c),
+          phi, GB(c),
+          c->D1, GB(c),
+          FB(c),
+          DXYZ(c));
+        break;
+      }
+    }
+
+    LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS(
+      c->reinit_rhs, GB(c),
+      phi, GB(c),
+      phi, GB(c),
+      c->phi_x_plus, c->phi_y_plus, c->phi_z_plus, GB(c),
+      c->phi_x_minus, c->phi_y_minus, c->phi_z_minus, GB(c),
+      FB(c),
+      DXYZ(c),
+      &use_phi0_for_sgn);
+  }
+}
+
+
+/*
+ * updateStage() computes a TVD Runge-Kutta stage
+ *
+ *   phi = alpha*phi_cur + (1-alpha)*(phi + dt*reinit_rhs)
+ *
+ * and returns max |phi - phi_cur| over the updated grid points.
+ */
+static LSMLIB_REAL updateStage(ReinitializationContext *c,
+                               LSMLIB_REAL *phi,
+                               const LSMLIB_REAL *phi_cur,
+                               LSMLIB_REAL alpha,
+                               LSMLIB_REAL dt)
+{
+  LSMLIB_REAL one_minus_alpha = 1.0 - alpha;
+  LSMLIB_REAL max_change = 0.0;
+  int n;
+
+  if (c->use_narrow_band) {
+    for (n = 0; n < c->num_update_pts; n++) {
+      int idx = c->update_pts[n];
+      LSMLIB_REAL change;
+      phi[idx] = alpha*phi_cur[idx]
+               + one_minus_alpha*(phi[idx] + dt*c->reinit_rhs[idx]);
+      change = fabs(phi[idx] - phi_cur[idx]);
+      if (change > max_change) max_change = change;
+    }
+  } else {
+    /* reinit_rhs is zero in the ghostcells */
+    for (n = 0; n < c->num_gridpts; n++) {
+      LSMLIB_REAL change;
+      phi[n] = alpha*phi_cur[n]
+             + one_minus_alpha*(phi[n] + dt*c->reinit_rhs[n]);
+      change = fabs(phi[n] - phi_cur[n]);
+      if (change > max_change) max_change = change;
+    }
+  }
+
+  return max_change;
+}
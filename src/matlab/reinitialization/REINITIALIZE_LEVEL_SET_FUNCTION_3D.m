@@ -0,0 +1,63 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% REINITIALIZE_LEVEL_SET_FUNCTION_3D() reinitializes a three-dimensional
+% level set function to be a signed distance function.  The entire
+% iteration loop (spatial derivatives, right-hand side of the
+% reinitialization equation and TVD Runge-Kutta stages) runs in compiled
+% code with scratch memory that is allocated once per call.
+%
+% Usage:  [phi, num_iterations] = REINITIALIZE_LEVEL_SET_FUNCTION_3D( ...
+%                                   phi_init, ghostcell_width, dX, ...
+%                                   max_iterations, ...
+%                                   spatial_derivative_order, ...
+%                                   tvdrk_order, ...
+%                                   stop_tol, ...
+%                                   narrow_band_width)
+%
+% Arguments:
+% - phi_init:                  initial level set function
+% - ghostcell_width:           ghostcell width for phi
+% - dX:                        array containing the grid spacing
+%                                in coordinate directions
+% - max_iterations:            maximum number of reinitialization steps
+%                                to take (default = 100)
+% - spatial_derivative_order:  order of discretization for spatial
+%                                derivative (default = 5)
+% - tvdrk_order:               order of discretization for time
+%                                integration (default = 3)
+% - stop_tol:                  stopping tolerance (default = 0)
+% - narrow_band_width:         width of narrow band (default = 0)
+%
+% Return value:
+% - phi:                       reinitialized level set function
+% - num_iterations:            number of reinitialization steps taken
+%
+% NOTES:
+% - The iteration stops early when max |phi^{n+1} - phi^n|/dt is less
+%   than stop_tol.  When stop_tol is zero, max_iterations steps are
+%   always taken.
+%
+% - When narrow_band_width is positive, only grid points where
+%   |phi_init| < narrow_band_width are updated; all other values of phi
+%   are left unchanged.  The narrow band is determined once at the
+%   beginning of the call.  Narrow band calculations are only supported
+%   for spatial_derivative_order equal to 1 or 2 and require
+%   ghostcell_width to be at least 3.
+%
+% - When narrow_band_width is zero, the results are identical to those
+%   of reinitializeLevelSetFunction().  In particular, the values of phi
+%   in the ghostcells are not changed.
+%
+% - All data arrays are assumed to be in the order generated by the
+%   MATLAB meshgrid() function.  That is, data corresponding to the
+%   point (x_i,y_j,z_k) is stored at index (j,i,k).
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% Copyrights: (c) 2005 The Trustees of Princeton University and Board of
+%                 Regents of the University of Texas.  All rights reserved.
+%             (c) 2009 Kevin T. Chu.  All rights reserved.
+% Revision:   $Revision$
+% Modified:   $Date$
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
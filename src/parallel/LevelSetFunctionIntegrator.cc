@@ -24,9 +24,11 @@
 // SAMRAI header files
 #include "Box.h"
 #include "BoxArray.h"
+#include "BoxList.h"
 #include "CartesianGridGeometry.h"
 #include "CartesianPatchGeometry.h"
 #include "CellData.h"
+#include "CoarsenOperator.h"
 #include "PatchLevel.h"
 #include "RefineOperator.h"
 #include "VariableContext.h"
@@ -49,6 +51,8 @@ extern "C" {
   #include "lsm_utilities1d.h"
   #include "lsm_utilities2d.h"
   #include "lsm_utilities3d.h"
+  #include "lsm_samrai_f77_utilities.h"
+  #include "lsm_instrumentation.h"
 }
 
 // SAMRAI namespaces
@@ -68,7 +72,7 @@ using namespace pdat;
 #define LSM_DEFAULT_ORTHOGONALIZATION_INTERVAL           (10)
 #define LSM_DEFAULT_ORTHOGONALIZATION_MAX_ITERS          (25)
 #define LSM_DEFAULT_USE_AMR                              (false)
-#define LSM_DEFAULT_REGRID_INTERVAL                      (5)  // KTC - ADJUST
+#define LSM_DEFAULT_REGRID_INTERVAL                      (0)
 #define LSM_DEFAULT_TAG_BUFFER_WIDTH                     (2)  // KTC - ADJUST
 #define LSM_DEFAULT_REFINEMENT_CUTOFF_VALUE              (1.0)  // KTC - ADJUST
 #define LSM_DEFAULT_VERBOSE_MODE                         (false)
@@ -376,6 +380,7 @@ LSMLIB_REAL LevelSetFunctionIntegrator<DIM>::computeStableDt()
  
   // fill boundary data to for phi/psi to be used for computing
   // velocity field
+  LSM_INSTRUMENTATION_START(t_ghost_fill);
   for ( int ln=0 ; ln < num_levels; ln++ ) {
     // NOTE: true indicates that physical boundary conditions should
     //       be set.
@@ -399,6 +404,8 @@ LSMLIB_REAL LevelSetFunctionIntegrator<DIM>::computeStableDt()
         comp);
     }
   }
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_GHOST_FILL,
+    t_ghost_fill, 0, 0);
 
   // loop over PatchHierarchy and compute the maximum stable
   // user-specified dt 
@@ -436,7 +443,10 @@ LSMLIB_REAL LevelSetFunctionIntegrator<DIM>::computeStableDt()
 
   }  // end loop over levels in hierarchy
 
+  LSM_INSTRUMENTATION_START(t_user_dt_reduction);
   max_user_specified_dt = tbox::MPI::minReduction(max_user_specified_dt);
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_REDUCTION, t_user_dt_reduction,
+    sizeof(LSMLIB_REAL), 0);
 
   LSMLIB_REAL max_stable_dt = -1; // temporary value to be set below
   if (max_user_specified_dt < LSMLIB_REAL_MAX) {
@@ -564,7 +574,10 @@ LSMLIB_REAL LevelSetFunctionIntegrator<DIM>::computeStableDt()
      *        (2) the concrete subclass of LevelSetMethodVelocityFieldStrategy
      *            physics_dt forgets to do a reduction
      */
+    LSM_INSTRUMENTATION_START(t_stable_dt_reduction);
     max_stable_dt = tbox::MPI::minReduction(max_stable_dt);
+    LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_REDUCTION,
+      t_stable_dt_reduction, sizeof(LSMLIB_REAL), 0);
 
     if (d_verbose_mode) {
       pout << endl;
@@ -598,6 +611,7 @@ bool LevelSetFunctionIntegrator<DIM>::advanceLevelSetFunctions(
   // if this is the first time step, synchronize data across processors 
   // NOTE:  normally this is done at the end of the time advance
   if (d_current_time == d_start_time) {
+    LSM_INSTRUMENTATION_START(t_ghost_fill);
     for ( int ln=0 ; ln < num_levels; ln++ ) {
       // NOTE: true indicates that physical boundary conditions should
       //       be set.
@@ -622,6 +636,8 @@ bool LevelSetFunctionIntegrator<DIM>::advanceLevelSetFunctions(
           comp);
       }
     }
+    LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_GHOST_FILL,
+      t_ghost_fill, 0, 0);
   } // end synchronization of data for initial time step
 
   // allocate scratch space
@@ -655,6 +671,9 @@ bool LevelSetFunctionIntegrator<DIM>::advanceLevelSetFunctions(
     }
   }
 
+  // replace data on coarser levels with averages of data on finer levels
+  coarsenLevelSetFunctions();
+
   // increment reinitialization and orthogonalization counters
   d_reinitialization_count++;
   d_orthogonalization_count++;
@@ -673,6 +692,8 @@ bool LevelSetFunctionIntegrator<DIM>::advanceLevelSetFunctions(
       d_orthogonalization_evolved_field = PHI;
     }
 
+    coarsenLevelSetFunctions();
+
     // reset orthogonalization counter 
     d_orthogonalization_count = 0;
 
@@ -691,22 +712,28 @@ bool LevelSetFunctionIntegrator<DIM>::advanceLevelSetFunctions(
     if (d_codimension == 2) {
       reinitializeLevelSetFunctions(PSI);
     }
+    coarsenLevelSetFunctions();
 
     // reset reinitialization counter 
     d_reinitialization_count = 0;
   } 
 
-  // determine if patch hierarchy needs to be regridded
-  // KTC - DO SOMETHING SMARTER
-  // regrid patch hierachy
+  // determine if patch hierarchy needs to be regridded.  the
+  // hierarchy is regridded when the zero level set moves out of 
+  // the region covered by finer levels or (if regrid_interval is 
+  // positive) when the maximum number of time steps between regrids 
+  // has been reached.
   bool regrid_needed = false;
-  if (0 == d_regrid_count%d_regrid_interval) 
-  {
-    regrid_needed = true;
-    d_regrid_count = 1;
-  } else {
+  if (d_use_AMR) {
     d_regrid_count++;
-  } 
+    if ( (d_regrid_interval > 0) && 
+         (d_regrid_count >= d_regrid_interval) ) {
+      regrid_needed = true;
+    } else {
+      regrid_needed = zeroLevelSetLeftRefinedRegion();
+    }
+    if (regrid_needed) d_regrid_count = 0;
+  }
 
   // update current time and integrator step
   d_current_time += dt;
@@ -720,6 +747,7 @@ bool LevelSetFunctionIntegrator<DIM>::advanceLevelSetFunctions(
   }
 
   // synchronize data across processors
+  LSM_INSTRUMENTATION_START(t_ghost_fill);
   for ( int ln=0 ; ln < num_levels; ln++ ) {
     // NOTE: true indicates that physical boundary conditions should
     //       be set.
@@ -744,6 +772,8 @@ bool LevelSetFunctionIntegrator<DIM>::advanceLevelSetFunctions(
         comp);
     }
   }
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_GHOST_FILL,
+    t_ghost_fill, 0, 0);
 
   // reinitialize level set functions to approximate distance functions
   return regrid_needed;
@@ -1010,9 +1040,25 @@ void LevelSetFunctionIntegrator<DIM>::applyGradientDetector(
                 << endl );
     }
 
+    // get dx and compute the tagging distance.  cells within the 
+    // refinement cutoff distance of the zero level set and a buffer 
+    // of d_tag_buffer_width grid cells around them are tagged so that 
+    // the zero level set can move before the hierarchy must be regridded.
+    Pointer< CartesianPatchGeometry<DIM> > patch_geom =
+      patch->getPatchGeometry();
+    const double* dx = patch_geom->getDx();
+    double max_dx = dx[0];
+    for (int k = 1; k < DIM; k++) {
+      if (max_dx < dx[k]) max_dx = dx[k];
+    }
+    LSMLIB_REAL tag_cutoff = d_refinement_cutoff_value 
+                           + d_tag_buffer_width*max_dx;
+
+    // get pointers to data and index space ranges
+    // NOTE: for codimension-one problems, phi is used in place of psi
     Pointer< CellData<DIM,LSMLIB_REAL> > phi_data = 
       patch->getPatchData( d_phi_handles[0] );
-    Pointer< CellData<DIM,LSMLIB_REAL> > psi_data;
+    Pointer< CellData<DIM,LSMLIB_REAL> > psi_data = phi_data;
     if (d_codimension == 2) {
       psi_data = patch->getPatchData( d_psi_handles[0] );
     }
@@ -1027,37 +1073,72 @@ void LevelSetFunctionIntegrator<DIM>::applyGradientDetector(
     const IntVector<DIM> psi_gb_lower = psi_ghostbox.lower();
     const IntVector<DIM> psi_gb_upper = psi_ghostbox.upper();
 
-    Box<DIM> tag_box = tag_data->getBox();
-    const IntVector<DIM> tag_box_lower = tag_box.lower();
-    const IntVector<DIM> tag_box_upper = tag_box.upper();
-
     Box<DIM> tag_ghostbox = tag_data->getGhostBox();
     const IntVector<DIM> tag_gb_lower = tag_ghostbox.lower();
     const IntVector<DIM> tag_gb_upper = tag_ghostbox.upper();
 
-/* KTC - FIX ME
-#if DIM==2
-    setrefinementtags_(
-      tag_data->getPointer(),
-      level_set_data->getPointer(),
-      &tag_ghostbox_lower[0],
-      &tag_ghostbox_upper[0],
-      &tag_ghostbox_lower[1],
-      &tag_ghostbox_upper[1],
-      &level_set_ghostbox_lower[0],
-      &level_set_ghostbox_upper[0],
-      &level_set_ghostbox_lower[1],
-      &level_set_ghostbox_upper[1],
-      &tag_box_lower[0],
-      &tag_box_upper[0],
-      &tag_box_lower[1],
-      &tag_box_upper[1],
-      &d_refinement_cutoff_value);
-#endif
+    Box<DIM> tag_box = patch->getBox();
+    const IntVector<DIM> tag_box_lower = tag_box.lower();
+    const IntVector<DIM> tag_box_upper = tag_box.upper();
 
-#if DIM==3
-#endif
-*/
+    int* tags = tag_data->getPointer();
+
+    for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
+
+      LSMLIB_REAL* phi = phi_data->getPointer(comp);
+      LSMLIB_REAL* psi = psi_data->getPointer(comp);
+
+      if ( DIM == 3 ) {
+        LSM3D_SAMRAI_UTILITIES_TAG_CELLS_NEAR_ZERO_LEVEL_SETS(
+          tags,
+          &tag_gb_lower[0], &tag_gb_upper[0],
+          &tag_gb_lower[1], &tag_gb_upper[1],
+          &tag_gb_lower[2], &tag_gb_upper[2],
+          phi,
+          &phi_gb_lower[0], &phi_gb_upper[0],
+          &phi_gb_lower[1], &phi_gb_upper[1],
+          &phi_gb_lower[2], &phi_gb_upper[2],
+          psi,
+          &psi_gb_lower[0], &psi_gb_upper[0],
+          &psi_gb_lower[1], &psi_gb_upper[1],
+          &psi_gb_lower[2], &psi_gb_upper[2],
+          &tag_box_lower[0], &tag_box_upper[0],
+          &tag_box_lower[1], &tag_box_upper[1],
+          &tag_box_lower[2], &tag_box_upper[2],
+          &tag_cutoff);
+      } else if ( DIM == 2 ) {
+        LSM2D_SAMRAI_UTILITIES_TAG_CELLS_NEAR_ZERO_LEVEL_SETS(
+          tags,
+          &tag_gb_lower[0], &tag_gb_upper[0],
+          &tag_gb_lower[1], &tag_gb_upper[1],
+          phi,
+          &phi_gb_lower[0], &phi_gb_upper[0],
+          &phi_gb_lower[1], &phi_gb_upper[1],
+          psi,
+          &psi_gb_lower[0], &psi_gb_upper[0],
+          &psi_gb_lower[1], &psi_gb_upper[1],
+          &tag_box_lower[0], &tag_box_upper[0],
+          &tag_box_lower[1], &tag_box_upper[1],
+          &tag_cutoff);
+      } else if ( DIM == 1 ) {
+        LSM1D_SAMRAI_UTILITIES_TAG_CELLS_NEAR_ZERO_LEVEL_SETS(
+          tags,
+          &tag_gb_lower[0], &tag_gb_upper[0],
+          phi,
+          &phi_gb_lower[0], &phi_gb_upper[0],
+          psi,
+          &psi_gb_lower[0], &psi_gb_upper[0],
+          &tag_box_lower[0], &tag_box_upper[0],
+          &tag_cutoff);
+      } else {  // Unsupported dimension
+        TBOX_ERROR(  d_object_name 
+                  << "::applyGradientDetector(): "
+                  << "Invalid value of DIM.  "
+                  << "Only DIM = 1, 2, and 3 are supported."
+                  << endl);
+      }
+
+    } // end loop over components of level set functions
 
   } // end loop over patches
 
@@ -1118,6 +1199,22 @@ void LevelSetFunctionIntegrator<DIM>::resetHierarchyConfiguration(
                                                     this);
   } // end loop over levels
 
+  // reset communications schedules used to coarsen level set functions
+  // (each schedule transfers data from level ln to level ln-1)
+  d_coarsen_level_set_fcns_scheds.resizeArray(num_levels);
+
+  const int hierarchy_finest_level = hierarchy->getFinestLevelNumber();
+  for (int ln = (coarsest_level > 0 ? coarsest_level : 1);
+       ln <= hierarchy_finest_level; ln++) {
+    Pointer< PatchLevel<DIM> > coarse_level = hierarchy->getPatchLevel(ln-1);
+    Pointer< PatchLevel<DIM> > fine_level = hierarchy->getPatchLevel(ln);
+
+    d_coarsen_level_set_fcns_scheds[ln] =
+      d_coarsen_level_set_fcns->createSchedule(coarse_level,
+                                               fine_level,
+                                               this);
+  } // end loop over levels
+
   // reset hierarchy configuration for reinitialization and orthogonalization
   // algorithms
   d_phi_reinitialization_alg->resetHierarchyConfiguration(
@@ -1247,6 +1344,7 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK2(
 
   // fill scratch space for second stage of time advance
   const int num_levels = d_patch_hierarchy->getNumberLevels();
+  LSM_INSTRUMENTATION_START(t_ghost_fill_stage2);
   for ( int ln=0 ; ln < num_levels; ln++ ) {
     // NOTE: true indicates that physical boundary conditions should
     //       be set.
@@ -1271,6 +1369,8 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK2(
         comp);
     }
   }
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_GHOST_FILL,
+    t_ghost_fill_stage2, 0, 0);
 
   // loop over components of vector level set function
   for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
@@ -1371,6 +1471,7 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK3(
 
   // fill scratch space for second stage of time advance
   const int num_levels = d_patch_hierarchy->getNumberLevels();
+  LSM_INSTRUMENTATION_START(t_ghost_fill_stage2);
   for ( int ln=0 ; ln < num_levels; ln++ ) {
     // NOTE: true indicates that physical boundary conditions should
     //       be set.
@@ -1395,6 +1496,8 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK3(
         comp);
     }
   }
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_GHOST_FILL,
+    t_ghost_fill_stage2, 0, 0);
 
   // loop over components of vector level set function
   for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
@@ -1443,6 +1546,7 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK3(
   rk_stage = 2;
 
   // fill scratch space for second stage of time advance
+  LSM_INSTRUMENTATION_START(t_ghost_fill_stage3);
   for ( int ln=0 ; ln < num_levels; ln++ ) {
     // NOTE: true indicates that physical boundary conditions should
     //       be set.
@@ -1467,6 +1571,8 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK3(
         comp);
     }
   }
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_GHOST_FILL,
+    t_ghost_fill_stage3, 0, 0);
 
   // loop over components of vector level set function
   for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
@@ -1520,6 +1626,9 @@ void LevelSetFunctionIntegrator<DIM>::computeLevelSetEquationRHS(
   const int phi_handle,
   const int component)
 {
+  LSM_INSTRUMENTATION_START(t_start);
+  double num_points = 0;
+
   int rhs_handle;
   if (level_set_fcn == PHI) {
     rhs_handle = d_rhs_phi_handle;
@@ -1554,6 +1663,7 @@ void LevelSetFunctionIntegrator<DIM>::computeLevelSetEquationRHS(
       const IntVector<DIM> rhs_ghostbox_upper = rhs_ghostbox.upper();
 
       LSMLIB_REAL* rhs = rhs_data->getPointer();
+      num_points += rhs_data->getBox().size();
 
       // zero out level set equation RHS
       if (DIM == 3) {
@@ -1606,6 +1716,9 @@ void LevelSetFunctionIntegrator<DIM>::computeLevelSetEquationRHS(
                                                component);
   }
 
+  // each grid point reads phi and the velocity field and writes the RHS
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_RHS, t_start,
+    num_points*(DIM+2)*sizeof(LSMLIB_REAL), num_points);
 }
 
 
@@ -1972,6 +2085,8 @@ void LevelSetFunctionIntegrator<DIM>::reinitializeLevelSetFunctions(
   const LEVEL_SET_FCN_TYPE level_set_fcn,
   const int max_iterations)
 {
+  LSM_INSTRUMENTATION_START(t_start);
+
   if (level_set_fcn == PHI) {
     for (int comp=0; comp < d_num_level_set_fcn_components; comp++) {
       d_phi_reinitialization_alg->
@@ -1991,6 +2106,9 @@ void LevelSetFunctionIntegrator<DIM>::reinitializeLevelSetFunctions(
           d_upper_bc_psi[comp]);
     }
   }
+
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_REINITIALIZATION, t_start,
+    0, 0);
 }
 
 
@@ -2031,6 +2149,148 @@ void LevelSetFunctionIntegrator<DIM>::orthogonalizeLevelSetFunctions(
 }
 
 
+/* coarsenLevelSetFunctions() */
+template <int DIM> 
+void LevelSetFunctionIntegrator<DIM>::coarsenLevelSetFunctions()
+{
+  // replace data on each level by the averages of the data on the 
+  // next finer level (beginning with the finest level)
+  const int finest_level = d_patch_hierarchy->getFinestLevelNumber();
+  for (int ln = finest_level; ln > 0; ln--) {
+    d_coarsen_level_set_fcns_scheds[ln]->coarsenData();
+  }
+}
+
+
+/* zeroLevelSetLeftRefinedRegion() */
+template <int DIM> 
+bool LevelSetFunctionIntegrator<DIM>::zeroLevelSetLeftRefinedRegion()
+{
+  int num_unrefined_cells = 0;
+
+  // count the cells on each level (other than the finest level) that 
+  // are within the refinement cutoff distance of the zero level set
+  // but are not covered by the next finer level
+  const int finest_level = d_patch_hierarchy->getFinestLevelNumber();
+  for (int ln = 0; ln < finest_level; ln++) {
+
+    Pointer< PatchLevel<DIM> > level = d_patch_hierarchy->getPatchLevel(ln);
+    Pointer< PatchLevel<DIM> > fine_level = 
+      d_patch_hierarchy->getPatchLevel(ln+1);
+
+    // compute region covered by the finer level in the index space
+    // of the current level
+    BoxList<DIM> refined_region(fine_level->getBoxes());
+    refined_region.coarsen(fine_level->getRatioToCoarserLevel());
+
+    typename PatchLevel<DIM>::Iterator pi;
+    for (pi.initialize(level); pi; pi++) { // loop over patches
+      const int pn = *pi;
+      Pointer< Patch<DIM> > patch = level->getPatch(pn);
+      if ( patch.isNull() ) {
+        TBOX_ERROR(  d_object_name 
+                  << "::zeroLevelSetLeftRefinedRegion(): "
+                  << "Cannot find patch. Null patch pointer."
+                  << endl );
+      }
+
+      // get pointers to data and index space ranges
+      // NOTE: for codimension-one problems, phi is used in place of psi
+      Pointer< CellData<DIM,LSMLIB_REAL> > phi_data = 
+        patch->getPatchData( d_phi_handles[0] );
+      Pointer< CellData<DIM,LSMLIB_REAL> > psi_data = phi_data;
+      if (d_codimension == 2) {
+        psi_data = patch->getPatchData( d_psi_handles[0] );
+      }
+
+      Box<DIM> phi_ghostbox = phi_data->getGhostBox();
+      const IntVector<DIM> phi_gb_lower = phi_ghostbox.lower();
+      const IntVector<DIM> phi_gb_upper = phi_ghostbox.upper();
+
+      Box<DIM> psi_ghostbox = psi_data->getGhostBox();
+      const IntVector<DIM> psi_gb_lower = psi_ghostbox.lower();
+      const IntVector<DIM> psi_gb_upper = psi_ghostbox.upper();
+
+      // compute part of patch that is not covered by the finer level
+      BoxList<DIM> unrefined_boxes(patch->getBox());
+      unrefined_boxes.removeIntersections(refined_region);
+
+      for (typename BoxList<DIM>::Iterator bi(unrefined_boxes); bi; bi++) {
+
+        const Box<DIM>& fillbox = bi();
+        const IntVector<DIM> fillbox_lower = fillbox.lower();
+        const IntVector<DIM> fillbox_upper = fillbox.upper();
+
+        for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
+
+          LSMLIB_REAL* phi = phi_data->getPointer(comp);
+          LSMLIB_REAL* psi = psi_data->getPointer(comp);
+          int num_cells_in_box = 0;
+
+          if ( DIM == 3 ) {
+            LSM3D_SAMRAI_UTILITIES_COUNT_CELLS_NEAR_ZERO_LEVEL_SETS(
+              &num_cells_in_box,
+              phi,
+              &phi_gb_lower[0], &phi_gb_upper[0],
+              &phi_gb_lower[1], &phi_gb_upper[1],
+              &phi_gb_lower[2], &phi_gb_upper[2],
+              psi,
+              &psi_gb_lower[0], &psi_gb_upper[0],
+              &psi_gb_lower[1], &psi_gb_upper[1],
+              &psi_gb_lower[2], &psi_gb_upper[2],
+              &fillbox_lower[0], &fillbox_upper[0],
+              &fillbox_lower[1], &fillbox_upper[1],
+              &fillbox_lower[2], &fillbox_upper[2],
+              &d_refinement_cutoff_value);
+          } else if ( DIM == 2 ) {
+            LSM2D_SAMRAI_UTILITIES_COUNT_CELLS_NEAR_ZERO_LEVEL_SETS(
+              &num_cells_in_box,
+              phi,
+              &phi_gb_lower[0], &phi_gb_upper[0],
+              &phi_gb_lower[1], &phi_gb_upper[1],
+              psi,
+              &psi_gb_lower[0], &psi_gb_upper[0],
+              &psi_gb_lower[1], &psi_gb_upper[1],
+              &fillbox_lower[0], &fillbox_upper[0],
+              &fillbox_lower[1], &fillbox_upper[1],
+              &d_refinement_cutoff_value);
+          } else if ( DIM == 1 ) {
+            LSM1D_SAMRAI_UTILITIES_COUNT_CELLS_NEAR_ZERO_LEVEL_SETS(
+              &num_cells_in_box,
+              phi,
+              &phi_gb_lower[0], &phi_gb_upper[0],
+              psi,
+              &psi_gb_lower[0], &psi_gb_upper[0],
+              &fillbox_lower[0], &fillbox_upper[0],
+              &d_refinement_cutoff_value);
+          } else {  // Unsupported dimension
+            TBOX_ERROR(  d_object_name 
+                      << "::zeroLevelSetLeftRefinedRegion(): "
+                      << "Invalid value of DIM.  "
+                      << "Only DIM = 1, 2, and 3 are supported."
+                      << endl);
+          }
+
+          num_unrefined_cells += num_cells_in_box;
+
+        } // end loop over components of level set functions
+      } // end loop over unrefined boxes
+    } // end loop over patches
+  } // end loop over levels
+
+  num_unrefined_cells = tbox::MPI::sumReduction(num_unrefined_cells);
+
+  if (d_verbose_mode && (num_unrefined_cells > 0)) {
+    pout << endl;
+    pout << d_object_name << "::zeroLevelSetLeftRefinedRegion():" << endl;
+    pout << "  " << num_unrefined_cells 
+         << " cells near zero level set are not refined" << endl;
+  }
+
+  return (num_unrefined_cells > 0);
+}
+
+
 /* initializeVariables() */
 template <int DIM> 
 void LevelSetFunctionIntegrator<DIM>::initializeVariables()
@@ -2260,11 +2520,15 @@ void LevelSetFunctionIntegrator<DIM>::initializeVariables()
 template <int DIM> 
 void LevelSetFunctionIntegrator<DIM>::initializeCommunicationObjects()
 {
-  // lookup refine operations
+  // lookup refine operations.  conservative linear interpolation is 
+  // used so that coarse-fine boundary data is consistent with the 
+  // conservative averaging of finer level data onto coarser levels
+  // (i.e. the average of the interpolated fine data over a coarse cell 
+  // equals the coarse data).
   Pointer< RefineOperator<DIM> > refine_op =
     d_grid_geometry->lookupRefineOperator(
       VariableDatabase<DIM>::getDatabase()->getVariable("phi (LSMLIB)"),
-      "LINEAR_REFINE");
+      "CONSERVATIVE_LINEAR_REFINE");
 
   // set up communications objects for filling a new level (used during
   // initialization of a level and in initializing velocity fields)
@@ -2323,6 +2587,26 @@ void LevelSetFunctionIntegrator<DIM>::initializeCommunicationObjects()
 
   } // end loop setting up data transfers for TVD Runge-Kutta time advance
 
+  // set up objects for coarsening level set functions from finer levels
+  // to coarser levels after each time step (only has an effect when 
+  // the patch hierarchy contains more than one level)
+  Pointer< CoarsenOperator<DIM> > coarsen_op =
+    d_grid_geometry->lookupCoarsenOperator(
+      VariableDatabase<DIM>::getDatabase()->getVariable("phi (LSMLIB)"),
+      "CONSERVATIVE_COARSEN");
+
+  d_coarsen_level_set_fcns = new CoarsenAlgorithm<DIM>;
+
+  // empty out the coarsen schedules 
+  d_coarsen_level_set_fcns_scheds.setNull();
+
+  d_coarsen_level_set_fcns->registerCoarsen(
+    d_phi_handles[0], d_phi_handles[0], coarsen_op);
+  if (d_codimension == 2) {
+    d_coarsen_level_set_fcns->registerCoarsen(
+      d_psi_handles[0], d_psi_handles[0], coarsen_op);
+  }
+
 }
 
 
@@ -154,11 +154,19 @@
  * <h4> AMR Parameters: </h4>
  *
  * - use_AMR                     = TRUE if AMR should be used (default = FALSE)
- * - regrid_interval             = regridding interval (default = 5)
- * - tag_buffer_width            = number of buffer cells to use around
- *                                 cells tagged for refinement
- *                                 (default = 2)
- * - refinement_cutoff_value     = cutoff value for distance function
+ * - regrid_interval             = maximum number of time steps between
+ *                                 regridding operations.  When set to 0,
+ *                                 regridding is only requested when the
+ *                                 zero level set moves out of the
+ *                                 refined region (default = 0)
+ * - tag_buffer_width            = number of buffer cells (in addition
+ *                                 to refinement_cutoff_value) to use 
+ *                                 around the zero level set when tagging
+ *                                 cells for refinement (default = 2)
+ * - refinement_cutoff_value     = distance from the zero level set
+ *                                 within which cells are refined.  It
+ *                                 should be at least as large as the
+ *                                 grid spacing on the coarsest level
  *                                 (default = 1.0)
  *
  * <h4> Miscellaneous Parameters: </h4>
@@ -234,8 +242,15 @@
  *      boundary condition will be overwritten by specified boundary
  *      condition type.
  *
- *  - AMR is currently UNAVAILABLE.  It is still in the development 
- *    stages.
+ *  - When AMR is used, cells within refinement_cutoff_value (plus
+ *    tag_buffer_width cells) of the zero level set are tagged for
+ *    refinement.  Coarse-fine boundary data and new fine levels are 
+ *    filled by conservative linear interpolation (slope-limited linear
+ *    interpolation whose average over each coarse cell equals the 
+ *    coarse data) and, after each time step, the level set functions 
+ *    on coarser levels are replaced by conservative averages of the 
+ *    data on finer levels.  All levels are advanced with the same 
+ *    time step (i.e. time steps are NOT subcycled on finer levels).
  *
  */
 
@@ -615,8 +630,13 @@ public:
    *                 this time step; false otherwise.
    *
    * NOTES:
-   *  - AMR is NOT yet implemented, so advanceLevelSetFunctions() 
-   *    currently always returns false.
+   *  - advanceLevelSetFunctions() always returns false when AMR is 
+   *    not used.  When AMR is used, it returns true when the zero 
+   *    level set has moved out of the refined region or when 
+   *    regrid_interval time steps have been taken since the last
+   *    regrid (if regrid_interval is positive).  In that case, the
+   *    user should call regridPatchHierarchy() before the next
+   *    time step.
    *
    */
   virtual bool advanceLevelSetFunctions(const LSMLIB_REAL dt);
@@ -1356,6 +1376,40 @@ protected:
    */
   virtual void getFromRestart();
 
+  /*!
+   * coarsenLevelSetFunctions() replaces the level set function data 
+   * on coarser levels of the PatchHierarchy by the (conservative) 
+   * averages of the data on the next finer level.  The coarsening
+   * proceeds from the finest level to the coarsest level.
+   *
+   * Arguments:     none
+   *
+   * Return value:  none
+   *
+   * NOTES:
+   *  - This method has no effect when the PatchHierarchy contains
+   *    a single level.
+   *
+   */
+  virtual void coarsenLevelSetFunctions();
+
+  /*!
+   * zeroLevelSetLeftRefinedRegion() determines whether the zero level 
+   * set has moved out of the region covered by the finer levels of 
+   * the PatchHierarchy.  A cell on a level (other than the finest 
+   * level) is considered to be near the zero level set if the 
+   * absolute values of all of the level set functions are less than
+   * refinement_cutoff_value.
+   *
+   * Arguments:     none
+   *
+   * Return value:  true if there are cells near the zero level set
+   *                that are not covered by the next finer level; 
+   *                false otherwise
+   *
+   */
+  virtual bool zeroLevelSetLeftRefinedRegion();
+
   //! @}
 
   /****************************************************************
@@ -1568,6 +1622,10 @@ protected:
   Array< Array< Pointer< RefineSchedule<DIM> > > > 
     d_fill_bdry_sched_time_advance;
 
+  // for coarsening level set functions from finer levels to coarser levels
+  Pointer< CoarsenAlgorithm<DIM> > d_coarsen_level_set_fcns;
+  Array< Pointer< CoarsenSchedule<DIM> > > d_coarsen_level_set_fcns_scheds;
+
 private:
  
   /*
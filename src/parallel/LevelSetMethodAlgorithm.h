@@ -33,7 +33,9 @@
  *
  * <h3> NOTES </h3>
  *
- *  - AMR is NOT yet supported.  It is still currently under development.
+ *  - When AMR is used, all levels of the PatchHierarchy are advanced 
+ *    with the same time step (i.e. time steps are NOT subcycled on 
+ *    finer levels).
  *
  * 
  * <h3> USAGE </h3>
@@ -246,15 +248,22 @@
  *   - verbose_mode                = TRUE if status should be output during 
  *                                   integration (default = TRUE)
  *
- *   <h5> AMR Parameters (CURRENTLY UNUSED): </h5>
+ *   <h5> AMR Parameters: </h5>
  *
  *   - use_AMR                     = TRUE if AMR should be used 
  *                                   (default = FALSE)
- *   - regrid_interval             = regridding interval (default = 5)
- *   - tag_buffer_width            = number of buffer cells to use around
- *                                   cells tagged for refinement
+ *   - regrid_interval             = maximum number of time steps between
+ *                                   regridding operations.  When set to 0,
+ *                                   regridding is only requested when the
+ *                                   zero level set moves out of the
+ *                                   refined region (default = 0)
+ *   - tag_buffer_width            = number of buffer cells (in addition 
+ *                                   to refinement_cutoff_value) to use
+ *                                   around the zero level set when 
+ *                                   tagging cells for refinement 
  *                                   (default = 2)
- *   - refinement_cutoff_value     = cutoff value for distance function
+ *   - refinement_cutoff_value     = distance from the zero level set
+ *                                   within which cells are refined
  *                                   (default = 1.0)
  *
  *
@@ -285,7 +294,7 @@
  *                                       level number and each vector must 
  *                                       have length DIM.
  *
- *   <h5> Adaptive Refinement Input (CURRENTLY UNUSED): </h5>
+ *   <h5> Adaptive Refinement Input: </h5>
  *
  *   - tagging_method (OPTIONAL)      =  string array specification of the type
  *                                       of cell-tagging used. Valid choices
@@ -316,6 +325,25 @@
  *   <h5> Load Balancer Input: </h5>
  *
  *   - NO REQUIRED INPUT PARAMETERS (several OPTIONAL input parameters)
+ *   - use_interface_workload         =  TRUE if the workload of each cell
+ *                                       should be estimated from its 
+ *                                       distance to the zero level set
+ *                                       (default = FALSE)
+ *   - workload_band_width            =  number of grid cells from the zero
+ *                                       level set within which cells are 
+ *                                       considered to be interface cells
+ *                                       (default = 3)
+ *   - interface_cell_workload        =  workload of an interface cell 
+ *                                       relative to a cell away from the
+ *                                       zero level set (default = 10.0)
+ *   - load_imbalance_threshold       =  ratio of maximum to average 
+ *                                       processor workload above which 
+ *                                       the PatchHierarchy is load balanced.
+ *                                       Values less than or equal to 1 
+ *                                       disable load balancing based on
+ *                                       the workload (default = 0.0)
+ *   - verbose_mode                   =  TRUE if load balance statistics
+ *                                       should be output (default = FALSE)
  *
  *
  *  <h4> NOTES ON INPUT PARAMETERS </h4>
@@ -932,8 +960,16 @@ public:
    *                 this time step; false otherwise.
    *
    * NOTES:
-   *  - AMR is NOT yet implemented, so advanceLevelSetFunctions() 
-   *    currently always returns false.
+   *  - advanceLevelSetFunctions() always returns false when AMR is 
+   *    not used.  When AMR is used, it returns true when the zero 
+   *    level set has moved out of the refined region or when 
+   *    regrid_interval time steps have been taken since the last
+   *    regrid (if regrid_interval is positive).  In that case, the
+   *    user should call regridPatchHierarchy() before the next
+   *    time step.
+   *  - advanceLevelSetFunctions() also returns true when the ratio of 
+   *    the maximum to average processor workload exceeds 
+   *    load_imbalance_threshold (see LevelSetMethodGriddingAlgorithm).
    *
    */
   virtual bool advanceLevelSetFunctions(const LSMLIB_REAL dt); 
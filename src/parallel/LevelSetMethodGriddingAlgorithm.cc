@@ -13,8 +13,13 @@
 
 #include "LevelSetMethodGriddingAlgorithm.h" 
 #include "BergerRigoutsos.h" 
+#include "CartesianPatchGeometry.h" 
 #include "CellData.h" 
+#include "CellIterator.h" 
+#include "CellVariable.h" 
 #include "LoadBalancer.h" 
+#include "VariableDatabase.h" 
+#include "tbox/MPI.h" 
 #include "tbox/RestartManager.h" 
 
 #ifdef DEBUG_CHECK_ASSERTIONS
@@ -24,6 +29,19 @@
 #endif
 #endif
 
+// headers for level set method instrumentation
+extern "C" {
+  #include "lsm_instrumentation.h"
+}
+
+
+// default parameters for workload-based load balancing
+#define LSM_DEFAULT_USE_INTERFACE_WORKLOAD                 (false)
+#define LSM_DEFAULT_WORKLOAD_BAND_WIDTH                    (3)
+#define LSM_DEFAULT_INTERFACE_CELL_WORKLOAD                (10.0)
+#define LSM_DEFAULT_LOAD_IMBALANCE_THRESHOLD               (0.0)
+#define LSM_DEFAULT_GRIDDING_VERBOSE_MODE                  (false)
+
 
 /****************************************************************
  *
@@ -81,6 +99,24 @@ StandardTagAndInitialize<DIM>(object_name,
   } else {
     load_balancer = new LoadBalancer<DIM> ("load balancer");
   }
+  d_load_balancer = load_balancer;
+
+  // set up workload variable used for workload-based load balancing
+  VariableDatabase<DIM> *var_db = VariableDatabase<DIM>::getDatabase();
+  Pointer< pdat::CellVariable<DIM,double> > workload_variable;
+  if (var_db->checkVariableExists("workload (LSMLIB)")) {
+    workload_variable = var_db->getVariable("workload (LSMLIB)");
+  } else {
+    workload_variable = 
+      new pdat::CellVariable<DIM,double>("workload (LSMLIB)");
+  }
+  d_workload_handle = var_db->registerVariableAndContext(
+    workload_variable, var_db->getContext("WORKLOAD"), IntVector<DIM>(0));
+
+  if (d_use_interface_workload) {
+    d_load_balancer->setWorkloadPatchDataIndex(d_workload_handle);
+  }
+  d_rebalance_coarsest_level = false;
 
   // construct gridding algorithm using "this" as the 
   // TagAndInitializeStrategy.  
@@ -146,28 +182,13 @@ void LevelSetMethodGriddingAlgorithm<DIM>::initializePatchHierarchy(
     }
 
 
-    //KTC - temporarily left out - need to fix for AMR
     /*
-     * After data on each level is initialized at simulation start time,
-     * coarser levels are synchronized with finer levels that didn't exist
-     * when the coarser level initial data was set.  This synchronization
-     * process is defined by the integration algorithm.
+     * NOTE: coarser levels do not need to be synchronized with finer 
+     * levels at this point because the level set functions are 
+     * initialized independently on each level.  After each time step, 
+     * the LevelSetFunctionIntegrator replaces data on coarser levels 
+     * by averages of data on finer levels.
      */
-    if (d_patch_hierarchy->getFinestLevelNumber() > 0) {
-      // "true" argument: const bool initial_time = true;
-      /*
-          d_level_set_alg->synchronizeNewLevels(
-            0,
-            d_patch_hierarchy->
-            getFinestLevelNumber(),
-            true);
-          d_velocity_field_alg->synchronizeNewLevels(
-            0,
-            d_patch_hierarchy->
-            getFinestLevelNumber(),
-            true);
-      */
-    }
 
   }
 }
@@ -182,6 +203,22 @@ template<int DIM>
 void LevelSetMethodGriddingAlgorithm<DIM>::regridPatchHierarchy(
   LSMLIB_REAL time)
 {
+  LSM_INSTRUMENTATION_START(t_start);
+
+  // update the workload data used by the load balancer 
+  if (d_use_interface_workload) {
+    for (int ln = 0; ln < d_patch_hierarchy->getNumberLevels(); ln++) {
+      computeWorkload(ln);
+    }
+  }
+
+  // regenerate (and load balance) the coarsest level if the 
+  // workload is poorly balanced
+  if (d_rebalance_coarsest_level) {
+    d_gridding_alg->makeCoarsestLevel(d_patch_hierarchy, time);
+    d_rebalance_coarsest_level = false;
+  }
+
   int num_levels = d_patch_hierarchy->getNumberLevels();
   Array<int> tag_buffer(num_levels, true);
   for (int ln=0; ln < num_levels ; ln++) 
@@ -192,6 +229,62 @@ void LevelSetMethodGriddingAlgorithm<DIM>::regridPatchHierarchy(
     0,    // regrid all levels finer than the coarsest level
     time,
     tag_buffer);
+
+  // regridding rebuilds the refined region around the zero level set
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_NARROW_BAND_REBUILD, t_start,
+    0, 0);
+
+  if (d_verbose_mode) {
+    computeLoadImbalance();
+  }
+}
+
+
+/* loadBalanceNeeded() */
+template<int DIM> 
+bool LevelSetMethodGriddingAlgorithm<DIM>::loadBalanceNeeded()
+{
+  if (d_load_imbalance_threshold <= 1.0) return false;
+
+  if (computeLoadImbalance() > d_load_imbalance_threshold) {
+    d_rebalance_coarsest_level = true;
+  }
+
+  return d_rebalance_coarsest_level;
+}
+
+
+/* computeLoadImbalance() */
+template<int DIM> 
+LSMLIB_REAL LevelSetMethodGriddingAlgorithm<DIM>::computeLoadImbalance()
+{
+  // compute workload of local patches
+  double local_workload = 0.0;
+  for (int ln = 0; ln < d_patch_hierarchy->getNumberLevels(); ln++) {
+    local_workload += computeWorkload(ln);
+  }
+
+  // compute workload statistics
+  double max_workload = tbox::MPI::maxReduction(local_workload);
+  double min_workload = tbox::MPI::minReduction(local_workload);
+  double avg_workload = tbox::MPI::sumReduction(local_workload)
+                      / tbox::MPI::getNodes();
+
+  LSMLIB_REAL imbalance = 1.0;
+  if (avg_workload > 0.0) {
+    imbalance = max_workload/avg_workload;
+  }
+
+  if (d_verbose_mode) {
+    pout << endl;
+    pout << d_object_name << "::computeLoadImbalance():" << endl;
+    pout << "  min workload:  " << min_workload << endl;
+    pout << "  max workload:  " << max_workload << endl;
+    pout << "  avg workload:  " << avg_workload << endl;
+    pout << "  imbalance (max/avg):  " << imbalance << endl;
+  }
+
+  return imbalance;
 }
 
 
@@ -453,6 +546,108 @@ void LevelSetMethodGriddingAlgorithm<DIM>::getFromInput(
       << "RICHARDSON_EXTRAPOLATION, or REFINE_BOXES\n"
       << "See class header for details.\n");
   }
+
+  /*
+   * Read workload-based load balancing input.
+   */
+  d_use_interface_workload = input_db->getBoolWithDefault(
+    "use_interface_workload", LSM_DEFAULT_USE_INTERFACE_WORKLOAD);
+  d_workload_band_width = input_db->getIntegerWithDefault(
+    "workload_band_width", LSM_DEFAULT_WORKLOAD_BAND_WIDTH);
+  d_interface_cell_workload = input_db->getDoubleWithDefault(
+    "interface_cell_workload", LSM_DEFAULT_INTERFACE_CELL_WORKLOAD);
+  d_load_imbalance_threshold = input_db->getDoubleWithDefault(
+    "load_imbalance_threshold", LSM_DEFAULT_LOAD_IMBALANCE_THRESHOLD);
+  d_verbose_mode = input_db->getBoolWithDefault(
+    "verbose_mode", LSM_DEFAULT_GRIDDING_VERBOSE_MODE);
+
+  if (d_workload_band_width < 0) {
+    TBOX_ERROR(  d_object_name 
+              << "::getFromInput(): "
+              << "`workload_band_width' must be non-negative."
+              << endl);
+  }
+  if (d_interface_cell_workload < 1.0) {
+    TBOX_ERROR(  d_object_name 
+              << "::getFromInput(): "
+              << "`interface_cell_workload' must be greater than or "
+              << "equal to 1."
+              << endl);
+  }
+}
+
+
+/* computeWorkload() */
+template<int DIM> 
+double LevelSetMethodGriddingAlgorithm<DIM>::computeWorkload(
+  const int level_number)
+{
+  Pointer< PatchLevel<DIM> > level = 
+    d_patch_hierarchy->getPatchLevel(level_number);
+
+  if (!level->checkAllocated(d_workload_handle)) {
+    level->allocatePatchData(d_workload_handle);
+  }
+
+  const int phi_handle = d_lsm_integrator_strategy->getPhiPatchDataHandle();
+
+  double level_workload = 0.0;
+
+  typename PatchLevel<DIM>::Iterator pi;
+  for (pi.initialize(level); pi; pi++) { // loop over patches
+    const int pn = *pi;
+    Pointer< Patch<DIM> > patch = level->getPatch(pn);
+    if ( patch.isNull() ) {
+      TBOX_ERROR(  d_object_name 
+                << "::computeWorkload(): "
+                << "Cannot find patch. Null patch pointer."
+                << endl );
+    }
+
+    Pointer< pdat::CellData<DIM,double> > workload_data = 
+      patch->getPatchData(d_workload_handle);
+
+    // uniform workload
+    if (!d_use_interface_workload) {
+      workload_data->fillAll(1.0);
+      level_workload += patch->getBox().size();
+      continue;
+    }
+
+    // compute width of band of interface cells 
+    Pointer< geom::CartesianPatchGeometry<DIM> > patch_geom =
+      patch->getPatchGeometry();
+    const double* dx = patch_geom->getDx();
+    double max_dx = dx[0];
+    for (int k = 1; k < DIM; k++) {
+      if (max_dx < dx[k]) max_dx = dx[k];
+    }
+    const double band_width = d_workload_band_width*max_dx;
+
+    // set workload of cells based on distance from zero level set
+    Pointer< pdat::CellData<DIM,LSMLIB_REAL> > phi_data = 
+      patch->getPatchData(phi_handle);
+    const int num_components = phi_data->getDepth();
+
+    for (pdat::CellIterator<DIM> ci(patch->getBox()); ci; ci++) {
+      const pdat::CellIndex<DIM>& cell = ci();
+
+      double cell_workload = 1.0;
+      for (int comp = 0; comp < num_components; comp++) {
+        LSMLIB_REAL phi = (*phi_data)(cell,comp);
+        if ( (phi < band_width) && (phi > -band_width) ) {
+          cell_workload = d_interface_cell_workload;
+          break;
+        }
+      }
+
+      (*workload_data)(cell) = cell_workload;
+      level_workload += cell_workload;
+    }
+
+  } // end loop over patches
+
+  return level_workload;
 }
 
 /* Copy Constructor */
@@ -75,6 +75,29 @@
  *
  * <h4> Load Balancer Input: </h4>
  * - NO REQUIRED INPUT PARAMETERS (several OPTIONAL input parameters)
+ * - use_interface_workload (OPTIONAL)   
+ *                                  =  TRUE if the workload of each cell 
+ *                                     should be estimated from its distance
+ *                                     to the zero level set.  Otherwise,
+ *                                     all cells are assigned the same 
+ *                                     workload (default = FALSE).
+ * - workload_band_width (OPTIONAL) =  number of grid cells from the zero 
+ *                                     level set within which cells are
+ *                                     considered to be interface cells
+ *                                     (default = 3)
+ * - interface_cell_workload (OPTIONAL)
+ *                                  =  workload of an interface cell relative
+ *                                     to a cell away from the zero level 
+ *                                     set (default = 10.0)
+ * - load_imbalance_threshold (OPTIONAL)
+ *                                  =  ratio of maximum to average processor
+ *                                     workload above which the 
+ *                                     PatchHierarchy is load balanced.  
+ *                                     Values less than or equal to 1 
+ *                                     disable load balancing based on the 
+ *                                     workload (default = 0.0)
+ * - verbose_mode (OPTIONAL)        =  TRUE if load balance statistics 
+ *                                     should be output (default = FALSE)
  *
  *
  * <h3> NOTES: </h3>
@@ -95,12 +118,31 @@
  *   - For a list and description of optional load balancer input 
  *     fields, see the documentation for the SAMRAI::mesh::LoadBalancer
  *     class. 
+ *
+ *   - When use_interface_workload is TRUE, the workload of cells within
+ *     workload_band_width grid cells of the zero level set of phi is 
+ *     set to interface_cell_workload and the workload of all other cells
+ *     is set to 1.  The workload is passed to the SAMRAI::mesh::LoadBalancer
+ *     so that patches are distributed according to their interface 
+ *     content (rather than their size).  Because the work done on 
+ *     each patch by the narrow band calculations scales with the number
+ *     of cells near the zero level set, this usually yields a more even
+ *     distribution of work across processors.
+ *
+ *   - The workload imbalance is defined as the ratio of the maximum 
+ *     processor workload to the average processor workload.  When
+ *     load_imbalance_threshold is greater than 1, loadBalanceNeeded()
+ *     returns true whenever the imbalance exceeds the threshold and 
+ *     the next call to regridPatchHierarchy() regenerates and load 
+ *     balances ALL levels of the PatchHierarchy (including the coarsest
+ *     level).
  *     
  */
 
 
 #include "SAMRAI_config.h"
 #include "GriddingAlgorithm.h"
+#include "LoadBalancer.h"
 #include "PatchHierarchy.h"
 #include "PatchLevel.h"
 #include "StandardTagAndInitialize.h"
@@ -247,6 +289,45 @@ public:
    */
   virtual void regridPatchHierarchy(LSMLIB_REAL time);
 
+  /*!
+   * loadBalanceNeeded() computes the workload imbalance across 
+   * processors and determines whether it exceeds the 
+   * load_imbalance_threshold.
+   *
+   * Arguments:      none
+   *
+   * Return value:   true if the PatchHierarchy should be load balanced;
+   *                 false otherwise
+   *
+   * NOTES:
+   *  - loadBalanceNeeded() always returns false when 
+   *    load_imbalance_threshold is less than or equal to 1.
+   *
+   *  - loadBalanceNeeded() requires communication between all 
+   *    processors, so it must be called by all processors.
+   *
+   */
+  virtual bool loadBalanceNeeded();
+
+  /*!
+   * computeLoadImbalance() computes the ratio of the maximum processor 
+   * workload to the average processor workload for the PatchHierarchy.
+   *
+   * Arguments:      none
+   *
+   * Return value:   workload imbalance (a value of 1 indicates a 
+   *                 perfectly balanced PatchHierarchy)
+   *
+   * NOTES:
+   *  - When use_interface_workload is FALSE, the workload of each 
+   *    cell is taken to be 1.
+   *
+   *  - When verbose_mode is TRUE, the minimum, maximum and average
+   *    processor workloads are output.
+   *
+   */
+  virtual LSMLIB_REAL computeLoadImbalance();
+
   //! @}
  
   //! @{ 
@@ -380,6 +461,8 @@ protected:
    * database.  This input has already been read by the parent class,
    * but the results are not available because the relevent data members
    * are declared private in StandardTagAndInitialize.
+   * It also reads the input parameters for workload-based load 
+   * balancing.
    *
    * Arguments:     
    *  - input_db (in):  input database
@@ -393,6 +476,21 @@ protected:
    */
   void getFromInput(Pointer<Database> input_db);
 
+  /*!
+   * computeWorkload() sets the workload data on the specified 
+   * PatchLevel (allocating it if necessary) and returns the total 
+   * workload of the patches on the level that are owned by the local 
+   * processor.
+   *
+   * Arguments:     
+   *  - level_number (in):  number of PatchLevel on which to compute 
+   *                        the workload
+   *                      
+   * Return value:          total workload of the local patches
+   *
+   */
+  double computeWorkload(const int level_number);
+
   //! @}
 
 
@@ -435,6 +533,23 @@ protected:
   Array< Pointer< LevelSetMethodVelocityFieldStrategy<DIM> > > 
     d_velocity_field_strategies;
 
+  /*
+   * Load balancer and parameters for workload-based load balancing.
+   */
+  Pointer< LoadBalancer<DIM> > d_load_balancer;
+  bool d_use_interface_workload;
+  int d_workload_band_width;
+  double d_interface_cell_workload;
+  LSMLIB_REAL d_load_imbalance_threshold;
+  bool d_verbose_mode;
+
+  // PatchData handle for workload data
+  int d_workload_handle;
+
+  // true if all levels (including the coarsest level) should be 
+  // load balanced at the next regrid
+  bool d_rebalance_coarsest_level;
+
 private:
  
   /*
@@ -128,6 +128,23 @@ public:
    */
   virtual void regridPatchHierarchy(LSMLIB_REAL time) = 0;
 
+  /*!
+   * loadBalanceNeeded() determines whether the work associated with
+   * the PatchHierarchy is sufficiently unevenly distributed across 
+   * processors that the PatchHierarchy should be regridded (and 
+   * load balanced).
+   *
+   * Arguments:      none
+   *
+   * Return value:   true if the PatchHierarchy should be load balanced;
+   *                 false otherwise
+   *
+   * NOTES:
+   *  - The default implementation always returns false.
+   *
+   */
+  virtual bool loadBalanceNeeded() { return false; }
+
   //! @}
 
 
@@ -12,6 +12,7 @@
 #define included_LevelSetMethodToolbox_cc
 
 // System Headers
+#include <cstdio>
 #include <vector>
 #include <float.h>
 
@@ -39,6 +40,8 @@ extern "C" {
   #include "lsm_geometry1d.h"
   #include "lsm_geometry2d.h"
   #include "lsm_geometry3d.h"
+  #include "lsm_instrumentation.h"
+  #include "lsm_mesh3d.h"
   #include "lsm_spatial_derivatives1d.h"
   #include "lsm_spatial_derivatives2d.h"
   #include "lsm_spatial_derivatives3d.h"
@@ -112,6 +115,9 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
   const int upwind_function_handle,
   const int phi_component)
 {
+  LSM_INSTRUMENTATION_START(t_start);
+  double num_points = 0;
+
 
   // make sure that the scratch PatchData handles have been created
   initializeComputeSpatialDerivativesParameters();
@@ -151,6 +157,7 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
 #endif
   
       Box<DIM> fillbox = grad_phi_data->getBox();
+      num_points += fillbox.size();
       const IntVector<DIM> grad_phi_fillbox_lower = fillbox.lower();
       const IntVector<DIM> grad_phi_fillbox_upper = fillbox.upper();
 
@@ -761,6 +768,10 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
 
     } // end loop over Patches
   } // end loop over PatchLevels
+
+  // each grid point reads and writes (2*DIM+1) data values
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_SPATIAL_DERIVATIVES, t_start,
+    num_points*(2*DIM+1)*sizeof(LSMLIB_REAL), num_points);
 }
 
 
@@ -775,6 +786,9 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
   const int phi_handle,
   const int phi_component)
 {
+  LSM_INSTRUMENTATION_START(t_start);
+  double num_points = 0;
+
 
   // make sure that the scratch PatchData handles have been created
   initializeComputeSpatialDerivativesParameters();
@@ -814,6 +828,7 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
         patch->getPatchData( phi_handle );
   
       Box<DIM> fillbox = grad_phi_plus_data->getBox();
+      num_points += fillbox.size();
       const IntVector<DIM> grad_phi_fillbox_lower = fillbox.lower();
       const IntVector<DIM> grad_phi_fillbox_upper = fillbox.upper();
 
@@ -1418,6 +1433,10 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
 
     } // end loop over Patches
   } // end loop over PatchLevels
+
+  // each grid point reads and writes (2*DIM+1) data values
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_SPATIAL_DERIVATIVES, t_start,
+    num_points*(2*DIM+1)*sizeof(LSMLIB_REAL), num_points);
 }
 
 
@@ -1430,6 +1449,9 @@ void LevelSetMethodToolbox<DIM>::computeCentralSpatialDerivatives(
   const int phi_handle,
   const int phi_component)
 {
+  LSM_INSTRUMENTATION_START(t_start);
+  double num_points = 0;
+
 
   // make sure that the scratch PatchData handles have been created
   initializeComputeSpatialDerivativesParameters();
@@ -1467,6 +1489,7 @@ void LevelSetMethodToolbox<DIM>::computeCentralSpatialDerivatives(
 #endif
   
       Box<DIM> fillbox = grad_phi_data->getBox();
+      num_points += fillbox.size();
       const IntVector<DIM> grad_phi_fillbox_lower = fillbox.lower();
       const IntVector<DIM> grad_phi_fillbox_upper = fillbox.upper();
 
@@ -1644,6 +1667,10 @@ void LevelSetMethodToolbox<DIM>::computeCentralSpatialDerivatives(
 
     } // end loop over Patches
   } // end loop over PatchLevels
+
+  // each grid point reads and writes (DIM+1) data values
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_SPATIAL_DERIVATIVES, t_start,
+    num_points*(DIM+1)*sizeof(LSMLIB_REAL), num_points);
 }
 
 
@@ -1659,6 +1686,9 @@ void LevelSetMethodToolbox<DIM>::TVDRK1Step(
   const int u_cur_component,
   const int rhs_component)
 {
+  LSM_INSTRUMENTATION_START(t_start);
+  double num_points = 0;
+
   // loop over PatchHierarchy and take Runge-Kutta step
   // by calling Fortran routines
   const int num_levels = patch_hierarchy->getNumberLevels();
@@ -1699,6 +1729,7 @@ void LevelSetMethodToolbox<DIM>::TVDRK1Step(
 
       // fill box
       Box<DIM> fillbox = rhs_data->getBox();
+      num_points += fillbox.size();
       const IntVector<DIM> fillbox_lower = fillbox.lower();
       const IntVector<DIM> fillbox_upper = fillbox.upper();
 
@@ -1785,6 +1816,10 @@ void LevelSetMethodToolbox<DIM>::TVDRK1Step(
 
     } // end loop over patches in level
   } // end loop over levels in hierarchy
+
+  // each grid point reads and writes 3 data values
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_TVD_RK_STAGE, t_start,
+    num_points*3*sizeof(LSMLIB_REAL), num_points);
 }
 
 
@@ -1800,6 +1835,9 @@ void LevelSetMethodToolbox<DIM>::TVDRK2Stage1(
   const int u_cur_component,
   const int rhs_component)
 {
+  LSM_INSTRUMENTATION_START(t_start);
+  double num_points = 0;
+
   // loop over PatchHierarchy and take Runge-Kutta step
   // by calling Fortran routines
   const int num_levels = patch_hierarchy->getNumberLevels();
@@ -1844,6 +1882,7 @@ void LevelSetMethodToolbox<DIM>::TVDRK2Stage1(
 
       // fill box
       Box<DIM> fillbox = u_stage1_data->getBox();
+      num_points += fillbox.size();
       const IntVector<DIM> fillbox_lower = fillbox.lower();
       const IntVector<DIM> fillbox_upper = fillbox.upper();
 
@@ -1930,6 +1969,10 @@ void LevelSetMethodToolbox<DIM>::TVDRK2Stage1(
 
     } // end loop over patches in level
   } // end loop over levels in hierarchy
+
+  // each grid point reads and writes 3 data values
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_TVD_RK_STAGE, t_start,
+    num_points*3*sizeof(LSMLIB_REAL), num_points);
 }
 
 
@@ -1947,6 +1990,9 @@ void LevelSetMethodToolbox<DIM>::TVDRK2Stage2(
   const int u_cur_component,
   const int rhs_component)
 {
+  LSM_INSTRUMENTATION_START(t_start);
+  double num_points = 0;
+
   // loop over PatchHierarchy and take Runge-Kutta step
   // by calling Fortran routines
   const int num_levels = patch_hierarchy->getNumberLevels();
@@ -1999,6 +2045,7 @@ void LevelSetMethodToolbox<DIM>::TVDRK2Stage2(
 
       // fill box
       Box<DIM> fillbox = u_next_data->getBox();
+      num_points += fillbox.size();
       const IntVector<DIM> fillbox_lower = fillbox.lower();
       const IntVector<DIM> fillbox_upper = fillbox.upper();
 
@@ -2102,6 +2149,10 @@ void LevelSetMethodToolbox<DIM>::TVDRK2Stage2(
     } // end loop over patches in level
   } // end loop over levels in hierarchy
 
+
+  // each grid point reads and writes 4 data values
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_TVD_RK_STAGE, t_start,
+    num_points*4*sizeof(LSMLIB_REAL), num_points);
 }
 
 
@@ -2117,6 +2168,9 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage1(
   const int u_cur_component,
   const int rhs_component)
 {
+  LSM_INSTRUMENTATION_START(t_start);
+  double num_points = 0;
+
   // loop over PatchHierarchy and take Runge-Kutta step
   // by calling Fortran routines
   const int num_levels = patch_hierarchy->getNumberLevels();
@@ -2161,6 +2215,7 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage1(
 
       // fill box
       Box<DIM> fillbox = u_stage1_data->getBox();
+      num_points += fillbox.size();
       const IntVector<DIM> fillbox_lower = fillbox.lower();
       const IntVector<DIM> fillbox_upper = fillbox.upper();
 
@@ -2247,6 +2302,10 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage1(
 
     } // end loop over patches in level
   } // end loop over levels in hierarchy
+
+  // each grid point reads and writes 3 data values
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_TVD_RK_STAGE, t_start,
+    num_points*3*sizeof(LSMLIB_REAL), num_points);
 }
 
 
@@ -2264,6 +2323,9 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage2(
   const int u_cur_component,
   const int rhs_component)
 {
+  LSM_INSTRUMENTATION_START(t_start);
+  double num_points = 0;
+
   // loop over PatchHierarchy and take Runge-Kutta step
   // by calling Fortran routines
   const int num_levels = patch_hierarchy->getNumberLevels();
@@ -2316,6 +2378,7 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage2(
 
       // fill box
       Box<DIM> fillbox = u_stage2_data->getBox();
+      num_points += fillbox.size();
       const IntVector<DIM> fillbox_lower = fillbox.lower();
       const IntVector<DIM> fillbox_upper = fillbox.upper();
 
@@ -2419,6 +2482,10 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage2(
     } // end loop over patches in level
   } // end loop over levels in hierarchy
 
+
+  // each grid point reads and writes 4 data values
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_TVD_RK_STAGE, t_start,
+    num_points*4*sizeof(LSMLIB_REAL), num_points);
 }
 
 
@@ -2436,6 +2503,9 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage3(
   const int u_cur_component,
   const int rhs_component)
 {
+  LSM_INSTRUMENTATION_START(t_start);
+  double num_points = 0;
+
   // loop over PatchHierarchy and take Runge-Kutta step
   // by calling Fortran routines
   const int num_levels = patch_hierarchy->getNumberLevels();
@@ -2488,6 +2558,7 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage3(
 
       // fill box
       Box<DIM> fillbox = u_stage2_data->getBox();
+      num_points += fillbox.size();
       const IntVector<DIM> fillbox_lower = fillbox.lower();
       const IntVector<DIM> fillbox_upper = fillbox.upper();
 
@@ -2591,6 +2662,10 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage3(
     } // end loop over patches in level
   } // end loop over levels in hierarchy
 
+
+  // each grid point reads and writes 4 data values
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_TVD_RK_STAGE, t_start,
+    num_points*4*sizeof(LSMLIB_REAL), num_points);
 }
 
 
@@ -5361,7 +5436,12 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeOfRegionDefinedByZeroLevelS
 
   } // end if statement on (region_indicator > 0)
 
-  return tbox::MPI::sumReduction(volume);
+  LSM_INSTRUMENTATION_START(t_reduction);
+  volume = tbox::MPI::sumReduction(volume);
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_REDUCTION, t_reduction,
+    sizeof(volume), 0);
+
+  return volume;
 }
 
 
@@ -5541,7 +5621,12 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeOfZeroLevelSet(
     } // end loop over patches in level
   } // end loop over levels in hierarchy
 
-  return tbox::MPI::sumReduction(volume);
+  LSM_INSTRUMENTATION_START(t_reduction);
+  volume = tbox::MPI::sumReduction(volume);
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_REDUCTION, t_reduction,
+    sizeof(volume), 0);
+
+  return volume;
 }
 
 
@@ -5878,7 +5963,12 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeIntegral(
 
   } // end if statement on (region_indicator > 0)
 
-  return tbox::MPI::sumReduction(integral_F);
+  LSM_INSTRUMENTATION_START(t_reduction);
+  integral_F = tbox::MPI::sumReduction(integral_F);
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_REDUCTION, t_reduction,
+    sizeof(integral_F), 0);
+
+  return integral_F;
 }
 
 
@@ -6082,7 +6172,186 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeSurfaceIntegral(
     } // end loop over patches in level
   } // end loop over levels in hierarchy
 
-  return tbox::MPI::sumReduction(integral_F);
+  LSM_INSTRUMENTATION_START(t_reduction);
+  integral_F = tbox::MPI::sumReduction(integral_F);
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_REDUCTION, t_reduction,
+    sizeof(integral_F), 0);
+
+  return integral_F;
+}
+
+
+/* writeZeroLevelSetMeshToFile() */
+template <int DIM> 
+int LevelSetMethodToolbox<DIM>::writeZeroLevelSetMeshToFile(
+  Pointer< PatchHierarchy<DIM> > patch_hierarchy,
+  const std::string& file_name,
+  const int phi_handle,
+  const int control_volume_handle,
+  const int phi_component,
+  const int psi_handle,
+  const int psi_component)
+{
+  if ( DIM != 3 ) {
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "writeZeroLevelSetMeshToFile(): "
+              << "Invalid value of DIM.  "
+              << "Only DIM = 3 is supported."
+              << endl);
+  }
+
+  const bool extract_curves = (psi_handle >= 0);
+  LSM_Mesh* mesh = LSM_createMesh(extract_curves ? 2 : 3);
+  LSMLIB_REAL min_dx = LSMLIB_REAL_MAX;
+
+  // loop over PatchHierarchy and extract the mesh on each Patch
+  const int num_levels = patch_hierarchy->getNumberLevels();
+
+  for ( int ln=0 ; ln < num_levels; ln++ ) {
+
+    Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
+    
+    typename PatchLevel<DIM>::Iterator pi;
+    for (pi.initialize(level); pi; pi++) { // loop over patches
+      const int pn = *pi;
+      Pointer< Patch<DIM> > patch = level->getPatch(pn);
+      if ( patch.isNull() ) {
+        TBOX_ERROR(  "LevelSetMethodToolbox::" 
+                  << "writeZeroLevelSetMeshToFile(): "
+                  << "Cannot find patch. Null patch pointer."
+                  << endl);
+      }
+
+      // get dx and coordinates of lower corner of patch
+      Pointer< CartesianPatchGeometry<DIM> > patch_geom =
+        patch->getPatchGeometry();
+      const double* dx_double = patch_geom->getDx();
+      const double* x_lower = patch_geom->getXLower();
+      LSMLIB_REAL dx[3];
+      for (int k = 0; k < DIM; k++) {
+        dx[k] = (LSMLIB_REAL) dx_double[k];
+        if (min_dx > dx[k]) min_dx = dx[k];
+      }
+
+      // get pointers to data and index space ranges
+      Pointer< CellData<DIM,LSMLIB_REAL> > phi_data =
+        patch->getPatchData( phi_handle );
+      Pointer< CellData<DIM,LSMLIB_REAL> > control_volume_data =
+        patch->getPatchData( control_volume_handle );
+      LSMLIB_REAL* phi = phi_data->getPointer(phi_component);
+      LSMLIB_REAL* psi = 0;
+      if (extract_curves) {
+        Pointer< CellData<DIM,LSMLIB_REAL> > psi_data =
+          patch->getPatchData( psi_handle );
+        psi = psi_data->getPointer(psi_component);
+      }
+
+      Box<DIM> phi_ghostbox = phi_data->getGhostBox();
+      const IntVector<DIM> phi_ghostbox_lower = phi_ghostbox.lower();
+      const IntVector<DIM> phi_ghostbox_upper = phi_ghostbox.upper();
+
+      // interior box
+      Box<DIM> interior_box = patch->getBox();
+      const IntVector<DIM> interior_box_lower = interior_box.lower();
+      const IntVector<DIM> interior_box_upper = interior_box.upper();
+
+      // grid cells (between cell centers) with lower corner in the
+      // interior box; the upper corner must lie in the ghostbox
+      int cell_box_upper[3];
+      LSMLIB_REAL x_lo[3];
+      for (int k = 0; k < DIM; k++) {
+        cell_box_upper[k] = interior_box_upper[k];
+        if (cell_box_upper[k] >= phi_ghostbox_upper[k]) {
+          cell_box_upper[k] = phi_ghostbox_upper[k] - 1;
+        }
+        x_lo[k] = x_lower[k] 
+                + (phi_ghostbox_lower[k] - interior_box_lower[k] + 0.5)*dx[k];
+      }
+
+      // mark grid cells whose lower corner is not covered by a finer level
+      Box<DIM> control_volume_ghostbox = control_volume_data->getGhostBox();
+      const IntVector<DIM> control_volume_ghostbox_lower = 
+        control_volume_ghostbox.lower();
+      LSMLIB_REAL* control_volume = control_volume_data->getPointer();
+      const int nx = phi_ghostbox.numberCells(0);
+      const int ny = phi_ghostbox.numberCells(1);
+      const int cv_nx = control_volume_ghostbox.numberCells(0);
+      const int cv_ny = control_volume_ghostbox.numberCells(1);
+      vector<unsigned char> mark(phi_ghostbox.size(), 0);
+      for (int k = interior_box_lower[2]; k <= interior_box_upper[2]; k++) {
+        for (int j = interior_box_lower[1]; j <= interior_box_upper[1]; j++) {
+          for (int i = interior_box_lower[0]; i <= interior_box_upper[0]; 
+               i++) {
+            int cv_idx = (i - control_volume_ghostbox_lower[0])
+              + (j - control_volume_ghostbox_lower[1])*cv_nx
+              + (k - control_volume_ghostbox_lower[2])*cv_nx*cv_ny;
+            int idx = (i - phi_ghostbox_lower[0])
+              + (j - phi_ghostbox_lower[1])*nx
+              + (k - phi_ghostbox_lower[2])*nx*ny;
+            mark[idx] = (control_volume[cv_idx] > 0) ? 1 : 0;
+          }
+        }
+      }
+
+      int count;
+      if (extract_curves) {
+        count = LSM3D_extractZeroLevelSetCurveSegments(
+          mesh, phi, psi, &(mark[0]),
+          phi_ghostbox_lower[0], phi_ghostbox_upper[0],
+          phi_ghostbox_lower[1], phi_ghostbox_upper[1],
+          phi_ghostbox_lower[2], phi_ghostbox_upper[2],
+          interior_box_lower[0], cell_box_upper[0],
+          interior_box_lower[1], cell_box_upper[1],
+          interior_box_lower[2], cell_box_upper[2],
+          x_lo, dx[0], dx[1], dx[2]);
+      } else {
+        count = LSM3D_extractZeroLevelSetTriangles(
+          mesh, phi, &(mark[0]),
+          phi_ghostbox_lower[0], phi_ghostbox_upper[0],
+          phi_ghostbox_lower[1], phi_ghostbox_upper[1],
+          phi_ghostbox_lower[2], phi_ghostbox_upper[2],
+          interior_box_lower[0], cell_box_upper[0],
+          interior_box_lower[1], cell_box_upper[1],
+          interior_box_lower[2], cell_box_upper[2],
+          x_lo, dx[0], dx[1], dx[2]);
+      }
+      if (count < 0) {
+        TBOX_ERROR(  "LevelSetMethodToolbox::" 
+                  << "writeZeroLevelSetMeshToFile(): "
+                  << "Unable to allocate memory for mesh."
+                  << endl);
+      }
+
+    } // end loop over patches in level
+  } // end loop over levels in hierarchy
+
+  // weld vertices shared by patches and write mesh to file
+  if (LSM_weldMeshVertices(mesh, 1.e-6*min_dx)) {
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "writeZeroLevelSetMeshToFile(): "
+              << "Unable to allocate memory for mesh."
+              << endl);
+  }
+
+  char rank_suffix[16];
+  sprintf(rank_suffix, ".%05d", tbox::MPI::getRank());
+  std::string processor_file_name = file_name + rank_suffix;
+  if (LSM_writeMeshToBinaryFile(mesh, processor_file_name.c_str())) {
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "writeZeroLevelSetMeshToFile(): "
+              << "Unable to write file '" << processor_file_name << "'."
+              << endl);
+  }
+
+  int num_elements = mesh->num_elements;
+  LSM_destroyMesh(mesh);
+
+  LSM_INSTRUMENTATION_START(t_reduction);
+  num_elements = tbox::MPI::sumReduction(num_elements);
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_REDUCTION, t_reduction,
+    sizeof(num_elements), 0);
+
+  return num_elements;
 }
 
 
@@ -6234,7 +6503,12 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeStableAdvectionDt(
     } // end loop over patches in level
   } // end loop over levels in hierarchy
 
-  return tbox::MPI::minReduction(max_advection_dt);
+  LSM_INSTRUMENTATION_START(t_reduction);
+  max_advection_dt = tbox::MPI::minReduction(max_advection_dt);
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_REDUCTION, t_reduction,
+    sizeof(max_advection_dt), 0);
+
+  return max_advection_dt;
 }
 
 
@@ -6436,7 +6710,12 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeStableNormalVelocityDt(
     } // end loop over patches in level
   } // end loop over levels in hierarchy
 
-  return tbox::MPI::minReduction(max_normal_vel_dt);
+  LSM_INSTRUMENTATION_START(t_reduction);
+  max_normal_vel_dt = tbox::MPI::minReduction(max_normal_vel_dt);
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_REDUCTION, t_reduction,
+    sizeof(max_normal_vel_dt), 0);
+
+  return max_normal_vel_dt;
 }
 
 
@@ -6591,7 +6870,12 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::maxNormOfDifference(
     } // end loop over patches in level
   } // end loop over levels in hierarchy
 
-  return tbox::MPI::maxReduction(max_norm_diff);
+  LSM_INSTRUMENTATION_START(t_reduction);
+  max_norm_diff = tbox::MPI::maxReduction(max_norm_diff);
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_REDUCTION, t_reduction,
+    sizeof(max_norm_diff), 0);
+
+  return max_norm_diff;
 }
 
 
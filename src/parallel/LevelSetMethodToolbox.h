@@ -35,6 +35,8 @@
  *  - computation of volume and surface integrals over regions
  *    defined by the zero level set; 
  *
+ *  - extraction of meshes of the zero level set for output;
+ *
  *  - computation of stable time step sizes for advection and 
  *    normal velocity evolution; 
  * 
@@ -57,6 +59,7 @@
  */
 
 
+#include <string>
 #include <vector>
 
 #include "SAMRAI_config.h"
@@ -936,6 +939,64 @@ public:
   //! @}
 
 
+  //! @{
+  /*!
+   ****************************************************************
+   *
+   * @name Methods for extracting the zero level set
+   *
+   ****************************************************************/
+
+  /*!
+   * writeZeroLevelSetMeshToFile() extracts a triangle mesh of the zero
+   * level set of phi (or, if psi_handle is specified, a line segment
+   * mesh of the \f$ \{ \phi=0,\psi=0 \} \f$ curves) using marching
+   * tetrahedra and writes it to a compact binary file (see
+   * LSM_writeMeshToBinaryFile()).
+   *
+   * Arguments:
+   *  - patch_hierarchy (in):        PatchHierarchy containing phi
+   *  - file_name (in):              base name of output files
+   *  - phi_handle (in):             PatchData handle for phi
+   *  - control_volume_handle (in):  PatchData handle for control volume
+   *  - phi_component (in):          component of phi to use as level set
+   *                                 function (default = 0)
+   *  - psi_handle (in):             PatchData handle for psi (default =
+   *                                 -1, i.e. extract zero level set of
+   *                                 phi)
+   *  - psi_component (in):          component of psi to use as level set
+   *                                 function (default = 0)
+   *
+   * Return value:                   total number of elements written by
+   *                                 all processors
+   *
+   * NOTES:
+   *  - Each processor extracts the mesh from its own patches and
+   *    writes it to the file "<file_name>.<processor number>" (with
+   *    the processor number padded to five digits).  Vertices are
+   *    welded across the patches owned by each processor.
+   *
+   *  - The grid cell between the cell centers (i,...,k) and
+   *    (i+1,...,k+1) is processed by the patch that contains cell
+   *    (i,...,k) when that cell is not covered by a finer level (i.e.
+   *    the control volume is positive).  phi (and psi) must have at
+   *    least one ghostcell filled.
+   *
+   *  - Only DIM = 3 is supported.
+   *
+   */
+  static int writeZeroLevelSetMeshToFile(
+    Pointer< PatchHierarchy<DIM> > patch_hierarchy,
+    const std::string& file_name,
+    const int phi_handle,
+    const int control_volume_handle,
+    const int phi_component = 0,
+    const int psi_handle = -1,
+    const int psi_component = 0);
+
+  //! @}
+
+
   //! @{
   /*!
    ****************************************************************
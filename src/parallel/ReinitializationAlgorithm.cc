@@ -1171,9 +1171,11 @@ void ReinitializationAlgorithm<DIM>::initializeCommunicationObjects()
               << endl);
   }
 
-  // lookup refine operations
+  // lookup refine operations (conservative linear interpolation is 
+  // used to be consistent with LevelSetFunctionIntegrator)
   Pointer< RefineOperator<DIM> > refine_op =
-    d_grid_geometry->lookupRefineOperator(phi_variable, "LINEAR_REFINE");
+    d_grid_geometry->lookupRefineOperator(phi_variable,
+                                          "CONSERVATIVE_LINEAR_REFINE");
 
 
   /*
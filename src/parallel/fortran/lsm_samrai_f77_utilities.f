@@ -172,3 +172,423 @@ c     } end loop over grid
       end
 c } end subroutine
 c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm1dSAMRAIUtilitiesTagCellsNearZeroLevelSets() tags cells that
+c  lie within the specified distance of the zero level set for 1D
+c  problems.  A cell is tagged if |phi| and |psi| are both less than
+c  the cutoff value.  For codimension-one problems, phi should be 
+c  passed as both phi and psi.  Cells that are not within the cutoff
+c  distance are left unchanged.
+c
+c  Arguments:
+c    tags (in/out):       tag data (set to 1 for tagged cells)
+c    phi (in):            level set function
+c    psi (in):            level set function
+c    cutoff (in):         cutoff distance
+c    *_gb (in):           index range for ghostbox
+c    *_fb (in):           index range for fillbox
+c
+c***********************************************************************
+      subroutine lsm1dSAMRAIUtilitiesTagCellsNearZeroLevelSets(
+     &  tags,
+     &  ilo_tag_gb, ihi_tag_gb,
+     &  phi,
+     &  ilo_phi_gb, ihi_phi_gb,
+     &  psi,
+     &  ilo_psi_gb, ihi_psi_gb,
+     &  ilo_fb, ihi_fb,
+     &  cutoff)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+c     _gb refers to ghostbox 
+c     _fb refers to fillbox 
+      integer ilo_tag_gb, ihi_tag_gb
+      integer ilo_phi_gb, ihi_phi_gb
+      integer ilo_psi_gb, ihi_psi_gb
+      integer ilo_fb, ihi_fb
+      integer tags(ilo_tag_gb:ihi_tag_gb)
+      real phi(ilo_phi_gb:ihi_phi_gb)
+      real psi(ilo_psi_gb:ihi_psi_gb)
+      real cutoff
+      integer i
+
+c     loop over cells in fillbox {
+      do i=ilo_fb,ihi_fb
+
+        if ( (abs(phi(i)) .lt. cutoff) .and.
+     &       (abs(psi(i)) .lt. cutoff) ) then
+          tags(i) = 1
+        endif
+
+      enddo
+c     } end loop over grid 
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm1dSAMRAIUtilitiesCountCellsNearZeroLevelSets() counts the 
+c  number of cells that lie within the specified distance of the 
+c  zero level set for 1D problems.  A cell is counted if |phi| and 
+c  |psi| are both less than the cutoff value.  For codimension-one 
+c  problems, phi should be passed as both phi and psi.
+c
+c  Arguments:
+c    num_cells (out):     number of cells within cutoff distance
+c    phi (in):            level set function
+c    psi (in):            level set function
+c    cutoff (in):         cutoff distance
+c    *_gb (in):           index range for ghostbox
+c    *_fb (in):           index range for fillbox
+c
+c***********************************************************************
+      subroutine lsm1dSAMRAIUtilitiesCountCellsNearZeroLevelSets(
+     &  num_cells,
+     &  phi,
+     &  ilo_phi_gb, ihi_phi_gb,
+     &  psi,
+     &  ilo_psi_gb, ihi_psi_gb,
+     &  ilo_fb, ihi_fb,
+     &  cutoff)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+c     _gb refers to ghostbox 
+c     _fb refers to fillbox 
+      integer ilo_phi_gb, ihi_phi_gb
+      integer ilo_psi_gb, ihi_psi_gb
+      integer ilo_fb, ihi_fb
+      integer num_cells
+      real phi(ilo_phi_gb:ihi_phi_gb)
+      real psi(ilo_psi_gb:ihi_psi_gb)
+      real cutoff
+      integer i
+
+      num_cells = 0
+
+c     loop over cells in fillbox {
+      do i=ilo_fb,ihi_fb
+
+        if ( (abs(phi(i)) .lt. cutoff) .and.
+     &       (abs(psi(i)) .lt. cutoff) ) then
+          num_cells = num_cells + 1
+        endif
+
+      enddo
+c     } end loop over grid 
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm2dSAMRAIUtilitiesTagCellsNearZeroLevelSets() tags cells that
+c  lie within the specified distance of the zero level set for 2D
+c  problems.  A cell is tagged if |phi| and |psi| are both less than
+c  the cutoff value.  For codimension-one problems, phi should be 
+c  passed as both phi and psi.  Cells that are not within the cutoff
+c  distance are left unchanged.
+c
+c  Arguments:
+c    tags (in/out):       tag data (set to 1 for tagged cells)
+c    phi (in):            level set function
+c    psi (in):            level set function
+c    cutoff (in):         cutoff distance
+c    *_gb (in):           index range for ghostbox
+c    *_fb (in):           index range for fillbox
+c
+c***********************************************************************
+      subroutine lsm2dSAMRAIUtilitiesTagCellsNearZeroLevelSets(
+     &  tags,
+     &  ilo_tag_gb, ihi_tag_gb,
+     &  jlo_tag_gb, jhi_tag_gb,
+     &  phi,
+     &  ilo_phi_gb, ihi_phi_gb,
+     &  jlo_phi_gb, jhi_phi_gb,
+     &  psi,
+     &  ilo_psi_gb, ihi_psi_gb,
+     &  jlo_psi_gb, jhi_psi_gb,
+     &  ilo_fb, ihi_fb,
+     &  jlo_fb, jhi_fb,
+     &  cutoff)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+c     _gb refers to ghostbox 
+c     _fb refers to fillbox 
+      integer ilo_tag_gb, ihi_tag_gb
+      integer jlo_tag_gb, jhi_tag_gb
+      integer ilo_phi_gb, ihi_phi_gb
+      integer jlo_phi_gb, jhi_phi_gb
+      integer ilo_psi_gb, ihi_psi_gb
+      integer jlo_psi_gb, jhi_psi_gb
+      integer ilo_fb, ihi_fb
+      integer jlo_fb, jhi_fb
+      integer tags(ilo_tag_gb:ihi_tag_gb,
+     &             jlo_tag_gb:jhi_tag_gb)
+      real phi(ilo_phi_gb:ihi_phi_gb,
+     &         jlo_phi_gb:jhi_phi_gb)
+      real psi(ilo_psi_gb:ihi_psi_gb,
+     &         jlo_psi_gb:jhi_psi_gb)
+      real cutoff
+      integer i, j
+
+c     loop over cells in fillbox {
+      do j=jlo_fb,jhi_fb
+        do i=ilo_fb,ihi_fb
+
+          if ( (abs(phi(i,j)) .lt. cutoff) .and.
+     &         (abs(psi(i,j)) .lt. cutoff) ) then
+            tags(i,j) = 1
+          endif
+
+        enddo
+      enddo
+c     } end loop over grid 
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm2dSAMRAIUtilitiesCountCellsNearZeroLevelSets() counts the 
+c  number of cells that lie within the specified distance of the 
+c  zero level set for 2D problems.  A cell is counted if |phi| and 
+c  |psi| are both less than the cutoff value.  For codimension-one 
+c  problems, phi should be passed as both phi and psi.
+c
+c  Arguments:
+c    num_cells (out):     number of cells within cutoff distance
+c    phi (in):            level set function
+c    psi (in):            level set function
+c    cutoff (in):         cutoff distance
+c    *_gb (in):           index range for ghostbox
+c    *_fb (in):           index range for fillbox
+c
+c***********************************************************************
+      subroutine lsm2dSAMRAIUtilitiesCountCellsNearZeroLevelSets(
+     &  num_cells,
+     &  phi,
+     &  ilo_phi_gb, ihi_phi_gb,
+     &  jlo_phi_gb, jhi_phi_gb,
+     &  psi,
+     &  ilo_psi_gb, ihi_psi_gb,
+     &  jlo_psi_gb, jhi_psi_gb,
+     &  ilo_fb, ihi_fb,
+     &  jlo_fb, jhi_fb,
+     &  cutoff)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+c     _gb refers to ghostbox 
+c     _fb refers to fillbox 
+      integer ilo_phi_gb, ihi_phi_gb
+      integer jlo_phi_gb, jhi_phi_gb
+      integer ilo_psi_gb, ihi_psi_gb
+      integer jlo_psi_gb, jhi_psi_gb
+      integer ilo_fb, ihi_fb
+      integer jlo_fb, jhi_fb
+      integer num_cells
+      real phi(ilo_phi_gb:ihi_phi_gb,
+     &         jlo_phi_gb:jhi_phi_gb)
+      real psi(ilo_psi_gb:ihi_psi_gb,
+     &         jlo_psi_gb:jhi_psi_gb)
+      real cutoff
+      integer i, j
+
+      num_cells = 0
+
+c     loop over cells in fillbox {
+      do j=jlo_fb,jhi_fb
+        do i=ilo_fb,ihi_fb
+
+          if ( (abs(phi(i,j)) .lt. cutoff) .and.
+     &         (abs(psi(i,j)) .lt. cutoff) ) then
+            num_cells = num_cells + 1
+          endif
+
+        enddo
+      enddo
+c     } end loop over grid 
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm3dSAMRAIUtilitiesTagCellsNearZeroLevelSets() tags cells that
+c  lie within the specified distance of the zero level set for 3D
+c  problems.  A cell is tagged if |phi| and |psi| are both less than
+c  the cutoff value.  For codimension-one problems, phi should be 
+c  passed as both phi and psi.  Cells that are not within the cutoff
+c  distance are left unchanged.
+c
+c  Arguments:
+c    tags (in/out):       tag data (set to 1 for tagged cells)
+c    phi (in):            level set function
+c    psi (in):            level set function
+c    cutoff (in):         cutoff distance
+c    *_gb (in):           index range for ghostbox
+c    *_fb (in):           index range for fillbox
+c
+c***********************************************************************
+      subroutine lsm3dSAMRAIUtilitiesTagCellsNearZeroLevelSets(
+     &  tags,
+     &  ilo_tag_gb, ihi_tag_gb,
+     &  jlo_tag_gb, jhi_tag_gb,
+     &  klo_tag_gb, khi_tag_gb,
+     &  phi,
+     &  ilo_phi_gb, ihi_phi_gb,
+     &  jlo_phi_gb, jhi_phi_gb,
+     &  klo_phi_gb, khi_phi_gb,
+     &  psi,
+     &  ilo_psi_gb, ihi_psi_gb,
+     &  jlo_psi_gb, jhi_psi_gb,
+     &  klo_psi_gb, khi_psi_gb,
+     &  ilo_fb, ihi_fb,
+     &  jlo_fb, jhi_fb,
+     &  klo_fb, khi_fb,
+     &  cutoff)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+c     _gb refers to ghostbox 
+c     _fb refers to fillbox 
+      integer ilo_tag_gb, ihi_tag_gb
+      integer jlo_tag_gb, jhi_tag_gb
+      integer klo_tag_gb, khi_tag_gb
+      integer ilo_phi_gb, ihi_phi_gb
+      integer jlo_phi_gb, jhi_phi_gb
+      integer klo_phi_gb, khi_phi_gb
+      integer ilo_psi_gb, ihi_psi_gb
+      integer jlo_psi_gb, jhi_psi_gb
+      integer klo_psi_gb, khi_psi_gb
+      integer ilo_fb, ihi_fb
+      integer jlo_fb, jhi_fb
+      integer klo_fb, khi_fb
+      integer tags(ilo_tag_gb:ihi_tag_gb,
+     &             jlo_tag_gb:jhi_tag_gb,
+     &             klo_tag_gb:khi_tag_gb)
+      real phi(ilo_phi_gb:ihi_phi_gb,
+     &         jlo_phi_gb:jhi_phi_gb,
+     &         klo_phi_gb:khi_phi_gb)
+      real psi(ilo_psi_gb:ihi_psi_gb,
+     &         jlo_psi_gb:jhi_psi_gb,
+     &         klo_psi_gb:khi_psi_gb)
+      real cutoff
+      integer i, j, k
+
+c     loop over cells in fillbox {
+      do k=klo_fb,khi_fb
+        do j=jlo_fb,jhi_fb
+          do i=ilo_fb,ihi_fb
+
+            if ( (abs(phi(i,j,k)) .lt. cutoff) .and.
+     &           (abs(psi(i,j,k)) .lt. cutoff) ) then
+              tags(i,j,k) = 1
+            endif
+
+          enddo
+        enddo
+      enddo
+c     } end loop over grid 
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm3dSAMRAIUtilitiesCountCellsNearZeroLevelSets() counts the 
+c  number of cells that lie within the specified distance of the 
+c  zero level set for 3D problems.  A cell is counted if |phi| and 
+c  |psi| are both less than the cutoff value.  For codimension-one 
+c  problems, phi should be passed as both phi and psi.
+c
+c  Arguments:
+c    num_cells (out):     number of cells within cutoff distance
+c    phi (in):            level set function
+c    psi (in):            level set function
+c    cutoff (in):         cutoff distance
+c    *_gb (in):           index range for ghostbox
+c    *_fb (in):           index range for fillbox
+c
+c***********************************************************************
+      subroutine lsm3dSAMRAIUtilitiesCountCellsNearZeroLevelSets(
+     &  num_cells,
+     &  phi,
+     &  ilo_phi_gb, ihi_phi_gb,
+     &  jlo_phi_gb, jhi_phi_gb,
+     &  klo_phi_gb, khi_phi_gb,
+     &  psi,
+     &  ilo_psi_gb, ihi_psi_gb,
+     &  jlo_psi_gb, jhi_psi_gb,
+     &  klo_psi_gb, khi_psi_gb,
+     &  ilo_fb, ihi_fb,
+     &  jlo_fb, jhi_fb,
+     &  klo_fb, khi_fb,
+     &  cutoff)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+c     _gb refers to ghostbox 
+c     _fb refers to fillbox 
+      integer ilo_phi_gb, ihi_phi_gb
+      integer jlo_phi_gb, jhi_phi_gb
+      integer klo_phi_gb, khi_phi_gb
+      integer ilo_psi_gb, ihi_psi_gb
+      integer jlo_psi_gb, jhi_psi_gb
+      integer klo_psi_gb, khi_psi_gb
+      integer ilo_fb, ihi_fb
+      integer jlo_fb, jhi_fb
+      integer klo_fb, khi_fb
+      integer num_cells
+      real phi(ilo_phi_gb:ihi_phi_gb,
+     &         jlo_phi_gb:jhi_phi_gb,
+     &         klo_phi_gb:khi_phi_gb)
+      real psi(ilo_psi_gb:ihi_psi_gb,
+     &         jlo_psi_gb:jhi_psi_gb,
+     &         klo_psi_gb:khi_psi_gb)
+      real cutoff
+      integer i, j, k
+
+      num_cells = 0
+
+c     loop over cells in fillbox {
+      do k=klo_fb,khi_fb
+        do j=jlo_fb,jhi_fb
+          do i=ilo_fb,ihi_fb
+
+            if ( (abs(phi(i,j,k)) .lt. cutoff) .and.
+     &           (abs(psi(i,j,k)) .lt. cutoff) ) then
+              num_cells = num_cells + 1
+            endif
+
+          enddo
+        enddo
+      enddo
+c     } end loop over grid 
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
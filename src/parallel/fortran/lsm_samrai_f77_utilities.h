@@ -22,6 +22,18 @@
 #define LSM1D_SAMRAI_UTILITIES_COPY_DATA   lsm1dsamraiutilitiescopydata_
 #define LSM2D_SAMRAI_UTILITIES_COPY_DATA   lsm2dsamraiutilitiescopydata_
 #define LSM3D_SAMRAI_UTILITIES_COPY_DATA   lsm3dsamraiutilitiescopydata_
+#define LSM1D_SAMRAI_UTILITIES_TAG_CELLS_NEAR_ZERO_LEVEL_SETS              \
+        lsm1dsamraiutilitiestagcellsnearzerolevelsets_
+#define LSM2D_SAMRAI_UTILITIES_TAG_CELLS_NEAR_ZERO_LEVEL_SETS              \
+        lsm2dsamraiutilitiestagcellsnearzerolevelsets_
+#define LSM3D_SAMRAI_UTILITIES_TAG_CELLS_NEAR_ZERO_LEVEL_SETS              \
+        lsm3dsamraiutilitiestagcellsnearzerolevelsets_
+#define LSM1D_SAMRAI_UTILITIES_COUNT_CELLS_NEAR_ZERO_LEVEL_SETS            \
+        lsm1dsamraiutilitiescountcellsnearzerolevelsets_
+#define LSM2D_SAMRAI_UTILITIES_COUNT_CELLS_NEAR_ZERO_LEVEL_SETS            \
+        lsm2dsamraiutilitiescountcellsnearzerolevelsets_
+#define LSM3D_SAMRAI_UTILITIES_COUNT_CELLS_NEAR_ZERO_LEVEL_SETS            \
+        lsm3dsamraiutilitiescountcellsnearzerolevelsets_
 
 void LSM1D_SAMRAI_UTILITIES_COPY_DATA(
   LSMLIB_REAL *dst_data,
@@ -71,4 +83,124 @@ void LSM3D_SAMRAI_UTILITIES_COPY_DATA(
   const int *klo_fb,
   const int *khi_fb);
 
+void LSM1D_SAMRAI_UTILITIES_TAG_CELLS_NEAR_ZERO_LEVEL_SETS(
+  int *tags,
+  const int *ilo_tag_gb,
+  const int *ihi_tag_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const LSMLIB_REAL *psi,
+  const int *ilo_psi_gb,
+  const int *ihi_psi_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const LSMLIB_REAL *cutoff);
+
+void LSM2D_SAMRAI_UTILITIES_TAG_CELLS_NEAR_ZERO_LEVEL_SETS(
+  int *tags,
+  const int *ilo_tag_gb,
+  const int *ihi_tag_gb,
+  const int *jlo_tag_gb,
+  const int *jhi_tag_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const LSMLIB_REAL *psi,
+  const int *ilo_psi_gb,
+  const int *ihi_psi_gb,
+  const int *jlo_psi_gb,
+  const int *jhi_psi_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *cutoff);
+
+void LSM3D_SAMRAI_UTILITIES_TAG_CELLS_NEAR_ZERO_LEVEL_SETS(
+  int *tags,
+  const int *ilo_tag_gb,
+  const int *ihi_tag_gb,
+  const int *jlo_tag_gb,
+  const int *jhi_tag_gb,
+  const int *klo_tag_gb,
+  const int *khi_tag_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const int *klo_phi_gb,
+  const int *khi_phi_gb,
+  const LSMLIB_REAL *psi,
+  const int *ilo_psi_gb,
+  const int *ihi_psi_gb,
+  const int *jlo_psi_gb,
+  const int *jhi_psi_gb,
+  const int *klo_psi_gb,
+  const int *khi_psi_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const int *klo_fb,
+  const int *khi_fb,
+  const LSMLIB_REAL *cutoff);
+
+void LSM1D_SAMRAI_UTILITIES_COUNT_CELLS_NEAR_ZERO_LEVEL_SETS(
+  int *num_cells,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const LSMLIB_REAL *psi,
+  const int *ilo_psi_gb,
+  const int *ihi_psi_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const LSMLIB_REAL *cutoff);
+
+void LSM2D_SAMRAI_UTILITIES_COUNT_CELLS_NEAR_ZERO_LEVEL_SETS(
+  int *num_cells,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const LSMLIB_REAL *psi,
+  const int *ilo_psi_gb,
+  const int *ihi_psi_gb,
+  const int *jlo_psi_gb,
+  const int *jhi_psi_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *cutoff);
+
+void LSM3D_SAMRAI_UTILITIES_COUNT_CELLS_NEAR_ZERO_LEVEL_SETS(
+  int *num_cells,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const int *klo_phi_gb,
+  const int *khi_phi_gb,
+  const LSMLIB_REAL *psi,
+  const int *ilo_psi_gb,
+  const int *ihi_psi_gb,
+  const int *jlo_psi_gb,
+  const int *jhi_psi_gb,
+  const int *klo_psi_gb,
+  const int *khi_psi_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const int *klo_fb,
+  const int *khi_fb,
+  const LSMLIB_REAL *cutoff);
+
 #endif
@@ -12,8 +12,8 @@
  *
  * \brief
  * @ref lsm_FMM_eikonal.c provides "generic" implementations of 
- *      first- and second-order accurate Fast Marching Method schemes
- *      for solving the Eikonal equation.  The code is "templated" on 
+ *      first-, second- and third-order accurate Fast Marching Method 
+ *      schemes for solving the Eikonal equation.  The code is "templated" on 
  *      the number of dimensions through the use of macro definitions 
  *      that MUST be provided by the user.  
  *
@@ -24,6 +24,17 @@
  *    -# FMM_NDIM:  the number of spatial dimensions.
  *    -# FMM_EIKONAL_SOLVE_EIKONAL_EQUATION:  desired name of function 
  *       that solves the Eikonal equation.
+ *    -# FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_WORKSPACE:  desired name 
+ *       of function that solves the Eikonal equation using a 
+ *       user-provided FMM_Workspace.
+ *    -# FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_BATCH:  desired name of 
+ *       function that solves the Eikonal equation for a batch of 
+ *       solutions using an EikonalBatchSolver.
+ *    -# FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_TO_TARGETS:  desired name of 
+ *       function that solves the Eikonal equation until the solution 
+ *       is known at a set of target points.
+ *    -# FMM_EIKONAL_COMPUTE_PATH:  desired name of function that 
+ *       computes a minimal arrival time path by gradient descent.
  *    -# FMM_EIKONAL_INITIALIZE_FRONT:  desired name of function that
  *       initializes the values on the front.
  *    -# FMM_EIKONAL_UPDATE_GRID_POINT_ORDER1:  desired name of function 
@@ -32,6 +43,9 @@
  *    -# FMM_EIKONAL_UPDATE_GRID_POINT_ORDER2:  desired name of function 
  *       that updates the value of the solution at grid points using
  *       a second-order accurate discretization
+ *    -# FMM_EIKONAL_UPDATE_GRID_POINT_ORDER3:  desired name of function 
+ *       that updates the value of the solution at grid points using
+ *       a third-order accurate discretization
  * -# Include this file at the end of the implementation file
  *    for the n-dimentsional Eikonal equation solver.
  * -# Compile code.
@@ -55,6 +69,10 @@
 #include "FMM_Heap.h"
 #include "FMM_Macros.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 /*
  * This macro protect against misuse of the code in this file.  It will
@@ -66,6 +84,18 @@
 #ifndef FMM_EIKONAL_SOLVE_EIKONAL_EQUATION
 #error "lsm_FMM_eikonal: required macro FMM_EIKONAL_SOLVE_EIKONAL_EQUATION not defined!"
 #endif
+#ifndef FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_WORKSPACE
+#error "lsm_FMM_eikonal: required macro FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_WORKSPACE not defined!"
+#endif
+#ifndef FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_BATCH
+#error "lsm_FMM_eikonal: required macro FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_BATCH not defined!"
+#endif
+#ifndef FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_TO_TARGETS
+#error "lsm_FMM_eikonal: required macro FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_TO_TARGETS not defined!"
+#endif
+#ifndef FMM_EIKONAL_COMPUTE_PATH
+#error "lsm_FMM_eikonal: required macro FMM_EIKONAL_COMPUTE_PATH not defined!"
+#endif
 #ifndef FMM_EIKONAL_INITIALIZE_FRONT
 #error "lsm_FMM_eikonal: required macro FMM_EIKONAL_INITIALIZE_FRONT not defined!"
 #endif
@@ -75,12 +105,25 @@
 #ifndef FMM_EIKONAL_UPDATE_GRID_POINT_ORDER2
 #error "lsm_FMM_eikonal: required macro FMM_EIKONAL_UPDATE_GRID_POINT_ORDER2 not defined!"
 #endif
+#ifndef FMM_EIKONAL_UPDATE_GRID_POINT_ORDER3
+#error "lsm_FMM_eikonal: required macro FMM_EIKONAL_UPDATE_GRID_POINT_ORDER3 not defined!"
+#endif
 
 
 /*================== lsm_FMM_eikonal Data Structures ================*/
 struct FMM_FieldData {
   LSMLIB_REAL *phi;         /* solution to Eikonal equation */
   LSMLIB_REAL *speed;       /* speed function               */
+  int *source_label;        /* label of nearest source      */
+                            /* (NULL if not computed)       */
+  LSMLIB_REAL *label_phi;   /* arrival time from sources    */
+                            /* with the same label          */
+  updateGridPointFuncPtr updatePhi;  /* update function for phi  */
+                                     /* when labels are computed */
+  int *target_idx;          /* grid indices of target points */
+  int num_targets;          /* number of target points       */
+  LSMLIB_REAL heuristic_scale;  /* weight of heuristic divided */
+                                /* by maximum speed            */
 };
 
 
@@ -133,6 +176,101 @@ LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER2(
   int *grid_dims,
   LSMLIB_REAL *dx);
 
+/* 
+ * FMM_EIKONAL_UPDATE_GRID_POINT_ORDER3() implements the callback  
+ * function required by FMM_Core::FMM_Core_updateNeighbors() to 
+ * update the solution at a grid point.  It is identical to 
+ * FMM_EIKONAL_UPDATE_GRID_POINT_ORDER2() except that a third-order 
+ * accurate one-sided discretization of the gradient operator is used
+ * when three "KNOWN" neighbors are available in the upwind direction.
+ * When fewer "KNOWN" neighbors are available, the discretization of 
+ * the gradient drops to second- or first-order accuracy.
+ */
+LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER3(
+  FMM_CoreData *fmm_core_data,
+  FMM_FieldData *fmm_field_data,
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*
+ * FMM_Eikonal_updateGridPointAndLabel() implements the callback
+ * function required by FMM_Core::FMM_Core_updateNeighbors() when
+ * the labels of the nearest sources are computed.  It updates phi
+ * using fmm_field_data->updatePhi() and updates the label of the 
+ * grid point.
+ *
+ * For each label of the "KNOWN" neighbors, a first-order accurate 
+ * arrival time is computed from the values of label_phi at the 
+ * "KNOWN" neighbors with that label.  The grid point is assigned the 
+ * label with the smallest arrival time, which is stored in label_phi.
+ * Because label_phi only depends on neighbors with the same label, 
+ * the label of a source does not spread along the boundary between 
+ * the regions of two other sources (as it would if the label were 
+ * taken from the neighbor with the smallest value of phi).
+ */
+static LSMLIB_REAL FMM_Eikonal_updateGridPointAndLabel(
+  FMM_CoreData *fmm_core_data,
+  FMM_FieldData *fmm_field_data,
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*
+ * FMM_Eikonal_heuristic() implements the callback function used by
+ * FMM_Core::FMM_Core_updateNeighbors() to order the "trial" points
+ * when the Eikonal equation is solved until the solution is known 
+ * at a set of target points.  It returns the distance from the grid 
+ * point to the nearest target point multiplied by heuristic_scale.
+ */
+static LSMLIB_REAL FMM_Eikonal_heuristic(
+  FMM_CoreData *fmm_core_data,
+  FMM_FieldData *fmm_field_data,
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*
+ * FMM_Eikonal_solve() solves the Eikonal equation (and computes the
+ * labels of the nearest sources if source_label is not NULL).  If
+ * outside_pts is not NULL, the grid points outside of the domain of
+ * the problem are taken from outside_pts instead of being computed
+ * from the mask and speed function.  If target_idx is not NULL, the
+ * calculation is stopped as soon as the solution is known at all of
+ * the target points.
+ */
+static int FMM_Eikonal_solve(
+  LSMLIB_REAL *phi,
+  int *source_label,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int *outside_pts,
+  int num_outside_pts,
+  int *target_idx,
+  int num_targets,
+  LSMLIB_REAL *target_values,
+  LSMLIB_REAL heuristic_weight,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  FMM_Workspace *workspace);
+
+/*
+ * FMM_Eikonal_computeGradient() computes the gradient of phi at a grid
+ * point using central differences (one-sided differences next to grid 
+ * points where phi is not known).  It returns 0 if phi is not known 
+ * at the grid point and 1 otherwise.
+ */
+static int FMM_Eikonal_computeGradient(
+  LSMLIB_REAL *grad_phi,
+  LSMLIB_REAL *phi,
+  int *grid_idx,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
 
 /*==================== Function Definitions =========================*/
 
@@ -144,19 +282,192 @@ int FMM_EIKONAL_SOLVE_EIKONAL_EQUATION(
   int spatial_discretization_order,
   int *grid_dims,
   LSMLIB_REAL *dx)
+{
+  return FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_WORKSPACE(
+           phi,
+           speed,
+           mask,
+           spatial_discretization_order,
+           grid_dims,
+           dx,
+           0); /* NULL workspace pointer */
+}
+
+int FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_WORKSPACE(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  FMM_Workspace *workspace)
+{
+  return FMM_Eikonal_solve(
+           phi,
+           0, /* NULL source_label pointer */
+           speed,
+           mask,
+           0, /* NULL outside_pts pointer */
+           0,
+           0, /* NULL target_idx pointer */
+           0,
+           0,
+           0,
+           spatial_discretization_order,
+           grid_dims,
+           dx,
+           workspace);
+}
+
+int FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_BATCH(
+  LSMLIB_REAL **phi,
+  int **source_label,
+  int num_solves,
+  EikonalBatchSolver *solver)
+{
+  int error_code = LSM_FMM_ERR_SUCCESS;
+  int n;  /* loop variable */
+
+  if ( (!solver) || (solver->num_dims != FMM_NDIM) ) {
+    fprintf(stderr,
+           "ERROR: EikonalBatchSolver has wrong number of dimensions.\n");
+    return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+  }
+
+  /* 
+   * each thread uses its own FMM_Workspace, so the solutions
+   * may be computed concurrently
+   */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1) \
+                         num_threads(solver->num_workspaces)
+#endif
+  for (n = 0; n < num_solves; n++) {
+
+#ifdef _OPENMP
+    int thread_num = omp_get_thread_num();
+#else
+    int thread_num = 0;
+#endif
+    int solve_error_code = FMM_Eikonal_solve(
+      phi[n],
+      (source_label) ? source_label[n] : 0,
+      solver->speed,
+      0, /* mask is represented by outside_pts */
+      solver->outside_pts,
+      solver->num_outside_pts,
+      0, /* NULL target_idx pointer */
+      0,
+      0,
+      0,
+      solver->spatial_discretization_order,
+      solver->grid_dims,
+      solver->dx,
+      solver->workspaces[thread_num]);
+
+    if (solve_error_code != LSM_FMM_ERR_SUCCESS) {
+#ifdef _OPENMP
+#pragma omp critical (lsm_FMM_eikonal_batch)
+#endif
+      error_code = solve_error_code;
+    }
+  }
+
+  return error_code;
+}
+
+int FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_TO_TARGETS(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *target_values,
+  int *target_idx,
+  int num_targets,
+  LSMLIB_REAL heuristic_weight,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  FMM_Workspace *workspace)
+{
+  return FMM_Eikonal_solve(
+           phi,
+           0, /* NULL source_label pointer */
+           speed,
+           mask,
+           0, /* NULL outside_pts pointer */
+           0,
+           (num_targets > 0) ? target_idx : 0,
+           num_targets,
+           target_values,
+           heuristic_weight,
+           spatial_discretization_order,
+           grid_dims,
+           dx,
+           workspace);
+}
+
+static int FMM_Eikonal_solve(
+  LSMLIB_REAL *phi,
+  int *source_label,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int *outside_pts,
+  int num_outside_pts,
+  int *target_idx,
+  int num_targets,
+  LSMLIB_REAL *target_values,
+  LSMLIB_REAL heuristic_weight,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  FMM_Workspace *workspace)
 {
   /* fast marching method data */
   FMM_CoreData *fmm_core_data;
+  FMM_FieldData fmm_field_data;
 
   /* pointers to callback functions */
   updateGridPointFuncPtr updateGridPoint;
   initializeFrontFuncPtr initializeFront;
 
+  /* target points that have not been accepted */
+  int *remaining_targets = 0;
+  int num_remaining_targets = 0;
+  unsigned char *gridpoint_status;
+
   /* auxiliary variables */
   int num_gridpoints;       /* number of grid points */
   int i, idx;               /* loop variables */
 
 
+  /******************************************************
+   * check target points
+   ******************************************************/
+  num_gridpoints = 1;
+  for (i = 0; i < FMM_NDIM; i++) {
+    num_gridpoints *= grid_dims[i];
+  }
+
+  if (target_idx) {
+    int grid_idx_out_of_bounds;
+    if (num_targets > 0) {
+      remaining_targets = (int*) malloc(num_targets*sizeof(int));
+      if (!remaining_targets) return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+    }
+    for (i = 0; i < num_targets; i++) {
+      int *target = &(target_idx[FMM_NDIM*i]);
+      LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,target,grid_dims);
+      if (grid_idx_out_of_bounds) {
+        fprintf(stderr,"ERROR: Target point outside of grid.\n");
+        free(remaining_targets);
+        return LSM_FMM_ERR_INVALID_TARGET;
+      }
+      LSM_FMM_IDX(remaining_targets[i], target, grid_dims);
+    }
+    num_remaining_targets = num_targets;
+  }
+
+
   /******************************************************
    * set up appropriate grid point update and front
    * detection/initialization functions based on the
@@ -167,95 +478,600 @@ int FMM_EIKONAL_SOLVE_EIKONAL_EQUATION(
     updateGridPoint = &FMM_EIKONAL_UPDATE_GRID_POINT_ORDER1;
   } else if (spatial_discretization_order == 2) {
     updateGridPoint = &FMM_EIKONAL_UPDATE_GRID_POINT_ORDER2;
+  } else if (spatial_discretization_order == 3) {
+    updateGridPoint = &FMM_EIKONAL_UPDATE_GRID_POINT_ORDER3;
   } else {
     fprintf(stderr,
-           "ERROR: Invalid spatial derivative order.  Only first-\n");
+           "ERROR: Invalid spatial derivative order.  Only first-,\n");
     fprintf(stderr,
-           "       and second-order finite differences supported.\n");
+           "       second- and third-order finite differences supported.\n");
+    if (remaining_targets) free(remaining_targets);
     return LSM_FMM_ERR_INVALID_SPATIAL_DISCRETIZATION_ORDER;
   }
 
   /********************************************
    * set up FMM Field Data
    ********************************************/
-  FMM_FieldData *fmm_field_data = 
-    (FMM_FieldData*) malloc(sizeof(FMM_FieldData));
-  if (!fmm_field_data) return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
-  fmm_field_data->phi   = phi;
-  fmm_field_data->speed = speed;
+  fmm_field_data.phi   = phi;
+  fmm_field_data.speed = speed;
+  fmm_field_data.source_label = source_label;
+  fmm_field_data.label_phi = 0;
+  fmm_field_data.updatePhi = updateGridPoint;
+  fmm_field_data.target_idx = target_idx;
+  fmm_field_data.num_targets = num_targets;
+  fmm_field_data.heuristic_scale = 0;
+  if (source_label) {
+    updateGridPoint = &FMM_Eikonal_updateGridPointAndLabel;
+  }
    
   /********************************************
    * initialize FMM Core Data
    ********************************************/
-  fmm_core_data = FMM_Core_createFMM_CoreData(
-    fmm_field_data,
+  fmm_core_data = FMM_Core_createFMM_CoreDataWithWorkspace(
+    &fmm_field_data,
     FMM_NDIM,
     grid_dims,
     dx,
     initializeFront,
-    updateGridPoint);
-  if (!fmm_core_data) return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+    updateGridPoint,
+    workspace);
+  if (!fmm_core_data) {
+    if (remaining_targets) free(remaining_targets);
+    return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+  }
+
+  /* 
+   * order trial points using the distance to the nearest target
+   * divided by the maximum speed, which is a lower bound on the 
+   * arrival time from the grid point to the target
+   */
+  if ( (target_idx) && (num_targets > 0) && (heuristic_weight > 0) ) {
+    LSMLIB_REAL max_speed = 0;
+    for (idx = 0; idx < num_gridpoints; idx++) {
+      if ( ((!mask) || (mask[idx] >= 0)) && (speed[idx] > max_speed) ) {
+        max_speed = speed[idx];
+      }
+    }
+    if (max_speed > 0) {
+      fmm_field_data.heuristic_scale = heuristic_weight/max_speed;
+      FMM_Core_setHeuristic(fmm_core_data, &FMM_Eikonal_heuristic);
+    }
+  }
 
   /********************************************
    * initialize phi and mark grid points
    * outside of the mathematical/physical 
    * domain
    ********************************************/
-  num_gridpoints = 1;
-  for (i = 0; i < FMM_NDIM; i++) {
-    num_gridpoints *= grid_dims[i];
+
+  /* labels of grid points that are not sources are set when */
+  /* the grid points are updated                             */
+  if (source_label) {
+    fmm_field_data.label_phi = 
+      FMM_Core_getScratchData(fmm_core_data, num_gridpoints);
+    if (!fmm_field_data.label_phi) {
+      FMM_Core_destroyFMM_CoreData(fmm_core_data);
+      if (remaining_targets) free(remaining_targets);
+      return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+    }
+    for (idx = 0; idx < num_gridpoints; idx++) {
+      if (phi[idx] <= -LSMLIB_ZERO_TOL) {
+        source_label[idx] = -1;
+      } else {
+        fmm_field_data.label_phi[idx] = phi[idx];
+      }
+    }
   }
 
-  for (idx = 0; idx < num_gridpoints; idx++) {
+  if (outside_pts) {
 
-    /* temporary variables */
-    int grid_idx[FMM_NDIM];   /* grid index */
-    int idx_remainder = idx;
+    /* use grid points outside of domain provided by caller */
+    for (i = 0; i < num_outside_pts; i++) {
 
-    /* compute grid_idx */
-    for (i = 0; i < FMM_NDIM; i++) {
-      grid_idx[i] = idx_remainder%grid_dims[i];
-      idx_remainder -= grid_idx[i];
-      idx_remainder /= grid_dims[i];
-    }
-
-    /* grid points with a negative mask value are taken to */
-    /* be outside of the mathemtatical/physical domain     */
-    if ((mask) && (mask[idx] < 0)) {
+      /* temporary variables */
+      int grid_idx[FMM_NDIM];   /* grid index */
+      int idx_remainder;
+      int j;
+
+      idx = outside_pts[i];
+      idx_remainder = idx;
+
+      /* compute grid_idx */
+      for (j = 0; j < FMM_NDIM; j++) {
+        grid_idx[j] = idx_remainder%grid_dims[j];
+        idx_remainder -= grid_idx[j];
+        idx_remainder /= grid_dims[j];
+      }
 
       FMM_Core_markPointOutsideDomain(fmm_core_data, grid_idx);
 
       /* set phi to LSMLIB_REAL_MAX (i.e. infinity) */
       phi[idx] = LSMLIB_REAL_MAX;
+      if (source_label) source_label[idx] = -1;
     }
 
-    /* grid points with a non-positive speed are taken to */
-    /* be outside of the mathemtatical/physical domain    */
-    if (speed[idx] < LSMLIB_ZERO_TOL) {
+  } else {
 
-      FMM_Core_markPointOutsideDomain(fmm_core_data, grid_idx);
+    for (idx = 0; idx < num_gridpoints; idx++) {
 
-      /* speed is zero, so set phi to be LSMLIB_REAL_MAX (i.e. infinity) */
-      phi[idx] = LSMLIB_REAL_MAX;
-    }
+      /* temporary variables */
+      int grid_idx[FMM_NDIM];   /* grid index */
+      int idx_remainder = idx;
+
+      /* compute grid_idx */
+      for (i = 0; i < FMM_NDIM; i++) {
+        grid_idx[i] = idx_remainder%grid_dims[i];
+        idx_remainder -= grid_idx[i];
+        idx_remainder /= grid_dims[i];
+      }
+
+      /* grid points with a negative mask value are taken to */
+      /* be outside of the mathemtatical/physical domain     */
+      if ((mask) && (mask[idx] < 0)) {
+
+        FMM_Core_markPointOutsideDomain(fmm_core_data, grid_idx);
+
+        /* set phi to LSMLIB_REAL_MAX (i.e. infinity) */
+        phi[idx] = LSMLIB_REAL_MAX;
+        if (source_label) source_label[idx] = -1;
+      }
+
+      /* grid points with a non-positive speed are taken to */
+      /* be outside of the mathemtatical/physical domain    */
+      if (speed[idx] < LSMLIB_ZERO_TOL) {
+
+        FMM_Core_markPointOutsideDomain(fmm_core_data, grid_idx);
+
+        /* speed is zero, so set phi to be LSMLIB_REAL_MAX (i.e. infinity) */
+        phi[idx] = LSMLIB_REAL_MAX;
+        if (source_label) source_label[idx] = -1;
+      }
+
+    } /* end loop over grid to mark points outside of domain */ 
 
-  } /* end loop over grid to mark points outside of domain */ 
+  }
 
   /* initialize grid points around the front */ 
   FMM_Core_initializeFront(fmm_core_data); 
 
-  /* update remaining grid points */
-  while (FMM_Core_moreGridPointsToUpdate(fmm_core_data)) {
+  /* update remaining grid points (until all target points are known) */
+  gridpoint_status = FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+  while (1) {
+
+    if (target_idx) {
+
+      /* remove target points that are known or outside of the domain */
+      i = 0;
+      while (i < num_remaining_targets) {
+        PointStatus target_status = 
+          (PointStatus) gridpoint_status[remaining_targets[i]];
+        if ( (KNOWN == target_status) || (OUTSIDE_DOMAIN == target_status) ) {
+          remaining_targets[i] = remaining_targets[--num_remaining_targets];
+        } else {
+          i++;
+        }
+      }
+      if (num_remaining_targets == 0) break;
+    }
+
+    if (!FMM_Core_moreGridPointsToUpdate(fmm_core_data)) break;
     FMM_Core_advanceFront(fmm_core_data);
   }
 
+  /* set values at target points */
+  if ( (target_idx) && (target_values) ) {
+    for (i = 0; i < num_targets; i++) {
+      int *target = &(target_idx[FMM_NDIM*i]);
+      LSM_FMM_IDX(idx, target, grid_dims);
+      target_values[i] = (KNOWN == (PointStatus) gridpoint_status[idx]) ?
+                         phi[idx] : LSMLIB_REAL_MAX;
+    }
+  }
+
   /* clean up memory */
   FMM_Core_destroyFMM_CoreData(fmm_core_data);
-  free(fmm_field_data);
+  if (remaining_targets) free(remaining_targets);
 
   return LSM_FMM_ERR_SUCCESS;
 }
 
+static LSMLIB_REAL FMM_Eikonal_heuristic(
+  FMM_CoreData *fmm_core_data,
+  FMM_FieldData *fmm_field_data,
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  int *target_idx = fmm_field_data->target_idx;
+  LSMLIB_REAL dist_sq_min = LSMLIB_REAL_MAX;
+  int i, dir;  /* loop variables */
+
+  /* unused function parameters */
+  (void) fmm_core_data;
+  (void) num_dims;
+  (void) grid_dims;
+
+  for (i = 0; i < fmm_field_data->num_targets; i++) {
+    LSMLIB_REAL dist_sq = 0;
+    for (dir = 0; dir < FMM_NDIM; dir++) {
+      LSMLIB_REAL dist = (target_idx[FMM_NDIM*i+dir] - grid_idx[dir])*dx[dir];
+      dist_sq += dist*dist;
+    }
+    if (dist_sq < dist_sq_min) dist_sq_min = dist_sq;
+  }
+
+  return fmm_field_data->heuristic_scale*sqrt(dist_sq_min);
+}
+
+static LSMLIB_REAL FMM_Eikonal_updateGridPointAndLabel(
+  FMM_CoreData *fmm_core_data,
+  FMM_FieldData *fmm_field_data,
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  unsigned char *gridpoint_status = 
+    FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+
+  /* FMM Field Data variables */
+  LSMLIB_REAL *speed = fmm_field_data->speed;
+  int *source_label = fmm_field_data->source_label;
+  LSMLIB_REAL *label_phi = fmm_field_data->label_phi;
+
+  /* "KNOWN" neighbors */
+  int num_known = 0;
+  int known_label[2*FMM_NDIM];
+  int known_dir[2*FMM_NDIM];
+  LSMLIB_REAL known_phi[2*FMM_NDIM];
+
+  /* variables used in label update */
+  LSMLIB_REAL phi_updated;
+  LSMLIB_REAL label_phi_best = LSMLIB_REAL_MAX;
+  int label_best = -1;
+  int neighbor[FMM_NDIM];
+
+  /* auxilliary variables */
+  int dir;  /* loop variable for spatial directions */
+  int n;    /* loop variable for neighbors */
+  int l, m; /* extra loop variables */ 
+  int idx_cur_gridpoint, idx_neighbor;
+  int grid_idx_out_of_bounds;
+
+  /* update phi */
+  phi_updated = fmm_field_data->updatePhi(fmm_core_data, fmm_field_data,
+                                          grid_idx, num_dims, grid_dims, dx);
+
+  /* collect "KNOWN" neighbors */
+  for (dir = 0; dir < FMM_NDIM; dir++) { 
+    for (n = -1; n <= 1; n += 2) { 
+
+      for (l = 0; l < FMM_NDIM; l++) { 
+        neighbor[l] = grid_idx[l];
+      }
+      neighbor[dir] += n;
+
+      LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor,grid_dims);
+      if (!grid_idx_out_of_bounds) {
+        LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
+        if ( (KNOWN == (PointStatus) gridpoint_status[idx_neighbor])
+          && (source_label[idx_neighbor] >= 0) ) {
+          known_label[num_known] = source_label[idx_neighbor];
+          known_dir[num_known] = dir;
+          known_phi[num_known] = label_phi[idx_neighbor];
+          num_known++;
+        }
+      }
+    }
+  } /* loop over coordinate directions */
+
+  LSM_FMM_IDX(idx_cur_gridpoint, grid_idx, grid_dims);
+
+  /* compute arrival time for each label of the "KNOWN" neighbors */
+  for (l = 0; l < num_known; l++) {
+
+    /* upwind values of label_phi for current label */
+    LSMLIB_REAL phi_upwind[FMM_NDIM];
+
+    /* coefficients of quadratic equation for label_phi */
+    LSMLIB_REAL phi_A = 0;
+    LSMLIB_REAL phi_B = 0;
+    LSMLIB_REAL phi_C = 0;
+    LSMLIB_REAL phi_upwind_max = 0;
+    LSMLIB_REAL phi_one_sided = LSMLIB_REAL_MAX;
+    LSMLIB_REAL inv_speed = 1/speed[idx_cur_gridpoint];
+    LSMLIB_REAL discriminant;
+    LSMLIB_REAL label_phi_cur;
+
+    /* skip labels that have already been processed */
+    for (m = 0; m < l; m++) {
+      if (known_label[m] == known_label[l]) break;
+    }
+    if (m < l) continue;
+
+    for (dir = 0; dir < FMM_NDIM; dir++) {
+      phi_upwind[dir] = LSMLIB_REAL_MAX;
+    }
+    for (m = l; m < num_known; m++) {
+      if ( (known_label[m] == known_label[l])
+        && (known_phi[m] < phi_upwind[known_dir[m]]) ) {
+        phi_upwind[known_dir[m]] = known_phi[m];
+      }
+    }
+
+    /* accumulate coefficients for label_phi */
+    for (dir = 0; dir < FMM_NDIM; dir++) {
+      if (phi_upwind[dir] < LSMLIB_REAL_MAX) {
+        LSMLIB_REAL inv_dx_sq;
+        LSMLIB_REAL phi_cur = phi_upwind[dir] + dx[dir]*inv_speed;
+        inv_dx_sq = 1/dx[dir]; inv_dx_sq *= inv_dx_sq; 
+        phi_A += inv_dx_sq;
+        phi_B += inv_dx_sq*phi_upwind[dir];
+        phi_C += inv_dx_sq*phi_upwind[dir]*phi_upwind[dir];
+        if (phi_upwind[dir] > phi_upwind_max) {
+          phi_upwind_max = phi_upwind[dir];
+        }
+        if (phi_cur < phi_one_sided) phi_one_sided = phi_cur;
+      }
+    }
+    phi_B *= -2.0;
+    phi_C -= inv_speed*inv_speed;
+
+    /* use the one-sided update if the quadratic equation has no */
+    /* solution that is upwind of all of the neighbors           */
+    discriminant = phi_B*phi_B - 4.0*phi_A*phi_C;
+    label_phi_cur = phi_one_sided;
+    if (discriminant >= 0) {
+      LSMLIB_REAL phi_quadratic = 0.5*(-phi_B + sqrt(discriminant))/phi_A;
+      if ( (phi_quadratic >= phi_upwind_max) 
+        && (phi_quadratic < label_phi_cur) ) {
+        label_phi_cur = phi_quadratic;
+      }
+    }
+
+    if (label_phi_cur < label_phi_best) {
+      label_phi_best = label_phi_cur;
+      label_best = known_label[l];
+    }
+  }
+
+  /* set label at current grid point */
+  source_label[idx_cur_gridpoint] = label_best;
+  label_phi[idx_cur_gridpoint] = label_phi_best;
+
+  return phi_updated;
+}
+
+int FMM_EIKONAL_COMPUTE_PATH(
+  LSMLIB_REAL *path,
+  int max_num_path_points,
+  LSMLIB_REAL *start_point,
+  LSMLIB_REAL step_size,
+  LSMLIB_REAL *phi,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  LSMLIB_REAL x[FMM_NDIM];      /* current point (grid index coordinates) */
+  int num_path_points = 0;
+
+  /* auxiliary variables */
+  int dir;  /* loop variable for spatial directions */
+  int l, m; /* extra loop variables */ 
+
+  if (max_num_path_points <= 0) return 0;
+
+  /* set default step size */
+  if (step_size <= 0) {
+    step_size = dx[0];
+    for (dir = 1; dir < FMM_NDIM; dir++) {
+      if (dx[dir] < step_size) step_size = dx[dir];
+    }
+    step_size *= 0.5;
+  }
+
+  for (dir = 0; dir < FMM_NDIM; dir++) {
+    x[dir] = start_point[dir];
+    if (x[dir] < 0) x[dir] = 0;
+    if (x[dir] > grid_dims[dir]-1) x[dir] = grid_dims[dir]-1;
+  }
+
+  while (num_path_points < max_num_path_points) {
+
+    /* variables for gradient calculation */
+    LSMLIB_REAL grad_phi[FMM_NDIM];
+    LSMLIB_REAL grad_phi_corner[FMM_NDIM];
+    LSMLIB_REAL grad_phi_norm;
+    LSMLIB_REAL weight_sum = 0;
+    int base_idx[FMM_NDIM];
+    int nearest_idx[FMM_NDIM];
+    int corner_idx[FMM_NDIM];
+    int neighbor[FMM_NDIM];
+    int smallest_neighbor[FMM_NDIM];
+    LSMLIB_REAL phi_smallest_neighbor;
+    int idx_nearest, idx_neighbor;
+    int use_grid_step;
+    int corner;
+
+    /* add current point to path */
+    for (dir = 0; dir < FMM_NDIM; dir++) {
+      path[FMM_NDIM*num_path_points+dir] = x[dir];
+    }
+    num_path_points++;
+
+    /* stop at a local minimum of phi (i.e. a source) */
+    for (dir = 0; dir < FMM_NDIM; dir++) {
+      nearest_idx[dir] = (int) floor(x[dir] + 0.5);
+    }
+    LSM_FMM_IDX(idx_nearest, nearest_idx, grid_dims);
+    if ( (phi[idx_nearest] < 0) || (phi[idx_nearest] >= LSMLIB_REAL_MAX) ) {
+      break;
+    }
+    phi_smallest_neighbor = phi[idx_nearest];
+    for (dir = 0; dir < FMM_NDIM; dir++) {
+      smallest_neighbor[dir] = nearest_idx[dir];
+    }
+    for (dir = 0; dir < FMM_NDIM; dir++) {
+      for (l = -1; l <= 1; l += 2) {
+        int grid_idx_out_of_bounds;
+        for (m = 0; m < FMM_NDIM; m++) {
+          neighbor[m] = nearest_idx[m];
+        }
+        neighbor[dir] += l;
+        LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor,grid_dims);
+        if (grid_idx_out_of_bounds) continue;
+        LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
+        if ( (phi[idx_neighbor] >= 0) 
+          && (phi[idx_neighbor] < phi_smallest_neighbor) ) {
+          phi_smallest_neighbor = phi[idx_neighbor];
+          for (m = 0; m < FMM_NDIM; m++) {
+            smallest_neighbor[m] = neighbor[m];
+          }
+        }
+      }
+    }
+    if (phi_smallest_neighbor >= phi[idx_nearest]) {
+      if (num_path_points < max_num_path_points) {
+        for (dir = 0; dir < FMM_NDIM; dir++) {
+          path[FMM_NDIM*num_path_points+dir] = nearest_idx[dir];
+        }
+        num_path_points++;
+      }
+      break;
+    }
+
+    /* 
+     * compute gradient of phi by multilinear interpolation of the 
+     * gradients at the corners of the grid cell containing x 
+     * (corners where phi is not known are skipped)
+     */
+    for (dir = 0; dir < FMM_NDIM; dir++) {
+      base_idx[dir] = (int) floor(x[dir]);
+      if (base_idx[dir] > grid_dims[dir]-2) base_idx[dir] = grid_dims[dir]-2;
+      if (base_idx[dir] < 0) base_idx[dir] = 0;
+      grad_phi[dir] = 0;
+    }
+    for (corner = 0; corner < (1 << FMM_NDIM); corner++) {
+      LSMLIB_REAL weight = 1;
+      int corner_out_of_bounds;
+      for (dir = 0; dir < FMM_NDIM; dir++) {
+        LSMLIB_REAL frac = x[dir] - base_idx[dir];
+        if (corner & (1 << dir)) {
+          corner_idx[dir] = base_idx[dir] + 1;
+          weight *= frac;
+        } else {
+          corner_idx[dir] = base_idx[dir];
+          weight *= 1 - frac;
+        }
+      }
+      LSM_FMM_IDX_OUT_OF_BOUNDS(corner_out_of_bounds,corner_idx,grid_dims);
+      if ( (corner_out_of_bounds) || (weight <= 0) ) continue;
+      if (FMM_Eikonal_computeGradient(grad_phi_corner, phi, corner_idx,
+                                      grid_dims, dx)) {
+        for (dir = 0; dir < FMM_NDIM; dir++) {
+          grad_phi[dir] += weight*grad_phi_corner[dir];
+        }
+        weight_sum += weight;
+      }
+    }
+
+    grad_phi_norm = 0;
+    for (dir = 0; dir < FMM_NDIM; dir++) {
+      grad_phi_norm += grad_phi[dir]*grad_phi[dir];
+    }
+    grad_phi_norm = sqrt(grad_phi_norm);
+
+    /* take step in direction of steepest descent */
+    use_grid_step = ( (weight_sum <= 0) || (grad_phi_norm == 0) );
+    if (!use_grid_step) {
+      LSMLIB_REAL x_next[FMM_NDIM];
+      for (dir = 0; dir < FMM_NDIM; dir++) {
+        x_next[dir] = x[dir] - step_size*grad_phi[dir]/grad_phi_norm/dx[dir];
+        if (x_next[dir] < 0) x_next[dir] = 0;
+        if (x_next[dir] > grid_dims[dir]-1) x_next[dir] = grid_dims[dir]-1;
+        neighbor[dir] = (int) floor(x_next[dir] + 0.5);
+      }
+
+      /* do not step into grid cells where phi is not known */
+      /* (e.g. around corners of obstacles)                 */
+      LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
+      if ( (phi[idx_neighbor] < 0) || (phi[idx_neighbor] >= LSMLIB_REAL_MAX) ) {
+        use_grid_step = 1;
+      } else {
+        for (dir = 0; dir < FMM_NDIM; dir++) {
+          x[dir] = x_next[dir];
+        }
+      }
+    }
+
+    /* otherwise, move to the neighbor with the smallest value of phi */
+    if (use_grid_step) {
+      for (dir = 0; dir < FMM_NDIM; dir++) {
+        x[dir] = smallest_neighbor[dir];
+      }
+    }
+  }
+
+  return num_path_points;
+}
+
+static int FMM_Eikonal_computeGradient(
+  LSMLIB_REAL *grad_phi,
+  LSMLIB_REAL *phi,
+  int *grid_idx,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  int neighbor[FMM_NDIM];
+  LSMLIB_REAL phi_cur, phi_minus, phi_plus;
+  int idx_cur_gridpoint, idx_neighbor;
+  int grid_idx_out_of_bounds;
+  int dir, l;  /* loop variables */
+
+  LSM_FMM_IDX(idx_cur_gridpoint, grid_idx, grid_dims);
+  phi_cur = phi[idx_cur_gridpoint];
+  if ( (phi_cur < 0) || (phi_cur >= LSMLIB_REAL_MAX) ) return 0;
+
+  for (dir = 0; dir < FMM_NDIM; dir++) {
+
+    for (l = 0; l < FMM_NDIM; l++) { 
+      neighbor[l] = grid_idx[l];
+    }
+
+    /* phi is not known at grid points with negative values */
+    /* or values equal to LSMLIB_REAL_MAX                   */
+    phi_minus = -1;
+    neighbor[dir] = grid_idx[dir] - 1;
+    LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor,grid_dims);
+    if (!grid_idx_out_of_bounds) {
+      LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
+      phi_minus = phi[idx_neighbor];
+      if (phi_minus >= LSMLIB_REAL_MAX) phi_minus = -1;
+    }
+
+    phi_plus = -1;
+    neighbor[dir] = grid_idx[dir] + 1;
+    LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor,grid_dims);
+    if (!grid_idx_out_of_bounds) {
+      LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
+      phi_plus = phi[idx_neighbor];
+      if (phi_plus >= LSMLIB_REAL_MAX) phi_plus = -1;
+    }
+
+    if ( (phi_minus >= 0) && (phi_plus >= 0) ) {
+      grad_phi[dir] = 0.5*(phi_plus - phi_minus)/dx[dir];
+    } else if (phi_minus >= 0) {
+      grad_phi[dir] = (phi_cur - phi_minus)/dx[dir];
+    } else if (phi_plus >= 0) {
+      grad_phi[dir] = (phi_plus - phi_cur)/dx[dir];
+    } else {
+      grad_phi[dir] = 0;
+    }
+  }
+
+  return 1;
+}
+
 void FMM_EIKONAL_INITIALIZE_FRONT(
   FMM_CoreData *fmm_core_data,
   FMM_FieldData *fmm_field_data,
@@ -264,7 +1080,8 @@ void FMM_EIKONAL_INITIALIZE_FRONT(
   LSMLIB_REAL *dx)
 {
   /* Grid point status */
-  int *gridpoint_status = FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+  unsigned char *gridpoint_status = 
+    FMM_Core_getGridPointStatusDataArray(fmm_core_data);
 
   /* FMM Field Data variables */
   LSMLIB_REAL *phi   = fmm_field_data->phi;
@@ -321,7 +1138,8 @@ LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER1(
   int *grid_dims,
   LSMLIB_REAL *dx)
 {
-  int *gridpoint_status = FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+  unsigned char *gridpoint_status = 
+    FMM_Core_getGridPointStatusDataArray(fmm_core_data);
 
   /* FMM Field Data variables */
   LSMLIB_REAL *phi   = fmm_field_data->phi; 
@@ -464,7 +1282,8 @@ LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER2(
   int *grid_dims,
   LSMLIB_REAL *dx)
 {
-  int *gridpoint_status = FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+  unsigned char *gridpoint_status = 
+    FMM_Core_getGridPointStatusDataArray(fmm_core_data);
 
   /* FMM Field Data variables */
   LSMLIB_REAL *phi   = fmm_field_data->phi; 
@@ -649,4 +1468,173 @@ LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER2(
   return phi_updated;
 }
 
+
+LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER3(
+  FMM_CoreData *fmm_core_data,
+  FMM_FieldData *fmm_field_data,
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  unsigned char *gridpoint_status = 
+    FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+
+  /* FMM Field Data variables */
+  LSMLIB_REAL *phi   = fmm_field_data->phi; 
+  LSMLIB_REAL *speed = fmm_field_data->speed;
+
+  /* variables used in phi update */
+  PointStatus neighbor_status;
+  LSMLIB_REAL phi_upwind[3], phi_side[3];
+  int upwind_order;
+  LSMLIB_REAL upwind_coef, upwind_contrib;
+  LSMLIB_REAL inv_dx_sq; 
+  int neighbor[FMM_NDIM];
+
+  /* coefficients of quadratic equation for phi */
+  LSMLIB_REAL phi_A = 0;
+  LSMLIB_REAL phi_B = 0;
+  LSMLIB_REAL phi_C = 0;
+
+  /* coefficients of quadratic equation for first-order update (used */
+  /* when the higher-order quadratic equation has no real roots)     */
+  LSMLIB_REAL phi_A1 = 0;
+  LSMLIB_REAL phi_B1 = 0;
+  LSMLIB_REAL phi_C1 = 0;
+  LSMLIB_REAL discriminant;
+  LSMLIB_REAL phi_updated;
+
+  /* auxilliary variables */
+  int dir;  /* loop variable for spatial directions */
+  int side; /* loop variable for minus/plus neighbors */
+  int s;    /* loop variable for neighbors along upwind direction */
+  int l;    /* extra loop variable */ 
+  int num_upwind;
+  int idx_cur_gridpoint, idx_neighbor;
+  int grid_idx_out_of_bounds;
+
+  /* unused function parameters */
+  (void) num_dims;
+
+  /* compute index for current grid point */
+  LSM_FMM_IDX(idx_cur_gridpoint, grid_idx, grid_dims);
+
+  /* calculate update to phi */
+  for (dir = 0; dir < FMM_NDIM; dir++) { 
+
+    /* reset upwind_order to 0 (i.e. no KNOWN neighbors) */
+    upwind_order = 0;
+
+    for (side = -1; side <= 1; side += 2) { /* loop over minus/plus sides */
+
+      /* collect KNOWN neighbors along current side with non-increasing */
+      /* abs(phi) values (up to three for third-order accuracy)         */
+      num_upwind = 0;
+      for (s = 1; s <= 3; s++) {
+        for (l = 0; l < FMM_NDIM; l++) neighbor[l] = grid_idx[l];
+        neighbor[dir] += s*side;
+        LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor,grid_dims);
+        if (grid_idx_out_of_bounds) break;
+        LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
+        neighbor_status = (PointStatus) gridpoint_status[idx_neighbor];
+        if (KNOWN != neighbor_status) break;
+        if ( (s > 1) && 
+             (LSM_FMM_ABS(phi[idx_neighbor]) > LSM_FMM_ABS(phi_side[s-2])) ) 
+          break;
+        phi_side[s-1] = phi[idx_neighbor];
+        num_upwind++;
+      }
+
+      /* 
+       * choosing the upwind direction to be the direction
+       * with the smaller abs(phi) value gives a consistent 
+       * solution to the "upwind" Eikonal equation.
+       */
+      if ( (num_upwind > 0) && 
+           ( (upwind_order == 0) ||
+             (LSM_FMM_ABS(phi_side[0]) < LSM_FMM_ABS(phi_upwind[0])) ) ) {
+        upwind_order = num_upwind;
+        for (s = 0; s < num_upwind; s++) phi_upwind[s] = phi_side[s];
+      }
+
+    } /* end loop over minus/plus sides */
+
+    /*
+     * accumulate coefficients for phi if any of the neighbors are "KNOWN"
+     */
+    if (upwind_order > 0) {
+
+      /* set upwind_coef and upwind_contrib based on the number of */
+      /* KNOWN neighbors available in the upwind direction so that */
+      /* D phi = (upwind_coef*phi - upwind_contrib)/dx             */
+      if (upwind_order == 3) {
+        upwind_coef = 11.0/6.0;
+        upwind_contrib = 3.0*phi_upwind[0] - 1.5*phi_upwind[1]
+                       + phi_upwind[2]/3.0;
+      } else if (upwind_order == 2) {
+        upwind_coef = 1.5;
+        upwind_contrib = 2.0*phi_upwind[0] - 0.5*phi_upwind[1];
+      } else {
+        upwind_coef = 1.0;
+        upwind_contrib = phi_upwind[0];
+      }
+
+      /* accumulate coefs for phi */ 
+      inv_dx_sq = 1/dx[dir]; inv_dx_sq *= inv_dx_sq; 
+      phi_A += inv_dx_sq*upwind_coef*upwind_coef;
+      phi_B += inv_dx_sq*upwind_coef*upwind_contrib;
+      phi_C += inv_dx_sq*upwind_contrib*upwind_contrib;
+      phi_A1 += inv_dx_sq;
+      phi_B1 += inv_dx_sq*phi_upwind[0];
+      phi_C1 += inv_dx_sq*phi_upwind[0]*phi_upwind[0];
+    }
+
+  } /* loop over coordinate directions */
+
+  /* check that phi_A is nonzero */
+  if (LSM_FMM_ABS(phi_A) == 0) {
+    fprintf(stderr,"ERROR: phi update - no KNOWN neighbors!!!\n");
+    fprintf(stderr,"       phi set to 'infinity'.\n");
+    return LSMLIB_REAL_MAX;
+  }
+
+  /* complete computation of phi_B and phi_C */
+  phi_B *= -2.0;
+  phi_C -= 1/speed[idx_cur_gridpoint]/speed[idx_cur_gridpoint];
+  phi_B1 *= -2.0;
+  phi_C1 -= 1/speed[idx_cur_gridpoint]/speed[idx_cur_gridpoint];
+
+  /* compute phi by solving quadratic equation */
+  discriminant = phi_B*phi_B - 4.0*phi_A*phi_C;
+  if (discriminant < 0) {
+
+    /* the higher-order discretization is inconsistent with the */
+    /* KNOWN neighbors (e.g., close to the initial front or to  */
+    /* kinks in the solution), so drop to first-order accuracy  */
+    phi_A = phi_A1;
+    phi_B = phi_B1;
+    phi_C = phi_C1;
+    discriminant = phi_B*phi_B - 4.0*phi_A*phi_C;
+
+  }
+  phi_updated = LSMLIB_REAL_MAX;
+  if (discriminant >= 0) {
+
+    phi_updated = 0.5*(-phi_B + sqrt(discriminant))/phi_A;
+
+  } else {
+
+    /* discriminant is negative ... keep the previously computed */
+    /* value of phi (see FMM_EIKONAL_UPDATE_GRID_POINT_ORDER2()). */
+    phi_updated = phi[idx_cur_gridpoint]; 
+
+  }
+
+  /* set phi at current grid point */
+  phi[idx_cur_gridpoint] = phi_updated;
+
+  return phi_updated;
+}
+
 #endif
@@ -21,11 +21,20 @@
 /* Define required macros */
 #define FMM_NDIM                               2 
 #define FMM_EIKONAL_SOLVE_EIKONAL_EQUATION     solveEikonalEquation2d
+#define FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_WORKSPACE                 \
+        solveEikonalEquation2dWithWorkspace
+#define FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_BATCH                          \
+        solveEikonalEquation2dBatch
+#define FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_TO_TARGETS                     \
+        solveEikonalEquation2dToTargets
+#define FMM_EIKONAL_COMPUTE_PATH               computeEikonalPath2d
 #define FMM_EIKONAL_INITIALIZE_FRONT           FMM_initializeFront_Eikonal2d
 #define FMM_EIKONAL_UPDATE_GRID_POINT_ORDER1                              \
         FMM_updateGridPoint_Eikonal2d_Order1
 #define FMM_EIKONAL_UPDATE_GRID_POINT_ORDER2                              \
         FMM_updateGridPoint_Eikonal2d_Order2
+#define FMM_EIKONAL_UPDATE_GRID_POINT_ORDER3                              \
+        FMM_updateGridPoint_Eikonal2d_Order3
 
 
 /* Include "templated" implementation of Eikonal equation solver. */
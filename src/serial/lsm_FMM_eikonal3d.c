@@ -21,11 +21,20 @@
 /* Define required macros */
 #define FMM_NDIM                               3 
 #define FMM_EIKONAL_SOLVE_EIKONAL_EQUATION     solveEikonalEquation3d
+#define FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_WITH_WORKSPACE                 \
+        solveEikonalEquation3dWithWorkspace
+#define FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_BATCH                          \
+        solveEikonalEquation3dBatch
+#define FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_TO_TARGETS                     \
+        solveEikonalEquation3dToTargets
+#define FMM_EIKONAL_COMPUTE_PATH               computeEikonalPath3d
 #define FMM_EIKONAL_INITIALIZE_FRONT           FMM_initializeFront_Eikonal3d
 #define FMM_EIKONAL_UPDATE_GRID_POINT_ORDER1                              \
         FMM_updateGridPoint_Eikonal3d_Order1
 #define FMM_EIKONAL_UPDATE_GRID_POINT_ORDER2                              \
         FMM_updateGridPoint_Eikonal3d_Order2
+#define FMM_EIKONAL_UPDATE_GRID_POINT_ORDER3                              \
+        FMM_updateGridPoint_Eikonal3d_Order3
 
 
 /* Include "templated" implementation of Eikonal equation solver. */
@@ -0,0 +1,131 @@
+/*
+ * File:        lsm_FMM_eikonal_batch.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation of data structure shared by batches of
+ *              Fast Marching Method calculations for the Eikonal equation
+ */
+
+/*
+ * lsm_FMM_eikonal_batch.c provides the functions for creating and
+ * destroying an EikonalBatchSolver.  The batch solvers themselves
+ * (solveEikonalEquation2dBatch() and solveEikonalEquation3dBatch())
+ * are provided by the generic implementation of the Eikonal equation
+ * solver in lsm_FMM_eikonal.c.
+ */
+
+#include <stdlib.h>
+#include "LSMLIB_config.h"
+#include "lsm_fast_marching_method.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+EikonalBatchSolver* createEikonalBatchSolver(
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  int num_threads)
+{
+  EikonalBatchSolver *solver;
+  int num_gridpoints;
+  int i, idx;
+
+  /* check arguments */
+  if ( (!speed) || (!grid_dims) || (!dx)
+    || (num_dims < 2) || (num_dims > 3) ) {
+    return 0;
+  }
+  num_gridpoints = 1;
+  for (i = 0; i < num_dims; i++) {
+    if (grid_dims[i] <= 0) return 0;
+    num_gridpoints *= grid_dims[i];
+  }
+
+  /* set default number of threads */
+  if (num_threads <= 0) {
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#else
+    num_threads = 1;
+#endif
+  }
+
+  /* allocate memory for EikonalBatchSolver */
+  solver = (EikonalBatchSolver*) calloc(1, sizeof(EikonalBatchSolver));
+  if (!solver) return 0;
+
+  /* set grid and speed function */
+  solver->num_dims = num_dims;
+  for (i = 0; i < 3; i++) {
+    solver->grid_dims[i] = (i < num_dims) ? grid_dims[i] : 1;
+    solver->dx[i] = (i < num_dims) ? dx[i] : 1.0;
+  }
+  solver->speed = speed;
+  solver->spatial_discretization_order = spatial_discretization_order;
+
+  /* collect grid points outside of the domain of the problem */
+  for (idx = 0; idx < num_gridpoints; idx++) {
+    if ( ((mask) && (mask[idx] < 0)) || (speed[idx] < LSMLIB_ZERO_TOL) ) {
+      solver->num_outside_pts++;
+    }
+  }
+  if (solver->num_outside_pts > 0) {
+    solver->outside_pts = (int*) malloc(solver->num_outside_pts*sizeof(int));
+    if (!solver->outside_pts) {
+      destroyEikonalBatchSolver(solver);
+      return 0;
+    }
+    i = 0;
+    for (idx = 0; idx < num_gridpoints; idx++) {
+      if ( ((mask) && (mask[idx] < 0)) || (speed[idx] < LSMLIB_ZERO_TOL) ) {
+        solver->outside_pts[i++] = idx;
+      }
+    }
+  }
+
+  /* create FMM_Workspace for each thread */
+  solver->workspaces =
+    (FMM_Workspace**) calloc(num_threads, sizeof(FMM_Workspace*));
+  if (!solver->workspaces) {
+    destroyEikonalBatchSolver(solver);
+    return 0;
+  }
+  solver->num_workspaces = num_threads;
+  for (i = 0; i < num_threads; i++) {
+    solver->workspaces[i] = FMM_Core_createFMM_Workspace(num_dims, grid_dims);
+    if (!solver->workspaces[i]) {
+      destroyEikonalBatchSolver(solver);
+      return 0;
+    }
+  }
+
+  return solver;
+}
+
+
+void destroyEikonalBatchSolver(EikonalBatchSolver *solver)
+{
+  int i;
+
+  if (!solver) return;
+
+  if (solver->workspaces) {
+    for (i = 0; i < solver->num_workspaces; i++) {
+      if (solver->workspaces[i]) {
+        FMM_Core_destroyFMM_Workspace(solver->workspaces[i]);
+      }
+    }
+    free(solver->workspaces);
+  }
+  if (solver->outside_pts) free(solver->outside_pts);
+  free(solver);
+}
@@ -13,8 +13,9 @@
  *
  * \brief
  * @ref lsm_FMM_field_extension.c provides "generic" implementations 
- *      first- and second-order accurate Fast Marching Method schemes 
- *      for computing signed distance functions and extension fields.  
+ *      first-, second- and third-order accurate Fast Marching Method 
+ *      schemes for computing signed distance functions and extension 
+ *      fields.  
  *      The code is "templated" on  the number of dimensions through the 
  *      use of macro definitions that MUST be provided by the user.  
  *
@@ -29,6 +30,10 @@
  *    -# FMM_COMPUTE_EXTENSION_FIELDS:  desired name of function
  *       that computes the extensions of fields off of the zero 
  *       level set 
+ *    -# FMM_COMPUTE_DISTANCE_FUNCTION_WITH_WORKSPACE and
+ *       FMM_COMPUTE_EXTENSION_FIELDS_WITH_WORKSPACE:  desired names 
+ *       of the versions of the above functions that use a 
+ *       user-provided FMM_Workspace
  *    -# FMM_INITIALIZE_FRONT_ORDER1:  desired name of function that
  *       initializes the values on the front using a first-order scheme
  *    -# FMM_INITIALIZE_FRONT_ORDER2:  desired name of function that
@@ -39,18 +44,36 @@
  *    -# FMM_UPDATE_GRID_POINT_ORDER2:  desired name of function
  *       that updates the value of the solution at grid points using
  *       a second-order accurate discretization
+ *    -# FMM_UPDATE_GRID_POINT_ORDER3:  desired name of function
+ *       that updates the value of the solution at grid points using
+ *       a third-order accurate discretization
+ *    -# FMM_COMPUTE_SUBCELL_DISTANCE:  name of function with signature
+ *       (distance0, phi, grid_idx, grid_dims, dx) that sets distance0 
+ *       at grid_idx using LSM*D_COMPUTE_DISTANCE_FOR_SUBCELL_FIX_CUBIC()
+ *       (with the entire grid as the ghostbox) and returns 1 if the 
+ *       Newton projection succeeded and 0 otherwise
  * -# Include this file at the end of the implementation file
  *    for the n-dimentsional Eikonal equation solver.
  * -# Compile code.
  *
  *
  * <h3> NOTES: </h3>
- * - This implementation currently does NOT support second-order
- *   initialization grid points adjacent to the zero level set.
- *   As a consequence, the computed signed distance function and
- *   extension fields are only first-order accurate in the L-infinity
- *   norm.  All results should, however, be second-order accurate in 
- *   the L2 norm.
+ * - The second-order scheme uses first-order initialization of grid 
+ *   points adjacent to the zero level set.  As a consequence, the 
+ *   computed signed distance function and extension fields are only 
+ *   first-order accurate in the L-infinity norm.  All results should,
+ *   however, be second-order accurate in the L2 norm.
+ *
+ * - The third-order scheme initializes grid points adjacent to the
+ *   zero level set using FMM_INITIALIZE_FRONT_ORDER2(), which projects
+ *   each grid point onto the zero level set of the local bicubic 
+ *   (tricubic) interpolant of phi.  This is the same computation used
+ *   for the subcell fix in PDE-based reinitialization.  The resulting signed distance function is 
+ *   second-order accurate in the L-infinity norm (and close to 
+ *   third-order accurate in the L2 norm when phi is smooth), so a 
+ *   single third-order FMM computation can often replace additional
+ *   iterations of PDE-based reinitialization.  Extension fields are 
+ *   only first-order accurate.
  * 
  * - Because this code depends on macros, care must be taken to
  *   ensure that macros do not conflict.
@@ -83,6 +106,12 @@
 #ifndef FMM_COMPUTE_EXTENSION_FIELDS
 #error "lsm_FMM_field_extension: required macro FMM_COMPUTE_EXTENSION_FIELDS not defined!"
 #endif
+#ifndef FMM_COMPUTE_DISTANCE_FUNCTION_WITH_WORKSPACE
+#error "lsm_FMM_field_extension: required macro FMM_COMPUTE_DISTANCE_FUNCTION_WITH_WORKSPACE not defined!"
+#endif
+#ifndef FMM_COMPUTE_EXTENSION_FIELDS_WITH_WORKSPACE
+#error "lsm_FMM_field_extension: required macro FMM_COMPUTE_EXTENSION_FIELDS_WITH_WORKSPACE not defined!"
+#endif
 #ifndef FMM_INITIALIZE_FRONT_ORDER1
 #error "lsm_FMM_field_extension: required macro FMM_INITIALIZE_FRONT_ORDER1 not defined!"
 #endif
@@ -95,6 +124,22 @@
 #ifndef FMM_UPDATE_GRID_POINT_ORDER2
 #error "lsm_FMM_field_extension: required macro FMM_UPDATE_GRID_POINT_ORDER2 not defined!"
 #endif
+#ifndef FMM_UPDATE_GRID_POINT_ORDER3
+#error "lsm_FMM_field_extension: required macro FMM_UPDATE_GRID_POINT_ORDER3 not defined!"
+#endif
+#ifndef FMM_COMPUTE_SUBCELL_DISTANCE
+#error "lsm_FMM_field_extension: required macro FMM_COMPUTE_SUBCELL_DISTANCE not defined!"
+#endif
+
+
+/*============================= Constants ===========================*/
+
+/*
+ * FMM_FIELD_EXTENSION_MAX_NEWTON_ITERATIONS is the maximum number of
+ * iterations used to locate the zero level set along a grid line
+ * during second-order front initialization.
+ */
+#define FMM_FIELD_EXTENSION_MAX_NEWTON_ITERATIONS    (20)
 
 
 /*=============== lsm_FMM_field_extension Data Structures =============*/
@@ -143,9 +188,15 @@ void FMM_INITIALIZE_FRONT_ORDER1(
  * required by FMM_Core::FMM_initializeFront() to find and initialize 
  * the front.  
  *
- * The approximation to the distance function is computed using
- * a first-order scheme.  The values of the extension fields on 
- * the zero level set are computed using quadratic interpolation.  
+ * The approximation to the distance function is computed by 
+ * projecting the grid point onto the zero level set of the local
+ * bicubic (tricubic) interpolant of phi.  Near grid points outside 
+ * of the domain, a local quadratic model of phi is used instead, and
+ * near the boundary of the computational domain, the first-order 
+ * scheme is used.  The location of the zero 
+ * level set along each grid line is computed using a cubic interpolant
+ * of phi, and the values of the extension fields on the zero level set
+ * are computed using quadratic interpolation.  
  * The extension fields for points adjacent to the zero level set
  * are calculated using a first-order approximation to the 
  * grad(F)*grad(dist) = 0 equation.
@@ -199,6 +250,76 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
   int *grid_dims,
   LSMLIB_REAL *dx);
 
+/* 
+ * FMM_UPDATE_GRID_POINT_ORDER3() implements the callback function 
+ * required by FMM_Core::FMM_Core_updateNeighbors() to update the
+ * distance function and extension fields at a grid point.  It 
+ * computes and returns the updated distance function and extension
+ * field values of the specified grid point using values of neighbors
+ * that have status "KNOWN".
+ *
+ * The approximation to the distance function is computed using a 
+ * third-order one-sided finite-difference scheme along each coordinate
+ * direction, which drops to second- or first-order when there are not
+ * enough KNOWN neighbors in the upwind direction.  The extension 
+ * fields are calculated in the same manner as in 
+ * FMM_UPDATE_GRID_POINT_ORDER2().
+ */
+LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER3(
+  FMM_CoreData *fmm_core_data,
+  FMM_FieldData *fmm_field_data,
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+
+/*================== Helper Functions Declarations ==================*/
+
+/*
+ * FMM_FieldExtension_locateZeroCrossing() returns the location s in
+ * [0,1] of the zero of the polynomial interpolant of phi along a grid
+ * line, where phi_cur and phi_nb (the values at s = 0 and s = 1) have
+ * opposite signs.  phi_back (s = -1) and phi_nb2 (s = 2) are used 
+ * only if the corresponding flags are set.
+ */
+static LSMLIB_REAL FMM_FieldExtension_locateZeroCrossing(
+  LSMLIB_REAL phi_back,
+  LSMLIB_REAL phi_cur,
+  LSMLIB_REAL phi_nb,
+  LSMLIB_REAL phi_nb2,
+  int use_back,
+  int use_nb2);
+
+/*
+ * FMM_FieldExtension_projectOntoZeroLevelSet() computes the signed
+ * distance from the specified grid point to the zero level set of 
+ * the local quadratic model of phi (using central difference 
+ * approximations of the gradient and Hessian) along the direction of
+ * grad(phi).  Returns LSM_FMM_TRUE on success and LSM_FMM_FALSE if 
+ * the stencil is not available (e.g., near the boundary of the 
+ * computational domain) or grad(phi) vanishes.
+ */
+static int FMM_FieldExtension_projectOntoZeroLevelSet(
+  LSMLIB_REAL *dist,
+  LSMLIB_REAL *phi,
+  unsigned char *gridpoint_status,
+  int *grid_idx,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*
+ * FMM_FieldExtension_stencilInsideDomain() returns LSM_FMM_TRUE if 
+ * none of the grid points within the specified (max-norm) distance
+ * of grid_idx are marked as OUTSIDE_DOMAIN.  Grid points beyond the
+ * boundary of the computational domain are ignored.
+ */
+static int FMM_FieldExtension_stencilInsideDomain(
+  unsigned char *gridpoint_status,
+  int *grid_idx,
+  int *grid_dims,
+  int width);
+
 
 /*==================== Function Definitions =========================*/
 
@@ -214,9 +335,38 @@ int FMM_COMPUTE_EXTENSION_FIELDS(
   int spatial_discretization_order,
   int *grid_dims,
   LSMLIB_REAL *dx)
+{
+  return FMM_COMPUTE_EXTENSION_FIELDS_WITH_WORKSPACE(
+           distance_function,
+           extension_fields,
+           phi,
+           mask,
+           source_fields,
+           extension_mask,
+           num_extension_fields,
+           spatial_discretization_order,
+           grid_dims,
+           dx,
+           0); /* NULL workspace pointer */
+}
+
+int FMM_COMPUTE_EXTENSION_FIELDS_WITH_WORKSPACE(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  int num_extension_fields,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  FMM_Workspace *workspace)
 {
   /* fast marching method data */
   FMM_CoreData *fmm_core_data;
+  FMM_FieldData fmm_field_data;
+  LSMLIB_REAL *scratch_data;
 
   /* pointers to callback functions */
   updateGridPointFuncPtr updateGridPoint;
@@ -246,49 +396,28 @@ int FMM_COMPUTE_EXTENSION_FIELDS(
     initializeFront = &FMM_INITIALIZE_FRONT_ORDER1; 
     updateGridPoint = &FMM_UPDATE_GRID_POINT_ORDER2;
 
+  } else if (spatial_discretization_order == 3) {
+
+    initializeFront = &FMM_INITIALIZE_FRONT_ORDER2; 
+    updateGridPoint = &FMM_UPDATE_GRID_POINT_ORDER3;
+
   } else {
     fprintf(stderr,
-           "ERROR: Invalid spatial derivative order.  Only first-\n");
+           "ERROR: Invalid spatial derivative order.  Only first-,\n");
     fprintf(stderr,
-           "       and second-order finite differences supported.\n");
+           "       second- and third-order finite differences supported.\n");
     return LSM_FMM_ERR_INVALID_SPATIAL_DISCRETIZATION_ORDER;
   }
 
   /********************************************
    * set up FMM Field Data
    ********************************************/
-  FMM_FieldData *fmm_field_data = 
-    (FMM_FieldData*) malloc(sizeof(FMM_FieldData));
-  if (!fmm_field_data) return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
-  fmm_field_data->phi = phi;
-  fmm_field_data->distance_function = distance_function;
-  fmm_field_data->num_extension_fields = num_extension_fields;
-  fmm_field_data->source_fields = source_fields;
-  fmm_field_data->extension_fields = extension_fields;
-  fmm_field_data->extension_mask = extension_mask;
-
-  /* allocate memory for extension field calculations */
-  if (num_extension_fields > 0) {
-    fmm_field_data->extension_fields_cur = 
-      (LSMLIB_REAL*) malloc(num_extension_fields*sizeof(LSMLIB_REAL));
-    fmm_field_data->extension_fields_sum_div_dist_sq = 
-      (LSMLIB_REAL*) malloc(num_extension_fields*sizeof(LSMLIB_REAL));
-    fmm_field_data->extension_fields_minus = 
-      (LSMLIB_REAL*) malloc(num_extension_fields*sizeof(LSMLIB_REAL));
-    fmm_field_data->extension_fields_plus = 
-      (LSMLIB_REAL*) malloc(num_extension_fields*sizeof(LSMLIB_REAL));
-    fmm_field_data->extension_fields_numerator = 
-      (LSMLIB_REAL*) malloc(num_extension_fields*sizeof(LSMLIB_REAL));
-    fmm_field_data->extension_fields_denominator = 
-      (LSMLIB_REAL*) malloc(num_extension_fields*sizeof(LSMLIB_REAL));
-  } else {
-    fmm_field_data->extension_fields_cur = 0;
-    fmm_field_data->extension_fields_sum_div_dist_sq = 0;
-    fmm_field_data->extension_fields_minus = 0;
-    fmm_field_data->extension_fields_plus = 0;
-    fmm_field_data->extension_fields_numerator = 0;
-    fmm_field_data->extension_fields_denominator = 0;
-  }
+  fmm_field_data.phi = phi;
+  fmm_field_data.distance_function = distance_function;
+  fmm_field_data.num_extension_fields = num_extension_fields;
+  fmm_field_data.source_fields = source_fields;
+  fmm_field_data.extension_fields = extension_fields;
+  fmm_field_data.extension_mask = extension_mask;
 
   /********************************************
    * initialize phi and extension fields
@@ -310,15 +439,45 @@ int FMM_COMPUTE_EXTENSION_FIELDS(
   /********************************************
    * initialize FMM Core Data
    ********************************************/
-  fmm_core_data = FMM_Core_createFMM_CoreData(
-    fmm_field_data,
+  fmm_core_data = FMM_Core_createFMM_CoreDataWithWorkspace(
+    &fmm_field_data,
     FMM_NDIM,
     grid_dims,
     dx,
     initializeFront,
-    updateGridPoint);
+    updateGridPoint,
+    workspace);
   if (!fmm_core_data) return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
 
+  /* set up memory for extension field calculations */
+  /* (owned by the FMM_Workspace)                   */
+  if (num_extension_fields > 0) {
+    scratch_data = FMM_Core_getScratchData(fmm_core_data,
+                                           6*num_extension_fields);
+    if (!scratch_data) {
+      FMM_Core_destroyFMM_CoreData(fmm_core_data);
+      return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+    }
+    fmm_field_data.extension_fields_cur = scratch_data;
+    fmm_field_data.extension_fields_sum_div_dist_sq = 
+      scratch_data + num_extension_fields;
+    fmm_field_data.extension_fields_minus = 
+      scratch_data + 2*num_extension_fields;
+    fmm_field_data.extension_fields_plus = 
+      scratch_data + 3*num_extension_fields;
+    fmm_field_data.extension_fields_numerator = 
+      scratch_data + 4*num_extension_fields;
+    fmm_field_data.extension_fields_denominator = 
+      scratch_data + 5*num_extension_fields;
+  } else {
+    fmm_field_data.extension_fields_cur = 0;
+    fmm_field_data.extension_fields_sum_div_dist_sq = 0;
+    fmm_field_data.extension_fields_minus = 0;
+    fmm_field_data.extension_fields_plus = 0;
+    fmm_field_data.extension_fields_numerator = 0;
+    fmm_field_data.extension_fields_denominator = 0;
+  }
+
   /* mark grid points outside of domain */
   for (idx = 0; idx < num_gridpoints; idx++) {
 
@@ -355,15 +514,6 @@ int FMM_COMPUTE_EXTENSION_FIELDS(
 
   /* clean up memory */
   FMM_Core_destroyFMM_CoreData(fmm_core_data);
-  if (num_extension_fields > 0) {
-    free(fmm_field_data->extension_fields_cur);
-    free(fmm_field_data->extension_fields_sum_div_dist_sq);
-    free(fmm_field_data->extension_fields_minus);
-    free(fmm_field_data->extension_fields_plus);
-    free(fmm_field_data->extension_fields_numerator);
-    free(fmm_field_data->extension_fields_denominator);
-  }
-  free(fmm_field_data);
 
   return LSM_FMM_ERR_SUCCESS;
 }
@@ -381,7 +531,35 @@ int FMM_COMPUTE_DISTANCE_FUNCTION(
   int *grid_dims,
   LSMLIB_REAL *dx)
 {
-  return FMM_COMPUTE_EXTENSION_FIELDS(
+  return FMM_COMPUTE_EXTENSION_FIELDS_WITH_WORKSPACE(
+           distance_function,
+           0, /*  NULL extension fields pointer */
+           phi,
+           mask,
+           0, /*  NULL source fields pointer */
+	   0, /*  NULL extension_mask pointer */
+           0, /*  zero extension fields to compute */
+           spatial_discretization_order,
+           grid_dims,
+           dx,
+           0); /* NULL workspace pointer */
+}
+
+/* 
+ * FMM_COMPUTE_DISTANCE_FUNCTION_WITH_WORKSPACE() just calls 
+ * FMM_COMPUTE_EXTENSION_FIELDS_WITH_WORKSPACE() with no source/extension 
+ * fields (i.e. NULL source/extension field pointers).
+ */
+int FMM_COMPUTE_DISTANCE_FUNCTION_WITH_WORKSPACE(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  FMM_Workspace *workspace)
+{
+  return FMM_COMPUTE_EXTENSION_FIELDS_WITH_WORKSPACE(
            distance_function,
            0, /*  NULL extension fields pointer */
            phi,
@@ -391,7 +569,8 @@ int FMM_COMPUTE_DISTANCE_FUNCTION(
            0, /*  zero extension fields to compute */
            spatial_discretization_order,
            grid_dims,
-           dx);
+           dx,
+           workspace);
 }
 
 void FMM_INITIALIZE_FRONT_ORDER1(
@@ -401,7 +580,8 @@ void FMM_INITIALIZE_FRONT_ORDER1(
   int *grid_dims,
   LSMLIB_REAL *dx)
 {
-  int *gridpoint_status = FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+  unsigned char *gridpoint_status = 
+    FMM_Core_getGridPointStatusDataArray(fmm_core_data);
 
   /* FMM Field Data variables */
   LSMLIB_REAL *phi = fmm_field_data->phi;
@@ -675,7 +855,8 @@ void FMM_INITIALIZE_FRONT_ORDER2(
   int *grid_dims,
   LSMLIB_REAL *dx)
 {
-  int *gridpoint_status = FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+  unsigned char *gridpoint_status = 
+    FMM_Core_getGridPointStatusDataArray(fmm_core_data);
 
   /* FMM Field Data variables */
   LSMLIB_REAL *phi = fmm_field_data->phi;
@@ -686,6 +867,7 @@ void FMM_INITIALIZE_FRONT_ORDER2(
    
   /* grid variables */
   int neighbor_plus[FMM_NDIM], neighbor_minus[FMM_NDIM];
+  int neighbor_plus2[FMM_NDIM], neighbor_minus2[FMM_NDIM];
   int on_interface = LSM_FMM_FALSE;
   int borders_interface = LSM_FMM_FALSE;
 
@@ -693,9 +875,16 @@ void FMM_INITIALIZE_FRONT_ORDER2(
   LSMLIB_REAL phi_cur;
   LSMLIB_REAL phi_minus;
   LSMLIB_REAL phi_plus;
+  LSMLIB_REAL phi_minus2;
+  LSMLIB_REAL phi_plus2;
+  int have_minus, have_plus, have_minus2, have_plus2;
   LSMLIB_REAL dist_minus;
   LSMLIB_REAL dist_plus;
   LSMLIB_REAL dist_dir;
+  LSMLIB_REAL dist_min;
+  LSMLIB_REAL dist_proj;
+  LSMLIB_REAL max_dx;
+  LSMLIB_REAL large_distance_flag;
   int use_plus; 
 
   LSMLIB_REAL sum_dist_inv_sq; 
@@ -712,6 +901,7 @@ void FMM_INITIALIZE_FRONT_ORDER2(
   int num_gridpoints;       /* number of grid points */ 
   int i,idx;  /* loop variables for grid */
   int idx_neighbor_plus, idx_neighbor_minus;
+  int idx_neighbor_plus2, idx_neighbor_minus2;
   int m;    /* loop variable for extension fields */
   int l;    /* extra loop variable */
   int dir;  /* loop variable over spatial dimensions */
@@ -732,6 +922,14 @@ void FMM_INITIALIZE_FRONT_ORDER2(
     num_gridpoints *= grid_dims[i];
   }
 
+  /* flag value used by FMM_COMPUTE_SUBCELL_DISTANCE() for grid points */
+  /* that are not adjacent to the interface                            */
+  max_dx = dx[0];
+  for (i = 1; i < FMM_NDIM; i++) {
+    if (dx[i] > max_dx) max_dx = dx[i];
+  }
+  large_distance_flag = -1000.0*max_dx;
+
   for (idx = 0; idx < num_gridpoints; idx++) {
 
     /* temporary variables */
@@ -763,6 +961,7 @@ void FMM_INITIALIZE_FRONT_ORDER2(
 
     /* zero out accumulation variables */
     sum_dist_inv_sq = 0; 
+    dist_min = LSMLIB_REAL_MAX;
     for (m = 0; m < num_extension_fields; m++) {
       extension_fields_sum_div_dist_sq[m] = 0;
     }
@@ -792,20 +991,48 @@ void FMM_INITIALIZE_FRONT_ORDER2(
       for (l = 0; l < FMM_NDIM; l++) {
         neighbor_plus[l] = grid_idx[l];
         neighbor_minus[l] = grid_idx[l];
+        neighbor_plus2[l] = grid_idx[l];
+        neighbor_minus2[l] = grid_idx[l];
       }
       neighbor_plus[dir]++; neighbor_minus[dir]--;
+      neighbor_plus2[dir] += 2; neighbor_minus2[dir] -= 2;
       LSM_FMM_IDX(idx_neighbor_plus, neighbor_plus, grid_dims);
       LSM_FMM_IDX(idx_neighbor_minus, neighbor_minus, grid_dims);
+      LSM_FMM_IDX(idx_neighbor_plus2, neighbor_plus2, grid_dims);
+      LSM_FMM_IDX(idx_neighbor_minus2, neighbor_minus2, grid_dims);
 
-      /* calculate distance to interface in minus direction */
+      /* gather the phi values along the current grid line that are */
+      /* available for locating the zero level set                  */
       LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,
                                 neighbor_minus,grid_dims);
-      if (!grid_idx_out_of_bounds) {
-        phi_minus = phi[idx_neighbor_minus];
+      have_minus = !grid_idx_out_of_bounds;
+      phi_minus = have_minus ? phi[idx_neighbor_minus] : 0;
+      LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,
+                                neighbor_plus,grid_dims);
+      have_plus = !grid_idx_out_of_bounds;
+      phi_plus = have_plus ? phi[idx_neighbor_plus] : 0;
+      LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,
+                                neighbor_minus2,grid_dims);
+      have_minus2 = (!grid_idx_out_of_bounds) && 
+        (OUTSIDE_DOMAIN != gridpoint_status[idx_neighbor_minus2]);
+      phi_minus2 = have_minus2 ? phi[idx_neighbor_minus2] : 0;
+      LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,
+                                neighbor_plus2,grid_dims);
+      have_plus2 = (!grid_idx_out_of_bounds) && 
+        (OUTSIDE_DOMAIN != gridpoint_status[idx_neighbor_plus2]);
+      phi_plus2 = have_plus2 ? phi[idx_neighbor_plus2] : 0;
+
+      /* calculate distance to interface in minus direction */
+      if (have_minus) {
         if (phi_minus*phi_cur <= 0) {
 
-          /* locate zero level set using linear interpolant */
-          dist_minus = phi_cur/(phi_cur-phi_minus);
+          /* locate zero level set using a cubic (or quadratic) */
+          /* interpolant of phi along the grid line             */
+          dist_minus = FMM_FieldExtension_locateZeroCrossing(
+            phi_plus, phi_cur, phi_minus, phi_minus2,
+            have_plus && 
+              (OUTSIDE_DOMAIN != gridpoint_status[idx_neighbor_plus]),
+            have_minus2);
 
           /* compute value of extension fields on zero level set */
           LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,
@@ -842,14 +1069,16 @@ void FMM_INITIALIZE_FRONT_ORDER2(
       }
       
       /* calculate distance to interface in plus direction */
-      LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,
-                                neighbor_plus,grid_dims);
-      if (!grid_idx_out_of_bounds) {
-        phi_plus = phi[idx_neighbor_plus];
+      if (have_plus) {
         if (phi_plus*phi_cur <= 0) {
 
-          /* locate zero level set using linear interpolant */
-          dist_plus = phi_cur/(phi_cur-phi_plus);
+          /* locate zero level set using a cubic (or quadratic) */
+          /* interpolant of phi along the grid line             */
+          dist_plus = FMM_FieldExtension_locateZeroCrossing(
+            phi_minus, phi_cur, phi_plus, phi_plus2,
+            have_minus && 
+              (OUTSIDE_DOMAIN != gridpoint_status[idx_neighbor_minus]),
+            have_plus2);
 
           /* compute value of extension fields on zero level set */
           LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,
@@ -898,6 +1127,10 @@ void FMM_INITIALIZE_FRONT_ORDER2(
           use_plus = LSM_FMM_FALSE;
         }
 
+        /* the distance to the zero level set along a coordinate */
+        /* direction is an upper bound on the true distance      */
+        if (dist_dir < dist_min) dist_min = dist_dir;
+
         /* update 1/dist^2 and ext_field/dist^2 values with */
         /* information from current coordinate direction    */
         dist_inv_sq_dir = 1/dist_dir/dist_dir;
@@ -941,11 +1174,37 @@ void FMM_INITIALIZE_FRONT_ORDER2(
 
     } else if (borders_interface) { 
 
-      /* compute updated value for the signed distance function */
+      /* compute updated value for the signed distance function by  */
+      /* projecting onto the zero level set of the local bicubic     */
+      /* (tricubic) interpolant of phi.  If the interpolant uses     */
+      /* grid points outside of the domain or the projection fails,  */
+      /* project onto the zero level set of a local quadratic model  */
+      /* of phi instead.  If both projections fail or are            */
+      /* inconsistent with the distances along the coordinate        */
+      /* directions, use the first-order approximation.              */
+      dist_dir = LSMLIB_REAL_MAX;
+      if (FMM_FieldExtension_stencilInsideDomain(
+            gridpoint_status, grid_idx, grid_dims, 2)) {
+        if (FMM_COMPUTE_SUBCELL_DISTANCE(distance_function, phi, 
+                                         grid_idx, grid_dims, dx)
+         && (distance_function[idx] != large_distance_flag) ) {
+          dist_proj = LSM_FMM_ABS(distance_function[idx])*max_dx;
+          if (dist_proj <= dist_min) dist_dir = dist_proj;
+        }
+      }
+      if ( (dist_dir == LSMLIB_REAL_MAX)
+        && FMM_FieldExtension_projectOntoZeroLevelSet(
+             &dist_proj, phi, gridpoint_status, grid_idx, grid_dims, dx)
+        && (LSM_FMM_ABS(dist_proj) <= dist_min) ) {
+        dist_dir = LSM_FMM_ABS(dist_proj);
+      }
+      if (dist_dir == LSMLIB_REAL_MAX) {
+        dist_dir = sqrt(1.0/sum_dist_inv_sq);
+      }
       if (phi_cur > 0)
-        distance_function[idx] = sqrt(1.0/sum_dist_inv_sq);
+        distance_function[idx] = dist_dir;
       else 
-        distance_function[idx] = -sqrt(1.0/sum_dist_inv_sq);
+        distance_function[idx] = -dist_dir;
 
       /* compute extension field value */
       for (m = 0; m < num_extension_fields; m++) {
@@ -972,7 +1231,8 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
   int *grid_dims,
   LSMLIB_REAL *dx)
 {
-  int *gridpoint_status = FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+  unsigned char *gridpoint_status = 
+    FMM_Core_getGridPointStatusDataArray(fmm_core_data);
 
   /* FMM Field Data variables */
   LSMLIB_REAL *distance_function = fmm_field_data->distance_function; 
@@ -1185,7 +1445,8 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
   int *grid_dims,
   LSMLIB_REAL *dx)
 {
-  int *gridpoint_status = FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+  unsigned char *gridpoint_status = 
+    FMM_Core_getGridPointStatusDataArray(fmm_core_data);
 
   /* FMM Field Data variables */
   LSMLIB_REAL *distance_function = fmm_field_data->distance_function; 
@@ -1469,4 +1730,449 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
   return dist_updated;
 }
 
+
+LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER3(
+  FMM_CoreData *fmm_core_data,
+  FMM_FieldData *fmm_field_data,
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  unsigned char *gridpoint_status = 
+    FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+
+  /* FMM Field Data variables */
+  LSMLIB_REAL *distance_function = fmm_field_data->distance_function; 
+  int num_extension_fields = fmm_field_data->num_extension_fields; 
+  LSMLIB_REAL **extension_fields = fmm_field_data->extension_fields; 
+
+  /* variables for extension field calculations */
+  LSMLIB_REAL *extension_fields_numerator = 
+    fmm_field_data->extension_fields_numerator;
+  LSMLIB_REAL *extension_fields_denominator =
+    fmm_field_data->extension_fields_denominator;
+
+  /* variables used in distance function update */
+  PointStatus  neighbor_status;
+  int dir_used[FMM_NDIM];
+  int upwind_offset[FMM_NDIM];
+  int upwind_order[FMM_NDIM];
+  LSMLIB_REAL phi_upwind[3];
+  LSMLIB_REAL upwind_coef[FMM_NDIM], upwind_contrib[FMM_NDIM];
+  LSMLIB_REAL phi_upwind1[FMM_NDIM];
+  LSMLIB_REAL inv_dx_sq; 
+  int neighbor[FMM_NDIM];
+
+  /* coefficients of quadratic equation for the updated distance function */
+  LSMLIB_REAL phi_A = 0;
+  LSMLIB_REAL phi_B = 0;
+  LSMLIB_REAL phi_C = 0;
+
+  /* coefficients of quadratic equation for first-order update (used */
+  /* when the higher-order quadratic equation has no real roots)     */
+  LSMLIB_REAL phi_A1 = 0;
+  LSMLIB_REAL phi_B1 = 0;
+  LSMLIB_REAL phi_C1 = 0;
+  LSMLIB_REAL discriminant;
+  LSMLIB_REAL dist_updated;
+
+  /* auxilliary variables */
+  int dir;  /* loop variable for spatial directions */
+  int side; /* loop variable for minus/plus neighbors */
+  int s;    /* loop variable for neighbors along upwind direction */
+  int k;    /* loop variable for extension fields */
+  int l;    /* extra loop variable */ 
+  int idx_cur_gridpoint, idx_neighbor;
+  int grid_idx_out_of_bounds;
+
+  /* unused function parameters */
+  (void) num_dims;
+
+  /* initialize auxilliary variables used for extension field calculation */
+  for (k = 0; k < num_extension_fields; k++) {
+    extension_fields_numerator[k] = 0;
+    extension_fields_denominator[k] = 0;
+  }
+
+  /* calculate update to distance function */
+  for (dir = 0; dir < FMM_NDIM; dir++) { /* loop over coord directions */
+
+    /* changed to true if has KNOWN neighbor */
+    dir_used[dir] = LSM_FMM_FALSE;  
+    upwind_order[dir] = 0;
+    upwind_offset[dir] = 0;
+
+    for (side = -1; side <= 1; side += 2) { /* loop over minus/plus sides */
+
+      /* collect KNOWN neighbors along current side with non-increasing */
+      /* abs(phi) values (up to three for third-order accuracy)         */
+      int num_upwind = 0;
+      LSMLIB_REAL phi_side[3];
+      for (s = 1; s <= 3; s++) {
+        for (l = 0; l < FMM_NDIM; l++) neighbor[l] = grid_idx[l];
+        neighbor[dir] += s*side;
+        LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor,grid_dims);
+        if (grid_idx_out_of_bounds) break;
+        LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
+        neighbor_status = (PointStatus) gridpoint_status[idx_neighbor];
+        if (KNOWN != neighbor_status) break;
+        if ( (s > 1) && 
+             (  LSM_FMM_ABS(distance_function[idx_neighbor])
+              > LSM_FMM_ABS(phi_side[s-2])) ) break;
+        phi_side[s-1] = distance_function[idx_neighbor];
+        num_upwind++;
+      }
+
+      /* 
+       * choosing the upwind direction to be the direction
+       * with the smaller abs(phi) value gives a consistent 
+       * solution to the "upwind" Eikonal equation.
+       */
+      if ( (num_upwind > 0) && 
+           ( (!dir_used[dir]) ||
+             (LSM_FMM_ABS(phi_side[0]) < LSM_FMM_ABS(phi_upwind[0])) ) ) {
+        dir_used[dir] = LSM_FMM_TRUE;
+        upwind_offset[dir] = side;
+        upwind_order[dir] = num_upwind;
+        for (s = 0; s < num_upwind; s++) phi_upwind[s] = phi_side[s];
+      }
+
+    } /* end loop over minus/plus sides */
+
+    /*
+     * accumulate coefficients for phi if any of the neighbors are "KNOWN"
+     */
+    if (dir_used[dir]) {
+
+      /* set upwind_coef and upwind_contrib based on the number of */
+      /* KNOWN neighbors available in the upwind direction so that */
+      /* D phi = (upwind_coef*phi - upwind_contrib)/dx             */
+      if (upwind_order[dir] == 3) {
+        upwind_coef[dir] = 11.0/6.0;
+        upwind_contrib[dir] = 3.0*phi_upwind[0] - 1.5*phi_upwind[1]
+                            + phi_upwind[2]/3.0;
+      } else if (upwind_order[dir] == 2) {
+        upwind_coef[dir] = 1.5;
+        upwind_contrib[dir] = 2.0*phi_upwind[0] - 0.5*phi_upwind[1];
+      } else {
+        upwind_coef[dir] = 1.0;
+        upwind_contrib[dir] = phi_upwind[0];
+      }
+      
+      /* accumulate coefs for phi */
+      inv_dx_sq = 1/dx[dir]; inv_dx_sq *= inv_dx_sq;
+      phi_A += inv_dx_sq*upwind_coef[dir]*upwind_coef[dir];
+      phi_B += inv_dx_sq*upwind_coef[dir]*upwind_contrib[dir];
+      phi_C += inv_dx_sq*upwind_contrib[dir]*upwind_contrib[dir];
+      phi_upwind1[dir] = phi_upwind[0];
+      phi_A1 += inv_dx_sq;
+      phi_B1 += inv_dx_sq*phi_upwind[0];
+      phi_C1 += inv_dx_sq*phi_upwind[0]*phi_upwind[0];
+    }
+
+  } /* loop over coordinate directions */
+
+  /* check that phi_A is nonzero */
+  if (LSM_FMM_ABS(phi_A) == 0) {
+    fprintf(stderr,"ERROR: distance update - no KNOWN neighbors!!!\n");
+    fprintf(stderr,"       distance set to 'infinity'.\n");
+    return LSMLIB_REAL_MAX;
+  }
+
+  /* complete computation of phi_B and phi_C */
+  phi_B *= -2.0;
+  phi_C -= 1.0;  
+  phi_B1 *= -2.0;
+  phi_C1 -= 1.0;  
+
+  /* compute index of current grid point */
+  LSM_FMM_IDX(idx_cur_gridpoint, grid_idx, grid_dims);
+
+  /* compute updated distance function by solving quadratic equation */
+  discriminant = phi_B*phi_B - 4.0*phi_A*phi_C;
+  if (discriminant < 0) {
+
+    /* the higher-order discretization is inconsistent with the */
+    /* KNOWN neighbors (e.g., close to the initial front or to  */
+    /* kinks in the solution), so drop to first-order accuracy  */
+    phi_A = phi_A1;
+    phi_B = phi_B1;
+    phi_C = phi_C1;
+    discriminant = phi_B*phi_B - 4.0*phi_A*phi_C;
+    for (dir = 0; dir < FMM_NDIM; dir++) {
+      upwind_coef[dir] = 1.0;
+      upwind_contrib[dir] = phi_upwind1[dir];
+    }
+
+  }
+  dist_updated = LSMLIB_REAL_MAX;
+  if (discriminant >= 0) {
+
+    if (phi_B == 0) { 
+      /* grid point is ON the interface, so keep it there */
+      dist_updated = 0;
+    } else if (phi_B < LSMLIB_ZERO_TOL) { 
+      /* distance function of neighbors is positive */
+      dist_updated = 0.5*(-phi_B + sqrt(discriminant))/phi_A;
+    } else {
+      /* distance function of neighbors is negative */
+      dist_updated = 0.5*(-phi_B - sqrt(discriminant))/phi_A;
+    } 
+
+  } else {
+
+    /* discriminant is negative ... set dist_updated to the   */
+    /* value of distance_function at the current grid point   */
+    /* so that the distance function is not corrupted by      */
+    /* infinities (see FMM_UPDATE_GRID_POINT_ORDER1()).       */
+    dist_updated = distance_function[idx_cur_gridpoint]; 
+
+  } /* end switch on value of discriminant */
+
+
+  /* calculate extension field values                              */
+  /* NOTE: as in FMM_UPDATE_GRID_POINT_ORDER2(), the extension      */
+  /*       fields are computed using a first-order discretization  */
+  /*       of grad(F) together with the high-order approximation  */
+  /*       of grad(dist).                                          */
+  if (num_extension_fields > 0) {
+
+    for (dir = 0; dir < FMM_NDIM; dir++) { /* loop over coord directions */
+
+      /*
+       * only accumulate values from the current direction if this
+       * direction was used in the update of the distance function
+       */
+      if (dir_used[dir]) {
+
+        LSMLIB_REAL grad_dist = upwind_coef[dir]*dist_updated 
+                              - upwind_contrib[dir];
+
+        for (l = 0; l < FMM_NDIM; l++) neighbor[l] = grid_idx[l];
+        neighbor[dir] += upwind_offset[dir];
+        LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
+  
+        inv_dx_sq = 1/dx[dir]; inv_dx_sq *= inv_dx_sq;
+        for (k = 0; k < num_extension_fields; k++) {
+          extension_fields_numerator[k] += 
+            inv_dx_sq*grad_dist*extension_fields[k][idx_neighbor];
+          extension_fields_denominator[k] += inv_dx_sq*grad_dist;
+        }
+
+      } /* end case: current direction used */
+    } /* loop over coordinate directions */
+  } /* end case: num_extension_fields > 0 */
+
+
+  /* set updated quantities */
+  distance_function[idx_cur_gridpoint] = dist_updated;
+  for (k = 0; k < num_extension_fields; k++) {
+    extension_fields[k][idx_cur_gridpoint] =
+      extension_fields_numerator[k]/extension_fields_denominator[k];
+  }
+
+  return dist_updated;
+}
+
+
+/*==================== Helper Functions Definitions =================*/
+
+static LSMLIB_REAL FMM_FieldExtension_locateZeroCrossing(
+  LSMLIB_REAL phi_back,
+  LSMLIB_REAL phi_cur,
+  LSMLIB_REAL phi_nb,
+  LSMLIB_REAL phi_nb2,
+  int use_back,
+  int use_nb2)
+{
+  /* coefficients of interpolant p(s) = c0 + c1*s + c2*s^2 + c3*s^3 */
+  LSMLIB_REAL c0 = phi_cur, c1, c2, c3;
+  LSMLIB_REAL s, s_lo = 0, s_hi = 1;
+  LSMLIB_REAL p, dp, ds;
+  int iter;
+
+  /* initial guess from linear interpolant */
+  s = phi_cur/(phi_cur-phi_nb);
+
+  /* compute the coefficients of the interpolant */
+  if (use_back && use_nb2) {
+    /* cubic through s = -1, 0, 1, 2 */
+    c1 = -phi_back/3.0 - 0.5*phi_cur + phi_nb - phi_nb2/6.0;
+    c2 = 0.5*(phi_back + phi_nb) - phi_cur;
+    c3 = (phi_nb2 - phi_back)/6.0 + 0.5*(phi_cur - phi_nb);
+  } else if (use_nb2) {
+    /* quadratic through s = 0, 1, 2 */
+    c1 = -1.5*phi_cur + 2.0*phi_nb - 0.5*phi_nb2;
+    c2 = 0.5*phi_cur - phi_nb + 0.5*phi_nb2;
+    c3 = 0;
+  } else if (use_back) {
+    /* quadratic through s = -1, 0, 1 */
+    c1 = 0.5*(phi_nb - phi_back);
+    c2 = 0.5*(phi_nb + phi_back) - phi_cur;
+    c3 = 0;
+  } else {
+    return s;
+  }
+
+  /* safeguarded Newton iteration on [0,1], where phi_cur and phi_nb */
+  /* have opposite signs so that the interpolant is bracketed        */
+  for (iter = 0; iter < FMM_FIELD_EXTENSION_MAX_NEWTON_ITERATIONS; iter++) {
+    p = c0 + s*(c1 + s*(c2 + s*c3));
+    dp = c1 + s*(2.0*c2 + 3.0*s*c3);
+
+    /* update bracket */
+    if (p*phi_cur > 0) {
+      s_lo = s;
+    } else {
+      s_hi = s;
+    }
+
+    /* take Newton step, falling back to bisection if the step */
+    /* leaves the bracket                                      */
+    ds = (dp != 0) ? -p/dp : s_hi - s_lo;
+    if ( (dp == 0) || (s+ds <= s_lo) || (s+ds >= s_hi) ) {
+      ds = 0.5*(s_lo + s_hi) - s;
+    }
+    s += ds;
+
+    if (LSM_FMM_ABS(ds) < LSMLIB_ZERO_TOL) break;
+  }
+
+  return s;
+}
+
+
+static int FMM_FieldExtension_projectOntoZeroLevelSet(
+  LSMLIB_REAL *dist,
+  LSMLIB_REAL *phi,
+  unsigned char *gridpoint_status,
+  int *grid_idx,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  LSMLIB_REAL grad[FMM_NDIM];
+  LSMLIB_REAL hess[FMM_NDIM][FMM_NDIM];
+  LSMLIB_REAL phi_nb[4];
+  LSMLIB_REAL phi_cur;
+  LSMLIB_REAL grad_mag, curv, discriminant, s;
+  int neighbor[FMM_NDIM];
+  int dir, dir2, l, c;
+  int idx_cur_gridpoint, idx_neighbor;
+  int grid_idx_out_of_bounds;
+
+  LSM_FMM_IDX(idx_cur_gridpoint, grid_idx, grid_dims);
+  phi_cur = phi[idx_cur_gridpoint];
+
+  /* compute gradient and Hessian of phi using central differences */
+  for (dir = 0; dir < FMM_NDIM; dir++) {
+    for (dir2 = dir; dir2 < FMM_NDIM; dir2++) {
+
+      /* gather phi at the (dir, dir2) = (-,-), (+,-), (-,+), (+,+)  */
+      /* neighbors.  When dir2 == dir, these are the -2, 0, 0 and +2 */
+      /* neighbors, so only the first and last entries are used.     */
+      for (c = 0; c < 4; c++) {
+        for (l = 0; l < FMM_NDIM; l++) neighbor[l] = grid_idx[l];
+        neighbor[dir]  += (c & 1) ? 1 : -1;
+        neighbor[dir2] += (c & 2) ? 1 : -1;
+        LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor,grid_dims);
+        if (grid_idx_out_of_bounds) return LSM_FMM_FALSE;
+        LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
+        if (OUTSIDE_DOMAIN == gridpoint_status[idx_neighbor]) {
+          return LSM_FMM_FALSE;
+        }
+        phi_nb[c] = phi[idx_neighbor];
+      }
+
+      if (dir2 == dir) {
+
+        LSMLIB_REAL phi_minus, phi_plus;
+        for (l = 0; l < FMM_NDIM; l++) neighbor[l] = grid_idx[l];
+        neighbor[dir]--;
+        LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
+        phi_minus = phi[idx_neighbor];
+        neighbor[dir] += 2;
+        LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
+        phi_plus = phi[idx_neighbor];
+
+        grad[dir] = 0.5*(phi_plus - phi_minus)/dx[dir];
+        hess[dir][dir] = (phi_plus - 2.0*phi_cur + phi_minus)
+                       / dx[dir]/dx[dir];
+
+      } else {
+
+        hess[dir][dir2] = 0.25*(phi_nb[3] - phi_nb[1] - phi_nb[2] + phi_nb[0])
+                        / dx[dir]/dx[dir2];
+        hess[dir2][dir] = hess[dir][dir2];
+
+      }
+    }
+  }
+
+  grad_mag = 0;
+  for (dir = 0; dir < FMM_NDIM; dir++) grad_mag += grad[dir]*grad[dir];
+  grad_mag = sqrt(grad_mag);
+  if (grad_mag < LSMLIB_ZERO_TOL) return LSM_FMM_FALSE;
+
+  /* compute second derivative of phi along the unit normal */
+  curv = 0;
+  for (dir = 0; dir < FMM_NDIM; dir++) {
+    for (dir2 = 0; dir2 < FMM_NDIM; dir2++) {
+      curv += grad[dir]*hess[dir][dir2]*grad[dir2];
+    }
+  }
+  curv /= grad_mag*grad_mag;
+
+  /* solve phi + grad_mag*s + 0.5*curv*s^2 = 0 for the root closest */
+  /* to s = 0 (dropping to the linear model if there are no real    */
+  /* roots)                                                         */
+  discriminant = grad_mag*grad_mag - 2.0*curv*phi_cur;
+  if (discriminant >= 0) {
+    s = -2.0*phi_cur/(grad_mag + sqrt(discriminant));
+  } else {
+    s = -phi_cur/grad_mag;
+  }
+
+  *dist = -s;
+  return LSM_FMM_TRUE;
+}
+
+
+static int FMM_FieldExtension_stencilInsideDomain(
+  unsigned char *gridpoint_status,
+  int *grid_idx,
+  int *grid_dims,
+  int width)
+{
+  int offset[FMM_NDIM];
+  int neighbor[FMM_NDIM];
+  int idx_neighbor;
+  int grid_idx_out_of_bounds;
+  int l;
+
+  for (l = 0; l < FMM_NDIM; l++) offset[l] = -width;
+
+  /* loop over all offsets in [-width,width]^FMM_NDIM */
+  while (offset[FMM_NDIM-1] <= width) {
+
+    for (l = 0; l < FMM_NDIM; l++) neighbor[l] = grid_idx[l] + offset[l];
+    LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor,grid_dims);
+    if (!grid_idx_out_of_bounds) {
+      LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
+      if (OUTSIDE_DOMAIN == gridpoint_status[idx_neighbor]) {
+        return LSM_FMM_FALSE;
+      }
+    }
+
+    /* advance to next offset */
+    for (l = 0; l < FMM_NDIM; l++) {
+      offset[l]++;
+      if ( (offset[l] <= width) || (l == FMM_NDIM-1) ) break;
+      offset[l] = -width;
+    }
+  }
+
+  return LSM_FMM_TRUE;
+}
+
 #endif
@@ -17,12 +17,17 @@
  */
 
 #include "lsm_fast_marching_method.h"
+#include "lsm_reinitialization2d.h"
 
 
 /* Define required macros */
 #define FMM_NDIM                         2
 #define FMM_COMPUTE_DISTANCE_FUNCTION    computeDistanceFunction2d
 #define FMM_COMPUTE_EXTENSION_FIELDS     computeExtensionFields2d
+#define FMM_COMPUTE_DISTANCE_FUNCTION_WITH_WORKSPACE                        \
+        computeDistanceFunction2dWithWorkspace
+#define FMM_COMPUTE_EXTENSION_FIELDS_WITH_WORKSPACE                         \
+        computeExtensionFields2dWithWorkspace
 #define FMM_INITIALIZE_FRONT_ORDER1                                         \
         FMM_initializeFront_FieldExtension2d_Order1
 #define FMM_INITIALIZE_FRONT_ORDER2                                         \
@@ -31,6 +36,35 @@
         FMM_updateGridPoint_FieldExtension2d_Order1
 #define FMM_UPDATE_GRID_POINT_ORDER2                                        \
         FMM_updateGridPoint_FieldExtension2d_Order2
+#define FMM_UPDATE_GRID_POINT_ORDER3                                        \
+        FMM_updateGridPoint_FieldExtension2d_Order3
+#define FMM_COMPUTE_SUBCELL_DISTANCE                                        \
+        FMM_computeSubcellDistance_FieldExtension2d
+
+
+/*
+ * FMM_computeSubcellDistance_FieldExtension2d() sets distance0 at 
+ * grid_idx using LSM2D_COMPUTE_DISTANCE_FOR_SUBCELL_FIX_CUBIC() 
+ * with the entire grid as the ghostbox.  It returns 1 if the Newton 
+ * projection succeeded and 0 otherwise.
+ */
+static int FMM_computeSubcellDistance_FieldExtension2d(
+  LSMLIB_REAL *distance0,
+  LSMLIB_REAL *phi,
+  int *grid_idx,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  int ilo_gb = 0, ihi_gb = grid_dims[0]-1;
+  int jlo_gb = 0, jhi_gb = grid_dims[1]-1;
+  int num_projection_failures;
+  LSM2D_COMPUTE_DISTANCE_FOR_SUBCELL_FIX_CUBIC(
+    distance0, &num_projection_failures, phi,
+    &ilo_gb, &ihi_gb, &jlo_gb, &jhi_gb,
+    &grid_idx[0], &grid_idx[0], &grid_idx[1], &grid_idx[1], 
+    &dx[0], &dx[1]);
+  return (num_projection_failures == 0);
+}
 
 
 /* Include "templated" implementation of Fast Marching Method */
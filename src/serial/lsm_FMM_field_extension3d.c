@@ -17,12 +17,17 @@
  */
 
 #include "lsm_fast_marching_method.h"
+#include "lsm_reinitialization3d.h"
 
 
 /* Define required macros */
 #define FMM_NDIM                         3
 #define FMM_COMPUTE_DISTANCE_FUNCTION    computeDistanceFunction3d
 #define FMM_COMPUTE_EXTENSION_FIELDS     computeExtensionFields3d
+#define FMM_COMPUTE_DISTANCE_FUNCTION_WITH_WORKSPACE                        \
+        computeDistanceFunction3dWithWorkspace
+#define FMM_COMPUTE_EXTENSION_FIELDS_WITH_WORKSPACE                         \
+        computeExtensionFields3dWithWorkspace
 #define FMM_INITIALIZE_FRONT_ORDER1                                         \
         FMM_initializeFront_FieldExtension3d_Order1
 #define FMM_INITIALIZE_FRONT_ORDER2                                         \
@@ -31,6 +36,37 @@
         FMM_updateGridPoint_FieldExtension3d_Order1
 #define FMM_UPDATE_GRID_POINT_ORDER2                                        \
         FMM_updateGridPoint_FieldExtension3d_Order2
+#define FMM_UPDATE_GRID_POINT_ORDER3                                        \
+        FMM_updateGridPoint_FieldExtension3d_Order3
+#define FMM_COMPUTE_SUBCELL_DISTANCE                                        \
+        FMM_computeSubcellDistance_FieldExtension3d
+
+
+/*
+ * FMM_computeSubcellDistance_FieldExtension3d() sets distance0 at 
+ * grid_idx using LSM3D_COMPUTE_DISTANCE_FOR_SUBCELL_FIX_CUBIC() 
+ * with the entire grid as the ghostbox.  It returns 1 if the Newton 
+ * projection succeeded and 0 otherwise.
+ */
+static int FMM_computeSubcellDistance_FieldExtension3d(
+  LSMLIB_REAL *distance0,
+  LSMLIB_REAL *phi,
+  int *grid_idx,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  int ilo_gb = 0, ihi_gb = grid_dims[0]-1;
+  int jlo_gb = 0, jhi_gb = grid_dims[1]-1;
+  int klo_gb = 0, khi_gb = grid_dims[2]-1;
+  int num_projection_failures;
+  LSM3D_COMPUTE_DISTANCE_FOR_SUBCELL_FIX_CUBIC(
+    distance0, &num_projection_failures, phi,
+    &ilo_gb, &ihi_gb, &jlo_gb, &jhi_gb, &klo_gb, &khi_gb,
+    &grid_idx[0], &grid_idx[0], &grid_idx[1], &grid_idx[1], 
+    &grid_idx[2], &grid_idx[2],
+    &dx[0], &dx[1], &dx[2]);
+  return (num_projection_failures == 0);
+}
 
 
 /* Include "templated" implementation of Fast Marching Method */
@@ -0,0 +1,379 @@
+/*
+ * File:        lsm_anisotropic_eikonal.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation of anisotropic Eikonal equation solvers
+ */
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include "LSMLIB_config.h"
+#include "lsm_anisotropic_eikonal.h"
+
+
+/*===================== Helper Functions Declarations ==================*/
+
+/* status of grid points during the sweeping iteration; the ACTIVE */
+/* flag marks UPDATE grid points with neighbors that have changed   */
+/* since the grid point was last updated                            */
+#define LSM_ANISOTROPIC_EIKONAL_UPDATE          (0)
+#define LSM_ANISOTROPIC_EIKONAL_FIXED           (1)
+#define LSM_ANISOTROPIC_EIKONAL_OUTSIDE_DOMAIN  (2)
+#define LSM_ANISOTROPIC_EIKONAL_ACTIVE          (4)
+
+static int solveAnisotropicEikonalEquation(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL **speed_tensor,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL tolerance,
+  int max_iterations,
+  int *num_iterations,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+static LSMLIB_REAL computeMinEigenvalueBound(
+  LSMLIB_REAL **speed_tensor,
+  int idx,
+  int num_dims);
+
+static LSMLIB_REAL updateGridPoint(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL **speed_tensor,
+  unsigned char *status,
+  LSMLIB_REAL phi_large,
+  int idx,
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  int *offsets,
+  LSMLIB_REAL *dx);
+
+
+/*================== Anisotropic Eikonal Equation Solvers ===============*/
+
+int solveAnisotropicEikonalEquation2d(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL **speed_tensor,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL tolerance,
+  int max_iterations,
+  int *num_iterations,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  return solveAnisotropicEikonalEquation(phi, speed_tensor, mask,
+    tolerance, max_iterations, num_iterations, 2, grid_dims, dx);
+}
+
+
+int solveAnisotropicEikonalEquation3d(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL **speed_tensor,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL tolerance,
+  int max_iterations,
+  int *num_iterations,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  return solveAnisotropicEikonalEquation(phi, speed_tensor, mask,
+    tolerance, max_iterations, num_iterations, 3, grid_dims, dx);
+}
+
+
+/*==================== Helper Functions Definitions =================*/
+
+/*
+ * index of component (d1,d2) of the speed tensor in the speed_tensor
+ * array (packed upper triangle stored row by row)
+ */
+static const int s_tensor_component_2d[2][2] = { {0, 1}, {1, 2} };
+static const int s_tensor_component_3d[3][3] =
+  { {0, 1, 2}, {1, 3, 4}, {2, 4, 5} };
+
+
+/*
+ * solveAnisotropicEikonalEquation() carries out the Lax-Friedrichs
+ * fast sweeping iteration for two- and three-dimensional grids.
+ *
+ * Grid points that have not been reached (as well as neighbors that
+ * lie outside of the grid or the domain of the problem) are assigned
+ * a large value, phi_large, that exceeds the arrival time at every
+ * reachable grid point.  Because the Lax-Friedrichs update is
+ * monotone in the neighboring values, these values never reduce the
+ * values at the other grid points below the solution.
+ */
+static int solveAnisotropicEikonalEquation(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL **speed_tensor,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL tolerance,
+  int max_iterations,
+  int *num_iterations,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  unsigned char *status;
+  int dims[3] = {1, 1, 1};
+  int offsets[3];
+  int grid_idx[3];
+  int start[3], end[3], step[3];
+  int num_components = (num_dims == 2) ? 3 : 6;
+  int num_gridpoints;
+  int num_orderings = 1 << num_dims;
+  int iteration, ordering;
+  int converged = 0;
+  LSMLIB_REAL min_eigenvalue = LSMLIB_REAL_MAX;
+  LSMLIB_REAL max_fixed_phi = 0.0;
+  LSMLIB_REAL path_length = 0.0;
+  LSMLIB_REAL phi_large;
+  int d, idx;
+
+  if (num_iterations) *num_iterations = 0;
+
+  /* check arguments */
+  if ( (!phi) || (!speed_tensor) || (!grid_dims) || (!dx) ) {
+    return LSM_ANISOTROPIC_EIKONAL_ERR_INVALID_ARGUMENT;
+  }
+  for (d = 0; d < num_components; d++) {
+    if (!speed_tensor[d]) return LSM_ANISOTROPIC_EIKONAL_ERR_INVALID_ARGUMENT;
+  }
+  num_gridpoints = 1;
+  for (d = 0; d < num_dims; d++) {
+    if ( (grid_dims[d] <= 0) || (dx[d] <= 0) ) {
+      return LSM_ANISOTROPIC_EIKONAL_ERR_INVALID_ARGUMENT;
+    }
+    dims[d] = grid_dims[d];
+    num_gridpoints *= grid_dims[d];
+    path_length += grid_dims[d]*dx[d];
+  }
+  offsets[0] = 1;
+  offsets[1] = dims[0];
+  offsets[2] = dims[0]*dims[1];
+
+  status = (unsigned char*) malloc(num_gridpoints*sizeof(unsigned char));
+  if (!status) return LSM_ANISOTROPIC_EIKONAL_ERR_MEMORY_ALLOCATION;
+
+  /* initialize status and find bounds on the speed and fixed values */
+  for (idx = 0; idx < num_gridpoints; idx++) {
+    LSMLIB_REAL lambda = computeMinEigenvalueBound(speed_tensor, idx,
+                                                   num_dims);
+
+    if ( ((mask) && (mask[idx] < 0)) || (lambda < LSMLIB_ZERO_TOL) ) {
+      status[idx] = LSM_ANISOTROPIC_EIKONAL_OUTSIDE_DOMAIN;
+    } else if (phi[idx] >= 0) {
+      status[idx] = LSM_ANISOTROPIC_EIKONAL_FIXED;
+      if (phi[idx] > max_fixed_phi) max_fixed_phi = phi[idx];
+      if (lambda < min_eigenvalue) min_eigenvalue = lambda;
+    } else {
+      status[idx] = LSM_ANISOTROPIC_EIKONAL_UPDATE
+                  | LSM_ANISOTROPIC_EIKONAL_ACTIVE;
+      if (lambda < min_eigenvalue) min_eigenvalue = lambda;
+    }
+  }
+
+  /* set phi_large to a generous bound on the arrival time: paths  */
+  /* around obstacles may be several times longer than the size of */
+  /* the grid                                                      */
+  phi_large = (min_eigenvalue < LSMLIB_REAL_MAX)
+            ? max_fixed_phi + 100.0*path_length/sqrt(min_eigenvalue)
+            : 1.0;
+  for (idx = 0; idx < num_gridpoints; idx++) {
+    if (status[idx] != LSM_ANISOTROPIC_EIKONAL_FIXED) phi[idx] = phi_large;
+  }
+
+  /* sweep the grid in alternating orderings until phi stops changing */
+  for (iteration = 0; (iteration < max_iterations) && (!converged);
+       iteration++) {
+    LSMLIB_REAL max_change = 0.0;
+
+    for (ordering = 0; ordering < num_orderings; ordering++) {
+
+      /* set loop bounds for current ordering */
+      for (d = 0; d < 3; d++) {
+        if ( (ordering >> d) & 1 ) {
+          start[d] = dims[d]-1; end[d] = -1; step[d] = -1;
+        } else {
+          start[d] = 0; end[d] = dims[d]; step[d] = 1;
+        }
+      }
+
+      for (grid_idx[2] = start[2]; grid_idx[2] != end[2];
+           grid_idx[2] += step[2]) {
+        for (grid_idx[1] = start[1]; grid_idx[1] != end[1];
+             grid_idx[1] += step[1]) {
+          for (grid_idx[0] = start[0]; grid_idx[0] != end[0];
+               grid_idx[0] += step[0]) {
+            LSMLIB_REAL change;
+
+            idx = grid_idx[0] + offsets[1]*grid_idx[1]
+                + offsets[2]*grid_idx[2];
+            if (!(status[idx] & LSM_ANISOTROPIC_EIKONAL_ACTIVE)) continue;
+            status[idx] = LSM_ANISOTROPIC_EIKONAL_UPDATE;
+
+            change = updateGridPoint(phi, speed_tensor, status, phi_large,
+                                     idx, grid_idx, num_dims, dims,
+                                     offsets, dx);
+            if (change > max_change) max_change = change;
+
+            /* activate neighbors of grid points that have changed by */
+            /* more than the tolerance                                */
+            if (change > tolerance) {
+              for (d = 0; d < num_dims; d++) {
+                if ( (grid_idx[d] > 0) && (status[idx-offsets[d]]
+                     == LSM_ANISOTROPIC_EIKONAL_UPDATE) ) {
+                  status[idx-offsets[d]] |= LSM_ANISOTROPIC_EIKONAL_ACTIVE;
+                }
+                if ( (grid_idx[d] < dims[d]-1) && (status[idx+offsets[d]]
+                     == LSM_ANISOTROPIC_EIKONAL_UPDATE) ) {
+                  status[idx+offsets[d]] |= LSM_ANISOTROPIC_EIKONAL_ACTIVE;
+                }
+              }
+            }
+          }
+        }
+      }
+    } /* end loop over orderings */
+
+    converged = (max_change <= tolerance);
+    if (num_iterations) *num_iterations = iteration+1;
+  }
+
+  /* set phi to LSMLIB_REAL_MAX at grid points that were not reached */
+  for (idx = 0; idx < num_gridpoints; idx++) {
+    if ( (status[idx] == LSM_ANISOTROPIC_EIKONAL_OUTSIDE_DOMAIN)
+      || ( (status[idx] != LSM_ANISOTROPIC_EIKONAL_FIXED)
+        && (phi[idx] >= phi_large) ) ) {
+      phi[idx] = LSMLIB_REAL_MAX;
+    }
+  }
+
+  free(status);
+
+  return converged ? LSM_ANISOTROPIC_EIKONAL_ERR_SUCCESS
+                   : LSM_ANISOTROPIC_EIKONAL_ERR_NOT_CONVERGED;
+}
+
+
+/*
+ * computeMinEigenvalueBound() returns a lower bound on the smallest
+ * eigenvalue of the speed tensor at grid point idx (the exact value
+ * in two dimensions).  The return value is non-positive if the speed
+ * tensor is not positive definite.
+ */
+static LSMLIB_REAL computeMinEigenvalueBound(
+  LSMLIB_REAL **speed_tensor,
+  int idx,
+  int num_dims)
+{
+  if (num_dims == 2) {
+    LSMLIB_REAL D_xx = speed_tensor[0][idx];
+    LSMLIB_REAL D_xy = speed_tensor[1][idx];
+    LSMLIB_REAL D_yy = speed_tensor[2][idx];
+    LSMLIB_REAL mean = 0.5*(D_xx + D_yy);
+    LSMLIB_REAL diff = 0.5*(D_xx - D_yy);
+
+    return mean - sqrt(diff*diff + D_xy*D_xy);
+
+  } else {
+    LSMLIB_REAL D_xx = speed_tensor[0][idx];
+    LSMLIB_REAL D_xy = speed_tensor[1][idx];
+    LSMLIB_REAL D_xz = speed_tensor[2][idx];
+    LSMLIB_REAL D_yy = speed_tensor[3][idx];
+    LSMLIB_REAL D_yz = speed_tensor[4][idx];
+    LSMLIB_REAL D_zz = speed_tensor[5][idx];
+    LSMLIB_REAL trace = D_xx + D_yy + D_zz;
+    LSMLIB_REAL minor_sum = D_xx*D_yy - D_xy*D_xy + D_xx*D_zz - D_xz*D_xz
+                          + D_yy*D_zz - D_yz*D_yz;
+    LSMLIB_REAL det = D_xx*(D_yy*D_zz - D_yz*D_yz)
+                    - D_xy*(D_xy*D_zz - D_yz*D_xz)
+                    + D_xz*(D_xy*D_yz - D_yy*D_xz);
+
+    /* the tensor is positive definite if and only if the trace, the */
+    /* sum of the principal 2x2 minors and the determinant are all   */
+    /* positive; since the largest eigenvalue is bounded by the      */
+    /* trace, det/trace^2 bounds the smallest eigenvalue from below  */
+    if ( (trace <= 0) || (minor_sum <= 0) || (det <= 0) ) return 0.0;
+    return det/(trace*trace);
+  }
+}
+
+
+/*
+ * updateGridPoint() applies the Lax-Friedrichs update to the grid
+ * point idx and returns the decrease in phi.
+ */
+static LSMLIB_REAL updateGridPoint(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL **speed_tensor,
+  unsigned char *status,
+  LSMLIB_REAL phi_large,
+  int idx,
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  int *offsets,
+  LSMLIB_REAL *dx)
+{
+  LSMLIB_REAL grad_phi[3];
+  LSMLIB_REAL numerator = 1.0, denominator = 0.0;
+  LSMLIB_REAL H_sq = 0.0;
+  LSMLIB_REAL phi_new;
+  int d, d2;
+
+  for (d = 0; d < num_dims; d++) {
+    int c = (num_dims == 2) ? s_tensor_component_2d[d][d]
+                            : s_tensor_component_3d[d][d];
+    LSMLIB_REAL sigma = sqrt(speed_tensor[c][idx]);
+    LSMLIB_REAL phi_minus = phi_large, phi_plus = phi_large;
+
+    /* neighbors outside of the domain take the value phi_large;  */
+    /* neighbors outside of the grid are linearly extrapolated     */
+    /* (the neighbor inside the grid is used until phi is reached) */
+    if ( (grid_idx[d] > 0) &&
+         (status[idx-offsets[d]] != LSM_ANISOTROPIC_EIKONAL_OUTSIDE_DOMAIN) ) {
+      phi_minus = phi[idx-offsets[d]];
+    }
+    if ( (grid_idx[d] < grid_dims[d]-1) &&
+         (status[idx+offsets[d]] != LSM_ANISOTROPIC_EIKONAL_OUTSIDE_DOMAIN) ) {
+      phi_plus = phi[idx+offsets[d]];
+    }
+    if (grid_idx[d] == 0) {
+      phi_minus = (phi[idx] < phi_large) ? 2.0*phi[idx] - phi_plus : phi_plus;
+      if (phi_minus < phi_plus) phi_minus = phi_plus;
+    }
+    if (grid_idx[d] == grid_dims[d]-1) {
+      phi_plus = (phi[idx] < phi_large) ? 2.0*phi[idx] - phi_minus : phi_minus;
+      if (phi_plus < phi_minus) phi_plus = phi_minus;
+    }
+
+    grad_phi[d] = (phi_plus - phi_minus)/(2.0*dx[d]);
+    numerator += sigma*(phi_plus + phi_minus)/(2.0*dx[d]);
+    denominator += sigma/dx[d];
+  }
+
+  /* compute H(grad phi) = sqrt(grad phi . D grad phi) */
+  for (d = 0; d < num_dims; d++) {
+    for (d2 = 0; d2 < num_dims; d2++) {
+      int c = (num_dims == 2) ? s_tensor_component_2d[d][d2]
+                              : s_tensor_component_3d[d][d2];
+      H_sq += grad_phi[d]*speed_tensor[c][idx]*grad_phi[d2];
+    }
+  }
+  numerator -= (H_sq > 0.0) ? sqrt(H_sq) : 0.0;
+
+  phi_new = numerator/denominator;
+  if (phi_new < phi[idx]) {
+    LSMLIB_REAL change = phi[idx] - phi_new;
+    phi[idx] = phi_new;
+    return change;
+  }
+
+  return 0.0;
+}
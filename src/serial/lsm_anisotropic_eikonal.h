@@ -0,0 +1,196 @@
+/*
+ * File:        lsm_anisotropic_eikonal.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for anisotropic Eikonal equation solvers
+ */
+
+#ifndef INCLUDED_LSM_ANISOTROPIC_EIKONAL_H
+#define INCLUDED_LSM_ANISOTROPIC_EIKONAL_H
+
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*! \file lsm_anisotropic_eikonal.h
+ *
+ * \brief
+ * @ref lsm_anisotropic_eikonal.h provides solvers for the anisotropic
+ * Eikonal equation
+ *
+ * \f[
+ *
+ *   \sqrt{ \nabla \phi \cdot D(x) \nabla \phi } = 1
+ *
+ * \f]
+ *
+ * where the speed tensor \f$ D(x) \f$ is a symmetric, positive definite
+ * matrix that may vary from grid point to grid point.  \f$ \phi \f$ is
+ * the first arrival time of a front whose speed in the (unit) direction
+ * \f$ a \f$ is \f$ 1/\sqrt{a^T D^{-1} a} \f$.  For \f$ D = F^2 I \f$, the
+ * equation reduces to the isotropic Eikonal equation
+ * \f$ |\nabla \phi| F = 1 \f$ solved by solveEikonalEquation2d() and
+ * solveEikonalEquation3d(); for a constant speed tensor and a point
+ * source at the origin, the solution is
+ * \f$ \phi(x) = \sqrt{x^T D^{-1} x} \f$.
+ *
+ * Because the characteristics of the anisotropic equation are not
+ * aligned with the gradient of the solution, the upwind ordering used
+ * by the Fast Marching Method does not apply.  Instead, the equation
+ * is solved using the Lax-Friedrichs fast sweeping method (Kao, Osher
+ * and Qian, J. Comput. Phys. 196 (2004) 367-391): the grid points are
+ * updated in place (Gauss-Seidel fashion) in each of the 2^(num_dims)
+ * alternating orderings of the grid until the solution stops changing.
+ * Each update uses the first-order Lax-Friedrichs discretization
+ *
+ * \f[
+ *
+ *   \phi_{new} = \frac{ 1 - H(p) + \sum_d \sigma_d
+ *                       (\phi_{d+} + \phi_{d-})/(2 \Delta x_d) }
+ *                     { \sum_d \sigma_d / \Delta x_d }
+ *
+ * \f]
+ *
+ * where \f$ p \f$ is the central difference approximation to
+ * \f$ \nabla \phi \f$, \f$ \sigma_d = \sqrt{D_{dd}} \f$ and the value
+ * of \f$ \phi \f$ at a grid point is only decreased by an update.
+ * Grid points that have not yet been reached and neighbors that are
+ * masked out are assigned a large value (so obstacles are avoided);
+ * neighbors outside of the grid are linearly extrapolated from the
+ * interior of the grid.  Grid points whose neighbors have not changed since their
+ * last update are skipped during a sweep.
+ *
+ * The scheme is first-order accurate but more diffusive than the Fast
+ * Marching Method, especially near kinks in the solution (e.g. at
+ * point sources and corners of obstacles).  For point sources, the
+ * accuracy is considerably improved by initializing phi in a small
+ * neighborhood of the source (a few grid cells wide).  The number of
+ * iterations required for convergence depends on the anisotropy of
+ * the speed tensor and the geometry of the domain, but not strongly
+ * on the size of the grid (typically 20-80 iterations for open
+ * domains).
+ *
+ * The speed tensor is passed as an array of pointers to the
+ * independent components of \f$ D \f$, each of which is a data array
+ * with the same index space extents as phi:
+ *
+ * - 2d:  D_xx, D_xy, D_yy
+ * - 3d:  D_xx, D_xy, D_xz, D_yy, D_yz, D_zz
+ *
+ */
+
+
+/*!
+ * Error codes returned by the anisotropic Eikonal equation solvers.
+ */
+#define LSM_ANISOTROPIC_EIKONAL_ERR_SUCCESS                  (0)
+#define LSM_ANISOTROPIC_EIKONAL_ERR_INVALID_ARGUMENT         (1)
+#define LSM_ANISOTROPIC_EIKONAL_ERR_MEMORY_ALLOCATION        (2)
+#define LSM_ANISOTROPIC_EIKONAL_ERR_NOT_CONVERGED            (3)
+
+/*!
+ * Default values for the tolerance and maximum number of iterations
+ * used by the anisotropic Eikonal equation solvers.
+ */
+#define LSM_ANISOTROPIC_EIKONAL_DEFAULT_TOLERANCE            (1.0e-6)
+#define LSM_ANISOTROPIC_EIKONAL_DEFAULT_MAX_ITERATIONS       (1000)
+
+
+/*!
+ * solveAnisotropicEikonalEquation2d() solves the anisotropic Eikonal
+ * equation \f$ \sqrt{ \nabla \phi \cdot D \nabla \phi } = 1 \f$ in two
+ * space dimensions using the Lax-Friedrichs fast sweeping method.
+ *
+ * Arguments:
+ *  - phi (in/out):           pointer to solution to the anisotropic
+ *                            Eikonal equation; phi must be initialized
+ *                            as for solveEikonalEquation2d() (see NOTES)
+ *  - speed_tensor (in):      array of pointers to the components of
+ *                            the speed tensor (D_xx, D_xy, D_yy)
+ *  - mask (in):              mask for domain of problem; grid points
+ *                            outside of the domain of the problem
+ *                            should be set to a negative value
+ *  - tolerance (in):         the iteration stops when no value of phi
+ *                            changes by more than tolerance during an
+ *                            iteration
+ *  - max_iterations (in):    maximum number of iterations (each
+ *                            iteration consists of one sweep in each of
+ *                            the four orderings of the grid)
+ *  - num_iterations (out):   number of iterations performed (ignored
+ *                            if NULL)
+ *  - grid_dims (in):         array of index space extents for all
+ *                            fields
+ *  - dx (in):                array of grid cell sizes in each
+ *                            coordinate direction
+ *
+ * Return value:              error code (LSM_ANISOTROPIC_EIKONAL_ERR_*)
+ *
+ * NOTES:
+ *  - phi MUST be initialized so that the values for phi at grid points
+ *    on or adjacent to the boundary of the domain for the Eikonal
+ *    equation are correctly set (these values are not changed).  All
+ *    other grid points should be set to have negative values for phi.
+ *
+ *  - For grid points that are masked out, that have a speed tensor
+ *    that is not positive definite or that cannot be reached from the
+ *    boundary of the domain, phi is set to LSMLIB_REAL_MAX.
+ *
+ *  - If the iteration does not converge within max_iterations
+ *    iterations, phi contains the result of the last iteration and
+ *    LSM_ANISOTROPIC_EIKONAL_ERR_NOT_CONVERGED is returned.
+ *
+ *  - If mask is set to a NULL pointer, then all grid points are treated
+ *    as being in the interior of the domain.
+ *
+ */
+int solveAnisotropicEikonalEquation2d(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL **speed_tensor,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL tolerance,
+  int max_iterations,
+  int *num_iterations,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * solveAnisotropicEikonalEquation3d() solves the anisotropic Eikonal
+ * equation \f$ \sqrt{ \nabla \phi \cdot D \nabla \phi } = 1 \f$ in three
+ * space dimensions using the Lax-Friedrichs fast sweeping method.
+ *
+ * Arguments:
+ *  - speed_tensor (in):      array of pointers to the components of
+ *                            the speed tensor (D_xx, D_xy, D_xz, D_yy,
+ *                            D_yz, D_zz)
+ *  - max_iterations (in):    maximum number of iterations (each
+ *                            iteration consists of one sweep in each of
+ *                            the eight orderings of the grid)
+ *  - all other arguments:    see solveAnisotropicEikonalEquation2d()
+ *
+ * Return value:              error code (LSM_ANISOTROPIC_EIKONAL_ERR_*)
+ *
+ * NOTES:
+ *  - See solveAnisotropicEikonalEquation2d().
+ *
+ */
+int solveAnisotropicEikonalEquation3d(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL **speed_tensor,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL tolerance,
+  int max_iterations,
+  int *num_iterations,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
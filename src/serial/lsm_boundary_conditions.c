@@ -12,6 +12,31 @@
 #include "lsm_boundary_conditions.h"
 #include "lsm_boundary_conditions2d.h"
 #include "lsm_boundary_conditions3d.h"
+#include "lsm_instrumentation.h"
+
+
+/*============================= Constants ===========================*/
+
+/*================== Helper Functions Declarations ==================*/
+
+#ifdef LSMLIB_ENABLE_INSTRUMENTATION
+
+/*
+ * LSM_BC_numGhostCellsFilled() returns the number of ghostcells filled
+ * when imposing a boundary condition at the boundary locations 
+ * specified by bdry_location_idx.  The ghostcells at a boundary 
+ * location are the grid points of the ghostbox beyond the fillbox 
+ * (use_fillbox = 1) or the interior of the grid (use_fillbox = 0) in 
+ * the direction normal to the boundary.  It is used as the number of 
+ * grid points updated when recording boundary condition calculations 
+ * with the instrumentation layer.
+ */
+static double LSM_BC_numGhostCellsFilled(
+  Grid *grid,
+  int bdry_location_idx,
+  int use_fillbox);
+
+#endif
 
 
 /*============= Function definitions for boundary conditions ==============*/
@@ -22,6 +47,8 @@ void linearExtrapolationBC(
   int bdry_location_idx)
 {
   int num_dims = grid->num_dims;
+  LSM_INSTRUMENTATION_START(t_start);
+
   if (num_dims == 2) {
 
     switch (bdry_location_idx) { 
@@ -300,6 +327,12 @@ void linearExtrapolationBC(
 
   } /* end switch on num_dims */
 
+  /* each ghostcell is written using values from the interior of */
+  /* the grid (for extrapolation in the normal direction)        */
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_GHOST_FILL, t_start,
+    3*LSM_BC_numGhostCellsFilled(grid, bdry_location_idx, 1)
+     *sizeof(LSMLIB_REAL),
+    LSM_BC_numGhostCellsFilled(grid, bdry_location_idx, 1));
 }
 
 
@@ -309,6 +342,8 @@ void signedLinearExtrapolationBC(
   int bdry_location_idx)
 {
   int num_dims = grid->num_dims;
+  LSM_INSTRUMENTATION_START(t_start);
+
   if (num_dims == 2) {
 
     switch (bdry_location_idx) { 
@@ -587,6 +622,12 @@ void signedLinearExtrapolationBC(
 
   } /* end switch on num_dims */
 
+  /* each ghostcell is written using values from the interior of */
+  /* the grid (for extrapolation in the normal direction)        */
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_GHOST_FILL, t_start,
+    3*LSM_BC_numGhostCellsFilled(grid, bdry_location_idx, 1)
+     *sizeof(LSMLIB_REAL),
+    LSM_BC_numGhostCellsFilled(grid, bdry_location_idx, 1));
 }
  
    
@@ -596,6 +637,8 @@ void copyExtrapolationBC(
   int bdry_location_idx)
 {
   int num_dims = grid->num_dims;
+  LSM_INSTRUMENTATION_START(t_start);
+
   if (num_dims == 2) {
 
     switch (bdry_location_idx) { 
@@ -874,6 +917,12 @@ void copyExtrapolationBC(
 
   } /* end switch on num_dims */
 
+  /* each ghostcell is written using values from the interior of */
+  /* the grid (for extrapolation in the normal direction)        */
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_GHOST_FILL, t_start,
+    3*LSM_BC_numGhostCellsFilled(grid, bdry_location_idx, 1)
+     *sizeof(LSMLIB_REAL),
+    LSM_BC_numGhostCellsFilled(grid, bdry_location_idx, 1));
 }
 
 
@@ -884,3 +933,124 @@ void homogeneousNeumannBC(
 {
   copyExtrapolationBC(phi, grid, bdry_location_idx);
 }
+
+
+void periodicBC(
+  LSMLIB_REAL *phi,
+  Grid *grid,
+  int bdry_location_idx)
+{
+  int num_dims = grid->num_dims;
+  int bdry_location_idx_list[6];
+  int num_bdry_locations = 0;
+  int ilo_int, ihi_int, jlo_int, jhi_int, klo_int, khi_int;
+  int idx;
+  LSM_INSTRUMENTATION_START(t_start);
+
+  /* index space for interior of grid (one period in each direction) */
+  ilo_int = grid->ilo_gb 
+          + (grid->grid_dims_ghostbox[0] - grid->grid_dims[0])/2;
+  ihi_int = ilo_int + grid->grid_dims[0] - 1;
+  jlo_int = grid->jlo_gb 
+          + (grid->grid_dims_ghostbox[1] - grid->grid_dims[1])/2;
+  jhi_int = jlo_int + grid->grid_dims[1] - 1;
+  klo_int = grid->klo_gb 
+          + (grid->grid_dims_ghostbox[2] - grid->grid_dims[2])/2;
+  khi_int = klo_int + grid->grid_dims[2] - 1;
+
+  /* expand bdry_location_idx into list of single boundary locations */
+  if ( (bdry_location_idx >= 0) && (bdry_location_idx < 2*num_dims) ) {
+    bdry_location_idx_list[num_bdry_locations++] = bdry_location_idx;
+  } else if ( (bdry_location_idx >= X_LO_AND_X_HI) && 
+              (bdry_location_idx < X_LO_AND_X_HI + num_dims) ) {
+    idx = 2*(bdry_location_idx - X_LO_AND_X_HI);
+    bdry_location_idx_list[num_bdry_locations++] = idx;
+    bdry_location_idx_list[num_bdry_locations++] = idx+1;
+  } else if (bdry_location_idx == ALL_BOUNDARIES) {
+    for (idx = 0; idx < 2*num_dims; idx++) {
+      bdry_location_idx_list[num_bdry_locations++] = idx;
+    }
+  }
+
+  for (idx = 0; idx < num_bdry_locations; idx++) {
+    if (num_dims == 2) {
+      LSM2D_PERIODIC(
+        phi,
+        &(grid->ilo_gb), &(grid->ihi_gb), 
+        &(grid->jlo_gb), &(grid->jhi_gb), 
+        &ilo_int, &ihi_int, 
+        &jlo_int, &jhi_int, 
+        &(bdry_location_idx_list[idx]));
+    } else if (num_dims == 3) {
+      LSM3D_PERIODIC(
+        phi,
+        &(grid->ilo_gb), &(grid->ihi_gb), 
+        &(grid->jlo_gb), &(grid->jhi_gb), 
+        &(grid->klo_gb), &(grid->khi_gb), 
+        &ilo_int, &ihi_int, 
+        &jlo_int, &jhi_int, 
+        &klo_int, &khi_int, 
+        &(bdry_location_idx_list[idx]));
+    }
+  }
+
+  /* each ghostcell is copied from a single grid cell */
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_GHOST_FILL, t_start,
+    2*LSM_BC_numGhostCellsFilled(grid, bdry_location_idx, 0)
+     *sizeof(LSMLIB_REAL),
+    LSM_BC_numGhostCellsFilled(grid, bdry_location_idx, 0));
+}
+
+
+/*================== Helper Functions Definitions ===================*/
+
+#ifdef LSMLIB_ENABLE_INSTRUMENTATION
+
+static double LSM_BC_numGhostCellsFilled(
+  Grid *grid,
+  int bdry_location_idx,
+  int use_fillbox)
+{
+  int num_dims = grid->num_dims;
+  int lo_gb[3], hi_gb[3], lo[3], hi[3];
+  double num_ghost_cells = 0.0;
+  double num_face_pts;
+  int bdry_idx, dir, d;
+
+  lo_gb[0] = grid->ilo_gb; hi_gb[0] = grid->ihi_gb;
+  lo_gb[1] = grid->jlo_gb; hi_gb[1] = grid->jhi_gb;
+  lo_gb[2] = grid->klo_gb; hi_gb[2] = grid->khi_gb;
+  if (use_fillbox) {
+    lo[0] = grid->ilo_fb; hi[0] = grid->ihi_fb;
+    lo[1] = grid->jlo_fb; hi[1] = grid->jhi_fb;
+    lo[2] = grid->klo_fb; hi[2] = grid->khi_fb;
+  } else {
+    for (d = 0; d < num_dims; d++) {
+      lo[d] = lo_gb[d] 
+            + (grid->grid_dims_ghostbox[d] - grid->grid_dims[d])/2;
+      hi[d] = lo[d] + grid->grid_dims[d] - 1;
+    }
+  }
+
+  for (bdry_idx = 0; bdry_idx < 2*num_dims; bdry_idx++) {
+
+    /* skip boundary locations that are not filled */
+    dir = bdry_idx/2;
+    if ( (bdry_location_idx != bdry_idx) &&
+         (bdry_location_idx != X_LO_AND_X_HI + dir) &&
+         (bdry_location_idx != ALL_BOUNDARIES) ) continue;
+
+    /* the ghostcells at each face span the ghostbox in the */
+    /* tangential directions                                */
+    num_face_pts = (bdry_idx % 2 == 0) ? lo[dir] - lo_gb[dir]
+                                       : hi_gb[dir] - hi[dir];
+    for (d = 0; d < num_dims; d++) {
+      if (d != dir) num_face_pts *= grid->grid_dims_ghostbox[d];
+    }
+    num_ghost_cells += num_face_pts;
+  }
+
+  return num_ghost_cells;
+}
+
+#endif
@@ -27,7 +27,8 @@ extern "C" {
  * @ref lsm_boundary_conditions.h provides support for filling 
  * ghostcells to impose several common level set method boundary 
  * conditions in two- and three-dimensions.  Support is provided 
- * for extrapolation and homogeneous Neumann boundary conditions.
+ * for extrapolation, homogeneous Neumann and periodic boundary 
+ * conditions.
  * Boundary conditions are imposed by filling ghostcells outside 
  * of the computational domain in such a way that they produce
  * the desired boundary condition.  
@@ -176,6 +177,35 @@ void homogeneousNeumannBC(
   int bdry_location_idx);
 
 
+/*!
+ * periodicBC() fills the ghostcells at the specified boundary 
+ * location(s) with data from the opposite side of the interior of
+ * the computational domain (periodic boundary conditions).
+ * 
+ * Arguments:
+ *  - phi (in/out):            grid function for which to set ghostcells
+ *  - grid (in):               pointer to Grid data structure
+ *  - bdry_location_idx (in):  boundary location index
+ *      
+ * Return value:               none
+ *
+ * NOTES:
+ *  - The period of phi in each coordinate direction is the number of 
+ *    grid cells in the interior of the computational domain 
+ *    (grid->grid_dims), which may differ from the size of the fillbox.
+ *
+ *  - Ghostcells at the edges and corners of the ghostbox are filled 
+ *    correctly when periodic boundary conditions are imposed in the 
+ *    lower coordinate directions first (e.g. bdry_location_idx = 
+ *    ALL_BOUNDARIES).
+ *      
+ */
+void periodicBC(
+  LSMLIB_REAL *phi,
+  Grid *grid,
+  int bdry_location_idx);
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,351 @@
+/*
+ * File:        lsm_curvature_flow.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for semi-implicit (AOS) mean curvature
+ *              flow time stepping for serial calculations
+ */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "lsm_curvature_flow.h"
+#include "lsm_instrumentation.h"
+
+
+/*============================= Constants ===========================*/
+
+/*
+ * LSM_CURVATURE_FLOW_GRAD_EPS is the regularization parameter used
+ * when computing 1/|grad(phi)|.  Since phi is typically close to a
+ * signed distance function, a fixed value (relative to 1) suffices.
+ */
+#define LSM_CURVATURE_FLOW_GRAD_EPS    (1.0e-3)
+
+/*
+ * LSM_CURVATURE_FLOW_IS_UPDATED() determines whether the grid point
+ * with the specified array index is updated by the AOS step.
+ */
+#define LSM_CURVATURE_FLOW_IS_UPDATED(narrow_band, idx)                  \
+  ( ((narrow_band) == 0) || ((narrow_band)[(idx)] == 1) )
+
+
+/*================== Helper Functions Declarations ==================*/
+
+/*
+ * computeGradPhiMagnitudeForAOS() computes |grad(phi)| using second-
+ * order central differences at all grid points that are either
+ * updated by the AOS step or are adjacent to such a point.
+ */
+static void computeGradPhiMagnitudeForAOS(
+  LSMLIB_REAL *grad_phi_mag,
+  const LSMLIB_REAL *phi,
+  const unsigned char *narrow_band,
+  const int *lo_fb,
+  const int *hi_fb,
+  const int *stride,
+  const LSMLIB_REAL *dx,
+  int num_dims);
+
+/*
+ * solveTridiagonalSystem() solves the tridiagonal linear system with
+ * the specified lower, main and upper diagonals using the Thomas
+ * algorithm.  The solution is returned in rhs and the contents of
+ * upper are overwritten.
+ */
+static void solveTridiagonalSystem(
+  const LSMLIB_REAL *lower,
+  const LSMLIB_REAL *diag,
+  LSMLIB_REAL *upper,
+  LSMLIB_REAL *rhs,
+  int n);
+
+
+/*==================== Function Definitions =========================*/
+
+int advanceMeanCurvatureFlowAOS(
+  LSMLIB_REAL *phi_next,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *grad_phi_mag,
+  const unsigned char *narrow_band,
+  LSMLIB_REAL b,
+  LSMLIB_REAL dt,
+  Grid *grid)
+{
+  int num_dims = grid->num_dims;
+  int lo_fb[3], hi_fb[3];
+  int stride[3];
+  int dir;
+  int idx;
+  int error_code = LSM_CURVATURE_FLOW_ERR_SUCCESS;
+  LSMLIB_REAL eps_sq = LSM_CURVATURE_FLOW_GRAD_EPS*LSM_CURVATURE_FLOW_GRAD_EPS;
+
+  if ( (num_dims != 2) && (num_dims != 3) ) {
+    return LSM_CURVATURE_FLOW_ERR_INVALID_NUM_DIMS;
+  }
+
+  /* set up index space (the third dimension is trivial in 2D) */
+  lo_fb[0] = grid->ilo_fb;  hi_fb[0] = grid->ihi_fb;
+  lo_fb[1] = grid->jlo_fb;  hi_fb[1] = grid->jhi_fb;
+  stride[0] = 1;
+  stride[1] = grid->grid_dims_ghostbox[0];
+  if (num_dims == 3) {
+    lo_fb[2] = grid->klo_fb;  hi_fb[2] = grid->khi_fb;
+    stride[2] = grid->grid_dims_ghostbox[0]*grid->grid_dims_ghostbox[1];
+  } else {
+    lo_fb[2] = 0;  hi_fb[2] = 0;
+    stride[2] = grid->num_gridpts;
+  }
+
+  /* grid points that are not updated retain their original values */
+  for (idx = 0; idx < grid->num_gridpts; idx++) {
+    phi_next[idx] = phi[idx];
+  }
+
+  /* freeze |grad(phi)| at the beginning of the time step */
+  {
+    LSM_INSTRUMENTATION_START(t_start);
+    computeGradPhiMagnitudeForAOS(grad_phi_mag, phi, narrow_band,
+                                  lo_fb, hi_fb, stride, grid->dx, num_dims);
+    LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_SPATIAL_DERIVATIVES,
+      t_start, 2*grid->num_gridpts*sizeof(LSMLIB_REAL), grid->num_gridpts);
+  }
+
+  /* solve the implicit problem along each coordinate direction */
+  for (dir = 0; dir < num_dims; dir++) {
+
+    /* choose the two directions transverse to the line direction */
+    int dir1 = (dir == 0) ? 1 : 0;
+    int dir2 = (dir == 2) ? 1 : 2;
+    int n1 = hi_fb[dir1] - lo_fb[dir1] + 1;
+    int n2 = hi_fb[dir2] - lo_fb[dir2] + 1;
+    int num_lines = n1*n2;
+    int line_length = hi_fb[dir] - lo_fb[dir] + 1;
+    int s = stride[dir];
+    LSMLIB_REAL tau = num_dims*b*dt/(grid->dx[dir]*grid->dx[dir]);
+    LSMLIB_REAL one_over_num_dims = 1.0/num_dims;
+    LSM_INSTRUMENTATION_START(t_start);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      int line;
+      int idx;
+
+      /* per-thread line scratch space */
+      LSMLIB_REAL *lower = (LSMLIB_REAL*) malloc(4*line_length
+                                                 *sizeof(LSMLIB_REAL));
+      LSMLIB_REAL *diag  = lower + line_length;
+      LSMLIB_REAL *upper = diag + line_length;
+      LSMLIB_REAL *rhs   = upper + line_length;
+
+      if (!lower) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        error_code = LSM_CURVATURE_FLOW_ERR_MEMORY_ALLOCATION_FAILED;
+      }
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+      for (line = 0; line < num_lines; line++) {
+        int i1 = lo_fb[dir1] + line%n1;
+        int i2 = lo_fb[dir2] + line/n1;
+        int idx_line_start = lo_fb[dir]*s + i1*stride[dir1]
+                           + i2*stride[dir2];
+        int run_start, run_end;
+
+        if (!lower) continue;
+
+        run_start = lo_fb[dir];
+        while (run_start <= hi_fb[dir]) {
+          int n, q;
+          int idx_run_start;
+          LSMLIB_REAL g_minus, g_center, g_plus;
+
+          /* find the next run of consecutive grid points to update */
+          idx = idx_line_start + (run_start-lo_fb[dir])*s;
+          if (!LSM_CURVATURE_FLOW_IS_UPDATED(narrow_band, idx)) {
+            run_start++;
+            continue;
+          }
+          idx_run_start = idx;
+          run_end = run_start;
+          while ( (run_end < hi_fb[dir]) &&
+                  LSM_CURVATURE_FLOW_IS_UPDATED(narrow_band, idx+s) ) {
+            run_end++;
+            idx += s;
+          }
+          n = run_end - run_start + 1;
+
+          /* assemble tridiagonal system for the run */
+          idx = idx_run_start;
+          g_minus  = 1.0/sqrt(grad_phi_mag[idx-s]*grad_phi_mag[idx-s]
+                            + eps_sq);
+          g_center = 1.0/sqrt(grad_phi_mag[idx]*grad_phi_mag[idx]
+                            + eps_sq);
+          for (q = 0; q < n; q++, idx += s) {
+            LSMLIB_REAL coef_minus, coef_plus;
+
+            g_plus = 1.0/sqrt(grad_phi_mag[idx+s]*grad_phi_mag[idx+s]
+                            + eps_sq);
+            coef_minus = 0.5*tau*grad_phi_mag[idx]*(g_minus+g_center);
+            coef_plus  = 0.5*tau*grad_phi_mag[idx]*(g_center+g_plus);
+
+            lower[q] = -coef_minus;
+            diag[q]  = 1.0 + coef_minus + coef_plus;
+            upper[q] = -coef_plus;
+            rhs[q]   = phi[idx];
+
+            g_minus = g_center;
+            g_center = g_plus;
+          }
+
+          /* move Dirichlet data at the ends of the run to the rhs */
+          rhs[0] -= lower[0]*phi[idx_run_start-s];
+          lower[0] = 0.0;
+          rhs[n-1] -= upper[n-1]*phi[idx_run_start+n*s];
+          upper[n-1] = 0.0;
+
+          solveTridiagonalSystem(lower, diag, upper, rhs, n);
+
+          /* accumulate contribution to AOS average */
+          idx = idx_run_start;
+          for (q = 0; q < n; q++, idx += s) {
+            phi_next[idx] += one_over_num_dims*(rhs[q] - phi[idx]);
+          }
+
+          run_start = run_end + 1;
+
+        } /* end loop over runs */
+      } /* end loop over lines */
+
+      free(lower);
+
+    } /* end parallel region */
+
+    /* the line solves are the time integration stage of the AOS */
+    /* scheme:  phi and |grad(phi)| are read and phi_next is      */
+    /* updated                                                    */
+    LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_TVD_RK_STAGE, t_start,
+      4*grid->num_gridpts*sizeof(LSMLIB_REAL), num_lines*line_length);
+
+    if (error_code != LSM_CURVATURE_FLOW_ERR_SUCCESS) {
+      return error_code;
+    }
+
+  } /* end loop over directions */
+
+  return LSM_CURVATURE_FLOW_ERR_SUCCESS;
+}
+
+
+int advanceMeanCurvatureFlowAOSForDataArrays(
+  LSM_DataArrays *data_arrays,
+  Grid *grid,
+  LSMLIB_REAL b,
+  LSMLIB_REAL dt,
+  int use_narrow_band)
+{
+  const unsigned char *narrow_band =
+    use_narrow_band ? data_arrays->narrow_band : 0;
+
+  return advanceMeanCurvatureFlowAOS(data_arrays->phi_next,
+                                     data_arrays->phi,
+                                     data_arrays->D1,
+                                     narrow_band,
+                                     b, dt, grid);
+}
+
+
+/*==================== Helper Functions Definitions =================*/
+
+static void computeGradPhiMagnitudeForAOS(
+  LSMLIB_REAL *grad_phi_mag,
+  const LSMLIB_REAL *phi,
+  const unsigned char *narrow_band,
+  const int *lo_fb,
+  const int *hi_fb,
+  const int *stride,
+  const LSMLIB_REAL *dx,
+  int num_dims)
+{
+  LSMLIB_REAL inv_2dx[3];
+  int lo[3], hi[3];
+  int dir, k;
+
+  /* include the first layer of ghostcells along each direction */
+  for (dir = 0; dir < 3; dir++) {
+    if (dir < num_dims) {
+      lo[dir] = lo_fb[dir] - 1;
+      hi[dir] = hi_fb[dir] + 1;
+      inv_2dx[dir] = 0.5/dx[dir];
+    } else {
+      lo[dir] = hi[dir] = 0;
+      inv_2dx[dir] = 0.0;
+    }
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (k = lo[2]; k <= hi[2]; k++) {
+    int i, j, l;
+    for (j = lo[1]; j <= hi[1]; j++) {
+      for (i = lo[0]; i <= hi[0]; i++) {
+        int idx = i*stride[0] + j*stride[1] + k*stride[2];
+        LSMLIB_REAL grad_sq = 0.0;
+
+        if (narrow_band) {
+          int use_point = (narrow_band[idx] == 1);
+          for (l = 0; l < num_dims; l++) {
+            if ( (narrow_band[idx+stride[l]] == 1) ||
+                 (narrow_band[idx-stride[l]] == 1) ) {
+              use_point = 1;
+            }
+          }
+          if (!use_point) continue;
+        }
+
+        for (l = 0; l < num_dims; l++) {
+          LSMLIB_REAL phi_s = (phi[idx+stride[l]] - phi[idx-stride[l]])
+                            * inv_2dx[l];
+          grad_sq += phi_s*phi_s;
+        }
+        grad_phi_mag[idx] = sqrt(grad_sq);
+      }
+    }
+  }
+}
+
+
+static void solveTridiagonalSystem(
+  const LSMLIB_REAL *lower,
+  const LSMLIB_REAL *diag,
+  LSMLIB_REAL *upper,
+  LSMLIB_REAL *rhs,
+  int n)
+{
+  int q;
+  LSMLIB_REAL denom;
+
+  /* forward elimination */
+  denom = diag[0];
+  upper[0] /= denom;
+  rhs[0] /= denom;
+  for (q = 1; q < n; q++) {
+    denom = diag[q] - lower[q]*upper[q-1];
+    upper[q] /= denom;
+    rhs[q] = (rhs[q] - lower[q]*rhs[q-1])/denom;
+  }
+
+  /* back substitution */
+  for (q = n-2; q >= 0; q--) {
+    rhs[q] -= upper[q]*rhs[q+1];
+  }
+}
@@ -0,0 +1,157 @@
+/*
+ * File:        lsm_curvature_flow.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for semi-implicit (AOS) mean curvature flow
+ *              time stepping for serial calculations
+ */
+
+#ifndef INCLUDED_LSM_CURVATURE_FLOW_H
+#define INCLUDED_LSM_CURVATURE_FLOW_H
+
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lsm_grid.h"
+#include "lsm_data_arrays.h"
+
+
+/*! \file lsm_curvature_flow.h
+ *
+ * \brief
+ * @ref lsm_curvature_flow.h provides a semi-implicit time step for
+ * the mean curvature term of the level set equation
+ *
+ * \f[
+ *
+ *   \phi_t = b \kappa |\nabla \phi|
+ *          = b |\nabla \phi| \nabla \cdot
+ *            \left( \frac{\nabla \phi}{|\nabla \phi|} \right)
+ *
+ * \f]
+ *
+ * in two- and three-dimensions.  The diffusion coefficients
+ * \f$ |\nabla \phi| \f$ and \f$ 1/|\nabla \phi| \f$ are frozen at
+ * the beginning of the time step and the resulting linear problem
+ * is solved using the additive operator splitting (AOS) scheme
+ *
+ * \f[
+ *
+ *   \phi^{n+1} = \frac{1}{m} \sum_{l=1}^{m}
+ *                \left( I - m \Delta t A_l \right)^{-1} \phi^n,
+ *
+ * \f]
+ *
+ * where \f$ m \f$ is the number of spatial dimensions and \f$ A_l \f$
+ * is the (tridiagonal) discretization of the curvature operator along
+ * the l-th coordinate direction.  Each of the inverses is computed
+ * using independent tridiagonal solves along grid lines.  The scheme
+ * is unconditionally stable in the maximum norm, so the time step
+ * for a curvature-driven problem only needs to satisfy the CFL
+ * condition of the hyperbolic terms (if any).
+ *
+ * Typical usage is to advance the hyperbolic terms of the level set
+ * equation with one of the explicit TVD Runge-Kutta schemes and then
+ * to apply advanceMeanCurvatureFlowAOS() to the result (i.e.
+ * first-order operator splitting).
+ *
+ */
+
+
+/*========================== Error Codes ============================*/
+#define LSM_CURVATURE_FLOW_ERR_SUCCESS                       (0)
+#define LSM_CURVATURE_FLOW_ERR_MEMORY_ALLOCATION_FAILED      (1)
+#define LSM_CURVATURE_FLOW_ERR_INVALID_NUM_DIMS              (2)
+
+
+/*!
+ * advanceMeanCurvatureFlowAOS() advances phi by a single time step
+ * of mean curvature flow using the semi-implicit additive operator
+ * splitting (AOS) scheme.
+ *
+ * Arguments:
+ *  - phi_next (out):      level set function at the end of the time step
+ *  - phi (in):            level set function at the beginning of the
+ *                         time step (ghostcells must be filled)
+ *  - grad_phi_mag (out):  scratch space used to store \f$|\nabla \phi|\f$
+ *                         at the beginning of the time step
+ *  - narrow_band (in):    narrow band array (see
+ *                         LSM3D_DETERMINE_NARROW_BAND()) or NULL;
+ *                         when non-NULL, only level 0 narrow band
+ *                         points (i.e. narrow_band == 1) are updated
+ *  - b (in):              coefficient of the mean curvature term
+ *  - dt (in):             time step
+ *  - grid (in):           pointer to Grid data structure
+ *
+ * Return value:           LSM_CURVATURE_FLOW_ERR_SUCCESS or an error code
+ *
+ * NOTES:
+ *  - phi_next, phi and grad_phi_mag are assumed to be distinct arrays
+ *    of size grid->num_gridpts.
+ *
+ *  - Ghostcell values of phi are used as Dirichlet data at the ends of
+ *    each grid line.  phi_next is set equal to phi in the ghostcells
+ *    and at grid points that are not updated, so boundary conditions
+ *    should be imposed on phi_next after this function returns.
+ *
+ *  - When narrow_band is non-NULL, each maximal run of consecutive
+ *    level 0 narrow band points along a grid line is solved
+ *    independently with the values of phi at the adjacent points
+ *    held fixed.  The narrow band should contain at least one
+ *    additional level (i.e. num_nb_levels >= 2) so that the gradient
+ *    is available at those points.
+ *
+ *  - When LSMLIB is built with OpenMP support, the line solves along
+ *    each coordinate direction are distributed across threads.
+ *
+ */
+int advanceMeanCurvatureFlowAOS(
+  LSMLIB_REAL *phi_next,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *grad_phi_mag,
+  const unsigned char *narrow_band,
+  LSMLIB_REAL b,
+  LSMLIB_REAL dt,
+  Grid *grid);
+
+
+/*!
+ * advanceMeanCurvatureFlowAOSForDataArrays() is a convenience wrapper
+ * around advanceMeanCurvatureFlowAOS() for use with LSM_DataArrays.
+ * It computes data_arrays->phi_next from data_arrays->phi, using
+ * data_arrays->D1 as scratch space.
+ *
+ * Arguments:
+ *  - data_arrays (in/out):   pointer to LSM_DataArrays structure
+ *  - grid (in):              pointer to Grid data structure
+ *  - b (in):                 coefficient of the mean curvature term
+ *  - dt (in):                time step
+ *  - use_narrow_band (in):   flag indicating whether the update should
+ *                            be restricted to data_arrays->narrow_band
+ *
+ * Return value:              LSM_CURVATURE_FLOW_ERR_SUCCESS or an
+ *                            error code
+ *
+ * NOTES:
+ *  - The contents of data_arrays->D1 are overwritten.
+ *
+ */
+int advanceMeanCurvatureFlowAOSForDataArrays(
+  LSM_DataArrays *data_arrays,
+  Grid *grid,
+  LSMLIB_REAL b,
+  LSMLIB_REAL dt,
+  int use_narrow_band);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,823 @@
+/*
+ * File:        lsm_curve_evolution.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for narrow band evolution of curves in
+ *              three space dimensions (codimension-two problems) for
+ *              serial calculations
+ */
+
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+#include "lsm_curve_evolution.h"
+#include "lsm_boundary_conditions.h"
+#include "lsm_instrumentation.h"
+#include "lsm_level_set_evolution3d_local.h"
+#include "lsm_localization3d.h"
+#include "lsm_reinitialization3d_local.h"
+#include "lsm_spatial_derivatives3d_local.h"
+
+
+/*============================= Constants ===========================*/
+
+/* marks for boundary layers of the narrow band (see localization) */
+static const unsigned char s_mark_gb = 127;
+static const unsigned char s_mark_D1 = 126;
+static const unsigned char s_mark_D2 = 125;
+static const unsigned char s_mark_fb = 124;
+
+/* CFL number for pseudo-time steps of the reinitialization and */
+/* orthogonalization equations                                  */
+#define LSM_CURVE_EVOLUTION_PSEUDO_TIME_CFL_NUMBER   (0.5)
+
+/* index space arguments for toolbox kernels */
+#define GB3D(g)  &((g)->ilo_gb), &((g)->ihi_gb), &((g)->jlo_gb), \
+                 &((g)->jhi_gb), &((g)->klo_gb), &((g)->khi_gb)
+#define DX3D(g)  &((g)->dx[0]), &((g)->dx[1]), &((g)->dx[2])
+
+
+/*================== Helper Functions Declarations ==================*/
+
+/*
+ * computeCurveDerivatives() computes the forward and backward HJ ENO
+ * approximations to grad(phi) and grad(psi) in a single pass over
+ * level 0 of the narrow band.
+ */
+static int computeCurveDerivatives(
+  LSM_CurveEvolutionDataArrays *curve_arrays,
+  Grid *grid,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *psi,
+  int spatial_derivative_order);
+
+/*
+ * fillCurveGhostCells() imposes signed linear extrapolation boundary
+ * conditions on num_fields consecutively stored data arrays.
+ */
+static void fillCurveGhostCells(
+  LSMLIB_REAL *data,
+  int num_fields,
+  Grid *grid,
+  int bdry_location_idx);
+
+/*
+ * updateCurveStage() computes a TVD Runge-Kutta stage for num_fields
+ * consecutively stored data arrays at all narrow band points:
+ *
+ *   u_out = alpha*u_cur + (1-alpha)*(u_stage + dt*rhs)
+ *
+ * u_out may be the same array as u_cur or u_stage.
+ */
+static void updateCurveStage(
+  LSM_CurveEvolutionDataArrays *curve_arrays,
+  Grid *grid,
+  LSMLIB_REAL *u_out,
+  const LSMLIB_REAL *u_cur,
+  const LSMLIB_REAL *u_stage,
+  const LSMLIB_REAL *rhs,
+  int num_fields,
+  LSMLIB_REAL alpha,
+  LSMLIB_REAL dt);
+
+/*
+ * computeCurveReinitializationRHS() computes the right-hand sides of
+ * the reinitialization equations for phi and psi.
+ */
+static int computeCurveReinitializationRHS(
+  LSM_CurveEvolutionDataArrays *curve_arrays,
+  Grid *grid,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *psi,
+  int spatial_derivative_order);
+
+/*
+ * computeCurveOrthogonalizationRHS() computes the right-hand side of
+ * the orthogonalization equation for the evolved level set function
+ * (phi if evolved_level_set_fcn is LSM_CURVE_EVOLUTION_PHI; psi
+ * otherwise).
+ */
+static int computeCurveOrthogonalizationRHS(
+  LSM_CurveEvolutionDataArrays *curve_arrays,
+  Grid *grid,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *psi,
+  int evolved_level_set_fcn,
+  int spatial_derivative_order);
+
+
+/*==================== Function Definitions =========================*/
+
+LSM_CurveEvolutionDataArrays *createCurveEvolutionDataArrays(Grid *grid)
+{
+  LSM_CurveEvolutionDataArrays *c;
+  int num_gridpts = grid->num_gridpts;
+  size_t pair_size = 2*((size_t) num_gridpts)*sizeof(LSMLIB_REAL);
+  size_t field_size = num_gridpts*sizeof(LSMLIB_REAL);
+
+  if (grid->num_dims != 3) return NULL;
+
+  c = (LSM_CurveEvolutionDataArrays*)
+    calloc(1, sizeof(LSM_CurveEvolutionDataArrays));
+  if (!c) return NULL;
+
+  /* phi and psi are stored consecutively so that the time */
+  /* integration loops update both in a single pass        */
+  c->phi = (LSMLIB_REAL*) malloc(pair_size);
+  c->phi_stage1 = (LSMLIB_REAL*) malloc(pair_size);
+  c->phi_stage2 = (LSMLIB_REAL*) malloc(pair_size);
+  c->rhs_phi = (LSMLIB_REAL*) calloc(2*((size_t) num_gridpts),
+                                     sizeof(LSMLIB_REAL));
+
+  /* velocity field */
+  c->external_velocity_x = (LSMLIB_REAL*) calloc(num_gridpts,
+                                                 sizeof(LSMLIB_REAL));
+  c->external_velocity_y = (LSMLIB_REAL*) calloc(num_gridpts,
+                                                 sizeof(LSMLIB_REAL));
+  c->external_velocity_z = (LSMLIB_REAL*) calloc(num_gridpts,
+                                                 sizeof(LSMLIB_REAL));
+  c->normal_velocity_phi = (LSMLIB_REAL*) calloc(num_gridpts,
+                                                 sizeof(LSMLIB_REAL));
+  c->normal_velocity_psi = (LSMLIB_REAL*) calloc(num_gridpts,
+                                                 sizeof(LSMLIB_REAL));
+
+  /* one-sided derivatives */
+  c->phi_x_plus = (LSMLIB_REAL*) malloc(field_size);
+  c->phi_y_plus = (LSMLIB_REAL*) malloc(field_size);
+  c->phi_z_plus = (LSMLIB_REAL*) malloc(field_size);
+  c->phi_x_minus = (LSMLIB_REAL*) malloc(field_size);
+  c->phi_y_minus = (LSMLIB_REAL*) malloc(field_size);
+  c->phi_z_minus = (LSMLIB_REAL*) malloc(field_size);
+  c->psi_x_plus = (LSMLIB_REAL*) malloc(field_size);
+  c->psi_y_plus = (LSMLIB_REAL*) malloc(field_size);
+  c->psi_z_plus = (LSMLIB_REAL*) malloc(field_size);
+  c->psi_x_minus = (LSMLIB_REAL*) malloc(field_size);
+  c->psi_y_minus = (LSMLIB_REAL*) malloc(field_size);
+  c->psi_z_minus = (LSMLIB_REAL*) malloc(field_size);
+
+  /* narrow band */
+  c->max_abs_phi_psi = (LSMLIB_REAL*) malloc(field_size);
+  c->narrow_band = (unsigned char*) calloc(num_gridpts,
+                                           sizeof(unsigned char));
+  c->index_x = (int*) malloc(num_gridpts*sizeof(int));
+  c->index_y = (int*) malloc(num_gridpts*sizeof(int));
+  c->index_z = (int*) malloc(num_gridpts*sizeof(int));
+  c->index_outer_pts = (int*) malloc(num_gridpts*sizeof(int));
+  c->update_pts = (int*) malloc(num_gridpts*sizeof(int));
+
+  if ( !c->phi || !c->phi_stage1 || !c->phi_stage2 || !c->rhs_phi ||
+       !c->external_velocity_x || !c->external_velocity_y ||
+       !c->external_velocity_z || !c->normal_velocity_phi ||
+       !c->normal_velocity_psi ||
+       !c->phi_x_plus || !c->phi_y_plus || !c->phi_z_plus ||
+       !c->phi_x_minus || !c->phi_y_minus || !c->phi_z_minus ||
+       !c->psi_x_plus || !c->psi_y_plus || !c->psi_z_plus ||
+       !c->psi_x_minus || !c->psi_y_minus || !c->psi_z_minus ||
+       !c->max_abs_phi_psi || !c->narrow_band || !c->index_x ||
+       !c->index_y || !c->index_z || !c->index_outer_pts ||
+       !c->update_pts ) {
+    destroyCurveEvolutionDataArrays(c);
+    return NULL;
+  }
+
+  c->psi = c->phi + num_gridpts;
+  c->psi_stage1 = c->phi_stage1 + num_gridpts;
+  c->psi_stage2 = c->phi_stage2 + num_gridpts;
+  c->rhs_psi = c->rhs_phi + num_gridpts;
+
+  /* the narrow band is empty until it is built */
+  c->n_lo[0] = 0;
+  c->n_hi[0] = -1;
+  c->num_update_pts = 0;
+
+  return c;
+}
+
+
+void destroyCurveEvolutionDataArrays(
+  LSM_CurveEvolutionDataArrays *curve_arrays)
+{
+  LSM_CurveEvolutionDataArrays *c = curve_arrays;
+  if (!c) return;
+
+  /* psi, psi_stage1, psi_stage2 and rhs_psi are not separately */
+  /* allocated                                                  */
+  free(c->phi);
+  free(c->phi_stage1);
+  free(c->phi_stage2);
+  free(c->rhs_phi);
+  free(c->external_velocity_x);
+  free(c->external_velocity_y);
+  free(c->external_velocity_z);
+  free(c->normal_velocity_phi);
+  free(c->normal_velocity_psi);
+  free(c->phi_x_plus);
+  free(c->phi_y_plus);
+  free(c->phi_z_plus);
+  free(c->phi_x_minus);
+  free(c->phi_y_minus);
+  free(c->phi_z_minus);
+  free(c->psi_x_plus);
+  free(c->psi_y_plus);
+  free(c->psi_z_plus);
+  free(c->psi_x_minus);
+  free(c->psi_y_minus);
+  free(c->psi_z_minus);
+  free(c->max_abs_phi_psi);
+  free(c->narrow_band);
+  free(c->index_x);
+  free(c->index_y);
+  free(c->index_z);
+  free(c->index_outer_pts);
+  free(c->update_pts);
+  free(c);
+}
+
+
+void determineCurveEvolutionNarrowBand(
+  LSM_CurveEvolutionDataArrays *curve_arrays,
+  Grid *grid,
+  LSMLIB_REAL beta,
+  LSMLIB_REAL gamma)
+{
+  LSM_CurveEvolutionDataArrays *c = curve_arrays;
+  int num_gridpts = grid->num_gridpts;
+  int nlo_index = 0, nhi_index = num_gridpts - 1;
+  int nlo_index_outer = 0, nhi_index_outer = num_gridpts - 1;
+  int level = LSM_CURVE_EVOLUTION_NUM_NB_LEVELS;
+  int nx = grid->grid_dims_ghostbox[0];
+  int nxy = nx*grid->grid_dims_ghostbox[1];
+  int idx, n;
+  LSM_INSTRUMENTATION_START(t_start);
+
+  c->beta = beta;
+  c->gamma = gamma;
+
+  /* the intersection of the narrow bands of phi and psi is the */
+  /* narrow band of max(|phi|,|psi|)                            */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (idx = 0; idx < num_gridpts; idx++) {
+    LSMLIB_REAL abs_phi = fabs(c->phi[idx]);
+    LSMLIB_REAL abs_psi = fabs(c->psi[idx]);
+    c->max_abs_phi_psi[idx] = (abs_phi > abs_psi) ? abs_phi : abs_psi;
+  }
+
+  LSM3D_DETERMINE_NARROW_BAND(c->max_abs_phi_psi, GB3D(grid),
+    c->narrow_band, GB3D(grid),
+    c->index_x, c->index_y, c->index_z,
+    &nlo_index, &nhi_index,
+    c->n_lo, c->n_hi,
+    c->index_outer_pts,
+    &nlo_index_outer, &nhi_index_outer,
+    &(c->nlo_outer_plus), &(c->nhi_outer_plus),
+    &(c->nlo_outer_minus), &(c->nhi_outer_minus),
+    &gamma, &beta, &level);
+
+  LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER(c->narrow_band, GB3D(grid),
+    &(grid->ilo_D2_fb), &(grid->ihi_D2_fb),
+    &(grid->jlo_D2_fb), &(grid->jhi_D2_fb),
+    &(grid->klo_D2_fb), &(grid->khi_D2_fb),
+    &s_mark_D2);
+  LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER(c->narrow_band, GB3D(grid),
+    &(grid->ilo_D1_fb), &(grid->ihi_D1_fb),
+    &(grid->jlo_D1_fb), &(grid->jhi_D1_fb),
+    &(grid->klo_D1_fb), &(grid->khi_D1_fb),
+    &s_mark_D1);
+  LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER(c->narrow_band, GB3D(grid),
+    GB3D(grid),
+    &s_mark_gb);
+
+  /* the time integration loops cover all levels of the narrow band */
+  c->num_update_pts = 0;
+  if (c->n_hi[0] >= c->n_lo[0]) {
+    for (n = c->n_lo[0]; n <= c->n_hi[level]; n++) {
+      c->update_pts[c->num_update_pts++] =
+        (c->index_x[n] - grid->ilo_gb) + (c->index_y[n] - grid->jlo_gb)*nx
+      + (c->index_z[n] - grid->klo_gb)*nxy;
+    }
+  }
+
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_NARROW_BAND_REBUILD,
+    t_start, 4.0*num_gridpts*sizeof(LSMLIB_REAL), num_gridpts);
+}
+
+
+LSMLIB_REAL computeCurveEvolutionStableDt(
+  LSM_CurveEvolutionDataArrays *curve_arrays,
+  Grid *grid,
+  LSMLIB_REAL cfl_number)
+{
+  LSM_CurveEvolutionDataArrays *c = curve_arrays;
+  LSMLIB_REAL inv_dx = 1.0/grid->dx[0];
+  LSMLIB_REAL inv_dy = 1.0/grid->dx[1];
+  LSMLIB_REAL inv_dz = 1.0/grid->dx[2];
+  LSMLIB_REAL inv_dx_norm = sqrt(inv_dx*inv_dx + inv_dy*inv_dy
+                               + inv_dz*inv_dz);
+  LSMLIB_REAL max_H = 0.0;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    LSMLIB_REAL max_H_local = 0.0;
+    int n_local;
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (n_local = 0; n_local < c->num_update_pts; n_local++) {
+      int idx = c->update_pts[n_local];
+      LSMLIB_REAL vel_n_phi = fabs(c->normal_velocity_phi[idx]);
+      LSMLIB_REAL vel_n_psi = fabs(c->normal_velocity_psi[idx]);
+      LSMLIB_REAL H = fabs(c->external_velocity_x[idx])*inv_dx
+                    + fabs(c->external_velocity_y[idx])*inv_dy
+                    + fabs(c->external_velocity_z[idx])*inv_dz
+                    + ((vel_n_phi > vel_n_psi) ? vel_n_phi : vel_n_psi)
+                      *inv_dx_norm;
+      if (H > max_H_local) max_H_local = H;
+    }
+
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+    {
+      if (max_H_local > max_H) max_H = max_H_local;
+    }
+  }
+
+  return (max_H > 0) ? cfl_number/max_H : LSMLIB_REAL_MAX;
+}
+
+
+int computeCurveEvolutionEqnRHS(
+  LSM_CurveEvolutionDataArrays *curve_arrays,
+  Grid *grid,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *psi,
+  int spatial_derivative_order)
+{
+  LSM_CurveEvolutionDataArrays *c = curve_arrays;
+  int error_code;
+  int n;
+  LSM_INSTRUMENTATION_START(t_start);
+
+  error_code = computeCurveDerivatives(c, grid, phi, psi,
+                                       spatial_derivative_order);
+  if (error_code != LSM_CURVE_EVOLUTION_ERR_SUCCESS) return error_code;
+
+  /* zero the right-hand sides and update the distance from the */
+  /* curve used by the cut-off function                         */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (n = 0; n < c->num_update_pts; n++) {
+    int idx = c->update_pts[n];
+    LSMLIB_REAL abs_phi = fabs(phi[idx]);
+    LSMLIB_REAL abs_psi = fabs(psi[idx]);
+    c->max_abs_phi_psi[idx] = (abs_phi > abs_psi) ? abs_phi : abs_psi;
+    c->rhs_phi[idx] = 0.0;
+    c->rhs_psi[idx] = 0.0;
+  }
+
+  LSM3D_ADD_EXTERNAL_AND_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL(
+    c->rhs_phi, GB3D(grid),
+    c->phi_x_plus, c->phi_y_plus, c->phi_z_plus, GB3D(grid),
+    c->phi_x_minus, c->phi_y_minus, c->phi_z_minus, GB3D(grid),
+    c->normal_velocity_phi,
+    c->external_velocity_x, c->external_velocity_y,
+    c->external_velocity_z, GB3D(grid),
+    c->index_x, c->index_y, c->index_z,
+    &(c->n_lo[0]), &(c->n_hi[0]),
+    c->narrow_band, GB3D(grid),
+    &s_mark_fb);
+  LSM3D_ADD_EXTERNAL_AND_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL(
+    c->rhs_psi, GB3D(grid),
+    c->psi_x_plus, c->psi_y_plus, c->psi_z_plus, GB3D(grid),
+    c->psi_x_minus, c->psi_y_minus, c->psi_z_minus, GB3D(grid),
+    c->normal_velocity_psi,
+    c->external_velocity_x, c->external_velocity_y,
+    c->external_velocity_z, GB3D(grid),
+    c->index_x, c->index_y, c->index_z,
+    &(c->n_lo[0]), &(c->n_hi[0]),
+    c->narrow_band, GB3D(grid),
+    &s_mark_fb);
+
+  /* cut-off based on the distance from the curve (rather than from */
+  /* the zero level set of each function) so that both functions    */
+  /* are frozen at the boundary of the tube                         */
+  LSM3D_MULTIPLY_CUT_OFF_LSE_RHS_LOCAL(c->max_abs_phi_psi, c->rhs_phi,
+    GB3D(grid),
+    c->index_x, c->index_y, c->index_z,
+    &(c->n_lo[0]), &(c->n_hi[0]),
+    c->narrow_band, GB3D(grid),
+    &s_mark_fb,
+    &(c->beta), &(c->gamma));
+  LSM3D_MULTIPLY_CUT_OFF_LSE_RHS_LOCAL(c->max_abs_phi_psi, c->rhs_psi,
+    GB3D(grid),
+    c->index_x, c->index_y, c->index_z,
+    &(c->n_lo[0]), &(c->n_hi[0]),
+    c->narrow_band, GB3D(grid),
+    &s_mark_fb,
+    &(c->beta), &(c->gamma));
+
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_RHS, t_start,
+    2.0*(2.0 + 3*3 + 2)*c->num_update_pts*sizeof(LSMLIB_REAL),
+    2*c->num_update_pts);
+
+  return LSM_CURVE_EVOLUTION_ERR_SUCCESS;
+}
+
+
+int advanceCurveLevelSetsTVDRK(
+  LSM_CurveEvolutionDataArrays *curve_arrays,
+  Grid *grid,
+  LSMLIB_REAL dt,
+  int tvd_rk_order,
+  int spatial_derivative_order,
+  int bdry_location_idx)
+{
+  LSM_CurveEvolutionDataArrays *c = curve_arrays;
+  int error_code;
+
+  if ( (tvd_rk_order < 1) || (tvd_rk_order > 3) ) {
+    return LSM_CURVE_EVOLUTION_ERR_INVALID_TVD_RK_ORDER;
+  }
+
+  /* stage 1 (forward Euler step) */
+  fillCurveGhostCells(c->phi, 2, grid, bdry_location_idx);
+  error_code = computeCurveEvolutionEqnRHS(c, grid, c->phi, c->psi,
+                                           spatial_derivative_order);
+  if (error_code != LSM_CURVE_EVOLUTION_ERR_SUCCESS) return error_code;
+
+  if (tvd_rk_order == 1) {
+    updateCurveStage(c, grid, c->phi, c->phi, c->phi, c->rhs_phi, 2,
+                     0.0, dt);
+    fillCurveGhostCells(c->phi, 2, grid, bdry_location_idx);
+    return LSM_CURVE_EVOLUTION_ERR_SUCCESS;
+  }
+
+  updateCurveStage(c, grid, c->phi_stage1, c->phi, c->phi, c->rhs_phi, 2,
+                   0.0, dt);
+  fillCurveGhostCells(c->phi_stage1, 2, grid, bdry_location_idx);
+  error_code = computeCurveEvolutionEqnRHS(c, grid,
+                                           c->phi_stage1, c->psi_stage1,
+                                           spatial_derivative_order);
+  if (error_code != LSM_CURVE_EVOLUTION_ERR_SUCCESS) return error_code;
+
+  if (tvd_rk_order == 2) {
+    /* u^{n+1} = 1/2 u^n + 1/2 (u_stage1 + dt*L(u_stage1)) */
+    updateCurveStage(c, grid, c->phi, c->phi, c->phi_stage1, c->rhs_phi, 2,
+                     0.5, dt);
+  } else {
+    /* u_stage2 = 3/4 u^n + 1/4 (u_stage1 + dt*L(u_stage1)) */
+    updateCurveStage(c, grid, c->phi_stage2, c->phi, c->phi_stage1,
+                     c->rhs_phi, 2, 0.75, dt);
+    fillCurveGhostCells(c->phi_stage2, 2, grid, bdry_location_idx);
+    error_code = computeCurveEvolutionEqnRHS(c, grid,
+                                             c->phi_stage2, c->psi_stage2,
+                                             spatial_derivative_order);
+    if (error_code != LSM_CURVE_EVOLUTION_ERR_SUCCESS) return error_code;
+
+    /* u^{n+1} = 1/3 u^n + 2/3 (u_stage2 + dt*L(u_stage2)) */
+    updateCurveStage(c, grid, c->phi, c->phi, c->phi_stage2, c->rhs_phi, 2,
+                     1.0/3.0, dt);
+  }
+
+  fillCurveGhostCells(c->phi, 2, grid, bdry_location_idx);
+
+  return LSM_CURVE_EVOLUTION_ERR_SUCCESS;
+}
+
+
+int reinitializeCurveLevelSets(
+  LSM_CurveEvolutionDataArrays *curve_arrays,
+  Grid *grid,
+  int num_iterations,
+  int spatial_derivative_order,
+  int bdry_location_idx)
+{
+  LSM_CurveEvolutionDataArrays *c = curve_arrays;
+  LSMLIB_REAL dt = LSM_CURVE_EVOLUTION_PSEUDO_TIME_CFL_NUMBER
+                 / (1.0/grid->dx[0] + 1.0/grid->dx[1] + 1.0/grid->dx[2]);
+  int iter;
+  int error_code = LSM_CURVE_EVOLUTION_ERR_SUCCESS;
+  LSM_INSTRUMENTATION_START(t_start);
+
+  /* the signs of phi and psi are frozen at the beginning of */
+  /* reinitialization (phi0 and psi0 are stored in stage2)   */
+  fillCurveGhostCells(c->phi, 2, grid, bdry_location_idx);
+  memcpy(c->phi_stage2, c->phi,
+         2*((size_t) grid->num_gridpts)*sizeof(LSMLIB_REAL));
+
+  for (iter = 0; iter < num_iterations; iter++) {
+    error_code = computeCurveReinitializationRHS(
+      c, grid, c->phi, c->psi, spatial_derivative_order);
+    if (error_code != LSM_CURVE_EVOLUTION_ERR_SUCCESS) break;
+    updateCurveStage(c, grid, c->phi_stage1, c->phi, c->phi, c->rhs_phi, 2,
+                     0.0, dt);
+    fillCurveGhostCells(c->phi_stage1, 2, grid, bdry_location_idx);
+
+    error_code = computeCurveReinitializationRHS(
+      c, grid, c->phi_stage1, c->psi_stage1, spatial_derivative_order);
+    if (error_code != LSM_CURVE_EVOLUTION_ERR_SUCCESS) break;
+    updateCurveStage(c, grid, c->phi, c->phi, c->phi_stage1, c->rhs_phi, 2,
+                     0.5, dt);
+    fillCurveGhostCells(c->phi, 2, grid, bdry_location_idx);
+  }
+
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_REINITIALIZATION, t_start,
+    2.0*num_iterations*2*(3.0 + 2*3)*c->num_update_pts*sizeof(LSMLIB_REAL),
+    2.0*num_iterations*2*c->num_update_pts);
+
+  return error_code;
+}
+
+
+int orthogonalizeCurveLevelSets(
+  LSM_CurveEvolutionDataArrays *curve_arrays,
+  Grid *grid,
+  int evolved_level_set_fcn,
+  int num_iterations,
+  int spatial_derivative_order,
+  int bdry_location_idx)
+{
+  LSM_CurveEvolutionDataArrays *c = curve_arrays;
+  LSMLIB_REAL dt = LSM_CURVE_EVOLUTION_PSEUDO_TIME_CFL_NUMBER
+                 / (1.0/grid->dx[0] + 1.0/grid->dx[1] + 1.0/grid->dx[2]);
+  LSMLIB_REAL *u, *u_stage1, *rhs;
+  int iter;
+  int error_code = LSM_CURVE_EVOLUTION_ERR_SUCCESS;
+  LSM_INSTRUMENTATION_START(t_start);
+
+  if (evolved_level_set_fcn == LSM_CURVE_EVOLUTION_PHI) {
+    u = c->phi;
+    u_stage1 = c->phi_stage1;
+    rhs = c->rhs_phi;
+  } else if (evolved_level_set_fcn == LSM_CURVE_EVOLUTION_PSI) {
+    u = c->psi;
+    u_stage1 = c->psi_stage1;
+    rhs = c->rhs_psi;
+  } else {
+    return LSM_CURVE_EVOLUTION_ERR_INVALID_LEVEL_SET_FCN;
+  }
+
+  /* the fixed level set function is used for all stages */
+  fillCurveGhostCells(c->phi, 2, grid, bdry_location_idx);
+  if (evolved_level_set_fcn == LSM_CURVE_EVOLUTION_PHI) {
+    memcpy(c->psi_stage1, c->psi, grid->num_gridpts*sizeof(LSMLIB_REAL));
+  } else {
+    memcpy(c->phi_stage1, c->phi, grid->num_gridpts*sizeof(LSMLIB_REAL));
+  }
+
+  for (iter = 0; iter < num_iterations; iter++) {
+    error_code = computeCurveOrthogonalizationRHS(
+      c, grid, c->phi, c->psi, evolved_level_set_fcn,
+      spatial_derivative_order);
+    if (error_code != LSM_CURVE_EVOLUTION_ERR_SUCCESS) break;
+    updateCurveStage(c, grid, u_stage1, u, u, rhs, 1, 0.0, dt);
+    fillCurveGhostCells(u_stage1, 1, grid, bdry_location_idx);
+
+    error_code = computeCurveOrthogonalizationRHS(
+      c, grid, c->phi_stage1, c->psi_stage1, evolved_level_set_fcn,
+      spatial_derivative_order);
+    if (error_code != LSM_CURVE_EVOLUTION_ERR_SUCCESS) break;
+    updateCurveStage(c, grid, u, u, u_stage1, rhs, 1, 0.5, dt);
+    fillCurveGhostCells(u, 1, grid, bdry_location_idx);
+  }
+
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_REINITIALIZATION, t_start,
+    2.0*num_iterations*(3.0 + 4*3)*c->num_update_pts*sizeof(LSMLIB_REAL),
+    2.0*num_iterations*c->num_update_pts);
+
+  return error_code;
+}
+
+
+/*==================== Helper Functions Definitions =================*/
+
+static int computeCurveDerivatives(
+  LSM_CurveEvolutionDataArrays *curve_arrays,
+  Grid *grid,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *psi,
+  int spatial_derivative_order)
+{
+  LSM_CurveEvolutionDataArrays *c = curve_arrays;
+  LSM_INSTRUMENTATION_START(t_start);
+
+  switch (spatial_derivative_order) {
+    case 1: {
+      LSM3D_HJ_ENO1_CODIM2_LOCAL(
+        c->phi_x_plus, c->phi_y_plus, c->phi_z_plus,
+        c->phi_x_minus, c->phi_y_minus, c->phi_z_minus,
+        c->psi_x_plus, c->psi_y_plus, c->psi_z_plus,
+        c->psi_x_minus, c->psi_y_minus, c->psi_z_minus,
+        GB3D(grid),
+        phi, psi, GB3D(grid),
+        DX3D(grid),
+        c->index_x, c->index_y, c->index_z,
+        &(c->n_lo[0]), &(c->n_hi[0]),
+        c->narrow_band, GB3D(grid),
+        &s_mark_fb);
+      break;
+    }
+    case 2: {
+      LSM3D_HJ_ENO2_CODIM2_LOCAL(
+        c->phi_x_plus, c->phi_y_plus, c->phi_z_plus,
+        c->phi_x_minus, c->phi_y_minus, c->phi_z_minus,
+        c->psi_x_plus, c->psi_y_plus, c->psi_z_plus,
+        c->psi_x_minus, c->psi_y_minus, c->psi_z_minus,
+        GB3D(grid),
+        phi, psi, GB3D(grid),
+        DX3D(grid),
+        c->index_x, c->index_y, c->index_z,
+        &(c->n_lo[0]), &(c->n_hi[0]),
+        c->narrow_band, GB3D(grid),
+        &s_mark_fb);
+      break;
+    }
+    default: {
+      return LSM_CURVE_EVOLUTION_ERR_INVALID_SPATIAL_DERIVATIVE_ORDER;
+    }
+  }
+
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_SPATIAL_DERIVATIVES,
+    t_start,
+    2.0*(1.0 + 2*3)*(c->n_hi[0] - c->n_lo[0] + 1)*sizeof(LSMLIB_REAL),
+    2*(c->n_hi[0] - c->n_lo[0] + 1));
+
+  return LSM_CURVE_EVOLUTION_ERR_SUCCESS;
+}
+
+
+static void fillCurveGhostCells(
+  LSMLIB_REAL *data,
+  int num_fields,
+  Grid *grid,
+  int bdry_location_idx)
+{
+  int f;
+  for (f = 0; f < num_fields; f++) {
+    signedLinearExtrapolationBC(data + f*grid->num_gridpts, grid,
+                                bdry_location_idx);
+  }
+}
+
+
+static void updateCurveStage(
+  LSM_CurveEvolutionDataArrays *curve_arrays,
+  Grid *grid,
+  LSMLIB_REAL *u_out,
+  const LSMLIB_REAL *u_cur,
+  const LSMLIB_REAL *u_stage,
+  const LSMLIB_REAL *rhs,
+  int num_fields,
+  LSMLIB_REAL alpha,
+  LSMLIB_REAL dt)
+{
+  LSM_CurveEvolutionDataArrays *c = curve_arrays;
+  int num_gridpts = grid->num_gridpts;
+  LSMLIB_REAL one_minus_alpha = 1.0 - alpha;
+  int n;
+  LSM_INSTRUMENTATION_START(t_start);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (n = 0; n < c->num_update_pts; n++) {
+    int idx = c->update_pts[n];
+    int f;
+    for (f = 0; f < num_fields; f++) {
+      int idx_f = f*num_gridpts + idx;
+      u_out[idx_f] = alpha*u_cur[idx_f]
+                   + one_minus_alpha*(u_stage[idx_f] + dt*rhs[idx_f]);
+    }
+  }
+
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_TVD_RK_STAGE, t_start,
+    4.0*num_fields*c->num_update_pts*sizeof(LSMLIB_REAL),
+    num_fields*c->num_update_pts);
+}
+
+
+static int computeCurveReinitializationRHS(
+  LSM_CurveEvolutionDataArrays *curve_arrays,
+  Grid *grid,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *psi,
+  int spatial_derivative_order)
+{
+  LSM_CurveEvolutionDataArrays *c = curve_arrays;
+  int use_phi0_for_sgn = 1;
+  int error_code;
+  int n;
+
+  error_code = computeCurveDerivatives(c, grid, phi, psi,
+                                       spatial_derivative_order);
+  if (error_code != LSM_CURVE_EVOLUTION_ERR_SUCCESS) return error_code;
+
+  /* zero the right-hand sides at all narrow band points (the kernels */
+  /* only set the right-hand sides on level 0 of the narrow band)     */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (n = 0; n < c->num_update_pts; n++) {
+    int idx = c->update_pts[n];
+    c->rhs_phi[idx] = 0.0;
+    c->rhs_psi[idx] = 0.0;
+  }
+
+  LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS_LOCAL(
+    c->rhs_phi, GB3D(grid),
+    phi, GB3D(grid),
+    c->phi_stage2, GB3D(grid),
+    c->phi_x_plus, c->phi_y_plus, c->phi_z_plus, GB3D(grid),
+    c->phi_x_minus, c->phi_y_minus, c->phi_z_minus, GB3D(grid),
+    DX3D(grid),
+    &use_phi0_for_sgn,
+    c->index_x, c->index_y, c->index_z,
+    &(c->n_lo[0]), &(c->n_hi[0]),
+    c->narrow_band, GB3D(grid),
+    &s_mark_fb);
+  LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS_LOCAL(
+    c->rhs_psi, GB3D(grid),
+    psi, GB3D(grid),
+    c->psi_stage2, GB3D(grid),
+    c->psi_x_plus, c->psi_y_plus, c->psi_z_plus, GB3D(grid),
+    c->psi_x_minus, c->psi_y_minus, c->psi_z_minus, GB3D(grid),
+    DX3D(grid),
+    &use_phi0_for_sgn,
+    c->index_x, c->index_y, c->index_z,
+    &(c->n_lo[0]), &(c->n_hi[0]),
+    c->narrow_band, GB3D(grid),
+    &s_mark_fb);
+
+  return LSM_CURVE_EVOLUTION_ERR_SUCCESS;
+}
+
+
+static int computeCurveOrthogonalizationRHS(
+  LSM_CurveEvolutionDataArrays *curve_arrays,
+  Grid *grid,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *psi,
+  int evolved_level_set_fcn,
+  int spatial_derivative_order)
+{
+  LSM_CurveEvolutionDataArrays *c = curve_arrays;
+  LSMLIB_REAL *rhs;
+  int error_code;
+  int n;
+
+  error_code = computeCurveDerivatives(c, grid, phi, psi,
+                                       spatial_derivative_order);
+  if (error_code != LSM_CURVE_EVOLUTION_ERR_SUCCESS) return error_code;
+
+  /* zero the right-hand side at all narrow band points (the kernel */
+  /* only sets the right-hand side on level 0 of the narrow band)   */
+  rhs = (evolved_level_set_fcn == LSM_CURVE_EVOLUTION_PHI) ?
+        c->rhs_phi : c->rhs_psi;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (n = 0; n < c->num_update_pts; n++) {
+    rhs[c->update_pts[n]] = 0.0;
+  }
+
+  if (evolved_level_set_fcn == LSM_CURVE_EVOLUTION_PHI) {
+    LSM3D_COMPUTE_ORTHOGONALIZATION_EQN_RHS_LOCAL(
+      c->rhs_phi, GB3D(grid),
+      c->phi_x_plus, c->phi_y_plus, c->phi_z_plus, GB3D(grid),
+      c->phi_x_minus, c->phi_y_minus, c->phi_z_minus, GB3D(grid),
+      psi, GB3D(grid),
+      c->psi_x_plus, c->psi_y_plus, c->psi_z_plus, GB3D(grid),
+      c->psi_x_minus, c->psi_y_minus, c->psi_z_minus, GB3D(grid),
+      DX3D(grid),
+      c->index_x, c->index_y, c->index_z,
+      &(c->n_lo[0]), &(c->n_hi[0]),
+      c->narrow_band, GB3D(grid),
+      &s_mark_fb);
+  } else {
+    LSM3D_COMPUTE_ORTHOGONALIZATION_EQN_RHS_LOCAL(
+      c->rhs_psi, GB3D(grid),
+      c->psi_x_plus, c->psi_y_plus, c->psi_z_plus, GB3D(grid),
+      c->psi_x_minus, c->psi_y_minus, c->psi_z_minus, GB3D(grid),
+      phi, GB3D(grid),
+      c->phi_x_plus, c->phi_y_plus, c->phi_z_plus, GB3D(grid),
+      c->phi_x_minus, c->phi_y_minus, c->phi_z_minus, GB3D(grid),
+      DX3D(grid),
+      c->index_x, c->index_y, c->index_z,
+      &(c->n_lo[0]), &(c->n_hi[0]),
+      c->narrow_band, GB3D(grid),
+      &s_mark_fb);
+  }
+
+  return LSM_CURVE_EVOLUTION_ERR_SUCCESS;
+}
@@ -0,0 +1,365 @@
+/*
+ * File:        lsm_curve_evolution.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for narrow band evolution of curves in three
+ *              space dimensions (codimension-two problems) for serial
+ *              calculations
+ */
+
+#ifndef INCLUDED_LSM_CURVE_EVOLUTION_H
+#define INCLUDED_LSM_CURVE_EVOLUTION_H
+
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lsm_grid.h"
+
+
+/*! \file lsm_curve_evolution.h
+ *
+ * \brief
+ * @ref lsm_curve_evolution.h provides support for evolving curves in
+ * three space dimensions that are represented as the intersection of
+ * the zero level sets of two level set functions, \f$ \phi \f$ and
+ * \f$ \psi \f$ (i.e. codimension-two problems):
+ *
+ * \f[
+ *
+ *   \phi_t + \vec{V} \cdot \nabla \phi + V_{n,\phi} |\nabla \phi| = 0
+ *   \\
+ *   \psi_t + \vec{V} \cdot \nabla \psi + V_{n,\psi} |\nabla \psi| = 0
+ *
+ * \f]
+ *
+ * Only the values of \f$ \phi \f$ and \f$ \psi \f$ near the curve are
+ * needed, so all calculations (time advance, reinitialization and
+ * orthogonalization) are restricted to the intersection of the narrow
+ * bands of \f$ \phi \f$ and \f$ \psi \f$, i.e. a tube around the curve
+ * defined by \f$ \max(|\phi|, |\psi|) < \gamma \f$.  The tube is
+ * much smaller than the narrow band of either level set function.
+ *
+ * The one-sided derivatives of \f$ \phi \f$ and \f$ \psi \f$ are
+ * computed together in a single pass over the tube (see
+ * LSM3D_HJ_ENO1_CODIM2_LOCAL() and LSM3D_HJ_ENO2_CODIM2_LOCAL()), and
+ * the TVD Runge-Kutta stages update both level set functions in a
+ * single loop.  This module provides the serial counterpart of the
+ * codimension-two support in the parallel package
+ * (LevelSetFunctionIntegrator and OrthogonalizationAlgorithm).
+ *
+ * Typical usage is
+ *
+ * \code
+ *   c = createCurveEvolutionDataArrays(grid);
+ *   (initialize c->phi, c->psi and the velocity field)
+ *   while (t < t_final) {
+ *     determineCurveEvolutionNarrowBand(c, grid, beta, gamma);
+ *     dt = computeCurveEvolutionStableDt(c, grid, cfl_number);
+ *     advanceCurveLevelSetsTVDRK(c, grid, dt, 3, 2, ALL_BOUNDARIES);
+ *     (periodically) reinitializeCurveLevelSets(c, grid, ...);
+ *     (periodically) orthogonalizeCurveLevelSets(c, grid, ...);
+ *     t += dt;
+ *   }
+ *   destroyCurveEvolutionDataArrays(c);
+ * \endcode
+ *
+ */
+
+
+/*========================== Error Codes ============================*/
+#define LSM_CURVE_EVOLUTION_ERR_SUCCESS                          (0)
+#define LSM_CURVE_EVOLUTION_ERR_INVALID_SPATIAL_DERIVATIVE_ORDER (1)
+#define LSM_CURVE_EVOLUTION_ERR_INVALID_TVD_RK_ORDER             (2)
+#define LSM_CURVE_EVOLUTION_ERR_INVALID_LEVEL_SET_FCN            (3)
+
+
+/*============================= Constants ===========================*/
+
+/* level set function identifiers for orthogonalizeCurveLevelSets() */
+#define LSM_CURVE_EVOLUTION_PHI                                  (0)
+#define LSM_CURVE_EVOLUTION_PSI                                  (1)
+
+/*
+ * number of narrow band levels (in addition to level 0) marked by
+ * determineCurveEvolutionNarrowBand()
+ */
+#define LSM_CURVE_EVOLUTION_NUM_NB_LEVELS                        (3)
+
+
+/*!
+ * Structure 'LSM_CurveEvolutionDataArrays' stores the data arrays
+ * required for narrow band evolution of a curve in three space
+ * dimensions.
+ */
+typedef struct _LSM_CurveEvolutionDataArrays
+{
+  /* level set functions (psi is stored directly after phi) */
+  LSMLIB_REAL *phi, *psi;
+
+  /* level set functions at intermediate time integration steps    */
+  /* (phi_stage2 and psi_stage2 also store phi0 and psi0 during    */
+  /* reinitialization)                                             */
+  LSMLIB_REAL *phi_stage1, *psi_stage1;
+  LSMLIB_REAL *phi_stage2, *psi_stage2;
+
+  /* right-hand sides of the level set equations */
+  LSMLIB_REAL *rhs_phi, *rhs_psi;
+
+  /* external velocity (shared) and normal velocities (initialized */
+  /* to zero)                                                      */
+  LSMLIB_REAL *external_velocity_x;
+  LSMLIB_REAL *external_velocity_y;
+  LSMLIB_REAL *external_velocity_z;
+  LSMLIB_REAL *normal_velocity_phi;
+  LSMLIB_REAL *normal_velocity_psi;
+
+  /* one-sided derivatives of phi and psi */
+  LSMLIB_REAL *phi_x_plus, *phi_y_plus, *phi_z_plus;
+  LSMLIB_REAL *phi_x_minus, *phi_y_minus, *phi_z_minus;
+  LSMLIB_REAL *psi_x_plus, *psi_y_plus, *psi_z_plus;
+  LSMLIB_REAL *psi_x_minus, *psi_y_minus, *psi_z_minus;
+
+  /* intersection of the narrow bands of phi and psi */
+  LSMLIB_REAL *max_abs_phi_psi;
+  unsigned char *narrow_band;
+  int *index_x, *index_y, *index_z;
+  int n_lo[LSM_CURVE_EVOLUTION_NUM_NB_LEVELS+1];
+  int n_hi[LSM_CURVE_EVOLUTION_NUM_NB_LEVELS+1];
+  int *index_outer_pts;
+  int nlo_outer_plus, nhi_outer_plus;
+  int nlo_outer_minus, nhi_outer_minus;
+
+  /* array indices of all points in the narrow band (all levels) */
+  int *update_pts;
+  int num_update_pts;
+
+  /* inner (beta) and outer (gamma) narrow band widths */
+  LSMLIB_REAL beta, gamma;
+
+} LSM_CurveEvolutionDataArrays;
+
+
+/*!
+ * createCurveEvolutionDataArrays() allocates a
+ * LSM_CurveEvolutionDataArrays structure and the memory for its data
+ * arrays.
+ *
+ * Arguments:
+ *  - grid (in):  pointer to three-dimensional Grid
+ *
+ * Return value:  pointer to new LSM_CurveEvolutionDataArrays structure;
+ *                NULL if grid is not three-dimensional or if memory
+ *                allocation fails
+ *
+ * NOTES:
+ *  - The velocity field arrays are initialized to zero.
+ *
+ *  - The narrow band is empty until
+ *    determineCurveEvolutionNarrowBand() is called.
+ *
+ */
+LSM_CurveEvolutionDataArrays *createCurveEvolutionDataArrays(Grid *grid);
+
+
+/*!
+ * destroyCurveEvolutionDataArrays() frees the memory allocated for a
+ * LSM_CurveEvolutionDataArrays structure and its data arrays.
+ */
+void destroyCurveEvolutionDataArrays(
+  LSM_CurveEvolutionDataArrays *curve_arrays);
+
+
+/*!
+ * determineCurveEvolutionNarrowBand() builds the intersection of the
+ * narrow bands of phi and psi, i.e. the set of grid points where
+ * \f$ \max(|\phi|, |\psi|) < \gamma \f$, and marks the boundary layers
+ * used by the local toolbox kernels.
+ *
+ * Arguments:
+ *  - curve_arrays (in/out):  pointer to LSM_CurveEvolutionDataArrays
+ *  - grid (in):              pointer to Grid
+ *  - beta (in):              inner narrow band width (the level set
+ *                            equations are unmodified where
+ *                            \f$ \max(|\phi|, |\psi|) < \beta \f$)
+ *  - gamma (in):             outer narrow band width
+ *
+ * Return value:              none
+ *
+ * NOTES:
+ *  - phi and psi should be close to signed distance functions (see
+ *    reinitializeCurveLevelSets()).
+ *
+ *  - The narrow band should be rebuilt after every time step (or
+ *    whenever the curve may have moved more than gamma - beta).
+ *
+ */
+void determineCurveEvolutionNarrowBand(
+  LSM_CurveEvolutionDataArrays *curve_arrays,
+  Grid *grid,
+  LSMLIB_REAL beta,
+  LSMLIB_REAL gamma);
+
+
+/*!
+ * computeCurveEvolutionStableDt() computes the stable time step for
+ * the level set equations for phi and psi.
+ *
+ * Arguments:
+ *  - curve_arrays (in):  pointer to LSM_CurveEvolutionDataArrays
+ *  - grid (in):          pointer to Grid
+ *  - cfl_number (in):    CFL number
+ *
+ * Return value:          stable time step (LSMLIB_REAL_MAX if the
+ *                        velocity field vanishes on the narrow band)
+ *
+ */
+LSMLIB_REAL computeCurveEvolutionStableDt(
+  LSM_CurveEvolutionDataArrays *curve_arrays,
+  Grid *grid,
+  LSMLIB_REAL cfl_number);
+
+
+/*!
+ * computeCurveEvolutionEqnRHS() computes the right-hand sides of the
+ * level set equations for phi and psi on the narrow band.  The
+ * right-hand sides are multiplied by the cut-off function of Peng et
+ * al. evaluated at \f$ \max(|\phi|, |\psi|) \f$.
+ *
+ * Arguments:
+ *  - curve_arrays (in/out):         pointer to
+ *                                   LSM_CurveEvolutionDataArrays
+ *  - grid (in):                     pointer to Grid
+ *  - phi (in):                      phi
+ *  - psi (in):                      psi
+ *  - spatial_derivative_order (in): order of the HJ ENO
+ *                                   discretization (1 or 2)
+ *
+ * Return value:                     LSM_CURVE_EVOLUTION_ERR_SUCCESS or
+ *                                   an error code
+ *
+ */
+int computeCurveEvolutionEqnRHS(
+  LSM_CurveEvolutionDataArrays *curve_arrays,
+  Grid *grid,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *psi,
+  int spatial_derivative_order);
+
+
+/*!
+ * advanceCurveLevelSetsTVDRK() advances phi and psi through a single
+ * TVD Runge-Kutta time step.
+ *
+ * Arguments:
+ *  - curve_arrays (in/out):         pointer to
+ *                                   LSM_CurveEvolutionDataArrays
+ *  - grid (in):                     pointer to Grid
+ *  - dt (in):                       time step
+ *  - tvd_rk_order (in):             order of TVD Runge-Kutta
+ *                                   integration (1, 2 or 3)
+ *  - spatial_derivative_order (in): order of the HJ ENO
+ *                                   discretization (1 or 2)
+ *  - bdry_location_idx (in):        boundary location index for
+ *                                   signed linear extrapolation
+ *                                   boundary conditions (see
+ *                                   lsm_boundary_conditions.h)
+ *
+ * Return value:                     LSM_CURVE_EVOLUTION_ERR_SUCCESS or
+ *                                   an error code
+ *
+ */
+int advanceCurveLevelSetsTVDRK(
+  LSM_CurveEvolutionDataArrays *curve_arrays,
+  Grid *grid,
+  LSMLIB_REAL dt,
+  int tvd_rk_order,
+  int spatial_derivative_order,
+  int bdry_location_idx);
+
+
+/*!
+ * reinitializeCurveLevelSets() reinitializes phi and psi to be
+ * approximate signed distance functions on the narrow band by
+ * advancing the reinitialization equations for both functions
+ * together in pseudo-time (TVD RK2).
+ *
+ * Arguments:
+ *  - curve_arrays (in/out):         pointer to
+ *                                   LSM_CurveEvolutionDataArrays
+ *  - grid (in):                     pointer to Grid
+ *  - num_iterations (in):           number of pseudo-time steps
+ *  - spatial_derivative_order (in): order of the HJ ENO
+ *                                   discretization (1 or 2)
+ *  - bdry_location_idx (in):        boundary location index for
+ *                                   signed linear extrapolation
+ *                                   boundary conditions
+ *
+ * Return value:                     LSM_CURVE_EVOLUTION_ERR_SUCCESS or
+ *                                   an error code
+ *
+ */
+int reinitializeCurveLevelSets(
+  LSM_CurveEvolutionDataArrays *curve_arrays,
+  Grid *grid,
+  int num_iterations,
+  int spatial_derivative_order,
+  int bdry_location_idx);
+
+
+/*!
+ * orthogonalizeCurveLevelSets() evolves one of the level set functions
+ * so that its gradient is orthogonal to the gradient of the other
+ * (fixed) level set function on the narrow band by advancing the
+ * orthogonalization equation
+ *
+ * \f[
+ *
+ *   \phi_t + sgn(\psi) \frac{\nabla \psi}{|\nabla \psi|}
+ *            \cdot \nabla \phi = 0
+ *
+ * \f]
+ *
+ * in pseudo-time (TVD RK2).
+ *
+ * Arguments:
+ *  - curve_arrays (in/out):         pointer to
+ *                                   LSM_CurveEvolutionDataArrays
+ *  - grid (in):                     pointer to Grid
+ *  - evolved_level_set_fcn (in):    level set function to evolve
+ *                                   (LSM_CURVE_EVOLUTION_PHI or
+ *                                   LSM_CURVE_EVOLUTION_PSI)
+ *  - num_iterations (in):           number of pseudo-time steps
+ *  - spatial_derivative_order (in): order of the HJ ENO
+ *                                   discretization (1 or 2)
+ *  - bdry_location_idx (in):        boundary location index for
+ *                                   signed linear extrapolation
+ *                                   boundary conditions
+ *
+ * Return value:                     LSM_CURVE_EVOLUTION_ERR_SUCCESS or
+ *                                   an error code
+ *
+ * NOTES:
+ *  - As in the parallel package, the evolved level set function
+ *    should alternate between phi and psi in successive calls.
+ *
+ */
+int orthogonalizeCurveLevelSets(
+  LSM_CurveEvolutionDataArrays *curve_arrays,
+  Grid *grid,
+  int evolved_level_set_fcn,
+  int num_iterations,
+  int spatial_derivative_order,
+  int bdry_location_idx);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
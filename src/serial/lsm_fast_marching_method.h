@@ -40,7 +40,8 @@ extern "C" {
  *
  * - Error Codes:  0 - successful computation,
  *                 1 - FMM_Data creation error,
- *                 2 - invalid spatial discretization order
+ *                 2 - invalid spatial discretization order,
+ *                 3 - target point outside of grid
  *
  * - While @ref lsm_fast_marching_method.h only provides functions 
  *   for 2D and 3D FMM calculations, LSMLIB is capable of supporting higher 
@@ -51,6 +52,28 @@ extern "C" {
  *   the data array sizes and index calculations are appropriate
  *   for the dimensionality of the problem of interest.
  *
+ * - When FMM calculations are performed repeatedly (e.g. periodic 
+ *   reinitialization), the "WithWorkspace" versions of the functions 
+ *   may be used together with an FMM_Workspace created by 
+ *   FMM_Core_createFMM_Workspace() to avoid allocating and 
+ *   initializing memory for the entire grid on every call.
+ *
+ * - When the Eikonal equation is solved many times with the same 
+ *   speed function and mask (e.g. travel times from many different 
+ *   sets of sources), solveEikonalEquation2dBatch() and 
+ *   solveEikonalEquation3dBatch() may be used together with an 
+ *   EikonalBatchSolver.  The batch solver caches the grid points 
+ *   outside of the domain of the problem and one FMM_Workspace per 
+ *   thread, and it optionally computes the label of the nearest 
+ *   source for every grid point.
+ *
+ * - For travel times between sources and a small number of target 
+ *   points (e.g. path planning), solveEikonalEquation2dToTargets() and
+ *   solveEikonalEquation3dToTargets() stop the calculation as soon as 
+ *   the solution is known at all of the target points, and 
+ *   computeEikonalPath2d() and computeEikonalPath3d() compute the 
+ *   minimal arrival time path from a target point back to the sources.
+ *
  */
 
 
@@ -104,6 +127,13 @@ extern "C" {
  *    uses only a first-order accurate scheme for initializing the grid 
  *    points around the zero-level set.
  *
+ *  - When the third-order spatial discretization is requested, the
+ *    grid points around the zero level set are initialized by 
+ *    projecting onto the zero level set of a local quadratic model of
+ *    phi, and the distance function is computed using a third-order 
+ *    discretization away from the zero level set.  The resulting
+ *    distance function is second-order accurate in the L-infinity norm.
+ *
  *  - For grid points that are masked out, the distance function and
  *    extension fields are set to 0.
  *
@@ -133,6 +163,35 @@ int computeExtensionFields2d(
   int *grid_dims,
   LSMLIB_REAL *dx);
 
+/*!
+ * computeExtensionFields2dWithWorkspace() is identical to 
+ * computeExtensionFields2d() except that the memory required by the FMM 
+ * calculation is provided by the specified FMM_Workspace (see
+ * FMM_Core_createFMM_Workspace()).
+ *
+ * Arguments:
+ *  - workspace (in/out):                 FMM_Workspace to use for the FMM
+ *                                        calculation (a temporary workspace
+ *                                        is used if workspace is NULL)
+ *  - all other arguments:                see computeExtensionFields2d()
+ *
+ * Return value:                          error code (see
+ *                                        computeExtensionFields2d())
+ *
+ */
+int computeExtensionFields2dWithWorkspace(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  int num_extension_fields,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  FMM_Workspace *workspace);
+
 /*!
  * computeDistanceFunction2d uses the FMM algorithm to compute the 
  * a distance function from the original level set function, phi.
@@ -162,6 +221,13 @@ int computeExtensionFields2d(
  *    uses only a first-order accurate scheme for initializing the grid 
  *    points around the zero-level set.
  *
+ *  - When the third-order spatial discretization is requested, the
+ *    grid points around the zero level set are initialized by 
+ *    projecting onto the zero level set of a local quadratic model of
+ *    phi, and the distance function is computed using a third-order 
+ *    discretization away from the zero level set.  The resulting
+ *    distance function is second-order accurate in the L-infinity norm.
+ *
  *  - For grid points that are masked out, the distance function is
  *    set to 0.
  *
@@ -184,6 +250,31 @@ int computeDistanceFunction2d(
   int *grid_dims,
   LSMLIB_REAL *dx);
 
+/*!
+ * computeDistanceFunction2dWithWorkspace() is identical to 
+ * computeDistanceFunction2d() except that the memory required by the FMM 
+ * calculation is provided by the specified FMM_Workspace (see
+ * FMM_Core_createFMM_Workspace()).
+ *
+ * Arguments:
+ *  - workspace (in/out):                 FMM_Workspace to use for the FMM
+ *                                        calculation (a temporary workspace
+ *                                        is used if workspace is NULL)
+ *  - all other arguments:                see computeDistanceFunction2d()
+ *
+ * Return value:                          error code (see
+ *                                        computeDistanceFunction2d())
+ *
+ */
+int computeDistanceFunction2dWithWorkspace(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  FMM_Workspace *workspace);
+
 /*!
  * solveEikonalEquation2d uses the FMM algorithm to solve the Eikonal
  * equation 
@@ -233,6 +324,11 @@ int computeDistanceFunction2d(
  *    L2 norm is achieved using the second-order scheme even if only one 
  *    layer of boundary values is specified.
  *
+ *  - The third-order spatial discretization requires "boundary values"
+ *    of phi in a layer of grid cells at least three deep to achieve 
+ *    third-order accuracy.  When fewer KNOWN values are available, the
+ *    discretization drops to second- or first-order accuracy.
+ *
  *  - phi MUST be initialized so that the values for phi at grid points on 
  *    or adjacent to the boundary of the domain for the Eikonal equation 
  *    are correctly set.  All other grid points should be set to have
@@ -261,6 +357,31 @@ int solveEikonalEquation2d(
   int *grid_dims,
   LSMLIB_REAL *dx);
 
+/*!
+ * solveEikonalEquation2dWithWorkspace() is identical to 
+ * solveEikonalEquation2d() except that the memory required by the FMM 
+ * calculation is provided by the specified FMM_Workspace (see
+ * FMM_Core_createFMM_Workspace()).
+ *
+ * Arguments:
+ *  - workspace (in/out):                 FMM_Workspace to use for the FMM
+ *                                        calculation (a temporary workspace
+ *                                        is used if workspace is NULL)
+ *  - all other arguments:                see solveEikonalEquation2d()
+ *
+ * Return value:                          error code (see
+ *                                        solveEikonalEquation2d())
+ *
+ */
+int solveEikonalEquation2dWithWorkspace(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  FMM_Workspace *workspace);
+
 /*!
  * computeExtensionFields3d uses the FMM algorithm to compute the 
  * distance function and extension fields from the original level set
@@ -311,6 +432,13 @@ int solveEikonalEquation2d(
  *    uses only a first-order accurate scheme for initializing the grid 
  *    points around the zero-level set.
  *
+ *  - When the third-order spatial discretization is requested, the
+ *    grid points around the zero level set are initialized by 
+ *    projecting onto the zero level set of a local quadratic model of
+ *    phi, and the distance function is computed using a third-order 
+ *    discretization away from the zero level set.  The resulting
+ *    distance function is second-order accurate in the L-infinity norm.
+ *
  *  - For grid points that are masked out, the distance function and
  *    extension fields are set to 0.
  *
@@ -340,6 +468,35 @@ int computeExtensionFields3d(
   int *grid_dims,
   LSMLIB_REAL *dx);
 
+/*!
+ * computeExtensionFields3dWithWorkspace() is identical to 
+ * computeExtensionFields3d() except that the memory required by the FMM 
+ * calculation is provided by the specified FMM_Workspace (see
+ * FMM_Core_createFMM_Workspace()).
+ *
+ * Arguments:
+ *  - workspace (in/out):                 FMM_Workspace to use for the FMM
+ *                                        calculation (a temporary workspace
+ *                                        is used if workspace is NULL)
+ *  - all other arguments:                see computeExtensionFields3d()
+ *
+ * Return value:                          error code (see
+ *                                        computeExtensionFields3d())
+ *
+ */
+int computeExtensionFields3dWithWorkspace(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  int num_extension_fields,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  FMM_Workspace *workspace);
+
 /*!
  * computeDistanceFunction3d uses the FMM algorithm to compute the 
  * a distance function from the original level set function, phi.
@@ -369,6 +526,13 @@ int computeExtensionFields3d(
  *    uses only a first-order accurate scheme for initializing the grid 
  *    points around the zero-level set.
  *
+ *  - When the third-order spatial discretization is requested, the
+ *    grid points around the zero level set are initialized by 
+ *    projecting onto the zero level set of a local quadratic model of
+ *    phi, and the distance function is computed using a third-order 
+ *    discretization away from the zero level set.  The resulting
+ *    distance function is second-order accurate in the L-infinity norm.
+ *
  *  - For grid points that are masked out, the distance function is
  *    set to 0.
  *
@@ -391,6 +555,31 @@ int computeDistanceFunction3d(
   int *grid_dims,
   LSMLIB_REAL *dx);
 
+/*!
+ * computeDistanceFunction3dWithWorkspace() is identical to 
+ * computeDistanceFunction3d() except that the memory required by the FMM 
+ * calculation is provided by the specified FMM_Workspace (see
+ * FMM_Core_createFMM_Workspace()).
+ *
+ * Arguments:
+ *  - workspace (in/out):                 FMM_Workspace to use for the FMM
+ *                                        calculation (a temporary workspace
+ *                                        is used if workspace is NULL)
+ *  - all other arguments:                see computeDistanceFunction3d()
+ *
+ * Return value:                          error code (see
+ *                                        computeDistanceFunction3d())
+ *
+ */
+int computeDistanceFunction3dWithWorkspace(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  FMM_Workspace *workspace);
+
 /*!
  * solveEikonalEquation3d uses the FMM algorithm to solve the Eikonal
  * equation 
@@ -440,6 +629,11 @@ int computeDistanceFunction3d(
  *    L2 norm is achieved using the second-order scheme even if only one 
  *    layer of boundary values is specified.
  *
+ *  - The third-order spatial discretization requires "boundary values"
+ *    of phi in a layer of grid cells at least three deep to achieve 
+ *    third-order accuracy.  When fewer KNOWN values are available, the
+ *    discretization drops to second- or first-order accuracy.
+ *
  *  - phi MUST be initialized so that the values for phi at grid points on 
  *    or adjacent to the boundary of the domain for the Eikonal equation 
  *    are correctly set.  All other grid points should be set to have
@@ -468,6 +662,382 @@ int solveEikonalEquation3d(
   int *grid_dims,
   LSMLIB_REAL *dx);
 
+/*!
+ * solveEikonalEquation3dWithWorkspace() is identical to 
+ * solveEikonalEquation3d() except that the memory required by the FMM 
+ * calculation is provided by the specified FMM_Workspace (see
+ * FMM_Core_createFMM_Workspace()).
+ *
+ * Arguments:
+ *  - workspace (in/out):                 FMM_Workspace to use for the FMM
+ *                                        calculation (a temporary workspace
+ *                                        is used if workspace is NULL)
+ *  - all other arguments:                see solveEikonalEquation3d()
+ *
+ * Return value:                          error code (see
+ *                                        solveEikonalEquation3d())
+ *
+ */
+int solveEikonalEquation3dWithWorkspace(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  FMM_Workspace *workspace);
+
+/*!
+ * EikonalBatchSolver is a data structure that contains the data shared 
+ * by a batch of solutions of the Eikonal equation with the same speed 
+ * function and mask.
+ */
+typedef struct _EikonalBatchSolver
+{
+  /* number of spatial dimensions and index space extents of grid */
+  int num_dims;
+  int grid_dims[3];
+
+  /* grid cell sizes */
+  LSMLIB_REAL dx[3];
+
+  /* speed function (not owned) */
+  LSMLIB_REAL *speed;
+
+  /* order of finite differences used to compute spatial derivatives */
+  int spatial_discretization_order;
+
+  /* grid points outside of the domain of the problem */
+  int num_outside_pts;
+  int *outside_pts;
+
+  /* FMM_Workspace for each thread */
+  int num_workspaces;
+  FMM_Workspace **workspaces;
+
+} EikonalBatchSolver;
+
+/*!
+ * createEikonalBatchSolver() creates an EikonalBatchSolver for the 
+ * specified speed function and mask.
+ *
+ * Arguments:
+ *  - speed (in):                         pointer to speed field
+ *  - mask (in):                          mask for domain of problem;
+ *                                        grid points outside of the domain
+ *                                        of the problem should be set to a 
+ *                                        negative value.
+ *  - spatial_discretization_order (in):  order of finite differences used 
+ *                                        to compute spatial derivatives
+ *  - num_dims (in):                      number of spatial dimensions 
+ *                                        (2 or 3)
+ *  - grid_dims (in):                     array of index space extents for all 
+ *                                        fields 
+ *  - dx (in):                            array of grid cell sizes in each 
+ *                                        coordinate direction
+ *  - num_threads (in):                   maximum number of solutions 
+ *                                        computed concurrently 
+ *                                        (non-positive to use the maximum
+ *                                        number of OpenMP threads)
+ *
+ * Return value:                          pointer to new EikonalBatchSolver
+ *                                        (NULL if the arguments are 
+ *                                        invalid or memory could not be 
+ *                                        allocated)
+ *
+ * NOTES:
+ *  - The grid points outside of the domain of the problem (negative 
+ *    mask value or zero speed) are determined when the 
+ *    EikonalBatchSolver is created, so the mask is not used afterwards.
+ *
+ *  - The speed function is NOT copied.  It must not be modified or 
+ *    freed until the EikonalBatchSolver is destroyed.
+ *
+ *  - Each thread requires an FMM_Workspace for the entire grid.
+ *
+ *  - If mask is set to a NULL pointer, then all grid points with 
+ *    nonzero speed are treated as being in the interior of the domain.
+ *
+ */
+EikonalBatchSolver* createEikonalBatchSolver(
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  int num_threads);
+
+/*!
+ * destroyEikonalBatchSolver() frees the memory associated with an 
+ * EikonalBatchSolver.
+ *
+ * Arguments:
+ *  - solver (in):  EikonalBatchSolver to be destroyed
+ *
+ * Return value:    none
+ *
+ */
+void destroyEikonalBatchSolver(EikonalBatchSolver *solver);
+
+/*!
+ * solveEikonalEquation2dBatch() solves the Eikonal equation for each 
+ * of a batch of solutions phi[0], ..., phi[num_solves-1] using the 
+ * speed function and mask of the EikonalBatchSolver.  When LSMLIB is 
+ * built with OpenMP support, the solutions are computed concurrently 
+ * (at most solver->num_workspaces at a time).
+ *
+ * Arguments:
+ *  - phi (in/out):           array of pointers to solutions to Eikonal 
+ *                            equation; each solution must be initialized 
+ *                            as specified in the NOTES for 
+ *                            solveEikonalEquation2d()
+ *  - source_label (in/out):  array of pointers to labels of the nearest 
+ *                            source for each solution (see NOTES); 
+ *                            may be NULL
+ *  - num_solves (in):        number of solutions
+ *  - solver (in):            EikonalBatchSolver created with num_dims 
+ *                            equal to 2
+ *
+ * Return value:              error code (see NOTES for translation).  If 
+ *                            several solutions fail, the error code of 
+ *                            one of them is returned.
+ *
+ * NOTES:
+ *  - On input, source_label[n] must be set at the grid points where 
+ *    phi[n] is initialized (i.e. non-negative).  On output, 
+ *    source_label[n] contains the label of the nearest source (in 
+ *    the sense of arrival time) at every grid point, which yields a 
+ *    (discrete) Voronoi partition of the domain.  The label of a grid 
+ *    point is the label of its "KNOWN" neighbors that yields the 
+ *    smallest first-order accurate arrival time computed only from 
+ *    neighbors with the same label, so labels may differ from the 
+ *    exact partition only at grid points where the arrival times from 
+ *    different sources are nearly equal.  The label of grid points 
+ *    that are masked out, have zero speed or are not reached by the 
+ *    front is set to -1.
+ *
+ *  - Computing labels requires one additional LSMLIB_REAL per grid 
+ *    point (stored in the scratch data of the FMM_Workspace).
+ *
+ *  - If source_label is NULL, labels are not computed.  Individual 
+ *    entries of source_label may also be NULL.
+ *
+ *  - The solution phi[n] is identical to the solution computed by 
+ *    solveEikonalEquation2d() with the same speed function, mask and 
+ *    initial data.
+ *
+ */
+int solveEikonalEquation2dBatch(
+  LSMLIB_REAL **phi,
+  int **source_label,
+  int num_solves,
+  EikonalBatchSolver *solver);
+
+/*!
+ * solveEikonalEquation3dBatch() is identical to 
+ * solveEikonalEquation2dBatch() except that it solves the Eikonal 
+ * equation in three space dimensions (see solveEikonalEquation3d()).
+ *
+ * Arguments:
+ *  - solver (in):            EikonalBatchSolver created with num_dims 
+ *                            equal to 3
+ *  - all other arguments:    see solveEikonalEquation2dBatch()
+ *
+ * Return value:              error code (see 
+ *                            solveEikonalEquation2dBatch())
+ *
+ */
+int solveEikonalEquation3dBatch(
+  LSMLIB_REAL **phi,
+  int **source_label,
+  int num_solves,
+  EikonalBatchSolver *solver);
+
+/*!
+ * solveEikonalEquation2dToTargets() is identical to 
+ * solveEikonalEquation2dWithWorkspace() except that the calculation is 
+ * stopped as soon as the solution is known at all of the specified 
+ * target points.  Optionally, grid points are accepted in order of 
+ * increasing arrival time plus a lower bound on the remaining arrival 
+ * time to the nearest target point (as in the A* search algorithm), 
+ * which further reduces the region explored by the calculation.
+ *
+ * Arguments:
+ *  - phi (in/out):                       pointer to solution to Eikonal 
+ *                                        equation; must be initialized as 
+ *                                        for solveEikonalEquation2d()
+ *  - target_values (out):                solution at the target points
+ *                                        (may be NULL)
+ *  - target_idx (in):                    grid indices of target points 
+ *                                        (2 entries per target point)
+ *  - num_targets (in):                   number of target points
+ *  - heuristic_weight (in):              weight of heuristic used to order 
+ *                                        grid points (0 to accept grid 
+ *                                        points in order of arrival time)
+ *  - speed (in):                         pointer to speed field
+ *  - mask (in):                          mask for domain of problem;
+ *                                        grid points outside of the domain
+ *                                        of the problem should be set to a 
+ *                                        negative value.
+ *  - spatial_discretization_order (in):  order of finite differences used 
+ *                                        to compute spatial derivatives
+ *  - grid_dims (in):                     array of index space extents for all 
+ *                                        fields 
+ *  - dx (in):                            array of grid cell sizes in each 
+ *                                        coordinate direction
+ *  - workspace (in/out):                 FMM_Workspace to use for the FMM
+ *                                        calculation (a temporary workspace
+ *                                        is used if workspace is NULL)
+ *
+ * Return value:                          error code (see NOTES for 
+ *                                        solveEikonalEquation2d())
+ *
+ * NOTES:
+ *  - When the calculation stops, phi is only known at grid points 
+ *    that have been accepted by the FMM.  At grid points adjacent to 
+ *    accepted grid points, phi is an upper bound on the solution.
+ *    phi is not modified at the remaining grid points (i.e. it 
+ *    retains its negative initial value).
+ *
+ *  - target_values[i] is set to LSMLIB_REAL_MAX for target points that 
+ *    are outside of the domain of the problem or are not reached 
+ *    from the boundary data.
+ *
+ *  - The heuristic is heuristic_weight times the distance from the 
+ *    grid point to the nearest target point divided by the maximum 
+ *    speed.  For heuristic_weight between 0 and 1, the heuristic is a 
+ *    lower bound on the arrival time from the grid point to the 
+ *    target points.  Because grid points may be accepted before all
+ *    of their upwind neighbors, the solution at the target points is 
+ *    only approximately equal to the solution computed without a 
+ *    heuristic (the difference increases with heuristic_weight).
+ *
+ *  - If num_targets is not positive, the solution is computed on the 
+ *    entire grid.
+ *
+ *  - The cost of preparing the calculation is proportional to the size 
+ *    of the grid (see solveEikonalEquation2d()).  The cost of the FMM 
+ *    calculation is proportional to the number of grid points accepted 
+ *    before the target points are reached.  Passing the same 
+ *    FMM_Workspace to repeated calculations avoids allocating memory 
+ *    for the entire grid on every call.
+ *
+ */
+int solveEikonalEquation2dToTargets(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *target_values,
+  int *target_idx,
+  int num_targets,
+  LSMLIB_REAL heuristic_weight,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  FMM_Workspace *workspace);
+
+/*!
+ * solveEikonalEquation3dToTargets() is identical to 
+ * solveEikonalEquation2dToTargets() except that it solves the Eikonal 
+ * equation in three space dimensions (see solveEikonalEquation3d()).
+ *
+ * Arguments:
+ *  - target_idx (in):                    grid indices of target points 
+ *                                        (3 entries per target point)
+ *  - all other arguments:                see 
+ *                                        solveEikonalEquation2dToTargets()
+ *
+ * Return value:                          error code (see 
+ *                                        solveEikonalEquation2dToTargets())
+ *
+ */
+int solveEikonalEquation3dToTargets(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *target_values,
+  int *target_idx,
+  int num_targets,
+  LSMLIB_REAL heuristic_weight,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  FMM_Workspace *workspace);
+
+/*!
+ * computeEikonalPath2d() computes the minimal arrival time path from 
+ * a point back to the boundary data (e.g. sources) of a solution of 
+ * the Eikonal equation by gradient descent on the arrival time.
+ *
+ * Arguments:
+ *  - path (out):                 points on path in grid index coordinates 
+ *                                (2 entries per point); must have space
+ *                                for max_num_path_points points
+ *  - max_num_path_points (in):   maximum number of points on path
+ *  - start_point (in):           starting point of path in grid index 
+ *                                coordinates (e.g. a target point)
+ *  - step_size (in):             distance between points on path
+ *                                (non-positive to use half of the 
+ *                                smallest grid cell size)
+ *  - phi (in):                   solution to Eikonal equation computed by
+ *                                solveEikonalEquation2d() or 
+ *                                solveEikonalEquation2dToTargets()
+ *  - grid_dims (in):             array of index space extents for phi
+ *  - dx (in):                    array of grid cell sizes in each 
+ *                                coordinate direction
+ *
+ * Return value:                  number of points on path
+ *
+ * NOTES:
+ *  - The path starts at start_point.  At each step, the path moves a 
+ *    distance step_size in the direction of -grad(phi), which is 
+ *    computed by multilinear interpolation of central difference 
+ *    approximations at the grid points (one-sided differences are 
+ *    used next to grid points where phi is not known).  If the step 
+ *    would move the path to a point whose nearest grid point is not 
+ *    known (e.g. around the corners of obstacles), the path moves to 
+ *    the neighboring grid point with the smallest value of phi instead.
+ *
+ *  - The path ends at the grid point where phi has a local minimum 
+ *    (i.e. a source), which is the last point of the path.  The path 
+ *    also ends if phi is not known at the grid point nearest to 
+ *    start_point or if max_num_path_points points have been computed.
+ *
+ *  - Grid points where phi is negative or equal to LSMLIB_REAL_MAX are
+ *    treated as grid points where phi is not known.
+ *
+ */
+int computeEikonalPath2d(
+  LSMLIB_REAL *path,
+  int max_num_path_points,
+  LSMLIB_REAL *start_point,
+  LSMLIB_REAL step_size,
+  LSMLIB_REAL *phi,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * computeEikonalPath3d() is identical to computeEikonalPath2d() except 
+ * that it computes the path in three space dimensions.
+ *
+ * Arguments:
+ *  - path (out):                 points on path in grid index coordinates 
+ *                                (3 entries per point)
+ *  - all other arguments:        see computeEikonalPath2d()
+ *
+ * Return value:                  number of points on path
+ *
+ */
+int computeEikonalPath3d(
+  LSMLIB_REAL *path,
+  int max_num_path_points,
+  LSMLIB_REAL *start_point,
+  LSMLIB_REAL step_size,
+  LSMLIB_REAL *phi,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
 #ifdef __cplusplus
 }
 #endif
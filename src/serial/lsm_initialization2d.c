@@ -250,3 +250,326 @@ void createIntersectionOfRectangles(
     
   free(phi1);
 }
+
+
+/*============ Banded (spatially binned) initialization =============*/
+
+/*
+ * LSM_INIT2D_MIN_BIN_WIDTH and LSM_INIT2D_MAX_BIN_WIDTH are the 
+ * bounds on the number of grid points along each edge of the bins
+ * used to sort primitives for banded initialization.
+ */
+#define LSM_INIT2D_MIN_BIN_WIDTH     (16)
+#define LSM_INIT2D_MAX_BIN_WIDTH     (256)
+
+/*
+ * LSM_INIT2D_DISTANCE_FCN is the type of the functions used by 
+ * createIntersectionOfPrimitivesWithBandWidth2d() to compute the signed 
+ * distance (positive outside) from the point (x,y) to the l-th 
+ * primitive.  params is the array of primitive parameter arrays that 
+ * is passed to createIntersectionOfPrimitivesWithBandWidth2d().
+ */
+typedef LSMLIB_REAL (*LSM_INIT2D_DISTANCE_FCN)(
+  LSMLIB_REAL **params, int l, LSMLIB_REAL x, LSMLIB_REAL y);
+
+/*
+ * createIntersectionOfPrimitivesWithBandWidth2d() sets phi to be the 
+ * maximum over all primitives of orientation[l] times the signed 
+ * distance to the l-th primitive, clamped to the interval 
+ * [-band_width, band_width].
+ *
+ * bounding_box contains 4 entries for each primitive (x_lo, x_hi, 
+ * y_lo, y_hi) that define a box outside of which the absolute value
+ * of the signed distance to the primitive is at least band_width.  
+ * Primitives are sorted into a uniform grid of bins so that only the 
+ * primitives whose bounding boxes overlap a bin are considered when 
+ * computing phi at the grid points in that bin.
+ */
+static void createIntersectionOfPrimitivesWithBandWidth2d(
+  LSMLIB_REAL *phi,
+  int num_primitives,
+  LSM_INIT2D_DISTANCE_FCN distance_fcn,
+  LSMLIB_REAL **params,
+  const LSMLIB_REAL *bounding_box,
+  const signed char *orientation,
+  LSMLIB_REAL band_width,
+  Grid *grid);
+
+/* circle distance function */
+static LSMLIB_REAL distanceToCircle2d(
+  LSMLIB_REAL **params, int l, LSMLIB_REAL x, LSMLIB_REAL y);
+
+/* rectangle distance function (maximum of distances to the edge lines) */
+static LSMLIB_REAL distanceToRectangle2d(
+  LSMLIB_REAL **params, int l, LSMLIB_REAL x, LSMLIB_REAL y);
+
+
+void createIntersectionOfCirclesWithBandWidth(
+  LSMLIB_REAL *phi,
+  int num_circles,
+  LSMLIB_REAL *center_x,
+  LSMLIB_REAL *center_y,
+  LSMLIB_REAL *radius,
+  int *inside_flag,
+  LSMLIB_REAL band_width,
+  Grid *grid)
+{
+  LSMLIB_REAL *params[3];
+  LSMLIB_REAL *bounding_box;
+  signed char *orientation;
+  int l;
+
+  if (band_width <= 0) {
+    createIntersectionOfCircles(phi, num_circles, center_x, center_y,
+                                radius, inside_flag, grid);
+    return;
+  }
+
+  bounding_box = (LSMLIB_REAL*) malloc(4*num_circles*sizeof(LSMLIB_REAL));
+  orientation = (signed char*) malloc(num_circles*sizeof(signed char));
+
+  for (l = 0; l < num_circles; l++) {
+    LSMLIB_REAL extent = fabs(radius[l]) + band_width;
+    bounding_box[4*l]   = center_x[l] - extent;
+    bounding_box[4*l+1] = center_x[l] + extent;
+    bounding_box[4*l+2] = center_y[l] - extent;
+    bounding_box[4*l+3] = center_y[l] + extent;
+    orientation[l] = (inside_flag[l] >= 0) ? -1 : 1;
+  }
+
+  params[0] = center_x; params[1] = center_y; params[2] = radius;
+  createIntersectionOfPrimitivesWithBandWidth2d(
+    phi, num_circles, distanceToCircle2d, params,
+    bounding_box, orientation, band_width, grid);
+
+  free(bounding_box);
+  free(orientation);
+}
+
+
+void createIntersectionOfRectanglesWithBandWidth(
+  LSMLIB_REAL *phi,
+  int num_rectangles,   
+  LSMLIB_REAL *corner_x, LSMLIB_REAL *corner_y,
+  LSMLIB_REAL *side_length_x, LSMLIB_REAL *side_length_y,
+  int *inside_flag,
+  LSMLIB_REAL band_width,
+  Grid *grid)
+{
+  LSMLIB_REAL *params[4];
+  LSMLIB_REAL *bounding_box;
+  signed char *orientation;
+  int l;
+
+  if (band_width <= 0) {
+    createIntersectionOfRectangles(phi, num_rectangles, corner_x, corner_y,
+                                   side_length_x, side_length_y,
+                                   inside_flag, grid);
+    return;
+  }
+
+  bounding_box = (LSMLIB_REAL*) malloc(4*num_rectangles*sizeof(LSMLIB_REAL));
+  orientation = (signed char*) malloc(num_rectangles*sizeof(signed char));
+
+  for (l = 0; l < num_rectangles; l++) {
+    bounding_box[4*l]   = corner_x[l] - band_width;
+    bounding_box[4*l+1] = corner_x[l] + side_length_x[l] + band_width;
+    bounding_box[4*l+2] = corner_y[l] - band_width;
+    bounding_box[4*l+3] = corner_y[l] + side_length_y[l] + band_width;
+
+    /* NOTE: same convention as createIntersectionOfRectangles() */
+    orientation[l] = (inside_flag[l] >= 1) ? -1 : 1;
+  }
+
+  params[0] = corner_x;      params[1] = corner_y;
+  params[2] = side_length_x; params[3] = side_length_y;
+  createIntersectionOfPrimitivesWithBandWidth2d(
+    phi, num_rectangles, distanceToRectangle2d, params,
+    bounding_box, orientation, band_width, grid);
+
+  free(bounding_box);
+  free(orientation);
+}
+
+
+static void createIntersectionOfPrimitivesWithBandWidth2d(
+  LSMLIB_REAL *phi,
+  int num_primitives,
+  LSM_INIT2D_DISTANCE_FCN distance_fcn,
+  LSMLIB_REAL **params,
+  const LSMLIB_REAL *bounding_box,
+  const signed char *orientation,
+  LSMLIB_REAL band_width,
+  Grid *grid)
+{
+  int n[2], num_bins_dir[2], num_bins;
+  int bin_width;
+  int *index_box;
+  int *bin_start, *bin_fill, *bin_primitives;
+  int num_outward_primitives = 0;
+  int l, dir, idx;
+  double mean_extent = 0.0;
+
+  for (dir = 0; dir < 2; dir++) n[dir] = grid->grid_dims_ghostbox[dir];
+
+  /* compute index space bounding box of each primitive */
+  index_box = (int*) malloc(4*num_primitives*sizeof(int));
+  for (l = 0; l < num_primitives; l++) {
+    int max_extent = 0;
+    int empty = 0;
+    for (dir = 0; dir < 2; dir++) {
+      LSMLIB_REAL lo = (bounding_box[4*l+2*dir] - grid->x_lo_ghostbox[dir])
+                     / grid->dx[dir];
+      LSMLIB_REAL hi = (bounding_box[4*l+2*dir+1] - grid->x_lo_ghostbox[dir])
+                     / grid->dx[dir];
+      int i_lo, i_hi;
+      if (lo < 0) lo = 0;
+      if (hi > n[dir]-1) hi = n[dir]-1;
+      i_lo = (int) ceil(lo);
+      i_hi = (int) floor(hi);
+      if (i_lo > i_hi) empty = 1;
+      index_box[4*l+2*dir]   = i_lo;
+      index_box[4*l+2*dir+1] = i_hi;
+      if (i_hi - i_lo + 1 > max_extent) max_extent = i_hi - i_lo + 1;
+    }
+    if (empty) {
+      index_box[4*l] = 1; index_box[4*l+1] = 0;
+    } else {
+      mean_extent += max_extent;
+    }
+    if (orientation[l] > 0) {
+      /* phi >= band_width everywhere if the grid does not intersect */
+      /* the bounding box of an outward oriented primitive           */
+      if (empty) {
+        SET_DATA_TO_CONSTANT(phi, grid, band_width)
+        free(index_box);
+        return;
+      }
+      num_outward_primitives++;
+    }
+  }
+
+  /* choose bin width based on the mean size of the primitives */
+  if (num_primitives > 0) mean_extent /= num_primitives;
+  bin_width = (int) mean_extent;
+  if (bin_width < LSM_INIT2D_MIN_BIN_WIDTH) {
+    bin_width = LSM_INIT2D_MIN_BIN_WIDTH;
+  }
+  if (bin_width > LSM_INIT2D_MAX_BIN_WIDTH) {
+    bin_width = LSM_INIT2D_MAX_BIN_WIDTH;
+  }
+  for (dir = 0; dir < 2; dir++) {
+    num_bins_dir[dir] = (n[dir] + bin_width - 1)/bin_width;
+  }
+  num_bins = num_bins_dir[0]*num_bins_dir[1];
+
+  /* sort primitives into bins (compressed row storage) */
+  bin_start = (int*) calloc(num_bins+1, sizeof(int));
+  bin_fill = (int*) malloc(num_bins*sizeof(int));
+  for (l = 0; l < num_primitives; l++) {
+    int bi, bj;
+    if (index_box[4*l] > index_box[4*l+1]) continue;
+    for (bj = index_box[4*l+2]/bin_width; 
+         bj <= index_box[4*l+3]/bin_width; bj++) {
+      for (bi = index_box[4*l]/bin_width; 
+           bi <= index_box[4*l+1]/bin_width; bi++) {
+        bin_start[bi + num_bins_dir[0]*bj + 1]++;
+      }
+    }
+  }
+  for (idx = 0; idx < num_bins; idx++) {
+    bin_start[idx+1] += bin_start[idx];
+    bin_fill[idx] = bin_start[idx];
+  }
+  bin_primitives = (int*) malloc((bin_start[num_bins]+1)*sizeof(int));
+  for (l = 0; l < num_primitives; l++) {
+    int bi, bj;
+    if (index_box[4*l] > index_box[4*l+1]) continue;
+    for (bj = index_box[4*l+2]/bin_width; 
+         bj <= index_box[4*l+3]/bin_width; bj++) {
+      for (bi = index_box[4*l]/bin_width; 
+           bi <= index_box[4*l+1]/bin_width; bi++) {
+        bin_primitives[bin_fill[bi + num_bins_dir[0]*bj]++] = l;
+      }
+    }
+  }
+
+  /* compute phi bin by bin */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (idx = 0; idx < num_bins; idx++) {
+    int bi = idx%num_bins_dir[0];
+    int bj = idx/num_bins_dir[0];
+    int i_lo = bi*bin_width, i_hi = i_lo + bin_width - 1;
+    int j_lo = bj*bin_width, j_hi = j_lo + bin_width - 1;
+    const int *candidates = bin_primitives + bin_start[idx];
+    int num_candidates = bin_start[idx+1] - bin_start[idx];
+    int i, j, c;
+
+    if (i_hi > n[0]-1) i_hi = n[0]-1;
+    if (j_hi > n[1]-1) j_hi = n[1]-1;
+
+    for (j = j_lo; j <= j_hi; j++) {
+      for (i = i_lo; i <= i_hi; i++) {
+        int grid_idx = i + n[0]*j;
+        LSMLIB_REAL x = grid->x_lo_ghostbox[0] + grid->dx[0]*i;
+        LSMLIB_REAL y = grid->x_lo_ghostbox[1] + grid->dx[1]*j;
+        LSMLIB_REAL max = -band_width;
+        int num_outward = 0;
+
+        for (c = 0; c < num_candidates; c++) {
+          int p = candidates[c];
+          const int *box = index_box + 4*p;
+          LSMLIB_REAL dist;
+
+          /* skip primitives whose bounding box excludes the point */
+          if ( (i < box[0]) || (i > box[1]) || 
+               (j < box[2]) || (j > box[3]) ) {
+            continue;
+          }
+
+          dist = orientation[p]*distance_fcn(params, p, x, y);
+          if (orientation[p] > 0) num_outward++;
+          if (dist > max) {
+            max = dist;
+            if (max >= band_width) break;
+          }
+        }
+
+        /* the point lies outside the bounding box of at least one */
+        /* outward oriented primitive                              */
+        if (num_outward < num_outward_primitives) max = band_width;
+
+        if (max > band_width) max = band_width;
+        phi[grid_idx] = max;
+      }
+    }
+  } /* end loop over bins */
+
+  free(index_box);
+  free(bin_start);
+  free(bin_fill);
+  free(bin_primitives);
+}
+
+
+static LSMLIB_REAL distanceToCircle2d(
+  LSMLIB_REAL **params, int l, LSMLIB_REAL x, LSMLIB_REAL y)
+{
+  LSMLIB_REAL dx = x - params[0][l];
+  LSMLIB_REAL dy = y - params[1][l];
+  return sqrt(dx*dx + dy*dy) - params[2][l];
+}
+
+
+static LSMLIB_REAL distanceToRectangle2d(
+  LSMLIB_REAL **params, int l, LSMLIB_REAL x, LSMLIB_REAL y)
+{
+  LSMLIB_REAL dist = params[0][l] - x;
+  LSMLIB_REAL tmp;
+  tmp = x - (params[0][l] + params[2][l]); if (tmp > dist) dist = tmp;
+  tmp = params[1][l] - y;                  if (tmp > dist) dist = tmp;
+  tmp = y - (params[1][l] + params[3][l]); if (tmp > dist) dist = tmp;
+  return dist;
+}
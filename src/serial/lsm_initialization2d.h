@@ -376,6 +376,98 @@ void createIntersectionOfRectangles(
   int *inside_flag,
   Grid *grid);
 
+
+/*!
+ * createIntersectionOfCirclesWithBandWidth() computes the same level 
+ * set function as createIntersectionOfCircles() within band_width of 
+ * the zero level set.  Outside of this band, phi is set equal to 
+ * +/- band_width.
+ *
+ * Arguments:
+ *  - phi (out):         level set function 
+ *  - num_circles (in):  number of circles
+ *  - center_x (in):     array containing the x-coordinates of the centers
+ *                       of the circles 
+ *  - center_y (in):     array containing the y-coordinates of the centers
+ *                       of the circles 
+ *  - radius (in):       array containing the radii of the circles
+ *  - inside_flag (in):  array containing the flags indicating whether the
+ *                       inside or outside of each circle should be the
+ *                       region associated with negative values of the
+ *                       level set function (see 
+ *                       createIntersectionOfCircles())
+ *  - band_width (in):   width of band around the zero level set within
+ *                       which phi is computed.  If band_width is 
+ *                       non-positive, createIntersectionOfCircles() is 
+ *                       used to compute phi.
+ *  - grid (in):         pointer to Grid data structure
+ *
+ * Return value:         none
+ *
+ * NOTES:
+ * - The circles are sorted into a uniform grid of bins, and phi at each
+ *   grid point is computed using only the circles that come within 
+ *   band_width of the bin containing the grid point.  The cost is 
+ *   proportional to the number of grid points plus the number of grid 
+ *   points within band_width of each circle (rather than the product 
+ *   of the number of grid points and the number of circles).
+ *
+ * - When LSMLIB is built with OpenMP support, the bins are distributed
+ *   across threads.
+ *
+ * - Is it the user's responsbility to ensure that memory for phi
+ *   has been allocated.
+ *
+ */
+void createIntersectionOfCirclesWithBandWidth(
+  LSMLIB_REAL *phi, 
+  int num_circles,
+  LSMLIB_REAL *center_x, LSMLIB_REAL *center_y,
+  LSMLIB_REAL *radius,
+  int *inside_flag,
+  LSMLIB_REAL band_width,
+  Grid *grid);
+
+
+/*!
+ * createIntersectionOfRectanglesWithBandWidth() computes the same level 
+ * set function as createIntersectionOfRectangles() within band_width 
+ * of the zero level set.  Outside of this band, phi is set equal to 
+ * +/- band_width.
+ *
+ * Arguments:
+ *  - phi (out):            level set function 
+ *  - num_rectangles (in):  number of rectangles
+ *  - corner_* (in):        arrays containing the coordinates of the lower
+ *                          corner of each rectangle
+ *  - side_length_* (in):   arrays containing the side lengths of the 
+ *                          rectangles
+ *  - inside_flag (in):     flag indicating whether the inside or outside 
+ *                          of each rectangle should be the region 
+ *                          associated with negative values of the level 
+ *                          set function (see 
+ *                          createIntersectionOfRectangles())
+ *  - band_width (in):      width of band around the zero level set within
+ *                          which phi is computed.  If band_width is 
+ *                          non-positive, createIntersectionOfRectangles() 
+ *                          is used to compute phi.
+ *  - grid (in):            pointer to Grid data structure 
+ *
+ * Return value:            none
+ *
+ * NOTES:
+ * - See NOTES for createIntersectionOfCirclesWithBandWidth().
+ *
+ */
+void createIntersectionOfRectanglesWithBandWidth(
+  LSMLIB_REAL *phi,
+  int num_rectangles,   
+  LSMLIB_REAL *corner_x, LSMLIB_REAL *corner_y,
+  LSMLIB_REAL *side_length_x, LSMLIB_REAL *side_length_y,
+  int *inside_flag,
+  LSMLIB_REAL band_width,
+  Grid *grid);
+
      
 #ifdef __cplusplus
 }
@@ -519,3 +519,462 @@ void createIntersectionOfBoxes(
     
   free(phi1);
 }
+
+
+/*============ Banded (spatially binned) initialization =============*/
+
+/*
+ * LSM_INIT3D_MIN_BIN_WIDTH and LSM_INIT3D_MAX_BIN_WIDTH are the 
+ * bounds on the number of grid points along each edge of the bins
+ * used to sort primitives for banded initialization.
+ */
+#define LSM_INIT3D_MIN_BIN_WIDTH     (8)
+#define LSM_INIT3D_MAX_BIN_WIDTH     (64)
+
+/*
+ * LSM_INIT3D_DISTANCE_FCN is the type of the functions used by 
+ * createIntersectionOfPrimitivesWithBandWidth3d() to compute the signed 
+ * distance (positive outside) from the point (x,y,z) to the l-th 
+ * primitive.  params is the array of primitive parameter arrays that 
+ * is passed to createIntersectionOfPrimitivesWithBandWidth3d().
+ */
+typedef LSMLIB_REAL (*LSM_INIT3D_DISTANCE_FCN)(
+  LSMLIB_REAL **params, int l, LSMLIB_REAL x, LSMLIB_REAL y, LSMLIB_REAL z);
+
+/*
+ * createIntersectionOfPrimitivesWithBandWidth3d() sets phi to be the 
+ * maximum over all primitives of orientation[l] times the signed 
+ * distance to the l-th primitive, clamped to the interval 
+ * [-band_width, band_width].
+ *
+ * bounding_box contains 6 entries for each primitive (x_lo, x_hi, 
+ * y_lo, y_hi, z_lo, z_hi) that define a box outside of which the 
+ * absolute value of the signed distance to the primitive is at least 
+ * band_width.  Primitives are sorted into a uniform grid of bins so 
+ * that only the primitives whose bounding boxes overlap a bin are 
+ * considered when computing phi at the grid points in that bin.
+ */
+static void createIntersectionOfPrimitivesWithBandWidth3d(
+  LSMLIB_REAL *phi,
+  int num_primitives,
+  LSM_INIT3D_DISTANCE_FCN distance_fcn,
+  LSMLIB_REAL **params,
+  const LSMLIB_REAL *bounding_box,
+  const signed char *orientation,
+  LSMLIB_REAL band_width,
+  Grid *grid);
+
+/* sphere distance function */
+static LSMLIB_REAL distanceToSphere3d(
+  LSMLIB_REAL **params, int l, LSMLIB_REAL x, LSMLIB_REAL y, LSMLIB_REAL z);
+
+/* cylinder distance function */
+static LSMLIB_REAL distanceToCylinder3d(
+  LSMLIB_REAL **params, int l, LSMLIB_REAL x, LSMLIB_REAL y, LSMLIB_REAL z);
+
+/* box distance function (maximum of distances to the face planes) */
+static LSMLIB_REAL distanceToBox3d(
+  LSMLIB_REAL **params, int l, LSMLIB_REAL x, LSMLIB_REAL y, LSMLIB_REAL z);
+
+
+void createIntersectionOfSpheresWithBandWidth(
+  LSMLIB_REAL *phi,
+  int num_spheres,
+  LSMLIB_REAL *center_x,
+  LSMLIB_REAL *center_y,
+  LSMLIB_REAL *center_z,
+  LSMLIB_REAL *radius,
+  int *inside_flag,
+  LSMLIB_REAL band_width,
+  Grid *grid)
+{
+  LSMLIB_REAL *params[4];
+  LSMLIB_REAL *bounding_box;
+  signed char *orientation;
+  int l;
+
+  if (band_width <= 0) {
+    createIntersectionOfSpheres(phi, num_spheres, 
+                                center_x, center_y, center_z,
+                                radius, inside_flag, grid);
+    return;
+  }
+
+  bounding_box = (LSMLIB_REAL*) malloc(6*num_spheres*sizeof(LSMLIB_REAL));
+  orientation = (signed char*) malloc(num_spheres*sizeof(signed char));
+
+  for (l = 0; l < num_spheres; l++) {
+    LSMLIB_REAL extent = fabs(radius[l]) + band_width;
+    bounding_box[6*l]   = center_x[l] - extent;
+    bounding_box[6*l+1] = center_x[l] + extent;
+    bounding_box[6*l+2] = center_y[l] - extent;
+    bounding_box[6*l+3] = center_y[l] + extent;
+    bounding_box[6*l+4] = center_z[l] - extent;
+    bounding_box[6*l+5] = center_z[l] + extent;
+    orientation[l] = (inside_flag[l] >= 0) ? -1 : 1;
+  }
+
+  params[0] = center_x; params[1] = center_y; params[2] = center_z;
+  params[3] = radius;
+  createIntersectionOfPrimitivesWithBandWidth3d(
+    phi, num_spheres, distanceToSphere3d, params,
+    bounding_box, orientation, band_width, grid);
+
+  free(bounding_box);
+  free(orientation);
+}
+
+
+void createIntersectionOfCylindersWithBandWidth(
+  LSMLIB_REAL *phi,
+  int num_cylinders,
+  LSMLIB_REAL *tangent_x,
+  LSMLIB_REAL *tangent_y,
+  LSMLIB_REAL *tangent_z,
+  LSMLIB_REAL *point_x,
+  LSMLIB_REAL *point_y,
+  LSMLIB_REAL *point_z,
+  LSMLIB_REAL *radius,
+  int *inside_flag,
+  LSMLIB_REAL band_width,
+  Grid *grid)
+{
+  LSMLIB_REAL *params[7];
+  LSMLIB_REAL *bounding_box;
+  signed char *orientation;
+  int l, dir;
+
+  if (band_width <= 0) {
+    createIntersectionOfCylinders(phi, num_cylinders, 
+                                  tangent_x, tangent_y, tangent_z,
+                                  point_x, point_y, point_z,
+                                  radius, inside_flag, grid);
+    return;
+  }
+
+  bounding_box = (LSMLIB_REAL*) malloc(6*num_cylinders*sizeof(LSMLIB_REAL));
+  orientation = (signed char*) malloc(num_cylinders*sizeof(signed char));
+
+  for (l = 0; l < num_cylinders; l++) {
+    LSMLIB_REAL extent = fabs(radius[l]) + band_width;
+    LSMLIB_REAL p[3], t[3];
+    LSMLIB_REAL norm_t;
+    LSMLIB_REAL s_min = -FLT_MAX, s_max = FLT_MAX;
+
+    p[0] = point_x[l]; p[1] = point_y[l]; p[2] = point_z[l];
+    norm_t = sqrt( tangent_x[l]*tangent_x[l] + tangent_y[l]*tangent_y[l]
+                 + tangent_z[l]*tangent_z[l] );
+    t[0] = tangent_x[l]/norm_t;
+    t[1] = tangent_y[l]/norm_t;
+    t[2] = tangent_z[l]/norm_t;
+
+    /* clip the axis of the cylinder to the ghostbox (expanded by */
+    /* extent).  grid points within extent of the axis lie within */
+    /* extent of the clipped segment.                             */
+    for (dir = 0; dir < 3; dir++) {
+      LSMLIB_REAL lo = grid->x_lo_ghostbox[dir] - extent;
+      LSMLIB_REAL hi = grid->x_hi_ghostbox[dir] + extent;
+      if (fabs(t[dir]) > 0) {
+        LSMLIB_REAL s_lo = (lo - p[dir])/t[dir];
+        LSMLIB_REAL s_hi = (hi - p[dir])/t[dir];
+        if (s_lo > s_hi) {
+          LSMLIB_REAL tmp = s_lo; s_lo = s_hi; s_hi = tmp;
+        }
+        if (s_lo > s_min) s_min = s_lo;
+        if (s_hi < s_max) s_max = s_hi;
+      } else if ( (p[dir] < lo) || (p[dir] > hi) ) {
+        s_min = 1; s_max = 0;
+      }
+    }
+
+    for (dir = 0; dir < 3; dir++) {
+      if (s_min <= s_max) {
+        LSMLIB_REAL end_0 = p[dir] + s_min*t[dir];
+        LSMLIB_REAL end_1 = p[dir] + s_max*t[dir];
+        bounding_box[6*l+2*dir]   = (end_0 < end_1 ? end_0 : end_1) - extent;
+        bounding_box[6*l+2*dir+1] = (end_0 < end_1 ? end_1 : end_0) + extent;
+      } else {
+        /* cylinder does not come within band_width of the grid */
+        bounding_box[6*l+2*dir]   = grid->x_hi_ghostbox[dir] + extent;
+        bounding_box[6*l+2*dir+1] = grid->x_lo_ghostbox[dir] - extent;
+      }
+    }
+    orientation[l] = (inside_flag[l] >= 0) ? -1 : 1;
+  }
+
+  params[0] = tangent_x; params[1] = tangent_y; params[2] = tangent_z;
+  params[3] = point_x;   params[4] = point_y;   params[5] = point_z;
+  params[6] = radius;
+  createIntersectionOfPrimitivesWithBandWidth3d(
+    phi, num_cylinders, distanceToCylinder3d, params,
+    bounding_box, orientation, band_width, grid);
+
+  free(bounding_box);
+  free(orientation);
+}
+
+
+void createIntersectionOfBoxesWithBandWidth(
+  LSMLIB_REAL *phi,
+  int num_cuboids,   
+  LSMLIB_REAL *corner_x, LSMLIB_REAL *corner_y, LSMLIB_REAL *corner_z,
+  LSMLIB_REAL *side_length_x, 
+  LSMLIB_REAL *side_length_y, 
+  LSMLIB_REAL *side_length_z,
+  int *inside_flag,
+  LSMLIB_REAL band_width,
+  Grid *grid)
+{
+  LSMLIB_REAL *params[6];
+  LSMLIB_REAL *bounding_box;
+  signed char *orientation;
+  int l;
+
+  if (band_width <= 0) {
+    createIntersectionOfBoxes(phi, num_cuboids, 
+                              corner_x, corner_y, corner_z,
+                              side_length_x, side_length_y, side_length_z,
+                              inside_flag, grid);
+    return;
+  }
+
+  bounding_box = (LSMLIB_REAL*) malloc(6*num_cuboids*sizeof(LSMLIB_REAL));
+  orientation = (signed char*) malloc(num_cuboids*sizeof(signed char));
+
+  for (l = 0; l < num_cuboids; l++) {
+    bounding_box[6*l]   = corner_x[l] - band_width;
+    bounding_box[6*l+1] = corner_x[l] + side_length_x[l] + band_width;
+    bounding_box[6*l+2] = corner_y[l] - band_width;
+    bounding_box[6*l+3] = corner_y[l] + side_length_y[l] + band_width;
+    bounding_box[6*l+4] = corner_z[l] - band_width;
+    bounding_box[6*l+5] = corner_z[l] + side_length_z[l] + band_width;
+
+    /* NOTE: same convention as createIntersectionOfBoxes() */
+    orientation[l] = (inside_flag[l] >= 1) ? -1 : 1;
+  }
+
+  params[0] = corner_x;      params[1] = corner_y;      params[2] = corner_z;
+  params[3] = side_length_x; params[4] = side_length_y; params[5] = side_length_z;
+  createIntersectionOfPrimitivesWithBandWidth3d(
+    phi, num_cuboids, distanceToBox3d, params,
+    bounding_box, orientation, band_width, grid);
+
+  free(bounding_box);
+  free(orientation);
+}
+
+
+static void createIntersectionOfPrimitivesWithBandWidth3d(
+  LSMLIB_REAL *phi,
+  int num_primitives,
+  LSM_INIT3D_DISTANCE_FCN distance_fcn,
+  LSMLIB_REAL **params,
+  const LSMLIB_REAL *bounding_box,
+  const signed char *orientation,
+  LSMLIB_REAL band_width,
+  Grid *grid)
+{
+  int n[3], num_bins_dir[3], num_bins;
+  int bin_width;
+  int *index_box;
+  int *bin_start, *bin_fill, *bin_primitives;
+  int num_outward_primitives = 0;
+  int l, dir, idx;
+  double mean_extent = 0.0;
+
+  for (dir = 0; dir < 3; dir++) n[dir] = grid->grid_dims_ghostbox[dir];
+
+  /* compute index space bounding box of each primitive */
+  index_box = (int*) malloc(6*num_primitives*sizeof(int));
+  for (l = 0; l < num_primitives; l++) {
+    int max_extent = 0;
+    int empty = 0;
+    for (dir = 0; dir < 3; dir++) {
+      LSMLIB_REAL lo = (bounding_box[6*l+2*dir] - grid->x_lo_ghostbox[dir])
+                     / grid->dx[dir];
+      LSMLIB_REAL hi = (bounding_box[6*l+2*dir+1] - grid->x_lo_ghostbox[dir])
+                     / grid->dx[dir];
+      int i_lo, i_hi;
+      if (lo < 0) lo = 0;
+      if (hi > n[dir]-1) hi = n[dir]-1;
+      i_lo = (int) ceil(lo);
+      i_hi = (int) floor(hi);
+      if (i_lo > i_hi) empty = 1;
+      index_box[6*l+2*dir]   = i_lo;
+      index_box[6*l+2*dir+1] = i_hi;
+      if (i_hi - i_lo + 1 > max_extent) max_extent = i_hi - i_lo + 1;
+    }
+    if (empty) {
+      index_box[6*l] = 1; index_box[6*l+1] = 0;
+    } else {
+      mean_extent += max_extent;
+    }
+    if (orientation[l] > 0) {
+      /* phi >= band_width everywhere if the grid does not intersect */
+      /* the bounding box of an outward oriented primitive           */
+      if (empty) {
+        SET_DATA_TO_CONSTANT(phi, grid, band_width)
+        free(index_box);
+        return;
+      }
+      num_outward_primitives++;
+    }
+  }
+
+  /* choose bin width based on the mean size of the primitives */
+  if (num_primitives > 0) mean_extent /= num_primitives;
+  bin_width = (int) mean_extent;
+  if (bin_width < LSM_INIT3D_MIN_BIN_WIDTH) {
+    bin_width = LSM_INIT3D_MIN_BIN_WIDTH;
+  }
+  if (bin_width > LSM_INIT3D_MAX_BIN_WIDTH) {
+    bin_width = LSM_INIT3D_MAX_BIN_WIDTH;
+  }
+  for (dir = 0; dir < 3; dir++) {
+    num_bins_dir[dir] = (n[dir] + bin_width - 1)/bin_width;
+  }
+  num_bins = num_bins_dir[0]*num_bins_dir[1]*num_bins_dir[2];
+
+  /* sort primitives into bins (compressed row storage) */
+  bin_start = (int*) calloc(num_bins+1, sizeof(int));
+  bin_fill = (int*) malloc(num_bins*sizeof(int));
+  for (l = 0; l < num_primitives; l++) {
+    int bi, bj, bk;
+    if (index_box[6*l] > index_box[6*l+1]) continue;
+    for (bk = index_box[6*l+4]/bin_width; 
+         bk <= index_box[6*l+5]/bin_width; bk++) {
+      for (bj = index_box[6*l+2]/bin_width; 
+           bj <= index_box[6*l+3]/bin_width; bj++) {
+        for (bi = index_box[6*l]/bin_width; 
+             bi <= index_box[6*l+1]/bin_width; bi++) {
+          int bin = bi + num_bins_dir[0]*(bj + num_bins_dir[1]*bk);
+          bin_start[bin+1]++;
+        }
+      }
+    }
+  }
+  for (idx = 0; idx < num_bins; idx++) {
+    bin_start[idx+1] += bin_start[idx];
+    bin_fill[idx] = bin_start[idx];
+  }
+  bin_primitives = (int*) malloc((bin_start[num_bins]+1)*sizeof(int));
+  for (l = 0; l < num_primitives; l++) {
+    int bi, bj, bk;
+    if (index_box[6*l] > index_box[6*l+1]) continue;
+    for (bk = index_box[6*l+4]/bin_width; 
+         bk <= index_box[6*l+5]/bin_width; bk++) {
+      for (bj = index_box[6*l+2]/bin_width; 
+           bj <= index_box[6*l+3]/bin_width; bj++) {
+        for (bi = index_box[6*l]/bin_width; 
+             bi <= index_box[6*l+1]/bin_width; bi++) {
+          int bin = bi + num_bins_dir[0]*(bj + num_bins_dir[1]*bk);
+          bin_primitives[bin_fill[bin]++] = l;
+        }
+      }
+    }
+  }
+
+  /* compute phi bin by bin */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (idx = 0; idx < num_bins; idx++) {
+    int bi = idx%num_bins_dir[0];
+    int bj = (idx/num_bins_dir[0])%num_bins_dir[1];
+    int bk = idx/(num_bins_dir[0]*num_bins_dir[1]);
+    int i_lo = bi*bin_width, i_hi = i_lo + bin_width - 1;
+    int j_lo = bj*bin_width, j_hi = j_lo + bin_width - 1;
+    int k_lo = bk*bin_width, k_hi = k_lo + bin_width - 1;
+    const int *candidates = bin_primitives + bin_start[idx];
+    int num_candidates = bin_start[idx+1] - bin_start[idx];
+    int i, j, k, c;
+
+    if (i_hi > n[0]-1) i_hi = n[0]-1;
+    if (j_hi > n[1]-1) j_hi = n[1]-1;
+    if (k_hi > n[2]-1) k_hi = n[2]-1;
+
+    for (k = k_lo; k <= k_hi; k++) {
+      for (j = j_lo; j <= j_hi; j++) {
+        for (i = i_lo; i <= i_hi; i++) {
+          int grid_idx = i + n[0]*(j + n[1]*k);
+          LSMLIB_REAL x = grid->x_lo_ghostbox[0] + grid->dx[0]*i;
+          LSMLIB_REAL y = grid->x_lo_ghostbox[1] + grid->dx[1]*j;
+          LSMLIB_REAL z = grid->x_lo_ghostbox[2] + grid->dx[2]*k;
+          LSMLIB_REAL max = -band_width;
+          int num_outward = 0;
+
+          for (c = 0; c < num_candidates; c++) {
+            int p = candidates[c];
+            const int *box = index_box + 6*p;
+            LSMLIB_REAL dist;
+
+            /* skip primitives whose bounding box excludes the point */
+            if ( (i < box[0]) || (i > box[1]) || 
+                 (j < box[2]) || (j > box[3]) ||
+                 (k < box[4]) || (k > box[5]) ) {
+              continue;
+            }
+
+            dist = orientation[p]*distance_fcn(params, p, x, y, z);
+            if (orientation[p] > 0) num_outward++;
+            if (dist > max) {
+              max = dist;
+              if (max >= band_width) break;
+            }
+          }
+
+          /* the point lies outside the bounding box of at least one */
+          /* outward oriented primitive                              */
+          if (num_outward < num_outward_primitives) max = band_width;
+
+          if (max > band_width) max = band_width;
+          phi[grid_idx] = max;
+        }
+      }
+    }
+  } /* end loop over bins */
+
+  free(index_box);
+  free(bin_start);
+  free(bin_fill);
+  free(bin_primitives);
+}
+
+
+static LSMLIB_REAL distanceToSphere3d(
+  LSMLIB_REAL **params, int l, LSMLIB_REAL x, LSMLIB_REAL y, LSMLIB_REAL z)
+{
+  LSMLIB_REAL dx = x - params[0][l];
+  LSMLIB_REAL dy = y - params[1][l];
+  LSMLIB_REAL dz = z - params[2][l];
+  return sqrt(dx*dx + dy*dy + dz*dz) - params[3][l];
+}
+
+
+static LSMLIB_REAL distanceToCylinder3d(
+  LSMLIB_REAL **params, int l, LSMLIB_REAL x, LSMLIB_REAL y, LSMLIB_REAL z)
+{
+  LSMLIB_REAL tx = params[0][l], ty = params[1][l], tz = params[2][l];
+  LSMLIB_REAL dx = x - params[3][l];
+  LSMLIB_REAL dy = y - params[4][l];
+  LSMLIB_REAL dz = z - params[5][l];
+  LSMLIB_REAL norm_sq_x_minus_p = dx*dx + dy*dy + dz*dz;
+  LSMLIB_REAL x_minus_p_dot_tangent = (dx*tx + dy*ty + dz*tz)
+                                    / sqrt(tx*tx + ty*ty + tz*tz);
+  return sqrt( norm_sq_x_minus_p 
+             - x_minus_p_dot_tangent*x_minus_p_dot_tangent) - params[6][l];
+}
+
+
+static LSMLIB_REAL distanceToBox3d(
+  LSMLIB_REAL **params, int l, LSMLIB_REAL x, LSMLIB_REAL y, LSMLIB_REAL z)
+{
+  LSMLIB_REAL dist = params[0][l] - x;
+  LSMLIB_REAL tmp;
+  tmp = x - (params[0][l] + params[3][l]); if (tmp > dist) dist = tmp;
+  tmp = params[1][l] - y;                  if (tmp > dist) dist = tmp;
+  tmp = y - (params[1][l] + params[4][l]); if (tmp > dist) dist = tmp;
+  tmp = params[2][l] - z;                  if (tmp > dist) dist = tmp;
+  tmp = z - (params[2][l] + params[5][l]); if (tmp > dist) dist = tmp;
+  return dist;
+}
@@ -605,6 +605,144 @@ void  createIntersectionOfBoxes(
   Grid *grid);     
 
 
+/*!
+ * createIntersectionOfSpheresWithBandWidth() computes the same level 
+ * set function as createIntersectionOfSpheres() within band_width of 
+ * the zero level set.  Outside of this band, phi is set equal to 
+ * +/- band_width.
+ *
+ * Arguments:
+ *  - phi (out):         level set function 
+ *  - num_spheres (in):  number of spheres
+ *  - center_x (in):     array containing the x-coordinates of the centers
+ *                       of the spheres 
+ *  - center_y (in):     array containing the y-coordinates of the centers
+ *                       of the spheres 
+ *  - center_z (in):     array containing the z-coordinates of the centers
+ *                       of the spheres 
+ *  - radius (in):       array containing the radii of the spheres
+ *  - inside_flag (in):  array containing the flags indicating whether the
+ *                       inside or outside of each sphere should be the
+ *                       region associated with negative values of the
+ *                       level set function (see 
+ *                       createIntersectionOfSpheres())
+ *  - band_width (in):   width of band around the zero level set within
+ *                       which phi is computed.  If band_width is 
+ *                       non-positive, createIntersectionOfSpheres() is 
+ *                       used to compute phi.
+ *  - grid (in):         pointer to Grid data structure
+ *
+ * Return value:         none
+ *
+ * NOTES:
+ * - The spheres are sorted into a uniform grid of bins, and phi at each
+ *   grid point is computed using only the spheres that come within 
+ *   band_width of the bin containing the grid point.  The cost is 
+ *   proportional to the number of grid points plus the number of grid 
+ *   points within band_width of each sphere (rather than the product 
+ *   of the number of grid points and the number of spheres).
+ *
+ * - When LSMLIB is built with OpenMP support, the bins are distributed
+ *   across threads.
+ *
+ * - Is it the user's responsbility to ensure that memory for phi
+ *   has been allocated.
+ *
+ */
+void createIntersectionOfSpheresWithBandWidth(
+  LSMLIB_REAL *phi, int num_spheres,
+  LSMLIB_REAL *center_x, LSMLIB_REAL *center_y, LSMLIB_REAL *center_z,
+  LSMLIB_REAL *radius, 
+  int *inside_flag,
+  LSMLIB_REAL band_width,
+  Grid *grid);
+
+
+/*!
+ * createIntersectionOfCylindersWithBandWidth() computes the same level 
+ * set function as createIntersectionOfCylinders() within band_width of 
+ * the zero level set.  Outside of this band, phi is set equal to 
+ * +/- band_width.
+ *
+ * Arguments:
+ *  - phi (out):           level set function 
+ *  - num_cylinders (in):  number of cylinders
+ *  - tangent_* (in):      arrays containing the components of the 
+ *                         vectors that define the directions of the 
+ *                         axes of the cylinders
+ *  - point_* (in):        arrays containing the coordinates of points 
+ *                         that lie on the axes of the cylinders
+ *  - radius (in):         array containing the radii of the cylinders
+ *  - inside_flag (in):    array containing the flags indicating whether 
+ *                         the inside or outside of each cylinder should 
+ *                         be the region associated with negative values 
+ *                         of the level set function (see 
+ *                         createIntersectionOfCylinders())
+ *  - band_width (in):     width of band around the zero level set within
+ *                         which phi is computed.  If band_width is 
+ *                         non-positive, createIntersectionOfCylinders() 
+ *                         is used to compute phi.
+ *  - grid (in):           pointer to Grid data structure
+ *
+ * Return value:           none
+ *
+ * NOTES:
+ * - See NOTES for createIntersectionOfSpheresWithBandWidth().  The 
+ *   bin that each cylinder is sorted into is determined by the 
+ *   portion of the cylinder that lies within the computational grid.
+ *
+ */
+void createIntersectionOfCylindersWithBandWidth(
+  LSMLIB_REAL *phi, int num_cylinders,
+  LSMLIB_REAL *tangent_x, LSMLIB_REAL *tangent_y, LSMLIB_REAL *tangent_z,
+  LSMLIB_REAL *point_x, LSMLIB_REAL *point_y, LSMLIB_REAL *point_z,
+  LSMLIB_REAL *radius, 
+  int *inside_flag,
+  LSMLIB_REAL band_width,
+  Grid *grid);
+
+
+/*!
+ * createIntersectionOfBoxesWithBandWidth() computes the same level 
+ * set function as createIntersectionOfBoxes() within band_width of 
+ * the zero level set.  Outside of this band, phi is set equal to 
+ * +/- band_width.
+ *
+ * Arguments:
+ *  - phi (out):           level set function 
+ *  - num_cuboids (in):    number of cuboids
+ *  - corner_* (in):       arrays containing the coordinates of the lower
+ *                         corner of each cuboid
+ *  - side_length_* (in):  arrays containing the side lengths of the 
+ *                         cuboids
+ *  - inside_flag (in):    flag indicating whether the inside or outside of 
+ *                         each cuboid should be the region associated with 
+ *                         negative values of the level set function (see
+ *                         createIntersectionOfBoxes())
+ *  - band_width (in):     width of band around the zero level set within
+ *                         which phi is computed.  If band_width is 
+ *                         non-positive, createIntersectionOfBoxes() is 
+ *                         used to compute phi.
+ *  - grid (in):           pointer to Grid data structure 
+ *
+ * Return value:           none
+ *
+ * NOTES:
+ * - See NOTES for createIntersectionOfSpheresWithBandWidth().
+ *
+ */
+void createIntersectionOfBoxesWithBandWidth(
+  LSMLIB_REAL *phi,
+  int num_cuboids,   
+  LSMLIB_REAL *corner_x, LSMLIB_REAL *corner_y, LSMLIB_REAL *corner_z,
+  LSMLIB_REAL *side_length_x, 
+  LSMLIB_REAL *side_length_y, 
+  LSMLIB_REAL *side_length_z,
+  int *inside_flag,
+  LSMLIB_REAL band_width,
+  Grid *grid);     
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,170 @@
+/*
+ * File:        lsm_mesh_extraction.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for extracting meshes of the zero
+ *              level set
+ */
+
+#include <stdlib.h>
+
+#include "lsm_mesh_extraction.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+/*============================= Constants ===========================*/
+
+/*
+ * Vertices are welded if their coordinates agree to within
+ * LSM_MESH_EXTRACTION_WELD_TOL times the smallest grid spacing.
+ */
+#define LSM_MESH_EXTRACTION_WELD_TOL     (1.e-6)
+
+
+/*================== Helper Functions Declarations ==================*/
+
+/*
+ * extractMesh3d() extracts the zero level set of phi (when psi is NULL)
+ * or the {phi=0,psi=0} curves (when psi is not NULL).
+ */
+static LSM_Mesh *extractMesh3d(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *psi,
+  unsigned char *narrow_band,
+  Grid *grid);
+
+
+/*==================== Function Definitions =========================*/
+
+LSM_Mesh *extractZeroLevelSetMesh3d(
+  LSMLIB_REAL *phi,
+  unsigned char *narrow_band,
+  Grid *grid)
+{
+  return extractMesh3d(phi, NULL, narrow_band, grid);
+}
+
+
+LSM_Mesh *extractZeroLevelSetCurveMesh3d(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *psi,
+  unsigned char *narrow_band,
+  Grid *grid)
+{
+  return extractMesh3d(phi, psi, narrow_band, grid);
+}
+
+
+/*==================== Helper Functions Definitions =================*/
+
+static LSM_Mesh *extractMesh3d(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *psi,
+  unsigned char *narrow_band,
+  Grid *grid)
+{
+  int num_vertices_per_element = psi ? 2 : 3;
+  LSM_Mesh *mesh;
+  LSM_Mesh **slab_meshes;
+  int num_slabs = 1;
+  int error = 0;
+  int s;
+  LSMLIB_REAL weld_tol;
+
+  /* lower corners of grid cells in the interior of the domain (the */
+  /* interior is offset from the ghostbox by the number of          */
+  /* ghostcells; the fillbox is not the interior of the grid for all */
+  /* spatial derivative accuracy types)                              */
+  int ilo_cb = grid->ilo_gb
+             + (grid->grid_dims_ghostbox[0] - grid->grid_dims[0])/2;
+  int ihi_cb = ilo_cb + grid->grid_dims[0] - 2;
+  int jlo_cb = grid->jlo_gb
+             + (grid->grid_dims_ghostbox[1] - grid->grid_dims[1])/2;
+  int jhi_cb = jlo_cb + grid->grid_dims[1] - 2;
+  int klo_cb = grid->klo_gb
+             + (grid->grid_dims_ghostbox[2] - grid->grid_dims[2])/2;
+  int khi_cb = klo_cb + grid->grid_dims[2] - 2;
+  int num_cells_z = khi_cb - klo_cb + 1;
+
+  mesh = LSM_createMesh(num_vertices_per_element);
+  if (!mesh) return NULL;
+  if (num_cells_z <= 0) return mesh;
+
+#ifdef _OPENMP
+  num_slabs = omp_get_max_threads();
+  if (num_slabs > num_cells_z) num_slabs = num_cells_z;
+#endif
+
+  slab_meshes = (LSM_Mesh**) calloc(num_slabs, sizeof(LSM_Mesh*));
+  if (!slab_meshes) {
+    LSM_destroyMesh(mesh);
+    return NULL;
+  }
+
+  /* extract mesh from each slab of grid cells */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static,1)
+#endif
+  for (s = 0; s < num_slabs; s++) {
+    int klo_slab = klo_cb + (s*num_cells_z)/num_slabs;
+    int khi_slab = klo_cb + ((s+1)*num_cells_z)/num_slabs - 1;
+    int count;
+
+    slab_meshes[s] = LSM_createMesh(num_vertices_per_element);
+    if (!slab_meshes[s]) {
+      error = 1;
+      continue;
+    }
+
+    if (psi) {
+      count = LSM3D_extractZeroLevelSetCurveSegments(
+        slab_meshes[s], phi, psi, narrow_band,
+        grid->ilo_gb, grid->ihi_gb,
+        grid->jlo_gb, grid->jhi_gb,
+        grid->klo_gb, grid->khi_gb,
+        ilo_cb, ihi_cb,
+        jlo_cb, jhi_cb,
+        klo_slab, khi_slab,
+        grid->x_lo_ghostbox,
+        grid->dx[0], grid->dx[1], grid->dx[2]);
+    } else {
+      count = LSM3D_extractZeroLevelSetTriangles(
+        slab_meshes[s], phi, narrow_band,
+        grid->ilo_gb, grid->ihi_gb,
+        grid->jlo_gb, grid->jhi_gb,
+        grid->klo_gb, grid->khi_gb,
+        ilo_cb, ihi_cb,
+        jlo_cb, jhi_cb,
+        klo_slab, khi_slab,
+        grid->x_lo_ghostbox,
+        grid->dx[0], grid->dx[1], grid->dx[2]);
+    }
+    if (count < 0) error = 1;
+  }
+
+  /* merge slab meshes (in slab order so the result does not depend */
+  /* on the number of threads) and weld vertices                    */
+  for (s = 0; s < num_slabs; s++) {
+    if ( !error && LSM_appendMesh(mesh, slab_meshes[s]) ) error = 1;
+    LSM_destroyMesh(slab_meshes[s]);
+  }
+  free(slab_meshes);
+
+  weld_tol = grid->dx[0];
+  if (grid->dx[1] < weld_tol) weld_tol = grid->dx[1];
+  if (grid->dx[2] < weld_tol) weld_tol = grid->dx[2];
+  weld_tol *= LSM_MESH_EXTRACTION_WELD_TOL;
+
+  if ( error || LSM_weldMeshVertices(mesh, weld_tol) ) {
+    LSM_destroyMesh(mesh);
+    return NULL;
+  }
+
+  return mesh;
+}
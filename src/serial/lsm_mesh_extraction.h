@@ -0,0 +1,105 @@
+/*
+ * File:        lsm_mesh_extraction.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for extracting meshes of the zero level set
+ */
+
+#ifndef INCLUDED_LSM_MESH_EXTRACTION_H
+#define INCLUDED_LSM_MESH_EXTRACTION_H
+
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lsm_grid.h"
+#include "lsm_mesh3d.h"
+
+
+/*! \file lsm_mesh_extraction.h
+ *
+ * \brief
+ * @ref lsm_mesh_extraction.h provides functions for extracting triangle
+ * meshes of the zero level set of \f$ \phi \f$ (and line segment meshes
+ * of \f$ \{ \phi=0,\psi=0 \} \f$ curves) in three space dimensions.
+ * The meshes can be written to compact binary files using
+ * LSM_writeMeshToBinaryFile(), which is typically much cheaper than
+ * saving the entire \f$ \phi \f$ array for visualization.
+ *
+ * When LSMLIB is built with OpenMP support, the grid is split into
+ * slabs in the z-direction that are processed by different threads.
+ * The meshes from all slabs are merged and welded so that each vertex
+ * of the final mesh is shared by all of the elements that touch it.
+ *
+ */
+
+
+/*!
+ * extractZeroLevelSetMesh3d() computes a welded triangle mesh of the
+ * zero level set of \f$ \phi \f$ using marching tetrahedra.
+ *
+ * Arguments:
+ *  - phi (in):          level set function
+ *  - narrow_band (in):  narrow band marks (may be NULL).  When provided,
+ *                       only grid cells whose lower corner lies in the
+ *                       narrow band (i.e. has a nonzero mark) are
+ *                       processed.
+ *  - grid (in):         pointer to Grid data structure
+ *
+ * Return value:         pointer to new triangle mesh; NULL if memory
+ *                       allocation fails
+ *
+ * NOTES:
+ *  - Only grid cells with all corners in the interior of the
+ *    computational domain (i.e. not in the ghostcells) are processed.
+ *
+ *  - When narrow_band is provided, it should contain all grid points
+ *    within one grid cell diagonal of the zero level set.
+ *
+ *  - The mesh should be freed using LSM_destroyMesh().
+ *
+ */
+LSM_Mesh *extractZeroLevelSetMesh3d(
+  LSMLIB_REAL *phi,
+  unsigned char *narrow_band,
+  Grid *grid);
+
+
+/*!
+ * extractZeroLevelSetCurveMesh3d() computes a welded line segment mesh
+ * of the \f$ \{ \phi=0,\psi=0 \} \f$ curves (codimension-two zero level
+ * set) using LSM3D_findLineInTetrahedron().
+ *
+ * Arguments:
+ *  - phi (in):          level set function
+ *  - psi (in):          level set function
+ *  - narrow_band (in):  see extractZeroLevelSetMesh3d()
+ *  - grid (in):         pointer to Grid data structure
+ *
+ * Return value:         pointer to new line segment mesh; NULL if memory
+ *                       allocation fails
+ *
+ * NOTES:
+ *  - Each segment is oriented in the direction of
+ *    \f$ \nabla \phi \times \nabla \psi \f$.
+ *
+ *  - The mesh should be freed using LSM_destroyMesh().
+ *
+ */
+LSM_Mesh *extractZeroLevelSetCurveMesh3d(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *psi,
+  unsigned char *narrow_band,
+  Grid *grid);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,1129 @@
+/*
+ * File:        lsm_multiphase.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for batched evolution of multiple
+ *              level set functions (multiphase problems) for serial
+ *              calculations
+ */
+
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+#include "lsm_multiphase.h"
+#include "lsm_boundary_conditions.h"
+#include "lsm_instrumentation.h"
+#include "lsm_kernel_backends.h"
+#include "lsm_level_set_evolution2d.h"
+#include "lsm_level_set_evolution2d_local.h"
+#include "lsm_level_set_evolution3d.h"
+#include "lsm_level_set_evolution3d_local.h"
+#include "lsm_localization2d.h"
+#include "lsm_localization3d.h"
+#include "lsm_reinitialization2d.h"
+#include "lsm_reinitialization2d_local.h"
+#include "lsm_reinitialization3d.h"
+#include "lsm_reinitialization3d_local.h"
+#include "lsm_spatial_derivatives2d.h"
+#include "lsm_spatial_derivatives2d_local.h"
+#include "lsm_spatial_derivatives3d.h"
+#include "lsm_spatial_derivatives3d_local.h"
+
+
+/*============================= Constants ===========================*/
+
+/* marks for boundary layers of the narrow band (see localization) */
+static const unsigned char s_mark_gb = 127;
+static const unsigned char s_mark_D1 = 126;
+static const unsigned char s_mark_D2 = 125;
+static const unsigned char s_mark_fb = 124;
+
+/* CFL number for pseudo-time steps of the reinitialization equation */
+#define LSM_MULTIPHASE_REINIT_CFL_NUMBER     (0.5)
+
+/* boundary condition types for the boundary-aware HJ ENO/WENO kernels */
+#define LSM_MULTIPHASE_BDRY_TYPE_STORED          (0)
+#define LSM_MULTIPHASE_BDRY_TYPE_SIGNED_LINEAR   (3)
+
+/* index space arguments for toolbox kernels */
+#define GB2D(g)  &((g)->ilo_gb), &((g)->ihi_gb), &((g)->jlo_gb), &((g)->jhi_gb)
+#define FB2D(g)  &((g)->ilo_fb), &((g)->ihi_fb), &((g)->jlo_fb), &((g)->jhi_fb)
+#define GB3D(g)  GB2D(g), &((g)->klo_gb), &((g)->khi_gb)
+#define FB3D(g)  FB2D(g), &((g)->klo_fb), &((g)->khi_fb)
+#define DX2D(g)  &((g)->dx[0]), &((g)->dx[1])
+#define DX3D(g)  DX2D(g), &((g)->dx[2])
+
+
+/*================== Helper Functions Declarations ==================*/
+
+/*
+ * setFillboxUpdatePoints() sets the list of grid points updated by
+ * the batched loops to all points in the fillbox.
+ */
+static void setFillboxUpdatePoints(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid);
+
+/*
+ * setBdryTypes() sets the boundary condition types for the
+ * boundary-aware HJ ENO/WENO kernels (see LSM3D_HJ_ENO1_BDRY()) to
+ * signed linear extrapolation at the boundaries selected by
+ * bdry_location_idx and to "use stored ghostcell values" at all other
+ * boundaries.  If bdry_location_idx is negative, stored ghostcell
+ * values are used at all boundaries.
+ */
+static void setBdryTypes(
+  int bdry_location_idx,
+  int *bdry_types);
+
+/*
+ * computeOneSidedDerivatives() computes the forward and backward HJ
+ * ENO/WENO approximations to grad(phi) for a single phase (stored in
+ * the shared scratch arrays).  For full grid calculations, boundary
+ * conditions are imposed on the fly at the boundaries where bdry_types
+ * is nonzero, so the ghostcells of phi are not read there.
+ */
+static int computeOneSidedDerivatives(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid,
+  LSMLIB_REAL *phi,
+  int spatial_derivative_order,
+  const int *bdry_types);
+
+/*
+ * computeLevelSetEqnRHS() computes the right-hand sides of the level
+ * set equations for all phases (see computeMultiphaseLevelSetEqnRHS()).
+ */
+static int computeLevelSetEqnRHS(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid,
+  LSMLIB_REAL *phi,
+  int spatial_derivative_order,
+  const int *bdry_types);
+
+/*
+ * zeroMultiphaseRHS() sets the right-hand sides of all phases to zero
+ * at all update points.
+ */
+static void zeroMultiphaseRHS(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid);
+
+/*
+ * updateMultiphaseStage() computes a TVD Runge-Kutta stage for all
+ * phases:
+ *
+ *   u_out = alpha*u_cur + (1-alpha)*(u_stage + dt*lse_rhs)
+ *
+ * u_out may be the same array as u_cur or u_stage.
+ */
+static void updateMultiphaseStage(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid,
+  LSMLIB_REAL *u_out,
+  const LSMLIB_REAL *u_cur,
+  const LSMLIB_REAL *u_stage,
+  LSMLIB_REAL alpha,
+  LSMLIB_REAL dt);
+
+/*
+ * computeMultiphaseReinitializationRHS() computes the right-hand
+ * sides of the reinitialization equations for all phases.
+ */
+static int computeMultiphaseReinitializationRHS(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *phi0,
+  int spatial_derivative_order,
+  const int *bdry_types);
+
+
+/*==================== Function Definitions =========================*/
+
+LSM_MultiphaseDataArrays *createMultiphaseDataArrays(
+  int num_phases,
+  Grid *grid,
+  int use_narrow_band)
+{
+  LSM_MultiphaseDataArrays *m;
+  int num_gridpts = grid->num_gridpts;
+  size_t phase_size = ((size_t) num_phases)*num_gridpts*sizeof(LSMLIB_REAL);
+  size_t field_size = num_gridpts*sizeof(LSMLIB_REAL);
+
+  if ( (num_phases < 1) ||
+       ((grid->num_dims != 2) && (grid->num_dims != 3)) ) {
+    return NULL;
+  }
+
+  m = (LSM_MultiphaseDataArrays*) calloc(1, sizeof(LSM_MultiphaseDataArrays));
+  if (!m) return NULL;
+
+  m->num_phases = num_phases;
+  m->use_narrow_band = use_narrow_band;
+
+  /* stacked arrays */
+  m->phi = (LSMLIB_REAL*) malloc(phase_size);
+  m->phi_stage1 = (LSMLIB_REAL*) malloc(phase_size);
+  m->phi_stage2 = (LSMLIB_REAL*) malloc(phase_size);
+  m->lse_rhs = (LSMLIB_REAL*) calloc(((size_t) num_phases)*num_gridpts,
+                                     sizeof(LSMLIB_REAL));
+
+  /* shared velocity field */
+  m->external_velocity_x = (LSMLIB_REAL*) calloc(num_gridpts,
+                                                 sizeof(LSMLIB_REAL));
+  m->external_velocity_y = (LSMLIB_REAL*) calloc(num_gridpts,
+                                                 sizeof(LSMLIB_REAL));
+  m->external_velocity_z = (LSMLIB_REAL*) calloc(num_gridpts,
+                                                 sizeof(LSMLIB_REAL));
+  m->normal_velocity = (LSMLIB_REAL*) calloc(num_gridpts,
+                                             sizeof(LSMLIB_REAL));
+
+  /* shared scratch space */
+  m->phi_x_plus = (LSMLIB_REAL*) malloc(field_size);
+  m->phi_y_plus = (LSMLIB_REAL*) malloc(field_size);
+  m->phi_z_plus = (LSMLIB_REAL*) malloc(field_size);
+  m->phi_x_minus = (LSMLIB_REAL*) malloc(field_size);
+  m->phi_y_minus = (LSMLIB_REAL*) malloc(field_size);
+  m->phi_z_minus = (LSMLIB_REAL*) malloc(field_size);
+  m->D1 = (LSMLIB_REAL*) malloc(field_size);
+  m->D2 = (LSMLIB_REAL*) malloc(field_size);
+  m->D3 = (LSMLIB_REAL*) malloc(field_size);
+
+  /* list of grid points updated by batched loops */
+  m->update_pts = (int*) malloc(num_gridpts*sizeof(int));
+
+  /* union narrow band */
+  if (use_narrow_band) {
+    m->phi_min_abs = (LSMLIB_REAL*) malloc(field_size);
+    m->narrow_band = (unsigned char*) calloc(num_gridpts,
+                                             sizeof(unsigned char));
+    m->index_x = (int*) malloc(num_gridpts*sizeof(int));
+    m->index_y = (int*) malloc(num_gridpts*sizeof(int));
+    m->index_z = (int*) malloc(num_gridpts*sizeof(int));
+    m->index_outer_pts = (int*) malloc(num_gridpts*sizeof(int));
+  }
+
+  if ( !m->phi || !m->phi_stage1 || !m->phi_stage2 || !m->lse_rhs ||
+       !m->external_velocity_x || !m->external_velocity_y ||
+       !m->external_velocity_z || !m->normal_velocity ||
+       !m->phi_x_plus || !m->phi_y_plus || !m->phi_z_plus ||
+       !m->phi_x_minus || !m->phi_y_minus || !m->phi_z_minus ||
+       !m->D1 || !m->D2 || !m->D3 || !m->update_pts ||
+       (use_narrow_band &&
+        (!m->phi_min_abs || !m->narrow_band || !m->index_x ||
+         !m->index_y || !m->index_z || !m->index_outer_pts)) ) {
+    destroyMultiphaseDataArrays(m);
+    return NULL;
+  }
+
+  /* until the narrow band is built, the batched loops cover the */
+  /* entire fillbox                                               */
+  setFillboxUpdatePoints(m, grid);
+
+  return m;
+}
+
+
+void destroyMultiphaseDataArrays(LSM_MultiphaseDataArrays *multiphase_arrays)
+{
+  LSM_MultiphaseDataArrays *m = multiphase_arrays;
+  if (!m) return;
+
+  free(m->phi);
+  free(m->phi_stage1);
+  free(m->phi_stage2);
+  free(m->lse_rhs);
+  free(m->external_velocity_x);
+  free(m->external_velocity_y);
+  free(m->external_velocity_z);
+  free(m->normal_velocity);
+  free(m->phi_x_plus);
+  free(m->phi_y_plus);
+  free(m->phi_z_plus);
+  free(m->phi_x_minus);
+  free(m->phi_y_minus);
+  free(m->phi_z_minus);
+  free(m->D1);
+  free(m->D2);
+  free(m->D3);
+  free(m->update_pts);
+  free(m->phi_min_abs);
+  free(m->narrow_band);
+  free(m->index_x);
+  free(m->index_y);
+  free(m->index_z);
+  free(m->index_outer_pts);
+  free(m);
+}
+
+
+int determineMultiphaseNarrowBand(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid,
+  LSMLIB_REAL beta,
+  LSMLIB_REAL gamma)
+{
+  LSM_MultiphaseDataArrays *m = multiphase_arrays;
+  int num_gridpts = grid->num_gridpts;
+  int nlo_index = 0, nhi_index = num_gridpts - 1;
+  int nlo_index_outer = 0, nhi_index_outer = num_gridpts - 1;
+  int level = LSM_MULTIPHASE_NUM_NB_LEVELS;
+  int nx = grid->grid_dims_ghostbox[0];
+  int nxy = nx*grid->grid_dims_ghostbox[1];
+  int idx, n;
+  LSM_INSTRUMENTATION_START(t_start);
+
+  if (!m->use_narrow_band) {
+    return LSM_MULTIPHASE_ERR_NARROW_BAND_NOT_ALLOCATED;
+  }
+
+  m->beta = beta;
+  m->gamma = gamma;
+
+  /* distance to the nearest zero level set (single pass over all */
+  /* phases)                                                       */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (idx = 0; idx < num_gridpts; idx++) {
+    LSMLIB_REAL phi_min_abs = fabs(m->phi[idx]);
+    int p;
+    for (p = 1; p < m->num_phases; p++) {
+      LSMLIB_REAL abs_phi = fabs(m->phi[p*num_gridpts + idx]);
+      if (abs_phi < phi_min_abs) phi_min_abs = abs_phi;
+    }
+    m->phi_min_abs[idx] = phi_min_abs;
+  }
+
+  if (grid->num_dims == 3) {
+    LSM3D_DETERMINE_NARROW_BAND(m->phi_min_abs, GB3D(grid),
+      m->narrow_band, GB3D(grid),
+      m->index_x, m->index_y, m->index_z,
+      &nlo_index, &nhi_index,
+      m->n_lo, m->n_hi,
+      m->index_outer_pts,
+      &nlo_index_outer, &nhi_index_outer,
+      &(m->nlo_outer_plus), &(m->nhi_outer_plus),
+      &(m->nlo_outer_minus), &(m->nhi_outer_minus),
+      &gamma, &beta, &level);
+
+    LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER(m->narrow_band, GB3D(grid),
+      &(grid->ilo_D2_fb), &(grid->ihi_D2_fb),
+      &(grid->jlo_D2_fb), &(grid->jhi_D2_fb),
+      &(grid->klo_D2_fb), &(grid->khi_D2_fb),
+      &s_mark_D2);
+    LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER(m->narrow_band, GB3D(grid),
+      &(grid->ilo_D1_fb), &(grid->ihi_D1_fb),
+      &(grid->jlo_D1_fb), &(grid->jhi_D1_fb),
+      &(grid->klo_D1_fb), &(grid->khi_D1_fb),
+      &s_mark_D1);
+    LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER(m->narrow_band, GB3D(grid),
+      GB3D(grid),
+      &s_mark_gb);
+  } else {
+    LSM2D_DETERMINE_NARROW_BAND(m->phi_min_abs, GB2D(grid),
+      m->narrow_band, GB2D(grid),
+      m->index_x, m->index_y,
+      &nlo_index, &nhi_index,
+      m->n_lo, m->n_hi,
+      m->index_outer_pts,
+      &nlo_index_outer, &nhi_index_outer,
+      &(m->nlo_outer_plus), &(m->nhi_outer_plus),
+      &(m->nlo_outer_minus), &(m->nhi_outer_minus),
+      &gamma, &beta, &level);
+
+    LSM2D_MARK_NARROW_BAND_BOUNDARY_LAYER(m->narrow_band, GB2D(grid),
+      &(grid->ilo_D2_fb), &(grid->ihi_D2_fb),
+      &(grid->jlo_D2_fb), &(grid->jhi_D2_fb),
+      &s_mark_D2);
+    LSM2D_MARK_NARROW_BAND_BOUNDARY_LAYER(m->narrow_band, GB2D(grid),
+      &(grid->ilo_D1_fb), &(grid->ihi_D1_fb),
+      &(grid->jlo_D1_fb), &(grid->jhi_D1_fb),
+      &s_mark_D1);
+    LSM2D_MARK_NARROW_BAND_BOUNDARY_LAYER(m->narrow_band, GB2D(grid),
+      GB2D(grid),
+      &s_mark_gb);
+  }
+
+  /* the batched loops cover all levels of the narrow band */
+  m->num_update_pts = 0;
+  if (m->n_hi[0] >= m->n_lo[0]) {
+    for (n = m->n_lo[0]; n <= m->n_hi[level]; n++) {
+      int k = (grid->num_dims == 3) ? m->index_z[n] - grid->klo_gb : 0;
+      m->update_pts[m->num_update_pts++] =
+        (m->index_x[n] - grid->ilo_gb) + (m->index_y[n] - grid->jlo_gb)*nx
+      + k*nxy;
+    }
+  }
+
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_NARROW_BAND_REBUILD,
+    t_start, (m->num_phases + 2)*num_gridpts*sizeof(LSMLIB_REAL),
+    num_gridpts);
+
+  return LSM_MULTIPHASE_ERR_SUCCESS;
+}
+
+
+void fillMultiphaseGhostCells(
+  LSMLIB_REAL *data,
+  int num_phases,
+  Grid *grid,
+  int bdry_location_idx)
+{
+  int p;
+  for (p = 0; p < num_phases; p++) {
+    signedLinearExtrapolationBC(LSM_MULTIPHASE_PHASE_DATA(data, p, grid),
+                                grid, bdry_location_idx);
+  }
+}
+
+
+LSMLIB_REAL computeMultiphaseStableDt(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid,
+  LSMLIB_REAL cfl_number)
+{
+  LSM_MultiphaseDataArrays *m = multiphase_arrays;
+  int num_dims = grid->num_dims;
+  LSMLIB_REAL inv_dx[3] = {0.0, 0.0, 0.0};
+  LSMLIB_REAL inv_dx_norm = 0.0;
+  LSMLIB_REAL max_H = 0.0;
+  int dir;
+
+  for (dir = 0; dir < num_dims; dir++) {
+    inv_dx[dir] = 1.0/grid->dx[dir];
+    inv_dx_norm += inv_dx[dir]*inv_dx[dir];
+  }
+  inv_dx_norm = sqrt(inv_dx_norm);
+
+  /* the velocity field is shared, so a single pass suffices */
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    LSMLIB_REAL max_H_local = 0.0;
+    int n_local;
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (n_local = 0; n_local < m->num_update_pts; n_local++) {
+      int idx = m->update_pts[n_local];
+      LSMLIB_REAL H = fabs(m->external_velocity_x[idx])*inv_dx[0]
+                    + fabs(m->external_velocity_y[idx])*inv_dx[1]
+                    + fabs(m->normal_velocity[idx])*inv_dx_norm;
+      if (num_dims == 3) {
+        H += fabs(m->external_velocity_z[idx])*inv_dx[2];
+      }
+      if (H > max_H_local) max_H_local = H;
+    }
+
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+    {
+      if (max_H_local > max_H) max_H = max_H_local;
+    }
+  }
+
+  return (max_H > 0) ? cfl_number/max_H : LSMLIB_REAL_MAX;
+}
+
+
+int computeMultiphaseLevelSetEqnRHS(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid,
+  LSMLIB_REAL *phi,
+  int spatial_derivative_order)
+{
+  int bdry_types[6];
+
+  /* the ghostcells of phi are filled by the caller */
+  setBdryTypes(-1, bdry_types);
+  return computeLevelSetEqnRHS(multiphase_arrays, grid, phi,
+                               spatial_derivative_order, bdry_types);
+}
+
+
+int advanceMultiphaseLevelSetsTVDRK(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid,
+  LSMLIB_REAL dt,
+  int tvd_rk_order,
+  int spatial_derivative_order,
+  int bdry_location_idx)
+{
+  LSM_MultiphaseDataArrays *m = multiphase_arrays;
+  int K = m->num_phases;
+  int bdry_types[6];
+  int fill_stages;
+  int error_code;
+
+  if ( (tvd_rk_order < 1) || (tvd_rk_order > 3) ) {
+    return LSM_MULTIPHASE_ERR_INVALID_TVD_RK_ORDER;
+  }
+
+  /* for full grid calculations, the boundary conditions are imposed
+   * by the HJ ENO/WENO kernels, so the ghostcells of the intermediate
+   * stages do not need to be filled */
+  fill_stages = m->use_narrow_band;
+  setBdryTypes(fill_stages ? -1 : bdry_location_idx, bdry_types);
+
+  /* stage 1 (forward Euler step) */
+  if (fill_stages) {
+    fillMultiphaseGhostCells(m->phi, K, grid, bdry_location_idx);
+  }
+  error_code = computeLevelSetEqnRHS(m, grid, m->phi,
+                                   spatial_derivative_order,
+                                   bdry_types);
+  if (error_code != LSM_MULTIPHASE_ERR_SUCCESS) return error_code;
+
+  if (tvd_rk_order == 1) {
+    updateMultiphaseStage(m, grid, m->phi, m->phi, m->phi, 0.0, dt);
+    fillMultiphaseGhostCells(m->phi, K, grid, bdry_location_idx);
+    return LSM_MULTIPHASE_ERR_SUCCESS;
+  }
+
+  updateMultiphaseStage(m, grid, m->phi_stage1, m->phi, m->phi, 0.0, dt);
+  if (fill_stages) {
+    fillMultiphaseGhostCells(m->phi_stage1, K, grid, bdry_location_idx);
+  }
+  error_code = computeLevelSetEqnRHS(m, grid, m->phi_stage1,
+                                   spatial_derivative_order,
+                                   bdry_types);
+  if (error_code != LSM_MULTIPHASE_ERR_SUCCESS) return error_code;
+
+  if (tvd_rk_order == 2) {
+    /* phi^{n+1} = 1/2 phi^n + 1/2 (phi_stage1 + dt*L(phi_stage1)) */
+    updateMultiphaseStage(m, grid, m->phi, m->phi, m->phi_stage1, 0.5, dt);
+  } else {
+    /* phi_stage2 = 3/4 phi^n + 1/4 (phi_stage1 + dt*L(phi_stage1)) */
+    updateMultiphaseStage(m, grid, m->phi_stage2, m->phi, m->phi_stage1,
+                          0.75, dt);
+    if (fill_stages) {
+      fillMultiphaseGhostCells(m->phi_stage2, K, grid, bdry_location_idx);
+    }
+    error_code = computeLevelSetEqnRHS(m, grid, m->phi_stage2,
+                                     spatial_derivative_order,
+                                     bdry_types);
+    if (error_code != LSM_MULTIPHASE_ERR_SUCCESS) return error_code;
+
+    /* phi^{n+1} = 1/3 phi^n + 2/3 (phi_stage2 + dt*L(phi_stage2)) */
+    updateMultiphaseStage(m, grid, m->phi, m->phi, m->phi_stage2,
+                          1.0/3.0, dt);
+  }
+
+  fillMultiphaseGhostCells(m->phi, K, grid, bdry_location_idx);
+
+  return LSM_MULTIPHASE_ERR_SUCCESS;
+}
+
+
+int reinitializeMultiphaseLevelSets(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid,
+  int num_iterations,
+  int spatial_derivative_order,
+  int bdry_location_idx)
+{
+  LSM_MultiphaseDataArrays *m = multiphase_arrays;
+  int K = m->num_phases;
+
+  /* the sign of phi is frozen at the beginning of reinitialization */
+  if (m->use_narrow_band) {
+    fillMultiphaseGhostCells(m->phi, K, grid, bdry_location_idx);
+  }
+  memcpy(m->phi_stage2, m->phi,
+         ((size_t) K)*grid->num_gridpts*sizeof(LSMLIB_REAL));
+
+  return advanceMultiphaseReinitializationEqn(m, grid, num_iterations,
+                                              spatial_derivative_order,
+                                              bdry_location_idx);
+}
+
+
+int advanceMultiphaseReinitializationEqn(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid,
+  int num_iterations,
+  int spatial_derivative_order,
+  int bdry_location_idx)
+{
+  LSM_MultiphaseDataArrays *m = multiphase_arrays;
+  int K = m->num_phases;
+  LSMLIB_REAL *phi0 = m->phi_stage2;
+  LSMLIB_REAL dt = 0.0;
+  int bdry_types[6];
+  int fill_stages;
+  int dir, iter;
+  int error_code = LSM_MULTIPHASE_ERR_SUCCESS;
+  LSM_INSTRUMENTATION_START(t_start);
+
+  for (dir = 0; dir < grid->num_dims; dir++) {
+    dt += 1.0/grid->dx[dir];
+  }
+  dt = LSM_MULTIPHASE_REINIT_CFL_NUMBER/dt;
+
+  /* for full grid calculations, the boundary conditions are imposed
+   * by the HJ ENO/WENO kernels (see advanceMultiphaseLevelSetsTVDRK()) */
+  fill_stages = m->use_narrow_band;
+  setBdryTypes(fill_stages ? -1 : bdry_location_idx, bdry_types);
+
+  for (iter = 0; iter < num_iterations; iter++) {
+    error_code = computeMultiphaseReinitializationRHS(
+      m, grid, m->phi, phi0, spatial_derivative_order, bdry_types);
+    if (error_code != LSM_MULTIPHASE_ERR_SUCCESS) break;
+    updateMultiphaseStage(m, grid, m->phi_stage1, m->phi, m->phi, 0.0, dt);
+    if (fill_stages) {
+      fillMultiphaseGhostCells(m->phi_stage1, K, grid, bdry_location_idx);
+    }
+
+    error_code = computeMultiphaseReinitializationRHS(
+      m, grid, m->phi_stage1, phi0, spatial_derivative_order, bdry_types);
+    if (error_code != LSM_MULTIPHASE_ERR_SUCCESS) break;
+    updateMultiphaseStage(m, grid, m->phi, m->phi, m->phi_stage1, 0.5, dt);
+    if (fill_stages) {
+      fillMultiphaseGhostCells(m->phi, K, grid, bdry_location_idx);
+    }
+  }
+  fillMultiphaseGhostCells(m->phi, K, grid, bdry_location_idx);
+
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_REINITIALIZATION, t_start,
+    2.0*num_iterations*K*(3.0 + 2*grid->num_dims)*m->num_update_pts
+      *sizeof(LSMLIB_REAL),
+    2.0*num_iterations*K*m->num_update_pts);
+
+  return error_code;
+}
+
+
+void projectMultiphaseLevelSets(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid)
+{
+  LSM_MultiphaseDataArrays *m = multiphase_arrays;
+  int K = m->num_phases;
+  int num_gridpts = grid->num_gridpts;
+  int n;
+
+  if (K < 2) return;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (n = 0; n < m->num_update_pts; n++) {
+    int idx = m->update_pts[n];
+    LSMLIB_REAL min1 = LSMLIB_REAL_MAX, min2 = LSMLIB_REAL_MAX;
+    LSMLIB_REAL shift;
+    int p;
+
+    /* find the two smallest level set values */
+    for (p = 0; p < K; p++) {
+      LSMLIB_REAL phi_p = m->phi[p*num_gridpts + idx];
+      if (phi_p < min1) {
+        min2 = min1;
+        min1 = phi_p;
+      } else if (phi_p < min2) {
+        min2 = phi_p;
+      }
+    }
+
+    shift = 0.5*(min1 + min2);
+    for (p = 0; p < K; p++) {
+      m->phi[p*num_gridpts + idx] -= shift;
+    }
+  }
+}
+
+
+/*==================== Helper Functions Definitions =================*/
+
+static void setFillboxUpdatePoints(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid)
+{
+  LSM_MultiphaseDataArrays *m = multiphase_arrays;
+  int nx = grid->grid_dims_ghostbox[0];
+  int nxy = nx*grid->grid_dims_ghostbox[1];
+  int klo = (grid->num_dims == 3) ? grid->klo_fb : 0;
+  int khi = (grid->num_dims == 3) ? grid->khi_fb : 0;
+  int klo_gb = (grid->num_dims == 3) ? grid->klo_gb : 0;
+  int i, j, k;
+
+  m->num_update_pts = 0;
+  for (k = klo; k <= khi; k++) {
+    for (j = grid->jlo_fb; j <= grid->jhi_fb; j++) {
+      for (i = grid->ilo_fb; i <= grid->ihi_fb; i++) {
+        m->update_pts[m->num_update_pts++] =
+          (i - grid->ilo_gb) + (j - grid->jlo_gb)*nx + (k - klo_gb)*nxy;
+      }
+    }
+  }
+}
+
+
+static void setBdryTypes(
+  int bdry_location_idx,
+  int *bdry_types)
+{
+  int dir;
+
+  for (dir = 0; dir < 6; dir++) {
+    bdry_types[dir] = LSM_MULTIPHASE_BDRY_TYPE_STORED;
+  }
+
+  if ( (bdry_location_idx >= 0) && (bdry_location_idx <= 5) ) {
+    bdry_types[bdry_location_idx] = LSM_MULTIPHASE_BDRY_TYPE_SIGNED_LINEAR;
+  } else if ( (bdry_location_idx >= 6) && (bdry_location_idx <= 8) ) {
+    dir = bdry_location_idx - 6;
+    bdry_types[2*dir] = LSM_MULTIPHASE_BDRY_TYPE_SIGNED_LINEAR;
+    bdry_types[2*dir+1] = LSM_MULTIPHASE_BDRY_TYPE_SIGNED_LINEAR;
+  } else if (bdry_location_idx == 9) {
+    for (dir = 0; dir < 6; dir++) {
+      bdry_types[dir] = LSM_MULTIPHASE_BDRY_TYPE_SIGNED_LINEAR;
+    }
+  }
+}
+
+
+static int computeOneSidedDerivatives(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid,
+  LSMLIB_REAL *phi,
+  int spatial_derivative_order,
+  const int *bdry_types)
+{
+  LSM_MultiphaseDataArrays *m = multiphase_arrays;
+  int error_code = LSM_MULTIPHASE_ERR_SUCCESS;
+  LSM_INSTRUMENTATION_START(t_start);
+
+  if ( (grid->num_dims == 3) && (m->use_narrow_band) ) {
+
+    switch (spatial_derivative_order) {
+      case 1: {
+        LSM3D_HJ_ENO1_LOCAL(
+          m->phi_x_plus, m->phi_y_plus, m->phi_z_plus, GB3D(grid),
+          m->phi_x_minus, m->phi_y_minus, m->phi_z_minus, GB3D(grid),
+          phi, GB3D(grid),
+          m->D1, GB3D(grid),
+          DX3D(grid),
+          m->index_x, m->index_y, m->index_z,
+          &(m->n_lo[0]), &(m->n_hi[0]),
+          &(m->n_lo[1]), &(m->n_hi[1]),
+          m->narrow_band, GB3D(grid),
+          &s_mark_fb, &s_mark_D1);
+        break;
+      }
+      case 2: {
+        LSM3D_HJ_ENO2_LOCAL(
+          m->phi_x_plus, m->phi_y_plus, m->phi_z_plus, GB3D(grid),
+          m->phi_x_minus, m->phi_y_minus, m->phi_z_minus, GB3D(grid),
+          phi, GB3D(grid),
+          m->D1, GB3D(grid),
+          m->D2, GB3D(grid),
+          DX3D(grid),
+          m->index_x, m->index_y, m->index_z,
+          &(m->n_lo[0]), &(m->n_hi[0]),
+          &(m->n_lo[1]), &(m->n_hi[1]),
+          &(m->n_lo[2]), &(m->n_hi[2]),
+          m->narrow_band, GB3D(grid),
+          &s_mark_fb, &s_mark_D1, &s_mark_D2);
+        break;
+      }
+      default: {
+        error_code = LSM_MULTIPHASE_ERR_INVALID_SPATIAL_DERIVATIVE_ORDER;
+      }
+    }
+
+  } else if (grid->num_dims == 3) {
+
+    /* full-grid kernels are selected at runtime (lsm_kernel_backends.h) */
+    switch (spatial_derivative_order) {
+      case 1: {
+        LSM3D_HJ_ENO1_BDRY_DISPATCH(
+          m->phi_x_plus, m->phi_y_plus, m->phi_z_plus, GB3D(grid),
+          m->phi_x_minus, m->phi_y_minus, m->phi_z_minus, GB3D(grid),
+          phi, GB3D(grid),
+          m->D1, GB3D(grid),
+          FB3D(grid),
+          bdry_types,
+          DX3D(grid));
+        break;
+      }
+      case 2: {
+        LSM3D_HJ_ENO2_BDRY_DISPATCH(
+          m->phi_x_plus, m->phi_y_plus, m->phi_z_plus, GB3D(grid),
+          m->phi_x_minus, m->phi_y_minus, m->phi_z_minus, GB3D(grid),
+          phi, GB3D(grid),
+          m->D1, GB3D(grid),
+          m->D2, GB3D(grid),
+          FB3D(grid),
+          bdry_types,
+          DX3D(grid));
+        break;
+      }
+      case 3: {
+        LSM3D_HJ_ENO3_BDRY_DISPATCH(
+          m->phi_x_plus, m->phi_y_plus, m->phi_z_plus, GB3D(grid),
+          m->phi_x_minus, m->phi_y_minus, m->phi_z_minus, GB3D(grid),
+          phi, GB3D(grid),
+          m->D1, GB3D(grid),
+          m->D2, GB3D(grid),
+          m->D3, GB3D(grid),
+          FB3D(grid),
+          bdry_types,
+          DX3D(grid));
+        break;
+      }
+      case 5: {
+        LSM3D_HJ_WENO5_BDRY_DISPATCH(
+          m->phi_x_plus, m->phi_y_plus, m->phi_z_plus, GB3D(grid),
+          m->phi_x_minus, m->phi_y_minus, m->phi_z_minus, GB3D(grid),
+          phi, GB3D(grid),
+          m->D1, GB3D(grid),
+          FB3D(grid),
+          bdry_types,
+          DX3D(grid));
+        break;
+      }
+      default: {
+        error_code = LSM_MULTIPHASE_ERR_INVALID_SPATIAL_DERIVATIVE_ORDER;
+      }
+    }
+
+  } else if (m->use_narrow_band) {
+
+    switch (spatial_derivative_order) {
+      case 1: {
+        LSM2D_HJ_ENO1_LOCAL(
+          m->phi_x_plus, m->phi_y_plus, GB2D(grid),
+          m->phi_x_minus, m->phi_y_minus, GB2D(grid),
+          phi, GB2D(grid),
+          m->D1, GB2D(grid),
+          DX2D(grid),
+          m->index_x, m->index_y,
+          &(m->n_lo[0]), &(m->n_hi[0]),
+          &(m->n_lo[1]), &(m->n_hi[1]),
+          m->narrow_band, GB2D(grid),
+          &s_mark_fb, &s_mark_D1);
+        break;
+      }
+      case 2: {
+        LSM2D_HJ_ENO2_LOCAL(
+          m->phi_x_plus, m->phi_y_plus, GB2D(grid),
+          m->phi_x_minus, m->phi_y_minus, GB2D(grid),
+          phi, GB2D(grid),
+          m->D1, GB2D(grid),
+          m->D2, GB2D(grid),
+          DX2D(grid),
+          m->index_x, m->index_y,
+          &(m->n_lo[0]), &(m->n_hi[0]),
+          &(m->n_lo[1]), &(m->n_hi[1]),
+          &(m->n_lo[2]), &(m->n_hi[2]),
+          m->narrow_band, GB2D(grid),
+          &s_mark_fb, &s_mark_D1, &s_mark_D2);
+        break;
+      }
+      default: {
+        error_code = LSM_MULTIPHASE_ERR_INVALID_SPATIAL_DERIVATIVE_ORDER;
+      }
+    }
+
+  } else {
+
+    switch (spatial_derivative_order) {
+      case 1: {
+        LSM2D_HJ_ENO1_BDRY_DISPATCH(
+          m->phi_x_plus, m->phi_y_plus, GB2D(grid),
+          m->phi_x_minus, m->phi_y_minus, GB2D(grid),
+          phi, GB2D(grid),
+          m->D1, GB2D(grid),
+          FB2D(grid),
+          bdry_types,
+          DX2D(grid));
+        break;
+      }
+      case 2: {
+        LSM2D_HJ_ENO2_BDRY_DISPATCH(
+          m->phi_x_plus, m->phi_y_plus, GB2D(grid),
+          m->phi_x_minus, m->phi_y_minus, GB2D(grid),
+          phi, GB2D(grid),
+          m->D1, GB2D(grid),
+          m->D2, GB2D(grid),
+          FB2D(grid),
+          bdry_types,
+          DX2D(grid));
+        break;
+      }
+      case 3: {
+        LSM2D_HJ_ENO3_BDRY_DISPATCH(
+          m->phi_x_plus, m->phi_y_plus, GB2D(grid),
+          m->phi_x_minus, m->phi_y_minus, GB2D(grid),
+          phi, GB2D(grid),
+          m->D1, GB2D(grid),
+          m->D2, GB2D(grid),
+          m->D3, GB2D(grid),
+          FB2D(grid),
+          bdry_types,
+          DX2D(grid));
+        break;
+      }
+      case 5: {
+        LSM2D_HJ_WENO5_BDRY_DISPATCH(
+          m->phi_x_plus, m->phi_y_plus, GB2D(grid),
+          m->phi_x_minus, m->phi_y_minus, GB2D(grid),
+          phi, GB2D(grid),
+          m->D1, GB2D(grid),
+          FB2D(grid),
+          bdry_types,
+          DX2D(grid));
+        break;
+      }
+      default: {
+        error_code = LSM_MULTIPHASE_ERR_INVALID_SPATIAL_DERIVATIVE_ORDER;
+      }
+    }
+  }
+
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_SPATIAL_DERIVATIVES, t_start,
+    (1.0 + 2*grid->num_dims + spatial_derivative_order)*m->num_update_pts
+      *sizeof(LSMLIB_REAL),
+    m->num_update_pts);
+
+  return error_code;
+}
+
+
+static int computeLevelSetEqnRHS(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid,
+  LSMLIB_REAL *phi,
+  int spatial_derivative_order,
+  const int *bdry_types)
+{
+  LSM_MultiphaseDataArrays *m = multiphase_arrays;
+  int p;
+  int error_code;
+  LSM_INSTRUMENTATION_START(t_start);
+
+  zeroMultiphaseRHS(m, grid);
+
+  for (p = 0; p < m->num_phases; p++) {
+    LSMLIB_REAL *phi_p = LSM_MULTIPHASE_PHASE_DATA(phi, p, grid);
+    LSMLIB_REAL *rhs_p = LSM_MULTIPHASE_PHASE_DATA(m->lse_rhs, p, grid);
+
+    error_code = computeOneSidedDerivatives(m, grid, phi_p,
+                                            spatial_derivative_order,
+                                            bdry_types);
+    if (error_code != LSM_MULTIPHASE_ERR_SUCCESS) return error_code;
+
+    if (grid->num_dims == 3) {
+      if (m->use_narrow_band) {
+        LSM3D_ADD_EXTERNAL_AND_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL(
+          rhs_p, GB3D(grid),
+          m->phi_x_plus, m->phi_y_plus, m->phi_z_plus, GB3D(grid),
+          m->phi_x_minus, m->phi_y_minus, m->phi_z_minus, GB3D(grid),
+          m->normal_velocity,
+          m->external_velocity_x, m->external_velocity_y,
+          m->external_velocity_z, GB3D(grid),
+          m->index_x, m->index_y, m->index_z,
+          &(m->n_lo[0]), &(m->n_hi[0]),
+          m->narrow_band, GB3D(grid),
+          &s_mark_fb);
+        LSM3D_MULTIPLY_CUT_OFF_LSE_RHS_LOCAL(phi_p, rhs_p, GB3D(grid),
+          m->index_x, m->index_y, m->index_z,
+          &(m->n_lo[0]), &(m->n_hi[0]),
+          m->narrow_band, GB3D(grid),
+          &s_mark_fb,
+          &(m->beta), &(m->gamma));
+      } else {
+        LSM3D_ADD_EXTERNAL_AND_NORMAL_VEL_TERM_TO_LSE_RHS(
+          rhs_p, GB3D(grid),
+          m->phi_x_plus, m->phi_y_plus, m->phi_z_plus, GB3D(grid),
+          m->phi_x_minus, m->phi_y_minus, m->phi_z_minus, GB3D(grid),
+          m->normal_velocity,
+          m->external_velocity_x, m->external_velocity_y,
+          m->external_velocity_z, GB3D(grid),
+          FB3D(grid));
+      }
+    } else {
+      if (m->use_narrow_band) {
+        LSM2D_ADD_EXTERNAL_AND_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL(
+          rhs_p, GB2D(grid),
+          m->phi_x_plus, m->phi_y_plus, GB2D(grid),
+          m->phi_x_minus, m->phi_y_minus, GB2D(grid),
+          m->normal_velocity,
+          m->external_velocity_x, m->external_velocity_y, GB2D(grid),
+          m->index_x, m->index_y,
+          &(m->n_lo[0]), &(m->n_hi[0]),
+          m->narrow_band, GB2D(grid),
+          &s_mark_fb);
+        LSM2D_MULTIPLY_CUT_OFF_LSE_RHS_LOCAL(phi_p, rhs_p, GB2D(grid),
+          m->index_x, m->index_y,
+          &(m->n_lo[0]), &(m->n_hi[0]),
+          m->narrow_band, GB2D(grid),
+          &s_mark_fb,
+          &(m->beta), &(m->gamma));
+      } else {
+        LSM2D_ADD_EXTERNAL_AND_NORMAL_VEL_TERM_TO_LSE_RHS(
+          rhs_p, GB2D(grid),
+          m->phi_x_plus, m->phi_y_plus, GB2D(grid),
+          m->phi_x_minus, m->phi_y_minus, GB2D(grid),
+          m->normal_velocity,
+          m->external_velocity_x, m->external_velocity_y, GB2D(grid),
+          FB2D(grid));
+      }
+    }
+  }
+
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_RHS, t_start,
+    m->num_phases*(2.0 + 3*grid->num_dims)*m->num_update_pts
+      *sizeof(LSMLIB_REAL),
+    m->num_phases*m->num_update_pts);
+
+  return LSM_MULTIPHASE_ERR_SUCCESS;
+}
+
+
+static void zeroMultiphaseRHS(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid)
+{
+  LSM_MultiphaseDataArrays *m = multiphase_arrays;
+  int K = m->num_phases;
+  int num_gridpts = grid->num_gridpts;
+  int n;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (n = 0; n < m->num_update_pts; n++) {
+    int idx = m->update_pts[n];
+    int p;
+    for (p = 0; p < K; p++) {
+      m->lse_rhs[p*num_gridpts + idx] = 0.0;
+    }
+  }
+}
+
+
+static void updateMultiphaseStage(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid,
+  LSMLIB_REAL *u_out,
+  const LSMLIB_REAL *u_cur,
+  const LSMLIB_REAL *u_stage,
+  LSMLIB_REAL alpha,
+  LSMLIB_REAL dt)
+{
+  LSM_MultiphaseDataArrays *m = multiphase_arrays;
+  int K = m->num_phases;
+  int num_gridpts = grid->num_gridpts;
+  LSMLIB_REAL one_minus_alpha = 1.0 - alpha;
+  int n;
+  LSM_INSTRUMENTATION_START(t_start);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (n = 0; n < m->num_update_pts; n++) {
+    int idx = m->update_pts[n];
+    int p;
+    for (p = 0; p < K; p++) {
+      int idx_p = p*num_gridpts + idx;
+      u_out[idx_p] = alpha*u_cur[idx_p]
+                   + one_minus_alpha*(u_stage[idx_p] + dt*m->lse_rhs[idx_p]);
+    }
+  }
+
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_TVD_RK_STAGE, t_start,
+    4.0*K*m->num_update_pts*sizeof(LSMLIB_REAL), K*m->num_update_pts);
+}
+
+
+static int computeMultiphaseReinitializationRHS(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *phi0,
+  int spatial_derivative_order,
+  const int *bdry_types)
+{
+  LSM_MultiphaseDataArrays *m = multiphase_arrays;
+  int use_phi0_for_sgn = 1;
+  int p;
+  int error_code;
+
+  zeroMultiphaseRHS(m, grid);
+
+  for (p = 0; p < m->num_phases; p++) {
+    LSMLIB_REAL *phi_p = LSM_MULTIPHASE_PHASE_DATA(phi, p, grid);
+    LSMLIB_REAL *phi0_p = LSM_MULTIPHASE_PHASE_DATA(phi0, p, grid);
+    LSMLIB_REAL *rhs_p = LSM_MULTIPHASE_PHASE_DATA(m->lse_rhs, p, grid);
+
+    error_code = computeOneSidedDerivatives(m, grid, phi_p,
+                                            spatial_derivative_order,
+                                            bdry_types);
+    if (error_code != LSM_MULTIPHASE_ERR_SUCCESS) return error_code;
+
+    if (grid->num_dims == 3) {
+      if (m->use_narrow_band) {
+        LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS_LOCAL(
+          rhs_p, GB3D(grid),
+          phi_p, GB3D(grid),
+          phi0_p, GB3D(grid),
+          m->phi_x_plus, m->phi_y_plus, m->phi_z_plus, GB3D(grid),
+          m->phi_x_minus, m->phi_y_minus, m->phi_z_minus, GB3D(grid),
+          DX3D(grid),
+          &use_phi0_for_sgn,
+          m->index_x, m->index_y, m->index_z,
+          &(m->n_lo[0]), &(m->n_hi[0]),
+          m->narrow_band, GB3D(grid),
+          &s_mark_fb);
+      } else {
+        LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS(
+          rhs_p, GB3D(grid),
+          phi_p, GB3D(grid),
+          phi0_p, GB3D(grid),
+          m->phi_x_plus, m->phi_y_plus, m->phi_z_plus, GB3D(grid),
+          m->phi_x_minus, m->phi_y_minus, m->phi_z_minus, GB3D(grid),
+          FB3D(grid),
+          DX3D(grid),
+          &use_phi0_for_sgn);
+      }
+    } else {
+      if (m->use_narrow_band) {
+        LSM2D_COMPUTE_REINITIALIZATION_EQN_RHS_LOCAL(
+          rhs_p, GB2D(grid),
+          phi_p, GB2D(grid),
+          phi0_p, GB2D(grid),
+          m->phi_x_plus, m->phi_y_plus, GB2D(grid),
+          m->phi_x_minus, m->phi_y_minus, GB2D(grid),
+          DX2D(grid),
+          &use_phi0_for_sgn,
+          m->index_x, m->index_y,
+          &(m->n_lo[0]), &(m->n_hi[0]),
+          m->narrow_band, GB2D(grid),
+          &s_mark_fb);
+      } else {
+        LSM2D_COMPUTE_REINITIALIZATION_EQN_RHS(
+          rhs_p, GB2D(grid),
+          phi_p, GB2D(grid),
+          phi0_p, GB2D(grid),
+          m->phi_x_plus, m->phi_y_plus, GB2D(grid),
+          m->phi_x_minus, m->phi_y_minus, GB2D(grid),
+          FB2D(grid),
+          DX2D(grid),
+          &use_phi0_for_sgn);
+      }
+    }
+  }
+
+  return LSM_MULTIPHASE_ERR_SUCCESS;
+}
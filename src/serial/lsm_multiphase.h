@@ -0,0 +1,479 @@
+/*
+ * File:        lsm_multiphase.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for batched evolution of multiple level set
+ *              functions (multiphase problems) for serial calculations
+ */
+
+#ifndef INCLUDED_LSM_MULTIPHASE_H
+#define INCLUDED_LSM_MULTIPHASE_H
+
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lsm_grid.h"
+
+
+/*! \file lsm_multiphase.h
+ *
+ * \brief
+ * @ref lsm_multiphase.h provides support for evolving K level set
+ * functions \f$ \phi_1, \ldots, \phi_K \f$ (e.g. the phases of a
+ * multiphase problem) that share a single grid and velocity field
+ *
+ * \f[
+ *
+ *   \phi_{p,t} + \vec{V} \cdot \nabla \phi_p + V_n |\nabla \phi_p| = 0,
+ *   \quad p = 1, \ldots, K.
+ *
+ * \f]
+ *
+ * The level set functions are stored in a single "stacked" array:
+ * the data for phase p is a standard LSMLIB data array that starts at
+ * offset p*grid->num_gridpts (see LSM_MULTIPHASE_PHASE_DATA()), so
+ * any toolbox or serial package function may be applied to a single
+ * phase.  The functions in this file process all K phases together
+ * so that work that does not depend on the phase is performed only
+ * once per time step:
+ *
+ * - the velocity field and the time step restriction are shared
+ * - a single set of scratch arrays (one-sided derivatives and
+ *   divided differences) is reused for all phases
+ * - the narrow band is the union of the narrow bands of all phases
+ *   and is built with a single scan of the grid
+ * - TVD Runge-Kutta stage updates, zeroing of the right-hand side
+ *   and projection loop over all phases at each grid point in a
+ *   single pass
+ *
+ * Boundary conditions (fillMultiphaseGhostCells()) and the HJ ENO/WENO
+ * and level set equation right-hand side kernels are applied to one
+ * phase at a time, so they are called (and read the velocity field)
+ * once per phase.
+ *
+ * The projection step projectMultiphaseLevelSets() removes overlaps
+ * (points where more than one phase has phi < 0) and vacuum (points
+ * where no phase has phi < 0) by subtracting the average of the two
+ * smallest level set values at each grid point.
+ *
+ * Typical usage is
+ *
+ * \code
+ *   m = createMultiphaseDataArrays(K, grid, use_narrow_band);
+ *   (initialize m->phi and the velocity field)
+ *   while (t < t_final) {
+ *     if (use_narrow_band) determineMultiphaseNarrowBand(m, grid, ...);
+ *     dt = computeMultiphaseStableDt(m, grid, cfl_number);
+ *     advanceMultiphaseLevelSetsTVDRK(m, grid, dt, 3, 2, ALL_BOUNDARIES);
+ *     projectMultiphaseLevelSets(m, grid);
+ *     (periodically) reinitializeMultiphaseLevelSets(m, grid, ...);
+ *     t += dt;
+ *   }
+ *   destroyMultiphaseDataArrays(m);
+ * \endcode
+ *
+ */
+
+
+/*========================== Error Codes ============================*/
+#define LSM_MULTIPHASE_ERR_SUCCESS                             (0)
+#define LSM_MULTIPHASE_ERR_INVALID_NUM_DIMS                    (1)
+#define LSM_MULTIPHASE_ERR_INVALID_SPATIAL_DERIVATIVE_ORDER    (2)
+#define LSM_MULTIPHASE_ERR_INVALID_TVD_RK_ORDER                (3)
+#define LSM_MULTIPHASE_ERR_NARROW_BAND_NOT_ALLOCATED           (4)
+
+
+/*============================= Constants ===========================*/
+
+/*
+ * number of narrow band levels (in addition to level 0) marked by
+ * determineMultiphaseNarrowBand()
+ */
+#define LSM_MULTIPHASE_NUM_NB_LEVELS                           (3)
+
+
+/*!
+ * LSM_MULTIPHASE_PHASE_DATA() returns a pointer to the data for the
+ * specified phase in a stacked multiphase data array.
+ */
+#define LSM_MULTIPHASE_PHASE_DATA(data, phase, grid)                       \
+  ( (data) + (phase)*(grid)->num_gridpts )
+
+
+/*!
+ * Structure 'LSM_MultiphaseDataArrays' stores the data arrays required
+ * for batched evolution of multiple level set functions.
+ */
+typedef struct _LSM_MultiphaseDataArrays
+{
+  /* number of level set functions */
+  int num_phases;
+
+  /* stacked level set functions at different time integration steps */
+  /* (phi_stage2 also stores phi0 during reinitialization)            */
+  LSMLIB_REAL *phi, *phi_stage1, *phi_stage2;
+
+  /* stacked right-hand sides of the level set equations */
+  LSMLIB_REAL *lse_rhs;
+
+  /* velocity field shared by all phases (initialized to zero) */
+  LSMLIB_REAL *external_velocity_x;
+  LSMLIB_REAL *external_velocity_y;
+  LSMLIB_REAL *external_velocity_z;
+  LSMLIB_REAL *normal_velocity;
+
+  /* one-sided derivatives and divided differences (shared scratch) */
+  LSMLIB_REAL *phi_x_plus, *phi_y_plus, *phi_z_plus;
+  LSMLIB_REAL *phi_x_minus, *phi_y_minus, *phi_z_minus;
+  LSMLIB_REAL *D1, *D2, *D3;
+
+  /* array indices of the grid points updated by the batched loops */
+  /* (the fillbox or all levels of the union narrow band)          */
+  int *update_pts;
+  int num_update_pts;
+
+  /* union narrow band (NULL if the narrow band is not used) */
+  LSMLIB_REAL *phi_min_abs;
+  unsigned char *narrow_band;
+  int *index_x, *index_y, *index_z;
+  int n_lo[LSM_MULTIPHASE_NUM_NB_LEVELS+1];
+  int n_hi[LSM_MULTIPHASE_NUM_NB_LEVELS+1];
+  int *index_outer_pts;
+  int nlo_outer_plus, nhi_outer_plus;
+  int nlo_outer_minus, nhi_outer_minus;
+
+  /* inner (beta) and outer (gamma) narrow band widths */
+  LSMLIB_REAL beta, gamma;
+
+  /* flag indicating whether updates are restricted to the narrow band */
+  int use_narrow_band;
+
+} LSM_MultiphaseDataArrays;
+
+
+/*!
+ * createMultiphaseDataArrays() allocates a LSM_MultiphaseDataArrays
+ * structure and the memory for its data arrays.
+ *
+ * Arguments:
+ *  - num_phases (in):       number of level set functions
+ *  - grid (in):             pointer to Grid
+ *  - use_narrow_band (in):  flag indicating whether updates should be
+ *                           restricted to the union narrow band
+ *
+ * Return value:             pointer to new LSM_MultiphaseDataArrays
+ *                           structure; NULL if memory allocation fails
+ *
+ * NOTES:
+ *  - The velocity field arrays are initialized to zero.
+ *
+ */
+LSM_MultiphaseDataArrays *createMultiphaseDataArrays(
+  int num_phases,
+  Grid *grid,
+  int use_narrow_band);
+
+
+/*!
+ * destroyMultiphaseDataArrays() frees the memory allocated for a
+ * LSM_MultiphaseDataArrays structure and its data arrays.
+ */
+void destroyMultiphaseDataArrays(LSM_MultiphaseDataArrays *multiphase_arrays);
+
+
+/*!
+ * determineMultiphaseNarrowBand() builds the union of the narrow
+ * bands of all phases, i.e. the set of grid points where
+ * \f$ \min_p |\phi_p| < \gamma \f$, and marks the boundary layers
+ * used by the local toolbox kernels.
+ *
+ * Arguments:
+ *  - multiphase_arrays (in/out):  pointer to LSM_MultiphaseDataArrays
+ *  - grid (in):                   pointer to Grid
+ *  - beta (in):                   inner narrow band width (the level
+ *                                 set equations are unmodified where
+ *                                 \f$ |\phi_p| < \beta \f$)
+ *  - gamma (in):                  outer narrow band width (phase p is
+ *                                 not updated where
+ *                                 \f$ |\phi_p| \ge \gamma \f$)
+ *
+ * Return value:                   LSM_MULTIPHASE_ERR_SUCCESS or an
+ *                                 error code
+ *
+ * NOTES:
+ *  - The level set functions should be close to signed distance
+ *    functions (see reinitializeMultiphaseLevelSets()).
+ *
+ *  - The narrow band should be rebuilt after every time step (or
+ *    whenever the zero level sets may have moved more than
+ *    gamma - beta).
+ *
+ *  - Values of phi outside of the narrow band are not updated, so
+ *    very thin bands (e.g. beta = 4*dx, gamma = 6*dx) degrade the
+ *    accuracy of the solution unless the level set functions are
+ *    frequently reinitialized.  With beta = 8*dx and gamma = 12*dx,
+ *    the results are essentially the same as those of the full
+ *    grid calculation.
+ *
+ */
+int determineMultiphaseNarrowBand(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid,
+  LSMLIB_REAL beta,
+  LSMLIB_REAL gamma);
+
+
+/*!
+ * fillMultiphaseGhostCells() imposes signed linear extrapolation
+ * boundary conditions on all phases of a stacked data array.
+ *
+ * Arguments:
+ *  - data (in/out):            stacked data array
+ *  - num_phases (in):          number of phases
+ *  - grid (in):                pointer to Grid
+ *  - bdry_location_idx (in):   boundary location index (see
+ *                              signedLinearExtrapolationBC())
+ *
+ * Return value:                none
+ *
+ */
+void fillMultiphaseGhostCells(
+  LSMLIB_REAL *data,
+  int num_phases,
+  Grid *grid,
+  int bdry_location_idx);
+
+
+/*!
+ * computeMultiphaseStableDt() computes the stable time step for the
+ * level set equations of all phases.  Since the velocity field is
+ * shared, the time step is computed with a single pass over the
+ * velocity field:
+ *
+ * \f[
+ *
+ *   \Delta t = \frac{CFL}{\max \left( \sum_l |V_l|/\Delta x_l
+ *              + |V_n| \sqrt{\sum_l 1/\Delta x_l^2} \right)}
+ *
+ * \f]
+ *
+ * Arguments:
+ *  - multiphase_arrays (in):  pointer to LSM_MultiphaseDataArrays
+ *  - grid (in):               pointer to Grid
+ *  - cfl_number (in):         CFL number
+ *
+ * Return value:               stable time step; LSMLIB_REAL_MAX if the
+ *                             velocity field is zero
+ *
+ * NOTES:
+ *  - The normal velocity term assumes that
+ *    \f$ |\nabla \phi_p| \approx 1 \f$.
+ *
+ */
+LSMLIB_REAL computeMultiphaseStableDt(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid,
+  LSMLIB_REAL cfl_number);
+
+
+/*!
+ * computeMultiphaseLevelSetEqnRHS() computes the right-hand sides of
+ * the level set equations
+ *
+ * \f[
+ *
+ *   \phi_{p,t} = - \vec{V} \cdot \nabla \phi_p - V_n |\nabla \phi_p|
+ *
+ * \f]
+ *
+ * for all phases.
+ *
+ * Arguments:
+ *  - multiphase_arrays (in/out):      pointer to LSM_MultiphaseDataArrays;
+ *                                     the result is stored in lse_rhs
+ *  - grid (in):                       pointer to Grid
+ *  - phi (in):                        stacked level set functions
+ *                                     (ghostcells must be filled)
+ *  - spatial_derivative_order (in):   order of HJ ENO/WENO derivatives
+ *                                     (1, 2, 3 or 5)
+ *
+ * Return value:                       LSM_MULTIPHASE_ERR_SUCCESS or an
+ *                                     error code
+ *
+ * NOTES:
+ *  - When the narrow band is used, the right-hand sides are computed
+ *    at level 0 narrow band points, multiplied by the cut-off function
+ *    of Peng et al. for each phase, and set to zero at the other
+ *    narrow band points.  Only spatial_derivative_order = 1 or 2 is
+ *    supported with the narrow band.
+ *
+ */
+int computeMultiphaseLevelSetEqnRHS(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid,
+  LSMLIB_REAL *phi,
+  int spatial_derivative_order);
+
+
+/*!
+ * advanceMultiphaseLevelSetsTVDRK() advances all phases by a single
+ * time step using a TVD Runge-Kutta scheme.
+ *
+ * Arguments:
+ *  - multiphase_arrays (in/out):      pointer to LSM_MultiphaseDataArrays
+ *  - grid (in):                       pointer to Grid
+ *  - dt (in):                         time step
+ *  - tvd_rk_order (in):               order of TVD Runge-Kutta scheme
+ *                                     (1, 2 or 3)
+ *  - spatial_derivative_order (in):   order of HJ ENO/WENO derivatives
+ *  - bdry_location_idx (in):          boundary location index for
+ *                                     signed linear extrapolation
+ *                                     boundary conditions
+ *
+ * Return value:                       LSM_MULTIPHASE_ERR_SUCCESS or an
+ *                                     error code
+ *
+ * NOTES:
+ *  - The ghostcells of multiphase_arrays->phi are filled on return.
+ *    For full grid calculations, the boundary conditions are imposed
+ *    by the HJ ENO/WENO kernels (see LSM3D_HJ_ENO1_BDRY()), so the
+ *    ghostcells of the intermediate stages are not filled.
+ *
+ *  - When the narrow band is used, determineMultiphaseNarrowBand()
+ *    must be called before this function.
+ *
+ */
+int advanceMultiphaseLevelSetsTVDRK(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid,
+  LSMLIB_REAL dt,
+  int tvd_rk_order,
+  int spatial_derivative_order,
+  int bdry_location_idx);
+
+
+/*!
+ * reinitializeMultiphaseLevelSets() reinitializes all phases to signed
+ * distance functions by advancing the reinitialization equation
+ *
+ * \f[
+ *
+ *   \phi_{p,t} + sgn(\phi_{p,0}) ( |\nabla \phi_p| - 1 ) = 0
+ *
+ * \f]
+ *
+ * for the specified number of pseudo-time steps using TVD RK2.
+ *
+ * Arguments:
+ *  - multiphase_arrays (in/out):      pointer to LSM_MultiphaseDataArrays
+ *  - grid (in):                       pointer to Grid
+ *  - num_iterations (in):             number of pseudo-time steps
+ *  - spatial_derivative_order (in):   order of HJ ENO/WENO derivatives
+ *  - bdry_location_idx (in):          boundary location index for
+ *                                     signed linear extrapolation
+ *                                     boundary conditions
+ *
+ * Return value:                       LSM_MULTIPHASE_ERR_SUCCESS or an
+ *                                     error code
+ *
+ * NOTES:
+ *  - The contents of phi_stage1 and phi_stage2 are overwritten.
+ *
+ *  - The pseudo-time step is 0.5/(sum_l 1/dx_l).
+ *
+ *  - When the narrow band is used, only narrow band points are
+ *    updated, so the narrow band should be built with gamma equal to
+ *    the distance to which phi should be reinitialized.
+ *
+ */
+int reinitializeMultiphaseLevelSets(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid,
+  int num_iterations,
+  int spatial_derivative_order,
+  int bdry_location_idx);
+
+
+/*!
+ * advanceMultiphaseReinitializationEqn() advances the reinitialization
+ * equation for all phases (see reinitializeMultiphaseLevelSets()) for
+ * the specified number of pseudo-time steps using the level set
+ * functions stored in phi_stage2 as \f$ \phi_{p,0} \f$.
+ *
+ * Arguments:
+ *  - multiphase_arrays (in/out):      pointer to LSM_MultiphaseDataArrays
+ *  - grid (in):                       pointer to Grid
+ *  - num_iterations (in):             number of pseudo-time steps
+ *  - spatial_derivative_order (in):   order of HJ ENO/WENO derivatives
+ *  - bdry_location_idx (in):          boundary location index for
+ *                                     signed linear extrapolation
+ *                                     boundary conditions
+ *
+ * Return value:                       LSM_MULTIPHASE_ERR_SUCCESS or an
+ *                                     error code
+ *
+ * NOTES:
+ *  - reinitializeMultiphaseLevelSets() copies phi (with ghostcells
+ *    filled) to phi_stage2 and calls this function.  Calling this
+ *    function repeatedly without changing phi_stage2 gives the same
+ *    result as a single call with the total number of pseudo-time
+ *    steps, so a reinitialization may be split into several calls.
+ *
+ *  - When the narrow band is used, the ghostcells of phi and
+ *    phi_stage2 should be filled before the first call (the ghostcells
+ *    of phi are filled on return).
+ *
+ *  - The contents of phi_stage1 are overwritten.
+ *
+ */
+int advanceMultiphaseReinitializationEqn(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid,
+  int num_iterations,
+  int spatial_derivative_order,
+  int bdry_location_idx);
+
+
+/*!
+ * projectMultiphaseLevelSets() removes overlaps and vacuum by
+ * replacing each level set function with
+ *
+ * \f[
+ *
+ *   \phi_p \leftarrow \phi_p - \frac{\phi_{(1)} + \phi_{(2)}}{2},
+ *
+ * \f]
+ *
+ * where \f$ \phi_{(1)} \le \phi_{(2)} \f$ are the two smallest level
+ * set values at the grid point.  After projection, every grid point
+ * belongs to exactly one phase (the one with the smallest level set
+ * value) except at ties.
+ *
+ * Arguments:
+ *  - multiphase_arrays (in/out):  pointer to LSM_MultiphaseDataArrays
+ *  - grid (in):                   pointer to Grid
+ *
+ * Return value:                   none
+ *
+ * NOTES:
+ *  - Projection has no effect when num_phases = 1.
+ *
+ *  - When the narrow band is used, only narrow band points are
+ *    projected.
+ *
+ */
+void projectMultiphaseLevelSets(
+  LSM_MultiphaseDataArrays *multiphase_arrays,
+  Grid *grid);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
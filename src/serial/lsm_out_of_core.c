@@ -0,0 +1,1173 @@
+/*
+ * File:        lsm_out_of_core.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for out-of-core (disk-resident)
+ *              narrow band level set calculations
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+#include "lsm_out_of_core.h"
+#include "lsm_boundary_conditions.h"
+#include "lsm_multiphase.h"
+#include "lsm_tiled_grid.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+/*============================= Constants ===========================*/
+
+/* identifier at the beginning of data files */
+static const char s_file_magic[8] = "LSMOOC2";
+
+/* size of the file header (in bytes) */
+#define LSM_OUT_OF_CORE_HEADER_SIZE                            (64)
+
+/* chunk records start at a multiple of this offset (in bytes) */
+#define LSM_OUT_OF_CORE_RECORD_ALIGNMENT                       (4096)
+
+/* number of records per chunk: records 0 and 1 store the current and */
+/* updated values of phi, and record 2 stores phi0 during              */
+/* reinitialization                                                    */
+#define LSM_OUT_OF_CORE_NUM_RECORDS                            (3)
+#define LSM_OUT_OF_CORE_PHI0_RECORD                            (2)
+
+/* operations performed on the active chunks */
+#define LSM_OUT_OF_CORE_ADVANCE                                (0)
+#define LSM_OUT_OF_CORE_REINITIALIZE                           (1)
+
+
+/*=========================== Data Types ============================*/
+
+/*
+ * Structure 'LSM_OutOfCorePass' stores the parameters of a pass over
+ * the active chunks.
+ */
+typedef struct _LSM_OutOfCorePass
+{
+  int operation;
+  LSMLIB_REAL dt;
+  int tvd_rk_order;
+  int num_iterations;
+  int spatial_derivative_order;
+  LSMLIB_REAL beta, gamma;
+  int use_narrow_band;
+  LSM_OutOfCoreVelocityFunction velocity_function;
+  void *context;
+
+  /* pseudo-time step performed by a reinitialization pass and flags */
+  /* marking the chunks that are updated by the reinitialization     */
+  /* (NULL for time steps)                                           */
+  int iteration;
+  unsigned char *reinit_chunks;
+
+  /* number of grid cells added to each side of a chunk */
+  int halo;
+} LSM_OutOfCorePass;
+
+/*
+ * Structure 'LSM_OutOfCoreBox' stores an active chunk and the box
+ * (chunk and halo, clipped to the domain) used to update it.
+ */
+typedef struct _LSM_OutOfCoreBox
+{
+  int chunk_idx;
+  int lo[3];
+  int dims[3];
+} LSM_OutOfCoreBox;
+
+/*
+ * Structure 'LSM_OutOfCoreWorkspace' stores the data arrays used by a
+ * thread to update boxes with the same dimensions.
+ */
+typedef struct _LSM_OutOfCoreWorkspace
+{
+  int dims[3];
+  LSM_MultiphaseDataArrays *multiphase_arrays;
+} LSM_OutOfCoreWorkspace;
+
+
+/*================== Helper Functions Declarations ==================*/
+
+/*
+ * allocateOutOfCoreField() allocates an LSM_OutOfCoreField for the
+ * specified grid and chunk dimensions.
+ */
+static LSM_OutOfCoreField *allocateOutOfCoreField(
+  Grid *grid,
+  int *chunk_dims,
+  int max_cached_chunks);
+
+/*
+ * writeHeader() writes the file header and the chunk table to the
+ * data file.
+ */
+static int writeHeader(LSM_OutOfCoreField *field);
+
+/*
+ * getFillbox() computes the range of grid cells in the fillbox of a
+ * grid relative to the first interior grid cell in each coordinate
+ * direction (grid cells lo, ..., hi-1).
+ */
+static void getFillbox(Grid *grid, int *lo, int *hi);
+
+/*
+ * getChunkBox() computes the range of grid cells of the domain
+ * (relative to the first interior grid cell) covered by the specified
+ * chunk.
+ */
+static void getChunkBox(
+  LSM_OutOfCoreField *field,
+  int chunk_idx,
+  int *lo,
+  int *dims);
+
+/*
+ * getCacheEntry() returns the cache entry for the specified chunk
+ * record.  If the record is not in the cache, the least recently used
+ * entry is replaced (and written to disk if necessary), and the record
+ * is read from disk if read_data is nonzero.  Returns NULL if reading
+ * or writing fails.
+ *
+ * NOTES:
+ * - getCacheEntry() must be called inside the lsm_out_of_core_cache
+ *   critical section, and the cache entry may only be used inside the
+ *   same critical section.
+ */
+static LSM_OutOfCoreCacheEntry *getCacheEntry(
+  LSM_OutOfCoreField *field,
+  int chunk_idx,
+  int record,
+  int read_data);
+
+/*
+ * writeCacheEntry() writes a cache entry to disk.
+ */
+static int writeCacheEntry(
+  LSM_OutOfCoreField *field,
+  LSM_OutOfCoreCacheEntry *entry);
+
+/*
+ * copyChunkData() copies the part of a chunk that overlaps the fillbox
+ * of a data array between the chunk data and the data array.
+ *
+ * Arguments:
+ *  - field (in):       pointer to LSM_OutOfCoreField
+ *  - chunk_idx (in):   index of chunk
+ *  - chunk_data (in/out):  data for the chunk
+ *  - data (in/out):    data array
+ *  - data_grid (in):   Grid for the data array
+ *  - data_lo (in):     index of the first interior grid cell of the data
+ *                      array in the domain
+ *  - to_chunk (in):    copy from data to chunk_data if nonzero and from
+ *                      chunk_data to data otherwise
+ */
+static void copyChunkData(
+  LSM_OutOfCoreField *field,
+  int chunk_idx,
+  LSMLIB_REAL *chunk_data,
+  LSMLIB_REAL *data,
+  Grid *data_grid,
+  int *data_lo,
+  int to_chunk);
+
+/*
+ * computeChunkMinAbs() returns the minimum of |phi| over a chunk.
+ */
+static LSMLIB_REAL computeChunkMinAbs(
+  LSM_OutOfCoreField *field,
+  int chunk_idx,
+  LSMLIB_REAL *chunk_data);
+
+/*
+ * processActiveChunks() applies a pass to all chunks that contain
+ * narrow band points.
+ */
+static int processActiveChunks(
+  LSM_OutOfCoreField *field,
+  LSM_OutOfCorePass *pass);
+
+/*
+ * readBox() reads the fillbox of a box from the chunks that overlap
+ * it.  Chunks marked in phi0_chunks are read from the phi0 record; the
+ * other chunks (all chunks if phi0_chunks is NULL) are read from the
+ * current record.
+ */
+static int readBox(
+  LSM_OutOfCoreField *field,
+  LSM_OutOfCoreBox *box,
+  Grid *box_grid,
+  LSMLIB_REAL *data,
+  unsigned char *phi0_chunks);
+
+/*
+ * processBox() updates the chunk of a box.
+ */
+static int processBox(
+  LSM_OutOfCoreField *field,
+  LSM_OutOfCorePass *pass,
+  LSM_OutOfCoreBox *box,
+  LSM_OutOfCoreWorkspace *workspace);
+
+/*
+ * compareBoxes() orders boxes by their dimensions and chunk index (so
+ * that the workspace of each thread is rarely reallocated).
+ */
+static int compareBoxes(const void *box1, const void *box2);
+
+
+/*==================== Function Definitions =========================*/
+
+LSM_OutOfCoreField *createOutOfCoreField(
+  const char *file_name,
+  Grid *grid,
+  int *chunk_dims,
+  int max_cached_chunks)
+{
+  LSM_OutOfCoreField *field;
+  long file_size;
+  int c;
+
+  field = allocateOutOfCoreField(grid, chunk_dims, max_cached_chunks);
+  if (!field) return NULL;
+
+  field->fp = fopen(file_name, "w+b");
+  if (!field->fp) {
+    destroyOutOfCoreField(field);
+    return NULL;
+  }
+
+  /* phi is zero until the field is initialized */
+  for (c = 0; c < field->num_chunks_total; c++) {
+    field->current_record[c] = 0;
+    field->phi_min_abs[c] = 0.0;
+  }
+
+  /* extend the file to its full size so that every record can be read */
+  file_size = field->data_offset
+            + LSM_OUT_OF_CORE_NUM_RECORDS*field->num_chunks_total
+              *field->record_size
+              *((long) sizeof(LSMLIB_REAL));
+  if ( (writeHeader(field) != LSM_OUT_OF_CORE_ERR_SUCCESS) ||
+       (fseek(field->fp, file_size - 1, SEEK_SET) != 0) ||
+       (fputc(0, field->fp) == EOF) ) {
+    destroyOutOfCoreField(field);
+    return NULL;
+  }
+
+  return field;
+}
+
+
+LSM_OutOfCoreField *openOutOfCoreField(
+  const char *file_name,
+  Grid *grid,
+  int max_cached_chunks)
+{
+  LSM_OutOfCoreField *field;
+  FILE *fp;
+  char magic[8];
+  int sizeof_real, num_dims;
+  int grid_dims[3], chunk_dims[3], fb_lo[3];
+  int dir;
+
+  fp = fopen(file_name, "r+b");
+  if (!fp) return NULL;
+
+  if ( (fread(magic, 1, 8, fp) != 8) ||
+       (memcmp(magic, s_file_magic, 8) != 0) ||
+       (fread(&sizeof_real, sizeof(int), 1, fp) != 1) ||
+       (fread(&num_dims, sizeof(int), 1, fp) != 1) ||
+       (fread(grid_dims, sizeof(int), 3, fp) != 3) ||
+       (fread(chunk_dims, sizeof(int), 3, fp) != 3) ||
+       (fread(fb_lo, sizeof(int), 3, fp) != 3) ||
+       (sizeof_real != (int) sizeof(LSMLIB_REAL)) ||
+       (num_dims != grid->num_dims) ) {
+    fclose(fp);
+    return NULL;
+  }
+  for (dir = 0; dir < 3; dir++) {
+    if ( (grid_dims[dir] != grid->grid_dims[dir]) ||
+         (chunk_dims[dir] < 1) ) {
+      fclose(fp);
+      return NULL;
+    }
+  }
+
+  field = allocateOutOfCoreField(grid, chunk_dims, max_cached_chunks);
+  if (!field) {
+    fclose(fp);
+    return NULL;
+  }
+
+  /* the grid must have the same fillbox (spatial derivative accuracy) */
+  /* and the chunk table must be complete                              */
+  for (dir = 0; dir < 3; dir++) {
+    if (fb_lo[dir] != field->fb_lo[dir]) break;
+  }
+  if ( (dir < 3) ||
+       (fseek(fp, LSM_OUT_OF_CORE_HEADER_SIZE, SEEK_SET) != 0) ||
+       (fread(field->current_record, 1, field->num_chunks_total, fp)
+          != (size_t) field->num_chunks_total) ||
+       (fread(field->phi_min_abs, sizeof(LSMLIB_REAL),
+              field->num_chunks_total, fp)
+          != (size_t) field->num_chunks_total) ) {
+    fclose(fp);
+    destroyOutOfCoreField(field);
+    return NULL;
+  }
+  field->fp = fp;
+
+  return field;
+}
+
+
+int destroyOutOfCoreField(LSM_OutOfCoreField *field)
+{
+  int error_code = LSM_OUT_OF_CORE_ERR_SUCCESS;
+  int n;
+
+  if (!field) return error_code;
+
+  if (field->fp) {
+    error_code = flushOutOfCoreField(field);
+    fclose(field->fp);
+  }
+
+  if (field->cache) {
+    for (n = 0; n < field->max_cached_chunks; n++) {
+      free(field->cache[n].data);
+    }
+  }
+  free(field->cache);
+  free(field->cache_lookup);
+  free(field->current_record);
+  free(field->phi_min_abs);
+  free(field);
+
+  return error_code;
+}
+
+
+int flushOutOfCoreField(LSM_OutOfCoreField *field)
+{
+  int n;
+
+  for (n = 0; n < field->max_cached_chunks; n++) {
+    LSM_OutOfCoreCacheEntry *entry = &(field->cache[n]);
+    if ( (entry->chunk_idx >= 0) && (entry->dirty) ) {
+      int error_code = writeCacheEntry(field, entry);
+      if (error_code != LSM_OUT_OF_CORE_ERR_SUCCESS) return error_code;
+    }
+  }
+
+  if (writeHeader(field) != LSM_OUT_OF_CORE_ERR_SUCCESS) {
+    return LSM_OUT_OF_CORE_ERR_FILE_WRITE_FAILED;
+  }
+  if (fflush(field->fp) != 0) {
+    return LSM_OUT_OF_CORE_ERR_FILE_WRITE_FAILED;
+  }
+
+  return LSM_OUT_OF_CORE_ERR_SUCCESS;
+}
+
+
+int initializeOutOfCoreField(
+  LSM_OutOfCoreField *field,
+  LSM_OutOfCoreInitFunction init_function,
+  void *context)
+{
+  Grid *grid = field->grid;
+  int error_code = LSM_OUT_OF_CORE_ERR_SUCCESS;
+  int zero_lo[3] = {0, 0, 0};
+  Grid max_chunk_grid;
+  int c;
+
+  /* all chunks fit in the data array for the largest chunk */
+  setTileGrid(&max_chunk_grid, grid, zero_lo, field->chunk_dims);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    LSMLIB_REAL *phi = (LSMLIB_REAL*) malloc(
+      max_chunk_grid.num_gridpts*sizeof(LSMLIB_REAL));
+
+    if (!phi) {
+#ifdef _OPENMP
+#pragma omp critical (lsm_out_of_core_cache)
+#endif
+      error_code = LSM_OUT_OF_CORE_ERR_MEMORY_ALLOCATION_FAILED;
+    }
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic,1)
+#endif
+    for (c = 0; c < field->num_chunks_total; c++) {
+      Grid chunk_grid;
+      int lo[3], dims[3];
+
+      if ( (!phi) || (error_code != LSM_OUT_OF_CORE_ERR_SUCCESS) ) continue;
+
+      getChunkBox(field, c, lo, dims);
+      setTileGrid(&chunk_grid, grid, lo, dims);
+      memset(phi, 0, chunk_grid.num_gridpts*sizeof(LSMLIB_REAL));
+      init_function(phi, &chunk_grid, context);
+
+#ifdef _OPENMP
+#pragma omp critical (lsm_out_of_core_cache)
+#endif
+      {
+        LSM_OutOfCoreCacheEntry *entry =
+          getCacheEntry(field, c, field->current_record[c], 0);
+        if (entry) {
+          copyChunkData(field, c, entry->data, phi, &chunk_grid, lo, 1);
+          entry->dirty = 1;
+          field->phi_min_abs[c] = computeChunkMinAbs(field, c, entry->data);
+        } else {
+          error_code = LSM_OUT_OF_CORE_ERR_FILE_WRITE_FAILED;
+        }
+      }
+    }
+
+    free(phi);
+  }
+
+  return error_code;
+}
+
+
+int copyDataToOutOfCoreField(LSM_OutOfCoreField *field, LSMLIB_REAL *phi)
+{
+  int zero_lo[3] = {0, 0, 0};
+  int c;
+
+  for (c = 0; c < field->num_chunks_total; c++) {
+    LSM_OutOfCoreCacheEntry *entry =
+      getCacheEntry(field, c, field->current_record[c], 0);
+    if (!entry) return LSM_OUT_OF_CORE_ERR_FILE_WRITE_FAILED;
+
+    copyChunkData(field, c, entry->data, phi, field->grid, zero_lo, 1);
+    entry->dirty = 1;
+    field->phi_min_abs[c] = computeChunkMinAbs(field, c, entry->data);
+  }
+
+  return LSM_OUT_OF_CORE_ERR_SUCCESS;
+}
+
+
+int copyDataFromOutOfCoreField(LSM_OutOfCoreField *field, LSMLIB_REAL *phi)
+{
+  int zero_lo[3] = {0, 0, 0};
+  int c;
+
+  for (c = 0; c < field->num_chunks_total; c++) {
+    LSM_OutOfCoreCacheEntry *entry =
+      getCacheEntry(field, c, field->current_record[c], 1);
+    if (!entry) return LSM_OUT_OF_CORE_ERR_FILE_READ_FAILED;
+
+    copyChunkData(field, c, entry->data, phi, field->grid, zero_lo, 0);
+  }
+
+  return LSM_OUT_OF_CORE_ERR_SUCCESS;
+}
+
+
+int advanceOutOfCoreLevelSet(
+  LSM_OutOfCoreField *field,
+  LSMLIB_REAL dt,
+  int tvd_rk_order,
+  int spatial_derivative_order,
+  LSMLIB_REAL beta,
+  LSMLIB_REAL gamma,
+  LSM_OutOfCoreVelocityFunction velocity_function,
+  void *context)
+{
+  Grid *grid = field->grid;
+  LSM_OutOfCorePass pass;
+
+  if ( (tvd_rk_order < 1) || (tvd_rk_order > 3) || (!velocity_function) ) {
+    return LSM_OUT_OF_CORE_ERR_INVALID_PARAMETER;
+  }
+
+  pass.operation = LSM_OUT_OF_CORE_ADVANCE;
+  pass.dt = dt;
+  pass.tvd_rk_order = tvd_rk_order;
+  pass.num_iterations = 0;
+  pass.spatial_derivative_order = spatial_derivative_order;
+  pass.beta = beta;
+  pass.gamma = gamma;
+  pass.use_narrow_band = (gamma > 0.0);
+  pass.velocity_function = velocity_function;
+  pass.context = context;
+  pass.iteration = 0;
+  pass.reinit_chunks = NULL;
+
+  /* each stage corrupts one layer of ghostcells at the faces of the */
+  /* box that lie inside the domain                                  */
+  pass.halo = tvd_rk_order
+            * (grid->grid_dims_ghostbox[0] - grid->grid_dims[0])/2;
+
+  return processActiveChunks(field, &pass);
+}
+
+
+int reinitializeOutOfCoreLevelSet(
+  LSM_OutOfCoreField *field,
+  int num_iterations,
+  int spatial_derivative_order,
+  LSMLIB_REAL beta,
+  LSMLIB_REAL gamma)
+{
+  Grid *grid = field->grid;
+  LSM_OutOfCorePass pass;
+  int error_code = LSM_OUT_OF_CORE_ERR_SUCCESS;
+  int c;
+
+  if (num_iterations <= 0) return LSM_OUT_OF_CORE_ERR_SUCCESS;
+
+  pass.operation = LSM_OUT_OF_CORE_REINITIALIZE;
+  pass.dt = 0.0;
+  pass.tvd_rk_order = 2;
+  pass.num_iterations = num_iterations;
+  pass.spatial_derivative_order = spatial_derivative_order;
+  pass.beta = beta;
+  pass.gamma = gamma;
+  pass.use_narrow_band = (gamma > 0.0);
+  pass.velocity_function = NULL;
+  pass.context = NULL;
+
+  /* the chunks that are updated are determined by phi0 */
+  pass.reinit_chunks = (unsigned char*) malloc(field->num_chunks_total);
+  if (!pass.reinit_chunks) {
+    return LSM_OUT_OF_CORE_ERR_MEMORY_ALLOCATION_FAILED;
+  }
+  for (c = 0; c < field->num_chunks_total; c++) {
+    pass.reinit_chunks[c] = (!pass.use_narrow_band) ||
+                            (field->phi_min_abs[c] < gamma);
+  }
+
+  /* each pseudo-time step is performed in a separate pass over the   */
+  /* active chunks and uses two TVD Runge-Kutta stages.  The first    */
+  /* pass saves phi0 for the active chunks in the phi0 record.        */
+  pass.halo = 2*(grid->grid_dims_ghostbox[0] - grid->grid_dims[0])/2;
+  for (pass.iteration = 0; pass.iteration < num_iterations;
+       pass.iteration++) {
+    error_code = processActiveChunks(field, &pass);
+    if (error_code != LSM_OUT_OF_CORE_ERR_SUCCESS) break;
+  }
+
+  free(pass.reinit_chunks);
+
+  return error_code;
+}
+
+
+/*==================== Helper Functions Definitions =================*/
+
+static LSM_OutOfCoreField *allocateOutOfCoreField(
+  Grid *grid,
+  int *chunk_dims,
+  int max_cached_chunks)
+{
+  LSM_OutOfCoreField *field;
+  long table_size;
+  int fb_hi[3];
+  int dir, n;
+
+  if ( (grid->num_dims != 2) && (grid->num_dims != 3) ) return NULL;
+
+  field = (LSM_OutOfCoreField*) calloc(1, sizeof(LSM_OutOfCoreField));
+  if (!field) return NULL;
+  field->grid = grid;
+
+  getFillbox(grid, field->fb_lo, fb_hi);
+
+  field->num_chunks_total = 1;
+  field->record_size = 1;
+  for (dir = 0; dir < 3; dir++) {
+    int fb_dim = fb_hi[dir] - field->fb_lo[dir];
+
+    if (dir >= grid->num_dims) {
+      field->chunk_dims[dir] = 1;
+    } else if ( (chunk_dims) && (chunk_dims[dir] > 0) ) {
+      field->chunk_dims[dir] = chunk_dims[dir];
+    } else {
+      field->chunk_dims[dir] = LSM_OUT_OF_CORE_DEFAULT_CHUNK_DIM;
+    }
+    if (field->chunk_dims[dir] > fb_dim) {
+      field->chunk_dims[dir] = fb_dim;
+    }
+
+    field->num_chunks[dir] = (fb_dim + field->chunk_dims[dir] - 1)
+                           / field->chunk_dims[dir];
+    field->num_chunks_total *= field->num_chunks[dir];
+    field->record_size *= field->chunk_dims[dir];
+  }
+
+  /* header, chunk table and (aligned) chunk records */
+  table_size = field->num_chunks_total*(1 + (long) sizeof(LSMLIB_REAL));
+  field->data_offset = LSM_OUT_OF_CORE_HEADER_SIZE + table_size;
+  field->data_offset = ( (field->data_offset
+                          + LSM_OUT_OF_CORE_RECORD_ALIGNMENT - 1)
+                        / LSM_OUT_OF_CORE_RECORD_ALIGNMENT )
+                     * LSM_OUT_OF_CORE_RECORD_ALIGNMENT;
+
+  field->current_record =
+    (unsigned char*) calloc(field->num_chunks_total, 1);
+  field->phi_min_abs = (LSMLIB_REAL*) calloc(field->num_chunks_total,
+                                             sizeof(LSMLIB_REAL));
+
+  /* chunk cache */
+  field->max_cached_chunks = (max_cached_chunks > 0)
+                           ? max_cached_chunks
+                           : LSM_OUT_OF_CORE_DEFAULT_MAX_CACHED_CHUNKS;
+  field->cache = (LSM_OutOfCoreCacheEntry*) calloc(
+    field->max_cached_chunks, sizeof(LSM_OutOfCoreCacheEntry));
+  field->cache_lookup = (int*) malloc(
+    LSM_OUT_OF_CORE_NUM_RECORDS*field->num_chunks_total*sizeof(int));
+
+  if ( (!field->current_record) || (!field->phi_min_abs) ||
+       (!field->cache) || (!field->cache_lookup) ) {
+    destroyOutOfCoreField(field);
+    return NULL;
+  }
+
+  for (n = 0; n < LSM_OUT_OF_CORE_NUM_RECORDS*field->num_chunks_total; n++) {
+    field->cache_lookup[n] = -1;
+  }
+  for (n = 0; n < field->max_cached_chunks; n++) {
+    field->cache[n].chunk_idx = -1;
+    field->cache[n].data = (LSMLIB_REAL*) malloc(
+      field->record_size*sizeof(LSMLIB_REAL));
+    if (!field->cache[n].data) {
+      destroyOutOfCoreField(field);
+      return NULL;
+    }
+  }
+
+  return field;
+}
+
+
+static int writeHeader(LSM_OutOfCoreField *field)
+{
+  Grid *grid = field->grid;
+  char header[LSM_OUT_OF_CORE_HEADER_SIZE];
+  int values[11];
+  int dir;
+
+  values[0] = (int) sizeof(LSMLIB_REAL);
+  values[1] = grid->num_dims;
+  for (dir = 0; dir < 3; dir++) {
+    values[2+dir] = grid->grid_dims[dir];
+    values[5+dir] = field->chunk_dims[dir];
+    values[8+dir] = field->fb_lo[dir];
+  }
+
+  memset(header, 0, LSM_OUT_OF_CORE_HEADER_SIZE);
+  memcpy(header, s_file_magic, 8);
+  memcpy(header + 8, values, sizeof(values));
+
+  if ( (fseek(field->fp, 0, SEEK_SET) != 0) ||
+       (fwrite(header, 1, LSM_OUT_OF_CORE_HEADER_SIZE, field->fp)
+          != LSM_OUT_OF_CORE_HEADER_SIZE) ||
+       (fwrite(field->current_record, 1, field->num_chunks_total,
+               field->fp) != (size_t) field->num_chunks_total) ||
+       (fwrite(field->phi_min_abs, sizeof(LSMLIB_REAL),
+               field->num_chunks_total, field->fp)
+          != (size_t) field->num_chunks_total) ) {
+    return LSM_OUT_OF_CORE_ERR_FILE_WRITE_FAILED;
+  }
+
+  return LSM_OUT_OF_CORE_ERR_SUCCESS;
+}
+
+
+static void getChunkBox(
+  LSM_OutOfCoreField *field,
+  int chunk_idx,
+  int *lo,
+  int *dims)
+{
+  int pos[3];
+  int dir;
+
+  pos[0] = chunk_idx % field->num_chunks[0];
+  pos[1] = (chunk_idx/field->num_chunks[0]) % field->num_chunks[1];
+  pos[2] = chunk_idx/(field->num_chunks[0]*field->num_chunks[1]);
+
+  for (dir = 0; dir < 3; dir++) {
+    lo[dir] = field->fb_lo[dir] + pos[dir]*field->chunk_dims[dir];
+    dims[dir] = field->chunk_dims[dir];
+    if (lo[dir] + dims[dir] > field->grid->grid_dims[dir]) {
+      dims[dir] = field->grid->grid_dims[dir] - lo[dir];
+    }
+  }
+}
+
+
+static void getFillbox(Grid *grid, int *lo, int *hi)
+{
+  int lo_fb[3], hi_fb[3];
+  int dir;
+
+  lo_fb[0] = grid->ilo_fb; lo_fb[1] = grid->jlo_fb; lo_fb[2] = grid->klo_fb;
+  hi_fb[0] = grid->ihi_fb; hi_fb[1] = grid->jhi_fb; hi_fb[2] = grid->khi_fb;
+
+  for (dir = 0; dir < 3; dir++) {
+    if (dir < grid->num_dims) {
+      int num_ghostcells = (grid->grid_dims_ghostbox[dir]
+                            - grid->grid_dims[dir])/2;
+      lo[dir] = lo_fb[dir] - num_ghostcells;
+      hi[dir] = hi_fb[dir] - num_ghostcells + 1;
+    } else {
+      lo[dir] = 0;
+      hi[dir] = 1;
+    }
+  }
+}
+
+
+static LSM_OutOfCoreCacheEntry *getCacheEntry(
+  LSM_OutOfCoreField *field,
+  int chunk_idx,
+  int record,
+  int read_data)
+{
+  LSM_OutOfCoreCacheEntry *entry;
+  int key = LSM_OUT_OF_CORE_NUM_RECORDS*chunk_idx + record;
+  int n, victim;
+
+  if (field->cache_lookup[key] >= 0) {
+    entry = &(field->cache[field->cache_lookup[key]]);
+    entry->last_use = ++(field->cache_clock);
+    return entry;
+  }
+
+  /* replace an unused or the least recently used entry */
+  victim = 0;
+  for (n = 0; n < field->max_cached_chunks; n++) {
+    if (field->cache[n].chunk_idx < 0) {
+      victim = n;
+      break;
+    }
+    if (field->cache[n].last_use < field->cache[victim].last_use) {
+      victim = n;
+    }
+  }
+  entry = &(field->cache[victim]);
+
+  if (entry->chunk_idx >= 0) {
+    if ( (entry->dirty) &&
+         (writeCacheEntry(field, entry) != LSM_OUT_OF_CORE_ERR_SUCCESS) ) {
+      return NULL;
+    }
+    field->cache_lookup[LSM_OUT_OF_CORE_NUM_RECORDS*entry->chunk_idx
+                        + entry->record] = -1;
+    entry->chunk_idx = -1;
+  }
+
+  if (read_data) {
+    long offset = field->data_offset
+                + (long) key*field->record_size*((long) sizeof(LSMLIB_REAL));
+    if ( (fseek(field->fp, offset, SEEK_SET) != 0) ||
+         (fread(entry->data, sizeof(LSMLIB_REAL), field->record_size,
+                field->fp) != (size_t) field->record_size) ) {
+      return NULL;
+    }
+    field->num_chunk_reads++;
+  }
+
+  entry->chunk_idx = chunk_idx;
+  entry->record = record;
+  entry->dirty = 0;
+  entry->last_use = ++(field->cache_clock);
+  field->cache_lookup[key] = victim;
+
+  return entry;
+}
+
+
+static int writeCacheEntry(
+  LSM_OutOfCoreField *field,
+  LSM_OutOfCoreCacheEntry *entry)
+{
+  long key = LSM_OUT_OF_CORE_NUM_RECORDS*entry->chunk_idx + entry->record;
+  long offset = field->data_offset
+              + key*field->record_size*((long) sizeof(LSMLIB_REAL));
+
+  if ( (fseek(field->fp, offset, SEEK_SET) != 0) ||
+       (fwrite(entry->data, sizeof(LSMLIB_REAL), field->record_size,
+               field->fp) != (size_t) field->record_size) ) {
+    return LSM_OUT_OF_CORE_ERR_FILE_WRITE_FAILED;
+  }
+  entry->dirty = 0;
+  field->num_chunk_writes++;
+
+  return LSM_OUT_OF_CORE_ERR_SUCCESS;
+}
+
+
+static void copyChunkData(
+  LSM_OutOfCoreField *field,
+  int chunk_idx,
+  LSMLIB_REAL *chunk_data,
+  LSMLIB_REAL *data,
+  Grid *data_grid,
+  int *data_lo,
+  int to_chunk)
+{
+  int chunk_lo[3], chunk_dims[3];
+  int fb_lo[3], fb_hi[3];
+  int lo[3], hi[3], g[3];
+  long nx = data_grid->grid_dims_ghostbox[0];
+  long ny = data_grid->grid_dims_ghostbox[1];
+  size_t row_size;
+  int dir, j, k;
+
+  getChunkBox(field, chunk_idx, chunk_lo, chunk_dims);
+
+  /* overlap of the chunk and the fillbox of the data array */
+  getFillbox(data_grid, fb_lo, fb_hi);
+  for (dir = 0; dir < 3; dir++) {
+    lo[dir] = chunk_lo[dir];
+    if (data_lo[dir] + fb_lo[dir] > lo[dir]) {
+      lo[dir] = data_lo[dir] + fb_lo[dir];
+    }
+    hi[dir] = chunk_lo[dir] + chunk_dims[dir];
+    if (data_lo[dir] + fb_hi[dir] < hi[dir]) {
+      hi[dir] = data_lo[dir] + fb_hi[dir];
+    }
+    if (lo[dir] >= hi[dir]) return;
+
+    g[dir] = (data_grid->grid_dims_ghostbox[dir]
+              - data_grid->grid_dims[dir])/2;
+  }
+
+  row_size = (hi[0] - lo[0])*sizeof(LSMLIB_REAL);
+  for (k = lo[2]; k < hi[2]; k++) {
+    for (j = lo[1]; j < hi[1]; j++) {
+      LSMLIB_REAL *chunk_row = chunk_data + (lo[0] - chunk_lo[0])
+        + chunk_dims[0]*((j - chunk_lo[1])
+                         + chunk_dims[1]*(k - chunk_lo[2]));
+      LSMLIB_REAL *data_row = data + (lo[0] - data_lo[0] + g[0])
+        + nx*((j - data_lo[1] + g[1]) + ny*(k - data_lo[2] + g[2]));
+
+      if (to_chunk) {
+        memcpy(chunk_row, data_row, row_size);
+      } else {
+        memcpy(data_row, chunk_row, row_size);
+      }
+    }
+  }
+}
+
+
+static LSMLIB_REAL computeChunkMinAbs(
+  LSM_OutOfCoreField *field,
+  int chunk_idx,
+  LSMLIB_REAL *chunk_data)
+{
+  LSMLIB_REAL phi_min_abs = LSMLIB_REAL_MAX;
+  int lo[3], dims[3];
+  long n, num_values;
+
+  getChunkBox(field, chunk_idx, lo, dims);
+  num_values = ((long) dims[0])*dims[1]*dims[2];
+
+  for (n = 0; n < num_values; n++) {
+    if (fabs(chunk_data[n]) < phi_min_abs) phi_min_abs = fabs(chunk_data[n]);
+  }
+
+  return phi_min_abs;
+}
+
+
+static int processActiveChunks(
+  LSM_OutOfCoreField *field,
+  LSM_OutOfCorePass *pass)
+{
+  Grid *grid = field->grid;
+  LSM_OutOfCoreBox *boxes;
+  LSM_OutOfCoreWorkspace *workspaces;
+  int num_boxes = 0, num_workspaces = 1;
+  int error_code = LSM_OUT_OF_CORE_ERR_SUCCESS;
+  int b, c, n;
+
+  if ( (pass->spatial_derivative_order != 1) &&
+       (pass->spatial_derivative_order != 2) &&
+       ( (pass->use_narrow_band) ||
+         ( (pass->spatial_derivative_order != 3) &&
+           (pass->spatial_derivative_order != 5) ) ) ) {
+    return LSM_OUT_OF_CORE_ERR_INVALID_PARAMETER;
+  }
+
+  /* active chunks (chunks that contain narrow band points) */
+  boxes = (LSM_OutOfCoreBox*) malloc(
+    field->num_chunks_total*sizeof(LSM_OutOfCoreBox));
+  if (!boxes) return LSM_OUT_OF_CORE_ERR_MEMORY_ALLOCATION_FAILED;
+
+  for (c = 0; c < field->num_chunks_total; c++) {
+    if ( (pass->reinit_chunks) ? (pass->reinit_chunks[c]) :
+         ( (!pass->use_narrow_band) ||
+           (field->phi_min_abs[c] < pass->gamma) ) ) {
+      LSM_OutOfCoreBox *box = &(boxes[num_boxes++]);
+      int dir;
+
+      box->chunk_idx = c;
+      getChunkBox(field, c, box->lo, box->dims);
+      for (dir = 0; dir < grid->num_dims; dir++) {
+        int hi = box->lo[dir] + box->dims[dir] + pass->halo;
+        if (hi > grid->grid_dims[dir]) hi = grid->grid_dims[dir];
+        box->lo[dir] -= pass->halo;
+        if (box->lo[dir] < 0) box->lo[dir] = 0;
+        box->dims[dir] = hi - box->lo[dir];
+      }
+    }
+  }
+  field->num_active_chunks = num_boxes;
+  qsort(boxes, num_boxes, sizeof(LSM_OutOfCoreBox), compareBoxes);
+
+#ifdef _OPENMP
+  num_workspaces = omp_get_max_threads();
+#endif
+  workspaces = (LSM_OutOfCoreWorkspace*) calloc(
+    num_workspaces, sizeof(LSM_OutOfCoreWorkspace));
+  if (!workspaces) {
+    free(boxes);
+    return LSM_OUT_OF_CORE_ERR_MEMORY_ALLOCATION_FAILED;
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1)
+#endif
+  for (b = 0; b < num_boxes; b++) {
+    LSM_OutOfCoreWorkspace *workspace = &(workspaces[0]);
+    int box_error_code;
+
+#ifdef _OPENMP
+    workspace = &(workspaces[omp_get_thread_num()]);
+#endif
+
+    if (error_code != LSM_OUT_OF_CORE_ERR_SUCCESS) continue;
+
+    box_error_code = processBox(field, pass, &(boxes[b]), workspace);
+    if (box_error_code != LSM_OUT_OF_CORE_ERR_SUCCESS) {
+#ifdef _OPENMP
+#pragma omp critical (lsm_out_of_core_cache)
+#endif
+      error_code = box_error_code;
+    }
+  }
+
+  /* updated chunks are now current */
+  if (error_code == LSM_OUT_OF_CORE_ERR_SUCCESS) {
+    for (b = 0; b < num_boxes; b++) {
+      c = boxes[b].chunk_idx;
+      field->current_record[c] = 1 - field->current_record[c];
+    }
+  }
+
+  for (n = 0; n < num_workspaces; n++) {
+    destroyMultiphaseDataArrays(workspaces[n].multiphase_arrays);
+  }
+  free(workspaces);
+  free(boxes);
+
+  return error_code;
+}
+
+
+static int processBox(
+  LSM_OutOfCoreField *field,
+  LSM_OutOfCorePass *pass,
+  LSM_OutOfCoreBox *box,
+  LSM_OutOfCoreWorkspace *workspace)
+{
+  Grid *grid = field->grid;
+  LSM_MultiphaseDataArrays *m;
+  Grid box_grid;
+  int dir;
+  int error_code = LSM_OUT_OF_CORE_ERR_SUCCESS;
+  int c = box->chunk_idx;
+
+  setTileGrid(&box_grid, grid, box->lo, box->dims);
+
+  /* reuse the data arrays of the previous box if it has the same size */
+  if ( (!workspace->multiphase_arrays) ||
+       (workspace->dims[0] != box->dims[0]) ||
+       (workspace->dims[1] != box->dims[1]) ||
+       (workspace->dims[2] != box->dims[2]) ) {
+    destroyMultiphaseDataArrays(workspace->multiphase_arrays);
+    workspace->multiphase_arrays =
+      createMultiphaseDataArrays(1, &box_grid, pass->use_narrow_band);
+    if (!workspace->multiphase_arrays) {
+      return LSM_OUT_OF_CORE_ERR_MEMORY_ALLOCATION_FAILED;
+    }
+    for (dir = 0; dir < 3; dir++) workspace->dims[dir] = box->dims[dir];
+  }
+  m = workspace->multiphase_arrays;
+
+  /* boundary conditions are correct at the faces of the box that lie */
+  /* on the boundary of the domain; errors introduced at the other    */
+  /* faces do not reach the chunk                                     */
+  if (pass->operation == LSM_OUT_OF_CORE_ADVANCE) {
+    size_t size = box_grid.num_gridpts*sizeof(LSMLIB_REAL);
+
+    error_code = readBox(field, box, &box_grid, m->phi, NULL);
+    if (error_code != LSM_OUT_OF_CORE_ERR_SUCCESS) return error_code;
+    fillMultiphaseGhostCells(m->phi, 1, &box_grid, ALL_BOUNDARIES);
+    if (pass->use_narrow_band) {
+      determineMultiphaseNarrowBand(m, &box_grid, pass->beta, pass->gamma);
+    }
+
+    memset(m->external_velocity_x, 0, size);
+    memset(m->external_velocity_y, 0, size);
+    memset(m->external_velocity_z, 0, size);
+    memset(m->normal_velocity, 0, size);
+    pass->velocity_function(m->external_velocity_x, m->external_velocity_y,
+                            m->external_velocity_z, m->normal_velocity,
+                            m->phi, &box_grid, pass->context);
+
+    if (advanceMultiphaseLevelSetsTVDRK(m, &box_grid, pass->dt,
+                                        pass->tvd_rk_order,
+                                        pass->spatial_derivative_order,
+                                        ALL_BOUNDARIES)
+        != LSM_MULTIPHASE_ERR_SUCCESS) {
+      return LSM_OUT_OF_CORE_ERR_INVALID_PARAMETER;
+    }
+  } else {
+
+    /* the narrow band and the sign of phi are determined by phi0 */
+    /* (phi0 is the current value of phi during the first pass)   */
+    error_code = readBox(field, box, &box_grid, m->phi,
+      (pass->iteration > 0) ? pass->reinit_chunks : NULL);
+    if (error_code != LSM_OUT_OF_CORE_ERR_SUCCESS) return error_code;
+    fillMultiphaseGhostCells(m->phi, 1, &box_grid, ALL_BOUNDARIES);
+    if (pass->use_narrow_band) {
+      determineMultiphaseNarrowBand(m, &box_grid, pass->beta, pass->gamma);
+    }
+    memcpy(m->phi_stage2, m->phi,
+           box_grid.num_gridpts*sizeof(LSMLIB_REAL));
+
+    if (pass->iteration > 0) {
+      error_code = readBox(field, box, &box_grid, m->phi, NULL);
+      if (error_code != LSM_OUT_OF_CORE_ERR_SUCCESS) return error_code;
+      fillMultiphaseGhostCells(m->phi, 1, &box_grid, ALL_BOUNDARIES);
+    }
+
+    if (advanceMultiphaseReinitializationEqn(m, &box_grid, 1,
+                                             pass->spatial_derivative_order,
+                                             ALL_BOUNDARIES)
+        != LSM_MULTIPHASE_ERR_SUCCESS) {
+      return LSM_OUT_OF_CORE_ERR_INVALID_PARAMETER;
+    }
+  }
+
+  /* write the chunk to the record that is not in use */
+#ifdef _OPENMP
+#pragma omp critical (lsm_out_of_core_cache)
+#endif
+  {
+    LSM_OutOfCoreCacheEntry *entry =
+      getCacheEntry(field, c, 1 - field->current_record[c], 0);
+    if (entry) {
+      copyChunkData(field, c, entry->data, m->phi, &box_grid, box->lo, 1);
+      entry->dirty = 1;
+      field->phi_min_abs[c] = computeChunkMinAbs(field, c, entry->data);
+    } else {
+      error_code = LSM_OUT_OF_CORE_ERR_FILE_WRITE_FAILED;
+    }
+
+    /* save phi0 for the remaining reinitialization passes */
+    if ( (error_code == LSM_OUT_OF_CORE_ERR_SUCCESS) &&
+         (pass->operation == LSM_OUT_OF_CORE_REINITIALIZE) &&
+         (pass->iteration == 0) && (pass->num_iterations > 1) ) {
+      entry = getCacheEntry(field, c, LSM_OUT_OF_CORE_PHI0_RECORD, 0);
+      if (entry) {
+        copyChunkData(field, c, entry->data, m->phi_stage2, &box_grid,
+                      box->lo, 1);
+        entry->dirty = 1;
+      } else {
+        error_code = LSM_OUT_OF_CORE_ERR_FILE_WRITE_FAILED;
+      }
+    }
+  }
+
+  return error_code;
+}
+
+
+static int readBox(
+  LSM_OutOfCoreField *field,
+  LSM_OutOfCoreBox *box,
+  Grid *box_grid,
+  LSMLIB_REAL *data,
+  unsigned char *phi0_chunks)
+{
+  int fb_lo[3], fb_hi[3];
+  int c_lo[3], c_hi[3];
+  int cx, cy, cz, dir;
+  int error_code = LSM_OUT_OF_CORE_ERR_SUCCESS;
+
+  getFillbox(box_grid, fb_lo, fb_hi);
+  for (dir = 0; dir < 3; dir++) {
+    c_lo[dir] = (box->lo[dir] + fb_lo[dir] - field->fb_lo[dir])
+              / field->chunk_dims[dir];
+    c_hi[dir] = (box->lo[dir] + fb_hi[dir] - 1 - field->fb_lo[dir])
+              / field->chunk_dims[dir];
+  }
+  for (cz = c_lo[2]; cz <= c_hi[2]; cz++) {
+    for (cy = c_lo[1]; cy <= c_hi[1]; cy++) {
+      for (cx = c_lo[0]; cx <= c_hi[0]; cx++) {
+        int src = cx + field->num_chunks[0]*(cy + field->num_chunks[1]*cz);
+        int record = ( (phi0_chunks) && (phi0_chunks[src]) )
+                   ? LSM_OUT_OF_CORE_PHI0_RECORD
+                   : field->current_record[src];
+
+#ifdef _OPENMP
+#pragma omp critical (lsm_out_of_core_cache)
+#endif
+        {
+          LSM_OutOfCoreCacheEntry *entry =
+            getCacheEntry(field, src, record, 1);
+          if (entry) {
+            copyChunkData(field, src, entry->data, data, box_grid,
+                          box->lo, 0);
+          } else {
+            error_code = LSM_OUT_OF_CORE_ERR_FILE_READ_FAILED;
+          }
+        }
+        if (error_code != LSM_OUT_OF_CORE_ERR_SUCCESS) return error_code;
+      }
+    }
+  }
+
+  return error_code;
+}
+
+
+static int compareBoxes(const void *box1, const void *box2)
+{
+  const LSM_OutOfCoreBox *b1 = (const LSM_OutOfCoreBox*) box1;
+  const LSM_OutOfCoreBox *b2 = (const LSM_OutOfCoreBox*) box2;
+  int dir;
+
+  for (dir = 0; dir < 3; dir++) {
+    if (b1->dims[dir] != b2->dims[dir]) {
+      return (b1->dims[dir] < b2->dims[dir]) ? -1 : 1;
+    }
+  }
+  return (b1->chunk_idx < b2->chunk_idx) ? -1
+       : (b1->chunk_idx > b2->chunk_idx) ? 1 : 0;
+}
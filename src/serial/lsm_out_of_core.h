@@ -0,0 +1,495 @@
+/*
+ * File:        lsm_out_of_core.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for out-of-core (disk-resident) narrow band
+ *              level set calculations
+ */
+
+#ifndef INCLUDED_LSM_OUT_OF_CORE_H
+#define INCLUDED_LSM_OUT_OF_CORE_H
+
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include "lsm_grid.h"
+
+
+/*! \file lsm_out_of_core.h
+ *
+ * \brief
+ * @ref lsm_out_of_core.h provides support for evolving and
+ * reinitializing level set functions on grids that are too large to
+ * be stored in memory (e.g. level set functions computed from
+ * 3000^3 micro-CT images).
+ *
+ * The level set function is stored in a chunked file (an
+ * LSM_OutOfCoreField).  The fillbox of the computational domain is
+ * divided into chunks of chunk_dims grid cells, and only the chunks
+ * that contain narrow band points (\f$ |\phi| < \gamma \f$) are read,
+ * updated and written by advanceOutOfCoreLevelSet() and
+ * reinitializeOutOfCoreLevelSet().  Each active chunk is processed
+ * by
+ *
+ * - reading the chunk and a halo of neighboring grid cells (clipped to
+ *   the computational domain) into a box;
+ * - imposing signed linear extrapolation boundary conditions on the
+ *   box, building the narrow band of the box and applying
+ *   advanceMultiphaseLevelSetsTVDRK() (reinitializeMultiphaseLevelSets())
+ *   to it with a single phase;
+ * - writing the updated values in the chunk.
+ *
+ * The halo is wide enough that errors introduced at the faces of the
+ * box that lie inside the domain (one layer of ghostcells per TVD
+ * Runge-Kutta stage) do not reach the chunk, so the result agrees
+ * with the in-memory calculation on the entire grid (with signed
+ * linear extrapolation boundary conditions at all boundaries of the
+ * domain).  Reinitialization performs one pass per pseudo-time step.
+ *
+ * The file stores three records for each chunk.  Updated chunks are
+ * written to the record of the first two that is not in use, so all
+ * chunks are read at the same time level during a pass; these records
+ * are swapped at the end of the pass.  The third record holds the
+ * level set function at the start of reinitialization.  Chunks are accessed through a cache of
+ * max_cached_chunks chunks with least-recently-used replacement.
+ * Updated chunks are written back when they are evicted from the
+ * cache or the field is flushed.  Memory use is proportional to the
+ * size of the cache plus one box per thread (and a few numbers per
+ * chunk), independent of the size of the grid and of the number of
+ * reinitialization iterations.
+ *
+ * When LSMLIB is built with OpenMP support, the active chunks are
+ * distributed dynamically among the threads, so reads and write-backs
+ * performed by one thread overlap with computation on the other
+ * threads.
+ *
+ * Typical usage is
+ *
+ * \code
+ *   grid = createGridSetGridDims(3, grid_dims, x_lo, x_hi, MEDIUM);
+ *   field = createOutOfCoreField("phi.ooc", grid, chunk_dims, 512);
+ *   initializeOutOfCoreField(field, initPhi, &init_context);
+ *   while (t < t_final) {
+ *     advanceOutOfCoreLevelSet(field, dt, 3, 2, beta, gamma,
+ *                              setVelocity, &velocity_context);
+ *     (periodically) reinitializeOutOfCoreLevelSet(field, 5, 2,
+ *                                                  beta, gamma);
+ *     t += dt;
+ *   }
+ *   destroyOutOfCoreField(field);
+ * \endcode
+ *
+ * NOTES:
+ * - The data file uses the native byte order and floating-point
+ *   format of the machine.  Records of chunks that have never been
+ *   updated occupy no disk space on file systems that support sparse
+ *   files.
+ *
+ * - The Grid for the entire domain is only used to describe the
+ *   geometry and index spaces; its num_gridpts is not used (and may
+ *   overflow for very large grids).
+ *
+ */
+
+
+/*========================== Error Codes ============================*/
+#define LSM_OUT_OF_CORE_ERR_SUCCESS                            (0)
+#define LSM_OUT_OF_CORE_ERR_FILE_OPEN_FAILED                   (1)
+#define LSM_OUT_OF_CORE_ERR_FILE_READ_FAILED                   (2)
+#define LSM_OUT_OF_CORE_ERR_FILE_WRITE_FAILED                  (3)
+#define LSM_OUT_OF_CORE_ERR_INVALID_FILE                       (4)
+#define LSM_OUT_OF_CORE_ERR_MEMORY_ALLOCATION_FAILED           (5)
+#define LSM_OUT_OF_CORE_ERR_INVALID_PARAMETER                  (6)
+
+
+/*============================= Constants ===========================*/
+
+/*
+ * default number of grid cells per chunk in each coordinate
+ * direction (used when chunk_dims is NULL or non-positive)
+ */
+#define LSM_OUT_OF_CORE_DEFAULT_CHUNK_DIM                      (64)
+
+/*
+ * default number of chunks in the cache (used when max_cached_chunks
+ * is non-positive)
+ */
+#define LSM_OUT_OF_CORE_DEFAULT_MAX_CACHED_CHUNKS              (64)
+
+
+/*!
+ * Structure 'LSM_OutOfCoreCacheEntry' stores a chunk record in the
+ * chunk cache of an LSM_OutOfCoreField.
+ */
+typedef struct _LSM_OutOfCoreCacheEntry
+{
+  /* chunk and record (0, 1 or 2) stored in the entry (-1 if unused) */
+  int chunk_idx;
+  int record;
+
+  /* flag indicating whether the data has not been written to disk */
+  int dirty;
+
+  /* time of last use (for least-recently-used replacement) */
+  unsigned long last_use;
+
+  /* values of phi in the chunk */
+  LSMLIB_REAL *data;
+
+} LSM_OutOfCoreCacheEntry;
+
+
+/*!
+ * Structure 'LSM_OutOfCoreField' stores a disk-resident level set
+ * function.
+ *
+ * NOTES:
+ * - The field stores the values of phi in the fillbox of the grid.
+ *   For some accuracy levels, the fillbox includes a layer of
+ *   ghostcells at the lower boundary of the domain (fb_lo = -1).
+ *
+ * - The chunk at position (c_x, c_y, c_z) in the array of chunks has
+ *   chunk index c_x + num_chunks[0]*(c_y + num_chunks[1]*c_z) and
+ *   covers the grid cells fb_lo[dir] + c*chunk_dims[dir], ...,
+ *   min(fb_lo[dir] + (c+1)*chunk_dims[dir], grid_dims[dir])-1 in each
+ *   coordinate direction (numbered from the lower boundary of the
+ *   interior of the domain).
+ */
+typedef struct _LSM_OutOfCoreField
+{
+  /* Grid for the entire computational domain (not owned) */
+  Grid *grid;
+
+  /* data file */
+  FILE *fp;
+
+  /* first grid cell of the fillbox (relative to the interior) */
+  int fb_lo[3];
+
+  /* number of grid cells per chunk in each direction */
+  int chunk_dims[3];
+
+  /* number of chunks in each coordinate direction and in total */
+  int num_chunks[3];
+  int num_chunks_total;
+
+  /* number of values stored in each chunk record */
+  long record_size;
+
+  /* offset of the first chunk record in the data file (in bytes) */
+  long data_offset;
+
+  /* record (0 or 1) that stores the current data for each chunk */
+  unsigned char *current_record;
+
+  /* minimum of |phi| over each chunk */
+  LSMLIB_REAL *phi_min_abs;
+
+  /* chunk cache */
+  int max_cached_chunks;
+  LSM_OutOfCoreCacheEntry *cache;
+  int *cache_lookup;
+  unsigned long cache_clock;
+
+  /* statistics */
+  long num_chunk_reads;
+  long num_chunk_writes;
+  int num_active_chunks;
+
+} LSM_OutOfCoreField;
+
+
+/*!
+ * Type of functions used by initializeOutOfCoreField() to set the
+ * values of phi in a chunk.
+ *
+ * Arguments:
+ *  - phi (out):         data array for the chunk (including
+ *                       ghostcells); at least the fillbox of
+ *                       chunk_grid should be set
+ *  - chunk_grid (in):   Grid for the chunk (see setTileGrid())
+ *  - context (in):      user-supplied context passed to
+ *                       initializeOutOfCoreField()
+ */
+typedef void (*LSM_OutOfCoreInitFunction)(LSMLIB_REAL *phi,
+                                          Grid *chunk_grid,
+                                          void *context);
+
+
+/*!
+ * Type of functions used by advanceOutOfCoreLevelSet() to set the
+ * velocity field in a box.
+ *
+ * Arguments:
+ *  - external_velocity_x (out):  x-component of external velocity
+ *  - external_velocity_y (out):  y-component of external velocity
+ *  - external_velocity_z (out):  z-component of external velocity
+ *  - normal_velocity (out):      normal velocity
+ *  - phi (in):                   level set function on the box
+ *                                (ghostcells are filled)
+ *  - box_grid (in):              Grid for the box
+ *  - context (in):               user-supplied context passed to
+ *                                advanceOutOfCoreLevelSet()
+ *
+ * NOTES:
+ * - The velocity arrays are data arrays on box_grid that are set to
+ *   zero before the function is called, so only nonzero components
+ *   need to be set.
+ */
+typedef void (*LSM_OutOfCoreVelocityFunction)(
+  LSMLIB_REAL *external_velocity_x,
+  LSMLIB_REAL *external_velocity_y,
+  LSMLIB_REAL *external_velocity_z,
+  LSMLIB_REAL *normal_velocity,
+  LSMLIB_REAL *phi,
+  Grid *box_grid,
+  void *context);
+
+
+/*!
+ * createOutOfCoreField() creates a new data file for a level set
+ * function on the specified grid.
+ *
+ * Arguments:
+ *  - file_name (in):          name of data file (an existing file is
+ *                             overwritten)
+ *  - grid (in):               pointer to Grid for the entire domain
+ *  - chunk_dims (in):         number of grid cells per chunk
+ *                             in each coordinate direction (NULL to
+ *                             use LSM_OUT_OF_CORE_DEFAULT_CHUNK_DIM in
+ *                             every direction)
+ *  - max_cached_chunks (in):  maximum number of chunks in the cache
+ *                             (non-positive to use
+ *                             LSM_OUT_OF_CORE_DEFAULT_MAX_CACHED_CHUNKS)
+ *
+ * Return value:               pointer to new LSM_OutOfCoreField; NULL
+ *                             if the file cannot be created or memory
+ *                             allocation fails
+ *
+ * NOTES:
+ * - phi is zero in all chunks until the field is initialized (see
+ *   initializeOutOfCoreField() and copyDataToOutOfCoreField()).
+ *
+ * - chunk_dims is reduced to grid_dims in directions where it is
+ *   larger.
+ *
+ * - Each box processed by advanceOutOfCoreLevelSet() holds a chunk
+ *   and a halo of tvd_rk_order*(number of ghostcells) grid cells
+ *   on each side (2*(number of ghostcells) for
+ *   reinitializeOutOfCoreLevelSet()), so chunks should be considerably larger than the
+ *   halo.  Large chunks read more grid cells that are not in the
+ *   narrow band.
+ *
+ * - Chunks are processed in order of chunk index, so the number of
+ *   chunk reads is smallest when the cache can hold the active chunks
+ *   in three consecutive layers of chunks (in the z-direction).
+ */
+LSM_OutOfCoreField *createOutOfCoreField(
+  const char *file_name,
+  Grid *grid,
+  int *chunk_dims,
+  int max_cached_chunks);
+
+
+/*!
+ * openOutOfCoreField() opens an existing data file created by
+ * createOutOfCoreField().
+ *
+ * Arguments:
+ *  - file_name (in):          name of data file
+ *  - grid (in):               pointer to Grid for the entire domain
+ *                             (must have the same number of dimensions
+ *                             and grid_dims as the grid used to create
+ *                             the file)
+ *  - max_cached_chunks (in):  maximum number of chunks in the cache
+ *
+ * Return value:               pointer to LSM_OutOfCoreField; NULL if
+ *                             the file cannot be opened or does not
+ *                             match the grid
+ */
+LSM_OutOfCoreField *openOutOfCoreField(
+  const char *file_name,
+  Grid *grid,
+  int max_cached_chunks);
+
+
+/*!
+ * destroyOutOfCoreField() flushes and closes the data file and frees
+ * the memory used by an LSM_OutOfCoreField.
+ *
+ * Arguments:
+ *  - field (in):  pointer to LSM_OutOfCoreField
+ *
+ * Return value:   error code returned by flushOutOfCoreField()
+ */
+int destroyOutOfCoreField(LSM_OutOfCoreField *field);
+
+
+/*!
+ * flushOutOfCoreField() writes all updated chunks in the cache and
+ * the chunk table to the data file.
+ *
+ * Arguments:
+ *  - field (in):  pointer to LSM_OutOfCoreField
+ *
+ * Return value:   LSM_OUT_OF_CORE_ERR_SUCCESS or an error code
+ */
+int flushOutOfCoreField(LSM_OutOfCoreField *field);
+
+
+/*!
+ * initializeOutOfCoreField() sets phi in every chunk using a
+ * user-supplied function.
+ *
+ * Arguments:
+ *  - field (in/out):        pointer to LSM_OutOfCoreField
+ *  - init_function (in):    function that sets phi in a chunk
+ *  - context (in):          user-supplied data passed to init_function
+ *
+ * Return value:             LSM_OUT_OF_CORE_ERR_SUCCESS or an error
+ *                           code
+ *
+ * NOTES:
+ * - When LSMLIB is built with OpenMP support, init_function is called
+ *   concurrently for different chunks.
+ */
+int initializeOutOfCoreField(
+  LSM_OutOfCoreField *field,
+  LSM_OutOfCoreInitFunction init_function,
+  void *context);
+
+
+/*!
+ * copyDataToOutOfCoreField() copies the fillbox of a data array on
+ * the entire grid to an LSM_OutOfCoreField.
+ *
+ * Arguments:
+ *  - field (in/out):  pointer to LSM_OutOfCoreField
+ *  - phi (in):        data array for the entire grid
+ *
+ * Return value:       LSM_OUT_OF_CORE_ERR_SUCCESS or an error code
+ */
+int copyDataToOutOfCoreField(LSM_OutOfCoreField *field, LSMLIB_REAL *phi);
+
+
+/*!
+ * copyDataFromOutOfCoreField() copies an LSM_OutOfCoreField to the
+ * fillbox of a data array on the entire grid.  The ghostcells of phi
+ * outside of the fillbox are not modified.
+ *
+ * Arguments:
+ *  - field (in):  pointer to LSM_OutOfCoreField
+ *  - phi (out):   data array for the entire grid
+ *
+ * Return value:   LSM_OUT_OF_CORE_ERR_SUCCESS or an error code
+ */
+int copyDataFromOutOfCoreField(LSM_OutOfCoreField *field, LSMLIB_REAL *phi);
+
+
+/*!
+ * advanceOutOfCoreLevelSet() advances the level set equation
+ *
+ * \f[
+ *
+ *   \phi_t + \vec{V} \cdot \nabla \phi + V_n |\nabla \phi| = 0
+ *
+ * \f]
+ *
+ * by a single time step using a TVD Runge-Kutta scheme.  Only chunks
+ * that contain narrow band points are updated.
+ *
+ * Arguments:
+ *  - field (in/out):                  pointer to LSM_OutOfCoreField
+ *  - dt (in):                         time step
+ *  - tvd_rk_order (in):               order of TVD Runge-Kutta scheme
+ *                                     (1, 2 or 3)
+ *  - spatial_derivative_order (in):   order of HJ ENO/WENO derivatives
+ *                                     (the grid must have enough
+ *                                     ghostcells for the order)
+ *  - beta (in):                       inner narrow band width
+ *  - gamma (in):                      outer narrow band width
+ *                                     (non-positive to update all
+ *                                     chunks without a narrow band)
+ *  - velocity_function (in):          function that sets the velocity
+ *                                     field in a box
+ *  - context (in):                    user-supplied data passed to
+ *                                     velocity_function
+ *
+ * Return value:                       LSM_OUT_OF_CORE_ERR_SUCCESS or an
+ *                                     error code
+ *
+ * NOTES:
+ * - The result agrees with determineMultiphaseNarrowBand() followed
+ *   by advanceMultiphaseLevelSetsTVDRK() (with ALL_BOUNDARIES) for a
+ *   single phase on the entire grid.  The restrictions on
+ *   spatial_derivative_order of the narrow band calculation apply
+ *   (see computeMultiphaseLevelSetEqnRHS()).
+ *
+ * - dt should satisfy the CFL condition for the velocity field (see
+ *   computeMultiphaseStableDt()).
+ *
+ * - When LSMLIB is built with OpenMP support, velocity_function is
+ *   called concurrently for different boxes.
+ */
+int advanceOutOfCoreLevelSet(
+  LSM_OutOfCoreField *field,
+  LSMLIB_REAL dt,
+  int tvd_rk_order,
+  int spatial_derivative_order,
+  LSMLIB_REAL beta,
+  LSMLIB_REAL gamma,
+  LSM_OutOfCoreVelocityFunction velocity_function,
+  void *context);
+
+
+/*!
+ * reinitializeOutOfCoreLevelSet() reinitializes the level set
+ * function to a signed distance function (see
+ * reinitializeMultiphaseLevelSets()).  Only chunks that contain narrow
+ * band points are updated.
+ *
+ * Arguments:
+ *  - field (in/out):                  pointer to LSM_OutOfCoreField
+ *  - num_iterations (in):             number of pseudo-time steps
+ *  - spatial_derivative_order (in):   order of HJ ENO/WENO derivatives
+ *                                     (the grid must have enough
+ *                                     ghostcells for the order)
+ *  - beta (in):                       inner narrow band width
+ *  - gamma (in):                      outer narrow band width
+ *                                     (non-positive to update all
+ *                                     chunks without a narrow band)
+ *
+ * Return value:                       LSM_OUT_OF_CORE_ERR_SUCCESS or an
+ *                                     error code
+ *
+ * NOTES:
+ * - Each pseudo-time step is a separate pass over the active chunks
+ *   with a halo of 2*(number of ghostcells) grid cells, so memory use
+ *   does not depend on num_iterations.  The first pass also saves the
+ *   level set function in the third chunk record.
+ *
+ * - The active chunks and the narrow band of each box are determined
+ *   from the level set function at the start of reinitialization, so
+ *   the result agrees with determineMultiphaseNarrowBand() followed by
+ *   reinitializeMultiphaseLevelSets() on the entire grid.
+ */
+int reinitializeOutOfCoreLevelSet(
+  LSM_OutOfCoreField *field,
+  int num_iterations,
+  int spatial_derivative_order,
+  LSMLIB_REAL beta,
+  LSMLIB_REAL gamma);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,457 @@
+/*
+ * File:        lsm_tiled_grid.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for tiled (shared-memory parallel)
+ *              execution of serial calculations
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "lsm_tiled_grid.h"
+
+
+/*==================== Helper Function Declarations ==================*/
+
+/*
+ * getTileBox() computes the position of the specified tile in the
+ * array of tiles and the range of interior grid cells of the domain
+ * covered by the tile.
+ *
+ * Arguments:
+ *  - tiled_grid (in):  pointer to LSM_TiledGrid
+ *  - tile_idx (in):    index of the tile
+ *  - pos (out):        position of the tile in each coordinate direction
+ *  - lo (out):         index (relative to the lower boundary of the
+ *                      interior of the domain) of the first grid cell
+ *                      covered by the tile in each coordinate direction
+ *  - dims (out):       number of grid cells covered by the tile in each
+ *                      coordinate direction
+ *
+ * Return value:        none
+ */
+static void getTileBox(
+  LSM_TiledGrid *tiled_grid,
+  int tile_idx,
+  int *pos,
+  int *lo,
+  int *dims);
+
+/*
+ * fillTileGhostcellsFromTiles() copies data from neighboring tiles (and
+ * periodic partner tiles) into the ghostcells of the specified tile.
+ * Each ghostcell is copied from the tile that covers it after shifting
+ * by one period in periodic coordinate directions.  Grid cells outside
+ * of a non-periodic boundary of the domain are covered by the tiles at
+ * that boundary (as in copyDataFromTiles()).
+ *
+ * NOTES:
+ * - Source grid cells are never modified by fillTileGhostcellsFromTiles()
+ *   (they either lie in the interior of the source tile or outside of
+ *   a non-periodic boundary of the domain, where the source tile covers
+ *   its own ghostcells), so all tiles may be filled concurrently.
+ */
+static void fillTileGhostcellsFromTiles(
+  LSM_TiledGrid *tiled_grid,
+  LSMLIB_REAL **data,
+  int tile_idx,
+  int *periodic_dirs);
+
+
+/*==================== Function Definitions ==========================*/
+
+LSM_TiledGrid *createTiledGrid(Grid *grid, int *tile_dims)
+{
+  LSM_TiledGrid *tiled_grid;
+  int num_dims = grid->num_dims;
+  int pos[3], lo[3], dims[3];
+  int dir, t;
+
+  tiled_grid = (LSM_TiledGrid *) malloc(sizeof(LSM_TiledGrid));
+  tiled_grid->grid = grid;
+
+  tiled_grid->num_tiles_total = 1;
+  for (dir = 0; dir < 3; dir++) {
+    tiled_grid->num_ghostcells[dir] =
+      (grid->grid_dims_ghostbox[dir] - grid->grid_dims[dir])/2;
+
+    if (dir >= num_dims) {
+      tiled_grid->tile_dims[dir] = 1;
+    } else if ( (tile_dims) && (tile_dims[dir] > 0) ) {
+      tiled_grid->tile_dims[dir] = tile_dims[dir];
+    } else {
+      tiled_grid->tile_dims[dir] = LSM_TILED_GRID_DEFAULT_TILE_DIM;
+    }
+
+    /* only tiles at the boundary of the domain may have ghostcells */
+    /* outside of the domain                                        */
+    if (tiled_grid->tile_dims[dir] < tiled_grid->num_ghostcells[dir]) {
+      tiled_grid->tile_dims[dir] = tiled_grid->num_ghostcells[dir];
+    }
+    if (tiled_grid->tile_dims[dir] > grid->grid_dims[dir]) {
+      tiled_grid->tile_dims[dir] = grid->grid_dims[dir];
+    }
+
+    tiled_grid->num_tiles[dir] =
+      grid->grid_dims[dir]/tiled_grid->tile_dims[dir];
+    tiled_grid->num_tiles_total *= tiled_grid->num_tiles[dir];
+  }
+
+  tiled_grid->tiles =
+    (Grid *) malloc(tiled_grid->num_tiles_total*sizeof(Grid));
+  for (t = 0; t < tiled_grid->num_tiles_total; t++) {
+    getTileBox(tiled_grid, t, pos, lo, dims);
+    setTileGrid(LSM_TILED_GRID_TILE(tiled_grid, t), grid, lo, dims);
+  }
+
+  return tiled_grid;
+}
+
+
+void destroyTiledGrid(LSM_TiledGrid *tiled_grid)
+{
+  if (tiled_grid) {
+    free(tiled_grid->tiles);
+    free(tiled_grid);
+  }
+}
+
+
+void setTileGrid(
+  Grid *tile_grid,
+  Grid *grid,
+  int *lo,
+  int *dims)
+{
+  int shift[3];
+  int dir;
+
+  /* start from the grid for the domain so that the narrow band marks, */
+  /* narrow band widths and lower index space limits are inherited     */
+  *tile_grid = *grid;
+
+  tile_grid->num_gridpts = 1;
+  for (dir = 0; dir < 3; dir++) {
+    shift[dir] = grid->grid_dims[dir] - dims[dir];
+    tile_grid->grid_dims[dir] = dims[dir];
+    tile_grid->grid_dims_ghostbox[dir] =
+      grid->grid_dims_ghostbox[dir] - shift[dir];
+    tile_grid->num_gridpts *= tile_grid->grid_dims_ghostbox[dir];
+
+    if (dir < grid->num_dims) {
+      tile_grid->x_lo[dir] = grid->x_lo[dir] + lo[dir]*grid->dx[dir];
+      tile_grid->x_hi[dir] = tile_grid->x_lo[dir] + dims[dir]*grid->dx[dir];
+      tile_grid->x_lo_ghostbox[dir] = grid->x_lo_ghostbox[dir]
+                                    + lo[dir]*grid->dx[dir];
+      tile_grid->x_hi_ghostbox[dir] = tile_grid->x_lo_ghostbox[dir]
+        + tile_grid->grid_dims_ghostbox[dir]*grid->dx[dir];
+    }
+  }
+
+  /* upper index space limits are offset by the change in grid size */
+  tile_grid->ihi_gb -= shift[0];
+  tile_grid->jhi_gb -= shift[1];
+  tile_grid->khi_gb -= shift[2];
+  tile_grid->ihi_fb -= shift[0];
+  tile_grid->jhi_fb -= shift[1];
+  tile_grid->khi_fb -= shift[2];
+  tile_grid->ihi_D1_fb -= shift[0];
+  tile_grid->jhi_D1_fb -= shift[1];
+  tile_grid->khi_D1_fb -= shift[2];
+  tile_grid->ihi_D2_fb -= shift[0];
+  tile_grid->jhi_D2_fb -= shift[1];
+  tile_grid->khi_D2_fb -= shift[2];
+  tile_grid->ihi_D3_fb -= shift[0];
+  tile_grid->jhi_D3_fb -= shift[1];
+  tile_grid->khi_D3_fb -= shift[2];
+}
+
+
+LSMLIB_REAL **createTiledDataArray(LSM_TiledGrid *tiled_grid)
+{
+  LSMLIB_REAL **data;
+  int t;
+
+  data = (LSMLIB_REAL **)
+    malloc(tiled_grid->num_tiles_total*sizeof(LSMLIB_REAL *));
+
+#pragma omp parallel for schedule(dynamic,1)
+  for (t = 0; t < tiled_grid->num_tiles_total; t++) {
+    int num_gridpts = LSM_TILED_GRID_TILE(tiled_grid, t)->num_gridpts;
+    data[t] = (LSMLIB_REAL *) malloc(num_gridpts*sizeof(LSMLIB_REAL));
+    memset(data[t], 0, num_gridpts*sizeof(LSMLIB_REAL));
+  }
+
+  return data;
+}
+
+
+void destroyTiledDataArray(LSM_TiledGrid *tiled_grid, LSMLIB_REAL **data)
+{
+  int t;
+
+  if (data) {
+    for (t = 0; t < tiled_grid->num_tiles_total; t++) {
+      free(data[t]);
+    }
+    free(data);
+  }
+}
+
+
+void copyDataToTiles(
+  LSM_TiledGrid *tiled_grid,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL **data)
+{
+  Grid *grid = tiled_grid->grid;
+  int nx = grid->grid_dims_ghostbox[0];
+  int ny = grid->grid_dims_ghostbox[1];
+  int t;
+
+#pragma omp parallel for schedule(dynamic,1)
+  for (t = 0; t < tiled_grid->num_tiles_total; t++) {
+    Grid *tile_grid = LSM_TILED_GRID_TILE(tiled_grid, t);
+    int tile_nx = tile_grid->grid_dims_ghostbox[0];
+    int tile_ny = tile_grid->grid_dims_ghostbox[1];
+    int tile_nz = tile_grid->grid_dims_ghostbox[2];
+    int pos[3], lo[3], dims[3];
+    int j, k;
+
+    getTileBox(tiled_grid, t, pos, lo, dims);
+
+    /* tile index l corresponds to grid index l + lo */
+    for (k = 0; k < tile_nz; k++) {
+      for (j = 0; j < tile_ny; j++) {
+        memcpy(&(data[t][tile_nx*(j + tile_ny*k)]),
+               &(phi[lo[0] + nx*(j + lo[1] + ny*(k + lo[2]))]),
+               tile_nx*sizeof(LSMLIB_REAL));
+      }
+    }
+  }
+}
+
+
+void copyDataFromTiles(
+  LSM_TiledGrid *tiled_grid,
+  LSMLIB_REAL **data,
+  LSMLIB_REAL *phi)
+{
+  Grid *grid = tiled_grid->grid;
+  int nx = grid->grid_dims_ghostbox[0];
+  int ny = grid->grid_dims_ghostbox[1];
+  int t;
+
+#pragma omp parallel for schedule(dynamic,1)
+  for (t = 0; t < tiled_grid->num_tiles_total; t++) {
+    Grid *tile_grid = LSM_TILED_GRID_TILE(tiled_grid, t);
+    int tile_nx = tile_grid->grid_dims_ghostbox[0];
+    int tile_ny = tile_grid->grid_dims_ghostbox[1];
+    int pos[3], lo[3], dims[3];
+    int copy_lo[3], copy_hi[3];
+    int dir, j, k;
+
+    getTileBox(tiled_grid, t, pos, lo, dims);
+
+    /* copy the interior of the tile and the ghostcells of the tile */
+    /* that lie outside of the domain                               */
+    for (dir = 0; dir < 3; dir++) {
+      int g = tiled_grid->num_ghostcells[dir];
+      copy_lo[dir] = (pos[dir] == 0) ? 0 : g;
+      copy_hi[dir] = (pos[dir] == tiled_grid->num_tiles[dir]-1) ?
+                     tile_grid->grid_dims_ghostbox[dir] : g + dims[dir];
+    }
+
+    for (k = copy_lo[2]; k < copy_hi[2]; k++) {
+      for (j = copy_lo[1]; j < copy_hi[1]; j++) {
+        memcpy(&(phi[copy_lo[0] + lo[0] + nx*(j + lo[1] + ny*(k + lo[2]))]),
+               &(data[t][copy_lo[0] + tile_nx*(j + tile_ny*k)]),
+               (copy_hi[0]-copy_lo[0])*sizeof(LSMLIB_REAL));
+      }
+    }
+  }
+}
+
+
+int fillTileGhostcells(
+  LSM_TiledGrid *tiled_grid,
+  LSMLIB_REAL **data,
+  int *periodic_dirs,
+  LSM_BoundaryConditionFunction bc)
+{
+  Grid *grid = tiled_grid->grid;
+  int num_dims = grid->num_dims;
+  int no_periodic_dirs[3] = {0, 0, 0};
+  int dir, t;
+
+  if (!periodic_dirs) periodic_dirs = no_periodic_dirs;
+
+  for (dir = 0; dir < num_dims; dir++) {
+    if ( (periodic_dirs[dir]) &&
+         (grid->grid_dims[dir] < tiled_grid->num_ghostcells[dir]) ) {
+      return LSM_TILED_GRID_ERR_INVALID_PERIODIC_DIR;
+    }
+  }
+
+#pragma omp parallel for schedule(dynamic,1)
+  for (t = 0; t < tiled_grid->num_tiles_total; t++) {
+    fillTileGhostcellsFromTiles(tiled_grid, data, t, periodic_dirs);
+  }
+
+  /* impose boundary conditions at non-periodic domain boundaries */
+  /* (after all tiles have been filled because the boundary       */
+  /* conditions modify grid cells read by neighboring tiles)      */
+  if (bc) {
+#pragma omp parallel for schedule(dynamic,1)
+    for (t = 0; t < tiled_grid->num_tiles_total; t++) {
+      Grid *tile_grid = LSM_TILED_GRID_TILE(tiled_grid, t);
+      int pos[3], lo[3], dims[3];
+      int bc_dir;
+
+      getTileBox(tiled_grid, t, pos, lo, dims);
+      for (bc_dir = 0; bc_dir < num_dims; bc_dir++) {
+        if (periodic_dirs[bc_dir]) continue;
+        if (pos[bc_dir] == 0) {
+          bc(data[t], tile_grid, 2*bc_dir);
+        }
+        if (pos[bc_dir] == tiled_grid->num_tiles[bc_dir]-1) {
+          bc(data[t], tile_grid, 2*bc_dir+1);
+        }
+      }
+    }
+  }
+
+  return LSM_TILED_GRID_ERR_SUCCESS;
+}
+
+
+void executeOnTiles(
+  LSM_TiledGrid *tiled_grid,
+  LSM_TileFunction tile_function,
+  void *context)
+{
+  int t;
+
+#pragma omp parallel for schedule(dynamic,1)
+  for (t = 0; t < tiled_grid->num_tiles_total; t++) {
+    tile_function(LSM_TILED_GRID_TILE(tiled_grid, t), t, context);
+  }
+}
+
+
+/*==================== Helper Function Definitions ===================*/
+
+static void getTileBox(
+  LSM_TiledGrid *tiled_grid,
+  int tile_idx,
+  int *pos,
+  int *lo,
+  int *dims)
+{
+  int dir;
+
+  pos[0] = tile_idx % tiled_grid->num_tiles[0];
+  pos[1] = (tile_idx/tiled_grid->num_tiles[0]) % tiled_grid->num_tiles[1];
+  pos[2] = tile_idx/(tiled_grid->num_tiles[0]*tiled_grid->num_tiles[1]);
+
+  for (dir = 0; dir < 3; dir++) {
+    lo[dir] = pos[dir]*tiled_grid->tile_dims[dir];
+    dims[dir] = (pos[dir] == tiled_grid->num_tiles[dir]-1) ?
+                tiled_grid->grid->grid_dims[dir] - lo[dir] :
+                tiled_grid->tile_dims[dir];
+  }
+}
+
+
+static void fillTileGhostcellsFromTiles(
+  LSM_TiledGrid *tiled_grid,
+  LSMLIB_REAL **data,
+  int tile_idx,
+  int *periodic_dirs)
+{
+  Grid *grid = tiled_grid->grid;
+  Grid *tile_grid = LSM_TILED_GRID_TILE(tiled_grid, tile_idx);
+  LSMLIB_REAL *phi = data[tile_idx];
+  int *num_tiles = tiled_grid->num_tiles;
+  int *g = tiled_grid->num_ghostcells;
+  int n[3];
+  int pos[3], lo[3], dims[3];
+
+  /* position of the source tile, index of the source grid cell in */
+  /* the source tile and flag indicating whether the source is this */
+  /* tile and grid cell for each tile index                         */
+  int *src_pos[3], *src_idx[3], *is_self[3];
+
+  int dir, l, i, j, k;
+
+  getTileBox(tiled_grid, tile_idx, pos, lo, dims);
+
+  for (dir = 0; dir < 3; dir++) {
+    int num_cells = grid->grid_dims[dir];
+    int is_periodic = (dir < grid->num_dims) && (periodic_dirs[dir]);
+
+    n[dir] = tile_grid->grid_dims_ghostbox[dir];
+    src_pos[dir] = (int *) malloc(n[dir]*sizeof(int));
+    src_idx[dir] = (int *) malloc(n[dir]*sizeof(int));
+    is_self[dir] = (int *) malloc(n[dir]*sizeof(int));
+
+    for (l = 0; l < n[dir]; l++) {
+      /* index relative to the lower boundary of the domain */
+      int r = lo[dir] + l - g[dir];
+      int p;
+
+      if (is_periodic) {
+        if (r < 0) r += num_cells;
+        else if (r >= num_cells) r -= num_cells;
+      }
+
+      /* grid cells outside of a non-periodic boundary belong to the */
+      /* tile at that boundary                                       */
+      if (r < 0) {
+        p = 0;
+      } else {
+        p = r/tiled_grid->tile_dims[dir];
+        if (p > num_tiles[dir]-1) p = num_tiles[dir]-1;
+      }
+      src_pos[dir][l] = p;
+      src_idx[dir][l] = r - p*tiled_grid->tile_dims[dir] + g[dir];
+      is_self[dir][l] = (p == pos[dir]) && (src_idx[dir][l] == l);
+    }
+  }
+
+  for (k = 0; k < n[2]; k++) {
+    for (j = 0; j < n[1]; j++) {
+      int jk_self = is_self[1][j] && is_self[2][k];
+
+      for (i = 0; i < n[0]; i++) {
+        int src_tile_idx;
+        Grid *src_grid;
+
+        /* skip the interior of the tile */
+        if ( jk_self && (i == g[0]) ) {
+          i = g[0] + dims[0] - 1;
+          continue;
+        }
+        if ( jk_self && is_self[0][i] ) continue;
+
+        src_tile_idx = src_pos[0][i]
+          + num_tiles[0]*(src_pos[1][j] + num_tiles[1]*src_pos[2][k]);
+        src_grid = LSM_TILED_GRID_TILE(tiled_grid, src_tile_idx);
+
+        phi[i + n[0]*(j + n[1]*k)] = data[src_tile_idx][ src_idx[0][i]
+          + src_grid->grid_dims_ghostbox[0]*( src_idx[1][j]
+          + src_grid->grid_dims_ghostbox[1]*src_idx[2][k] ) ];
+      }
+    }
+  }
+
+  for (dir = 0; dir < 3; dir++) {
+    free(src_pos[dir]);
+    free(src_idx[dir]);
+    free(is_self[dir]);
+  }
+}
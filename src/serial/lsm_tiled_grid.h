@@ -0,0 +1,357 @@
+/*
+ * File:        lsm_tiled_grid.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for tiled (shared-memory parallel) execution
+ *              of serial calculations
+ */
+
+#ifndef INCLUDED_LSM_TILED_GRID_H
+#define INCLUDED_LSM_TILED_GRID_H
+
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lsm_grid.h"
+
+
+/*! \file lsm_tiled_grid.h
+ *
+ * \brief
+ * @ref lsm_tiled_grid.h provides support for decomposing the grid of a
+ * serial level set method calculation into tiles that are processed
+ * concurrently by multiple threads.
+ *
+ * The interior of the computational domain is divided into boxes of
+ * (approximately) tile_dims grid cells.  Each tile is described by its
+ * own Grid structure (see LSM_TILED_GRID_TILE()) with the same number
+ * of ghostcells, grid spacing and index space offsets as the grid for
+ * the entire domain, so any toolbox or serial package function that
+ * operates on a Grid may be applied to a single tile.  Tiled data arrays
+ * (created by createTiledDataArray()) store a separate data array,
+ * including ghostcells, for each tile.
+ *
+ * The ghostcells of the tiles are filled by fillTileGhostcells() using
+ *
+ * - data from the interior of neighboring tiles;
+ * - data from the interior of the tiles on the opposite side of the
+ *   domain in periodic coordinate directions;
+ * - a boundary condition from lsm_boundary_conditions.h at the
+ *   remaining (non-periodic) boundaries of the domain.
+ *
+ * executeOnTiles() applies a user-supplied function to every tile.  Tiles
+ * are handed out to threads one at a time (OpenMP dynamic scheduling),
+ * so threads that finish their tiles early take over the remaining
+ * tiles.  Tiles are processed sequentially when LSMLIB is not built with
+ * OpenMP support (--enable-openmp).
+ *
+ * Typical usage is
+ *
+ * \code
+ *   tiled_grid = createTiledGrid(grid, tile_dims);
+ *   phi_tiles = createTiledDataArray(tiled_grid);
+ *   copyDataToTiles(tiled_grid, phi, phi_tiles);
+ *   while (t < t_final) {
+ *     fillTileGhostcells(tiled_grid, phi_tiles, periodic_dirs,
+ *                        linearExtrapolationBC);
+ *     executeOnTiles(tiled_grid, advanceTile, &context);
+ *     t += dt;
+ *   }
+ *   copyDataFromTiles(tiled_grid, phi_tiles, phi);
+ *   destroyTiledDataArray(tiled_grid, phi_tiles);
+ *   destroyTiledGrid(tiled_grid);
+ * \endcode
+ *
+ * NOTES:
+ * - The Grid for the entire domain must remain valid for the lifetime
+ *   of the LSM_TiledGrid.
+ *
+ * - Functions passed to executeOnTiles() may only write to the data
+ *   arrays of the tile they are called for.  Reductions over the grid
+ *   (e.g. stable time step calculations) should store one result per
+ *   tile and combine the results after executeOnTiles() returns.
+ *
+ */
+
+
+/*========================== Error Codes ============================*/
+#define LSM_TILED_GRID_ERR_SUCCESS                             (0)
+#define LSM_TILED_GRID_ERR_INVALID_PERIODIC_DIR                (1)
+
+
+/*============================= Constants ===========================*/
+
+/*
+ * default number of interior grid cells per tile in each coordinate
+ * direction (used when tile_dims is NULL or non-positive)
+ */
+#define LSM_TILED_GRID_DEFAULT_TILE_DIM                        (32)
+
+
+/*!
+ * LSM_TILED_GRID_TILE() returns a pointer to the Grid for the specified
+ * tile.
+ */
+#define LSM_TILED_GRID_TILE(tiled_grid, tile_idx)                          \
+  ( &((tiled_grid)->tiles[(tile_idx)]) )
+
+
+/*!
+ * Structure 'LSM_TiledGrid' stores the decomposition of a Grid into
+ * tiles.
+ *
+ * NOTES:
+ * - The tile at position (t_x, t_y, t_z) in the array of tiles has
+ *   tile index t_x + num_tiles[0]*(t_y + num_tiles[1]*t_z).
+ *
+ * - In each coordinate direction, the tile at position t covers the
+ *   interior grid cells t*tile_dims[dir], ..., (t+1)*tile_dims[dir]-1
+ *   (numbered from the lower boundary of the domain).  The last tile
+ *   in each coordinate direction also covers the remaining grid cells.
+ */
+typedef struct _LSM_TiledGrid
+{
+  /* Grid for the entire computational domain (not owned) */
+  Grid *grid;
+
+  /* number of ghostcells on each side of the domain and of each tile */
+  int num_ghostcells[3];
+
+  /* number of interior grid cells per tile in each direction */
+  int tile_dims[3];
+
+  /* number of tiles in each coordinate direction and in total */
+  int num_tiles[3];
+  int num_tiles_total;
+
+  /* Grid structures for the tiles */
+  Grid *tiles;
+
+} LSM_TiledGrid;
+
+
+/*!
+ * Type of functions applied to the tiles by executeOnTiles().
+ *
+ * Arguments:
+ *  - tile_grid (in):  Grid for the tile
+ *  - tile_idx (in):   index of the tile
+ *  - context (in):    user-supplied context passed to executeOnTiles()
+ */
+typedef void (*LSM_TileFunction)(Grid *tile_grid, int tile_idx,
+                                 void *context);
+
+
+/*!
+ * Type of the boundary condition functions in lsm_boundary_conditions.h
+ * (used by fillTileGhostcells() at the non-periodic boundaries of the
+ * domain).
+ */
+typedef void (*LSM_BoundaryConditionFunction)(LSMLIB_REAL *phi,
+                                              Grid *grid,
+                                              int bdry_location_idx);
+
+
+/*!
+ * createTiledGrid() decomposes the interior of the specified grid into
+ * tiles.
+ *
+ * Arguments:
+ *  - grid (in):       pointer to Grid for the entire domain
+ *  - tile_dims (in):  desired number of interior grid cells per tile
+ *                     in each coordinate direction (NULL to use
+ *                     LSM_TILED_GRID_DEFAULT_TILE_DIM in every direction)
+ *
+ * Return value:       pointer to new LSM_TiledGrid
+ *
+ * NOTES:
+ * - tile_dims is increased to the number of ghostcells in directions
+ *   where it is smaller (so that only tiles at the boundary of the
+ *   domain have ghostcells outside of the domain) and reduced to 
+ *   grid_dims in directions where it is larger.
+ *
+ * - The number of tiles in each coordinate direction is
+ *   grid_dims[dir]/tile_dims[dir], so tiles at the upper end of the
+ *   domain may contain up to 2*tile_dims[dir]-1 grid cells.
+ *
+ * - The size of the tile_dims array should be equal to the number of
+ *   dimensions.
+ *
+ */
+LSM_TiledGrid *createTiledGrid(Grid *grid, int *tile_dims);
+
+
+/*!
+ * destroyTiledGrid() frees the memory used by an LSM_TiledGrid (but not
+ * the Grid for the entire domain).
+ *
+ * Arguments:
+ *  - tiled_grid (in):  pointer to LSM_TiledGrid
+ *
+ * Return value:        none
+ */
+void destroyTiledGrid(LSM_TiledGrid *tiled_grid);
+
+
+/*!
+ * setTileGrid() sets the Grid for a box of interior grid cells of the
+ * domain.  All index space limits are offset from the limits of the
+ * grid for the domain so that the box has the same number of
+ * ghostcells as the domain.
+ *
+ * Arguments:
+ *  - tile_grid (out):  Grid for the box
+ *  - grid (in):        pointer to Grid for the entire domain
+ *  - lo (in):          index (relative to the lower boundary of the
+ *                      interior of the domain) of the first grid cell
+ *                      of the box in each coordinate direction
+ *  - dims (in):        number of grid cells of the box in each
+ *                      coordinate direction
+ *
+ * Return value:        none
+ *
+ * NOTES:
+ * - The size of the lo and dims arrays should be 3 (lo = 0 and
+ *   dims = 1 in unused coordinate directions).
+ *
+ * - The tiles of an LSM_TiledGrid are set using setTileGrid(), which
+ *   may also be used to set up grids for boxes that are not tiles
+ *   (e.g. tiles enlarged by a halo of grid cells).
+ */
+void setTileGrid(Grid *tile_grid, Grid *grid, int *lo, int *dims);
+
+
+/*!
+ * createTiledDataArray() allocates a data array (including ghostcells)
+ * for each tile.  The data arrays are initialized to zero.
+ *
+ * Arguments:
+ *  - tiled_grid (in):  pointer to LSM_TiledGrid
+ *
+ * Return value:        array of pointers to the data arrays for the
+ *                      tiles (indexed by tile index)
+ */
+LSMLIB_REAL **createTiledDataArray(LSM_TiledGrid *tiled_grid);
+
+
+/*!
+ * destroyTiledDataArray() frees the memory used by a tiled data array.
+ *
+ * Arguments:
+ *  - tiled_grid (in):  pointer to LSM_TiledGrid
+ *  - data (in):        tiled data array
+ *
+ * Return value:        none
+ */
+void destroyTiledDataArray(LSM_TiledGrid *tiled_grid, LSMLIB_REAL **data);
+
+
+/*!
+ * copyDataToTiles() copies a data array on the entire grid (including
+ * ghostcells) to a tiled data array.  The ghostcells of every tile are
+ * filled with the corresponding values of the grid data array.
+ *
+ * Arguments:
+ *  - tiled_grid (in):  pointer to LSM_TiledGrid
+ *  - phi (in):         data array for the entire grid
+ *  - data (out):       tiled data array
+ *
+ * Return value:        none
+ */
+void copyDataToTiles(
+  LSM_TiledGrid *tiled_grid,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL **data);
+
+
+/*!
+ * copyDataFromTiles() copies a tiled data array to a data array on the
+ * entire grid.  Interior grid cells are copied from the tile that
+ * covers them, and ghostcells of the grid are copied from the ghostcells
+ * of the tiles at the boundary of the domain.
+ *
+ * Arguments:
+ *  - tiled_grid (in):  pointer to LSM_TiledGrid
+ *  - data (in):        tiled data array
+ *  - phi (out):        data array for the entire grid
+ *
+ * Return value:        none
+ */
+void copyDataFromTiles(
+  LSM_TiledGrid *tiled_grid,
+  LSMLIB_REAL **data,
+  LSMLIB_REAL *phi);
+
+
+/*!
+ * fillTileGhostcells() fills the ghostcells of all tiles (in parallel).
+ * Ghostcells that lie in the interior of the domain (or in the interior
+ * of the domain after shifting by one period in periodic coordinate
+ * directions) are copied from the tile that covers them.  Ghostcells
+ * outside of non-periodic boundaries of the domain are then set by
+ * imposing the specified boundary condition on each tile at the 
+ * boundaries of the domain, in the order x_lo, x_hi, y_lo, y_hi, z_lo,
+ * z_hi.
+ *
+ * Arguments:
+ *  - tiled_grid (in):     pointer to LSM_TiledGrid
+ *  - data (in/out):       tiled data array
+ *  - periodic_dirs (in):  array of flags indicating which coordinate
+ *                         directions are periodic (NULL if no
+ *                         direction is periodic)
+ *  - bc (in):             boundary condition function to impose at
+ *                         non-periodic boundaries of the domain (e.g.
+ *                         linearExtrapolationBC).  If bc is NULL,
+ *                         ghostcells outside of the domain at
+ *                         non-periodic boundaries are not modified.
+ *
+ * Return value:           error code
+ *
+ * NOTES:
+ * - For the same boundary condition, the ghostcell values of every tile
+ *   agree with the ghostcell values of a grid data array obtained by
+ *   imposing periodicBC() in the periodic directions followed by bc on
+ *   the remaining boundaries.
+ *
+ * - Periodic coordinate directions must contain at least as many
+ *   interior grid cells as ghostcells
+ *   (LSM_TILED_GRID_ERR_INVALID_PERIODIC_DIR is returned otherwise).
+ *
+ * - The size of the periodic_dirs array should be equal to the number
+ *   of dimensions.
+ */
+int fillTileGhostcells(
+  LSM_TiledGrid *tiled_grid,
+  LSMLIB_REAL **data,
+  int *periodic_dirs,
+  LSM_BoundaryConditionFunction bc);
+
+
+/*!
+ * executeOnTiles() calls the specified function for every tile.  Tiles
+ * are distributed dynamically among the available threads.
+ *
+ * Arguments:
+ *  - tiled_grid (in):     pointer to LSM_TiledGrid
+ *  - tile_function (in):  function to apply to each tile
+ *  - context (in):        user-supplied data passed to tile_function
+ *
+ * Return value:           none
+ */
+void executeOnTiles(
+  LSM_TiledGrid *tiled_grid,
+  LSM_TileFunction tile_function,
+  void *context);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
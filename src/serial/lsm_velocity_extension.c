@@ -0,0 +1,502 @@
+/*
+ * File:        lsm_velocity_extension.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for narrow band velocity extension in
+ *              the time loop of serial calculations
+ */
+
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "lsm_velocity_extension.h"
+#include "lsm_instrumentation.h"
+
+
+/*============================= Constants ===========================*/
+
+/*
+ * Classification of grid points:
+ *  - OUTSIDE_BAND:    not extended (vel_n_ext = vel_n)
+ *  - INTERFACE:       on or bordering the zero level set
+ *  - IN_BAND:         in the band but not yet extended
+ *  - DEFERRED:        in the band and waiting for upwind neighbors
+ *  - EXTENDED:        in the band and extended
+ *
+ * The values for grid points in the band are all greater than or
+ * equal to IN_BAND.
+ */
+#define LSM_VELOCITY_EXTENSION_OUTSIDE_BAND     (0)
+#define LSM_VELOCITY_EXTENSION_INTERFACE        (1)
+#define LSM_VELOCITY_EXTENSION_IN_BAND          (2)
+#define LSM_VELOCITY_EXTENSION_DEFERRED         (3)
+#define LSM_VELOCITY_EXTENSION_EXTENDED         (4)
+
+/*
+ * Estimated number of data arrays read and written per grid point
+ * (phi, vel_n, vel_n_ext, status and the ordering).
+ */
+#define LSM_VELOCITY_EXTENSION_ARRAYS_PER_PT       (5)
+
+
+/*================== Helper Functions Declarations ==================*/
+
+/*
+ * classifyGridPoints() classifies the grid points for the extension
+ * and computes the extension values at grid points on or bordering the
+ * zero level set (stored in ext->interface_values).  Grid points that
+ * enter the band (i.e. that were not in the band according to
+ * ext->status on entry) are stored at the end of ext->order; the
+ * return value is the number of grid points that entered the band.
+ */
+static int classifyGridPoints(
+  LSM_VelocityExtension *ext,
+  const LSMLIB_REAL *vel_n,
+  const LSMLIB_REAL *phi,
+  const unsigned char *narrow_band);
+
+/*
+ * computeOrdering() collects the grid points in the band and sorts
+ * them by |phi|.
+ */
+static void computeOrdering(
+  LSM_VelocityExtension *ext,
+  const LSMLIB_REAL *phi);
+
+/*
+ * findUpwindNeighbors() determines the upwind neighbor of the grid
+ * point idx in each coordinate direction (i.e. the neighbor not
+ * outside of the band with the smallest |phi| if it is smaller than
+ * |phi| at idx; -1 if there is no such neighbor) and returns 1 if all
+ * of the upwind neighbors have been extended (0 otherwise).
+ */
+static int findUpwindNeighbors(
+  const LSM_VelocityExtension *ext,
+  const LSMLIB_REAL *phi,
+  int idx,
+  int *upwind);
+
+/*
+ * extendGridPoint() computes the extension velocity at the grid point
+ * idx from the extension velocity at its upwind neighbors and appends
+ * idx to the ordering of the current call.
+ */
+static void extendGridPoint(
+  LSM_VelocityExtension *ext,
+  LSMLIB_REAL *vel_n_ext,
+  const LSMLIB_REAL *vel_n,
+  const LSMLIB_REAL *phi,
+  int idx,
+  const int *upwind);
+
+/*
+ * compareVelocityExtensionPoints() compares the keys of two
+ * LSM_VelocityExtensionPoints (for qsort()).
+ */
+static int compareVelocityExtensionPoints(const void *a, const void *b);
+
+
+/*==================== Function Definitions =========================*/
+
+LSM_VelocityExtension* createVelocityExtension(
+  Grid *grid,
+  LSMLIB_REAL band_width)
+{
+  LSM_VelocityExtension *ext;
+  int num_dims;
+  int dir;
+
+  if (!grid) return 0;
+  num_dims = grid->num_dims;
+  if ( (num_dims != 2) && (num_dims != 3) ) return 0;
+
+  ext = (LSM_VelocityExtension*) calloc(1, sizeof(LSM_VelocityExtension));
+  if (!ext) return 0;
+
+  /* set up index space (the third dimension is trivial in 2D) */
+  ext->num_dims = num_dims;
+  ext->num_gridpts = grid->num_gridpts;
+  ext->lo_fb[0] = grid->ilo_fb;  ext->hi_fb[0] = grid->ihi_fb;
+  ext->lo_fb[1] = grid->jlo_fb;  ext->hi_fb[1] = grid->jhi_fb;
+  ext->stride[0] = 1;
+  ext->stride[1] = grid->grid_dims_ghostbox[0];
+  if (num_dims == 3) {
+    ext->lo_fb[2] = grid->klo_fb;  ext->hi_fb[2] = grid->khi_fb;
+    ext->stride[2] = grid->grid_dims_ghostbox[0]*grid->grid_dims_ghostbox[1];
+  } else {
+    ext->lo_fb[2] = 0;  ext->hi_fb[2] = 0;
+    ext->stride[2] = grid->num_gridpts;
+  }
+  for (dir = 0; dir < 3; dir++) {
+    ext->dx[dir] = (dir < num_dims) ? grid->dx[dir] : 1.0;
+  }
+  ext->band_width = band_width;
+
+  /* allocate memory for classification, interface values, ordering */
+  /* and stack of extended grid points                               */
+  ext->status = (unsigned char*) calloc(grid->num_gridpts,
+                                        sizeof(unsigned char));
+  ext->interface_values = (LSMLIB_REAL*) malloc(
+    grid->num_gridpts*sizeof(LSMLIB_REAL));
+  ext->order = (LSM_VelocityExtensionPoint*) malloc(
+    grid->num_gridpts*sizeof(LSM_VelocityExtensionPoint));
+  ext->stack = (int*) malloc(grid->num_gridpts*sizeof(int));
+  if ( (!ext->status) || (!ext->interface_values) || (!ext->order)
+    || (!ext->stack) ) {
+    destroyVelocityExtension(ext);
+    return 0;
+  }
+
+  return ext;
+}
+
+
+void destroyVelocityExtension(LSM_VelocityExtension *ext)
+{
+  if (!ext) return;
+
+  if (ext->status) free(ext->status);
+  if (ext->interface_values) free(ext->interface_values);
+  if (ext->order) free(ext->order);
+  if (ext->stack) free(ext->stack);
+  free(ext);
+}
+
+
+int extendNormalVelocity(
+  LSM_VelocityExtension *ext,
+  LSMLIB_REAL *vel_n_ext,
+  const LSMLIB_REAL *vel_n,
+  const LSMLIB_REAL *phi,
+  const unsigned char *narrow_band)
+{
+  unsigned char *status;
+  const int *stride;
+  int upwind[3];
+  int num_entering;
+  int num_candidates;
+  int num_stack;
+  int idx;
+  int n;
+  LSM_INSTRUMENTATION_START(t_start);
+
+  if ( (!ext) || (!vel_n_ext) || (!vel_n) || (!phi) ) {
+    return LSM_VELOCITY_EXTENSION_ERR_INVALID_ARGUMENT;
+  }
+  status = ext->status;
+  stride = ext->stride;
+
+  /* classify grid points and collect the candidate ordering: either */
+  /* the ordering from the previous call followed by the grid points  */
+  /* that entered the band or a new ordering by increasing |phi|      */
+  num_entering = classifyGridPoints(ext, vel_n, phi, narrow_band);
+  if (ext->ordering_valid) {
+    memmove(ext->order + ext->num_ordered,
+            ext->order + ext->num_gridpts - num_entering,
+            num_entering*sizeof(LSM_VelocityExtensionPoint));
+    num_candidates = ext->num_ordered + num_entering;
+    ext->num_orderings_reused++;
+  } else {
+    computeOrdering(ext, phi);
+    num_candidates = ext->num_ordered;
+    ext->num_orderings_computed++;
+  }
+  ext->ordering_valid = 1;
+
+  /* set values outside of the band and on the zero level set */
+  for (idx = 0; idx < ext->num_gridpts; idx++) {
+    if (LSM_VELOCITY_EXTENSION_INTERFACE == status[idx]) {
+      vel_n_ext[idx] = ext->interface_values[idx];
+    } else if (LSM_VELOCITY_EXTENSION_OUTSIDE_BAND == status[idx]) {
+      vel_n_ext[idx] = vel_n[idx];
+    }
+  }
+
+  /* extend velocity to grid points in the band in the candidate     */
+  /* ordering.  Grid points whose upwind neighbors have not yet been  */
+  /* extended are deferred and extended as soon as their last upwind  */
+  /* neighbor has been extended.  Grid points are appended to the     */
+  /* ordering in the order in which they are extended, which never    */
+  /* overtakes the candidate ordering.                                */
+  ext->num_ordered = 0;
+  ext->num_deferred = 0;
+  for (n = 0; n < num_candidates; n++) {
+    idx = ext->order[n].idx;
+
+    /* skip grid points that left the band */
+    if (LSM_VELOCITY_EXTENSION_IN_BAND != status[idx]) continue;
+
+    if (!findUpwindNeighbors(ext, phi, idx, upwind)) {
+      status[idx] = LSM_VELOCITY_EXTENSION_DEFERRED;
+      ext->num_deferred++;
+      continue;
+    }
+    extendGridPoint(ext, vel_n_ext, vel_n, phi, idx, upwind);
+
+    /* extend deferred grid points that are now ready */
+    num_stack = 0;
+    ext->stack[num_stack++] = idx;
+    while (num_stack > 0) {
+      int idx_cur = ext->stack[--num_stack];
+      int dir, offset;
+
+      for (dir = 0; dir < ext->num_dims; dir++) {
+        for (offset = -1; offset <= 1; offset += 2) {
+          int idx_neighbor = idx_cur + offset*stride[dir];
+          if ( (LSM_VELOCITY_EXTENSION_DEFERRED == status[idx_neighbor])
+            && findUpwindNeighbors(ext, phi, idx_neighbor, upwind) ) {
+            extendGridPoint(ext, vel_n_ext, vel_n, phi, idx_neighbor,
+                            upwind);
+            ext->stack[num_stack++] = idx_neighbor;
+          }
+        }
+      }
+    }
+  }
+
+  LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_FAST_MARCHING_METHOD,
+    t_start,
+    (double) ext->num_gridpts*sizeof(LSMLIB_REAL)
+             *LSM_VELOCITY_EXTENSION_ARRAYS_PER_PT,
+    ext->num_ordered);
+
+  return LSM_VELOCITY_EXTENSION_ERR_SUCCESS;
+}
+
+
+int extendNormalVelocityForDataArrays(
+  LSM_VelocityExtension *ext,
+  LSM_DataArrays *data_arrays,
+  int use_narrow_band)
+{
+  if (!data_arrays) return LSM_VELOCITY_EXTENSION_ERR_INVALID_ARGUMENT;
+
+  return extendNormalVelocity(ext,
+    data_arrays->normal_velocity, data_arrays->normal_velocity,
+    data_arrays->phi,
+    use_narrow_band ? data_arrays->narrow_band : 0);
+}
+
+
+/*==================== Helper Functions Definitions =================*/
+
+static int classifyGridPoints(
+  LSM_VelocityExtension *ext,
+  const LSMLIB_REAL *vel_n,
+  const LSMLIB_REAL *phi,
+  const unsigned char *narrow_band)
+{
+  unsigned char *status = ext->status;
+  LSMLIB_REAL *interface_values = ext->interface_values;
+  LSM_VelocityExtensionPoint *entering = ext->order + ext->num_gridpts;
+  const int *lo_fb = ext->lo_fb;
+  const int *hi_fb = ext->hi_fb;
+  const int *stride = ext->stride;
+  LSMLIB_REAL band_width = ext->band_width;
+  int num_entering = 0;
+  int i, j, k;
+  int idx;
+
+  for (k = 0; k < ext->num_gridpts/stride[2]; k++) {
+    for (j = 0; j < stride[2]/stride[1]; j++) {
+      for (i = 0; i < stride[1]; i++) {
+        LSMLIB_REAL phi_cur;
+        LSMLIB_REAL sum_dist_inv_sq = 0.0;
+        LSMLIB_REAL sum_vel_div_dist_sq = 0.0;
+        unsigned char new_status;
+        int grid_idx[3];
+        int dir;
+
+        idx = i + j*stride[1] + k*stride[2];
+        grid_idx[0] = i;  grid_idx[1] = j;  grid_idx[2] = k;
+
+        /* grid points outside of the fillbox and narrow band */
+        if ( (i < lo_fb[0]) || (i > hi_fb[0])
+          || (j < lo_fb[1]) || (j > hi_fb[1])
+          || (k < lo_fb[2]) || (k > hi_fb[2])
+          || ( (narrow_band) && (0 == narrow_band[idx]) ) ) {
+          status[idx] = LSM_VELOCITY_EXTENSION_OUTSIDE_BAND;
+          continue;
+        }
+
+        phi_cur = phi[idx];
+        new_status = LSM_VELOCITY_EXTENSION_IN_BAND;
+
+        /* grid points on the zero level set */
+        if (fabs(phi_cur) < LSMLIB_ZERO_TOL) {
+          new_status = LSM_VELOCITY_EXTENSION_INTERFACE;
+          interface_values[idx] = vel_n[idx];
+
+        } else {
+
+          /* grid points bordering the zero level set: interpolate  */
+          /* vel_n to the zero level set along each direction and   */
+          /* weight the values by the inverse square of the distance */
+          for (dir = 0; dir < ext->num_dims; dir++) {
+            LSMLIB_REAL dist_dir = LSMLIB_REAL_MAX;
+            LSMLIB_REAL vel_dir = 0.0;
+            int offset;
+
+            for (offset = -1; offset <= 1; offset += 2) {
+              int idx_neighbor = idx + offset*stride[dir];
+              int n_dir = (0 == dir) ? stride[1]
+                        : ( (1 == dir) ? stride[2]/stride[1]
+                                       : ext->num_gridpts/stride[2] );
+              LSMLIB_REAL phi_neighbor;
+              LSMLIB_REAL dist;
+
+              if ( (grid_idx[dir] + offset < 0)
+                || (grid_idx[dir] + offset >= n_dir) ) {
+                continue;
+              }
+              phi_neighbor = phi[idx_neighbor];
+              if (phi_neighbor*phi_cur > 0) continue;
+
+              /* locate zero level set using linear interpolant */
+              dist = phi_cur/(phi_cur - phi_neighbor);
+              if (dist*ext->dx[dir] < dist_dir) {
+                dist_dir = dist*ext->dx[dir];
+                vel_dir = vel_n[idx]
+                        + dist*(vel_n[idx_neighbor] - vel_n[idx]);
+              }
+            }
+
+            if (dist_dir < LSMLIB_REAL_MAX) {
+              LSMLIB_REAL dist_inv_sq = 1.0/(dist_dir*dist_dir);
+              sum_dist_inv_sq += dist_inv_sq;
+              sum_vel_div_dist_sq += vel_dir*dist_inv_sq;
+            }
+          }
+
+          if (sum_dist_inv_sq > 0) {
+            new_status = LSM_VELOCITY_EXTENSION_INTERFACE;
+            interface_values[idx] = sum_vel_div_dist_sq/sum_dist_inv_sq;
+          } else if ( (band_width > 0) && (fabs(phi_cur) > band_width) ) {
+            new_status = LSM_VELOCITY_EXTENSION_OUTSIDE_BAND;
+          }
+        }
+
+        /* record grid points that entered the band (the grid points   */
+        /* in the band on entry occupy the beginning of ext->order, so */
+        /* the two sets cannot overlap)                                */
+        if ( (LSM_VELOCITY_EXTENSION_IN_BAND == new_status)
+          && (status[idx] < LSM_VELOCITY_EXTENSION_IN_BAND) ) {
+          num_entering++;
+          (entering - num_entering)->key = fabs(phi_cur);
+          (entering - num_entering)->idx = idx;
+        }
+        status[idx] = new_status;
+      }
+    }
+  }
+
+  return num_entering;
+}
+
+
+static void computeOrdering(
+  LSM_VelocityExtension *ext,
+  const LSMLIB_REAL *phi)
+{
+  int idx;
+  int n = 0;
+
+  for (idx = 0; idx < ext->num_gridpts; idx++) {
+    if (LSM_VELOCITY_EXTENSION_IN_BAND == ext->status[idx]) {
+      ext->order[n].key = fabs(phi[idx]);
+      ext->order[n].idx = idx;
+      n++;
+    }
+  }
+  ext->num_ordered = n;
+
+  qsort(ext->order, n, sizeof(LSM_VelocityExtensionPoint),
+        compareVelocityExtensionPoints);
+}
+
+
+static int findUpwindNeighbors(
+  const LSM_VelocityExtension *ext,
+  const LSMLIB_REAL *phi,
+  int idx,
+  int *upwind)
+{
+  const unsigned char *status = ext->status;
+  LSMLIB_REAL abs_phi_cur = fabs(phi[idx]);
+  int ready = 1;
+  int dir, offset;
+
+  for (dir = 0; dir < ext->num_dims; dir++) {
+    LSMLIB_REAL abs_phi_upwind = abs_phi_cur;
+
+    upwind[dir] = -1;
+    for (offset = -1; offset <= 1; offset += 2) {
+      int idx_neighbor = idx + offset*ext->stride[dir];
+      if ( (status[idx_neighbor] != LSM_VELOCITY_EXTENSION_OUTSIDE_BAND)
+        && (fabs(phi[idx_neighbor]) < abs_phi_upwind) ) {
+        upwind[dir] = idx_neighbor;
+        abs_phi_upwind = fabs(phi[idx_neighbor]);
+      }
+    }
+
+    if ( (upwind[dir] >= 0)
+      && (LSM_VELOCITY_EXTENSION_INTERFACE != status[upwind[dir]])
+      && (LSM_VELOCITY_EXTENSION_EXTENDED != status[upwind[dir]]) ) {
+      ready = 0;
+    }
+  }
+
+  return ready;
+}
+
+
+static void extendGridPoint(
+  LSM_VelocityExtension *ext,
+  LSMLIB_REAL *vel_n_ext,
+  const LSMLIB_REAL *vel_n,
+  const LSMLIB_REAL *phi,
+  int idx,
+  const int *upwind)
+{
+  LSMLIB_REAL abs_phi_cur = fabs(phi[idx]);
+  LSMLIB_REAL sum_weights = 0.0;
+  LSMLIB_REAL sum_weighted_vel = 0.0;
+  int dir;
+
+  /* upwind discretization of grad(phi) . grad(vel_n_ext) = 0 */
+  for (dir = 0; dir < ext->num_dims; dir++) {
+    if (upwind[dir] >= 0) {
+      LSMLIB_REAL weight = (abs_phi_cur - fabs(phi[upwind[dir]]))
+                         /(ext->dx[dir]*ext->dx[dir]);
+      sum_weights += weight;
+      sum_weighted_vel += weight*vel_n_ext[upwind[dir]];
+    }
+  }
+
+  if (sum_weights > 0) {
+    vel_n_ext[idx] = sum_weighted_vel/sum_weights;
+  } else {
+    vel_n_ext[idx] = vel_n[idx];
+  }
+
+  ext->status[idx] = LSM_VELOCITY_EXTENSION_EXTENDED;
+  ext->order[ext->num_ordered].key = abs_phi_cur;
+  ext->order[ext->num_ordered].idx = idx;
+  ext->num_ordered++;
+}
+
+
+static int compareVelocityExtensionPoints(const void *a, const void *b)
+{
+  LSMLIB_REAL key_a = ((const LSM_VelocityExtensionPoint*) a)->key;
+  LSMLIB_REAL key_b = ((const LSM_VelocityExtensionPoint*) b)->key;
+
+  if (key_a < key_b) return -1;
+  if (key_a > key_b) return 1;
+  return 0;
+}
@@ -0,0 +1,249 @@
+/*
+ * File:        lsm_velocity_extension.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for narrow band velocity extension in the
+ *              time loop of serial calculations
+ */
+
+#ifndef INCLUDED_LSM_VELOCITY_EXTENSION_H
+#define INCLUDED_LSM_VELOCITY_EXTENSION_H
+
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lsm_grid.h"
+#include "lsm_data_arrays.h"
+
+
+/*! \file lsm_velocity_extension.h
+ *
+ * \brief
+ * @ref lsm_velocity_extension.h provides a velocity extension stage for
+ * the time loop of level set method calculations.  The normal velocity
+ * on the zero level set is extended to the grid points in a band
+ * around the zero level set so that it is constant along the normals
+ * to the interface, i.e. the extension velocity satisfies
+ *
+ * \f[
+ *
+ *   \nabla \phi \cdot \nabla V_{ext} = 0.
+ *
+ * \f]
+ *
+ * The extension is computed using the upwind discretization of
+ * Adalsteinsson and Sethian (J. Comp. Phys, vol 148, p 2-22, 1999) in a
+ * single pass over the grid points in the band.  Each grid point is
+ * extended after its upwind neighbors (the neighbors with smaller
+ * |phi|), which is consistent with the order in which the fast marching
+ * method would accept the grid points if phi is a signed distance
+ * function.  Unlike computeExtensionFields3d(), phi is used directly
+ * (it is not replaced by a distance function), so phi should be kept
+ * close to a signed distance function (e.g. by periodic
+ * reinitialization).
+ *
+ * Because the interface moves by less than a grid cell per time step,
+ * the ordering of the grid points changes little between consecutive
+ * time steps.  An LSM_VelocityExtension therefore sorts the grid points
+ * by |phi| only on the first call.  On subsequent calls, the grid
+ * points are visited in the order in which they were extended by the
+ * previous call (followed by the grid points that entered the band);
+ * grid points whose upwind neighbors have not yet been extended are
+ * deferred until they have been.  The extension therefore costs a
+ * small, fixed number of operations per grid point in the band, which
+ * is considerably less than the dozens of iterations of the field
+ * extension equation (see LSM3D_COMPUTE_FIELD_EXTENSION_EQN_RHS())
+ * required to propagate the velocity across the band.
+ *
+ * Typical usage:
+ * \code
+ *   ext = createVelocityExtension(grid, band_width);
+ *   while (t < t_final) {
+ *     ... set data_arrays->normal_velocity near the zero level set ...
+ *     extendNormalVelocityForDataArrays(ext, data_arrays, 1);
+ *     ... advance phi using the extended normal velocity ...
+ *   }
+ *   destroyVelocityExtension(ext);
+ * \endcode
+ *
+ */
+
+
+/*========================== Error Codes ============================*/
+#define LSM_VELOCITY_EXTENSION_ERR_SUCCESS                   (0)
+#define LSM_VELOCITY_EXTENSION_ERR_INVALID_ARGUMENT          (1)
+
+
+/*!
+ * Structure 'LSM_VelocityExtensionPoint' stores a grid point in the
+ * band together with |phi| for the cached ordering.
+ */
+typedef struct _LSM_VelocityExtensionPoint
+{
+  LSMLIB_REAL key;
+  int idx;
+} LSM_VelocityExtensionPoint;
+
+/*!
+ * Structure 'LSM_VelocityExtension' stores the grid information and the
+ * cached ordering of the grid points in the band used by
+ * extendNormalVelocity().
+ */
+typedef struct _LSM_VelocityExtension
+{
+  /* grid (the third dimension is trivial in 2D) */
+  int num_dims;
+  int num_gridpts;
+  int lo_fb[3], hi_fb[3];
+  int stride[3];
+  LSMLIB_REAL dx[3];
+
+  /* grid points farther than band_width from the zero level set */
+  /* are not extended (no cutoff if band_width <= 0)             */
+  LSMLIB_REAL band_width;
+
+  /* classification of grid points from the most recent extension */
+  unsigned char *status;
+
+  /* scratch space for values on the zero level set */
+  LSMLIB_REAL *interface_values;
+
+  /* grid points in the band in the order in which they were */
+  /* extended by the most recent call                         */
+  LSM_VelocityExtensionPoint *order;
+  int num_ordered;
+  int ordering_valid;
+
+  /* scratch space for grid points whose downwind neighbors */
+  /* may be ready to be extended                            */
+  int *stack;
+
+  /* number of times the ordering was computed from scratch, number */
+  /* of times the cached ordering was reused and number of grid     */
+  /* points deferred by the most recent call                        */
+  int num_orderings_computed;
+  int num_orderings_reused;
+  int num_deferred;
+
+} LSM_VelocityExtension;
+
+
+/*!
+ * createVelocityExtension() allocates an LSM_VelocityExtension for the
+ * specified grid.
+ *
+ * Arguments:
+ *  - grid (in):        pointer to Grid data structure
+ *  - band_width (in):  distance from the zero level set beyond which
+ *                      the normal velocity is not extended; if
+ *                      band_width <= 0, the extension is limited only
+ *                      by the narrow band (if any) passed to
+ *                      extendNormalVelocity()
+ *
+ * Return value:        pointer to new LSM_VelocityExtension (NULL if
+ *                      the grid is invalid or memory allocation failed)
+ *
+ * NOTES:
+ *  - The LSM_VelocityExtension may only be used with grids that have
+ *    the same index space and grid spacing as grid.
+ *
+ */
+LSM_VelocityExtension* createVelocityExtension(
+  Grid *grid,
+  LSMLIB_REAL band_width);
+
+/*!
+ * destroyVelocityExtension() frees the memory used by an
+ * LSM_VelocityExtension.
+ *
+ * Arguments:
+ *  - ext (in):  pointer to LSM_VelocityExtension to destroy
+ *
+ * Return value: none
+ *
+ */
+void destroyVelocityExtension(LSM_VelocityExtension *ext);
+
+/*!
+ * extendNormalVelocity() extends the normal velocity off of the zero
+ * level set of phi to the grid points in the band.
+ *
+ * Arguments:
+ *  - ext (in/out):        pointer to LSM_VelocityExtension
+ *  - vel_n_ext (out):     extended normal velocity
+ *  - vel_n (in):          normal velocity (only the values at grid
+ *                         points adjacent to the zero level set are
+ *                         used)
+ *  - phi (in):            level set function
+ *  - narrow_band (in):    narrow band array (see
+ *                         LSM3D_DETERMINE_NARROW_BAND()) or NULL; when
+ *                         non-NULL, only grid points with nonzero
+ *                         narrow band values are extended
+ *
+ * Return value:           LSM_VELOCITY_EXTENSION_ERR_SUCCESS or an
+ *                         error code
+ *
+ * NOTES:
+ *  - vel_n_ext may be the same array as vel_n.
+ *
+ *  - At grid points that border the zero level set, the normal
+ *    velocity is interpolated to the zero level set along each
+ *    coordinate direction in the same way as computeExtensionFields3d().
+ *    At grid points outside of the band (including the ghostcells),
+ *    vel_n_ext is set equal to vel_n.
+ *
+ *  - Grid points in the band that cannot be reached from the zero
+ *    level set through grid points with smaller |phi| (e.g. local
+ *    minima of |phi| away from the zero level set) retain the value
+ *    of vel_n.
+ *
+ *  - The number of times the ordering is computed from scratch and
+ *    reused is recorded in ext->num_orderings_computed and
+ *    ext->num_orderings_reused.  The number of grid points that were
+ *    deferred (i.e. that were out of order in the cached ordering) is
+ *    recorded in ext->num_deferred; it is small compared to the number
+ *    of grid points in the band when phi changes by a fraction of a
+ *    grid cell between calls.
+ *
+ */
+int extendNormalVelocity(
+  LSM_VelocityExtension *ext,
+  LSMLIB_REAL *vel_n_ext,
+  const LSMLIB_REAL *vel_n,
+  const LSMLIB_REAL *phi,
+  const unsigned char *narrow_band);
+
+/*!
+ * extendNormalVelocityForDataArrays() is a convenience wrapper around
+ * extendNormalVelocity() for use with LSM_DataArrays.  It extends
+ * data_arrays->normal_velocity (in place) off of the zero level set
+ * of data_arrays->phi.
+ *
+ * Arguments:
+ *  - ext (in/out):           pointer to LSM_VelocityExtension
+ *  - data_arrays (in/out):   pointer to LSM_DataArrays structure
+ *  - use_narrow_band (in):   flag indicating whether the extension
+ *                            should be restricted to
+ *                            data_arrays->narrow_band
+ *
+ * Return value:              LSM_VELOCITY_EXTENSION_ERR_SUCCESS or an
+ *                            error code
+ *
+ */
+int extendNormalVelocityForDataArrays(
+  LSM_VelocityExtension *ext,
+  LSM_DataArrays *data_arrays,
+  int use_narrow_band);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
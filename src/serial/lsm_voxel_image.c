@@ -0,0 +1,454 @@
+/*
+ * File:        lsm_voxel_image.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for computing signed distance functions
+ *              from segmented voxel images
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+
+#include "lsm_voxel_image.h"
+
+#ifdef LSMLIB_HAVE_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+/*============================= Constants ===========================*/
+
+/*
+ * LSM_VOXEL_IMAGE_INFINITY is used to represent the (squared) distance
+ * to the opposite phase when there is no voxel of the opposite phase
+ * along a grid line.
+ */
+#define LSM_VOXEL_IMAGE_INFINITY    (LSMLIB_REAL_MAX)
+
+/*
+ * LSM_VOXEL_IMAGE_GET_LABEL() returns the label of the interior voxel
+ * with the specified index.
+ */
+#define LSM_VOXEL_IMAGE_GET_LABEL(labels, label_type, idx)               \
+  ( ((label_type) == LSM_VOXEL_IMAGE_UINT8) ?                            \
+    (int) ((const unsigned char*) (labels))[(idx)] :                     \
+    (int) ((const unsigned short*) (labels))[(idx)] )
+
+
+/*================== Helper Functions Declarations ==================*/
+
+/*
+ * computeSignedDistanceForLabel() sets dist to be the signed distance
+ * function for the region where the voxel labels are equal to label.
+ * The sign of dist in this region is given by inside_sign.
+ */
+static int computeSignedDistanceForLabel(
+  LSMLIB_REAL *dist,
+  const void *labels,
+  int label_type,
+  int label,
+  int inside_sign,
+  Grid *grid);
+
+/*
+ * transformLines() applies the one-dimensional squared distance
+ * transform to num_lines grid lines of length line_length.  Line l
+ * starts at dist[line_start[l]] and consecutive points on a line are
+ * separated by stride.  dist contains signed squared distances on
+ * input and output (negative values mark the inside phase).
+ */
+static int transformLines(
+  LSMLIB_REAL *dist,
+  int num_lines,
+  const int *n,
+  int line_dir,
+  LSMLIB_REAL h);
+
+/*
+ * lowerEnvelope() computes the squared distance to the nearest point
+ * of the opposite phase for all points of the specified phase on a
+ * single grid line using the lower envelope of parabolas.
+ */
+static void lowerEnvelope(
+  LSMLIB_REAL *dist_line,
+  int stride,
+  const double *f_abs,
+  const unsigned char *is_inside,
+  unsigned char phase,
+  int m,
+  double h,
+  int *v,
+  double *z,
+  double *f_v);
+
+
+/*==================== Function Definitions =========================*/
+
+int computeSignedDistanceFromLabels(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  const void *labels,
+  int label_type,
+  int phi_label,
+  int mask_label,
+  Grid *grid)
+{
+  int error_code;
+
+  if ( (label_type != LSM_VOXEL_IMAGE_UINT8) &&
+       (label_type != LSM_VOXEL_IMAGE_UINT16) ) {
+    return LSM_VOXEL_IMAGE_ERR_INVALID_LABEL_TYPE;
+  }
+  if ( (grid->num_dims != 2) && (grid->num_dims != 3) ) {
+    return LSM_VOXEL_IMAGE_ERR_INVALID_NUM_DIMS;
+  }
+
+  error_code = computeSignedDistanceForLabel(phi, labels, label_type,
+                                             phi_label, -1, grid);
+  if (error_code != LSM_VOXEL_IMAGE_ERR_SUCCESS) return error_code;
+
+  if (mask) {
+    error_code = computeSignedDistanceForLabel(mask, labels, label_type,
+                                               mask_label, 1, grid);
+  }
+
+  return error_code;
+}
+
+
+int computeSignedDistanceFromLabelFile(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  const char *file_name,
+  long header_size,
+  int label_type,
+  int phi_label,
+  int mask_label,
+  Grid *grid)
+{
+  size_t num_voxels;
+  size_t data_size;
+  int error_code;
+
+  if ( (label_type != LSM_VOXEL_IMAGE_UINT8) &&
+       (label_type != LSM_VOXEL_IMAGE_UINT16) ) {
+    return LSM_VOXEL_IMAGE_ERR_INVALID_LABEL_TYPE;
+  }
+  if ( (grid->num_dims != 2) && (grid->num_dims != 3) ) {
+    return LSM_VOXEL_IMAGE_ERR_INVALID_NUM_DIMS;
+  }
+
+  num_voxels = (size_t) grid->grid_dims[0] * grid->grid_dims[1];
+  if (grid->num_dims == 3) num_voxels *= grid->grid_dims[2];
+  data_size = num_voxels * ( (label_type == LSM_VOXEL_IMAGE_UINT8) ?
+                             sizeof(unsigned char) : sizeof(unsigned short) );
+
+#ifdef LSMLIB_HAVE_MMAP
+  {
+    int fd;
+    struct stat file_stat;
+    size_t map_size = header_size + data_size;
+    void *map;
+
+    fd = open(file_name, O_RDONLY);
+    if (fd < 0) return LSM_VOXEL_IMAGE_ERR_FILE_OPEN_FAILED;
+    if ( (fstat(fd, &file_stat) != 0) ||
+         ((size_t) file_stat.st_size < map_size) ) {
+      close(fd);
+      return LSM_VOXEL_IMAGE_ERR_FILE_READ_FAILED;
+    }
+
+    map = mmap(0, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return LSM_VOXEL_IMAGE_ERR_FILE_READ_FAILED;
+
+    error_code = computeSignedDistanceFromLabels(
+      phi, mask, (const char*) map + header_size, label_type,
+      phi_label, mask_label, grid);
+
+    munmap(map, map_size);
+  }
+#else
+  {
+    FILE *fp;
+    void *labels;
+
+    fp = fopen(file_name, "rb");
+    if (!fp) return LSM_VOXEL_IMAGE_ERR_FILE_OPEN_FAILED;
+
+    labels = malloc(data_size);
+    if (!labels) {
+      fclose(fp);
+      return LSM_VOXEL_IMAGE_ERR_MEMORY_ALLOCATION_FAILED;
+    }
+    if ( (fseek(fp, header_size, SEEK_SET) != 0) ||
+         (fread(labels, 1, data_size, fp) != data_size) ) {
+      free(labels);
+      fclose(fp);
+      return LSM_VOXEL_IMAGE_ERR_FILE_READ_FAILED;
+    }
+    fclose(fp);
+
+    error_code = computeSignedDistanceFromLabels(
+      phi, mask, labels, label_type, phi_label, mask_label, grid);
+
+    free(labels);
+  }
+#endif
+
+  return error_code;
+}
+
+
+/*==================== Helper Functions Definitions =================*/
+
+static int computeSignedDistanceForLabel(
+  LSMLIB_REAL *dist,
+  const void *labels,
+  int label_type,
+  int label,
+  int inside_sign,
+  Grid *grid)
+{
+  int n[3], lo_int[3], n_interior[3];
+  int num_gridpts;
+  int line, num_lines, idx;
+  int error_code = LSM_VOXEL_IMAGE_ERR_SUCCESS;
+  LSMLIB_REAL half_h;
+
+  /* set up index space (the third dimension is trivial in 2D) */
+  n[0] = grid->grid_dims_ghostbox[0];
+  n[1] = grid->grid_dims_ghostbox[1];
+  n[2] = (grid->num_dims == 3) ? grid->grid_dims_ghostbox[2] : 1;
+
+  /* the interior of the grid is offset from the ghostbox by the  */
+  /* number of ghostcells (the fillbox is not the interior of the */
+  /* grid for all spatial derivative accuracy types)              */
+  lo_int[0] = (grid->grid_dims_ghostbox[0] - grid->grid_dims[0])/2;
+  lo_int[1] = (grid->grid_dims_ghostbox[1] - grid->grid_dims[1])/2;
+  lo_int[2] = (grid->num_dims == 3) ?
+              (grid->grid_dims_ghostbox[2] - grid->grid_dims[2])/2 : 0;
+  n_interior[0] = grid->grid_dims[0];
+  n_interior[1] = grid->grid_dims[1];
+  n_interior[2] = (grid->num_dims == 3) ? grid->grid_dims[2] : 1;
+  num_gridpts = n[0]*n[1]*n[2];
+
+  /* set phases and compute distances along the x-direction */
+  num_lines = n[1]*n[2];
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (line = 0; line < num_lines; line++) {
+    int j = line%n[1];
+    int k = line/n[1];
+    int i, i_last;
+    int jj = j - lo_int[1], kk = k - lo_int[2];
+    long label_line_start;
+    LSMLIB_REAL *dist_line = dist + line*n[0];
+
+    /* labels in ghostcells are taken from nearest interior voxel */
+    if (jj < 0) jj = 0;
+    if (jj > n_interior[1]-1) jj = n_interior[1]-1;
+    if (kk < 0) kk = 0;
+    if (kk > n_interior[2]-1) kk = n_interior[2]-1;
+    label_line_start = ((long) kk*n_interior[1] + jj)*n_interior[0];
+
+    for (i = 0; i < n[0]; i++) {
+      int ii = i - lo_int[0];
+      if (ii < 0) ii = 0;
+      if (ii > n_interior[0]-1) ii = n_interior[0]-1;
+      dist_line[i] = (LSM_VOXEL_IMAGE_GET_LABEL(labels, label_type,
+                        label_line_start + ii) == label) ? -1 : 1;
+    }
+
+    /* forward sweep: distance (in grid cells) to nearest point */
+    /* of the opposite phase with a smaller index               */
+    i_last = -1;
+    for (i = 0; i < n[0]; i++) {
+      LSMLIB_REAL sgn = (dist_line[i] < 0) ? -1 : 1;
+      if ( (i > 0) && ((dist_line[i-1] < 0) != (sgn < 0)) ) i_last = i-1;
+      dist_line[i] = (i_last >= 0) ? sgn*(i - i_last)
+                                   : sgn*LSM_VOXEL_IMAGE_INFINITY;
+    }
+
+    /* backward sweep: include points of the opposite phase with a */
+    /* larger index and convert to squared physical distance       */
+    i_last = -1;
+    for (i = n[0]-1; i >= 0; i--) {
+      LSMLIB_REAL sgn = (dist_line[i] < 0) ? -1 : 1;
+      LSMLIB_REAL d = fabs(dist_line[i]);
+      if ( (i < n[0]-1) && ((dist_line[i+1] < 0) != (sgn < 0)) ) {
+        i_last = i+1;
+      }
+      if ( (i_last >= 0) && (i_last - i < d) ) d = i_last - i;
+      if (d < LSM_VOXEL_IMAGE_INFINITY) {
+        d *= grid->dx[0];
+        dist_line[i] = sgn*d*d;
+      }
+    }
+  } /* end loop over lines in x-direction */
+
+  /* transform along the y-direction (and z-direction in 3D) */
+  error_code = transformLines(dist, n[0]*n[2], n, 1, grid->dx[1]);
+  if (error_code != LSM_VOXEL_IMAGE_ERR_SUCCESS) return error_code;
+  if (grid->num_dims == 3) {
+    error_code = transformLines(dist, n[0]*n[1], n, 2, grid->dx[2]);
+    if (error_code != LSM_VOXEL_IMAGE_ERR_SUCCESS) return error_code;
+  }
+
+  /* convert squared distances to signed distances with the zero */
+  /* level set located midway between voxels of different phases */
+  half_h = grid->dx[0];
+  if (grid->dx[1] < half_h) half_h = grid->dx[1];
+  if ( (grid->num_dims == 3) && (grid->dx[2] < half_h) ) half_h = grid->dx[2];
+  half_h *= 0.5;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (idx = 0; idx < num_gridpts; idx++) {
+    LSMLIB_REAL d_sq = dist[idx];
+    LSMLIB_REAL sgn = (d_sq < 0) ? -inside_sign : inside_sign;
+    if (d_sq < 0) d_sq = -d_sq;
+    if (d_sq < LSM_VOXEL_IMAGE_INFINITY) {
+      dist[idx] = -sgn*(sqrt(d_sq) - half_h);
+    } else {
+      dist[idx] = -sgn*LSMLIB_REAL_MAX;
+    }
+  }
+
+  return error_code;
+}
+
+
+static int transformLines(
+  LSMLIB_REAL *dist,
+  int num_lines,
+  const int *n,
+  int line_dir,
+  LSMLIB_REAL h)
+{
+  int m = n[line_dir];
+  int stride = (line_dir == 1) ? n[0] : n[0]*n[1];
+  int error_code = LSM_VOXEL_IMAGE_ERR_SUCCESS;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    int line;
+
+    /* per-thread line scratch space */
+    double *f_abs = (double*) malloc(3*(m+1)*sizeof(double));
+    double *z = f_abs + (m+1);
+    double *f_v = z + (m+1);
+    int *v = (int*) malloc(m*sizeof(int));
+    unsigned char *is_inside = (unsigned char*) malloc(m);
+
+    if ( !f_abs || !v || !is_inside ) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+      error_code = LSM_VOXEL_IMAGE_ERR_MEMORY_ALLOCATION_FAILED;
+    }
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (line = 0; line < num_lines; line++) {
+      LSMLIB_REAL *dist_line;
+      int q;
+
+      if ( !f_abs || !v || !is_inside ) continue;
+
+      /* lines in the y-direction are ordered by (i,k) and lines */
+      /* in the z-direction are ordered by (i,j)                 */
+      if (line_dir == 1) {
+        dist_line = dist + (line%n[0]) + (line/n[0])*n[0]*n[1];
+      } else {
+        dist_line = dist + line;
+      }
+
+      for (q = 0; q < m; q++) {
+        LSMLIB_REAL d_sq = dist_line[q*stride];
+        is_inside[q] = (d_sq < 0);
+        f_abs[q] = is_inside[q] ? -d_sq : d_sq;
+      }
+
+      lowerEnvelope(dist_line, stride, f_abs, is_inside, 1, m, h,
+                    v, z, f_v);
+      lowerEnvelope(dist_line, stride, f_abs, is_inside, 0, m, h,
+                    v, z, f_v);
+    }
+
+    free(f_abs);
+    free(v);
+    free(is_inside);
+
+  } /* end parallel region */
+
+  return error_code;
+}
+
+
+static void lowerEnvelope(
+  LSMLIB_REAL *dist_line,
+  int stride,
+  const double *f_abs,
+  const unsigned char *is_inside,
+  unsigned char phase,
+  int m,
+  double h,
+  int *v,
+  double *z,
+  double *f_v)
+{
+  int k = -1;
+  int p, q;
+
+  /* construct lower envelope of the parabolas centered at each point */
+  /* with height equal to the squared distance to the opposite phase  */
+  /* (which vanishes at points of the opposite phase)                 */
+  for (q = 0; q < m; q++) {
+    double f_q = (is_inside[q] == phase) ? f_abs[q] : 0.0;
+    double s = 0.0;
+
+    if (f_q >= LSM_VOXEL_IMAGE_INFINITY) continue;
+
+    while (k >= 0) {
+      s = ( (f_q + (q*h)*(q*h)) - (f_v[k] + (v[k]*h)*(v[k]*h)) )
+        / (2.0*h*(q - v[k]));
+      if (s <= z[k]) {
+        k--;
+      } else {
+        break;
+      }
+    }
+    k++;
+    v[k] = q;
+    f_v[k] = f_q;
+    z[k] = (k == 0) ? -LSM_VOXEL_IMAGE_INFINITY : s;
+    z[k+1] = LSM_VOXEL_IMAGE_INFINITY;
+  }
+
+  /* no finite parabolas:  leave distances unchanged */
+  if (k < 0) return;
+
+  /* evaluate lower envelope at points of the specified phase */
+  k = 0;
+  for (p = 0; p < m; p++) {
+    double d;
+    while (z[k+1] < p*h) k++;
+    if (is_inside[p] != phase) continue;
+    d = (p - v[k])*h;
+    dist_line[p*stride] = (phase ? -1 : 1) * (d*d + f_v[k]);
+  }
+}
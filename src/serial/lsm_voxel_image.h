@@ -0,0 +1,157 @@
+/*
+ * File:        lsm_voxel_image.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for computing signed distance functions from
+ *              segmented voxel images
+ */
+
+#ifndef INCLUDED_LSM_VOXEL_IMAGE_H
+#define INCLUDED_LSM_VOXEL_IMAGE_H
+
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lsm_grid.h"
+
+
+/*! \file lsm_voxel_image.h
+ *
+ * \brief
+ * @ref lsm_voxel_image.h provides functions for computing signed
+ * distance functions (and masks) directly from segmented voxel images
+ * (e.g. label volumes from micro-CT scans) in two and three dimensions.
+ *
+ * The distance functions are computed using an exact Euclidean distance
+ * transform based on the separable lower envelope algorithms of
+ * Saito/Toriwaki and Meijster et al.  The transform is applied one
+ * coordinate direction at a time to independent grid lines (rows of
+ * each xy-slab, then columns along z), so the cost is linear in the
+ * number of grid points.  The squared distance to the opposite phase
+ * is accumulated in the output array itself (the sign of each entry
+ * records the phase of the voxel), so, apart from per-line scratch
+ * space, the output array is the only full-size array that is required.
+ *
+ */
+
+
+/*========================== Label Types ============================*/
+#define LSM_VOXEL_IMAGE_UINT8                               (1)
+#define LSM_VOXEL_IMAGE_UINT16                              (2)
+
+
+/*========================== Error Codes ============================*/
+#define LSM_VOXEL_IMAGE_ERR_SUCCESS                         (0)
+#define LSM_VOXEL_IMAGE_ERR_MEMORY_ALLOCATION_FAILED        (1)
+#define LSM_VOXEL_IMAGE_ERR_INVALID_LABEL_TYPE              (2)
+#define LSM_VOXEL_IMAGE_ERR_INVALID_NUM_DIMS                (3)
+#define LSM_VOXEL_IMAGE_ERR_FILE_OPEN_FAILED                (4)
+#define LSM_VOXEL_IMAGE_ERR_FILE_READ_FAILED                (5)
+
+
+/*!
+ * computeSignedDistanceFromLabels() computes a signed distance function
+ * for the region of a voxel image with a specified label and
+ * (optionally) a mask for the region with another label.
+ *
+ * Arguments:
+ *  - phi (out):         signed distance function for the region where
+ *                       the voxel labels are equal to phi_label.  phi
+ *                       is negative in this region and positive
+ *                       elsewhere.
+ *  - mask (out):        signed distance function that is positive in
+ *                       the region where the voxel labels are equal to
+ *                       mask_label and negative elsewhere (may be NULL)
+ *  - labels (in):       voxel labels for the interior of the
+ *                       computational domain, ordered with the
+ *                       x-coordinate varying fastest (i.e. an array of
+ *                       size grid->grid_dims[0]*grid->grid_dims[1]
+ *                       (*grid->grid_dims[2] in 3D))
+ *  - label_type (in):   type of the entries of labels
+ *                       (LSM_VOXEL_IMAGE_UINT8 or LSM_VOXEL_IMAGE_UINT16)
+ *  - phi_label (in):    label of the region where phi is negative
+ *  - mask_label (in):   label of the region where mask is positive
+ *                       (e.g. the solid phase of a porous medium).
+ *                       Ignored if mask is NULL.
+ *  - grid (in):         pointer to Grid data structure
+ *
+ * Return value:         LSM_VOXEL_IMAGE_ERR_SUCCESS or an error code
+ *
+ * NOTES:
+ *  - The voxel at grid point (i,j,k) of the interior of the grid
+ *    has label labels[i + j*grid_dims[0] + k*grid_dims[0]*grid_dims[1]].
+ *    Labels in the ghostcells are set equal to the label of the
+ *    nearest interior voxel.
+ *
+ *  - The zero level set of phi lies midway between voxel centers
+ *    with different phases; that is, |phi| is the Euclidean distance
+ *    to the nearest voxel of the opposite phase minus half of the
+ *    (smallest) grid spacing.
+ *
+ *  - If no voxel has label phi_label (or all voxels do), phi is set to
+ *    LSMLIB_REAL_MAX (or -LSMLIB_REAL_MAX).  The same is true of mask.
+ *
+ *  - mask is intended to be used with IMPOSE_MASK() to restrict the
+ *    motion of the zero level set to the region where labels are not
+ *    equal to mask_label.
+ *
+ *  - When LSMLIB is built with OpenMP support, the grid lines along
+ *    each coordinate direction are distributed across threads.
+ *
+ *  - It is the user's responsibility to ensure that memory for phi
+ *    (and mask) has been allocated.
+ *
+ */
+int computeSignedDistanceFromLabels(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  const void *labels,
+  int label_type,
+  int phi_label,
+  int mask_label,
+  Grid *grid);
+
+
+/*!
+ * computeSignedDistanceFromLabelFile() is identical to
+ * computeSignedDistanceFromLabels() except that the voxel labels are
+ * read from a raw binary file.  When the operating system supports
+ * it, the file is memory-mapped rather than read into memory.
+ *
+ * Arguments:
+ *  - phi (out):         see computeSignedDistanceFromLabels()
+ *  - mask (out):        see computeSignedDistanceFromLabels()
+ *  - file_name (in):    name of raw binary file containing voxel labels
+ *                       (in the native byte order of the machine)
+ *  - header_size (in):  number of bytes to skip at the beginning of the
+ *                       file
+ *  - label_type (in):   see computeSignedDistanceFromLabels()
+ *  - phi_label (in):    see computeSignedDistanceFromLabels()
+ *  - mask_label (in):   see computeSignedDistanceFromLabels()
+ *  - grid (in):         pointer to Grid data structure
+ *
+ * Return value:         LSM_VOXEL_IMAGE_ERR_SUCCESS or an error code
+ *
+ */
+int computeSignedDistanceFromLabelFile(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  const char *file_name,
+  long header_size,
+  int label_type,
+  int phi_label,
+  int mask_label,
+  Grid *grid);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -23,8 +23,8 @@ extern "C" {
  * \brief
  * @ref lsm_boundary_conditions2d.h provides support for filling 
  * ghostcells to impose common boundary conditions.  Support is 
- * provided for extrapolation and homogeneous Neumann boundary 
- * conditions.
+ * provided for extrapolation, homogeneous Neumann and periodic 
+ * boundary conditions.
  *
  * The boundary location index is used to identify the location of the
  * boundary relative to the computational domain.  In 2D, the boundary
@@ -51,6 +51,7 @@ extern "C" {
 #define LSM2D_HOMOGENEOUS_NEUMANN_ENO2     lsm2dhomogeneousneumanneno2_
 #define LSM2D_HOMOGENEOUS_NEUMANN_ENO3     lsm2dhomogeneousneumanneno3_
 #define LSM2D_HOMOGENEOUS_NEUMANN_WENO5    lsm2dhomogeneousneumannweno5_
+#define LSM2D_PERIODIC                     lsm2dperiodic_
 
 
 /*!
@@ -228,6 +229,33 @@ void LSM2D_HOMOGENEOUS_NEUMANN_WENO5(
   const int *bdry_location_idx);
 
 
+/*!
+ * LSM2D_PERIODIC() fills the ghostcells at the specified boundary 
+ * location with data from the opposite side of the fillbox (periodic
+ * boundary conditions).
+ *
+ * Arguments:
+ *  - phi (in/out):            grid function for which to set ghostcells
+ *  - bdry_location_idx (in):  boundary location index
+ *  - *_gb (in):               index range for ghostbox
+ *  - *_fb (in):               index range for fillbox (one period of phi
+ *                             in each coordinate direction)
+ *      
+ * Return value:               none
+ *
+ * NOTES:
+ *  - the number of ghostcells at the boundary must not exceed the 
+ *    number of fillbox cells in the direction normal to the boundary.
+ */
+void LSM2D_PERIODIC(
+  LSMLIB_REAL *phi,
+  const int *ilo_gb, const int *ihi_gb,
+  const int *jlo_gb, const int *jhi_gb,
+  const int *ilo_fb, const int *ihi_fb,
+  const int *jlo_fb, const int *jhi_fb,
+  const int *bdry_location_idx);
+
+
 #ifdef __cplusplus
 }
 #endif
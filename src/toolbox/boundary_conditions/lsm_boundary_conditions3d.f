@@ -638,3 +638,133 @@ c { begin subroutine
       end
 c } end subroutine
 c***********************************************************************
+
+c***********************************************************************
+c
+c lsm3dPeriodic() fills the ghostcells at the specified boundary
+c location with data from the opposite side of the fillbox (periodic
+c boundary conditions).
+c
+c Arguments:
+c   phi (in/out):            phi
+c   bdry_location_idx (in):  boundary location index
+c   *_gb (in):               index range for ghostbox
+c   *_fb (in):               index range for fillbox (one period of 
+c                            phi in each coordinate direction)
+c 
+c NOTES:
+c  - fillbox indices must be a subset of ghostbox indices.
+c  - the number of ghostcells at the boundary must not exceed the 
+c    number of fillbox cells in the direction normal to the boundary.
+c  - if bdry_location_idx is out of the range for 3D, then no
+c    ghostcell values are set
+c
+c***********************************************************************
+      subroutine lsm3dPeriodic(
+     &  phi,
+     &  ilo_gb, ihi_gb, jlo_gb, jhi_gb, klo_gb, khi_gb,
+     &  ilo_fb, ihi_fb, jlo_fb, jhi_fb, klo_fb, khi_fb,
+     &  bdry_location_idx)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+      integer ilo_gb, ihi_gb, jlo_gb, jhi_gb, klo_gb, khi_gb
+      integer ilo_fb, ihi_fb, jlo_fb, jhi_fb, klo_fb, khi_fb
+      integer bdry_location_idx
+      real phi(ilo_gb:ihi_gb,jlo_gb:jhi_gb,klo_gb:khi_gb)
+      
+c     local variables       
+      integer i,j,k
+      integer period
+
+      if (bdry_location_idx .eq. 0) then
+c     { copy data from upper end of fillbox in x-direction
+
+        period = ihi_fb - ilo_fb + 1
+        do k = klo_gb, khi_gb
+          do j = jlo_gb, jhi_gb
+            do i = ilo_gb, ilo_fb-1
+              phi(i,j,k) = phi(i+period,j,k)
+            enddo
+          enddo
+        enddo
+
+c     } end copy data from upper end of fillbox in x-direction
+
+      elseif (bdry_location_idx .eq. 1) then
+c     { copy data from lower end of fillbox in x-direction
+
+        period = ihi_fb - ilo_fb + 1
+        do k = klo_gb, khi_gb
+          do j = jlo_gb, jhi_gb
+            do i = ihi_fb+1, ihi_gb
+              phi(i,j,k) = phi(i-period,j,k)
+            enddo
+          enddo
+        enddo
+
+c     } end copy data from lower end of fillbox in x-direction
+
+      elseif (bdry_location_idx .eq. 2) then
+c     { copy data from upper end of fillbox in y-direction
+
+        period = jhi_fb - jlo_fb + 1
+        do k = klo_gb, khi_gb
+          do j = jlo_gb, jlo_fb-1
+            do i = ilo_gb, ihi_gb
+              phi(i,j,k) = phi(i,j+period,k)
+            enddo
+          enddo
+        enddo
+
+c     } end copy data from upper end of fillbox in y-direction
+
+      elseif (bdry_location_idx .eq. 3) then
+c     { copy data from lower end of fillbox in y-direction
+
+        period = jhi_fb - jlo_fb + 1
+        do k = klo_gb, khi_gb
+          do j = jhi_fb+1, jhi_gb
+            do i = ilo_gb, ihi_gb
+              phi(i,j,k) = phi(i,j-period,k)
+            enddo
+          enddo
+        enddo
+
+c     } end copy data from lower end of fillbox in y-direction
+
+      elseif (bdry_location_idx .eq. 4) then
+c     { copy data from upper end of fillbox in z-direction
+
+        period = khi_fb - klo_fb + 1
+        do k = klo_gb, klo_fb-1
+          do j = jlo_gb, jhi_gb
+            do i = ilo_gb, ihi_gb
+              phi(i,j,k) = phi(i,j,k+period)
+            enddo
+          enddo
+        enddo
+
+c     } end copy data from upper end of fillbox in z-direction
+
+      elseif (bdry_location_idx .eq. 5) then
+c     { copy data from lower end of fillbox in z-direction
+
+        period = khi_fb - klo_fb + 1
+        do k = khi_fb+1, khi_gb
+          do j = jlo_gb, jhi_gb
+            do i = ilo_gb, ihi_gb
+              phi(i,j,k) = phi(i,j,k-period)
+            enddo
+          enddo
+        enddo
+
+c     } end copy data from lower end of fillbox in z-direction
+
+      endif
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
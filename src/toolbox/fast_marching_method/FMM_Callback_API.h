@@ -101,6 +101,37 @@ LSMLIB_REAL updateGridPoint_CallbackFunc(
   int *grid_dims,
   LSMLIB_REAL *dx);
 
+/*!
+ * heuristic_CallbackFunc() defines the signature of the optional 
+ * callback function used by FMM_Core_updateNeighbors() to order the 
+ * "trial" points (see FMM_Core_setHeuristic()).
+ *
+ * Arguments:
+ *  - fmm_core_data (in/out):       FMM_CoreData "object" actively managing 
+ *                                  the FMM computation
+ *  - fmm_field_data (in/out):      pointer to FMM_FieldData containing
+ *                                  application specific field data
+ *  - grid_idx (in):                integer array containing the grid index 
+ *                                  of the grid point
+ *  - num_dims (in):                number of dimensions for FMM computation
+ *  - grid_dims (in):               integer array of dimensions of computational
+ *                                  grid
+ *  - dx (in):                      LSMLIB_REAL array containing grid cell 
+ *                                  sizes in each of the coordinate directions
+ *
+ * Return value:                    non-negative value that is added to the 
+ *                                  value of the grid point when it is 
+ *                                  ordered in the set of "trial" points
+ *
+ */
+LSMLIB_REAL heuristic_CallbackFunc(
+  FMM_CoreData *fmm_core_data, 
+  FMM_FieldData *fmm_field_data, 
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
 #ifdef __cplusplus
 }
 #endif
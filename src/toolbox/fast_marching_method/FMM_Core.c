@@ -10,9 +10,11 @@
  
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <float.h>
 #include "FMM_Heap.h"
 #include "FMM_Core.h"
+#include "lsm_instrumentation.h"
 
 #include "LSMLIB_config.h"
 
@@ -21,6 +23,18 @@
 #define FMM_CORE_FALSE                  (0)
 #define FMM_CORE_NULL                   (0)
 #define FMM_CORE_MAX_NDIM               (FMM_HEAP_MAX_NDIM)
+#define FMM_CORE_DEFAULT_LIST_MEM_SIZE  (64)
+
+/*
+ * The list of touched grid points is abandoned (and the status of
+ * all grid points is reset) once more than 1/FMM_CORE_TOUCHED_POINTS_RATIO
+ * of the grid points have been touched.
+ */
+#define FMM_CORE_TOUCHED_POINTS_RATIO   (16)
+
+/* empty slot marker and multiplier for the heap node handle table */
+#define FMM_CORE_HANDLE_TABLE_EMPTY     (-1)
+#define FMM_CORE_HANDLE_TABLE_HASH_MULT (2654435761u)
 
 
 /*======================= FMM_Core Macros =========================*/
@@ -51,6 +65,10 @@
   }                                                                       \
 }
 
+#define FMM_CORE_HANDLE_TABLE_HASH(idx, log2_size)                        \
+  ( (int) ( ((unsigned int) (idx) * FMM_CORE_HANDLE_TABLE_HASH_MULT)      \
+            >> (32 - (log2_size)) ) )
+
 
 /*=============== FMM_Core Helper Function Declarations ==============*/
 
@@ -61,6 +79,58 @@
 static 
 void FMM_Core_updateNeighbors(FMM_CoreData *fmm_core_data, int *grid_idx); 
 
+/*
+ * FMM_Core_prepareFMM_Workspace() readies an FMM_Workspace for a new
+ * FMM calculation on a grid with the specified dimensions.  Only the
+ * grid points touched during the previous calculation are reset unless
+ * the workspace must be enlarged.  Returns FMM_CORE_FALSE if memory
+ * could not be allocated.
+ */
+static
+int FMM_Core_prepareFMM_Workspace(FMM_Workspace *workspace,
+                                  int num_dims, int *grid_dims);
+
+/*
+ * FMM_Core_setGridPointStatus() sets the status of the grid point
+ * with the specified data array index and records the grid point in
+ * the list of touched grid points when it leaves the FAR state.
+ */
+static
+void FMM_Core_setGridPointStatus(FMM_CoreData *fmm_core_data, int idx,
+                                 PointStatus status);
+
+/*
+ * FMM_Core_growIntList() increases the amount of memory allocated
+ * for a list of integers by a factor of two (but not beyond max_size).
+ * Returns FMM_CORE_FALSE if memory could not be allocated.
+ */
+static
+int FMM_Core_growIntList(int **list, int *mem_size, int max_size);
+
+/*
+ * FMM_Core_getHeapNodeHandle(), FMM_Core_setHeapNodeHandle() and
+ * FMM_Core_removeHeapNodeHandle() manage the FMM_Heap handles of
+ * trial points.  In the default mode, the handles are stored in an
+ * array with one entry per grid point.  In lean mode, they are stored
+ * in an open-addressing hash table (with linear probing) keyed on the
+ * data array index, so the memory required is proportional to the
+ * number of trial points.
+ */
+static
+int FMM_Core_getHeapNodeHandle(FMM_Workspace *workspace, int idx);
+static
+void FMM_Core_setHeapNodeHandle(FMM_Workspace *workspace, int idx,
+                                int handle);
+static
+void FMM_Core_removeHeapNodeHandle(FMM_Workspace *workspace, int idx);
+
+/*
+ * FMM_Core_resizeHandleTable() reallocates the lean mode heap node
+ * handle table with 2^log2_size slots and reinserts all of its entries.
+ */
+static
+void FMM_Core_resizeHandleTable(FMM_Workspace *workspace, int log2_size);
+
 
 /*=============== Fast Marching Method Data Structures ==============*/
 struct FMM_CoreData {
@@ -74,17 +144,164 @@ struct FMM_CoreData {
   /* function pointer to grid update function */
   initializeFrontFuncPtr initializeFront;
   updateGridPointFuncPtr updateGridPoint;
+  heuristicFuncPtr heuristic;
 
   /* internal data */
+  unsigned char* gridpoint_status;
+  FMM_Heap* trial_points;
+
+  /* workspace providing the internal data */
+  FMM_Workspace* workspace;
+  int owns_workspace;
+
+  /* instrumentation data */
+  int num_points_accepted;
+#ifdef LSMLIB_ENABLE_INSTRUMENTATION
+  double start_time;
+#endif
+};
+
+struct FMM_Workspace {
+
+  /* dimensions of the grid that the workspace can currently support */
+  int num_dims;
+  int num_gridpoints_allocated;
+
+  /* per grid point data */
+  unsigned char* gridpoint_status;
+
+  /* heap node handles for trial points                              */
+  /* (default mode:  heapnode_handles array with entry per grid point */
+  /*  lean mode:     hash table with handle_table_size slots)        */
+  int lean_mode;
   int* heapnode_handles;
-  int* gridpoint_status;
+  int* handle_table_keys;
+  int* handle_table_values;
+  int handle_table_log2_size;
+  int handle_table_count;
+
+  /* data array indices of grid points whose status is not FAR */
+  int* touched_points;
+  int num_touched_points;
+  int touched_points_mem_size;
+  int touched_points_overflow;
+
+  /* data array indices of initial front points */
+  int* front_points;
+  int num_front_points;
+  int front_points_mem_size;
+
+  /* heap of trial points */
   FMM_Heap* trial_points;
-  FMM_Heap* known_points;
+
+  /* scratch space for FMM_FieldData */
+  LSMLIB_REAL* scratch_data;
+  int scratch_data_size;
 };
 
 
 /*=============== FMM_Core API Function Definitions ==============*/
 
+FMM_Workspace* FMM_Core_createFMM_Workspace(
+  int num_dims,
+  int *grid_dims)
+{
+  FMM_Workspace *workspace;        /* pointer to new FMM_Workspace */
+
+  /* allocate memory for FMM_Workspace */
+  workspace = (FMM_Workspace*) malloc( sizeof(FMM_Workspace) );
+  if (!workspace) return FMM_CORE_NULL;
+
+  workspace->num_dims = 0;
+  workspace->num_gridpoints_allocated = 0;
+  workspace->gridpoint_status = FMM_CORE_NULL;
+  workspace->lean_mode = FMM_CORE_FALSE;
+  workspace->heapnode_handles = FMM_CORE_NULL;
+  workspace->handle_table_keys = FMM_CORE_NULL;
+  workspace->handle_table_values = FMM_CORE_NULL;
+  workspace->handle_table_log2_size = 0;
+  workspace->handle_table_count = 0;
+  workspace->touched_points = FMM_CORE_NULL;
+  workspace->num_touched_points = 0;
+  workspace->touched_points_mem_size = 0;
+  workspace->touched_points_overflow = FMM_CORE_FALSE;
+  workspace->front_points = FMM_CORE_NULL;
+  workspace->num_front_points = 0;
+  workspace->front_points_mem_size = 0;
+  workspace->trial_points = FMM_CORE_NULL;
+  workspace->scratch_data = FMM_CORE_NULL;
+  workspace->scratch_data_size = 0;
+
+  /* allocate memory for the specified grid (if any) */
+  if ( (num_dims > 0) && (grid_dims != FMM_CORE_NULL) ) {
+
+    /* check that num_dimension is supported */
+    if ( num_dims > FMM_CORE_MAX_NDIM ) {
+      fprintf(stderr,
+      "ERROR: Invalid number of dimensions.  Only NDIM < %d supported.\n",
+      FMM_CORE_MAX_NDIM);
+      exit(-1);
+    } 
+
+    if (!FMM_Core_prepareFMM_Workspace(workspace, num_dims, grid_dims)) {
+      FMM_Core_destroyFMM_Workspace(workspace);
+      return FMM_CORE_NULL;
+    }
+  }
+
+  return workspace;
+}
+
+
+FMM_Workspace* FMM_Core_createLeanFMM_Workspace(
+  int num_dims,
+  int *grid_dims)
+{
+  FMM_Workspace *workspace;        /* pointer to new FMM_Workspace */
+
+  /* create empty workspace and switch it to lean mode before */
+  /* allocating memory for the grid                           */
+  workspace = FMM_Core_createFMM_Workspace(0, FMM_CORE_NULL);
+  if (!workspace) return FMM_CORE_NULL;
+  workspace->lean_mode = FMM_CORE_TRUE;
+
+  if ( (num_dims > 0) && (grid_dims != FMM_CORE_NULL) ) {
+
+    /* check that num_dimension is supported */
+    if ( num_dims > FMM_CORE_MAX_NDIM ) {
+      fprintf(stderr,
+      "ERROR: Invalid number of dimensions.  Only NDIM < %d supported.\n",
+      FMM_CORE_MAX_NDIM);
+      exit(-1);
+    }
+
+    if (!FMM_Core_prepareFMM_Workspace(workspace, num_dims, grid_dims)) {
+      FMM_Core_destroyFMM_Workspace(workspace);
+      return FMM_CORE_NULL;
+    }
+  }
+
+  return workspace;
+}
+
+
+void FMM_Core_destroyFMM_Workspace(FMM_Workspace *workspace)
+{
+  if (workspace == FMM_CORE_NULL) return;
+
+  free(workspace->gridpoint_status);
+  free(workspace->heapnode_handles);
+  free(workspace->handle_table_keys);
+  free(workspace->handle_table_values);
+  free(workspace->touched_points);
+  free(workspace->front_points);
+  if (workspace->trial_points != FMM_CORE_NULL)
+    FMM_Heap_destroyHeap(workspace->trial_points);
+  free(workspace->scratch_data);
+  free(workspace);
+}
+
+
 FMM_CoreData* FMM_Core_createFMM_CoreData(
   FMM_FieldData *fmm_field_data,
   int num_dims,
@@ -92,12 +309,29 @@ FMM_CoreData* FMM_Core_createFMM_CoreData(
   LSMLIB_REAL *dx,
   initializeFrontFuncPtr initializeFront,
   updateGridPointFuncPtr updateGridPoint)
+{
+  return FMM_Core_createFMM_CoreDataWithWorkspace(
+           fmm_field_data,
+           num_dims,
+           grid_dims,
+           dx,
+           initializeFront,
+           updateGridPoint,
+           FMM_CORE_NULL);
+}
+
+
+FMM_CoreData* FMM_Core_createFMM_CoreDataWithWorkspace(
+  FMM_FieldData *fmm_field_data,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  initializeFrontFuncPtr initializeFront,
+  updateGridPointFuncPtr updateGridPoint,
+  FMM_Workspace *workspace)
 {
   FMM_CoreData *fmm_core_data;     /* pointer to new FMM_CoreData */
-  int num_gridpoints;              /* number of grid points */
-  int initial_heap_size;           /* initial size for FMM_Heap */
   int i;                           /* loop variable */
-  int *ptr;                        /* integer pointer loop variable */
 
   /* check that num_dimension is supported */
   if ( num_dims > FMM_CORE_MAX_NDIM ) {
@@ -109,18 +343,36 @@ FMM_CoreData* FMM_Core_createFMM_CoreData(
 
   /* allocate memory for FMM_CoreData */
   fmm_core_data = (FMM_CoreData*) malloc( sizeof(FMM_CoreData) );
-
-  /* compute number of grid points */
-  num_gridpoints = 1;
-  for (i = 0; i < num_dims; i++) num_gridpoints *= grid_dims[i];
+  if (!fmm_core_data) return FMM_CORE_NULL;
+
+  /* initialize instrumentation data */
+  fmm_core_data->num_points_accepted = 0;
+#ifdef LSMLIB_ENABLE_INSTRUMENTATION
+  fmm_core_data->start_time = LSM_Instrumentation_getWallTime();
+#endif
+
+  /* use a temporary workspace if one is not provided by the caller */
+  if (workspace == FMM_CORE_NULL) {
+    workspace = FMM_Core_createFMM_Workspace(0, FMM_CORE_NULL);
+    fmm_core_data->owns_workspace = FMM_CORE_TRUE;
+  } else {
+    fmm_core_data->owns_workspace = FMM_CORE_FALSE;
+  }
+  fmm_core_data->workspace = workspace;
+  if ( (workspace == FMM_CORE_NULL) ||
+       !FMM_Core_prepareFMM_Workspace(workspace, num_dims, grid_dims) ) {
+    FMM_Core_destroyFMM_CoreData(fmm_core_data);
+    return FMM_CORE_NULL;
+  }
 
   /* initialize FMM data */
-  fmm_core_data->heapnode_handles = (int*) malloc(num_gridpoints*sizeof(int));
-  fmm_core_data->gridpoint_status = (int*) malloc(num_gridpoints*sizeof(int));
+  fmm_core_data->gridpoint_status = workspace->gridpoint_status;
+  fmm_core_data->trial_points = workspace->trial_points;
   fmm_core_data->num_dims = num_dims;
   fmm_core_data->fmm_field_data = fmm_field_data;
   fmm_core_data->initializeFront = initializeFront;
   fmm_core_data->updateGridPoint = updateGridPoint;
+  fmm_core_data->heuristic = FMM_CORE_NULL;
 
   /* initialize grid_dims and dx to zero */
   for (i = 0; i < FMM_CORE_MAX_NDIM; i++) {
@@ -136,69 +388,84 @@ FMM_CoreData* FMM_Core_createFMM_CoreData(
     fmm_core_data->dx[i] = dx[i];
   }
 
-  /* create an FMM_Heap to store the trial points */
-  /* NOTE: using default heap growth factor by    */
-  /*       specifying 0 for the second argument   */
-  initial_heap_size = 0;
-  for (i = 0; i < num_dims; i++) initial_heap_size += grid_dims[i];
-  fmm_core_data->trial_points = 
-    FMM_Heap_createHeap(num_dims,initial_heap_size,0); 
-
-  /* initialize heapnode handles to have a default value of -1 */
-  ptr = fmm_core_data->heapnode_handles;
-  for (i = 0; i < num_gridpoints; i++, ptr++) {
-    *ptr = -1;
+  return fmm_core_data;
+}
+
+
+void FMM_Core_destroyFMM_CoreData(FMM_CoreData *fmm_core_data)
+{
+#ifdef LSMLIB_ENABLE_INSTRUMENTATION
+  /* record FMM calculation (each accepted point reads and writes */
+  /* the data at the points in the stencils of its neighbors)    */
+  LSM_Instrumentation_record(
+    LSM_INSTRUMENTATION_FAST_MARCHING_METHOD,
+    LSM_Instrumentation_getWallTime() - fmm_core_data->start_time,
+    (double) fmm_core_data->num_points_accepted
+      * (2*fmm_core_data->num_dims+1)*sizeof(LSMLIB_REAL),
+    (double) fmm_core_data->num_points_accepted);
+#endif
+
+  if (fmm_core_data->owns_workspace) {
+    FMM_Core_destroyFMM_Workspace(fmm_core_data->workspace);
   }
+  free(fmm_core_data);
+}
 
-  /* initialize gridpoint status of all cells to FAR */
-  ptr = fmm_core_data->gridpoint_status;
-  for (i = 0; i < num_gridpoints; i++, ptr++) {
-    *ptr = FAR;
+
+LSMLIB_REAL* FMM_Core_getScratchData(
+  FMM_CoreData *fmm_core_data,
+  int num_values)
+{
+  FMM_Workspace *workspace = fmm_core_data->workspace;
+
+  if (num_values <= 0) return FMM_CORE_NULL;
+
+  if (num_values > workspace->scratch_data_size) {
+    LSMLIB_REAL *scratch_data = (LSMLIB_REAL*) realloc(
+      workspace->scratch_data, num_values*sizeof(LSMLIB_REAL));
+    if (!scratch_data) return FMM_CORE_NULL;
+    workspace->scratch_data = scratch_data;
+    workspace->scratch_data_size = num_values;
   }
 
-  return fmm_core_data;
+  return workspace->scratch_data;
 }
 
 
-void FMM_Core_destroyFMM_CoreData(FMM_CoreData *fmm_core_data)
+void FMM_Core_setHeuristic(
+  FMM_CoreData *fmm_core_data,
+  heuristicFuncPtr heuristic)
 {
-  free(fmm_core_data->heapnode_handles);
-  free(fmm_core_data->gridpoint_status);
-  FMM_Heap_destroyHeap(fmm_core_data->trial_points);
-  if (fmm_core_data->known_points != FMM_CORE_NULL)
-    FMM_Heap_destroyHeap(fmm_core_data->known_points);
-  free(fmm_core_data);
+  fmm_core_data->heuristic = heuristic;
 }
 
 
+/*
+ * NOTES:
+ *  (1) The initial front points are kept in the (empty) trial points
+ *      heap until the user-provided callback function returns.  Their
+ *      neighbors are then updated in order of increasing value (the
+ *      order in which they are extracted from the heap).  The order 
+ *      in which neighbors with equal trial values are inserted into 
+ *      the trial points heap affects the order in which they become 
+ *      known (and, at the level of round-off, the results), so the 
+ *      neighbors are updated in heap order rather than in the order
+ *      in which the callback function set the initial front points.
+ */
 void FMM_Core_initializeFront(FMM_CoreData *fmm_core_data)
 {
   int num_dims = fmm_core_data->num_dims; 
   int *grid_dims = fmm_core_data->grid_dims;
   FMM_FieldData *fmm_field_data = fmm_core_data->fmm_field_data;
-  int num_gridpoints;
+  FMM_Workspace *workspace = fmm_core_data->workspace;
 
-  /* list of known points */
-  FMM_Heap *known_points; 
-  int initial_heap_size;
+  /* heap and list of initial front points */
+  FMM_Heap *trial_points = fmm_core_data->trial_points;
+  int *front_points;
   int grid_idx[FMM_CORE_MAX_NDIM];
 
   /* auxilliary variables */
-  int i;         /* loop variable */
-
-  /* compute the number of grid points and initial heap size */
-  num_gridpoints = 1;
-  initial_heap_size = 0;
-  for (i = 0; i < num_dims; i++) {
-    num_gridpoints *= grid_dims[i];
-    initial_heap_size += grid_dims[i];
-  }
-
-  /* create FMM_Heap to contain known points      */
-  /* NOTE: using default heap growth factor by    */
-  /*       specifying 0 for the second argument   */
-  known_points = FMM_Heap_createHeap(num_dims,initial_heap_size,0);
-  fmm_core_data->known_points = known_points;
+  int i, n;      /* loop variables */
 
   /* let user-provided callback function find and initialize the front */
   fmm_core_data->initializeFront(
@@ -208,6 +475,33 @@ void FMM_Core_initializeFront(FMM_CoreData *fmm_core_data)
     fmm_core_data->grid_dims, 
     fmm_core_data->dx);
 
+  /* 
+   * Move initial front points with values less than LSMLIB_REAL_MAX
+   * from the trial points heap to the list of initial front points
+   * (in order of increasing value).
+   */
+  workspace->num_front_points = 0;
+  while (!FMM_Heap_isEmpty(trial_points)) {
+    int idx;   /* data array index */
+    FMM_HeapNode node = FMM_Heap_extractMin(trial_points,
+                                            FMM_CORE_NULL,
+                                            FMM_CORE_NULL);
+
+    if (node.value < LSMLIB_REAL_MAX) {
+      FMM_CORE_IDX(idx, num_dims, node.grid_idx, grid_dims);
+
+      if (workspace->num_front_points == workspace->front_points_mem_size) {
+        if (!FMM_Core_growIntList(&(workspace->front_points),
+                                  &(workspace->front_points_mem_size),
+                                  workspace->num_gridpoints_allocated)) {
+          fprintf(stderr,
+            "ERROR: Unable to allocate memory for FMM_Workspace.\n");
+          exit(-1);
+        }
+      }
+      workspace->front_points[workspace->num_front_points++] = idx;
+    }
+  }
 
   /* 
    * Set initial set of trial points (i.e. all of the 
@@ -216,43 +510,27 @@ void FMM_Core_initializeFront(FMM_CoreData *fmm_core_data)
    *   (1) update their neighbors 
    *   (2) add their neighbors to the list of trial points
    */
+  front_points = workspace->front_points;
+  for (n = 0; n < workspace->num_front_points; n++) {
   
-  while (!FMM_Heap_isEmpty(known_points)) {
-    /* extract grid index of next known point */
-    FMM_HeapNode node = FMM_Heap_extractMin(known_points,
-                                            FMM_CORE_NULL,
-                                            FMM_CORE_NULL);
-
-    
-    /* update neighbors if the value of the node is */
-    /* less than LSMLIB_REAL_MAX                    */
-    if (node.value < LSMLIB_REAL_MAX) {
-
-      /* set grid_idx */
-      for (i = 0; i < num_dims; i++) {
-        grid_idx[i] = node.grid_idx[i];
-      }
-      for (i = num_dims; i < FMM_CORE_MAX_NDIM; i++) {
-        grid_idx[i] = 0;
-      }
-
-      FMM_Core_updateNeighbors(fmm_core_data, grid_idx);
+    /* compute grid_idx of next known point */
+    int idx_remainder = front_points[n];
+    for (i = 0; i < num_dims; i++) {
+      grid_idx[i] = idx_remainder%grid_dims[i];
+      idx_remainder /= grid_dims[i];
+    }
+    for (i = num_dims; i < FMM_CORE_MAX_NDIM; i++) {
+      grid_idx[i] = 0;
     }
 
+    FMM_Core_updateNeighbors(fmm_core_data, grid_idx);
+
   } /* end loop over "known" points */
 
-  /* clean up memory */
-  FMM_Heap_destroyHeap(known_points);
-  fmm_core_data->known_points = FMM_CORE_NULL;
+  workspace->num_front_points = 0;
 }
 
 
-/*
- * FMM_Core_setInitialFrontPoint() first makes a local copy of the grid_idx
- * because the FMM_CORE_IDX calculation and FMM_Heap_insertNode() function
- * require that grid_idx is an array of size FMM_CORE_MAX_NDIM 
- * (= FMM_HEAP_MAX_NDIM).
- */
 void FMM_Core_setInitialFrontPoint(
   FMM_CoreData *fmm_core_data, 
   int *grid_idx, 
@@ -260,58 +538,33 @@ void FMM_Core_setInitialFrontPoint(
 {
   int num_dims = fmm_core_data->num_dims; 
   int *grid_dims = fmm_core_data->grid_dims;
-  int *gridpoint_status = fmm_core_data->gridpoint_status; 
-  int grid_idx_local[FMM_CORE_MAX_NDIM];     /* local copy of grid_idx */
 
   /* auxilliary variables */
-  int i;    /* loop variable */
   int idx;  /* data array index */
 
-  /* make local copy of grid index */
-  for (i = 0; i < num_dims; i++) {
-    grid_idx_local[i] = grid_idx[i];
-  }
-  for (i = num_dims; i < FMM_CORE_MAX_NDIM; i++) {
-    grid_idx_local[i] = 0;
-  }
-
-  /* Set status of grid point based and add it to the "known_points" heap. */
-  FMM_CORE_IDX(idx, num_dims, grid_idx_local, grid_dims);
-  gridpoint_status[idx] = KNOWN;
-  FMM_Heap_insertNode(fmm_core_data->known_points,grid_idx_local,value);
+  /* Set status of grid point and add it to the trial points heap, */
+  /* which holds the initial front points until the callback       */
+  /* function returns (see FMM_Core_initializeFront())             */
+  FMM_CORE_IDX(idx, num_dims, grid_idx, grid_dims);
+  FMM_Core_setGridPointStatus(fmm_core_data, idx, KNOWN);
+  FMM_Heap_insertNode(fmm_core_data->trial_points, grid_idx, value);
 
 }
 
-/*
- * FMM_Core_markPointOutsideDomain() first makes a local copy of the grid_idx
- * because the FMM_CORE_IDX calculation and FMM_Heap_insertNode() function
- * require that grid_idx is an array of size FMM_CORE_MAX_NDIM 
- * (= FMM_HEAP_MAX_NDIM).
- */
+
 void FMM_Core_markPointOutsideDomain(
   FMM_CoreData *fmm_core_data, 
   int *grid_idx)
 {
   int num_dims = fmm_core_data->num_dims; 
   int *grid_dims = fmm_core_data->grid_dims;
-  int *gridpoint_status = fmm_core_data->gridpoint_status; 
-  int grid_idx_local[FMM_CORE_MAX_NDIM];     /* local copy of grid_idx */
 
   /* auxilliary variables */
-  int i;    /* loop variable */
   int idx;  /* data array index */
 
-  /* make local copy of grid index */
-  for (i = 0; i < num_dims; i++) {
-    grid_idx_local[i] = grid_idx[i];
-  }
-  for (i = num_dims; i < FMM_CORE_MAX_NDIM; i++) {
-    grid_idx_local[i] = 0;
-  }
-
   /* set grid point status to OUTSIDE_DOMAIN */
-  FMM_CORE_IDX(idx, num_dims, grid_idx_local, grid_dims);
-  gridpoint_status[idx] = OUTSIDE_DOMAIN;
+  FMM_CORE_IDX(idx, num_dims, grid_idx, grid_dims);
+  FMM_Core_setGridPointStatus(fmm_core_data, idx, OUTSIDE_DOMAIN);
 
 }
 
@@ -326,8 +579,8 @@ void FMM_Core_advanceFront(FMM_CoreData *fmm_core_data)
   int num_dims = fmm_core_data->num_dims;
   int* grid_dims = fmm_core_data->grid_dims;
   FMM_Heap *fmm_trial_points = fmm_core_data->trial_points;
-  int *heapnode_handles = fmm_core_data->heapnode_handles;
-  int *gridpoint_status = fmm_core_data->gridpoint_status;
+  FMM_Workspace *workspace = fmm_core_data->workspace;
+  unsigned char *gridpoint_status = fmm_core_data->gridpoint_status;
   FMM_HeapNode moved_node;
   int moved_handle;
   FMM_HeapNode min_node;
@@ -341,12 +594,14 @@ void FMM_Core_advanceFront(FMM_CoreData *fmm_core_data)
   /* correct the handle for the moved node */
   if (-1 != moved_handle) {  /* update heapnode_data if necessary */
     FMM_CORE_IDX(idx, num_dims, moved_node.grid_idx, grid_dims);
-    heapnode_handles[idx] = moved_handle;
+    FMM_Core_setHeapNodeHandle(workspace, idx, moved_handle);
   }
 
   /* set status of min node to "known" */
   FMM_CORE_IDX(idx, num_dims, min_node.grid_idx, grid_dims);
   gridpoint_status[idx] = KNOWN;
+  if (workspace->lean_mode) FMM_Core_removeHeapNodeHandle(workspace, idx);
+  fmm_core_data->num_points_accepted++;
 
   /* update neighbors */
   FMM_Core_updateNeighbors(fmm_core_data, min_node.grid_idx);
@@ -359,7 +614,8 @@ int FMM_Core_moreGridPointsToUpdate(FMM_CoreData *fmm_core_data)
            FMM_CORE_FALSE : FMM_CORE_TRUE);
 }
 
-int* FMM_Core_getGridPointStatusDataArray(FMM_CoreData *fmm_core_data)
+unsigned char* FMM_Core_getGridPointStatusDataArray(
+  FMM_CoreData *fmm_core_data)
 {
   return (fmm_core_data->gridpoint_status);
 }
@@ -372,8 +628,8 @@ void FMM_Core_updateNeighbors(FMM_CoreData *fmm_core_data, int *grid_idx)
   int* grid_dims = fmm_core_data->grid_dims;
   FMM_Heap *fmm_trial_points = fmm_core_data->trial_points;
   FMM_FieldData *fmm_field_data = fmm_core_data->fmm_field_data;
-  int *heapnode_handles = fmm_core_data->heapnode_handles;
-  int *gridpoint_status = fmm_core_data->gridpoint_status;
+  FMM_Workspace *workspace = fmm_core_data->workspace;
+  unsigned char *gridpoint_status = fmm_core_data->gridpoint_status;
   int num_dims = fmm_core_data->num_dims;
 
   /* variables for update calculation */
@@ -421,26 +677,35 @@ void FMM_Core_updateNeighbors(FMM_CoreData *fmm_core_data, int *grid_idx)
                                                  fmm_core_data->dx);
           if (value < 0) value *= -1; /* only absolute value matters here */
 
+          /* order trial points by value plus heuristic (if set) */
+          if ( (fmm_core_data->heuristic) && (value < LSMLIB_REAL_MAX) ) {
+            value += fmm_core_data->heuristic(fmm_core_data, 
+                                              fmm_field_data,
+                                              neighbor,
+                                              fmm_core_data->num_dims, 
+                                              fmm_core_data->grid_dims, 
+                                              fmm_core_data->dx);
+          }
+
           if (FAR == neighbor_status) {
 
             /* set the status of the neighbor to TRIAL */
-            FMM_CORE_IDX(idx, num_dims, neighbor, grid_dims);
-            gridpoint_status[idx] = TRIAL;
+            FMM_Core_setGridPointStatus(fmm_core_data, idx, TRIAL);
 
             /* insert the new TRIAL point into the FMM_Heap */
             heapnode_handle = FMM_Heap_insertNode(fmm_trial_points, 
                                                   neighbor, value);
 
             /* set the heap node handle */
-            heapnode_handles[idx] = heapnode_handle;
+            FMM_Core_setHeapNodeHandle(workspace, idx, heapnode_handle);
 
           } else { 
             /* 
              * neighbor has status TRIAL, so just update its value in 
              * the heap
              */
-            FMM_CORE_IDX(idx, num_dims, neighbor, grid_dims);
-            FMM_Heap_updateNode(fmm_trial_points, heapnode_handles[idx], 
+            FMM_Heap_updateNode(fmm_trial_points,
+                                FMM_Core_getHeapNodeHandle(workspace, idx),
                                 value);
           } 
         } /* end update of neighbor point (not in "known" set) */
@@ -452,3 +717,280 @@ void FMM_Core_updateNeighbors(FMM_CoreData *fmm_core_data, int *grid_idx)
 
 }
 
+
+int FMM_Core_prepareFMM_Workspace(FMM_Workspace *workspace,
+                                  int num_dims, int *grid_dims)
+{
+  unsigned char *gridpoint_status;
+  int *touched_points;
+  int num_gridpoints;
+  int initial_heap_size;
+  int i;
+
+  /* compute number of grid points and initial heap size */
+  num_gridpoints = 1;
+  initial_heap_size = 0;
+  for (i = 0; i < num_dims; i++) {
+    num_gridpoints *= grid_dims[i];
+    initial_heap_size += grid_dims[i];
+  }
+
+  /* (re)create heap if the number of dimensions has changed */
+  /* NOTE: using default heap growth factor by specifying 0  */
+  /*       for the second argument                           */
+  if (workspace->num_dims != num_dims) {
+    if (workspace->trial_points != FMM_CORE_NULL)
+      FMM_Heap_destroyHeap(workspace->trial_points);
+    workspace->trial_points = 
+      FMM_Heap_createHeap(num_dims,initial_heap_size,0); 
+    workspace->num_dims = num_dims;
+  } else if (!FMM_Heap_isEmpty(workspace->trial_points)) {
+    /* heap is normally empty at the end of an FMM calculation */
+    FMM_Heap_clear(workspace->trial_points);
+  }
+
+  /* empty heap node handle table and list of initial front points */
+  if (workspace->handle_table_count > 0) {
+    int table_size = 1 << workspace->handle_table_log2_size;
+    for (i = 0; i < table_size; i++) {
+      workspace->handle_table_keys[i] = FMM_CORE_HANDLE_TABLE_EMPTY;
+    }
+    workspace->handle_table_count = 0;
+  }
+  workspace->num_front_points = 0;
+
+  if (num_gridpoints > workspace->num_gridpoints_allocated) {
+
+    /* enlarge workspace and reset the status of all grid points */
+    free(workspace->gridpoint_status);
+    free(workspace->heapnode_handles);
+    workspace->heapnode_handles = FMM_CORE_NULL;
+    gridpoint_status = (unsigned char*) malloc(num_gridpoints
+                                               *sizeof(unsigned char));
+    workspace->gridpoint_status = gridpoint_status;
+    if (!gridpoint_status) {
+      workspace->num_gridpoints_allocated = 0;
+      return FMM_CORE_FALSE;
+    }
+    if (!workspace->lean_mode) {
+      workspace->heapnode_handles = (int*) malloc(num_gridpoints*sizeof(int));
+      if (!workspace->heapnode_handles) {
+        workspace->num_gridpoints_allocated = 0;
+        return FMM_CORE_FALSE;
+      }
+    }
+    workspace->num_gridpoints_allocated = num_gridpoints;
+
+    memset(gridpoint_status, FAR, num_gridpoints*sizeof(unsigned char));
+
+  } else if (workspace->touched_points_overflow) {
+
+    /* too many grid points were touched to keep track of them */
+    memset(workspace->gridpoint_status, FAR,
+           workspace->num_gridpoints_allocated*sizeof(unsigned char));
+
+  } else {
+
+    /* only reset grid points touched by the previous calculation */
+    gridpoint_status = workspace->gridpoint_status;
+    touched_points = workspace->touched_points;
+    for (i = 0; i < workspace->num_touched_points; i++) {
+      gridpoint_status[touched_points[i]] = FAR;
+    }
+  }
+  workspace->num_touched_points = 0;
+  workspace->touched_points_overflow = FMM_CORE_FALSE;
+
+  /* create heap node handle table for lean mode */
+  if ( (workspace->lean_mode) && (workspace->handle_table_keys == FMM_CORE_NULL) ) {
+    int log2_size = 1;
+    while ( (1 << log2_size) < 2*initial_heap_size ) log2_size++;
+    FMM_Core_resizeHandleTable(workspace, log2_size);
+    if (workspace->handle_table_keys == FMM_CORE_NULL) return FMM_CORE_FALSE;
+  }
+
+  return FMM_CORE_TRUE;
+}
+
+
+void FMM_Core_setGridPointStatus(FMM_CoreData *fmm_core_data, int idx,
+                                 PointStatus status)
+{
+  FMM_Workspace *workspace = fmm_core_data->workspace;
+
+  if ( (FAR == fmm_core_data->gridpoint_status[idx]) &&
+       (!workspace->touched_points_overflow) ) {
+
+    /* grow list of touched points if necessary */
+    if (workspace->num_touched_points == workspace->touched_points_mem_size) {
+      int max_size = workspace->num_gridpoints_allocated
+                   / FMM_CORE_TOUCHED_POINTS_RATIO;
+      if ( (workspace->touched_points_mem_size >= max_size) ||
+           (!FMM_Core_growIntList(&(workspace->touched_points),
+                                  &(workspace->touched_points_mem_size),
+                                  max_size)) ) {
+        workspace->touched_points_overflow = FMM_CORE_TRUE;
+      }
+    }
+
+    if (!workspace->touched_points_overflow) {
+      workspace->touched_points[workspace->num_touched_points++] = idx;
+    }
+  }
+
+  fmm_core_data->gridpoint_status[idx] = status;
+}
+
+
+int FMM_Core_growIntList(int **list, int *mem_size, int max_size)
+{
+  int new_mem_size = 2*(*mem_size);
+  int *new_list;
+
+  if (new_mem_size < FMM_CORE_DEFAULT_LIST_MEM_SIZE)
+    new_mem_size = FMM_CORE_DEFAULT_LIST_MEM_SIZE;
+  if (new_mem_size > max_size) new_mem_size = max_size;
+  if (new_mem_size <= *mem_size) return FMM_CORE_FALSE;
+
+  new_list = (int*) realloc(*list, new_mem_size*sizeof(int));
+  if (!new_list) return FMM_CORE_FALSE;
+
+  *list = new_list;
+  *mem_size = new_mem_size;
+  return FMM_CORE_TRUE;
+}
+
+
+int FMM_Core_getHeapNodeHandle(FMM_Workspace *workspace, int idx)
+{
+  int *keys;
+  int mask;
+  int slot;
+
+  if (!workspace->lean_mode) return workspace->heapnode_handles[idx];
+
+  keys = workspace->handle_table_keys;
+  mask = (1 << workspace->handle_table_log2_size) - 1;
+  slot = FMM_CORE_HANDLE_TABLE_HASH(idx, workspace->handle_table_log2_size);
+  while (keys[slot] != idx) {
+    if (keys[slot] == FMM_CORE_HANDLE_TABLE_EMPTY) return -1;
+    slot = (slot+1) & mask;
+  }
+  return workspace->handle_table_values[slot];
+}
+
+
+void FMM_Core_setHeapNodeHandle(FMM_Workspace *workspace, int idx,
+                                int handle)
+{
+  int *keys;
+  int mask;
+  int slot;
+
+  if (!workspace->lean_mode) {
+    workspace->heapnode_handles[idx] = handle;
+    return;
+  }
+
+  /* keep load factor of hash table below 1/2 */
+  if ( 2*(workspace->handle_table_count+1)
+     > (1 << workspace->handle_table_log2_size) ) {
+    FMM_Core_resizeHandleTable(workspace,
+                               workspace->handle_table_log2_size+1);
+  }
+
+  keys = workspace->handle_table_keys;
+  mask = (1 << workspace->handle_table_log2_size) - 1;
+  slot = FMM_CORE_HANDLE_TABLE_HASH(idx, workspace->handle_table_log2_size);
+  while ( (keys[slot] != idx) && (keys[slot] != FMM_CORE_HANDLE_TABLE_EMPTY) ) {
+    slot = (slot+1) & mask;
+  }
+  if (keys[slot] == FMM_CORE_HANDLE_TABLE_EMPTY) {
+    keys[slot] = idx;
+    workspace->handle_table_count++;
+  }
+  workspace->handle_table_values[slot] = handle;
+}
+
+
+/*
+ * FMM_Core_removeHeapNodeHandle() uses backward shift deletion so that
+ * no "deleted" markers are required in the hash table.
+ */
+void FMM_Core_removeHeapNodeHandle(FMM_Workspace *workspace, int idx)
+{
+  int *keys = workspace->handle_table_keys;
+  int *values = workspace->handle_table_values;
+  int log2_size = workspace->handle_table_log2_size;
+  int mask = (1 << log2_size) - 1;
+  int slot, next_slot, home_slot;
+
+  /* find entry */
+  slot = FMM_CORE_HANDLE_TABLE_HASH(idx, log2_size);
+  while (keys[slot] != idx) {
+    if (keys[slot] == FMM_CORE_HANDLE_TABLE_EMPTY) return;
+    slot = (slot+1) & mask;
+  }
+
+  /* shift later entries in the probe sequence into the hole */
+  next_slot = slot;
+  while (1) {
+    next_slot = (next_slot+1) & mask;
+    if (keys[next_slot] == FMM_CORE_HANDLE_TABLE_EMPTY) break;
+
+    /* entries whose home slot lies cyclically in (slot, next_slot] */
+    /* must stay where they are                                     */
+    home_slot = FMM_CORE_HANDLE_TABLE_HASH(keys[next_slot], log2_size);
+    if (slot <= next_slot) {
+      if ( (slot < home_slot) && (home_slot <= next_slot) ) continue;
+    } else {
+      if ( (slot < home_slot) || (home_slot <= next_slot) ) continue;
+    }
+
+    keys[slot] = keys[next_slot];
+    values[slot] = values[next_slot];
+    slot = next_slot;
+  }
+  keys[slot] = FMM_CORE_HANDLE_TABLE_EMPTY;
+  workspace->handle_table_count--;
+}
+
+
+void FMM_Core_resizeHandleTable(FMM_Workspace *workspace, int log2_size)
+{
+  int *old_keys = workspace->handle_table_keys;
+  int *old_values = workspace->handle_table_values;
+  int old_size = (old_keys == FMM_CORE_NULL) ? 0
+               : (1 << workspace->handle_table_log2_size);
+  int size = 1 << log2_size;
+  int mask = size - 1;
+  int *keys, *values;
+  int i, slot;
+
+  keys = (int*) malloc(size*sizeof(int));
+  values = (int*) malloc(size*sizeof(int));
+  if ( (!keys) || (!values) ) {
+    fprintf(stderr,
+      "ERROR: Unable to allocate memory for FMM_Workspace.\n");
+    exit(-1);
+  }
+  for (i = 0; i < size; i++) keys[i] = FMM_CORE_HANDLE_TABLE_EMPTY;
+
+  /* reinsert entries */
+  for (i = 0; i < old_size; i++) {
+    if (old_keys[i] != FMM_CORE_HANDLE_TABLE_EMPTY) {
+      slot = FMM_CORE_HANDLE_TABLE_HASH(old_keys[i], log2_size);
+      while (keys[slot] != FMM_CORE_HANDLE_TABLE_EMPTY) {
+        slot = (slot+1) & mask;
+      }
+      keys[slot] = old_keys[i];
+      values[slot] = old_values[i];
+    }
+  }
+
+  free(old_keys);
+  free(old_values);
+  workspace->handle_table_keys = keys;
+  workspace->handle_table_values = values;
+  workspace->handle_table_log2_size = log2_size;
+}
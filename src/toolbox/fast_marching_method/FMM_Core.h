@@ -44,6 +44,23 @@ extern "C" {
  * -# Clean up the memory allocated for the FMM_CoreData using
  *    FMM_Core_destroyFMM_CoreData().
  *
+ * When many FMM calculations are performed (e.g. periodic 
+ * reinitialization during a level set calculation), the memory
+ * required for the FMM calculation may be reused by creating an
+ * FMM_Workspace once using FMM_Core_createFMM_Workspace() and passing 
+ * it to FMM_Core_createFMM_CoreDataWithWorkspace().  The workspace
+ * keeps track of the grid points touched during each calculation, so
+ * the cost of preparing it for the next calculation is proportional
+ * to the number of grid points updated by the previous calculation
+ * rather than the size of the grid.  For very large grids, 
+ * FMM_Core_createLeanFMM_Workspace() creates a workspace that requires
+ * approximately one byte of memory per grid point.
+ *
+ * For calculations that are stopped as soon as specific grid points
+ * are accepted, the order in which "trial" points are accepted may be
+ * modified using FMM_Core_setHeuristic() (as in the A* search 
+ * algorithm) to reduce the number of grid points that are updated.
+ *
  */
 
 
@@ -55,6 +72,13 @@ extern "C" {
  */
 typedef struct FMM_CoreData FMM_CoreData;
 
+/*!
+ * FMM_Workspace is a data structure that contains the memory required 
+ * by FMM calculations (grid point status, heap node handles, heaps, 
+ * etc.).  It may be reused for any number of FMM calculations.
+ */
+typedef struct FMM_Workspace FMM_Workspace;
+
 /*!
  * FMM_FieldData is a user-defined data structure that contains the field 
  * data for the fast marching method calculation (e.g. phi, distance 
@@ -93,6 +117,19 @@ typedef LSMLIB_REAL (*updateGridPointFuncPtr)(
   int *grid_dims,
   LSMLIB_REAL *dx);
 
+/*!
+ * heuristicFuncPtr is a function pointer to the optional callback 
+ * function defined in @ref FMM_Callback_API.h that is used to order
+ * the "trial" points (see FMM_Core_setHeuristic()).
+ */
+typedef LSMLIB_REAL (*heuristicFuncPtr)(  
+  FMM_CoreData *fmm_core_data,
+  FMM_FieldData *fmm_field_data,
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
 
 /*================== FMM_Core Function Declarations ==================*/
 
@@ -144,6 +181,44 @@ FMM_CoreData* FMM_Core_createFMM_CoreData(
   initializeFrontFuncPtr initializeFront,
   updateGridPointFuncPtr updateGridPoint);
 
+/*!
+ * FMM_Core_createFMM_CoreDataWithWorkspace() is identical to
+ * FMM_Core_createFMM_CoreData() except that the memory for the FMM 
+ * calculation is provided by the specified FMM_Workspace.
+ *
+ * Arguments:
+ *  - fmm_field_data (in):          see FMM_Core_createFMM_CoreData()
+ *  - num_dims (in):                see FMM_Core_createFMM_CoreData()
+ *  - grid_dims (in):               see FMM_Core_createFMM_CoreData()
+ *  - dx (in):                      see FMM_Core_createFMM_CoreData()
+ *  - initializeFront (in):         see FMM_Core_createFMM_CoreData()
+ *  - updateGridPoint (in):         see FMM_Core_createFMM_CoreData()
+ *  - workspace (in/out):           FMM_Workspace to use for the FMM 
+ *                                  calculation
+ *
+ * Return value:                    pointer to new FMM_CoreData structure
+ *                                  (NULL if memory could not be allocated)
+ *
+ * NOTES:
+ *  - If workspace is NULL, a temporary workspace is created and 
+ *    then destroyed by FMM_Core_destroyFMM_CoreData().
+ *
+ *  - The workspace is enlarged if it is too small for the specified
+ *    grid.  Otherwise, only the grid points touched by the previous 
+ *    FMM calculation that used the workspace are reset.
+ *
+ *  - A workspace may only be used by one FMM_CoreData at a time.
+ *
+ */
+FMM_CoreData* FMM_Core_createFMM_CoreDataWithWorkspace(
+  FMM_FieldData *fmm_field_data,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx,
+  initializeFrontFuncPtr initializeFront,
+  updateGridPointFuncPtr updateGridPoint,
+  FMM_Workspace *workspace);
+
 /*!
  * FMM_Core_destroyFMM_CoreData() frees the memory associated with an 
  * FMM_CoreData structure.
@@ -153,9 +228,132 @@ FMM_CoreData* FMM_Core_createFMM_CoreData(
  *
  * Return value:           none
  *
+ * NOTES:
+ *  - An FMM_Workspace provided by the user is NOT destroyed.
+ *
  */
 void FMM_Core_destroyFMM_CoreData(FMM_CoreData *fmm_core_data);
 
+/*!
+ * FMM_Core_createFMM_Workspace() allocates memory for an FMM_Workspace
+ * that can be used for FMM calculations on grids with the specified 
+ * dimensions.
+ *
+ * Arguments:
+ *  - num_dims (in):   number of dimensions for FMM computation
+ *  - grid_dims (in):  integer array of dimensions of computational grid
+ *
+ * Return value:       pointer to new FMM_Workspace structure
+ *                     (NULL if memory could not be allocated)
+ *
+ * NOTES:
+ *  - If num_dims is zero or grid_dims is NULL, no memory is allocated
+ *    for the grid until the workspace is used for the first time.
+ *
+ *  - The workspace may also be used for FMM calculations on grids
+ *    with other dimensions.  Memory is reallocated only when the 
+ *    number of grid points exceeds the size of the workspace.
+ *
+ */
+FMM_Workspace* FMM_Core_createFMM_Workspace(
+  int num_dims,
+  int *grid_dims);
+
+/*!
+ * FMM_Core_createLeanFMM_Workspace() allocates memory for an FMM_Workspace
+ * that uses as little memory per grid point as possible.
+ *
+ * Arguments:
+ *  - num_dims (in):   number of dimensions for FMM computation
+ *  - grid_dims (in):  integer array of dimensions of computational grid
+ *
+ * Return value:       pointer to new FMM_Workspace structure
+ *                     (NULL if memory could not be allocated)
+ *
+ * NOTES:
+ *  - A lean workspace stores only the status of each grid point (one
+ *    byte per grid point).  The heap node handles for trial points are 
+ *    kept in a hash table whose size is proportional to the number of 
+ *    trial points rather than in an array with one entry per grid 
+ *    point.  This reduces the memory required for very large grids
+ *    at the cost of a hash table lookup for each heap operation.
+ *
+ *  - See FMM_Core_createFMM_Workspace() for additional notes.
+ *
+ */
+FMM_Workspace* FMM_Core_createLeanFMM_Workspace(
+  int num_dims,
+  int *grid_dims);
+
+/*!
+ * FMM_Core_destroyFMM_Workspace() frees the memory associated with an 
+ * FMM_Workspace structure.
+ *
+ * Arguments:
+ *  - workspace (in):  FMM_Workspace to be destroyed
+ *
+ * Return value:       none
+ *
+ */
+void FMM_Core_destroyFMM_Workspace(FMM_Workspace *workspace);
+
+/*!
+ * FMM_Core_getScratchData() returns an array of at least the specified 
+ * size that may be used by the user (e.g. for the data arrays in the 
+ * FMM_FieldData) for the duration of the FMM calculation.
+ *
+ * Arguments:
+ *  - fmm_core_data (in):  FMM_CoreData "object" actively managing the 
+ *                         FMM computation
+ *  - num_values (in):     required number of LSMLIB_REAL values
+ *
+ * Return value:           pointer to scratch data array (NULL if 
+ *                         num_values is not positive or memory could 
+ *                         not be allocated)
+ *
+ * NOTES:
+ *  - The scratch data is owned by the FMM_Workspace, so it must NOT be 
+ *    freed by the user and it is reused by later FMM calculations.
+ *
+ */
+LSMLIB_REAL* FMM_Core_getScratchData(
+  FMM_CoreData *fmm_core_data,
+  int num_values);
+
+/*!
+ * FMM_Core_setHeuristic() sets the callback function used to order
+ * the "trial" points.  When a heuristic is set, "trial" points are 
+ * accepted in order of increasing value plus heuristic (as in the A* 
+ * search algorithm) instead of increasing value.
+ *
+ * Arguments:
+ *  - fmm_core_data (in):  FMM_CoreData "object" actively managing the 
+ *                         FMM computation
+ *  - heuristic (in):      callback function pointer that is used to 
+ *                         compute the heuristic for a grid point (see 
+ *                         @ref FMM_Callback_API.h for more details);
+ *                         NULL to order "trial" points by value
+ *
+ * Return value:           none
+ *
+ * NOTES:
+ *  - This function MUST be called before FMM_Core_initializeFront().
+ *
+ *  - The heuristic only changes the order in which grid points are 
+ *    accepted.  It is useful for calculations that are stopped as 
+ *    soon as specific grid points are accepted (e.g. point-to-point
+ *    travel times).  If the heuristic is a lower bound on the 
+ *    difference between the values at the target points and at the 
+ *    grid point, the region explored by the calculation is reduced.
+ *    Because grid points may be accepted before all of their upwind 
+ *    neighbors, the computed values are only approximately equal to 
+ *    the values computed without a heuristic.
+ *
+ */
+void FMM_Core_setHeuristic(
+  FMM_CoreData *fmm_core_data,
+  heuristicFuncPtr heuristic);
+
 /*!
  * FMM_Core_initializeFront() sets the initial set of "known" and "trial"
  * points.  It first initializes the list of "known" points by 
@@ -269,8 +467,13 @@ int FMM_Core_moreGridPointsToUpdate(FMM_CoreData *fmm_core_data);
  * 
  * Return value:           pointer to gridpoint_status data array
  *
+ * NOTES:
+ *  - The status of each grid point is stored in a single byte.  The
+ *    values should be cast to PointStatus for comparison.
+ *
  */
-int* FMM_Core_getGridPointStatusDataArray(FMM_CoreData *fmm_core_data);
+unsigned char* FMM_Core_getGridPointStatusDataArray(
+  FMM_CoreData *fmm_core_data);
 
 #ifdef __cplusplus
 }
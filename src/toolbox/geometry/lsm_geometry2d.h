@@ -54,6 +54,12 @@ extern "C" {
                            lsm2dperimeterzerolevelsetcontrolvolume_
 #define LSM2D_PERIMETER_ZERO_LEVEL_SET_DELTA_CONTROL_VOLUME    \
                lsm2dperimeterzerolevelsetdeltacontrolvolume_
+#define LSM2D_AREA_REGION_PHI_LESS_THAN_ZERO_CUT_CELL                    \
+                                        lsm2darearegionphilessthanzerocutcell_
+#define LSM2D_AREA_REGION_PHI_GREATER_THAN_ZERO_CUT_CELL                 \
+                                     lsm2darearegionphigreaterthanzerocutcell_
+#define LSM2D_PERIMETER_ZERO_LEVEL_SET_CUT_CELL                          \
+                                            lsm2dperimeterzerolevelsetcutcell_
 /*!
  * LSM2D_COMPUTE_UNIT_NORMAL() computes the unit normal vector to the
  * interface from \f$ \nabla \phi \f$.
@@ -466,6 +472,144 @@ void LSM2D_PERIMETER_ZERO_LEVEL_SET_DELTA_CONTROL_VOLUME(
   const int *jhi_ib,
   const LSMLIB_REAL *dx,
   const LSMLIB_REAL *dy);
+
+
+/*!
+ * LSM2D_AREA_REGION_PHI_LESS_THAN_ZERO_CUT_CELL() computes the area of
+ * the region where the level set function is less than 0 using cut-cell
+ * quadrature.
+ *
+ * Arguments:
+ *  - area (out):            area of the region where \f$ \phi < 0 \f$
+ *  - phi (in):              level set function
+ *  - dx, dy (in):           grid spacing
+ *  - *_gb (in):             index range for ghostbox
+ *  - *_ib (in):             index range for interior box
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ * - The integral is computed over the control volumes of the grid
+ *   points in the interior box using the grid cells (i.e. the cells
+ *   whose corners are grid points) that overlap them.  Grid cells that
+ *   straddle the boundary of the interior box are clipped to the
+ *   half-cell inside of it, so phi must be available in a layer of one
+ *   ghostcell around the interior box.
+ *
+ * - Each grid cell is split into two triangles within which phi is
+ *   approximated by a linear function.  The corners of the triangles
+ *   are grid points (bilinear interpolation is only used for clipped
+ *   grid cells), so the approximation interpolates phi.  The result
+ *   is exact (to round-off) when phi is linear and second-order
+ *   accurate for smooth interfaces.  Grid cells that are not cut by
+ *   the zero level set do not require any triangle calculations.
+ *
+ */
+void LSM2D_AREA_REGION_PHI_LESS_THAN_ZERO_CUT_CELL(
+  LSMLIB_REAL *area,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb, 
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb, 
+  const int *jhi_phi_gb,
+  const int *ilo_ib, 
+  const int *ihi_ib,
+  const int *jlo_ib, 
+  const int *jhi_ib,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy);
+
+
+/*!
+ * LSM2D_AREA_REGION_PHI_GREATER_THAN_ZERO_CUT_CELL() computes the area
+ * of the region where the level set function is greater than 0 using
+ * cut-cell quadrature.
+ *
+ * Arguments:
+ *  - area (out):            area of the region where \f$ \phi > 0 \f$
+ *  - phi (in):              level set function
+ *  - dx, dy (in):           grid spacing
+ *  - *_gb (in):             index range for ghostbox
+ *  - *_ib (in):             index range for interior box
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ * - The integral is computed over the control volumes of the grid
+ *   points in the interior box using the grid cells (i.e. the cells
+ *   whose corners are grid points) that overlap them.  Grid cells that
+ *   straddle the boundary of the interior box are clipped to the
+ *   half-cell inside of it, so phi must be available in a layer of one
+ *   ghostcell around the interior box.
+ *
+ * - Each grid cell is split into two triangles within which phi is
+ *   approximated by a linear function.  The corners of the triangles
+ *   are grid points (bilinear interpolation is only used for clipped
+ *   grid cells), so the approximation interpolates phi.  The result
+ *   is exact (to round-off) when phi is linear and second-order
+ *   accurate for smooth interfaces.  Grid cells that are not cut by
+ *   the zero level set do not require any triangle calculations.
+ *
+ */
+void LSM2D_AREA_REGION_PHI_GREATER_THAN_ZERO_CUT_CELL(
+  LSMLIB_REAL *area,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb, 
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb, 
+  const int *jhi_phi_gb,
+  const int *ilo_ib, 
+  const int *ihi_ib,
+  const int *jlo_ib, 
+  const int *jhi_ib,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy);
+
+
+/*!
+ * LSM2D_PERIMETER_ZERO_LEVEL_SET_CUT_CELL() computes the perimeter of
+ * the zero level set using cut-cell quadrature.
+ *
+ * Arguments:
+ *  - perimeter (out):       perimeter of the zero level set
+ *  - phi (in):              level set function
+ *  - dx, dy (in):           grid spacing
+ *  - *_gb (in):             index range for ghostbox
+ *  - *_ib (in):             index range for interior box
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ * - The integral is computed over the control volumes of the grid
+ *   points in the interior box using the grid cells (i.e. the cells
+ *   whose corners are grid points) that overlap them.  Grid cells that
+ *   straddle the boundary of the interior box are clipped to the
+ *   half-cell inside of it, so phi must be available in a layer of one
+ *   ghostcell around the interior box.
+ *
+ * - Each grid cell is split into two triangles within which phi is
+ *   approximated by a linear function.  The corners of the triangles
+ *   are grid points (bilinear interpolation is only used for clipped
+ *   grid cells), so the approximation interpolates phi.  The result
+ *   is exact (to round-off) when phi is linear and second-order
+ *   accurate for smooth interfaces.  Grid cells that are not cut by
+ *   the zero level set do not require any triangle calculations.
+ *
+ */
+void LSM2D_PERIMETER_ZERO_LEVEL_SET_CUT_CELL(
+  LSMLIB_REAL *perimeter,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb, 
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb, 
+  const int *jhi_phi_gb,
+  const int *ilo_ib, 
+  const int *ihi_ib,
+  const int *jlo_ib, 
+  const int *jhi_ib,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy);
+
 #ifdef __cplusplus
 }
 #endif
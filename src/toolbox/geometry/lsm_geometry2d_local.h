@@ -38,6 +38,12 @@ extern "C" {
                                        lsm2dcomputesignedunitnormallocal_
 #define LSM2D_PERIMETER_ZERO_LEVEL_SET_DELTA_CONTROL_VOLUME_LOCAL         \
                            lsm2dperimeterzerolevelsetdeltacontrolvolumelocal_
+#define LSM2D_AREA_REGION_PHI_LESS_THAN_ZERO_CUT_CELL_LOCAL              \
+                                   lsm2darearegionphilessthanzerocutcelllocal_
+#define LSM2D_AREA_REGION_PHI_GREATER_THAN_ZERO_CUT_CELL_LOCAL           \
+                                lsm2darearegionphigreaterthanzerocutcelllocal_
+#define LSM2D_PERIMETER_ZERO_LEVEL_SET_CUT_CELL_LOCAL                    \
+                                       lsm2dperimeterzerolevelsetcutcelllocal_
 /*!
  * LSM2D_COMPUTE_UNIT_NORMAL_LOCAL() computes the unit normal vector to the
  * interface from \f$ \nabla \phi \f$ using the slightly modified 
@@ -219,6 +225,164 @@ void LSM2D_PERIMETER_ZERO_LEVEL_SET_DELTA_CONTROL_VOLUME_LOCAL(
   const int *jhi_nb_gb,
   const unsigned char *mark_fb);
 
+
+/*!
+ * LSM2D_AREA_REGION_PHI_LESS_THAN_ZERO_CUT_CELL_LOCAL() computes the
+ * area of the region where the level set function is less than 0 using
+ * cut-cell quadrature.
+ *
+ * Arguments:
+ *  - area (out):            area of the region where \f$ \phi < 0 \f$
+ *  - phi (in):              level set function
+ *  - dx, dy (in):           grid spacing
+ *  - *_gb (in):             index range for ghostbox
+ *  - index_[xy](in):        [xy] coordinates of local (narrow band) points
+ *  - n*_index(in):          index range of points to loop over in index_*
+ *  - narrow_band(in):       array that marks voxels outside desired fillbox
+ *  - mark_fb(in):           upper limit narrow band value for voxels in 
+ *                           fillbox
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ * - Only the control volumes of the grid points in the fillbox of the
+ *   narrow band are included.  Because the region \f$ \{ \phi < 0 \} \f$
+ *   generally extends beyond the narrow band, the full area is the sum
+ *   of this value and dx*dy times the number of grid points outside of
+ *   the narrow band where \f$ \phi < 0 \f$.
+ *
+ * - See LSM2D_AREA_REGION_PHI_LESS_THAN_ZERO_CUT_CELL()
+ *   for a description of the cut-cell quadrature.  Each grid point
+ *   in the fillbox receives 1/4 of the contribution of each of the
+ *   four grid cells that it is a corner of, so the result agrees with
+ *   the full-grid calculation except in grid cells that straddle the
+ *   boundary of the fillbox.
+ *
+ */
+void LSM2D_AREA_REGION_PHI_LESS_THAN_ZERO_CUT_CELL_LOCAL(
+  LSMLIB_REAL *area,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb, 
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb, 
+  const int *jhi_phi_gb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const int *index_x,
+  const int *index_y,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const unsigned char *mark_fb);
+
+
+/*!
+ * LSM2D_AREA_REGION_PHI_GREATER_THAN_ZERO_CUT_CELL_LOCAL() computes the
+ * area of the region where the level set function is greater than 0
+ * using cut-cell quadrature.
+ *
+ * Arguments:
+ *  - area (out):            area of the region where \f$ \phi > 0 \f$
+ *  - phi (in):              level set function
+ *  - dx, dy (in):           grid spacing
+ *  - *_gb (in):             index range for ghostbox
+ *  - index_[xy](in):        [xy] coordinates of local (narrow band) points
+ *  - n*_index(in):          index range of points to loop over in index_*
+ *  - narrow_band(in):       array that marks voxels outside desired fillbox
+ *  - mark_fb(in):           upper limit narrow band value for voxels in 
+ *                           fillbox
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ * - Only the control volumes of the grid points in the fillbox of the
+ *   narrow band are included.  Because the region \f$ \{ \phi > 0 \} \f$
+ *   generally extends beyond the narrow band, the full area is the sum
+ *   of this value and dx*dy times the number of grid points outside of
+ *   the narrow band where \f$ \phi > 0 \f$.
+ *
+ * - See LSM2D_AREA_REGION_PHI_GREATER_THAN_ZERO_CUT_CELL()
+ *   for a description of the cut-cell quadrature.  Each grid point
+ *   in the fillbox receives 1/4 of the contribution of each of the
+ *   four grid cells that it is a corner of, so the result agrees with
+ *   the full-grid calculation except in grid cells that straddle the
+ *   boundary of the fillbox.
+ *
+ */
+void LSM2D_AREA_REGION_PHI_GREATER_THAN_ZERO_CUT_CELL_LOCAL(
+  LSMLIB_REAL *area,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb, 
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb, 
+  const int *jhi_phi_gb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const int *index_x,
+  const int *index_y,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const unsigned char *mark_fb);
+
+
+/*!
+ * LSM2D_PERIMETER_ZERO_LEVEL_SET_CUT_CELL_LOCAL() computes the
+ * perimeter of the zero level set using cut-cell quadrature.
+ *
+ * Arguments:
+ *  - perimeter (out):       perimeter of the zero level set
+ *  - phi (in):              level set function
+ *  - dx, dy (in):           grid spacing
+ *  - *_gb (in):             index range for ghostbox
+ *  - index_[xy](in):        [xy] coordinates of local (narrow band) points
+ *  - n*_index(in):          index range of points to loop over in index_*
+ *  - narrow_band(in):       array that marks voxels outside desired fillbox
+ *  - mark_fb(in):           upper limit narrow band value for voxels in 
+ *                           fillbox
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ * - The zero level set lies within the narrow band, so the result is
+ *   the full perimeter when the narrow band covers the zero level set.
+ *
+ * - See LSM2D_PERIMETER_ZERO_LEVEL_SET_CUT_CELL()
+ *   for a description of the cut-cell quadrature.  Each grid point
+ *   in the fillbox receives 1/4 of the contribution of each of the
+ *   four grid cells that it is a corner of, so the result agrees with
+ *   the full-grid calculation except in grid cells that straddle the
+ *   boundary of the fillbox.
+ *
+ */
+void LSM2D_PERIMETER_ZERO_LEVEL_SET_CUT_CELL_LOCAL(
+  LSMLIB_REAL *perimeter,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb, 
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb, 
+  const int *jhi_phi_gb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const int *index_x,
+  const int *index_y,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const unsigned char *mark_fb);
+
 #ifdef __cplusplus
 }
 #endif
@@ -53,6 +53,12 @@ extern "C" {
                           lsm3dsurfaceareazerolevelsetcontrolvolume_
 #define LSM3D_SURFACE_AREA_ZERO_LEVEL_SET_DELTA_CONTROL_VOLUME                     \
                           lsm3dsurfaceareazerolevelsetdeltacontrolvolume_
+#define LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO_CUT_CELL                  \
+                                      lsm3dvolumeregionphilessthanzerocutcell_
+#define LSM3D_VOLUME_REGION_PHI_GREATER_THAN_ZERO_CUT_CELL               \
+                                   lsm3dvolumeregionphigreaterthanzerocutcell_
+#define LSM3D_SURFACE_AREA_ZERO_LEVEL_SET_CUT_CELL                       \
+                                          lsm3dsurfaceareazerolevelsetcutcell_
 			  
 /*!
  * LSM3D_COMPUTE_UNIT_NORMAL() computes the unit normal vector to the
@@ -600,6 +606,158 @@ int LSM3D_findLineInTetrahedron(
   const LSMLIB_REAL *phi,
   const LSMLIB_REAL *psi);
 
+
+/*!
+ * LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO_CUT_CELL() computes the volume
+ * of the region where the level set function is less than 0 using
+ * cut-cell quadrature.
+ *
+ * Arguments:
+ *  - volume (out):          volume of the region where \f$ \phi < 0 \f$
+ *  - phi (in):              level set function
+ *  - dx, dy, dz (in):       grid spacing
+ *  - *_gb (in):             index range for ghostbox
+ *  - *_ib (in):             index range for interior box
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ * - The integral is computed over the control volumes of the grid
+ *   points in the interior box using the grid cells (i.e. the cells
+ *   whose corners are grid points) that overlap them.  Grid cells that
+ *   straddle the boundary of the interior box are clipped to the
+ *   half-cell inside of it, so phi must be available in a layer of one
+ *   ghostcell around the interior box.
+ *
+ * - Each grid cell is split into six tetrahedra within which phi is
+ *   approximated by a linear function.  The corners of the tetrahedra
+ *   are grid points (trilinear interpolation is only used for clipped
+ *   grid cells), so the approximation interpolates phi.  The result
+ *   is exact (to round-off) when phi is linear and second-order
+ *   accurate for smooth interfaces.  Grid cells that are not cut by
+ *   the zero level set do not require any tetrahedron calculations.
+ *
+ */
+void LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO_CUT_CELL(
+  LSMLIB_REAL *volume,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb, 
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb, 
+  const int *jhi_phi_gb,
+  const int *klo_phi_gb, 
+  const int *khi_phi_gb,
+  const int *ilo_ib, 
+  const int *ihi_ib,
+  const int *jlo_ib, 
+  const int *jhi_ib,
+  const int *klo_ib, 
+  const int *khi_ib,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz);
+
+
+/*!
+ * LSM3D_VOLUME_REGION_PHI_GREATER_THAN_ZERO_CUT_CELL() computes the
+ * volume of the region where the level set function is greater than 0
+ * using cut-cell quadrature.
+ *
+ * Arguments:
+ *  - volume (out):          volume of the region where \f$ \phi > 0 \f$
+ *  - phi (in):              level set function
+ *  - dx, dy, dz (in):       grid spacing
+ *  - *_gb (in):             index range for ghostbox
+ *  - *_ib (in):             index range for interior box
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ * - The integral is computed over the control volumes of the grid
+ *   points in the interior box using the grid cells (i.e. the cells
+ *   whose corners are grid points) that overlap them.  Grid cells that
+ *   straddle the boundary of the interior box are clipped to the
+ *   half-cell inside of it, so phi must be available in a layer of one
+ *   ghostcell around the interior box.
+ *
+ * - Each grid cell is split into six tetrahedra within which phi is
+ *   approximated by a linear function.  The corners of the tetrahedra
+ *   are grid points (trilinear interpolation is only used for clipped
+ *   grid cells), so the approximation interpolates phi.  The result
+ *   is exact (to round-off) when phi is linear and second-order
+ *   accurate for smooth interfaces.  Grid cells that are not cut by
+ *   the zero level set do not require any tetrahedron calculations.
+ *
+ */
+void LSM3D_VOLUME_REGION_PHI_GREATER_THAN_ZERO_CUT_CELL(
+  LSMLIB_REAL *volume,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb, 
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb, 
+  const int *jhi_phi_gb,
+  const int *klo_phi_gb, 
+  const int *khi_phi_gb,
+  const int *ilo_ib, 
+  const int *ihi_ib,
+  const int *jlo_ib, 
+  const int *jhi_ib,
+  const int *klo_ib, 
+  const int *khi_ib,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz);
+
+
+/*!
+ * LSM3D_SURFACE_AREA_ZERO_LEVEL_SET_CUT_CELL() computes the surface
+ * area of the zero level set using cut-cell quadrature.
+ *
+ * Arguments:
+ *  - area (out):            surface area of the zero level set
+ *  - phi (in):              level set function
+ *  - dx, dy, dz (in):       grid spacing
+ *  - *_gb (in):             index range for ghostbox
+ *  - *_ib (in):             index range for interior box
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ * - The integral is computed over the control volumes of the grid
+ *   points in the interior box using the grid cells (i.e. the cells
+ *   whose corners are grid points) that overlap them.  Grid cells that
+ *   straddle the boundary of the interior box are clipped to the
+ *   half-cell inside of it, so phi must be available in a layer of one
+ *   ghostcell around the interior box.
+ *
+ * - Each grid cell is split into six tetrahedra within which phi is
+ *   approximated by a linear function.  The corners of the tetrahedra
+ *   are grid points (trilinear interpolation is only used for clipped
+ *   grid cells), so the approximation interpolates phi.  The result
+ *   is exact (to round-off) when phi is linear and second-order
+ *   accurate for smooth interfaces.  Grid cells that are not cut by
+ *   the zero level set do not require any tetrahedron calculations.
+ *
+ */
+void LSM3D_SURFACE_AREA_ZERO_LEVEL_SET_CUT_CELL(
+  LSMLIB_REAL *area,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb, 
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb, 
+  const int *jhi_phi_gb,
+  const int *klo_phi_gb, 
+  const int *khi_phi_gb,
+  const int *ilo_ib, 
+  const int *ihi_ib,
+  const int *jlo_ib, 
+  const int *jhi_ib,
+  const int *klo_ib, 
+  const int *khi_ib,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,223 @@
+/*
+ * File:        lsm_geometry3d_local.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for 3D Fortran 77 narrow band level set method
+ *              geometry subroutines
+ */
+
+#ifndef INCLUDED_LSM_GEOMETRY_3D_LOCAL_H
+#define INCLUDED_LSM_GEOMETRY_3D_LOCAL_H
+
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \file lsm_geometry3d_local.h
+ *
+ * \brief
+ * @ref lsm_geometry3d_local.h provides support for computing various
+ * geometric quantities over the narrow band in three space dimensions.
+ *
+ */
+
+
+/* Link between C/C++ and Fortran function names
+ *
+ *      name in                        name in
+ *      C/C++ code                     Fortran code
+ *      ----------                     ------------
+ */
+#define LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO_CUT_CELL_LOCAL            \
+                                 lsm3dvolumeregionphilessthanzerocutcelllocal_
+#define LSM3D_VOLUME_REGION_PHI_GREATER_THAN_ZERO_CUT_CELL_LOCAL         \
+                              lsm3dvolumeregionphigreaterthanzerocutcelllocal_
+#define LSM3D_SURFACE_AREA_ZERO_LEVEL_SET_CUT_CELL_LOCAL                 \
+                                     lsm3dsurfaceareazerolevelsetcutcelllocal_
+
+
+/*!
+ * LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO_CUT_CELL_LOCAL() computes the
+ * volume of the region where the level set function is less than 0
+ * using cut-cell quadrature.
+ *
+ * Arguments:
+ *  - volume (out):          volume of the region where \f$ \phi < 0 \f$
+ *  - phi (in):              level set function
+ *  - dx, dy, dz (in):       grid spacing
+ *  - *_gb (in):             index range for ghostbox
+ *  - index_[xyz](in):       [xyz] coordinates of local (narrow band) points
+ *  - n*_index(in):          index range of points to loop over in index_*
+ *  - narrow_band(in):       array that marks voxels outside desired fillbox
+ *  - mark_fb(in):           upper limit narrow band value for voxels in 
+ *                           fillbox
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ * - Only the control volumes of the grid points in the fillbox of the
+ *   narrow band are included.  Because the region \f$ \{ \phi < 0 \} \f$
+ *   generally extends beyond the narrow band, the full volume is the sum
+ *   of this value and dx*dy*dz times the number of grid points outside of
+ *   the narrow band where \f$ \phi < 0 \f$.
+ *
+ * - See LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO_CUT_CELL()
+ *   for a description of the cut-cell quadrature.  Each grid point
+ *   in the fillbox receives 1/8 of the contribution of each of the
+ *   eight grid cells that it is a corner of, so the result agrees with
+ *   the full-grid calculation except in grid cells that straddle the
+ *   boundary of the fillbox.
+ *
+ */
+void LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO_CUT_CELL_LOCAL(
+  LSMLIB_REAL *volume,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb, 
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb, 
+  const int *jhi_phi_gb,
+  const int *klo_phi_gb, 
+  const int *khi_phi_gb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz,
+  const int *index_x,
+  const int *index_y,
+  const int *index_z,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const int *klo_nb_gb,
+  const int *khi_nb_gb,
+  const unsigned char *mark_fb);
+
+
+/*!
+ * LSM3D_VOLUME_REGION_PHI_GREATER_THAN_ZERO_CUT_CELL_LOCAL() computes
+ * the volume of the region where the level set function is greater than
+ * 0 using cut-cell quadrature.
+ *
+ * Arguments:
+ *  - volume (out):          volume of the region where \f$ \phi > 0 \f$
+ *  - phi (in):              level set function
+ *  - dx, dy, dz (in):       grid spacing
+ *  - *_gb (in):             index range for ghostbox
+ *  - index_[xyz](in):       [xyz] coordinates of local (narrow band) points
+ *  - n*_index(in):          index range of points to loop over in index_*
+ *  - narrow_band(in):       array that marks voxels outside desired fillbox
+ *  - mark_fb(in):           upper limit narrow band value for voxels in 
+ *                           fillbox
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ * - Only the control volumes of the grid points in the fillbox of the
+ *   narrow band are included.  Because the region \f$ \{ \phi > 0 \} \f$
+ *   generally extends beyond the narrow band, the full volume is the sum
+ *   of this value and dx*dy*dz times the number of grid points outside of
+ *   the narrow band where \f$ \phi > 0 \f$.
+ *
+ * - See LSM3D_VOLUME_REGION_PHI_GREATER_THAN_ZERO_CUT_CELL()
+ *   for a description of the cut-cell quadrature.  Each grid point
+ *   in the fillbox receives 1/8 of the contribution of each of the
+ *   eight grid cells that it is a corner of, so the result agrees with
+ *   the full-grid calculation except in grid cells that straddle the
+ *   boundary of the fillbox.
+ *
+ */
+void LSM3D_VOLUME_REGION_PHI_GREATER_THAN_ZERO_CUT_CELL_LOCAL(
+  LSMLIB_REAL *volume,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb, 
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb, 
+  const int *jhi_phi_gb,
+  const int *klo_phi_gb, 
+  const int *khi_phi_gb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz,
+  const int *index_x,
+  const int *index_y,
+  const int *index_z,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const int *klo_nb_gb,
+  const int *khi_nb_gb,
+  const unsigned char *mark_fb);
+
+
+/*!
+ * LSM3D_SURFACE_AREA_ZERO_LEVEL_SET_CUT_CELL_LOCAL() computes the
+ * surface area of the zero level set using cut-cell quadrature.
+ *
+ * Arguments:
+ *  - area (out):            surface area of the zero level set
+ *  - phi (in):              level set function
+ *  - dx, dy, dz (in):       grid spacing
+ *  - *_gb (in):             index range for ghostbox
+ *  - index_[xyz](in):       [xyz] coordinates of local (narrow band) points
+ *  - n*_index(in):          index range of points to loop over in index_*
+ *  - narrow_band(in):       array that marks voxels outside desired fillbox
+ *  - mark_fb(in):           upper limit narrow band value for voxels in 
+ *                           fillbox
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ * - The zero level set lies within the narrow band, so the result is
+ *   the full surface area when the narrow band covers the zero level set.
+ *
+ * - See LSM3D_SURFACE_AREA_ZERO_LEVEL_SET_CUT_CELL()
+ *   for a description of the cut-cell quadrature.  Each grid point
+ *   in the fillbox receives 1/8 of the contribution of each of the
+ *   eight grid cells that it is a corner of, so the result agrees with
+ *   the full-grid calculation except in grid cells that straddle the
+ *   boundary of the fillbox.
+ *
+ */
+void LSM3D_SURFACE_AREA_ZERO_LEVEL_SET_CUT_CELL_LOCAL(
+  LSMLIB_REAL *area,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb, 
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb, 
+  const int *jhi_phi_gb,
+  const int *klo_phi_gb, 
+  const int *khi_phi_gb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz,
+  const int *index_x,
+  const int *index_y,
+  const int *index_z,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const int *klo_nb_gb,
+  const int *khi_nb_gb,
+  const unsigned char *mark_fb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,560 @@
+/*
+ * File:        lsm_mesh3d.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation of 3D C functions for extracting meshes of
+ *              zero level sets
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include "LSMLIB_config.h"
+#include "lsm_geometry3d.h"
+#include "lsm_mesh3d.h"
+
+/* initial capacity of mesh arrays */
+#define LSM_MESH_INITIAL_SIZE     (1024)
+
+/* identifier at beginning of binary mesh files */
+#define LSM_MESH_FILE_ID          "LSMMESH"
+
+/*
+ * Decomposition of a grid cell into six tetrahedra.  Corners of the
+ * cell are numbered using the bits of the corner number to indicate
+ * the offset in the x (bit 0), y (bit 1) and z (bit 2) directions.
+ * Each tetrahedron is the path from corner 0 to corner 7 that steps
+ * along the coordinate directions in a different order, so all of the
+ * tetrahedra share the diagonal between corners 0 and 7.
+ */
+static const int LSM_MESH_TET[6][4] = {
+  {0, 1, 3, 7}, {0, 1, 5, 7}, {0, 2, 3, 7},
+  {0, 2, 6, 7}, {0, 4, 5, 7}, {0, 4, 6, 7} };
+
+
+/*================== Helper Functions Declarations ==================*/
+
+/*
+ * growMesh() ensures that mesh has space for at least the specified
+ * number of additional vertices and elements.
+ */
+static int growMesh(LSM_Mesh *mesh, int num_new_vertices,
+                    int num_new_elements);
+
+/*
+ * addTriangle() appends a triangle with vertices at the zero crossings
+ * of phi along the edges (in0,out0), (in1,out1), (in2,out2) of a
+ * tetrahedron.  The triangle is oriented so that its normal points
+ * from in0 toward out0.
+ */
+static void addTriangle(LSM_Mesh *mesh,
+  LSMLIB_REAL x[8][3], const LSMLIB_REAL *phi_c,
+  int in0, int out0, int in1, int out1, int in2, int out2);
+
+/*
+ * compareQuantizedVertices() orders vertices by their quantized
+ * coordinates (used by qsort()).
+ */
+static int compareQuantizedVertices(const void *a, const void *b);
+
+typedef struct {
+  double q[3];
+  int idx;
+} LSM_QuantizedVertex;
+
+
+/*==================== Function Definitions =========================*/
+
+LSM_Mesh *LSM_createMesh(int num_vertices_per_element)
+{
+  LSM_Mesh *mesh = (LSM_Mesh*) malloc(sizeof(LSM_Mesh));
+  if (!mesh) return NULL;
+
+  mesh->num_vertices_per_element = num_vertices_per_element;
+  mesh->num_vertices = 0;
+  mesh->max_num_vertices = 0;
+  mesh->vertices = NULL;
+  mesh->num_elements = 0;
+  mesh->max_num_elements = 0;
+  mesh->elements = NULL;
+
+  return mesh;
+}
+
+
+void LSM_destroyMesh(LSM_Mesh *mesh)
+{
+  if (mesh) {
+    free(mesh->vertices);
+    free(mesh->elements);
+    free(mesh);
+  }
+}
+
+
+int LSM_appendMesh(LSM_Mesh *mesh, const LSM_Mesh *other)
+{
+  int n = mesh->num_vertices_per_element;
+  int offset = mesh->num_vertices;
+  int *elements;
+  int i;
+
+  if (other->num_vertices_per_element != n) return -1;
+  if (growMesh(mesh, other->num_vertices, other->num_elements)) return -1;
+
+  memcpy(mesh->vertices + 3*mesh->num_vertices, other->vertices,
+         3*other->num_vertices*sizeof(LSMLIB_REAL));
+  elements = mesh->elements + n*mesh->num_elements;
+  for (i = 0; i < n*other->num_elements; i++) {
+    elements[i] = other->elements[i] + offset;
+  }
+  mesh->num_vertices += other->num_vertices;
+  mesh->num_elements += other->num_elements;
+
+  return 0;
+}
+
+
+int LSM_weldMeshVertices(LSM_Mesh *mesh, LSMLIB_REAL tolerance)
+{
+  int n = mesh->num_vertices_per_element;
+  int num_vertices = 0, num_elements = 0;
+  int *new_idx;
+  LSM_QuantizedVertex *qv;
+  int v, e, d;
+
+  if (mesh->num_vertices == 0) return 0;
+
+  qv = (LSM_QuantizedVertex*)
+    malloc(mesh->num_vertices*sizeof(LSM_QuantizedVertex));
+  new_idx = (int*) malloc(mesh->num_vertices*sizeof(int));
+  if (!qv || !new_idx) {
+    free(qv);
+    free(new_idx);
+    return -1;
+  }
+
+  /* sort vertices by quantized coordinates */
+  for (v = 0; v < mesh->num_vertices; v++) {
+    for (d = 0; d < 3; d++) {
+      qv[v].q[d] = floor(mesh->vertices[3*v+d]/tolerance + 0.5);
+    }
+    qv[v].idx = v;
+  }
+  qsort(qv, mesh->num_vertices, sizeof(LSM_QuantizedVertex),
+        compareQuantizedVertices);
+
+  /* assign new vertex indices in sorted order and compact coordinates */
+  /* (the coordinates of the first vertex of each group are kept)     */
+  for (v = 0; v < mesh->num_vertices; v++) {
+    if ( (v == 0) || compareQuantizedVertices(&qv[v-1], &qv[v]) ) {
+      num_vertices++;
+    }
+    new_idx[qv[v].idx] = num_vertices-1;
+  }
+  for (v = mesh->num_vertices-1; v >= 0; v--) {
+    qv[new_idx[v]].idx = v;
+  }
+  for (v = 0; v < num_vertices; v++) {
+    LSMLIB_REAL *x = mesh->vertices + 3*qv[v].idx;
+    qv[v].q[0] = x[0]; qv[v].q[1] = x[1]; qv[v].q[2] = x[2];
+  }
+  for (v = 0; v < num_vertices; v++) {
+    for (d = 0; d < 3; d++) mesh->vertices[3*v+d] = qv[v].q[d];
+  }
+
+  /* renumber elements and remove degenerate elements */
+  for (e = 0; e < mesh->num_elements; e++) {
+    int *elem = mesh->elements + n*e;
+    int *new_elem = mesh->elements + n*num_elements;
+    int degenerate = 0;
+    int a, b;
+    for (a = 0; a < n; a++) {
+      new_elem[a] = new_idx[elem[a]];
+      for (b = 0; b < a; b++) {
+        if (new_elem[a] == new_elem[b]) degenerate = 1;
+      }
+    }
+    if (!degenerate) num_elements++;
+  }
+
+  mesh->num_vertices = num_vertices;
+  mesh->num_elements = num_elements;
+
+  free(qv);
+  free(new_idx);
+
+  return 0;
+}
+
+
+int LSM_writeMeshToBinaryFile(const LSM_Mesh *mesh, const char *file_name)
+{
+  FILE *fp;
+  char file_id[8] = LSM_MESH_FILE_ID;
+  int header[3];
+  float x[3];
+  int v, status = 0;
+
+  fp = fopen(file_name, "wb");
+  if (!fp) return -1;
+
+  header[0] = mesh->num_vertices_per_element;
+  header[1] = mesh->num_vertices;
+  header[2] = mesh->num_elements;
+  if ( (fwrite(file_id, 1, 8, fp) != 8) ||
+       (fwrite(header, sizeof(int), 3, fp) != 3) ) {
+    status = -1;
+  }
+
+  for (v = 0; (v < mesh->num_vertices) && !status; v++) {
+    x[0] = (float) mesh->vertices[3*v];
+    x[1] = (float) mesh->vertices[3*v+1];
+    x[2] = (float) mesh->vertices[3*v+2];
+    if (fwrite(x, sizeof(float), 3, fp) != 3) status = -1;
+  }
+
+  if ( !status && (mesh->num_elements > 0) ) {
+    size_t num_entries = (size_t) header[0]*mesh->num_elements;
+    if (fwrite(mesh->elements, sizeof(int), num_entries, fp)
+        != num_entries) {
+      status = -1;
+    }
+  }
+
+  if (fclose(fp)) status = -1;
+
+  return status;
+}
+
+
+LSM_Mesh *LSM_readMeshFromBinaryFile(const char *file_name)
+{
+  FILE *fp;
+  char file_id[8];
+  int header[3];
+  float x[3];
+  LSM_Mesh *mesh = NULL;
+  int v;
+
+  fp = fopen(file_name, "rb");
+  if (!fp) return NULL;
+
+  if ( (fread(file_id, 1, 8, fp) != 8) ||
+       strncmp(file_id, LSM_MESH_FILE_ID, 8) ||
+       (fread(header, sizeof(int), 3, fp) != 3) ) {
+    fclose(fp);
+    return NULL;
+  }
+
+  mesh = LSM_createMesh(header[0]);
+  if ( !mesh || growMesh(mesh, header[1], header[2]) ) {
+    LSM_destroyMesh(mesh);
+    fclose(fp);
+    return NULL;
+  }
+
+  for (v = 0; v < header[1]; v++) {
+    if (fread(x, sizeof(float), 3, fp) != 3) break;
+    mesh->vertices[3*v] = x[0];
+    mesh->vertices[3*v+1] = x[1];
+    mesh->vertices[3*v+2] = x[2];
+  }
+  if ( (v < header[1]) ||
+       (fread(mesh->elements, sizeof(int), (size_t) header[0]*header[2], fp)
+        != (size_t) header[0]*header[2]) ) {
+    LSM_destroyMesh(mesh);
+    fclose(fp);
+    return NULL;
+  }
+  mesh->num_vertices = header[1];
+  mesh->num_elements = header[2];
+
+  fclose(fp);
+  return mesh;
+}
+
+
+/* LSM3D_extractZeroLevelSetTriangles() */
+int LSM3D_extractZeroLevelSetTriangles(
+  LSM_Mesh *mesh,
+  const LSMLIB_REAL *phi,
+  const unsigned char *mark,
+  int ilo_gb, int ihi_gb,
+  int jlo_gb, int jhi_gb,
+  int klo_gb, int khi_gb,
+  int ilo_cb, int ihi_cb,
+  int jlo_cb, int jhi_cb,
+  int klo_cb, int khi_cb,
+  const LSMLIB_REAL *x_lo,
+  LSMLIB_REAL dx,
+  LSMLIB_REAL dy,
+  LSMLIB_REAL dz)
+{
+  int nx = ihi_gb - ilo_gb + 1;
+  int nxy = nx*(jhi_gb - jlo_gb + 1);
+  int offset[8];
+  int num_triangles_start = mesh->num_elements;
+  int i, j, k, c, t;
+
+  (void) khi_gb;
+
+  for (c = 0; c < 8; c++) {
+    offset[c] = (c&1) + ((c>>1)&1)*nx + ((c>>2)&1)*nxy;
+  }
+
+  for (k = klo_cb; k <= khi_cb; k++) {
+    for (j = jlo_cb; j <= jhi_cb; j++) {
+      for (i = ilo_cb; i <= ihi_cb; i++) {
+
+        int idx = (i-ilo_gb) + (j-jlo_gb)*nx + (k-klo_gb)*nxy;
+        LSMLIB_REAL phi_c[8];
+        LSMLIB_REAL x[8][3];
+        int num_inside = 0;
+
+        if ( mark && !mark[idx] ) continue;
+
+        for (c = 0; c < 8; c++) {
+          phi_c[c] = phi[idx+offset[c]];
+          if (phi_c[c] < 0) num_inside++;
+        }
+        if ( (num_inside == 0) || (num_inside == 8) ) continue;
+
+        /* at most two triangles per tetrahedron */
+        if (growMesh(mesh, 36, 12)) return -1;
+
+        for (c = 0; c < 8; c++) {
+          x[c][0] = x_lo[0] + (i - ilo_gb + (c&1))*dx;
+          x[c][1] = x_lo[1] + (j - jlo_gb + ((c>>1)&1))*dy;
+          x[c][2] = x_lo[2] + (k - klo_gb + ((c>>2)&1))*dz;
+        }
+
+        for (t = 0; t < 6; t++) {
+          const int *tet = LSM_MESH_TET[t];
+          int in[4], out[4];
+          int n_in = 0, n_out = 0;
+          for (c = 0; c < 4; c++) {
+            if (phi_c[tet[c]] < 0) {
+              in[n_in++] = tet[c];
+            } else {
+              out[n_out++] = tet[c];
+            }
+          }
+
+          if (n_in == 1) {
+            addTriangle(mesh, x, phi_c, in[0], out[0], in[0], out[1],
+                        in[0], out[2]);
+          } else if (n_in == 3) {
+            addTriangle(mesh, x, phi_c, in[0], out[0], in[1], out[0],
+                        in[2], out[0]);
+          } else if (n_in == 2) {
+            /* quadrilateral with vertices on edges (in0,out0), */
+            /* (in0,out1), (in1,out1), (in1,out0) in cyclic order */
+            addTriangle(mesh, x, phi_c, in[0], out[0], in[0], out[1],
+                        in[1], out[1]);
+            addTriangle(mesh, x, phi_c, in[0], out[0], in[1], out[1],
+                        in[1], out[0]);
+          }
+        }
+
+      }
+    }
+  } /* end loop over grid cells */
+
+  return mesh->num_elements - num_triangles_start;
+}
+
+
+/* LSM3D_extractZeroLevelSetCurveSegments() */
+int LSM3D_extractZeroLevelSetCurveSegments(
+  LSM_Mesh *mesh,
+  const LSMLIB_REAL *phi,
+  const LSMLIB_REAL *psi,
+  const unsigned char *mark,
+  int ilo_gb, int ihi_gb,
+  int jlo_gb, int jhi_gb,
+  int klo_gb, int khi_gb,
+  int ilo_cb, int ihi_cb,
+  int jlo_cb, int jhi_cb,
+  int klo_cb, int khi_cb,
+  const LSMLIB_REAL *x_lo,
+  LSMLIB_REAL dx,
+  LSMLIB_REAL dy,
+  LSMLIB_REAL dz)
+{
+  int nx = ihi_gb - ilo_gb + 1;
+  int nxy = nx*(jhi_gb - jlo_gb + 1);
+  int offset[8];
+  int num_segments_start = mesh->num_elements;
+  int i, j, k, c, t;
+
+  (void) khi_gb;
+
+  for (c = 0; c < 8; c++) {
+    offset[c] = (c&1) + ((c>>1)&1)*nx + ((c>>2)&1)*nxy;
+  }
+
+  for (k = klo_cb; k <= khi_cb; k++) {
+    for (j = jlo_cb; j <= jhi_cb; j++) {
+      for (i = ilo_cb; i <= ihi_cb; i++) {
+
+        int idx = (i-ilo_gb) + (j-jlo_gb)*nx + (k-klo_gb)*nxy;
+        LSMLIB_REAL phi_c[8], psi_c[8];
+        LSMLIB_REAL x[8][3];
+        int num_phi_neg = 0, num_psi_neg = 0;
+
+        if ( mark && !mark[idx] ) continue;
+
+        for (c = 0; c < 8; c++) {
+          phi_c[c] = phi[idx+offset[c]];
+          psi_c[c] = psi[idx+offset[c]];
+          if (phi_c[c] < 0) num_phi_neg++;
+          if (psi_c[c] < 0) num_psi_neg++;
+        }
+        if ( (num_phi_neg == 0) || (num_phi_neg == 8) ||
+             (num_psi_neg == 0) || (num_psi_neg == 8) ) continue;
+
+        if (growMesh(mesh, 12, 6)) return -1;
+
+        for (c = 0; c < 8; c++) {
+          x[c][0] = x_lo[0] + (i - ilo_gb + (c&1))*dx;
+          x[c][1] = x_lo[1] + (j - jlo_gb + ((c>>1)&1))*dy;
+          x[c][2] = x_lo[2] + (k - klo_gb + ((c>>2)&1))*dz;
+        }
+
+        for (t = 0; t < 6; t++) {
+          const int *tet = LSM_MESH_TET[t];
+          LSMLIB_REAL phi_tet[4], psi_tet[4];
+          LSMLIB_REAL *endpt1 = mesh->vertices + 3*mesh->num_vertices;
+          LSMLIB_REAL *endpt2 = endpt1 + 3;
+          int count;
+
+          for (c = 0; c < 4; c++) {
+            phi_tet[c] = phi_c[tet[c]];
+            psi_tet[c] = psi_c[tet[c]];
+          }
+
+          count = LSM3D_findLineInTetrahedron(endpt1, endpt2,
+            x[tet[0]], x[tet[1]], x[tet[2]], x[tet[3]], phi_tet, psi_tet);
+
+          if ( (count >= 2) &&
+               ( (endpt1[0] != endpt2[0]) || (endpt1[1] != endpt2[1]) ||
+                 (endpt1[2] != endpt2[2]) ) ) {
+            int *elem = mesh->elements + 2*mesh->num_elements;
+            elem[0] = mesh->num_vertices;
+            elem[1] = mesh->num_vertices + 1;
+            mesh->num_vertices += 2;
+            mesh->num_elements++;
+          }
+        }
+
+      }
+    }
+  } /* end loop over grid cells */
+
+  return mesh->num_elements - num_segments_start;
+}
+
+
+/*==================== Helper Functions Definitions =================*/
+
+static int growMesh(LSM_Mesh *mesh, int num_new_vertices,
+                    int num_new_elements)
+{
+  int n = mesh->num_vertices_per_element;
+
+  if (mesh->num_vertices + num_new_vertices > mesh->max_num_vertices) {
+    int new_size = 2*mesh->max_num_vertices;
+    LSMLIB_REAL *vertices;
+    if (new_size < LSM_MESH_INITIAL_SIZE) new_size = LSM_MESH_INITIAL_SIZE;
+    if (new_size < mesh->num_vertices + num_new_vertices) {
+      new_size = mesh->num_vertices + num_new_vertices;
+    }
+    vertices = (LSMLIB_REAL*) realloc(mesh->vertices,
+                                      3*new_size*sizeof(LSMLIB_REAL));
+    if (!vertices) return -1;
+    mesh->vertices = vertices;
+    mesh->max_num_vertices = new_size;
+  }
+
+  if (mesh->num_elements + num_new_elements > mesh->max_num_elements) {
+    int new_size = 2*mesh->max_num_elements;
+    int *elements;
+    if (new_size < LSM_MESH_INITIAL_SIZE) new_size = LSM_MESH_INITIAL_SIZE;
+    if (new_size < mesh->num_elements + num_new_elements) {
+      new_size = mesh->num_elements + num_new_elements;
+    }
+    elements = (int*) realloc(mesh->elements, n*new_size*sizeof(int));
+    if (!elements) return -1;
+    mesh->elements = elements;
+    mesh->max_num_elements = new_size;
+  }
+
+  return 0;
+}
+
+
+static void addTriangle(LSM_Mesh *mesh,
+  LSMLIB_REAL x[8][3], const LSMLIB_REAL *phi_c,
+  int in0, int out0, int in1, int out1, int in2, int out2)
+{
+  int edge[3][2];
+  LSMLIB_REAL *v = mesh->vertices + 3*mesh->num_vertices;
+  int *elem = mesh->elements + 3*mesh->num_elements;
+  LSMLIB_REAL normal[3], dir[3];
+  int e, d;
+
+  edge[0][0] = in0; edge[0][1] = out0;
+  edge[1][0] = in1; edge[1][1] = out1;
+  edge[2][0] = in2; edge[2][1] = out2;
+
+  /* compute zero crossings.  the crossing is always computed from  */
+  /* the lower corner of the edge so that neighboring tetrahedra    */
+  /* (which share the edge) compute identical vertex coordinates.   */
+  for (e = 0; e < 3; e++) {
+    int p = edge[e][0], q = edge[e][1];
+    LSMLIB_REAL s;
+    if (p > q) { int tmp = p; p = q; q = tmp; }
+    s = phi_c[p]/(phi_c[p] - phi_c[q]);
+    for (d = 0; d < 3; d++) {
+      v[3*e+d] = x[p][d] + s*(x[q][d] - x[p][d]);
+    }
+  }
+
+  /* orient triangle so that normal points toward increasing phi */
+  normal[0] = (v[4]-v[1])*(v[8]-v[2]) - (v[5]-v[2])*(v[7]-v[1]);
+  normal[1] = (v[5]-v[2])*(v[6]-v[0]) - (v[3]-v[0])*(v[8]-v[2]);
+  normal[2] = (v[3]-v[0])*(v[7]-v[1]) - (v[4]-v[1])*(v[6]-v[0]);
+  for (d = 0; d < 3; d++) dir[d] = x[out0][d] - x[in0][d];
+
+  elem[0] = mesh->num_vertices;
+  if (normal[0]*dir[0] + normal[1]*dir[1] + normal[2]*dir[2] >= 0) {
+    elem[1] = mesh->num_vertices + 1;
+    elem[2] = mesh->num_vertices + 2;
+  } else {
+    elem[1] = mesh->num_vertices + 2;
+    elem[2] = mesh->num_vertices + 1;
+  }
+
+  mesh->num_vertices += 3;
+  mesh->num_elements++;
+}
+
+
+static int compareQuantizedVertices(const void *a, const void *b)
+{
+  const LSM_QuantizedVertex *va = (const LSM_QuantizedVertex*) a;
+  const LSM_QuantizedVertex *vb = (const LSM_QuantizedVertex*) b;
+  int d;
+
+  for (d = 0; d < 3; d++) {
+    if (va->q[d] < vb->q[d]) return -1;
+    if (va->q[d] > vb->q[d]) return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,262 @@
+/*
+ * File:        lsm_mesh3d.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for 3D C functions for extracting meshes of
+ *              zero level sets
+ */
+
+#ifndef INCLUDED_LSM_MESH_3D_H
+#define INCLUDED_LSM_MESH_3D_H
+
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \file lsm_mesh3d.h
+ *
+ * \brief
+ * @ref lsm_mesh3d.h provides support for extracting triangle meshes of
+ * the zero level set of \f$ \phi \f$ and line segment meshes of the
+ * \f$ \{ \phi=0,\psi=0 \} \f$ curve in three space dimensions and for
+ * writing these meshes to compact binary files.
+ *
+ * Each grid cell (i.e. the box with corners at eight neighboring grid
+ * points) is split into six tetrahedra that share the diagonal from the
+ * lower to the upper corner of the cell.  The same decomposition is
+ * used for all grid cells, so the triangulation is conforming across
+ * cell faces.  Within each tetrahedron, \f$ \phi \f$ and \f$ \psi \f$
+ * are approximated by linear functions (marching tetrahedra).
+ *
+ */
+
+
+/*!
+ * Structure 'LSM_Mesh' stores a mesh of triangles or line segments.
+ *
+ * NOTES:
+ * - vertices[3*v], vertices[3*v+1] and vertices[3*v+2] are the x, y and
+ *   z coordinates of vertex v.
+ *
+ * - elements[n*e], ..., elements[n*e+n-1] are the indices of the
+ *   vertices of element e, where n = num_vertices_per_element.
+ *
+ * - Triangles are oriented so that their normals (computed using the
+ *   right-hand rule) point in the direction of increasing \f$ \phi \f$.
+ *
+ */
+typedef struct _LSM_Mesh
+{
+  /* number of vertices per element (3 for triangles, 2 for segments) */
+  int num_vertices_per_element;
+
+  /* vertex coordinates */
+  int num_vertices;
+  int max_num_vertices;
+  LSMLIB_REAL *vertices;
+
+  /* element connectivity */
+  int num_elements;
+  int max_num_elements;
+  int *elements;
+
+} LSM_Mesh;
+
+
+/*!
+ * LSM_createMesh() allocates an empty LSM_Mesh.
+ *
+ * Arguments:
+ *  - num_vertices_per_element (in):  3 for a triangle mesh and 2 for a
+ *                                    line segment mesh
+ *
+ * Return value:                      pointer to new LSM_Mesh
+ *
+ */
+LSM_Mesh *LSM_createMesh(int num_vertices_per_element);
+
+
+/*!
+ * LSM_destroyMesh() frees the memory used by an LSM_Mesh.
+ *
+ * Arguments:
+ *  - mesh (in):  pointer to LSM_Mesh to destroy
+ *
+ * Return value:  none
+ *
+ */
+void LSM_destroyMesh(LSM_Mesh *mesh);
+
+
+/*!
+ * LSM_appendMesh() appends the vertices and elements of one mesh to
+ * another mesh.
+ *
+ * Arguments:
+ *  - mesh (in/out):  mesh to append to
+ *  - other (in):     mesh to append
+ *
+ * Return value:      0 on success; -1 if memory allocation fails or
+ *                    the meshes have different element types
+ *
+ */
+int LSM_appendMesh(LSM_Mesh *mesh, const LSM_Mesh *other);
+
+
+/*!
+ * LSM_weldMeshVertices() merges vertices with coincident coordinates
+ * and removes elements that become degenerate (i.e. that have repeated
+ * vertices) as a result.
+ *
+ * Arguments:
+ *  - mesh (in/out):  mesh to weld
+ *  - tolerance (in): vertices are merged if their coordinates agree
+ *                    after rounding to the nearest multiple of tolerance
+ *
+ * Return value:      0 on success; -1 if memory allocation fails
+ *
+ * NOTES:
+ *  - Vertices created from the same grid edge (or tetrahedron face)
+ *    by neighboring tetrahedra or neighboring patches differ at most
+ *    by round-off error, so a tolerance that is a small fraction of
+ *    the grid spacing (e.g. 1.e-6*dx) is appropriate.
+ *
+ *  - The cost is O(N log N) in the number of vertices.
+ *
+ */
+int LSM_weldMeshVertices(LSM_Mesh *mesh, LSMLIB_REAL tolerance);
+
+
+/*!
+ * LSM_writeMeshToBinaryFile() writes a mesh to a compact binary file.
+ *
+ * Arguments:
+ *  - mesh (in):       mesh to write
+ *  - file_name (in):  name of output file
+ *
+ * Return value:       0 on success; -1 if the file could not be written
+ *
+ * NOTES:
+ *  - The file contains (in the native byte order of the machine):
+ *    - the 8 character string "LSMMESH" (including the terminating
+ *      null character)
+ *    - num_vertices_per_element, num_vertices and num_elements
+ *      (as 32-bit integers)
+ *    - the vertex coordinates (as 32-bit floats)
+ *    - the element connectivity (as 32-bit integers)
+ *
+ */
+int LSM_writeMeshToBinaryFile(const LSM_Mesh *mesh, const char *file_name);
+
+
+/*!
+ * LSM_readMeshFromBinaryFile() reads a mesh written by
+ * LSM_writeMeshToBinaryFile().
+ *
+ * Arguments:
+ *  - file_name (in):  name of input file
+ *
+ * Return value:       pointer to new LSM_Mesh; NULL if the file could
+ *                     not be read
+ *
+ */
+LSM_Mesh *LSM_readMeshFromBinaryFile(const char *file_name);
+
+
+/*!
+ * LSM3D_extractZeroLevelSetTriangles() appends the triangles of a
+ * marching tetrahedra approximation of the zero level set of
+ * \f$ \phi \f$ in the specified box of grid cells to a triangle mesh.
+ *
+ * Arguments:
+ *  - mesh (in/out):  triangle mesh
+ *  - phi (in):       level set function
+ *  - mark (in):      grid cell with lower corner (i,j,k) is skipped if
+ *                    mark at (i,j,k) is zero (may be NULL)
+ *  - *_gb (in):      index range for ghostbox of phi and mark
+ *  - *_cb (in):      index range of lower corners of the grid cells
+ *                    to process (the upper corners must lie within
+ *                    the ghostbox)
+ *  - x_lo (in):      coordinates of the grid point (ilo_gb,jlo_gb,klo_gb)
+ *  - dx, dy, dz (in):  grid spacing
+ *
+ * Return value:      number of triangles appended; -1 if memory
+ *                    allocation fails
+ *
+ * NOTES:
+ *  - Grid points where \f$ \phi \ge 0 \f$ are treated as lying outside
+ *    of the region \f$ \{ \phi < 0 \} \f$.
+ *
+ *  - Vertices are not shared between triangles; call
+ *    LSM_weldMeshVertices() after all triangles have been extracted.
+ *
+ *  - A grid cell is skipped without further work when \f$ \phi \f$
+ *    has the same sign at all eight of its corners.
+ *
+ */
+int LSM3D_extractZeroLevelSetTriangles(
+  LSM_Mesh *mesh,
+  const LSMLIB_REAL *phi,
+  const unsigned char *mark,
+  int ilo_gb, int ihi_gb,
+  int jlo_gb, int jhi_gb,
+  int klo_gb, int khi_gb,
+  int ilo_cb, int ihi_cb,
+  int jlo_cb, int jhi_cb,
+  int klo_cb, int khi_cb,
+  const LSMLIB_REAL *x_lo,
+  LSMLIB_REAL dx,
+  LSMLIB_REAL dy,
+  LSMLIB_REAL dz);
+
+
+/*!
+ * LSM3D_extractZeroLevelSetCurveSegments() appends the line segments of
+ * the \f$ \{ \phi=0,\psi=0 \} \f$ curve in the specified box of grid
+ * cells to a line segment mesh.  Segments are computed for each
+ * tetrahedron using LSM3D_findLineInTetrahedron().
+ *
+ * Arguments:
+ *  - mesh (in/out):  line segment mesh
+ *  - phi (in):       level set function
+ *  - psi (in):       level set function
+ *  - mark, *_gb, *_cb, x_lo, dx, dy, dz (in):  see
+ *                    LSM3D_extractZeroLevelSetTriangles()
+ *
+ * Return value:      number of line segments appended; -1 if memory
+ *                    allocation fails
+ *
+ * NOTES:
+ *  - Each segment is oriented in the direction of
+ *    \f$ \nabla \phi \times \nabla \psi \f$.
+ *
+ *  - Vertices are not shared between segments; call
+ *    LSM_weldMeshVertices() after all segments have been extracted.
+ *
+ */
+int LSM3D_extractZeroLevelSetCurveSegments(
+  LSM_Mesh *mesh,
+  const LSMLIB_REAL *phi,
+  const LSMLIB_REAL *psi,
+  const unsigned char *mark,
+  int ilo_gb, int ihi_gb,
+  int jlo_gb, int jhi_gb,
+  int klo_gb, int khi_gb,
+  int ilo_cb, int ihi_cb,
+  int jlo_cb, int jhi_cb,
+  int klo_cb, int khi_cb,
+  const LSMLIB_REAL *x_lo,
+  LSMLIB_REAL dx,
+  LSMLIB_REAL dy,
+  LSMLIB_REAL dz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -47,6 +47,10 @@ extern "C" {
                                        lsm3daddconstprecomputedcurvtermtolserhslocal_					
 #define LSM3D_ADD_EXTERNAL_AND_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL	\
                                   lsm3daddexternalandnormalveltermtolserhslocal_						
+#define LSM3D_ADD_HAMILTONIAN_TERM_TO_LSE_RHS_LF_LOCAL                        \
+                                       lsm3daddhamiltoniantermtolserhslflocal_
+#define LSM3D_ADD_HAMILTONIAN_TERM_TO_LSE_RHS_LLF_LOCAL                       \
+                                      lsm3daddhamiltoniantermtolserhsllflocal_
 
 
 /*!
@@ -495,6 +499,246 @@ void LSM3D_ADD_EXTERNAL_AND_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL(
   const int *klo_nb_gb,
   const int *khi_nb_gb,
   const unsigned char *mark_fb);
+
+
+/*!
+ * LSM3D_ADD_HAMILTONIAN_TERM_TO_LSE_RHS_LF_LOCAL() adds the contribution
+ * of a general (possibly non-convex) Hamiltonian to the right-hand
+ * side of the level set equation when it is written in the form:
+ *
+ * \f[
+ *
+ *    \phi_t = -H(\nabla \phi) + ...
+ *
+ * \f]
+ *
+ * using the Lax-Friedrichs numerical Hamiltonian
+ *
+ * \f[
+ *
+ *    \hat{H} = H\left( \frac{p^+ + p^-}{2}, \frac{q^+ + q^-}{2},
+ *                        \frac{r^+ + r^-}{2} \right)
+ *             - \alpha_x \frac{p^+ - p^-}{2}
+ *             - \alpha_y \frac{q^+ - q^-}{2}
+ *             - \alpha_z \frac{r^+ - r^-}{2}
+ *
+ * \f]
+ *
+ * where \f$ p^\pm \f$, \f$ q^\pm \f$, \f$ r^\pm \f$ are the forward and
+ * backward approximations to the components of \f$ \nabla \phi \f$.
+ * The dissipation coefficients \f$ \alpha_* \f$ are the maxima of
+ * |alpha_*| over all grid points in the narrow band.
+ *
+ * Arguments:
+ *  - lse_rhs (in/out):  right-hand of level set equation
+ *  - phi_*_plus (in):   components of forward approx to \f$ \nabla \phi \f$
+ *                       at t = t_cur
+ *  - phi_*_minus (in):  components of backward approx to \f$ \nabla \phi \f$
+ *                       at t = t_cur
+ *  - H (in):            Hamiltonian evaluated at the average of the
+ *                       forward and backward approximations to
+ *                       \f$ \nabla \phi \f$ at t = t_cur
+ *  - alpha_* (in):      bounds on the partial derivatives of H with
+ *                       respect to the components of \f$ \nabla \phi \f$
+ *  - *_gb (in):         index range for ghostbox
+ *  - index_[xyz](in):  [xyz] coordinates of local (narrow band) points
+ *  - n*_index(in):     index range of points in index_*
+ *  - narrow_band(in):  array that marks voxels outside desired fillbox
+ *  - mark_fb(in):      upper limit narrow band value for voxels in 
+ *                      fillbox
+ *
+ * Return value:         none
+ *
+ * NOTES:
+ *  - Unlike Godunov's method used by
+ *    LSM3D_ADD_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL(), the
+ *    Lax-Friedrichs scheme does not require H to be convex.  It is
+ *    monotone as long as alpha_* bound |dH/dphi_*| over the range
+ *    of gradients that occur on the grid and the time step satisfies
+ *    the CFL condition computed by LSM3D_COMPUTE_STABLE_LF_DT_LOCAL().
+ *
+ *  - Because the maxima over all grid points are used, the scheme is
+ *    more dissipative than the local Lax-Friedrichs scheme
+ *    (LSM3D_ADD_HAMILTONIAN_TERM_TO_LSE_RHS_LLF_LOCAL()).
+ *
+ */
+void LSM3D_ADD_HAMILTONIAN_TERM_TO_LSE_RHS_LF_LOCAL(
+  LSMLIB_REAL *lse_rhs,
+  const int *ilo_lse_rhs_gb, 
+  const int *ihi_lse_rhs_gb,
+  const int *jlo_lse_rhs_gb, 
+  const int *jhi_lse_rhs_gb,
+  const int *klo_lse_rhs_gb, 
+  const int *khi_lse_rhs_gb,
+  const LSMLIB_REAL *phi_x_plus,
+  const LSMLIB_REAL *phi_y_plus,
+  const LSMLIB_REAL *phi_z_plus,
+  const int *ilo_grad_phi_plus_gb, 
+  const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb, 
+  const int *jhi_grad_phi_plus_gb,
+  const int *klo_grad_phi_plus_gb, 
+  const int *khi_grad_phi_plus_gb,
+  const LSMLIB_REAL *phi_x_minus,
+  const LSMLIB_REAL *phi_y_minus,
+  const LSMLIB_REAL *phi_z_minus,
+  const int *ilo_grad_phi_minus_gb, 
+  const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb, 
+  const int *jhi_grad_phi_minus_gb,
+  const int *klo_grad_phi_minus_gb, 
+  const int *khi_grad_phi_minus_gb,
+  const LSMLIB_REAL *H,
+  const int *ilo_H_gb, 
+  const int *ihi_H_gb,
+  const int *jlo_H_gb, 
+  const int *jhi_H_gb,
+  const int *klo_H_gb, 
+  const int *khi_H_gb,
+  const LSMLIB_REAL *alpha_x,
+  const LSMLIB_REAL *alpha_y,
+  const LSMLIB_REAL *alpha_z,
+  const int *ilo_alpha_gb, 
+  const int *ihi_alpha_gb,
+  const int *jlo_alpha_gb, 
+  const int *jhi_alpha_gb,
+  const int *klo_alpha_gb, 
+  const int *khi_alpha_gb,
+  const int *index_x,
+  const int *index_y,
+  const int *index_z,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const int *klo_nb_gb,
+  const int *khi_nb_gb,
+  const unsigned char *mark_fb);
+
+
+/*!
+ * LSM3D_ADD_HAMILTONIAN_TERM_TO_LSE_RHS_LLF_LOCAL() adds the contribution
+ * of a general (possibly non-convex) Hamiltonian to the right-hand
+ * side of the level set equation when it is written in the form:
+ *
+ * \f[
+ *
+ *    \phi_t = -H(\nabla \phi) + ...
+ *
+ * \f]
+ *
+ * using the local Lax-Friedrichs numerical Hamiltonian
+ *
+ * \f[
+ *
+ *    \hat{H} = H\left( \frac{p^+ + p^-}{2}, \frac{q^+ + q^-}{2},
+ *                        \frac{r^+ + r^-}{2} \right)
+ *             - \alpha_x \frac{p^+ - p^-}{2}
+ *             - \alpha_y \frac{q^+ - q^-}{2}
+ *             - \alpha_z \frac{r^+ - r^-}{2}
+ *
+ * \f]
+ *
+ * where \f$ p^\pm \f$, \f$ q^\pm \f$, \f$ r^\pm \f$ are the forward and
+ * backward approximations to the components of \f$ \nabla \phi \f$.
+ * The dissipation coefficients \f$ \alpha_* \f$ are taken from
+ * alpha_* at each grid point.
+ *
+ * Arguments:
+ *  - lse_rhs (in/out):  right-hand of level set equation
+ *  - phi_*_plus (in):   components of forward approx to \f$ \nabla \phi \f$
+ *                       at t = t_cur
+ *  - phi_*_minus (in):  components of backward approx to \f$ \nabla \phi \f$
+ *                       at t = t_cur
+ *  - H (in):            Hamiltonian evaluated at the average of the
+ *                       forward and backward approximations to
+ *                       \f$ \nabla \phi \f$ at t = t_cur
+ *  - alpha_* (in):      bounds on the partial derivatives of H with
+ *                       respect to the components of \f$ \nabla \phi \f$
+ *  - *_gb (in):         index range for ghostbox
+ *  - index_[xyz](in):  [xyz] coordinates of local (narrow band) points
+ *  - n*_index(in):     index range of points in index_*
+ *  - narrow_band(in):  array that marks voxels outside desired fillbox
+ *  - mark_fb(in):      upper limit narrow band value for voxels in 
+ *                      fillbox
+ *
+ * Return value:         none
+ *
+ * NOTES:
+ *  - Unlike Godunov's method used by
+ *    LSM3D_ADD_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL(), the local
+ *    Lax-Friedrichs scheme does not require H to be convex.  It is
+ *    monotone as long as alpha_* at each grid point bounds
+ *    |dH/dphi_*| for the component of the gradient ranging between
+ *    phi_*_minus and phi_*_plus (and the other components ranging
+ *    over their values in a neighborhood of the grid point) and the
+ *    time step satisfies the CFL condition computed by
+ *    LSM3D_COMPUTE_STABLE_LLF_DT_LOCAL().
+ *
+ *  - The local Lax-Friedrichs scheme is less dissipative than the
+ *    Lax-Friedrichs scheme, which uses the same dissipation
+ *    coefficients at all grid points.
+ *
+ */
+void LSM3D_ADD_HAMILTONIAN_TERM_TO_LSE_RHS_LLF_LOCAL(
+  LSMLIB_REAL *lse_rhs,
+  const int *ilo_lse_rhs_gb, 
+  const int *ihi_lse_rhs_gb,
+  const int *jlo_lse_rhs_gb, 
+  const int *jhi_lse_rhs_gb,
+  const int *klo_lse_rhs_gb, 
+  const int *khi_lse_rhs_gb,
+  const LSMLIB_REAL *phi_x_plus,
+  const LSMLIB_REAL *phi_y_plus,
+  const LSMLIB_REAL *phi_z_plus,
+  const int *ilo_grad_phi_plus_gb, 
+  const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb, 
+  const int *jhi_grad_phi_plus_gb,
+  const int *klo_grad_phi_plus_gb, 
+  const int *khi_grad_phi_plus_gb,
+  const LSMLIB_REAL *phi_x_minus,
+  const LSMLIB_REAL *phi_y_minus,
+  const LSMLIB_REAL *phi_z_minus,
+  const int *ilo_grad_phi_minus_gb, 
+  const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb, 
+  const int *jhi_grad_phi_minus_gb,
+  const int *klo_grad_phi_minus_gb, 
+  const int *khi_grad_phi_minus_gb,
+  const LSMLIB_REAL *H,
+  const int *ilo_H_gb, 
+  const int *ihi_H_gb,
+  const int *jlo_H_gb, 
+  const int *jhi_H_gb,
+  const int *klo_H_gb, 
+  const int *khi_H_gb,
+  const LSMLIB_REAL *alpha_x,
+  const LSMLIB_REAL *alpha_y,
+  const LSMLIB_REAL *alpha_z,
+  const int *ilo_alpha_gb, 
+  const int *ihi_alpha_gb,
+  const int *jlo_alpha_gb, 
+  const int *jhi_alpha_gb,
+  const int *klo_alpha_gb, 
+  const int *khi_alpha_gb,
+  const int *index_x,
+  const int *index_y,
+  const int *index_z,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const int *klo_nb_gb,
+  const int *khi_nb_gb,
+  const unsigned char *mark_fb);
+
   
 #ifdef __cplusplus
 }
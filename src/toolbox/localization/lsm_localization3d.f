@@ -152,13 +152,10 @@ c         check lower z-coordinate neighbor
         enddo
 c       } end examine points one level less
 	
-	if( count .gt. ( n_hi(l-1) + 1 ) ) then 
-	  n_lo(l) = n_hi(l-1) + 1
-	  n_hi(l) = count - 1
-	else
-	  n_lo(l) = -1
-	  n_hi(l) = -1
-	endif
+c       an empty level is stored as an empty index range
+c       (n_hi(l) = n_lo(l)-1) so that loops over it do nothing
+	n_lo(l) = n_hi(l-1) + 1
+	n_hi(l) = count - 1
 	
       enddo
 c     } end loop over all levels  
@@ -41,6 +41,8 @@ extern "C" {
                                        lsm3dcomputedistanceforsubcellfix_	
 #define LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS_SUBCELL_FIX_ORDER1           \
                       lsm3dcomputereinitializationeqnrhssubcellfixorder1_
+#define LSM3D_COMPUTE_DISTANCE_FOR_SUBCELL_FIX_CUBIC                        \
+                                  lsm3dcomputedistanceforsubcellfixcubic_
 
 /*!
  * LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS() computes the right-hand side 
@@ -343,6 +345,62 @@ void LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS_SUBCELL_FIX_ORDER1(
   const LSMLIB_REAL *dy,
   const LSMLIB_REAL *dz);
 
+/*!
+*  LSM3D_COMPUTE_DISTANCE_FOR_SUBCELL_FIX_CUBIC is a higher-accuracy 
+*  replacement for LSM3D_COMPUTE_DISTANCE_FOR_SUBCELL_FIX.  For each 
+*  gridpoint adjacent to the interface, the distance is computed by 
+*  projecting the gridpoint onto the zero level set of the local 
+*  tricubic interpolant of phi0 using Newton's method (Chopp, 
+*  "Some Improvements of the Fast Marching Method", SIAM J Sci Comput, 
+*  2001).  When the projection fails to converge, the Russo/Smereka 
+*  estimate is used and the failure is counted in 
+*  num_projection_failures.
+*
+*  The output may be passed directly to 
+*  LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS_SUBCELL_FIX_ORDER1.  It is also
+*  used by the serial Fast Marching Method to initialize the front
+*  when the third-order spatial discretization is requested.
+*
+*  Arguments
+*    distance0(out):         distance computed for phi0 (in units of 
+*                            max(dx,dy,dz))
+*    num_projection_failures (out):
+*                            number of gridpoints where the projection
+*                            failed
+*    phi0 (in):              level set function at initial iteration
+*                            iteration of reinitialization process
+*    *_gb (in):              index range for ghostbox
+*    *_fb (in):              index range for fillbox
+*    d* (in):                grid spacing
+*
+*  NOTES:
+*   - Distance of gridpoints away from the interface is set to a large
+*     negative number (-1000*max(dx,dy,dz)).
+*   - The interpolant uses values of phi0 up to two grid cells away 
+*     from the fillbox.  Near the boundary of the ghostbox, the 
+*     interpolation stencil is shifted inward, so the fillbox may be 
+*     the entire ghostbox.
+*/
+void LSM3D_COMPUTE_DISTANCE_FOR_SUBCELL_FIX_CUBIC(
+  LSMLIB_REAL* distance0, 
+  int *num_projection_failures,
+  const LSMLIB_REAL* phi0,
+  const int *ilo_phi0_gb, 
+  const int *ihi_phi0_gb, 
+  const int *jlo_phi0_gb, 
+  const int *jhi_phi0_gb,
+  const int *klo_phi0_gb, 
+  const int *khi_phi0_gb,
+  const int *ilo_fb,   
+  const int *ihi_fb,
+  const int *jlo_fb,   
+  const int *jhi_fb,
+  const int *klo_fb,   
+  const int *khi_fb,
+  const LSMLIB_REAL *dx, 
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz);
+
 #ifdef __cplusplus
 }
 #endif
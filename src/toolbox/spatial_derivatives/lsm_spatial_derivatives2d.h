@@ -37,6 +37,10 @@ extern "C" {
 #define LSM2D_HJ_ENO2                lsm2dhjeno2_
 #define LSM2D_HJ_ENO3                lsm2dhjeno3_
 #define LSM2D_HJ_WENO5               lsm2dhjweno5_
+#define LSM2D_HJ_ENO1_BDRY           lsm2dhjeno1bdry_
+#define LSM2D_HJ_ENO2_BDRY           lsm2dhjeno2bdry_
+#define LSM2D_HJ_ENO3_BDRY           lsm2dhjeno3bdry_
+#define LSM2D_HJ_WENO5_BDRY          lsm2dhjweno5bdry_
 #define LSM2D_UPWIND_HJ_ENO1         lsm2dupwindhjeno1_
 #define LSM2D_UPWIND_HJ_ENO2         lsm2dupwindhjeno2_
 #define LSM2D_UPWIND_HJ_ENO3         lsm2dupwindhjeno3_
@@ -314,6 +318,253 @@ void LSM2D_HJ_WENO5(
   const LSMLIB_REAL *dy);
 
 
+/*!
+ * LSM2D_HJ_ENO1_BDRY() is identical to LSM2D_HJ_ENO1() except that
+ * boundary conditions are imposed on the undivided differences of
+ * \f$ \phi \f$ at the boundaries of the fillbox.  At boundaries where
+ * a boundary condition is specified, the ghostcells of \f$ \phi \f$ do
+ * not need to be filled before calling LSM2D_HJ_ENO1_BDRY().
+ *
+ * Arguments:
+ *  - bdry_types (in):    boundary condition at each boundary of the
+ *                        fillbox (ordered x_lo, x_hi, y_lo, y_hi):
+ *                        0 = use ghostcell values stored in phi,
+ *                        1 = homogeneous Neumann (copy extrapolation),
+ *                        2 = linear extrapolation,
+ *                        3 = signed linear extrapolation
+ *  - all other arguments are the same as for LSM2D_HJ_ENO1()
+ *
+ * Return value:          none
+ *
+ * NOTES:
+ *  - ghostcell values are extrapolated from the grid cells in the
+ *    fillbox, so the results agree (up to round-off) with LSM2D_HJ_ENO1()
+ *    applied after filling the ghostcells of \f$ \phi \f$ using the
+ *    corresponding boundary condition in lsm_boundary_conditions2d.h
+ *    with the same fillbox.
+ *
+ */
+void LSM2D_HJ_ENO1_BDRY(
+  LSMLIB_REAL *phi_x_plus,
+  LSMLIB_REAL *phi_y_plus,
+  const int *ilo_grad_phi_plus_gb,
+  const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb,
+  const int *jhi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus,
+  LSMLIB_REAL *phi_y_minus,
+  const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  LSMLIB_REAL *D1,
+  const int *ilo_D1_gb,
+  const int *ihi_D1_gb,
+  const int *jlo_D1_gb,
+  const int *jhi_D1_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const int *bdry_types,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy);
+
+
+/*!
+ * LSM2D_HJ_ENO2_BDRY() is identical to LSM2D_HJ_ENO2() except that
+ * boundary conditions are imposed on the undivided differences of
+ * \f$ \phi \f$ at the boundaries of the fillbox.  At boundaries where
+ * a boundary condition is specified, the ghostcells of \f$ \phi \f$ do
+ * not need to be filled before calling LSM2D_HJ_ENO2_BDRY().
+ *
+ * Arguments:
+ *  - bdry_types (in):    boundary condition at each boundary of the
+ *                        fillbox (ordered x_lo, x_hi, y_lo, y_hi):
+ *                        0 = use ghostcell values stored in phi,
+ *                        1 = homogeneous Neumann (copy extrapolation),
+ *                        2 = linear extrapolation,
+ *                        3 = signed linear extrapolation
+ *  - all other arguments are the same as for LSM2D_HJ_ENO2()
+ *
+ * Return value:          none
+ *
+ * NOTES:
+ *  - ghostcell values are extrapolated from the grid cells in the
+ *    fillbox, so the results agree (up to round-off) with LSM2D_HJ_ENO2()
+ *    applied after filling the ghostcells of \f$ \phi \f$ using the
+ *    corresponding boundary condition in lsm_boundary_conditions2d.h
+ *    with the same fillbox.
+ *
+ */
+void LSM2D_HJ_ENO2_BDRY(
+  LSMLIB_REAL *phi_x_plus,
+  LSMLIB_REAL *phi_y_plus,
+  const int *ilo_grad_phi_plus_gb,
+  const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb,
+  const int *jhi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus,
+  LSMLIB_REAL *phi_y_minus,
+  const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  LSMLIB_REAL *D1,
+  const int *ilo_D1_gb,
+  const int *ihi_D1_gb,
+  const int *jlo_D1_gb,
+  const int *jhi_D1_gb,
+  LSMLIB_REAL *D2,
+  const int *ilo_D2_gb,
+  const int *ihi_D2_gb,
+  const int *jlo_D2_gb,
+  const int *jhi_D2_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const int *bdry_types,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy);
+
+
+/*!
+ * LSM2D_HJ_ENO3_BDRY() is identical to LSM2D_HJ_ENO3() except that
+ * boundary conditions are imposed on the undivided differences of
+ * \f$ \phi \f$ at the boundaries of the fillbox.  At boundaries where
+ * a boundary condition is specified, the ghostcells of \f$ \phi \f$ do
+ * not need to be filled before calling LSM2D_HJ_ENO3_BDRY().
+ *
+ * Arguments:
+ *  - bdry_types (in):    boundary condition at each boundary of the
+ *                        fillbox (ordered x_lo, x_hi, y_lo, y_hi):
+ *                        0 = use ghostcell values stored in phi,
+ *                        1 = homogeneous Neumann (copy extrapolation),
+ *                        2 = linear extrapolation,
+ *                        3 = signed linear extrapolation
+ *  - all other arguments are the same as for LSM2D_HJ_ENO3()
+ *
+ * Return value:          none
+ *
+ * NOTES:
+ *  - ghostcell values are extrapolated from the grid cells in the
+ *    fillbox, so the results agree (up to round-off) with LSM2D_HJ_ENO3()
+ *    applied after filling the ghostcells of \f$ \phi \f$ using the
+ *    corresponding boundary condition in lsm_boundary_conditions2d.h
+ *    with the same fillbox.
+ *
+ */
+void LSM2D_HJ_ENO3_BDRY(
+  LSMLIB_REAL *phi_x_plus,
+  LSMLIB_REAL *phi_y_plus,
+  const int *ilo_grad_phi_plus_gb,
+  const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb,
+  const int *jhi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus,
+  LSMLIB_REAL *phi_y_minus,
+  const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  LSMLIB_REAL *D1,
+  const int *ilo_D1_gb,
+  const int *ihi_D1_gb,
+  const int *jlo_D1_gb,
+  const int *jhi_D1_gb,
+  LSMLIB_REAL *D2,
+  const int *ilo_D2_gb,
+  const int *ihi_D2_gb,
+  const int *jlo_D2_gb,
+  const int *jhi_D2_gb,
+  LSMLIB_REAL *D3,
+  const int *ilo_D3_gb,
+  const int *ihi_D3_gb,
+  const int *jlo_D3_gb,
+  const int *jhi_D3_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const int *bdry_types,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy);
+
+
+/*!
+ * LSM2D_HJ_WENO5_BDRY() is identical to LSM2D_HJ_WENO5() except that
+ * boundary conditions are imposed on the undivided differences of
+ * \f$ \phi \f$ at the boundaries of the fillbox.  At boundaries where
+ * a boundary condition is specified, the ghostcells of \f$ \phi \f$ do
+ * not need to be filled before calling LSM2D_HJ_WENO5_BDRY().
+ *
+ * Arguments:
+ *  - bdry_types (in):    boundary condition at each boundary of the
+ *                        fillbox (ordered x_lo, x_hi, y_lo, y_hi):
+ *                        0 = use ghostcell values stored in phi,
+ *                        1 = homogeneous Neumann (copy extrapolation),
+ *                        2 = linear extrapolation,
+ *                        3 = signed linear extrapolation
+ *  - all other arguments are the same as for LSM2D_HJ_WENO5()
+ *
+ * Return value:          none
+ *
+ * NOTES:
+ *  - ghostcell values are extrapolated from the grid cells in the
+ *    fillbox, so the results agree (up to round-off) with LSM2D_HJ_WENO5()
+ *    applied after filling the ghostcells of \f$ \phi \f$ using the
+ *    corresponding boundary condition in lsm_boundary_conditions2d.h
+ *    with the same fillbox.
+ *
+ */
+void LSM2D_HJ_WENO5_BDRY(
+  LSMLIB_REAL *phi_x_plus,
+  LSMLIB_REAL *phi_y_plus,
+  const int *ilo_grad_phi_plus_gb,
+  const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb,
+  const int *jhi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus,
+  LSMLIB_REAL *phi_y_minus,
+  const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  LSMLIB_REAL *D1,
+  const int *ilo_D1_gb,
+  const int *ihi_D1_gb,
+  const int *jlo_D1_gb,
+  const int *jhi_D1_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const int *bdry_types,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy);
+
+
 /*! 
  * LSM2D_UPWIND_HJ_ENO1() computes the first-order Hamilton-Jacobi ENO
  * upwind approximation to the gradient of \f$ \phi \f$.
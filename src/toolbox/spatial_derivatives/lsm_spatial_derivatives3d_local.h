@@ -36,6 +36,9 @@ extern "C" {
 #define LSM3D_HJ_ENO1_LOCAL              lsm3dhjeno1local_
 #define LSM3D_HJ_ENO2_LOCAL              lsm3dhjeno2local_
 
+#define LSM3D_HJ_ENO1_CODIM2_LOCAL       lsm3dhjeno1codim2local_
+#define LSM3D_HJ_ENO2_CODIM2_LOCAL       lsm3dhjeno2codim2local_
+
 #define LSM3D_CENTRAL_GRAD_ORDER2_LOCAL  lsm3dcentralgradorder2local_
 #define LSM3D_CENTRAL_GRAD_ORDER4_LOCAL  lsm3dcentralgradorder4local_
 
@@ -219,6 +222,152 @@ void LSM3D_HJ_ENO2_LOCAL(
   const unsigned char *mark_D1,
   const unsigned char *mark_D2);
 
+/*!
+*
+*  LSM3D_HJ_ENO1_CODIM2_LOCAL() computes the forward (plus) and backward 
+*  (minus) first-order Hamilton-Jacobi ENO approximations to the 
+*  gradients of both level set functions (phi and psi) of a 
+*  codimension-two problem in a single pass over the narrow band.
+*  The routine loops only over local (narrow band) points.
+*
+*  Arguments:
+*    phi_*_plus (out):   components of grad(phi) in plus direction 
+*    phi_*_minus (out):  components of grad(phi) in minus direction
+*    psi_*_plus (out):   components of grad(psi) in plus direction 
+*    psi_*_minus (out):  components of grad(psi) in minus direction
+*    phi (in):           phi
+*    psi (in):           psi
+*    dx, dy, dz (in):    grid spacing
+*    *_gb (in):          index range for ghostbox
+*    index_*(in):        coordinates of local (narrow band) points
+*    n*_index(in):       index range of points to loop over in index_*
+*    narrow_band(in):    array that marks voxels outside desired fillbox
+*    mark_fb(in):        upper limit narrow band value for voxels in 
+*                        fillbox
+*
+*  NOTES:
+*   - phi and psi must have valid data in level 1 of the narrow band
+*   - the plus and minus derivatives of phi and psi are assumed to
+*     have the same ghostbox
+*/
+void LSM3D_HJ_ENO1_CODIM2_LOCAL(
+  LSMLIB_REAL *phi_x_plus,
+  LSMLIB_REAL *phi_y_plus,
+  LSMLIB_REAL *phi_z_plus,
+  LSMLIB_REAL *phi_x_minus,
+  LSMLIB_REAL *phi_y_minus,
+  LSMLIB_REAL *phi_z_minus,
+  LSMLIB_REAL *psi_x_plus,
+  LSMLIB_REAL *psi_y_plus,
+  LSMLIB_REAL *psi_z_plus,
+  LSMLIB_REAL *psi_x_minus,
+  LSMLIB_REAL *psi_y_minus,
+  LSMLIB_REAL *psi_z_minus,
+  const int *ilo_grad_gb,
+  const int *ihi_grad_gb,
+  const int *jlo_grad_gb,
+  const int *jhi_grad_gb,
+  const int *klo_grad_gb,
+  const int *khi_grad_gb,
+  const LSMLIB_REAL *phi,
+  const LSMLIB_REAL *psi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const int *klo_phi_gb,
+  const int *khi_phi_gb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz,
+  const int *index_x,
+  const int *index_y, 
+  const int *index_z,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const int *klo_nb_gb,
+  const int *khi_nb_gb,
+  const unsigned char *mark_fb);
+
+/*!
+*
+*  LSM3D_HJ_ENO2_CODIM2_LOCAL() computes the forward (plus) and backward 
+*  (minus) second-order Hamilton-Jacobi ENO approximations to the 
+*  gradients of both level set functions (phi and psi) of a 
+*  codimension-two problem in a single pass over the narrow band.
+*  The undivided differences are computed on the fly, so no scratch 
+*  space is required.
+*  The routine loops only over local (narrow band) points.
+*
+*  Arguments:
+*    phi_*_plus (out):   components of grad(phi) in plus direction 
+*    phi_*_minus (out):  components of grad(phi) in minus direction
+*    psi_*_plus (out):   components of grad(psi) in plus direction 
+*    psi_*_minus (out):  components of grad(psi) in minus direction
+*    phi (in):           phi
+*    psi (in):           psi
+*    dx, dy, dz (in):    grid spacing
+*    *_gb (in):          index range for ghostbox
+*    index_*(in):        coordinates of local (narrow band) points
+*    n*_index(in):       index range of points to loop over in index_*
+*    narrow_band(in):    array that marks voxels outside desired fillbox
+*    mark_fb(in):        upper limit narrow band value for voxels in 
+*                        fillbox
+*
+*  NOTES:
+*   - phi and psi must have valid data in levels 1 and 2 of the narrow band
+*   - the plus and minus derivatives of phi and psi are assumed to
+*     have the same ghostbox
+*/
+void LSM3D_HJ_ENO2_CODIM2_LOCAL(
+  LSMLIB_REAL *phi_x_plus,
+  LSMLIB_REAL *phi_y_plus,
+  LSMLIB_REAL *phi_z_plus,
+  LSMLIB_REAL *phi_x_minus,
+  LSMLIB_REAL *phi_y_minus,
+  LSMLIB_REAL *phi_z_minus,
+  LSMLIB_REAL *psi_x_plus,
+  LSMLIB_REAL *psi_y_plus,
+  LSMLIB_REAL *psi_z_plus,
+  LSMLIB_REAL *psi_x_minus,
+  LSMLIB_REAL *psi_y_minus,
+  LSMLIB_REAL *psi_z_minus,
+  const int *ilo_grad_gb,
+  const int *ihi_grad_gb,
+  const int *jlo_grad_gb,
+  const int *jhi_grad_gb,
+  const int *klo_grad_gb,
+  const int *khi_grad_gb,
+  const LSMLIB_REAL *phi,
+  const LSMLIB_REAL *psi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const int *klo_phi_gb,
+  const int *khi_phi_gb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz,
+  const int *index_x,
+  const int *index_y, 
+  const int *index_z,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const int *klo_nb_gb,
+  const int *khi_nb_gb,
+  const unsigned char *mark_fb);
+
 /*!
 *
 *  LSM3D_CENTRAL_GRAD_ORDER2_LOCAL() computes the second-order central 
@@ -0,0 +1,283 @@
+/*
+ * File:        lsm_instrumentation.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for LSMLIB kernel instrumentation
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "lsm_instrumentation.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#include <sys/time.h>
+#endif
+
+
+/*============================= Constants ===========================*/
+
+#define LSM_INSTRUMENTATION_MAX_FILE_NAME_LENGTH   (1024)
+
+static const char *s_kernel_family_names[
+  LSM_INSTRUMENTATION_NUM_KERNEL_FAMILIES] = {
+  "spatial_derivatives",
+  "rhs",
+  "tvd_rk_stage",
+  "reinitialization",
+  "fast_marching_method",
+  "narrow_band_rebuild",
+  "ghost_fill",
+  "reduction"
+};
+
+
+/*========================= Static Variables ========================*/
+
+static LSM_InstrumentationRecord
+  s_records[LSM_INSTRUMENTATION_NUM_KERNEL_FAMILIES];
+
+/* output file name (empty string if output at exit is disabled) */
+static char s_output_file_name[LSM_INSTRUMENTATION_MAX_FILE_NAME_LENGTH];
+
+/* flags for lazy initialization of output at exit */
+static int s_output_file_initialized = 0;
+static int s_atexit_registered = 0;
+
+
+/*================== Helper Functions Declarations ==================*/
+
+/*
+ * LSM_Instrumentation_initializeOutputFile() reads the output file name
+ * from the LSMLIB_INSTRUMENTATION_FILE environment variable and registers
+ * the function that writes the instrumentation data at exit.  It is
+ * called when the first kernel call is recorded (unless the output file
+ * has already been set by LSM_Instrumentation_setOutputFile()).
+ */
+static void LSM_Instrumentation_initializeOutputFile(void);
+
+/*
+ * LSM_Instrumentation_registerWriteAtExit() registers
+ * LSM_Instrumentation_writeAtExit() with atexit() (once).
+ */
+static void LSM_Instrumentation_registerWriteAtExit(void);
+
+/*
+ * LSM_Instrumentation_writeAtExit() writes the instrumentation data to
+ * the output file (if one has been set).
+ */
+static void LSM_Instrumentation_writeAtExit(void);
+
+
+/*==================== Function Definitions =========================*/
+
+int LSM_Instrumentation_isEnabled(void)
+{
+#ifdef LSMLIB_ENABLE_INSTRUMENTATION
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+
+double LSM_Instrumentation_getWallTime(void)
+{
+#ifdef _OPENMP
+  return omp_get_wtime();
+#else
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec + 1.e-6*tv.tv_usec;
+#endif
+}
+
+
+void LSM_Instrumentation_record(
+  LSM_InstrumentationKernelFamily family,
+  double wall_time,
+  double bytes_touched,
+  double points_updated)
+{
+  if ( (family < 0) || (family >= LSM_INSTRUMENTATION_NUM_KERNEL_FAMILIES) ) {
+    return;
+  }
+
+#ifdef _OPENMP
+#pragma omp critical (lsm_instrumentation)
+#endif
+  {
+    if (!s_output_file_initialized) {
+      LSM_Instrumentation_initializeOutputFile();
+    }
+
+    s_records[family].num_calls++;
+    s_records[family].wall_time += wall_time;
+    s_records[family].bytes_touched += bytes_touched;
+    s_records[family].points_updated += points_updated;
+  }
+}
+
+
+int LSM_Instrumentation_getRecord(
+  LSM_InstrumentationKernelFamily family,
+  LSM_InstrumentationRecord *record)
+{
+  if ( (family < 0) || (family >= LSM_INSTRUMENTATION_NUM_KERNEL_FAMILIES) ) {
+    return -1;
+  }
+
+#ifdef _OPENMP
+#pragma omp critical (lsm_instrumentation)
+#endif
+  *record = s_records[family];
+
+  return 0;
+}
+
+
+const char *LSM_Instrumentation_getKernelFamilyName(
+  LSM_InstrumentationKernelFamily family)
+{
+  if ( (family < 0) || (family >= LSM_INSTRUMENTATION_NUM_KERNEL_FAMILIES) ) {
+    return "unknown";
+  }
+  return s_kernel_family_names[family];
+}
+
+
+void LSM_Instrumentation_reset(void)
+{
+#ifdef _OPENMP
+#pragma omp critical (lsm_instrumentation)
+#endif
+  memset(s_records, 0, sizeof(s_records));
+}
+
+
+void LSM_Instrumentation_writeJSON(FILE *fp)
+{
+  int family;
+
+  fprintf(fp, "{\n");
+  fprintf(fp, "  \"instrumentation_enabled\": %s,\n",
+          LSM_Instrumentation_isEnabled() ? "true" : "false");
+  fprintf(fp, "  \"kernel_families\": [\n");
+  for (family = 0; family < LSM_INSTRUMENTATION_NUM_KERNEL_FAMILIES;
+       family++) {
+    LSM_InstrumentationRecord record;
+    LSM_Instrumentation_getRecord(
+      (LSM_InstrumentationKernelFamily) family, &record);
+    fprintf(fp, "    { \"name\": \"%s\", \"num_calls\": %ld, "
+                "\"wall_time\": %.9g, \"bytes_touched\": %.17g, "
+                "\"points_updated\": %.17g }%s\n",
+            s_kernel_family_names[family], record.num_calls,
+            record.wall_time, record.bytes_touched, record.points_updated,
+            (family < LSM_INSTRUMENTATION_NUM_KERNEL_FAMILIES-1) ? "," : "");
+  }
+  fprintf(fp, "  ]\n");
+  fprintf(fp, "}\n");
+}
+
+
+void LSM_Instrumentation_writeCSV(FILE *fp)
+{
+  int family;
+
+  fprintf(fp, "kernel_family,num_calls,wall_time,bytes_touched,"
+              "points_updated\n");
+  for (family = 0; family < LSM_INSTRUMENTATION_NUM_KERNEL_FAMILIES;
+       family++) {
+    LSM_InstrumentationRecord record;
+    LSM_Instrumentation_getRecord(
+      (LSM_InstrumentationKernelFamily) family, &record);
+    fprintf(fp, "%s,%ld,%.9g,%.17g,%.17g\n",
+            s_kernel_family_names[family], record.num_calls,
+            record.wall_time, record.bytes_touched, record.points_updated);
+  }
+}
+
+
+int LSM_Instrumentation_writeToFile(const char *file_name)
+{
+  FILE *fp;
+  size_t len = strlen(file_name);
+
+  fp = fopen(file_name, "w");
+  if (!fp) return -1;
+
+  if ( (len >= 4) && (0 == strcmp(file_name + len - 4, ".csv")) ) {
+    LSM_Instrumentation_writeCSV(fp);
+  } else {
+    LSM_Instrumentation_writeJSON(fp);
+  }
+
+  fclose(fp);
+  return 0;
+}
+
+
+void LSM_Instrumentation_setOutputFile(const char *file_name)
+{
+#ifdef _OPENMP
+#pragma omp critical (lsm_instrumentation)
+#endif
+  {
+    if (file_name) {
+      strncpy(s_output_file_name, file_name,
+              LSM_INSTRUMENTATION_MAX_FILE_NAME_LENGTH-1);
+      s_output_file_name[LSM_INSTRUMENTATION_MAX_FILE_NAME_LENGTH-1] = '\0';
+    } else {
+      s_output_file_name[0] = '\0';
+    }
+
+    /* the environment variable does not override the file name */
+    s_output_file_initialized = 1;
+    LSM_Instrumentation_registerWriteAtExit();
+  }
+}
+
+
+/*==================== Helper Functions Definitions =================*/
+
+static void LSM_Instrumentation_initializeOutputFile(void)
+{
+  const char *env_file_name = getenv("LSMLIB_INSTRUMENTATION_FILE");
+  if (env_file_name) {
+    strncpy(s_output_file_name, env_file_name,
+            LSM_INSTRUMENTATION_MAX_FILE_NAME_LENGTH-1);
+    s_output_file_name[LSM_INSTRUMENTATION_MAX_FILE_NAME_LENGTH-1] = '\0';
+  }
+  s_output_file_initialized = 1;
+
+  LSM_Instrumentation_registerWriteAtExit();
+}
+
+
+static void LSM_Instrumentation_registerWriteAtExit(void)
+{
+  /* instrumentation data is only written when it is collected */
+  if (!LSM_Instrumentation_isEnabled()) return;
+
+  if (!s_atexit_registered) {
+    atexit(LSM_Instrumentation_writeAtExit);
+    s_atexit_registered = 1;
+  }
+}
+
+
+static void LSM_Instrumentation_writeAtExit(void)
+{
+  if (s_output_file_name[0] != '\0') {
+    if (LSM_Instrumentation_writeToFile(s_output_file_name)) {
+      fprintf(stderr,
+        "WARNING: Unable to write LSMLIB instrumentation data to '%s'.\n",
+        s_output_file_name);
+    }
+  }
+}
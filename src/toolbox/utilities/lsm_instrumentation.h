@@ -0,0 +1,256 @@
+/*
+ * File:        lsm_instrumentation.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for LSMLIB kernel instrumentation
+ */
+
+#ifndef INCLUDED_LSM_INSTRUMENTATION_H
+#define INCLUDED_LSM_INSTRUMENTATION_H
+
+#include <stdio.h>
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \file lsm_instrumentation.h
+ *
+ * \brief
+ * @ref lsm_instrumentation.h provides a low-overhead instrumentation
+ * layer that records the number of calls, wall time, (estimated)
+ * number of bytes touched and number of grid points updated for each
+ * family of level set method kernels.
+ *
+ * Instrumentation is enabled at compile time using the
+ * --enable-instrumentation configure option (which defines
+ * LSMLIB_ENABLE_INSTRUMENTATION in LSMLIB_config.h).  When it is
+ * disabled, the LSM_INSTRUMENTATION_START() and
+ * LSM_INSTRUMENTATION_STOP() macros expand to nothing, so instrumented
+ * code has no overhead.  The query and output functions are always
+ * available; they report zero for all kernel families when
+ * instrumentation is disabled.
+ *
+ * <h3> Usage: </h3>
+ *
+ * - Run an instrumented code with the LSMLIB_INSTRUMENTATION_FILE
+ *   environment variable set (or call LSM_Instrumentation_setOutputFile())
+ *   to have the instrumentation data written when the program exits.
+ *   The data is written in CSV format if the file name ends in ".csv"
+ *   and in JSON format otherwise.
+ * - Query the data for a kernel family from within the program using
+ *   LSM_Instrumentation_getRecord().
+ * - Time user-provided code using the same macros, e.g.
+ *   \code
+ *     LSM_INSTRUMENTATION_START(t_start);
+ *     ...
+ *     LSM_INSTRUMENTATION_STOP(LSM_INSTRUMENTATION_RHS, t_start,
+ *                              num_bytes, num_points);
+ *   \endcode
+ *
+ * <h3> NOTES: </h3>
+ * - The data is accumulated separately by each process.  For parallel
+ *   calculations, use a different output file for each process
+ *   (e.g. by appending the MPI rank to the file name).
+ * - Recording a kernel call is thread-safe.
+ * - The number of bytes touched is estimated by the caller from the
+ *   number of grid points and the number of data arrays read and
+ *   written by the kernel; it does not account for cache effects.
+ * - Wall times of nested kernel families are included in the wall time
+ *   of the enclosing kernel family (e.g. the time for ghost cell fills
+ *   within a reinitialization calculation is counted for both
+ *   families).
+ * - In the parallel package, regridding of the patch hierarchy around
+ *   the zero level set is recorded as LSM_INSTRUMENTATION_NARROW_BAND_REBUILD.
+ *
+ */
+
+
+/*!
+ * Kernel families tracked by the instrumentation layer.
+ */
+typedef enum {
+  LSM_INSTRUMENTATION_SPATIAL_DERIVATIVES = 0,
+  LSM_INSTRUMENTATION_RHS = 1,
+  LSM_INSTRUMENTATION_TVD_RK_STAGE = 2,
+  LSM_INSTRUMENTATION_REINITIALIZATION = 3,
+  LSM_INSTRUMENTATION_FAST_MARCHING_METHOD = 4,
+  LSM_INSTRUMENTATION_NARROW_BAND_REBUILD = 5,
+  LSM_INSTRUMENTATION_GHOST_FILL = 6,
+  LSM_INSTRUMENTATION_REDUCTION = 7,
+  LSM_INSTRUMENTATION_NUM_KERNEL_FAMILIES = 8
+} LSM_InstrumentationKernelFamily;
+
+
+/*!
+ * Structure 'LSM_InstrumentationRecord' stores the accumulated
+ * instrumentation data for a single kernel family.
+ */
+typedef struct _LSM_InstrumentationRecord
+{
+  long num_calls;
+  double wall_time;         /* seconds */
+  double bytes_touched;
+  double points_updated;
+} LSM_InstrumentationRecord;
+
+
+/* Instrumentation macros */
+#ifdef LSMLIB_ENABLE_INSTRUMENTATION
+#define LSM_INSTRUMENTATION_START(timer)                                  \
+  double timer = LSM_Instrumentation_getWallTime()
+#define LSM_INSTRUMENTATION_STOP(family, timer, num_bytes, num_points)    \
+  LSM_Instrumentation_record((family),                                    \
+                             LSM_Instrumentation_getWallTime() - (timer), \
+                             (double) (num_bytes), (double) (num_points))
+#else
+#define LSM_INSTRUMENTATION_START(timer)
+#define LSM_INSTRUMENTATION_STOP(family, timer, num_bytes, num_points)
+#endif
+
+
+/*!
+ * LSM_Instrumentation_isEnabled() returns 1 if LSMLIB was compiled with
+ * instrumentation and 0 otherwise.
+ */
+int LSM_Instrumentation_isEnabled(void);
+
+
+/*!
+ * LSM_Instrumentation_getWallTime() returns the wall clock time (in
+ * seconds) relative to an arbitrary fixed time.
+ */
+double LSM_Instrumentation_getWallTime(void);
+
+
+/*!
+ * LSM_Instrumentation_record() adds a kernel call to the
+ * instrumentation data.
+ *
+ * Arguments:
+ *  - family (in):          kernel family
+ *  - wall_time (in):       wall time for kernel call (in seconds)
+ *  - bytes_touched (in):   estimated number of bytes read and written
+ *  - points_updated (in):  number of grid points updated
+ *
+ * Return value:            none
+ *
+ * NOTES:
+ *  - Normally called through LSM_INSTRUMENTATION_STOP().
+ *
+ */
+void LSM_Instrumentation_record(
+  LSM_InstrumentationKernelFamily family,
+  double wall_time,
+  double bytes_touched,
+  double points_updated);
+
+
+/*!
+ * LSM_Instrumentation_getRecord() retrieves the accumulated
+ * instrumentation data for a kernel family.
+ *
+ * Arguments:
+ *  - family (in):   kernel family
+ *  - record (out):  instrumentation data
+ *
+ * Return value:     0 on success; -1 if family is invalid
+ *
+ */
+int LSM_Instrumentation_getRecord(
+  LSM_InstrumentationKernelFamily family,
+  LSM_InstrumentationRecord *record);
+
+
+/*!
+ * LSM_Instrumentation_getKernelFamilyName() returns the name of a
+ * kernel family (e.g. "spatial_derivatives").
+ *
+ * Arguments:
+ *  - family (in):   kernel family
+ *
+ * Return value:     name of kernel family; "unknown" if family is
+ *                   invalid
+ *
+ */
+const char *LSM_Instrumentation_getKernelFamilyName(
+  LSM_InstrumentationKernelFamily family);
+
+
+/*!
+ * LSM_Instrumentation_reset() sets the instrumentation data for all
+ * kernel families to zero.
+ */
+void LSM_Instrumentation_reset(void);
+
+
+/*!
+ * LSM_Instrumentation_writeJSON() writes the instrumentation data in
+ * JSON format.
+ *
+ * Arguments:
+ *  - fp (in):   output stream
+ *
+ * Return value: none
+ *
+ */
+void LSM_Instrumentation_writeJSON(FILE *fp);
+
+
+/*!
+ * LSM_Instrumentation_writeCSV() writes the instrumentation data in
+ * CSV format (with a header line).
+ *
+ * Arguments:
+ *  - fp (in):   output stream
+ *
+ * Return value: none
+ *
+ */
+void LSM_Instrumentation_writeCSV(FILE *fp);
+
+
+/*!
+ * LSM_Instrumentation_writeToFile() writes the instrumentation data to
+ * a file.  The data is written in CSV format if the file name ends in
+ * ".csv" and in JSON format otherwise.
+ *
+ * Arguments:
+ *  - file_name (in):  name of output file
+ *
+ * Return value:       0 on success; -1 if the file could not be opened
+ *
+ */
+int LSM_Instrumentation_writeToFile(const char *file_name);
+
+
+/*!
+ * LSM_Instrumentation_setOutputFile() sets the name of the file that
+ * the instrumentation data is written to when the program exits.
+ *
+ * Arguments:
+ *  - file_name (in):  name of output file (NULL disables output at
+ *                     exit)
+ *
+ * Return value:       none
+ *
+ * NOTES:
+ *  - If LSM_Instrumentation_setOutputFile() is not called, the value
+ *    of the LSMLIB_INSTRUMENTATION_FILE environment variable (if it
+ *    is set) is used as the output file.
+ *
+ *  - Output at exit is only performed when LSMLIB is compiled with
+ *    instrumentation.
+ *
+ */
+void LSM_Instrumentation_setOutputFile(const char *file_name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
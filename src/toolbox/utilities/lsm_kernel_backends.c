@@ -0,0 +1,699 @@
+/*
+ * File:        lsm_kernel_backends.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for runtime selection of LSMLIB
+ *              kernel implementations
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+#include "lsm_kernel_backends.h"
+#include "lsm_spatial_derivatives2d.h"
+#include "lsm_spatial_derivatives3d.h"
+
+
+/*============================= Constants ===========================*/
+
+#define LSM_KERNEL_BACKENDS_MAX_NAME_LENGTH                     (64)
+
+/* backend indices used in the selection tables */
+#define LSM_KERNEL_BACKENDS_AUTOMATIC                           (-2)
+#define LSM_KERNEL_BACKENDS_REFERENCE_IDX                       (-1)
+
+/* number of interior grid cells and ghostcells of validation problem */
+#define LSM_KERNEL_BACKENDS_TEST_NUM_GHOSTCELLS                  (3)
+
+static const int s_test_grid_dims[3] = {10, 9, 8};
+static const LSMLIB_REAL s_test_dx[3] = {0.1, 0.2, 0.15};
+
+/* boundary condition types used to validate the *_BDRY kernels */
+static const int s_test_bdry_types[6] = {1, 2, 3, 0, 3, 2};
+
+static const char *s_kernel_names[LSM_KERNEL_NUM_KERNELS] = {
+  "LSM2D_HJ_ENO1",
+  "LSM2D_HJ_ENO2",
+  "LSM2D_HJ_ENO3",
+  "LSM2D_HJ_WENO5",
+  "LSM2D_HJ_ENO1_BDRY",
+  "LSM2D_HJ_ENO2_BDRY",
+  "LSM2D_HJ_ENO3_BDRY",
+  "LSM2D_HJ_WENO5_BDRY",
+  "LSM3D_HJ_ENO1",
+  "LSM3D_HJ_ENO2",
+  "LSM3D_HJ_ENO3",
+  "LSM3D_HJ_WENO5",
+  "LSM3D_HJ_ENO1_BDRY",
+  "LSM3D_HJ_ENO2_BDRY",
+  "LSM3D_HJ_ENO3_BDRY",
+  "LSM3D_HJ_WENO5_BDRY"
+};
+
+
+/*=========================== Data Types ============================*/
+
+/*
+ * Structure 'LSM_KernelBackendsTestProblem' stores the data arrays
+ * and index spaces for validating a kernel.
+ */
+typedef struct _LSM_KernelBackendsTestProblem
+{
+  int num_dims;
+  int lo_gb[3], hi_gb[3];
+  int lo_fb[3], hi_fb[3];
+  int num_gridpts;
+  LSMLIB_REAL *phi;
+  LSMLIB_REAL *D1, *D2, *D3;
+  LSMLIB_REAL *grad_phi_plus[3];
+  LSMLIB_REAL *grad_phi_minus[3];
+} LSM_KernelBackendsTestProblem;
+
+
+/*========================= Static Variables ========================*/
+
+static LSM_KernelBackend s_reference_backend;
+static LSM_KernelBackend s_backends[LSM_KERNEL_BACKENDS_MAX_BACKENDS];
+static char s_backend_names[LSM_KERNEL_BACKENDS_MAX_BACKENDS]
+                           [LSM_KERNEL_BACKENDS_MAX_NAME_LENGTH];
+static int s_num_backends = 0;
+
+/* backend selected by LSM_KernelBackends_select() for each kernel */
+static int s_requested_backend[LSM_KERNEL_NUM_KERNELS];
+
+/* backend used for each kernel and the corresponding functions */
+static int s_selected_backend[LSM_KERNEL_NUM_KERNELS];
+static LSM_KernelFunction s_functions[LSM_KERNEL_NUM_KERNELS];
+
+/* backend name from the LSMLIB_KERNEL_BACKEND environment variable */
+static char s_env_backend_name[LSM_KERNEL_BACKENDS_MAX_NAME_LENGTH];
+
+static volatile int s_initialized = 0;
+
+
+/*================== Helper Functions Declarations ==================*/
+
+/*
+ * LSM_KernelBackends_initialize() sets up the reference backend and
+ * reads the LSMLIB_KERNEL_BACKEND environment variable (once).
+ */
+static void LSM_KernelBackends_initialize(void);
+
+/*
+ * LSM_KernelBackends_updateSelection() recomputes the backend used for
+ * each kernel.
+ */
+static void LSM_KernelBackends_updateSelection(void);
+
+/*
+ * LSM_KernelBackends_findBackend() returns the index of the backend
+ * with the specified name (LSM_KERNEL_BACKENDS_REFERENCE_IDX for the
+ * reference backend); LSM_KERNEL_BACKENDS_AUTOMATIC if there is no
+ * such backend.
+ */
+static int LSM_KernelBackends_findBackend(const char *name);
+
+/*
+ * LSM_KernelBackends_createTestProblem() allocates the data arrays for
+ * validating a kernel in the specified number of dimensions and fills
+ * phi (including ghostcells) with pseudo-random data.
+ */
+static int LSM_KernelBackends_createTestProblem(
+  LSM_KernelBackendsTestProblem *test_problem,
+  int num_dims);
+
+/*
+ * LSM_KernelBackends_destroyTestProblem() frees the data arrays of a
+ * test problem.
+ */
+static void LSM_KernelBackends_destroyTestProblem(
+  LSM_KernelBackendsTestProblem *test_problem);
+
+/*
+ * LSM_KernelBackends_callKernel() calls a kernel function on a test
+ * problem.
+ */
+static void LSM_KernelBackends_callKernel(
+  LSM_KernelFunction function,
+  LSM_KernelId kernel,
+  LSM_KernelBackendsTestProblem *test_problem);
+
+
+/*==================== Function Definitions =========================*/
+
+int LSM_KernelBackends_register(const LSM_KernelBackend *backend)
+{
+  int kernel;
+  int idx;
+
+  LSM_KernelBackends_initialize();
+
+  if ( (!backend) || (!backend->name) || (backend->name[0] == '\0') ||
+       (strlen(backend->name) >= LSM_KERNEL_BACKENDS_MAX_NAME_LENGTH) ||
+       (LSM_KernelBackends_findBackend(backend->name)
+          != LSM_KERNEL_BACKENDS_AUTOMATIC) ||
+       (s_num_backends >= LSM_KERNEL_BACKENDS_MAX_BACKENDS) ) {
+    return LSM_KERNEL_BACKENDS_ERR_INVALID_BACKEND;
+  }
+
+  /* kernels of unsupported backends must not be called (not even for
+   * validation) */
+  if ( (backend->is_supported) && (!backend->is_supported()) ) {
+    return LSM_KERNEL_BACKENDS_ERR_NOT_SUPPORTED;
+  }
+
+  for (kernel = 0; kernel < LSM_KERNEL_NUM_KERNELS; kernel++) {
+    int error_code = LSM_KernelBackends_validate(
+      backend, (LSM_KernelId) kernel, NULL);
+    if (error_code != LSM_KERNEL_BACKENDS_ERR_SUCCESS) return error_code;
+  }
+
+  idx = s_num_backends++;
+  s_backends[idx] = *backend;
+  strcpy(s_backend_names[idx], backend->name);
+  s_backends[idx].name = s_backend_names[idx];
+
+  LSM_KernelBackends_updateSelection();
+
+  return LSM_KERNEL_BACKENDS_ERR_SUCCESS;
+}
+
+
+int LSM_KernelBackends_validate(
+  const LSM_KernelBackend *backend,
+  LSM_KernelId kernel,
+  LSMLIB_REAL *max_error)
+{
+  LSM_KernelBackendsTestProblem test_problem;
+  LSMLIB_REAL *grad_phi_ref[6];
+  LSMLIB_REAL max_ref = 0.0, max_diff = 0.0;
+  int num_dims;
+  int dir, i, j, k;
+  int num_ghostcells_x, num_ghostcells_xy;
+
+  if (max_error) *max_error = 0.0;
+
+  if ( (kernel < 0) || (kernel >= LSM_KERNEL_NUM_KERNELS) ) {
+    return LSM_KERNEL_BACKENDS_ERR_INVALID_KERNEL;
+  }
+  if ( (!backend) || (!backend->kernels[kernel]) ) {
+    return LSM_KERNEL_BACKENDS_ERR_SUCCESS;
+  }
+
+  LSM_KernelBackends_initialize();
+
+  num_dims = (kernel < LSM_KERNEL_HJ_ENO1_3D) ? 2 : 3;
+  if (LSM_KernelBackends_createTestProblem(&test_problem, num_dims)) {
+    return LSM_KERNEL_BACKENDS_ERR_VALIDATION_FAILED;
+  }
+
+  /* compute reference result */
+  LSM_KernelBackends_callKernel(s_reference_backend.kernels[kernel],
+                                kernel, &test_problem);
+  for (dir = 0; dir < num_dims; dir++) {
+    size_t size = test_problem.num_gridpts*sizeof(LSMLIB_REAL);
+    grad_phi_ref[dir] = (LSMLIB_REAL*) malloc(size);
+    grad_phi_ref[num_dims+dir] = (LSMLIB_REAL*) malloc(size);
+    memcpy(grad_phi_ref[dir], test_problem.grad_phi_plus[dir], size);
+    memcpy(grad_phi_ref[num_dims+dir], test_problem.grad_phi_minus[dir],
+           size);
+    memset(test_problem.grad_phi_plus[dir], 0, size);
+    memset(test_problem.grad_phi_minus[dir], 0, size);
+  }
+
+  /* compute result of backend and compare on the fillbox */
+  LSM_KernelBackends_callKernel(backend->kernels[kernel], kernel,
+                                &test_problem);
+
+  num_ghostcells_x = test_problem.hi_gb[0] - test_problem.lo_gb[0] + 1;
+  num_ghostcells_xy = num_ghostcells_x
+                    * (test_problem.hi_gb[1] - test_problem.lo_gb[1] + 1);
+  for (dir = 0; dir < 2*num_dims; dir++) {
+    LSMLIB_REAL *grad_phi = (dir < num_dims)
+                          ? test_problem.grad_phi_plus[dir]
+                          : test_problem.grad_phi_minus[dir-num_dims];
+    for (k = test_problem.lo_fb[2]; k <= test_problem.hi_fb[2]; k++) {
+      for (j = test_problem.lo_fb[1]; j <= test_problem.hi_fb[1]; j++) {
+        for (i = test_problem.lo_fb[0]; i <= test_problem.hi_fb[0]; i++) {
+          int idx = (i - test_problem.lo_gb[0])
+                  + (j - test_problem.lo_gb[1])*num_ghostcells_x
+                  + (k - test_problem.lo_gb[2])*num_ghostcells_xy;
+          LSMLIB_REAL diff = fabs(grad_phi[idx] - grad_phi_ref[dir][idx]);
+
+          /* NaN results never agree with the reference */
+          if (diff != diff) diff = LSMLIB_REAL_MAX;
+          if (diff > max_diff) max_diff = diff;
+          if (fabs(grad_phi_ref[dir][idx]) > max_ref) {
+            max_ref = fabs(grad_phi_ref[dir][idx]);
+          }
+        }
+      }
+    }
+  }
+
+  for (dir = 0; dir < 2*num_dims; dir++) {
+    free(grad_phi_ref[dir]);
+  }
+  LSM_KernelBackends_destroyTestProblem(&test_problem);
+
+  if (max_ref > 0.0) max_diff /= max_ref;
+  if (max_error) *max_error = max_diff;
+
+  return (max_diff <= LSM_KERNEL_BACKENDS_VALIDATION_TOLERANCE)
+       ? LSM_KERNEL_BACKENDS_ERR_SUCCESS
+       : LSM_KERNEL_BACKENDS_ERR_VALIDATION_FAILED;
+}
+
+
+int LSM_KernelBackends_select(int kernel, const char *backend_name)
+{
+  int idx = LSM_KERNEL_BACKENDS_AUTOMATIC;
+  int k;
+
+  LSM_KernelBackends_initialize();
+
+  if ( (kernel != LSM_KERNEL_ALL) &&
+       ((kernel < 0) || (kernel >= LSM_KERNEL_NUM_KERNELS)) ) {
+    return LSM_KERNEL_BACKENDS_ERR_INVALID_KERNEL;
+  }
+
+  if (backend_name) {
+    idx = LSM_KernelBackends_findBackend(backend_name);
+    if (idx == LSM_KERNEL_BACKENDS_AUTOMATIC) {
+      return LSM_KERNEL_BACKENDS_ERR_UNKNOWN_BACKEND;
+    }
+  }
+
+  if (kernel == LSM_KERNEL_ALL) {
+    for (k = 0; k < LSM_KERNEL_NUM_KERNELS; k++) {
+      if ( (idx < 0) || (s_backends[idx].kernels[k]) ) {
+        s_requested_backend[k] = idx;
+      }
+    }
+  } else {
+    if ( (idx >= 0) && (!s_backends[idx].kernels[kernel]) ) {
+      return LSM_KERNEL_BACKENDS_ERR_INVALID_KERNEL;
+    }
+    s_requested_backend[kernel] = idx;
+  }
+
+  LSM_KernelBackends_updateSelection();
+
+  return LSM_KERNEL_BACKENDS_ERR_SUCCESS;
+}
+
+
+LSM_KernelFunction LSM_KernelBackends_getFunction(LSM_KernelId kernel)
+{
+  if ( (kernel < 0) || (kernel >= LSM_KERNEL_NUM_KERNELS) ) {
+    return NULL;
+  }
+  if (!s_initialized) LSM_KernelBackends_initialize();
+  return s_functions[kernel];
+}
+
+
+const char *LSM_KernelBackends_getSelectedBackend(LSM_KernelId kernel)
+{
+  int idx;
+
+  if ( (kernel < 0) || (kernel >= LSM_KERNEL_NUM_KERNELS) ) {
+    return "unknown";
+  }
+  LSM_KernelBackends_initialize();
+
+  idx = s_selected_backend[kernel];
+  return (idx < 0) ? LSM_KERNEL_BACKENDS_REFERENCE : s_backends[idx].name;
+}
+
+
+const char *LSM_KernelBackends_getKernelName(LSM_KernelId kernel)
+{
+  if ( (kernel < 0) || (kernel >= LSM_KERNEL_NUM_KERNELS) ) {
+    return "unknown";
+  }
+  return s_kernel_names[kernel];
+}
+
+
+int LSM_KernelBackends_cpuSupports(const char *feature)
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  /* __builtin_cpu_supports() only accepts string literals */
+  __builtin_cpu_init();
+  if (0 == strcmp(feature, "sse4.2")) {
+    return (0 != __builtin_cpu_supports("sse4.2"));
+  } else if (0 == strcmp(feature, "avx")) {
+    return (0 != __builtin_cpu_supports("avx"));
+  } else if (0 == strcmp(feature, "avx2")) {
+    return (0 != __builtin_cpu_supports("avx2"));
+  } else if (0 == strcmp(feature, "fma")) {
+    return (0 != __builtin_cpu_supports("fma"));
+  } else if (0 == strcmp(feature, "avx512f")) {
+    return (0 != __builtin_cpu_supports("avx512f"));
+  } else if (0 == strcmp(feature, "avx512bw")) {
+    return (0 != __builtin_cpu_supports("avx512bw"));
+  } else if (0 == strcmp(feature, "avx512vl")) {
+    return (0 != __builtin_cpu_supports("avx512vl"));
+  } else if (0 == strcmp(feature, "avx512dq")) {
+    return (0 != __builtin_cpu_supports("avx512dq"));
+  }
+#endif
+  (void) feature;
+  return 0;
+}
+
+
+void LSM_KernelBackends_writeReport(FILE *fp)
+{
+  int idx, kernel;
+
+  LSM_KernelBackends_initialize();
+
+  fprintf(fp, "Registered kernel backends:\n");
+  fprintf(fp, "  %s\n", LSM_KERNEL_BACKENDS_REFERENCE);
+  for (idx = 0; idx < s_num_backends; idx++) {
+    fprintf(fp, "  %s (priority %d)\n", s_backends[idx].name,
+            s_backends[idx].priority);
+  }
+
+  fprintf(fp, "Selected kernel backends:\n");
+  for (kernel = 0; kernel < LSM_KERNEL_NUM_KERNELS; kernel++) {
+    fprintf(fp, "  %-22s %s\n", s_kernel_names[kernel],
+            LSM_KernelBackends_getSelectedBackend((LSM_KernelId) kernel));
+  }
+}
+
+
+/*==================== Helper Functions Definitions =================*/
+
+static void LSM_KernelBackends_initialize(void)
+{
+  if (s_initialized) return;
+
+#ifdef _OPENMP
+#pragma omp critical (lsm_kernel_backends)
+#endif
+  {
+    if (!s_initialized) {
+      LSM_KernelBackend *ref = &s_reference_backend;
+      const char *env_backend_name = getenv("LSMLIB_KERNEL_BACKEND");
+      int kernel;
+
+      memset(ref, 0, sizeof(LSM_KernelBackend));
+      ref->name = LSM_KERNEL_BACKENDS_REFERENCE;
+      ref->kernels[LSM_KERNEL_HJ_ENO1_2D] =
+        (LSM_KernelFunction) &LSM2D_HJ_ENO1;
+      ref->kernels[LSM_KERNEL_HJ_ENO2_2D] =
+        (LSM_KernelFunction) &LSM2D_HJ_ENO2;
+      ref->kernels[LSM_KERNEL_HJ_ENO3_2D] =
+        (LSM_KernelFunction) &LSM2D_HJ_ENO3;
+      ref->kernels[LSM_KERNEL_HJ_WENO5_2D] =
+        (LSM_KernelFunction) &LSM2D_HJ_WENO5;
+      ref->kernels[LSM_KERNEL_HJ_ENO1_BDRY_2D] =
+        (LSM_KernelFunction) &LSM2D_HJ_ENO1_BDRY;
+      ref->kernels[LSM_KERNEL_HJ_ENO2_BDRY_2D] =
+        (LSM_KernelFunction) &LSM2D_HJ_ENO2_BDRY;
+      ref->kernels[LSM_KERNEL_HJ_ENO3_BDRY_2D] =
+        (LSM_KernelFunction) &LSM2D_HJ_ENO3_BDRY;
+      ref->kernels[LSM_KERNEL_HJ_WENO5_BDRY_2D] =
+        (LSM_KernelFunction) &LSM2D_HJ_WENO5_BDRY;
+      ref->kernels[LSM_KERNEL_HJ_ENO1_3D] =
+        (LSM_KernelFunction) &LSM3D_HJ_ENO1;
+      ref->kernels[LSM_KERNEL_HJ_ENO2_3D] =
+        (LSM_KernelFunction) &LSM3D_HJ_ENO2;
+      ref->kernels[LSM_KERNEL_HJ_ENO3_3D] =
+        (LSM_KernelFunction) &LSM3D_HJ_ENO3;
+      ref->kernels[LSM_KERNEL_HJ_WENO5_3D] =
+        (LSM_KernelFunction) &LSM3D_HJ_WENO5;
+      ref->kernels[LSM_KERNEL_HJ_ENO1_BDRY_3D] =
+        (LSM_KernelFunction) &LSM3D_HJ_ENO1_BDRY;
+      ref->kernels[LSM_KERNEL_HJ_ENO2_BDRY_3D] =
+        (LSM_KernelFunction) &LSM3D_HJ_ENO2_BDRY;
+      ref->kernels[LSM_KERNEL_HJ_ENO3_BDRY_3D] =
+        (LSM_KernelFunction) &LSM3D_HJ_ENO3_BDRY;
+      ref->kernels[LSM_KERNEL_HJ_WENO5_BDRY_3D] =
+        (LSM_KernelFunction) &LSM3D_HJ_WENO5_BDRY;
+
+      if (env_backend_name) {
+        strncpy(s_env_backend_name, env_backend_name,
+                LSM_KERNEL_BACKENDS_MAX_NAME_LENGTH-1);
+        s_env_backend_name[LSM_KERNEL_BACKENDS_MAX_NAME_LENGTH-1] = '\0';
+      }
+
+      for (kernel = 0; kernel < LSM_KERNEL_NUM_KERNELS; kernel++) {
+        s_requested_backend[kernel] = LSM_KERNEL_BACKENDS_AUTOMATIC;
+        s_selected_backend[kernel] = LSM_KERNEL_BACKENDS_REFERENCE_IDX;
+        s_functions[kernel] = ref->kernels[kernel];
+      }
+
+      s_initialized = 1;
+    }
+  }
+}
+
+
+static void LSM_KernelBackends_updateSelection(void)
+{
+  int env_idx = LSM_KernelBackends_findBackend(s_env_backend_name);
+  int kernel, idx;
+
+  for (kernel = 0; kernel < LSM_KERNEL_NUM_KERNELS; kernel++) {
+    int selected = s_requested_backend[kernel];
+
+    if (selected == LSM_KERNEL_BACKENDS_AUTOMATIC) {
+      if ( (env_idx == LSM_KERNEL_BACKENDS_REFERENCE_IDX) ||
+           ((env_idx >= 0) && (s_backends[env_idx].kernels[kernel])) ) {
+        selected = env_idx;
+      } else {
+        /* registered backend with highest priority */
+        selected = LSM_KERNEL_BACKENDS_REFERENCE_IDX;
+        for (idx = 0; idx < s_num_backends; idx++) {
+          if ( (s_backends[idx].kernels[kernel]) &&
+               ( (selected < 0) ||
+                 (s_backends[idx].priority
+                    > s_backends[selected].priority) ) ) {
+            selected = idx;
+          }
+        }
+      }
+    }
+
+    s_selected_backend[kernel] = selected;
+    s_functions[kernel] = (selected < 0)
+                        ? s_reference_backend.kernels[kernel]
+                        : s_backends[selected].kernels[kernel];
+  }
+}
+
+
+static int LSM_KernelBackends_findBackend(const char *name)
+{
+  int idx;
+
+  if ( (!name) || (name[0] == '\0') ) return LSM_KERNEL_BACKENDS_AUTOMATIC;
+  if (0 == strcmp(name, LSM_KERNEL_BACKENDS_REFERENCE)) {
+    return LSM_KERNEL_BACKENDS_REFERENCE_IDX;
+  }
+  for (idx = 0; idx < s_num_backends; idx++) {
+    if (0 == strcmp(name, s_backends[idx].name)) return idx;
+  }
+  return LSM_KERNEL_BACKENDS_AUTOMATIC;
+}
+
+
+static int LSM_KernelBackends_createTestProblem(
+  LSM_KernelBackendsTestProblem *test_problem,
+  int num_dims)
+{
+  LSM_KernelBackendsTestProblem *tp = test_problem;
+  int g = LSM_KERNEL_BACKENDS_TEST_NUM_GHOSTCELLS;
+  unsigned int seed = 12345;
+  size_t size;
+  int dir, n;
+
+  memset(tp, 0, sizeof(LSM_KernelBackendsTestProblem));
+  tp->num_dims = num_dims;
+  tp->num_gridpts = 1;
+  for (dir = 0; dir < 3; dir++) {
+    int N = (dir < num_dims) ? s_test_grid_dims[dir] : 1;
+    int num_ghostcells = (dir < num_dims) ? g : 0;
+    tp->lo_gb[dir] = 0;
+    tp->hi_gb[dir] = N + 2*num_ghostcells - 1;
+    tp->lo_fb[dir] = num_ghostcells;
+    tp->hi_fb[dir] = N + num_ghostcells - 1;
+    tp->num_gridpts *= N + 2*num_ghostcells;
+  }
+
+  size = tp->num_gridpts*sizeof(LSMLIB_REAL);
+  tp->phi = (LSMLIB_REAL*) malloc(size);
+  tp->D1 = (LSMLIB_REAL*) malloc(size);
+  tp->D2 = (LSMLIB_REAL*) malloc(size);
+  tp->D3 = (LSMLIB_REAL*) malloc(size);
+  if ( (!tp->phi) || (!tp->D1) || (!tp->D2) || (!tp->D3) ) {
+    LSM_KernelBackends_destroyTestProblem(tp);
+    return -1;
+  }
+  for (dir = 0; dir < num_dims; dir++) {
+    tp->grad_phi_plus[dir] = (LSMLIB_REAL*) calloc(tp->num_gridpts,
+                                                   sizeof(LSMLIB_REAL));
+    tp->grad_phi_minus[dir] = (LSMLIB_REAL*) calloc(tp->num_gridpts,
+                                                    sizeof(LSMLIB_REAL));
+    if ( (!tp->grad_phi_plus[dir]) || (!tp->grad_phi_minus[dir]) ) {
+      LSM_KernelBackends_destroyTestProblem(tp);
+      return -1;
+    }
+  }
+
+  /* pseudo-random values in [-1,1] (linear congruential generator) */
+  for (n = 0; n < tp->num_gridpts; n++) {
+    seed = 1103515245u*seed + 12345u;
+    tp->phi[n] = ((seed >> 8) & 0xFFFF)/32767.5 - 1.0;
+  }
+
+  return 0;
+}
+
+
+static void LSM_KernelBackends_destroyTestProblem(
+  LSM_KernelBackendsTestProblem *test_problem)
+{
+  int dir;
+
+  free(test_problem->phi);
+  free(test_problem->D1);
+  free(test_problem->D2);
+  free(test_problem->D3);
+  for (dir = 0; dir < 3; dir++) {
+    free(test_problem->grad_phi_plus[dir]);
+    free(test_problem->grad_phi_minus[dir]);
+  }
+}
+
+
+/* index space arguments for kernels */
+#define GB2D(t)  &((t)->lo_gb[0]), &((t)->hi_gb[0]),                      \
+                 &((t)->lo_gb[1]), &((t)->hi_gb[1])
+#define FB2D(t)  &((t)->lo_fb[0]), &((t)->hi_fb[0]),                      \
+                 &((t)->lo_fb[1]), &((t)->hi_fb[1])
+#define GB3D(t)  GB2D(t), &((t)->lo_gb[2]), &((t)->hi_gb[2])
+#define FB3D(t)  FB2D(t), &((t)->lo_fb[2]), &((t)->hi_fb[2])
+
+/* leading arguments (grad(phi) and phi) of HJ ENO/WENO kernels */
+#define GRAD_PHI_2D(t)                                                    \
+  (t)->grad_phi_plus[0], (t)->grad_phi_plus[1], GB2D(t),                  \
+  (t)->grad_phi_minus[0], (t)->grad_phi_minus[1], GB2D(t),                \
+  (t)->phi, GB2D(t)
+#define GRAD_PHI_3D(t)                                                    \
+  (t)->grad_phi_plus[0], (t)->grad_phi_plus[1], (t)->grad_phi_plus[2],    \
+  GB3D(t),                                                                \
+  (t)->grad_phi_minus[0], (t)->grad_phi_minus[1], (t)->grad_phi_minus[2], \
+  GB3D(t),                                                                \
+  (t)->phi, GB3D(t)
+
+static void LSM_KernelBackends_callKernel(
+  LSM_KernelFunction function,
+  LSM_KernelId kernel,
+  LSM_KernelBackendsTestProblem *test_problem)
+{
+  LSM_KernelBackendsTestProblem *t = test_problem;
+  const LSMLIB_REAL *dx = s_test_dx;
+  const int *bdry_types = s_test_bdry_types;
+
+  switch (kernel) {
+    case LSM_KERNEL_HJ_ENO1_2D: {
+      ((LSM2D_HJ_ENO1_Function) function)(GRAD_PHI_2D(t),
+        t->D1, GB2D(t), FB2D(t), &dx[0], &dx[1]);
+      break;
+    }
+    case LSM_KERNEL_HJ_ENO2_2D: {
+      ((LSM2D_HJ_ENO2_Function) function)(GRAD_PHI_2D(t),
+        t->D1, GB2D(t), t->D2, GB2D(t), FB2D(t), &dx[0], &dx[1]);
+      break;
+    }
+    case LSM_KERNEL_HJ_ENO3_2D: {
+      ((LSM2D_HJ_ENO3_Function) function)(GRAD_PHI_2D(t),
+        t->D1, GB2D(t), t->D2, GB2D(t), t->D3, GB2D(t), FB2D(t),
+        &dx[0], &dx[1]);
+      break;
+    }
+    case LSM_KERNEL_HJ_WENO5_2D: {
+      ((LSM2D_HJ_WENO5_Function) function)(GRAD_PHI_2D(t),
+        t->D1, GB2D(t), FB2D(t), &dx[0], &dx[1]);
+      break;
+    }
+    case LSM_KERNEL_HJ_ENO1_BDRY_2D: {
+      ((LSM2D_HJ_ENO1_BDRY_Function) function)(GRAD_PHI_2D(t),
+        t->D1, GB2D(t), FB2D(t), bdry_types, &dx[0], &dx[1]);
+      break;
+    }
+    case LSM_KERNEL_HJ_ENO2_BDRY_2D: {
+      ((LSM2D_HJ_ENO2_BDRY_Function) function)(GRAD_PHI_2D(t),
+        t->D1, GB2D(t), t->D2, GB2D(t), FB2D(t), bdry_types,
+        &dx[0], &dx[1]);
+      break;
+    }
+    case LSM_KERNEL_HJ_ENO3_BDRY_2D: {
+      ((LSM2D_HJ_ENO3_BDRY_Function) function)(GRAD_PHI_2D(t),
+        t->D1, GB2D(t), t->D2, GB2D(t), t->D3, GB2D(t), FB2D(t),
+        bdry_types, &dx[0], &dx[1]);
+      break;
+    }
+    case LSM_KERNEL_HJ_WENO5_BDRY_2D: {
+      ((LSM2D_HJ_WENO5_BDRY_Function) function)(GRAD_PHI_2D(t),
+        t->D1, GB2D(t), FB2D(t), bdry_types, &dx[0], &dx[1]);
+      break;
+    }
+    case LSM_KERNEL_HJ_ENO1_3D: {
+      ((LSM3D_HJ_ENO1_Function) function)(GRAD_PHI_3D(t),
+        t->D1, GB3D(t), FB3D(t), &dx[0], &dx[1], &dx[2]);
+      break;
+    }
+    case LSM_KERNEL_HJ_ENO2_3D: {
+      ((LSM3D_HJ_ENO2_Function) function)(GRAD_PHI_3D(t),
+        t->D1, GB3D(t), t->D2, GB3D(t), FB3D(t), &dx[0], &dx[1], &dx[2]);
+      break;
+    }
+    case LSM_KERNEL_HJ_ENO3_3D: {
+      ((LSM3D_HJ_ENO3_Function) function)(GRAD_PHI_3D(t),
+        t->D1, GB3D(t), t->D2, GB3D(t), t->D3, GB3D(t), FB3D(t),
+        &dx[0], &dx[1], &dx[2]);
+      break;
+    }
+    case LSM_KERNEL_HJ_WENO5_3D: {
+      ((LSM3D_HJ_WENO5_Function) function)(GRAD_PHI_3D(t),
+        t->D1, GB3D(t), FB3D(t), &dx[0], &dx[1], &dx[2]);
+      break;
+    }
+    case LSM_KERNEL_HJ_ENO1_BDRY_3D: {
+      ((LSM3D_HJ_ENO1_BDRY_Function) function)(GRAD_PHI_3D(t),
+        t->D1, GB3D(t), FB3D(t), bdry_types, &dx[0], &dx[1], &dx[2]);
+      break;
+    }
+    case LSM_KERNEL_HJ_ENO2_BDRY_3D: {
+      ((LSM3D_HJ_ENO2_BDRY_Function) function)(GRAD_PHI_3D(t),
+        t->D1, GB3D(t), t->D2, GB3D(t), FB3D(t), bdry_types,
+        &dx[0], &dx[1], &dx[2]);
+      break;
+    }
+    case LSM_KERNEL_HJ_ENO3_BDRY_3D: {
+      ((LSM3D_HJ_ENO3_BDRY_Function) function)(GRAD_PHI_3D(t),
+        t->D1, GB3D(t), t->D2, GB3D(t), t->D3, GB3D(t), FB3D(t),
+        bdry_types, &dx[0], &dx[1], &dx[2]);
+      break;
+    }
+    case LSM_KERNEL_HJ_WENO5_BDRY_3D: {
+      ((LSM3D_HJ_WENO5_BDRY_Function) function)(GRAD_PHI_3D(t),
+        t->D1, GB3D(t), FB3D(t), bdry_types, &dx[0], &dx[1], &dx[2]);
+      break;
+    }
+    default: {
+      break;
+    }
+  }
+}
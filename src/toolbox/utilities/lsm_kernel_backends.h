@@ -0,0 +1,697 @@
+/*
+ * File:        lsm_kernel_backends.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for runtime selection of LSMLIB kernel
+ *              implementations
+ */
+
+#ifndef INCLUDED_LSM_KERNEL_BACKENDS_H
+#define INCLUDED_LSM_KERNEL_BACKENDS_H
+
+#include <stdio.h>
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \file lsm_kernel_backends.h
+ *
+ * \brief
+ * @ref lsm_kernel_backends.h provides a registry of alternative
+ * implementations ("backends") of LSMLIB toolbox kernels that are
+ * selected at run time.
+ *
+ * The Fortran 77 toolbox kernels form the "reference" backend, which is
+ * always available.  Alternative implementations of any subset of the
+ * kernels listed in LSM_KernelId (e.g. kernels optimized for a
+ * particular instruction set) are registered as an LSM_KernelBackend
+ * using LSM_KernelBackends_register().  Every kernel of a backend is
+ * validated against the reference kernel when the backend is
+ * registered.
+ *
+ * For each kernel, the implementation that is used is
+ *
+ * - the backend selected for the kernel by LSM_KernelBackends_select();
+ *   otherwise
+ * - the backend named by the LSMLIB_KERNEL_BACKEND environment variable
+ *   (if it provides the kernel); otherwise
+ * - the registered backend with the highest priority that provides the
+ *   kernel; otherwise
+ * - the reference backend.
+ *
+ * Backends are only registered on machines that support them (see
+ * is_supported in LSM_KernelBackend and LSM_KernelBackends_cpuSupports()),
+ * so a single executable can register backends for several instruction
+ * sets and use the fastest one available on each machine.
+ *
+ * Kernels are called through the *_DISPATCH macros, which have the same
+ * arguments as the corresponding toolbox kernels, e.g.
+ *
+ * \code
+ *   LSM3D_HJ_WENO5_DISPATCH(
+ *     phi_x_plus, phi_y_plus, phi_z_plus, ...,
+ *     dx, dy, dz);
+ * \endcode
+ *
+ * <h3> NOTES: </h3>
+ * - Registration and selection of backends is not thread-safe.  Backends
+ *   should be registered (and selected) before kernels are called from
+ *   multiple threads.
+ * - Backends should not modify any data except the output arrays and
+ *   scratch arrays of the kernels.
+ *
+ */
+
+
+/*========================== Error Codes ============================*/
+#define LSM_KERNEL_BACKENDS_ERR_SUCCESS                          (0)
+#define LSM_KERNEL_BACKENDS_ERR_INVALID_BACKEND                  (1)
+#define LSM_KERNEL_BACKENDS_ERR_NOT_SUPPORTED                    (2)
+#define LSM_KERNEL_BACKENDS_ERR_VALIDATION_FAILED                (3)
+#define LSM_KERNEL_BACKENDS_ERR_UNKNOWN_BACKEND                  (4)
+#define LSM_KERNEL_BACKENDS_ERR_INVALID_KERNEL                   (5)
+
+
+/*============================= Constants ===========================*/
+
+/* maximum number of registered backends (excluding the reference) */
+#define LSM_KERNEL_BACKENDS_MAX_BACKENDS                        (16)
+
+/* name of the reference (Fortran 77) backend */
+#define LSM_KERNEL_BACKENDS_REFERENCE                "reference"
+
+/*
+ * relative tolerance used to validate kernels against the reference
+ * kernels (relative to the maximum magnitude of the reference result)
+ */
+#define LSM_KERNEL_BACKENDS_VALIDATION_TOLERANCE  (1.e3*LSMLIB_REAL_EPSILON)
+
+
+/*!
+ * Kernels that may be provided by backends.
+ */
+typedef enum {
+  LSM_KERNEL_HJ_ENO1_2D = 0,
+  LSM_KERNEL_HJ_ENO2_2D = 1,
+  LSM_KERNEL_HJ_ENO3_2D = 2,
+  LSM_KERNEL_HJ_WENO5_2D = 3,
+  LSM_KERNEL_HJ_ENO1_BDRY_2D = 4,
+  LSM_KERNEL_HJ_ENO2_BDRY_2D = 5,
+  LSM_KERNEL_HJ_ENO3_BDRY_2D = 6,
+  LSM_KERNEL_HJ_WENO5_BDRY_2D = 7,
+  LSM_KERNEL_HJ_ENO1_3D = 8,
+  LSM_KERNEL_HJ_ENO2_3D = 9,
+  LSM_KERNEL_HJ_ENO3_3D = 10,
+  LSM_KERNEL_HJ_WENO5_3D = 11,
+  LSM_KERNEL_HJ_ENO1_BDRY_3D = 12,
+  LSM_KERNEL_HJ_ENO2_BDRY_3D = 13,
+  LSM_KERNEL_HJ_ENO3_BDRY_3D = 14,
+  LSM_KERNEL_HJ_WENO5_BDRY_3D = 15,
+  LSM_KERNEL_NUM_KERNELS = 16
+} LSM_KernelId;
+
+/* kernel index used to select a backend for all kernels */
+#define LSM_KERNEL_ALL                                          (-1)
+
+
+/*!
+ * Generic kernel function pointer type (kernels are stored in this
+ * form and cast to the kernel function types below when called).
+ */
+typedef void (*LSM_KernelFunction)(void);
+
+
+/*
+ * Kernel function types (the arguments are the same as for the
+ * toolbox kernels in lsm_spatial_derivatives2d.h and
+ * lsm_spatial_derivatives3d.h).
+ */
+typedef void (*LSM2D_HJ_ENO1_Function)(
+  LSMLIB_REAL *phi_x_plus, LSMLIB_REAL *phi_y_plus,
+  const int *ilo_grad_phi_plus_gb, const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb, const int *jhi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus, LSMLIB_REAL *phi_y_minus,
+  const int *ilo_grad_phi_minus_gb, const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb, const int *jhi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi, const int *ilo_phi_gb, const int *ihi_phi_gb,
+  const int *jlo_phi_gb, const int *jhi_phi_gb,
+  LSMLIB_REAL *D1, const int *ilo_D1_gb, const int *ihi_D1_gb,
+  const int *jlo_D1_gb, const int *jhi_D1_gb,
+  const int *ilo_fb, const int *ihi_fb, const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *dx, const LSMLIB_REAL *dy);
+
+typedef void (*LSM2D_HJ_ENO2_Function)(
+  LSMLIB_REAL *phi_x_plus, LSMLIB_REAL *phi_y_plus,
+  const int *ilo_grad_phi_plus_gb, const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb, const int *jhi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus, LSMLIB_REAL *phi_y_minus,
+  const int *ilo_grad_phi_minus_gb, const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb, const int *jhi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi, const int *ilo_phi_gb, const int *ihi_phi_gb,
+  const int *jlo_phi_gb, const int *jhi_phi_gb,
+  LSMLIB_REAL *D1, const int *ilo_D1_gb, const int *ihi_D1_gb,
+  const int *jlo_D1_gb, const int *jhi_D1_gb,
+  LSMLIB_REAL *D2, const int *ilo_D2_gb, const int *ihi_D2_gb,
+  const int *jlo_D2_gb, const int *jhi_D2_gb,
+  const int *ilo_fb, const int *ihi_fb, const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *dx, const LSMLIB_REAL *dy);
+
+typedef void (*LSM2D_HJ_ENO3_Function)(
+  LSMLIB_REAL *phi_x_plus, LSMLIB_REAL *phi_y_plus,
+  const int *ilo_grad_phi_plus_gb, const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb, const int *jhi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus, LSMLIB_REAL *phi_y_minus,
+  const int *ilo_grad_phi_minus_gb, const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb, const int *jhi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi, const int *ilo_phi_gb, const int *ihi_phi_gb,
+  const int *jlo_phi_gb, const int *jhi_phi_gb,
+  LSMLIB_REAL *D1, const int *ilo_D1_gb, const int *ihi_D1_gb,
+  const int *jlo_D1_gb, const int *jhi_D1_gb,
+  LSMLIB_REAL *D2, const int *ilo_D2_gb, const int *ihi_D2_gb,
+  const int *jlo_D2_gb, const int *jhi_D2_gb,
+  LSMLIB_REAL *D3, const int *ilo_D3_gb, const int *ihi_D3_gb,
+  const int *jlo_D3_gb, const int *jhi_D3_gb,
+  const int *ilo_fb, const int *ihi_fb, const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *dx, const LSMLIB_REAL *dy);
+
+typedef void (*LSM2D_HJ_WENO5_Function)(
+  LSMLIB_REAL *phi_x_plus, LSMLIB_REAL *phi_y_plus,
+  const int *ilo_grad_phi_plus_gb, const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb, const int *jhi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus, LSMLIB_REAL *phi_y_minus,
+  const int *ilo_grad_phi_minus_gb, const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb, const int *jhi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi, const int *ilo_phi_gb, const int *ihi_phi_gb,
+  const int *jlo_phi_gb, const int *jhi_phi_gb,
+  LSMLIB_REAL *D1, const int *ilo_D1_gb, const int *ihi_D1_gb,
+  const int *jlo_D1_gb, const int *jhi_D1_gb,
+  const int *ilo_fb, const int *ihi_fb, const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *dx, const LSMLIB_REAL *dy);
+
+typedef void (*LSM2D_HJ_ENO1_BDRY_Function)(
+  LSMLIB_REAL *phi_x_plus, LSMLIB_REAL *phi_y_plus,
+  const int *ilo_grad_phi_plus_gb, const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb, const int *jhi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus, LSMLIB_REAL *phi_y_minus,
+  const int *ilo_grad_phi_minus_gb, const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb, const int *jhi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi, const int *ilo_phi_gb, const int *ihi_phi_gb,
+  const int *jlo_phi_gb, const int *jhi_phi_gb,
+  LSMLIB_REAL *D1, const int *ilo_D1_gb, const int *ihi_D1_gb,
+  const int *jlo_D1_gb, const int *jhi_D1_gb,
+  const int *ilo_fb, const int *ihi_fb, const int *jlo_fb,
+  const int *jhi_fb,
+  const int *bdry_types,
+  const LSMLIB_REAL *dx, const LSMLIB_REAL *dy);
+
+typedef void (*LSM2D_HJ_ENO2_BDRY_Function)(
+  LSMLIB_REAL *phi_x_plus, LSMLIB_REAL *phi_y_plus,
+  const int *ilo_grad_phi_plus_gb, const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb, const int *jhi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus, LSMLIB_REAL *phi_y_minus,
+  const int *ilo_grad_phi_minus_gb, const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb, const int *jhi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi, const int *ilo_phi_gb, const int *ihi_phi_gb,
+  const int *jlo_phi_gb, const int *jhi_phi_gb,
+  LSMLIB_REAL *D1, const int *ilo_D1_gb, const int *ihi_D1_gb,
+  const int *jlo_D1_gb, const int *jhi_D1_gb,
+  LSMLIB_REAL *D2, const int *ilo_D2_gb, const int *ihi_D2_gb,
+  const int *jlo_D2_gb, const int *jhi_D2_gb,
+  const int *ilo_fb, const int *ihi_fb, const int *jlo_fb,
+  const int *jhi_fb,
+  const int *bdry_types,
+  const LSMLIB_REAL *dx, const LSMLIB_REAL *dy);
+
+typedef void (*LSM2D_HJ_ENO3_BDRY_Function)(
+  LSMLIB_REAL *phi_x_plus, LSMLIB_REAL *phi_y_plus,
+  const int *ilo_grad_phi_plus_gb, const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb, const int *jhi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus, LSMLIB_REAL *phi_y_minus,
+  const int *ilo_grad_phi_minus_gb, const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb, const int *jhi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi, const int *ilo_phi_gb, const int *ihi_phi_gb,
+  const int *jlo_phi_gb, const int *jhi_phi_gb,
+  LSMLIB_REAL *D1, const int *ilo_D1_gb, const int *ihi_D1_gb,
+  const int *jlo_D1_gb, const int *jhi_D1_gb,
+  LSMLIB_REAL *D2, const int *ilo_D2_gb, const int *ihi_D2_gb,
+  const int *jlo_D2_gb, const int *jhi_D2_gb,
+  LSMLIB_REAL *D3, const int *ilo_D3_gb, const int *ihi_D3_gb,
+  const int *jlo_D3_gb, const int *jhi_D3_gb,
+  const int *ilo_fb, const int *ihi_fb, const int *jlo_fb,
+  const int *jhi_fb,
+  const int *bdry_types,
+  const LSMLIB_REAL *dx, const LSMLIB_REAL *dy);
+
+typedef void (*LSM2D_HJ_WENO5_BDRY_Function)(
+  LSMLIB_REAL *phi_x_plus, LSMLIB_REAL *phi_y_plus,
+  const int *ilo_grad_phi_plus_gb, const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb, const int *jhi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus, LSMLIB_REAL *phi_y_minus,
+  const int *ilo_grad_phi_minus_gb, const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb, const int *jhi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi, const int *ilo_phi_gb, const int *ihi_phi_gb,
+  const int *jlo_phi_gb, const int *jhi_phi_gb,
+  LSMLIB_REAL *D1, const int *ilo_D1_gb, const int *ihi_D1_gb,
+  const int *jlo_D1_gb, const int *jhi_D1_gb,
+  const int *ilo_fb, const int *ihi_fb, const int *jlo_fb,
+  const int *jhi_fb,
+  const int *bdry_types,
+  const LSMLIB_REAL *dx, const LSMLIB_REAL *dy);
+
+typedef void (*LSM3D_HJ_ENO1_Function)(
+  LSMLIB_REAL *phi_x_plus, LSMLIB_REAL *phi_y_plus, LSMLIB_REAL *phi_z_plus,
+  const int *ilo_grad_phi_plus_gb, const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb, const int *jhi_grad_phi_plus_gb,
+  const int *klo_grad_phi_plus_gb, const int *khi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus, LSMLIB_REAL *phi_y_minus,
+  LSMLIB_REAL *phi_z_minus, const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb, const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb, const int *klo_grad_phi_minus_gb,
+  const int *khi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi, const int *ilo_phi_gb, const int *ihi_phi_gb,
+  const int *jlo_phi_gb, const int *jhi_phi_gb, const int *klo_phi_gb,
+  const int *khi_phi_gb,
+  LSMLIB_REAL *D1, const int *ilo_D1_gb, const int *ihi_D1_gb,
+  const int *jlo_D1_gb, const int *jhi_D1_gb, const int *klo_D1_gb,
+  const int *khi_D1_gb,
+  const int *ilo_fb, const int *ihi_fb, const int *jlo_fb,
+  const int *jhi_fb, const int *klo_fb, const int *khi_fb,
+  const LSMLIB_REAL *dx, const LSMLIB_REAL *dy, const LSMLIB_REAL *dz);
+
+typedef void (*LSM3D_HJ_ENO2_Function)(
+  LSMLIB_REAL *phi_x_plus, LSMLIB_REAL *phi_y_plus, LSMLIB_REAL *phi_z_plus,
+  const int *ilo_grad_phi_plus_gb, const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb, const int *jhi_grad_phi_plus_gb,
+  const int *klo_grad_phi_plus_gb, const int *khi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus, LSMLIB_REAL *phi_y_minus,
+  LSMLIB_REAL *phi_z_minus, const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb, const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb, const int *klo_grad_phi_minus_gb,
+  const int *khi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi, const int *ilo_phi_gb, const int *ihi_phi_gb,
+  const int *jlo_phi_gb, const int *jhi_phi_gb, const int *klo_phi_gb,
+  const int *khi_phi_gb,
+  LSMLIB_REAL *D1, const int *ilo_D1_gb, const int *ihi_D1_gb,
+  const int *jlo_D1_gb, const int *jhi_D1_gb, const int *klo_D1_gb,
+  const int *khi_D1_gb,
+  LSMLIB_REAL *D2, const int *ilo_D2_gb, const int *ihi_D2_gb,
+  const int *jlo_D2_gb, const int *jhi_D2_gb, const int *klo_D2_gb,
+  const int *khi_D2_gb,
+  const int *ilo_fb, const int *ihi_fb, const int *jlo_fb,
+  const int *jhi_fb, const int *klo_fb, const int *khi_fb,
+  const LSMLIB_REAL *dx, const LSMLIB_REAL *dy, const LSMLIB_REAL *dz);
+
+typedef void (*LSM3D_HJ_ENO3_Function)(
+  LSMLIB_REAL *phi_x_plus, LSMLIB_REAL *phi_y_plus, LSMLIB_REAL *phi_z_plus,
+  const int *ilo_grad_phi_plus_gb, const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb, const int *jhi_grad_phi_plus_gb,
+  const int *klo_grad_phi_plus_gb, const int *khi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus, LSMLIB_REAL *phi_y_minus,
+  LSMLIB_REAL *phi_z_minus, const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb, const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb, const int *klo_grad_phi_minus_gb,
+  const int *khi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi, const int *ilo_phi_gb, const int *ihi_phi_gb,
+  const int *jlo_phi_gb, const int *jhi_phi_gb, const int *klo_phi_gb,
+  const int *khi_phi_gb,
+  LSMLIB_REAL *D1, const int *ilo_D1_gb, const int *ihi_D1_gb,
+  const int *jlo_D1_gb, const int *jhi_D1_gb, const int *klo_D1_gb,
+  const int *khi_D1_gb,
+  LSMLIB_REAL *D2, const int *ilo_D2_gb, const int *ihi_D2_gb,
+  const int *jlo_D2_gb, const int *jhi_D2_gb, const int *klo_D2_gb,
+  const int *khi_D2_gb,
+  LSMLIB_REAL *D3, const int *ilo_D3_gb, const int *ihi_D3_gb,
+  const int *jlo_D3_gb, const int *jhi_D3_gb, const int *klo_D3_gb,
+  const int *khi_D3_gb,
+  const int *ilo_fb, const int *ihi_fb, const int *jlo_fb,
+  const int *jhi_fb, const int *klo_fb, const int *khi_fb,
+  const LSMLIB_REAL *dx, const LSMLIB_REAL *dy, const LSMLIB_REAL *dz);
+
+typedef void (*LSM3D_HJ_WENO5_Function)(
+  LSMLIB_REAL *phi_x_plus, LSMLIB_REAL *phi_y_plus, LSMLIB_REAL *phi_z_plus,
+  const int *ilo_grad_phi_plus_gb, const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb, const int *jhi_grad_phi_plus_gb,
+  const int *klo_grad_phi_plus_gb, const int *khi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus, LSMLIB_REAL *phi_y_minus,
+  LSMLIB_REAL *phi_z_minus, const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb, const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb, const int *klo_grad_phi_minus_gb,
+  const int *khi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi, const int *ilo_phi_gb, const int *ihi_phi_gb,
+  const int *jlo_phi_gb, const int *jhi_phi_gb, const int *klo_phi_gb,
+  const int *khi_phi_gb,
+  LSMLIB_REAL *D1, const int *ilo_D1_gb, const int *ihi_D1_gb,
+  const int *jlo_D1_gb, const int *jhi_D1_gb, const int *klo_D1_gb,
+  const int *khi_D1_gb,
+  const int *ilo_fb, const int *ihi_fb, const int *jlo_fb,
+  const int *jhi_fb, const int *klo_fb, const int *khi_fb,
+  const LSMLIB_REAL *dx, const LSMLIB_REAL *dy, const LSMLIB_REAL *dz);
+
+typedef void (*LSM3D_HJ_ENO1_BDRY_Function)(
+  LSMLIB_REAL *phi_x_plus, LSMLIB_REAL *phi_y_plus, LSMLIB_REAL *phi_z_plus,
+  const int *ilo_grad_phi_plus_gb, const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb, const int *jhi_grad_phi_plus_gb,
+  const int *klo_grad_phi_plus_gb, const int *khi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus, LSMLIB_REAL *phi_y_minus,
+  LSMLIB_REAL *phi_z_minus, const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb, const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb, const int *klo_grad_phi_minus_gb,
+  const int *khi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi, const int *ilo_phi_gb, const int *ihi_phi_gb,
+  const int *jlo_phi_gb, const int *jhi_phi_gb, const int *klo_phi_gb,
+  const int *khi_phi_gb,
+  LSMLIB_REAL *D1, const int *ilo_D1_gb, const int *ihi_D1_gb,
+  const int *jlo_D1_gb, const int *jhi_D1_gb, const int *klo_D1_gb,
+  const int *khi_D1_gb,
+  const int *ilo_fb, const int *ihi_fb, const int *jlo_fb,
+  const int *jhi_fb, const int *klo_fb, const int *khi_fb,
+  const int *bdry_types,
+  const LSMLIB_REAL *dx, const LSMLIB_REAL *dy, const LSMLIB_REAL *dz);
+
+typedef void (*LSM3D_HJ_ENO2_BDRY_Function)(
+  LSMLIB_REAL *phi_x_plus, LSMLIB_REAL *phi_y_plus, LSMLIB_REAL *phi_z_plus,
+  const int *ilo_grad_phi_plus_gb, const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb, const int *jhi_grad_phi_plus_gb,
+  const int *klo_grad_phi_plus_gb, const int *khi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus, LSMLIB_REAL *phi_y_minus,
+  LSMLIB_REAL *phi_z_minus, const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb, const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb, const int *klo_grad_phi_minus_gb,
+  const int *khi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi, const int *ilo_phi_gb, const int *ihi_phi_gb,
+  const int *jlo_phi_gb, const int *jhi_phi_gb, const int *klo_phi_gb,
+  const int *khi_phi_gb,
+  LSMLIB_REAL *D1, const int *ilo_D1_gb, const int *ihi_D1_gb,
+  const int *jlo_D1_gb, const int *jhi_D1_gb, const int *klo_D1_gb,
+  const int *khi_D1_gb,
+  LSMLIB_REAL *D2, const int *ilo_D2_gb, const int *ihi_D2_gb,
+  const int *jlo_D2_gb, const int *jhi_D2_gb, const int *klo_D2_gb,
+  const int *khi_D2_gb,
+  const int *ilo_fb, const int *ihi_fb, const int *jlo_fb,
+  const int *jhi_fb, const int *klo_fb, const int *khi_fb,
+  const int *bdry_types,
+  const LSMLIB_REAL *dx, const LSMLIB_REAL *dy, const LSMLIB_REAL *dz);
+
+typedef void (*LSM3D_HJ_ENO3_BDRY_Function)(
+  LSMLIB_REAL *phi_x_plus, LSMLIB_REAL *phi_y_plus, LSMLIB_REAL *phi_z_plus,
+  const int *ilo_grad_phi_plus_gb, const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb, const int *jhi_grad_phi_plus_gb,
+  const int *klo_grad_phi_plus_gb, const int *khi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus, LSMLIB_REAL *phi_y_minus,
+  LSMLIB_REAL *phi_z_minus, const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb, const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb, const int *klo_grad_phi_minus_gb,
+  const int *khi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi, const int *ilo_phi_gb, const int *ihi_phi_gb,
+  const int *jlo_phi_gb, const int *jhi_phi_gb, const int *klo_phi_gb,
+  const int *khi_phi_gb,
+  LSMLIB_REAL *D1, const int *ilo_D1_gb, const int *ihi_D1_gb,
+  const int *jlo_D1_gb, const int *jhi_D1_gb, const int *klo_D1_gb,
+  const int *khi_D1_gb,
+  LSMLIB_REAL *D2, const int *ilo_D2_gb, const int *ihi_D2_gb,
+  const int *jlo_D2_gb, const int *jhi_D2_gb, const int *klo_D2_gb,
+  const int *khi_D2_gb,
+  LSMLIB_REAL *D3, const int *ilo_D3_gb, const int *ihi_D3_gb,
+  const int *jlo_D3_gb, const int *jhi_D3_gb, const int *klo_D3_gb,
+  const int *khi_D3_gb,
+  const int *ilo_fb, const int *ihi_fb, const int *jlo_fb,
+  const int *jhi_fb, const int *klo_fb, const int *khi_fb,
+  const int *bdry_types,
+  const LSMLIB_REAL *dx, const LSMLIB_REAL *dy, const LSMLIB_REAL *dz);
+
+typedef void (*LSM3D_HJ_WENO5_BDRY_Function)(
+  LSMLIB_REAL *phi_x_plus, LSMLIB_REAL *phi_y_plus, LSMLIB_REAL *phi_z_plus,
+  const int *ilo_grad_phi_plus_gb, const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb, const int *jhi_grad_phi_plus_gb,
+  const int *klo_grad_phi_plus_gb, const int *khi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus, LSMLIB_REAL *phi_y_minus,
+  LSMLIB_REAL *phi_z_minus, const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb, const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb, const int *klo_grad_phi_minus_gb,
+  const int *khi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi, const int *ilo_phi_gb, const int *ihi_phi_gb,
+  const int *jlo_phi_gb, const int *jhi_phi_gb, const int *klo_phi_gb,
+  const int *khi_phi_gb,
+  LSMLIB_REAL *D1, const int *ilo_D1_gb, const int *ihi_D1_gb,
+  const int *jlo_D1_gb, const int *jhi_D1_gb, const int *klo_D1_gb,
+  const int *khi_D1_gb,
+  const int *ilo_fb, const int *ihi_fb, const int *jlo_fb,
+  const int *jhi_fb, const int *klo_fb, const int *khi_fb,
+  const int *bdry_types,
+  const LSMLIB_REAL *dx, const LSMLIB_REAL *dy, const LSMLIB_REAL *dz);
+
+
+/*!
+ * Structure 'LSM_KernelBackend' describes a backend.
+ *
+ * NOTES:
+ * - Kernels that the backend does not provide should be set to NULL;
+ *   the corresponding kernels of the other backends are used instead.
+ *
+ * - Kernels are stored as LSM_KernelFunction, e.g.
+ *   \code
+ *     backend.kernels[LSM_KERNEL_HJ_WENO5_3D] =
+ *       (LSM_KernelFunction) &myHJWENO5AVX2;
+ *   \endcode
+ */
+typedef struct _LSM_KernelBackend
+{
+  /* name of the backend (e.g. "avx2"); at most 63 characters */
+  const char *name;
+
+  /* priority used for automatic selection (higher is preferred) */
+  int priority;
+
+  /*
+   * function that returns a nonzero value if the backend can be used
+   * on this machine (NULL if the backend can always be used)
+   */
+  int (*is_supported)(void);
+
+  /* kernels provided by the backend (indexed by LSM_KernelId) */
+  LSM_KernelFunction kernels[LSM_KERNEL_NUM_KERNELS];
+
+} LSM_KernelBackend;
+
+
+/* Dispatch macros */
+#define LSM_KERNEL_BACKENDS_DISPATCH(type, kernel)                        \
+  ((type) LSM_KernelBackends_getFunction(kernel))
+
+#define LSM2D_HJ_ENO1_DISPATCH                                            \
+  LSM_KERNEL_BACKENDS_DISPATCH(LSM2D_HJ_ENO1_Function,                    \
+                               LSM_KERNEL_HJ_ENO1_2D)
+#define LSM2D_HJ_ENO2_DISPATCH                                            \
+  LSM_KERNEL_BACKENDS_DISPATCH(LSM2D_HJ_ENO2_Function,                    \
+                               LSM_KERNEL_HJ_ENO2_2D)
+#define LSM2D_HJ_ENO3_DISPATCH                                            \
+  LSM_KERNEL_BACKENDS_DISPATCH(LSM2D_HJ_ENO3_Function,                    \
+                               LSM_KERNEL_HJ_ENO3_2D)
+#define LSM2D_HJ_WENO5_DISPATCH                                           \
+  LSM_KERNEL_BACKENDS_DISPATCH(LSM2D_HJ_WENO5_Function,                   \
+                               LSM_KERNEL_HJ_WENO5_2D)
+#define LSM2D_HJ_ENO1_BDRY_DISPATCH                                       \
+  LSM_KERNEL_BACKENDS_DISPATCH(LSM2D_HJ_ENO1_BDRY_Function,               \
+                               LSM_KERNEL_HJ_ENO1_BDRY_2D)
+#define LSM2D_HJ_ENO2_BDRY_DISPATCH                                       \
+  LSM_KERNEL_BACKENDS_DISPATCH(LSM2D_HJ_ENO2_BDRY_Function,               \
+                               LSM_KERNEL_HJ_ENO2_BDRY_2D)
+#define LSM2D_HJ_ENO3_BDRY_DISPATCH                                       \
+  LSM_KERNEL_BACKENDS_DISPATCH(LSM2D_HJ_ENO3_BDRY_Function,               \
+                               LSM_KERNEL_HJ_ENO3_BDRY_2D)
+#define LSM2D_HJ_WENO5_BDRY_DISPATCH                                      \
+  LSM_KERNEL_BACKENDS_DISPATCH(LSM2D_HJ_WENO5_BDRY_Function,              \
+                               LSM_KERNEL_HJ_WENO5_BDRY_2D)
+#define LSM3D_HJ_ENO1_DISPATCH                                            \
+  LSM_KERNEL_BACKENDS_DISPATCH(LSM3D_HJ_ENO1_Function,                    \
+                               LSM_KERNEL_HJ_ENO1_3D)
+#define LSM3D_HJ_ENO2_DISPATCH                                            \
+  LSM_KERNEL_BACKENDS_DISPATCH(LSM3D_HJ_ENO2_Function,                    \
+                               LSM_KERNEL_HJ_ENO2_3D)
+#define LSM3D_HJ_ENO3_DISPATCH                                            \
+  LSM_KERNEL_BACKENDS_DISPATCH(LSM3D_HJ_ENO3_Function,                    \
+                               LSM_KERNEL_HJ_ENO3_3D)
+#define LSM3D_HJ_WENO5_DISPATCH                                           \
+  LSM_KERNEL_BACKENDS_DISPATCH(LSM3D_HJ_WENO5_Function,                   \
+                               LSM_KERNEL_HJ_WENO5_3D)
+#define LSM3D_HJ_ENO1_BDRY_DISPATCH                                       \
+  LSM_KERNEL_BACKENDS_DISPATCH(LSM3D_HJ_ENO1_BDRY_Function,               \
+                               LSM_KERNEL_HJ_ENO1_BDRY_3D)
+#define LSM3D_HJ_ENO2_BDRY_DISPATCH                                       \
+  LSM_KERNEL_BACKENDS_DISPATCH(LSM3D_HJ_ENO2_BDRY_Function,               \
+                               LSM_KERNEL_HJ_ENO2_BDRY_3D)
+#define LSM3D_HJ_ENO3_BDRY_DISPATCH                                       \
+  LSM_KERNEL_BACKENDS_DISPATCH(LSM3D_HJ_ENO3_BDRY_Function,               \
+                               LSM_KERNEL_HJ_ENO3_BDRY_3D)
+#define LSM3D_HJ_WENO5_BDRY_DISPATCH                                      \
+  LSM_KERNEL_BACKENDS_DISPATCH(LSM3D_HJ_WENO5_BDRY_Function,              \
+                               LSM_KERNEL_HJ_WENO5_BDRY_3D)
+
+
+/*!
+ * LSM_KernelBackends_register() validates the kernels of a backend
+ * against the reference kernels and adds the backend to the registry.
+ *
+ * Arguments:
+ *  - backend (in):  backend to register (copied)
+ *
+ * Return value:     error code:
+ *                   - LSM_KERNEL_BACKENDS_ERR_SUCCESS
+ *                   - LSM_KERNEL_BACKENDS_ERR_INVALID_BACKEND if the
+ *                     name of the backend is missing or already in
+ *                     use, or the registry is full
+ *                   - LSM_KERNEL_BACKENDS_ERR_NOT_SUPPORTED if the
+ *                     backend is not supported on this machine
+ *                   - LSM_KERNEL_BACKENDS_ERR_VALIDATION_FAILED if any
+ *                     kernel of the backend does not agree with the
+ *                     reference kernel
+ *
+ * NOTES:
+ * - The backend is not registered if an error occurs.
+ *
+ * - The kernel selection is updated after the backend is registered.
+ *
+ */
+int LSM_KernelBackends_register(const LSM_KernelBackend *backend);
+
+
+/*!
+ * LSM_KernelBackends_validate() compares a kernel of a backend with
+ * the reference kernel on a small test problem.
+ *
+ * Arguments:
+ *  - backend (in):     backend
+ *  - kernel (in):      kernel to validate
+ *  - max_error (out):  maximum difference between the results of the
+ *                      backend and reference kernels relative to the
+ *                      maximum magnitude of the reference result (may
+ *                      be NULL)
+ *
+ * Return value:        LSM_KERNEL_BACKENDS_ERR_SUCCESS if the relative
+ *                      difference does not exceed
+ *                      LSM_KERNEL_BACKENDS_VALIDATION_TOLERANCE (or the
+ *                      backend does not provide the kernel); otherwise
+ *                      an error code
+ *
+ * NOTES:
+ * - The test problem uses pseudo-random data in all grid cells
+ *   (including ghostcells), so all branches of the ENO/WENO stencil
+ *   selection are exercised.
+ *
+ */
+int LSM_KernelBackends_validate(
+  const LSM_KernelBackend *backend,
+  LSM_KernelId kernel,
+  LSMLIB_REAL *max_error);
+
+
+/*!
+ * LSM_KernelBackends_select() selects the backend used for a kernel
+ * (overriding automatic selection).
+ *
+ * Arguments:
+ *  - kernel (in):        kernel (LSM_KERNEL_ALL to select the backend
+ *                        for all kernels that it provides)
+ *  - backend_name (in):  name of a registered backend,
+ *                        LSM_KERNEL_BACKENDS_REFERENCE, or NULL to
+ *                        restore automatic selection
+ *
+ * Return value:          LSM_KERNEL_BACKENDS_ERR_SUCCESS or an error
+ *                        code
+ *
+ * NOTES:
+ * - An error is returned if the backend does not provide the kernel
+ *   (for kernel = LSM_KERNEL_ALL, kernels that the backend does not
+ *   provide are not changed).
+ *
+ */
+int LSM_KernelBackends_select(int kernel, const char *backend_name);
+
+
+/*!
+ * LSM_KernelBackends_getFunction() returns the implementation of a
+ * kernel provided by the selected backend.
+ *
+ * Arguments:
+ *  - kernel (in):  kernel
+ *
+ * Return value:    kernel function (NULL if kernel is invalid)
+ *
+ * NOTES:
+ * - Normally called through the *_DISPATCH macros.
+ *
+ */
+LSM_KernelFunction LSM_KernelBackends_getFunction(LSM_KernelId kernel);
+
+
+/*!
+ * LSM_KernelBackends_getSelectedBackend() returns the name of the
+ * backend selected for a kernel.
+ *
+ * Arguments:
+ *  - kernel (in):  kernel
+ *
+ * Return value:    name of backend; "unknown" if kernel is invalid
+ *
+ */
+const char *LSM_KernelBackends_getSelectedBackend(LSM_KernelId kernel);
+
+
+/*!
+ * LSM_KernelBackends_getKernelName() returns the name of a kernel
+ * (e.g. "LSM3D_HJ_WENO5").
+ *
+ * Arguments:
+ *  - kernel (in):  kernel
+ *
+ * Return value:    name of kernel; "unknown" if kernel is invalid
+ *
+ */
+const char *LSM_KernelBackends_getKernelName(LSM_KernelId kernel);
+
+
+/*!
+ * LSM_KernelBackends_cpuSupports() checks whether the processor
+ * supports an instruction set extension.
+ *
+ * Arguments:
+ *  - feature (in):  name of instruction set extension ("sse4.2",
+ *                   "avx", "avx2", "fma", "avx512f", "avx512bw",
+ *                   "avx512vl" or "avx512dq")
+ *
+ * Return value:     1 if the extension is supported; 0 otherwise
+ *
+ * NOTES:
+ * - Always returns 0 for compilers other than GCC-compatible compilers
+ *   and for processors other than x86 processors.
+ *
+ */
+int LSM_KernelBackends_cpuSupports(const char *feature);
+
+
+/*!
+ * LSM_KernelBackends_writeReport() writes the registered backends and
+ * the backend selected for each kernel.
+ *
+ * Arguments:
+ *  - fp (in):   output stream
+ *
+ * Return value: none
+ *
+ */
+void LSM_KernelBackends_writeReport(FILE *fp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
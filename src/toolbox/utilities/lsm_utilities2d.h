@@ -72,6 +72,8 @@ extern "C" {
                                    lsm2dvoxelcountlessthanzerocontrolvolume_
 #define LSM2D_SURFACE_INTEGRAL_DELTA_CONTROL_VOLUME              \
                        lsm2dsurfaceintegralprecomputeddeltacontrolvolume_
+#define LSM2D_COMPUTE_STABLE_LF_DT             lsm2dcomputestablelfdt_
+#define LSM2D_COMPUTE_STABLE_LLF_DT            lsm2dcomputestablellfdt_
 		       
 /*!
  * LSM2D_MAX_NORM_DIFF() computes the max norm of the difference
@@ -964,6 +966,91 @@ void LSM2D_SURFACE_INTEGRAL_DELTA_CONTROL_VOLUME(
   const int *jhi_ib,
   const LSMLIB_REAL *dx,
   const LSMLIB_REAL *dy);
+
+
+/*!
+ * LSM2D_COMPUTE_STABLE_LF_DT() computes the stable time step size
+ * for the Lax-Friedrichs discretization of a general Hamiltonian
+ * (see LSM2D_ADD_HAMILTONIAN_TERM_TO_LSE_RHS_LF()) based on a CFL
+ * criterion.
+ *
+ * Arguments:
+ *  - dt (out):              step size
+ *  - alpha_* (in):          bounds on the partial derivatives of H with
+ *                           respect to the components of
+ *                           \f$ \nabla \phi \f$
+ *  - *_gb (in):             index range for ghostbox
+ *  - *_ib (in):             index range for box to include dt calculation
+ *  - dx, dy (in):           grid spacing
+ *  - cfl_number (in):       CFL number
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ *  - The time step size is computed from the maxima of |alpha_*|
+ *    over all included grid points:
+ *    dt = cfl_number / ( \alpha_x/\Delta x + \alpha_y/\Delta y ).
+ *
+ */
+void LSM2D_COMPUTE_STABLE_LF_DT(
+  LSMLIB_REAL *dt,
+  const LSMLIB_REAL *alpha_x,
+  const LSMLIB_REAL *alpha_y,
+  const int *ilo_alpha_gb, 
+  const int *ihi_alpha_gb,
+  const int *jlo_alpha_gb, 
+  const int *jhi_alpha_gb,
+  const int *ilo_ib, 
+  const int *ihi_ib,
+  const int *jlo_ib, 
+  const int *jhi_ib,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *cfl_number);
+
+
+/*!
+ * LSM2D_COMPUTE_STABLE_LLF_DT() computes the stable time step size
+ * for the local Lax-Friedrichs discretization of a general Hamiltonian
+ * (see LSM2D_ADD_HAMILTONIAN_TERM_TO_LSE_RHS_LLF()) based on a CFL
+ * criterion.
+ *
+ * Arguments:
+ *  - dt (out):              step size
+ *  - alpha_* (in):          bounds on the partial derivatives of H with
+ *                           respect to the components of
+ *                           \f$ \nabla \phi \f$
+ *  - *_gb (in):             index range for ghostbox
+ *  - *_ib (in):             index range for box to include dt calculation
+ *  - dx, dy (in):           grid spacing
+ *  - cfl_number (in):       CFL number
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ *  - The time step size is computed from the maximum over all
+ *    included grid points of
+ *    ( |\alpha_x|/\Delta x + |\alpha_y|/\Delta y ),
+ *    so it is never smaller than the time step size for the
+ *    Lax-Friedrichs scheme.
+ *
+ */
+void LSM2D_COMPUTE_STABLE_LLF_DT(
+  LSMLIB_REAL *dt,
+  const LSMLIB_REAL *alpha_x,
+  const LSMLIB_REAL *alpha_y,
+  const int *ilo_alpha_gb, 
+  const int *ihi_alpha_gb,
+  const int *jlo_alpha_gb, 
+  const int *jhi_alpha_gb,
+  const int *ilo_ib, 
+  const int *ihi_ib,
+  const int *jlo_ib, 
+  const int *jhi_ib,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *cfl_number);
+
   
 #ifdef __cplusplus
 }
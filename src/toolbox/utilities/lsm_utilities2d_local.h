@@ -42,6 +42,8 @@ extern "C" {
                                        lsm2dcomputestablenormalveldtlocal_
 #define LSM2D_COMPUTE_STABLE_CONST_NORMAL_VEL_DT_LOCAL                  \
                                         lsm2dcomputestableconstnormalveldtlocal_
+#define LSM2D_COMPUTE_STABLE_LF_DT_LOCAL       lsm2dcomputestablelfdtlocal_
+#define LSM2D_COMPUTE_STABLE_LLF_DT_LOCAL      lsm2dcomputestablellfdtlocal_
 
 /*!
 *
@@ -282,6 +284,111 @@ void LSM2D_COMPUTE_STABLE_CONST_NORMAL_VEL_DT_LOCAL(
   const int *jlo_nb_gb,
   const int *jhi_nb_gb,  
   const unsigned char *mark_fb);    
+
+
+/*!
+ * LSM2D_COMPUTE_STABLE_LF_DT_LOCAL() computes the stable time step size
+ * for the Lax-Friedrichs discretization of a general Hamiltonian
+ * (see LSM2D_ADD_HAMILTONIAN_TERM_TO_LSE_RHS_LF_LOCAL()) based on a CFL
+ * criterion.
+ *
+ * Arguments:
+ *  - dt (out):              step size
+ *  - alpha_* (in):          bounds on the partial derivatives of H with
+ *                           respect to the components of
+ *                           \f$ \nabla \phi \f$
+ *  - *_gb (in):             index range for ghostbox
+ *  - dx, dy (in):           grid spacing
+ *  - cfl_number (in):       CFL number
+ *  - index_[xy](in):  [xy] coordinates of local (narrow band) points
+ *  - n*_index(in):     index range of points in index_*
+ *  - narrow_band(in):  array that marks voxels outside desired fillbox
+ *  - mark_fb(in):      upper limit narrow band value for voxels in 
+ *                      fillbox
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ *  - The time step size is computed from the maxima of |alpha_*|
+ *    over all grid points in the narrow band:
+ *    dt = cfl_number / ( \alpha_x/\Delta x + \alpha_y/\Delta y ).
+ *
+ */
+void LSM2D_COMPUTE_STABLE_LF_DT_LOCAL(
+  LSMLIB_REAL *dt,
+  const LSMLIB_REAL *alpha_x,
+  const LSMLIB_REAL *alpha_y,
+  const int *ilo_alpha_gb, 
+  const int *ihi_alpha_gb,
+  const int *jlo_alpha_gb, 
+  const int *jhi_alpha_gb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *cfl_number,
+  const int *index_x,
+  const int *index_y,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const unsigned char *mark_fb);
+
+
+/*!
+ * LSM2D_COMPUTE_STABLE_LLF_DT_LOCAL() computes the stable time step size
+ * for the local Lax-Friedrichs discretization of a general Hamiltonian
+ * (see LSM2D_ADD_HAMILTONIAN_TERM_TO_LSE_RHS_LLF_LOCAL()) based on a CFL
+ * criterion.
+ *
+ * Arguments:
+ *  - dt (out):              step size
+ *  - alpha_* (in):          bounds on the partial derivatives of H with
+ *                           respect to the components of
+ *                           \f$ \nabla \phi \f$
+ *  - *_gb (in):             index range for ghostbox
+ *  - dx, dy (in):           grid spacing
+ *  - cfl_number (in):       CFL number
+ *  - index_[xy](in):  [xy] coordinates of local (narrow band) points
+ *  - n*_index(in):     index range of points in index_*
+ *  - narrow_band(in):  array that marks voxels outside desired fillbox
+ *  - mark_fb(in):      upper limit narrow band value for voxels in 
+ *                      fillbox
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ *  - The time step size is computed from the maximum over all
+ *    grid points in the narrow band of
+ *    ( |\alpha_x|/\Delta x + |\alpha_y|/\Delta y ),
+ *    so it is never smaller than the time step size for the
+ *    Lax-Friedrichs scheme.
+ *
+ */
+void LSM2D_COMPUTE_STABLE_LLF_DT_LOCAL(
+  LSMLIB_REAL *dt,
+  const LSMLIB_REAL *alpha_x,
+  const LSMLIB_REAL *alpha_y,
+  const int *ilo_alpha_gb, 
+  const int *ihi_alpha_gb,
+  const int *jlo_alpha_gb, 
+  const int *jhi_alpha_gb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *cfl_number,
+  const int *index_x,
+  const int *index_y,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const unsigned char *mark_fb);
+
   			    
 
 #ifdef __cplusplus
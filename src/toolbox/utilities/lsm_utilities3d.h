@@ -69,6 +69,8 @@ extern "C" {
                                    lsm3dvoxelcountgreaterthanzerocontrolvolume_
 #define LSM3D_VOXEL_COUNT_LESS_THAN_ZERO_CONTROL_VOLUME  \
                                    lsm3dvoxelcountlessthanzerocontrolvolume_
+#define LSM3D_COMPUTE_STABLE_LF_DT             lsm3dcomputestablelfdt_
+#define LSM3D_COMPUTE_STABLE_LLF_DT            lsm3dcomputestablellfdt_
 /*!
  * LSM3D_MAX_NORM_DIFF() computes the max norm of the difference
  * between the two specified scalar fields.
@@ -1026,6 +1028,104 @@ void LSM3D_VOXEL_COUNT_LESS_THAN_ZERO_CONTROL_VOLUME(
   const int *jhi_fb,
   const int *klo_fb,
   const int *khi_fb); 
+
+
+/*!
+ * LSM3D_COMPUTE_STABLE_LF_DT() computes the stable time step size
+ * for the Lax-Friedrichs discretization of a general Hamiltonian
+ * (see LSM3D_ADD_HAMILTONIAN_TERM_TO_LSE_RHS_LF()) based on a CFL
+ * criterion.
+ *
+ * Arguments:
+ *  - dt (out):              step size
+ *  - alpha_* (in):          bounds on the partial derivatives of H with
+ *                           respect to the components of
+ *                           \f$ \nabla \phi \f$
+ *  - *_gb (in):             index range for ghostbox
+ *  - *_ib (in):             index range for box to include dt calculation
+ *  - dx, dy, dz (in):       grid spacing
+ *  - cfl_number (in):       CFL number
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ *  - The time step size is computed from the maxima of |alpha_*|
+ *    over all included grid points:
+ *    dt = cfl_number / ( \alpha_x/\Delta x + \alpha_y/\Delta y
+ *                        + \alpha_z/\Delta z ).
+ *
+ */
+void LSM3D_COMPUTE_STABLE_LF_DT(
+  LSMLIB_REAL *dt,
+  const LSMLIB_REAL *alpha_x,
+  const LSMLIB_REAL *alpha_y,
+  const LSMLIB_REAL *alpha_z,
+  const int *ilo_alpha_gb, 
+  const int *ihi_alpha_gb,
+  const int *jlo_alpha_gb, 
+  const int *jhi_alpha_gb,
+  const int *klo_alpha_gb, 
+  const int *khi_alpha_gb,
+  const int *ilo_ib, 
+  const int *ihi_ib,
+  const int *jlo_ib, 
+  const int *jhi_ib,
+  const int *klo_ib, 
+  const int *khi_ib,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz,
+  const LSMLIB_REAL *cfl_number);
+
+
+/*!
+ * LSM3D_COMPUTE_STABLE_LLF_DT() computes the stable time step size
+ * for the local Lax-Friedrichs discretization of a general Hamiltonian
+ * (see LSM3D_ADD_HAMILTONIAN_TERM_TO_LSE_RHS_LLF()) based on a CFL
+ * criterion.
+ *
+ * Arguments:
+ *  - dt (out):              step size
+ *  - alpha_* (in):          bounds on the partial derivatives of H with
+ *                           respect to the components of
+ *                           \f$ \nabla \phi \f$
+ *  - *_gb (in):             index range for ghostbox
+ *  - *_ib (in):             index range for box to include dt calculation
+ *  - dx, dy, dz (in):       grid spacing
+ *  - cfl_number (in):       CFL number
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ *  - The time step size is computed from the maximum over all
+ *    included grid points of
+ *    ( |\alpha_x|/\Delta x + |\alpha_y|/\Delta y + |\alpha_z|/\Delta z ),
+ *    so it is never smaller than the time step size for the
+ *    Lax-Friedrichs scheme.
+ *
+ */
+void LSM3D_COMPUTE_STABLE_LLF_DT(
+  LSMLIB_REAL *dt,
+  const LSMLIB_REAL *alpha_x,
+  const LSMLIB_REAL *alpha_y,
+  const LSMLIB_REAL *alpha_z,
+  const int *ilo_alpha_gb, 
+  const int *ihi_alpha_gb,
+  const int *jlo_alpha_gb, 
+  const int *jhi_alpha_gb,
+  const int *klo_alpha_gb, 
+  const int *khi_alpha_gb,
+  const int *ilo_ib, 
+  const int *ihi_ib,
+  const int *jlo_ib, 
+  const int *jhi_ib,
+  const int *klo_ib, 
+  const int *khi_ib,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz,
+  const LSMLIB_REAL *cfl_number);
+
 #ifdef __cplusplus
 }
 #endif